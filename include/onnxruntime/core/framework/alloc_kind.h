@@ -20,13 +20,21 @@ namespace onnxruntime {
 //     do not try to optimize for "slice" like ops, where we may be able to
 //     conditionally reuse memory/data in some cases but not others.
 //     Generalizing this is future work.
+//   - sub-buffer values: tensor values whose buffer is a slice of the buffer
+//     of another tensor value, e.g. the inputs of a Concat that are computed
+//     directly into their slice of the Concat output.
+//   - view values: tensor values that are strided views of the buffer of an
+//     input of the node that produces them, e.g. the output of a Transpose
+//     whose consumers all accept strided inputs.
 
 enum class AllocKind {
   kAllocate = 0,
   kReuse = 1,
   kPreExisting = 2,
   kAllocateStatically = 3,
-  kAllocateOutput = 4
+  kAllocateOutput = 4,
+  kSubBuffer = 5,
+  kView = 6
 };
 
 std::ostream& operator<<(std::ostream& out, AllocKind alloc_kind);
@@ -58,6 +58,22 @@ class KernelDef {
     return alias_map_;
   }
 
+  const std::vector<int>& StridedInputs() const {
+    return strided_inputs_;
+  }
+
+  const std::vector<int>& StridedViews() const {
+    return strided_views_;
+  }
+
+  const std::vector<int>& ReleasableInputs() const {
+    return releasable_inputs_;
+  }
+
+  const std::vector<int>& CompactStringInputs() const {
+    return compact_string_inputs_;
+  }
+
   OrtMemType InputMemoryType(size_t input_index) const {
     auto it = input_memory_type_args_.find(input_index);
     if (it == input_memory_type_args_.end())
@@ -110,6 +126,18 @@ class KernelDef {
   // An element <i, j> means that output j is an alias of input i.
   std::vector<std::pair<int, int>> alias_map_;
 
+  // An element i means that input i may be a strided view of another buffer.
+  std::vector<int> strided_inputs_;
+
+  // An element i means that the outputs may be strided views of the buffer of input i.
+  std::vector<int> strided_views_;
+
+  // An element i means that input i is read only when the kernel is created, if it is an initializer.
+  std::vector<int> releasable_inputs_;
+
+  // An element i means that input i may be a string tensor in the compact layout.
+  std::vector<int> compact_string_inputs_;
+
   // The memory types of inputs/outputs of this kernel
   MemTypeMap input_memory_type_args_;
   MemTypeMap output_memory_type_args_;
@@ -193,6 +221,38 @@ class KernelDefBuilder {
   KernelDefBuilder& Alias(const std::vector<std::pair<int, int>>& aliases);
   KernelDefBuilder& Alias(int input_index, int output_index);
 
+  /**
+     Specify that this kernel accepts an input that is a strided view of the
+     buffer of another tensor, i.e. a tensor that is not contiguous.
+  */
+  KernelDefBuilder& StridedInput(int input_index);
+
+  /**
+     Specify that this kernel may produce its outputs as strided views of the
+     buffer of an input, as for Slice and Transpose. The allocation planner
+     plans an output as a view only if all its consumers accept strided inputs.
+     The kernel creates the view with OpKernelContext::OutputView and must
+     compute a contiguous output when no view is planned.
+  */
+  KernelDefBuilder& StridedView(int input_index);
+
+  /**
+     Specify that this kernel reads the input only when it is created, if the
+     input is an initializer, e.g. to quantize or pack weights in a format of
+     its own. The session releases the initializer once the kernels are
+     created, unless other nodes use it, so the kernel must not read the input
+     in Compute then.
+  */
+  KernelDefBuilder& ReleasableInput(int input_index);
+
+  /**
+     Specify that this kernel reads the string elements of an input with
+     Tensor::StringElement, so that the input may be a string tensor in the
+     compact layout. A compact string feed is expanded to std::string elements
+     unless all the kernels that consume it accept it.
+  */
+  KernelDefBuilder& CompactStringInput(int input_index);
+
   /**
      Specify that this kernel requires an input arg
      in certain memory type (instead of the default, device memory).
@@ -32,6 +32,13 @@ class MLValue {
     return data_ && type_;
   }
 
+  /**
+     Returns true if no other MLValue shares the data.
+  */
+  bool IsUnique() const noexcept {
+    return data_.use_count() == 1;
+  }
+
   template <typename T>
   const T& Get() const {
     ORT_ENFORCE(DataTypeImpl::GetType<T>() == type_, DataTypeImpl::GetType<T>(), " != ", type_);
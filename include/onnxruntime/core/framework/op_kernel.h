@@ -23,6 +23,9 @@ namespace onnxruntime {
 class ExecutionFrame;
 class OpKernelContext;
 class OpKernelWrapper;
+namespace concurrency {
+class ThreadPool;
+}
 
 class OpKernel {
  public:
@@ -99,6 +102,12 @@ class OpKernelContext {
   // Return nullptr if the output is an unused optional output.
   Tensor* Output(int index, const TensorShape& shape);
 
+  // Create the output tensor as a view of the data of an input tensor, starting offset elements into it with
+  // the given strides (in elements), if the output has been planned as a view of that input.
+  // Return nullptr if the output must be computed into a tensor of its own from Output(index, shape).
+  Tensor* OutputView(int index, const TensorShape& shape, const Tensor& source, int64_t offset,
+                     const std::vector<int64_t>& strides);
+
   const logging::Logger& Logger() const {
     return *logger_;
   }
@@ -121,6 +130,12 @@ class OpKernelContext {
    */
   Status GetTempSpaceAllocator(AllocatorPtr* output) const;
 
+  /**
+  Return the thread pool kernels can use to parallelize their computation, or nullptr if the
+  operator should run on the calling thread only. Use with concurrency::ThreadPool::TryParallelFor.
+  */
+  concurrency::ThreadPool* GetOperatorThreadPool() const;
+
   /**
   Return the fence of current node's input.
   @param index The index of the input.
@@ -67,6 +67,20 @@ class Tensor final {
          AllocatorPtr deleter = nullptr,
          int64_t offset = 0);
 
+  /**
+     Create a string tensor in the compact layout: the characters of all the elements in one buffer and the offset
+     at which each element starts in it. Element i ends where element i + 1 starts and the last one at chars_len,
+     as in OrtGetStringTensorContent. The elements are not std::string, see IsCompactString.
+     If deleter is given, the tensor owns p_buffer, the allocation that holds the characters and the offsets.
+  */
+  Tensor(const TensorShape& shape,
+         const char* chars,
+         size_t chars_len,
+         const size_t* offsets,
+         const OrtAllocatorInfo& alloc,
+         BufferNakedPtr p_buffer = nullptr,
+         AllocatorPtr deleter = nullptr);
+
   ~Tensor();
 
   /**
@@ -105,6 +119,7 @@ class Tensor final {
     // Type check
     ORT_ENFORCE(DataTypeImpl::GetType<T>() == dtype_, "Tensor type mismatch. ",
                 DataTypeImpl::GetType<T>(), "!=", dtype_);
+    ORT_ENFORCE(!compact_string_.enabled, "The elements of a compact string tensor are not std::string");
     return reinterpret_cast<T*>(static_cast<char*>(p_data_) + byte_offset_);
   }
 
@@ -116,6 +131,7 @@ class Tensor final {
     // Type check
     ORT_ENFORCE(DataTypeImpl::GetType<T>() == dtype_, "Tensor type mismatch. ",
                 DataTypeImpl::GetType<T>(), "!=", dtype_);
+    ORT_ENFORCE(!compact_string_.enabled, "The elements of a compact string tensor are not std::string");
     T* data = reinterpret_cast<T*>(static_cast<char*>(p_data_) + byte_offset_);
     return gsl::make_span(data, shape_.Size());
   }
@@ -125,6 +141,7 @@ class Tensor final {
     // Type check
     ORT_ENFORCE(DataTypeImpl::GetType<T>() == dtype_, "Tensor type mismatch. ",
                 DataTypeImpl::GetType<T>(), "!=", dtype_);
+    ORT_ENFORCE(!compact_string_.enabled, "The elements of a compact string tensor are not std::string");
     return reinterpret_cast<const T*>(static_cast<char*>(p_data_) + byte_offset_);
   }
 
@@ -133,6 +150,7 @@ class Tensor final {
     // Type check
     ORT_ENFORCE(DataTypeImpl::GetType<T>() == dtype_, "Tensor type mismatch. ",
                 DataTypeImpl::GetType<T>(), "!=", dtype_);
+    ORT_ENFORCE(!compact_string_.enabled, "The elements of a compact string tensor are not std::string");
     const T* data = reinterpret_cast<const T*>(static_cast<char*>(p_data_) + byte_offset_);
     return gsl::make_span(data, shape_.Size());
   }
@@ -161,6 +179,7 @@ class Tensor final {
    * @warning this function is NOT thread-safe.
    */
   inline void Reshape(const TensorShape& new_shape) {
+    ORT_ENFORCE(IsContiguous(), "Cannot reshape a strided tensor view");
     ORT_ENFORCE(shape_.Size() == new_shape.Size(),
                 "Tensor size (" + std::to_string(shape_.Size()) +
                     ") != new size (" + std::to_string(new_shape.Size()) + ")");
@@ -171,6 +190,70 @@ class Tensor final {
     return shape_.Size() * dtype_->Size();
   }
 
+  /**
+     Returns true if the elements of the tensor are stored densely in row-major order.
+     Otherwise the tensor is a strided view over a buffer that it shares with another tensor.
+  */
+  bool IsContiguous() const noexcept {
+    return strides_.empty();
+  }
+
+  /**
+     Returns the number of elements to move by to go to the next index along each axis.
+  */
+  std::vector<int64_t> Strides() const;
+
+  /**
+     Makes the tensor a strided view over its buffer. The strides are given in elements, one per axis.
+     Strides that describe the dense row-major layout of the shape leave the tensor contiguous.
+     @warning this function is NOT thread-safe.
+  */
+  void SetStrides(const std::vector<int64_t>& strides);
+
+  /**
+     Returns true if the tensor is a string tensor in the compact layout. Its elements are then read with
+     StringElement, or CompactStringChars and CompactStringOffsets, and not as std::string.
+  */
+  bool IsCompactString() const noexcept {
+    return compact_string_.enabled;
+  }
+
+  /**
+     Returns element index of a string tensor in either layout without copying it.
+  */
+  gsl::span<const char> StringElement(int64_t index) const {
+    if (compact_string_.enabled) {
+      size_t begin = compact_string_.offsets[index];
+      size_t end = index + 1 < compact_string_.count ? compact_string_.offsets[index + 1] : compact_string_.chars_len;
+      return gsl::make_span(compact_string_.chars + begin, end - begin);
+    }
+    const std::string& element = Data<std::string>()[index];
+    return gsl::make_span(element.data(), element.size());
+  }
+
+  /**
+     Returns the characters of all the elements of a compact string tensor.
+  */
+  gsl::span<const char> CompactStringChars() const {
+    ORT_ENFORCE(compact_string_.enabled, "The tensor is not a compact string tensor");
+    return gsl::make_span(compact_string_.chars, compact_string_.chars_len);
+  }
+
+  /**
+     Returns the offset of each element of a compact string tensor in CompactStringChars.
+  */
+  gsl::span<const size_t> CompactStringOffsets() const {
+    ORT_ENFORCE(compact_string_.enabled, "The tensor is not a compact string tensor");
+    return gsl::make_span(compact_string_.offsets, compact_string_.count);
+  }
+
+  /**
+     Returns true if the tensor releases its buffer when it is destroyed.
+  */
+  bool OwnsBuffer() const noexcept {
+    return buffer_deleter_ != nullptr;
+  }
+
   // More API methods.
  private:
   void Init(MLDataType p_type,
@@ -194,6 +277,18 @@ class Tensor final {
   MLDataType dtype_;
   OrtAllocatorInfo alloc_info_;
   int64_t byte_offset_;
+  // empty if the tensor is contiguous
+  std::vector<int64_t> strides_;
+
+  // the layout of a string tensor whose elements are not std::string
+  struct CompactString {
+    bool enabled = false;
+    const char* chars = nullptr;
+    size_t chars_len = 0;
+    const size_t* offsets = nullptr;
+    int64_t count = 0;
+  };
+  CompactString compact_string_;
 };
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
@@ -137,6 +137,8 @@ ORT_RUNTIME_CLASS(Status);  // nullptr for Status* indicates success
 ORT_RUNTIME_CLASS(Provider);
 ORT_RUNTIME_CLASS(AllocatorInfo);
 ORT_RUNTIME_CLASS(Session);
+ORT_RUNTIME_CLASS(IoBinding);
+ORT_RUNTIME_CLASS(InitializerStore);
 ORT_RUNTIME_CLASS(Value);
 ORT_RUNTIME_CLASS(ValueList);
 
@@ -208,6 +210,45 @@ ORT_API_STATUS(OrtRun, _Inout_ OrtSession* sess,
                _In_ const char* const* input_names, _In_ const OrtValue* const* input, size_t input_len,
                _In_ const char* const* output_names, size_t output_names_len, _Out_ OrtValue** output);
 
+/**
+ * Bind inputs and outputs once and run the session repeatedly without rebuilding them.
+ * Outputs bound to a tensor created with OrtCreateTensorWithDataAsOrtValue are written to the caller's
+ * buffer in place, so a steady state loop over a binding doesn't allocate any output memory.
+ * The binding refers to the session and must be released with OrtReleaseIoBinding before it.
+ * \param out Should be freed by OrtReleaseIoBinding
+ */
+ORT_API_STATUS(OrtCreateIoBinding, _Inout_ OrtSession* sess, _Out_ OrtIoBinding** out);
+
+/**
+ * The binding adds a reference to value, so it can be released by the caller.
+ * The data of a tensor created with OrtCreateTensorWithDataAsOrtValue must stay valid while it is bound.
+ * Binding a name again replaces the previous value.
+ */
+ORT_API_STATUS(OrtIoBindingBindInput, _Inout_ OrtIoBinding* binding, _In_ const char* name, _In_ const OrtValue* value);
+
+/**
+ * \param value A preallocated tensor of the output's type and shape, or NULL to let each run allocate the output.
+ */
+ORT_API_STATUS(OrtIoBindingBindOutput, _Inout_ OrtIoBinding* binding, _In_ const char* name,
+               _In_opt_ const OrtValue* value);
+
+ORT_API(void, OrtIoBindingClearInputs, _Inout_ OrtIoBinding* binding);
+ORT_API(void, OrtIoBindingClearOutputs, _Inout_ OrtIoBinding* binding);
+
+ORT_API_STATUS(OrtRunWithIoBinding, _Inout_ OrtSession* sess, _In_opt_ OrtRunOptions* run_options,
+               _Inout_ OrtIoBinding* binding);
+
+/**
+ * The outputs of the last run, in the order in which they were bound.
+ */
+ORT_API_STATUS(OrtIoBindingGetOutputCount, _In_ const OrtIoBinding* binding, _Out_ size_t* out);
+
+/**
+ * \param out A new reference to the output. Should be freed by OrtReleaseValue.
+ * For outputs bound to a preallocated tensor this refers to the same buffer.
+ */
+ORT_API_STATUS(OrtIoBindingGetOutputValue, _In_ const OrtIoBinding* binding, size_t index, _Out_ OrtValue** out);
+
 /**
  * \return A pointer of the newly created object. The pointer should be freed by OrtReleaseObject after use
  */
@@ -235,6 +276,26 @@ ORT_API(void, OrtDisableMemPattern, _In_ OrtSessionOptions* options);
 ORT_API(void, OrtEnableCpuMemArena, _In_ OrtSessionOptions* options);
 ORT_API(void, OrtDisableCpuMemArena, _In_ OrtSessionOptions* options);
 
+// Cache the graph optimized by the session initialization next to the model file, so that the next
+// sessions of the model skip the graph optimizations.
+ORT_API(void, OrtEnableOptimizedModelCache, _In_ OrtSessionOptions* options);
+ORT_API(void, OrtDisableOptimizedModelCache, _In_ OrtSessionOptions* options);
+
+// Share the initializers with the other sessions of the same model that enable it, so that they keep a single copy
+// of the weights. The sessions share if they load the same model content and use the same execution providers.
+ORT_API(void, OrtEnableSharedInitializers, _In_ OrtSessionOptions* options);
+ORT_API(void, OrtDisableSharedInitializers, _In_ OrtSessionOptions* options);
+
+/**
+ * A store for the initializers shared by the sessions created with it, see OrtSetInitializerStore.
+ * \param out Should be freed by OrtReleaseInitializerStore. The sessions using the store keep it alive.
+ */
+ORT_API_STATUS(OrtCreateInitializerStore, _Out_ OrtInitializerStore** out);
+
+// Share the initializers with the other sessions created with the same store. The sessions must load the same model
+// with the same execution providers. NULL stops using a store.
+ORT_API(void, OrtSetInitializerStore, _In_ OrtSessionOptions* options, _In_opt_ OrtInitializerStore* store);
+
 // < logger id to use for session output
 ORT_API(void, OrtSetSessionLogId, _In_ OrtSessionOptions* options, const char* logid);
 
@@ -244,6 +305,15 @@ ORT_API(void, OrtSetSessionLogVerbosityLevel, _In_ OrtSessionOptions* options, u
 // How many threads in the session thread pool.
 ORT_API(int, OrtSetSessionThreadPoolSize, _In_ OrtSessionOptions* options, int session_thread_pool_size);
 
+// How many threads kernels may use to parallelize a single operator, including the thread running it.
+// 1 disables intra-operator parallelism. Other values give the session a pool of its own. By default the sessions
+// share a pool with one thread per hardware thread.
+ORT_API(int, OrtSetOperatorThreadPoolSize, _In_ OrtSessionOptions* options, int operator_thread_pool_size);
+
+// How many threads session initialization may use to load the initializers and create the kernels, including the
+// calling thread. 1 initializes the session on the calling thread only. By default one thread per hardware thread is used.
+ORT_API(int, OrtSetLoadThreadPoolSize, _In_ OrtSessionOptions* options, int load_thread_pool_size);
+
 /**
   * The order of invocation indicates the preference order as well. In other words call this method
   * on your most preferred execution provider first followed by the less preferred ones.
@@ -307,6 +377,21 @@ ORT_API_STATUS(OrtCreateTensorWithDataAsOrtValue, _In_ const OrtAllocatorInfo* i
                _In_ void* p_data, size_t p_data_len, _In_ const size_t* shape, size_t shape_len,
                ONNXTensorElementDataType type, _Out_ OrtValue** out);
 
+/**
+ * Create a string tensor over user's buffers in the layout produced by OrtGetStringTensorContent,
+ * without copying the strings. The kernels that read this layout use it in place; the strings are
+ * copied only for the other kernels when the tensor is passed to OrtRun.
+ * s and offsets are owned by caller and must outlive the value. OrtReleaseValue won't release them.
+ * \param s string contents. Each string is NOT null-terminated.
+ * \param s_len total data length
+ * \param offsets start offset of each string in s
+ * \param offsets_len must be equal to the number of elements of the tensor
+ * \param out Should be freed by calling OrtReleaseValue
+ */
+ORT_API_STATUS(OrtCreateStringTensorWithDataAsOrtValue, _In_ const OrtAllocatorInfo* info,
+               _In_ const void* s, size_t s_len, _In_ const size_t* offsets, size_t offsets_len,
+               _In_ const size_t* shape, size_t shape_len, _Out_ OrtValue** out);
+
 // This function doesn't work with string tensor
 // this is a no-copy method whose pointer is only valid until the backing OrtValue is free'd.
 ORT_API_STATUS(OrtGetTensorMutableData, _Inout_ OrtValue* value, _Out_ void** out);
@@ -336,6 +421,26 @@ ORT_API_STATUS(OrtGetStringTensorDataLength, _In_ const OrtValue* value, _Out_ s
 ORT_API_STATUS(OrtGetStringTensorContent, _In_ const OrtValue* value, _Out_ void* s, size_t s_len,
                _Out_ size_t* offsets, size_t offsets_len);
 
+/**
+ * Fill a string tensor from the layout produced by OrtGetStringTensorContent,
+ * so no null-terminated copy of each string is needed.
+ * \param value A tensor created from OrtCreateTensor... function.
+ * \param s string contents. Each string is NOT null-terminated.
+ * \param s_len total data length
+ * \param offsets start offset of each string in s
+ * \param offsets_len must be equal to the number of elements of the tensor
+ */
+ORT_API_STATUS(OrtFillStringTensorFromBuffer, _In_ OrtValue* value, _In_ const void* s, size_t s_len,
+               _In_ const size_t* offsets, size_t offsets_len);
+
+/**
+ * Get a single string element without copying it.
+ * This is a no-copy method whose pointer is only valid until the backing OrtValue is modified or free'd.
+ * \param s the string is NOT null-terminated.
+ */
+ORT_API_STATUS(OrtGetStringTensorElement, _In_ const OrtValue* value, size_t index,
+               _Out_ const char** s, _Out_ size_t* len);
+
 ORT_API_STATUS(OrtTensorProtoToOrtValue, _Inout_ OrtAllocator* allocator,
                _In_ const void* input, int input_len, _Out_ OrtValue** out);
 
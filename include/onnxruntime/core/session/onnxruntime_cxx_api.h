@@ -75,6 +75,10 @@ class SessionOptionsWrapper {
   ORT_REDIRECT_SIMPLE_FUNCTION_CALL(DisableMemPattern)
   ORT_REDIRECT_SIMPLE_FUNCTION_CALL(EnableCpuMemArena)
   ORT_REDIRECT_SIMPLE_FUNCTION_CALL(DisableCpuMemArena)
+  ORT_REDIRECT_SIMPLE_FUNCTION_CALL(EnableOptimizedModelCache)
+  ORT_REDIRECT_SIMPLE_FUNCTION_CALL(DisableOptimizedModelCache)
+  ORT_REDIRECT_SIMPLE_FUNCTION_CALL(EnableSharedInitializers)
+  ORT_REDIRECT_SIMPLE_FUNCTION_CALL(DisableSharedInitializers)
   void EnableProfiling(_In_ const char* profile_file_prefix) {
     OrtEnableProfiling(value.get(), profile_file_prefix);
   }
@@ -88,6 +92,15 @@ class SessionOptionsWrapper {
   void SetSessionThreadPoolSize(int session_thread_pool_size) {
     OrtSetSessionThreadPoolSize(value.get(), session_thread_pool_size);
   }
+  void SetOperatorThreadPoolSize(int operator_thread_pool_size) {
+    OrtSetOperatorThreadPoolSize(value.get(), operator_thread_pool_size);
+  }
+  void SetLoadThreadPoolSize(int load_thread_pool_size) {
+    OrtSetLoadThreadPoolSize(value.get(), load_thread_pool_size);
+  }
+  void SetInitializerStore(_In_opt_ OrtInitializerStore* store) {
+    OrtSetInitializerStore(value.get(), store);
+  }
 
   /**
   * The order of invocation indicates the preference order as well. In other words call this method
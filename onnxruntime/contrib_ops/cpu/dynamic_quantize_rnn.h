@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cpu/rnn/deep_cpu_gru.h"
+#include "core/providers/cpu/rnn/deep_cpu_lstm.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// LSTM with W and R quantized to uint8 when the kernel is created.
+// The activations are quantized on each step and the gate projections use an integer GEMM.
+class DynamicQuantizeLSTM final : public DeepCpuLstmOp {
+ public:
+  DynamicQuantizeLSTM(const OpKernelInfo& info) : DeepCpuLstmOp(info, true) {}
+};
+
+// GRU with W and R quantized to uint8 when the kernel is created.
+// The activations are quantized on each step and the gate projections use an integer GEMM.
+class DynamicQuantizeGRU final : public DeepCpuGruOp {
+ public:
+  DynamicQuantizeGRU(const OpKernelInfo& info) : DeepCpuGruOp(info, true) {}
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "contrib_ops/cpu/gather_nd.h"
+#include "core/platform/threadpool.h"
+
+#include <atomic>
 
 namespace onnxruntime {
 namespace contrib     {
@@ -43,16 +46,15 @@ Status GatherNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) con
                input_shape.GetDims().begin() + last_indice_dimension,
                input_shape.GetDims().end());
   auto output_tensor = context->Output(0,TensorShape(shape));
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
   std::vector<int64_t> element_counts(last_indice_dimension, 0LL); // Number of elements for each input dimension
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
   for (int64_t i = 0; i < last_indice_dimension; ++i) {
     element_counts[i] = input_shape.SizeFromDimension(i + 1);
   }
 
-  int64_t err_indice = 0;
+  // written concurrently by the parallel loop below
+  std::atomic<int64_t> err_indice{0};
   p.element_bytes    = input_tensor->DataType()->Size();
   p.element_to_copy  = input_shape.SizeFromDimension(last_indice_dimension);
   p.bytes_to_copy    = p.element_bytes * p.element_to_copy;
@@ -68,20 +70,19 @@ Status GatherNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) con
     p.output_base     = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   }
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < offset_count; ++i) {
-    for (int64_t j = 0; j < last_indice_dimension; ++j) {
-      auto indice = *(indice_offset + i * last_indice_dimension + j);
-      if (indice < 0 || indice >= input_shape[j]) {
-        err_indice = indice;
+  concurrency::ThreadPool::TryParallelFor(tp, offset_count, static_cast<double>(last_indice_dimension), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (int64_t i = first; i < last; ++i) {
+      for (int64_t j = 0; j < last_indice_dimension; ++j) {
+        auto indice = *(indice_offset + i * last_indice_dimension + j);
+        if (indice < 0 || indice >= input_shape[j]) {
+          err_indice.store(indice);
+        }
+        p.element_offsets[i] += indice * element_counts[j];
       }
-      p.element_offsets[i] += indice * element_counts[j];
     }
-  }
-  return err_indice == 0 ? Status::OK() :
-    ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid indice found, indice = ", err_indice);
+  });
+  return err_indice.load() == 0 ? Status::OK() :
+    ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid indice found, indice = ", err_indice.load());
 }
 
 template Status GatherNDBase::PrepareForCompute<int32_t>(OpKernelContext*, Prepare&) const;
@@ -91,30 +92,29 @@ Status GatherND::Compute(OpKernelContext* context) const {
   Prepare p;
   ORT_RETURN_IF_ERROR(context->Input<Tensor>(1)->DataType() == DataTypeImpl::GetType<int32_t>() ? 
                               PrepareForCompute<int32_t>(context, p) : PrepareForCompute<int64_t>(context, p));
-  return nullptr == p.input_str_base ? GatherNumber(p) : GatherString(p);
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  return nullptr == p.input_str_base ? GatherNumber(p, tp) : GatherString(p, tp);
 }
 
-Status GatherND::GatherNumber(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    memcpy(p.output_base + i * p.bytes_to_copy,
-           p.input_base + p.element_offsets[i] * p.element_bytes,
-           p.bytes_to_copy);
-  }
+Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int64_t>(p.element_offsets.size()), static_cast<double>(p.bytes_to_copy), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (int64_t i = first; i < last; ++i) {
+      memcpy(p.output_base + i * p.bytes_to_copy,
+             p.input_base + p.element_offsets[i] * p.element_bytes,
+             p.bytes_to_copy);
+    }
+  });
   return Status::OK();
 }
 
-Status GatherND::GatherString(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
-      p.output_str_base[i * p.element_to_copy + j] = p.input_str_base[p.element_offsets[i] + j];
+Status GatherND::GatherString(const Prepare& p, concurrency::ThreadPool* tp) const {
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int64_t>(p.element_offsets.size()), static_cast<double>(p.element_to_copy * sizeof(std::string)), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (int64_t i = first; i < last; ++i) {
+      for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
+        p.output_str_base[i * p.element_to_copy + j] = p.input_str_base[p.element_offsets[i] + j];
+      }
     }
-  }
+  });
   return Status::OK();
 }
 
@@ -1,14 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#ifdef _MSC_VER
-#pragma warning(disable : 4244)
-#pragma warning(disable : 4267)
-#endif
-
 #include "contrib_ops/cpu/matmul_integer.h"
 #include "core/providers/cpu/math/matmul_helper.h"
-#include "public/gemmlowp.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -21,30 +16,47 @@ ONNX_OPERATOR_KERNEL_EX(
     kCpuExecutionProvider,
     KernelDefBuilder()
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
-        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", std::vector<MLDataType>{DataTypeImpl::GetTensorType<uint8_t>(),
+                                                      DataTypeImpl::GetTensorType<int8_t>()})
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
-    MatMulInteger<uint8_t, uint8_t, int32_t>);
-
-Status GemmlowpMultiply(const uint8_t* lhs_data, const uint8_t* rhs_data,
-                        int32_t* result_data, const int lhs_offset, const int rhs_offset,
-                        int m, int n, int k) {
-  const std::tuple<> empty_pipeline = {};
-  // TODO exp ColMajor order for rhs and result. That may be faster
-  const auto matOrder = gemmlowp::MapOrder::RowMajor;
-  gemmlowp::MatrixMap<const std::uint8_t, matOrder> lhs(lhs_data, m, k);
-  gemmlowp::MatrixMap<const std::uint8_t, matOrder> rhs(rhs_data, k, n);
-  gemmlowp::MatrixMap<std::int32_t, matOrder> result(result_data, m, n);
-
-  gemmlowp::GemmContext gemm_context;
-  gemmlowp::GemmWithOutputPipeline<std::uint8_t, std::int32_t,
-                                   gemmlowp::DefaultL8R8BitDepthParams>(
-      &gemm_context, lhs, rhs, &result, -lhs_offset, -rhs_offset, empty_pipeline);
+    MatMulInteger);
 
-  return Status::OK();
+static bool IsScalarZeroPoint(const Tensor& zero_point) {
+  const auto& shape = zero_point.Shape();
+  return shape.NumDimensions() == 0 || (shape.NumDimensions() == 1 && shape[0] == 1);
 }
 
-template<>
-Status MatMulInteger<uint8_t, uint8_t, int32_t>::Compute(OpKernelContext* ctx) const {
+MatMulInteger::MatMulInteger(const OpKernelInfo& info) : OpKernel(info) {
+  has_a_zero_point_ = info.GetInputCount() > 2;
+  has_b_zero_point_ = info.GetInputCount() > 3;
+
+  // pack B once if it's a constant 2-D initializer, which is the common case of MatMulInteger
+  // applying quantized weights. the zero point is folded into the packed data so it must be constant too.
+  const Tensor* b;
+  if (!info.TryGetConstantInput(1, &b) || b->Shape().NumDimensions() != 2) {
+    return;
+  }
+
+  uint8_t b_offset = 0;
+  if (has_b_zero_point_) {
+    const Tensor* b_zero_point;
+    if (!info.TryGetConstantInput(3, &b_zero_point) || !IsScalarZeroPoint(*b_zero_point)) {
+      return;
+    }
+    b_offset = *static_cast<const uint8_t*>(b_zero_point->DataRaw());
+  }
+
+  const size_t K = static_cast<size_t>(b->Shape()[0]);
+  const size_t N = static_cast<size_t>(b->Shape()[1]);
+  const bool b_is_signed = b->DataType() == DataTypeImpl::GetType<int8_t>();
+
+  auto alloc = info.GetAllocator(0, OrtMemTypeDefault);
+  auto* packed_b_data = alloc->Alloc(MlasQgemmPackBSize(N, K));
+  packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasQgemmPackB(N, K, static_cast<const uint8_t*>(b->DataRaw()), N, b_offset, b_is_signed, packed_b_.get());
+}
+
+Status MatMulInteger::Compute(OpKernelContext* ctx) const {
   auto a = ctx->Input<Tensor>(0);
   auto b = ctx->Input<Tensor>(1);
   ORT_ENFORCE(a != nullptr && b != nullptr);
@@ -54,35 +66,43 @@ Status MatMulInteger<uint8_t, uint8_t, int32_t>::Compute(OpKernelContext* ctx) c
   Tensor* y = ctx->Output(0, helper.OutputShape());
 
   // validate zero points
-  int32_t a_offset = 0;
-  int32_t b_offset = 0;
+  uint8_t a_offset = 0;
+  uint8_t b_offset = 0;
   if (has_a_zero_point_) {
     auto a_zero_point = ctx->Input<Tensor>(2);
-    ORT_ENFORCE(a_zero_point->Shape().NumDimensions() == 0 || 
-        (a_zero_point->Shape().NumDimensions() == 1 && a_zero_point->Shape().GetDims().size() == 1), 
-        "Currently only scalar zero_point is supported. TODO: add per channel zero point support.");
-    a_offset = static_cast<int32_t>(*a_zero_point->template Data<uint8_t>());
+    ORT_ENFORCE(IsScalarZeroPoint(*a_zero_point),
+                "Currently only scalar zero_point is supported. TODO: add per channel zero point support.");
+    a_offset = *a_zero_point->template Data<uint8_t>();
   }
   if (has_b_zero_point_) {
     auto b_zero_point = ctx->Input<Tensor>(3);
-    ORT_ENFORCE(b_zero_point->Shape().NumDimensions() == 0 || 
-        (b_zero_point->Shape().NumDimensions() == 1 && b_zero_point->Shape().GetDims().size() == 1),
-        "Currently only scalar zero_point is supported. TODO: add per channel zero point support.");
-    b_offset = static_cast<int32_t>(*b_zero_point->template Data<uint8_t>());
+    ORT_ENFORCE(IsScalarZeroPoint(*b_zero_point),
+                "Currently only scalar zero_point is supported. TODO: add per channel zero point support.");
+    b_offset = *static_cast<const uint8_t*>(b_zero_point->DataRaw());
   }
 
-  for (int i = 0; i < helper.OutputOffsets().size(); i++) {
-    GemmlowpMultiply(a->template Data<uint8_t>() + helper.LeftOffsets()[i],
-                     b->template Data<uint8_t>() + helper.RightOffsets()[i],
-                     y->template MutableData<int32_t>() + helper.OutputOffsets()[i],
-                     a_offset,
-                     b_offset,
-                     static_cast<int>(helper.M()),
-                     static_cast<int>(helper.N()),
-                     static_cast<int>(helper.K()));
+  const bool b_is_signed = b->DataType() == DataTypeImpl::GetType<int8_t>();
+  const auto* a_data = a->template Data<uint8_t>();
+  const auto* b_data = static_cast<const uint8_t*>(b->DataRaw());
+  auto* y_data = y->template MutableData<int32_t>();
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+    if (packed_b_) {
+      // B is 2-D so every right offset is 0
+      MlasQgemmPacked(M, N, K, a_data + helper.LeftOffsets()[i], K, a_offset, packed_b_.get(),
+                      y_data + helper.OutputOffsets()[i], N);
+    } else {
+      MlasQgemm(M, N, K, a_data + helper.LeftOffsets()[i], K, a_offset,
+                b_data + helper.RightOffsets()[i], N, b_offset, b_is_signed,
+                y_data + helper.OutputOffsets()[i], N);
+    }
   }
 
   return Status::OK();
 }
 }  // namespace contrib
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
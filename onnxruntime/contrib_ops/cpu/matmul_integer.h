@@ -10,25 +10,19 @@
 namespace onnxruntime {
 namespace contrib {
 
-template <typename T1, typename T2, typename T3>
 class MatMulInteger final : public OpKernel {
  public:
-  MatMulInteger(const OpKernelInfo& info) : OpKernel(info) {
-    has_a_zero_point_ = false;
-    has_b_zero_point_ = false;
-    if (info.GetInputCount() > 2) {
-      has_a_zero_point_ = true;      
-    }
-    if (info.GetInputCount() > 3) {
-      has_b_zero_point_ = true;
-    }
-  }
+  MatMulInteger(const OpKernelInfo& info);
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
   bool has_a_zero_point_;
   bool has_b_zero_point_;
+
+  // B packed by MlasQgemmPackB with its zero point applied. only set when B and its zero point are
+  // constant initializers and B is 2-D.
+  BufferUniquePtr packed_b_;
 };
 }  // namespace contrib
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
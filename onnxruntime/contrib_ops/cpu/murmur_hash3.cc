@@ -103,7 +103,8 @@ ONNX_OPERATOR_KERNEL_EX(
                                                       DataTypeImpl::GetTensorType<uint32_t>(),
                                                       DataTypeImpl::GetTensorType<std::string>()})
         .TypeConstraint("T2", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(),
-                                                      DataTypeImpl::GetTensorType<uint32_t>()}),
+                                                      DataTypeImpl::GetTensorType<uint32_t>()})
+        .CompactStringInput(0),
     MurmurHash3);
 
 void MurmurHash3::MurmurHash3_x86_32(const void* key, int len, uint32_t seed, void* out) const {
@@ -170,11 +171,10 @@ Status MurmurHash3::Compute(OpKernelContext* ctx) const {
   const int64_t input_count = input_shape.Size();
   for (int i = 0; i < input_count; ++i) {
     if (DataTypeImpl::GetType<std::string>() == keys_type) {
-      auto input = keys->DataRaw();
       auto output = output_tensor->MutableDataRaw();
-      auto input_string = reinterpret_cast<const std::string*>(input)[i];
-      MurmurHash3_x86_32(input_string.c_str(),
-                         static_cast<int>(input_string.length()),
+      auto input_string = keys->StringElement(i);
+      MurmurHash3_x86_32(input_string.data(),
+                         static_cast<int>(input_string.size()),
                          seed_,
                          reinterpret_cast<uint32_t*>(output) + static_cast<int64_t>(i) * output_element_bytes);
     } else {
@@ -12,7 +12,8 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #include "contrib_ops/cpu/non_max_suppression.h"
-#include <queue>
+#include <algorithm>
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -27,48 +28,68 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
     NonMaxSuppression<float>);
 
 template <typename T>
-void NonMaxSuppression<T>::MaxMin(const T& lhs, const T& rhs, T& min, T& max) const {
-  if (lhs >= rhs) {
-    min = rhs;
-    max = lhs;
-  } else {
-    min = lhs;
-    max = rhs;
-  }
-}
+void NonMaxSuppression<T>::SelectBoxes(const T* boxes_data, const T* scores_data, int64_t num_boxes,
+                                       std::vector<int32_t>& selected_indices) const {
+  struct ScoreIndexPair {
+    T score;
+    int32_t index;
+  };
 
-template <typename T>
-bool NonMaxSuppression<T>::SuppressByIOU(const T* boxes_data, int32_t box_index1, int32_t box_index2) const {
-  T x1_min, y1_min, x1_max, y1_max, x2_min, y2_min, x2_max, y2_max;
-  // boxes data [y1, x1, y2, x2],
-  MaxMin(boxes_data[4 * box_index1 + 1], boxes_data[4 * box_index1 + 3], x1_min, x1_max);
-  MaxMin(boxes_data[4 * box_index1 + 0], boxes_data[4 * box_index1 + 2], y1_min, y1_max);
-  MaxMin(boxes_data[4 * box_index2 + 1], boxes_data[4 * box_index2 + 3], x2_min, x2_max);
-  MaxMin(boxes_data[4 * box_index2 + 0], boxes_data[4 * box_index2 + 2], y2_min, y2_max);
-
-  const T intersection_x_min = std::max(x1_min, x2_min);
-  const T intersection_y_min = std::max(y1_min, y2_min);
-  const T intersection_x_max = std::min(x1_max, x2_max);
-  const T intersection_y_max = std::min(y1_max, y2_max);
-
-  const T intersection_area = std::max(intersection_x_max - intersection_x_min, static_cast<T>(0.0)) *
-                              std::max(intersection_y_max - intersection_y_min, static_cast<T>(0.0));
-
-  if (intersection_area <= static_cast<T>(0.0)) {
-    return false;
+  // Filter by score_threshold_ before sorting, ties are broken by the lower box index
+  std::vector<ScoreIndexPair> candidates;
+  for (int32_t i = 0; i < num_boxes; ++i) {
+    if (static_cast<float>(scores_data[i]) > score_threshold_) {
+      candidates.push_back(ScoreIndexPair({scores_data[i], i}));
+    }
   }
+  std::sort(candidates.begin(), candidates.end(), [](const ScoreIndexPair& lhs, const ScoreIndexPair& rhs) {
+    return lhs.score > rhs.score || (lhs.score == rhs.score && lhs.index < rhs.index);
+  });
+
+  // The selected boxes are kept as separate coordinate arrays so that the overlap test of a candidate
+  // against all of them is a straight loop the compiler can vectorize.
+  const size_t max_selected = static_cast<size_t>(std::min<int64_t>(max_output_size_, candidates.size()));
+  std::vector<T> selected_x_min(max_selected), selected_y_min(max_selected);
+  std::vector<T> selected_x_max(max_selected), selected_y_max(max_selected);
+  std::vector<T> selected_area(max_selected);
+  size_t num_selected = 0;
+
+  const T iou_threshold = static_cast<T>(iou_threshold_);
+
+  for (size_t c = 0; c < candidates.size() && num_selected < max_selected; ++c) {
+    // boxes data [y1, x1, y2, x2], the corners may be given in either order
+    const T* box = boxes_data + 4 * candidates[c].index;
+    const T x_min = std::min(box[1], box[3]);
+    const T x_max = std::max(box[1], box[3]);
+    const T y_min = std::min(box[0], box[2]);
+    const T y_max = std::max(box[0], box[2]);
+    const T area = (x_max - x_min) * (y_max - y_min);
+
+    // Suppress if the IOU (Intersection Over Union) with a selected box exceeds iou_threshold_. Boxes
+    // without area never overlap.
+    int suppressed = 0;
+    for (size_t i = 0; i < num_selected; ++i) {
+      const T intersection_width = std::min(selected_x_max[i], x_max) - std::max(selected_x_min[i], x_min);
+      const T intersection_height = std::min(selected_y_max[i], y_max) - std::max(selected_y_min[i], y_min);
+      const T intersection_area = std::max(intersection_width, static_cast<T>(0.0)) *
+                                  std::max(intersection_height, static_cast<T>(0.0));
+      const T union_area = selected_area[i] + area - intersection_area;
+      suppressed |= static_cast<int>(intersection_area > static_cast<T>(0.0)) &
+                    static_cast<int>(selected_area[i] > static_cast<T>(0.0)) &
+                    static_cast<int>(union_area > static_cast<T>(0.0)) &
+                    static_cast<int>(intersection_area / union_area > iou_threshold);
+    }
 
-  const T area1 = (x1_max - x1_min) * (y1_max - y1_min);
-  const T area2 = (x2_max - x2_min) * (y2_max - y2_min);
-  const T union_area = area1 + area2 - intersection_area;
-
-  if (area1 <= static_cast<T>(0.0) || area2 <= static_cast<T>(0.0) || union_area <= static_cast<T>(0.0)) {
-    return false;
+    if (suppressed == 0 || area <= static_cast<T>(0.0)) {
+      selected_x_min[num_selected] = x_min;
+      selected_y_min[num_selected] = y_min;
+      selected_x_max[num_selected] = x_max;
+      selected_y_max[num_selected] = y_max;
+      selected_area[num_selected] = area;
+      ++num_selected;
+      selected_indices.push_back(candidates[c].index);
+    }
   }
-
-  const T intersection_over_union = intersection_area / union_area;
-
-  return intersection_over_union > iou_threshold_;
 }
 
 template <typename T>
@@ -80,16 +101,35 @@ Status NonMaxSuppression<T>::Compute(OpKernelContext* ctx) const {
 
   const TensorShape& boxes_shape = boxes->Shape();
   auto boxes_dims = boxes_shape.GetDims();
-  ORT_RETURN_IF_NOT(boxes_shape.NumDimensions() == 2, "boxes must be a 2D tensor.");
-  int64_t num_boxes = boxes_dims[0];
-  ORT_RETURN_IF_NOT(boxes_dims[1] == 4, "boxes shape must be a 2D tensor with shape [num_boxes, 4].");
-
   const TensorShape& scores_shape = scores->Shape();
-  ORT_RETURN_IF_NOT(scores_shape.NumDimensions() == 1, "boxes must be a 1D tensor.");
-  ORT_RETURN_IF_NOT(scores_shape.GetDims()[0] == num_boxes, "scores and boxes should have same num_boxes.");
+  auto scores_dims = scores_shape.GetDims();
+
+  // The boxes are either [num_boxes, 4] with scores [num_boxes], or batched as [num_batches, num_boxes, 4]
+  // with scores [num_batches, num_classes, num_boxes].
+  const bool batched = boxes_shape.NumDimensions() == 3;
+  int64_t num_batches = 1;
+  int64_t num_classes = 1;
+  int64_t num_boxes;
+
+  if (batched) {
+    num_batches = boxes_dims[0];
+    num_boxes = boxes_dims[1];
+    ORT_RETURN_IF_NOT(boxes_dims[2] == 4, "boxes shape must be a 3D tensor with shape [num_batches, num_boxes, 4].");
+    ORT_RETURN_IF_NOT(scores_shape.NumDimensions() == 3, "scores must be a 3D tensor for 3D boxes.");
+    ORT_RETURN_IF_NOT(scores_dims[0] == num_batches, "scores and boxes should have same num_batches.");
+    ORT_RETURN_IF_NOT(scores_dims[2] == num_boxes, "scores and boxes should have same num_boxes.");
+    ORT_RETURN_IF_NOT(pad_to_max_output_size_ != 1, "pad_to_max_output_size is not supported for 3D boxes.");
+    num_classes = scores_dims[1];
+  } else {
+    ORT_RETURN_IF_NOT(boxes_shape.NumDimensions() == 2, "boxes must be a 2D tensor.");
+    num_boxes = boxes_dims[0];
+    ORT_RETURN_IF_NOT(boxes_dims[1] == 4, "boxes shape must be a 2D tensor with shape [num_boxes, 4].");
+    ORT_RETURN_IF_NOT(scores_shape.NumDimensions() == 1, "boxes must be a 1D tensor.");
+    ORT_RETURN_IF_NOT(scores_dims[0] == num_boxes, "scores and boxes should have same num_boxes.");
+  }
 
-  if (max_output_size_ <= 0 || boxes_dims[0] == 0) {
-    TensorShape output_shape({0});
+  if (max_output_size_ <= 0 || num_boxes == 0) {
+    TensorShape output_shape = batched ? TensorShape({0, 3}) : TensorShape({0});
     ctx->Output(0, output_shape);
     return Status::OK();
   }
@@ -97,57 +137,45 @@ Status NonMaxSuppression<T>::Compute(OpKernelContext* ctx) const {
   const T* boxes_data = boxes->Data<T>();
   const T* scores_data = scores->Data<T>();
 
-  struct ScoreIndexPair {
-    T score;
-    int32_t index;
-  };
-
-  auto LessCompare = [](const ScoreIndexPair& lhs, const ScoreIndexPair& rhs) {
-    return lhs.score < rhs.score;
-  };
-
-  // Filter by score_threshold_
-  std::priority_queue<ScoreIndexPair, std::deque<ScoreIndexPair>, decltype(LessCompare)> sorted_scores_with_index(LessCompare);
-  for (int32_t i = 0; i < num_boxes; ++i) {
-    if (static_cast<float>(scores_data[i]) > score_threshold_) {
-      sorted_scores_with_index.emplace(ScoreIndexPair({scores_data[i], i}));
+  // Every batch and class is suppressed independently
+  const int64_t num_selections = num_batches * num_classes;
+  std::vector<std::vector<int32_t>> selected_indices(num_selections);
+  concurrency::ThreadPool::TryParallelFor(ctx->GetOperatorThreadPool(), num_selections, static_cast<double>(num_boxes * 16), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t i = first; i < last; ++i) {
+      SelectBoxes(boxes_data + (i / num_classes) * num_boxes * 4, scores_data + i * num_boxes, num_boxes, selected_indices[i]);
     }
+  });
+
+  int64_t num_of_selected = 0;
+  for (const auto& indices : selected_indices) {
+    num_of_selected += indices.size();
   }
 
-  int num_of_selected = 0;
-  std::vector<int32_t> selected_index(max_output_size_, 0);
-  ScoreIndexPair next_top_score;
-
-  // Get the next box with top score, filter by iou_threshold_
-  while (num_of_selected < max_output_size_ && !sorted_scores_with_index.empty()) {
-    next_top_score = sorted_scores_with_index.top();
-    sorted_scores_with_index.pop();
-
-    bool selected = true;
-    // Check with existing boxes, suppress if exceed the IOU (Intersection Over Union) threshold
-    for (int i = num_of_selected - 1; i >= 0; --i) {
-      if (SuppressByIOU(boxes_data, selected_index[i], next_top_score.index)) {
-        selected = false;
-        break;
+  if (batched) {
+    // Each selection is reported as [batch_index, class_index, box_index]
+    Tensor* output = ctx->Output(0, TensorShape({num_of_selected, 3}));
+    auto output_data = output->MutableData<int32_t>();
+    for (int64_t i = 0; i < num_selections; ++i) {
+      for (int32_t index : selected_indices[i]) {
+        *output_data++ = static_cast<int32_t>(i / num_classes);
+        *output_data++ = static_cast<int32_t>(i % num_classes);
+        *output_data++ = index;
       }
     }
-
-    if (selected) {
-      selected_index[num_of_selected] = next_top_score.index;
-      ++num_of_selected;
+  } else {
+    int64_t num_to_copy = pad_to_max_output_size_ == 1 ? max_output_size_ : num_of_selected;
+    Tensor* output = ctx->Output(0, TensorShape({num_to_copy}));
+    auto output_data = output->MutableData<int32_t>();
+    std::fill_n(output_data, num_to_copy, 0);
+    if (num_of_selected > 0) {
+      memcpy(output_data, selected_indices[0].data(), num_of_selected * sizeof(int32_t));
     }
   }
 
-  int64_t num_to_copy = pad_to_max_output_size_ == 1 ? max_output_size_ : num_of_selected;
-  TensorShape output_shape({num_to_copy});
-  Tensor* selected_indices = ctx->Output(0, output_shape);
-  auto output_data = selected_indices->MutableData<int32_t>();
-  memcpy(output_data, selected_index.data(), num_to_copy * sizeof(int32_t));
-
   TensorShape valid_outputs_shape({1});
   Tensor* valid_outputs = ctx->Output(1, valid_outputs_shape);
   if (valid_outputs) {
-    valid_outputs->MutableData<int32_t>()[0] = num_of_selected;
+    valid_outputs->MutableData<int32_t>()[0] = static_cast<int32_t>(num_of_selected);
   }
 
   return Status::OK();
@@ -24,8 +24,8 @@ class NonMaxSuppression final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
 private:
-  bool SuppressByIOU(const T* boxes_data, int32_t box_index1, int32_t box_index2) const;
-  void MaxMin(const T& lhs, const T& rhs, T& min, T& max) const;
+  // Runs the suppression for the boxes of one batch and class, appending the selected box indices in order.
+  void SelectBoxes(const T* boxes_data, const T* scores_data, int64_t num_boxes, std::vector<int32_t>& selected_indices) const;
 
 private :
   int64_t max_output_size_;
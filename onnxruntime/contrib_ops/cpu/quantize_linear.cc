@@ -5,10 +5,48 @@
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/providers/cpu/tensor/cast_op.h"
 #include "core/providers/common.h"
+#include "core/platform/threadpool.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+
+// the elements along the quantization axis are split into blocks that share a scale and zero point. without an axis
+// the whole tensor is a single block. blocks are split into chunks of at most kQuantizeChunkSize elements so that
+// per-tensor quantization of a large tensor is also spread across the operator thread pool.
+// fn(offset, count, channel) is called for each chunk, where channel indexes the scale and zero point.
+constexpr size_t kQuantizeChunkSize = 16384;
+
+void ForEachQuantizeChunk(concurrency::ThreadPool* tp, const TensorShape& shape, int64_t axis, bool has_axis,
+                          const std::function<void(size_t, size_t, size_t)>& fn) {
+  size_t block_count = 1;
+  size_t broadcast_dim = 1;
+  size_t block_size = static_cast<size_t>(shape.Size());
+  if (has_axis) {
+    broadcast_dim = static_cast<size_t>(shape[axis]);
+    block_count = static_cast<size_t>(shape.SizeToDimension(axis)) * broadcast_dim;
+    block_size = static_cast<size_t>(shape.SizeFromDimension(axis + 1));
+  }
+
+  const size_t chunks_per_block = (block_size + kQuantizeChunkSize - 1) / kQuantizeChunkSize;
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(block_count * chunks_per_block),
+      static_cast<double>(std::min(block_size, kQuantizeChunkSize)),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t unit = first; unit < last; ++unit) {
+          const size_t block = static_cast<size_t>(unit) / chunks_per_block;
+          const size_t chunk_start = (static_cast<size_t>(unit) % chunks_per_block) * kQuantizeChunkSize;
+          fn(block * block_size + chunk_start, std::min(kQuantizeChunkSize, block_size - chunk_start),
+             block % broadcast_dim);
+        }
+      });
+}
+
+}  // namespace
+
 ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
     DequantizeLinear,
     1,
@@ -46,43 +84,27 @@ Status DequantizeLinear<T>::Compute(OpKernelContext* ctx) const {
   const auto& zero_point_shape = x_zero_point.Shape();
   const int64_t axis = HandleNegativeAxis(axis_, x_shape.NumDimensions());
 
-  size_t stride = 0;
   const auto& broadcastDim = x_shape[axis];
 
   if (has_axis_) {
     // if an axis was specified, ensure the scale and zero point are compatible
     ORT_ENFORCE(scale_shape.NumDimensions() == 1 && scale_shape.Size() == broadcastDim, "x_scale must be 1D tensor with size ", broadcastDim);
     ORT_ENFORCE(zero_point_shape.NumDimensions() == 1 && zero_point_shape.Size() == broadcastDim, "x_zero_point must be 1D tensor with size ", broadcastDim);
-    stride = 1;
   } else {
     // if no axis, enforce that scale and zero point are scalars
     ORT_ENFORCE(scale_shape.NumDimensions() == 0, "x_scale must be a scalar if no axis is provided");
     ORT_ENFORCE(zero_point_shape.NumDimensions() == 0, "x_zero_point must be a scalar if no axis is provided");
   }
 
-  size_t N = x_shape.SizeToDimension(axis);
   const T* zero_point = x_zero_point.template Data<T>();
   const float* scale = x_scale.template Data<float>();
-  size_t block_size = x_shape.SizeFromDimension(axis + 1);
   const T* input = x.template Data<T>();
   float* output = y.template MutableData<float>();
 
-  for (size_t n = 0; n < N; n++) {
-    const float* current_scale = scale;
-    const T* current_zero_point = zero_point;
-
-    for (size_t bd = 0; bd < static_cast<size_t>(broadcastDim); bd++) {
-      auto zp = static_cast<const int>(*current_zero_point);
-      auto sc = *current_scale;
-
-      for (size_t bs = 0; bs < block_size; bs++) {
-        *output++ = static_cast<float>(static_cast<const int>(*input++) - zp) * sc;
-      }
-
-      current_scale += stride;
-      current_zero_point += stride;
-    }
-  }
+  ForEachQuantizeChunk(ctx->GetOperatorThreadPool(), x_shape, axis, has_axis_,
+                       [&](size_t offset, size_t count, size_t channel) {
+                         MlasDequantizeLinear(input + offset, output + offset, count, scale[channel], zero_point[channel]);
+                       });
 
   return Status::OK();
 }
@@ -90,26 +112,30 @@ Status DequantizeLinear<T>::Compute(OpKernelContext* ctx) const {
 ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
     QuantizeLinear,
     1,
-    float,
+    uint8_t,
     KernelDefBuilder()
         .TypeConstraint("axis", DataTypeImpl::GetType<int64_t>())
         .TypeConstraint("x", DataTypeImpl::GetTensorType<float>())
         .TypeConstraint("y_scale", DataTypeImpl::GetTensorType<float>())
         .TypeConstraint("y_zero_point", DataTypeImpl::GetTensorType<uint8_t>())
         .TypeConstraint("y", DataTypeImpl::GetTensorType<uint8_t>()),
-    QuantizeLinear<float>);
-
-// clamp doesn't exist in the version of <algorithm> that we're using, so
-// make a local one.
-static float clamp(float v, float lo, float hi) {
-  if (v < lo) return lo;
-  if (v > hi) return hi;
-  return v;
-}
+    QuantizeLinear<uint8_t>);
 
-template <>
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    QuantizeLinear,
+    1,
+    int8_t,
+    KernelDefBuilder()
+        .TypeConstraint("axis", DataTypeImpl::GetType<int64_t>())
+        .TypeConstraint("x", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("y_scale", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("y_zero_point", DataTypeImpl::GetTensorType<int8_t>())
+        .TypeConstraint("y", DataTypeImpl::GetTensorType<int8_t>()),
+    QuantizeLinear<int8_t>);
+
+template <typename T>
 // formula is Y = X / Scale + ZeroPoint
-Status QuantizeLinear<float>::Compute(OpKernelContext* ctx) const {
+Status QuantizeLinear<T>::Compute(OpKernelContext* ctx) const {
   auto& x = *ctx->Input<Tensor>(0);
   auto& y_scale = *ctx->Input<Tensor>(1);
   auto& y_zero_point = *ctx->Input<Tensor>(2);
@@ -120,43 +146,27 @@ Status QuantizeLinear<float>::Compute(OpKernelContext* ctx) const {
   const auto& zero_point_shape = y_zero_point.Shape();
   const int64_t axis = HandleNegativeAxis(axis_, x_shape.NumDimensions());
 
-  size_t stride = 0;
   const auto& broadcastDim = x_shape[axis];
 
   if (has_axis_) {
     // if an axis was specified, ensure the scale and zero point are compatible
     ORT_ENFORCE(scale_shape.NumDimensions() == 1 && scale_shape.Size() == broadcastDim, "x_scale must be 1D tensor with size ", broadcastDim);
     ORT_ENFORCE(zero_point_shape.NumDimensions() == 1 && zero_point_shape.Size() == broadcastDim, "x_zero_point must be 1D tensor with size ", broadcastDim);
-    stride = 1;
   } else {
     // if no axis, enforce that scale and zero point are scalars
     ORT_ENFORCE(scale_shape.NumDimensions() == 0, "x_scale must be a scalar if no axis is provided");
     ORT_ENFORCE(zero_point_shape.NumDimensions() == 0, "x_zero_point must be a scalar if no axis is provided");
   }
 
-  size_t N = x_shape.SizeToDimension(axis);
-  const uint8_t* zero_point = y_zero_point.template Data<uint8_t>();
+  const T* zero_point = y_zero_point.template Data<T>();
   const float* scale = y_scale.template Data<float>();
-  size_t block_size = x_shape.SizeFromDimension(axis + 1);
   const float* input = x.template Data<float>();
-  uint8_t* output = y.template MutableData<uint8_t>();
-
-  for (size_t n = 0; n < N; n++) {
-    const float* current_scale = scale;
-    const uint8_t* current_zero_point = zero_point;
+  T* output = y.template MutableData<T>();
 
-    for (size_t bd = 0; bd < static_cast<size_t>(broadcastDim); bd++) {
-      float zp = *current_zero_point;
-      auto sc = *current_scale;
-
-      for (size_t bs = 0; bs < block_size; bs++) {
-        *output++ = static_cast<uint8_t>(clamp(std::round(static_cast<float>(*input++) / sc) + zp, 0.0f, float(UINT8_MAX)));
-      }
-
-      current_scale += stride;
-      current_zero_point += stride;
-    }
-  }
+  ForEachQuantizeChunk(ctx->GetOperatorThreadPool(), x_shape, axis, has_axis_,
+                       [&](size_t offset, size_t count, size_t channel) {
+                         MlasQuantizeLinear(input + offset, output + offset, count, scale[channel], zero_point[channel]);
+                       });
 
   return Status::OK();
 }
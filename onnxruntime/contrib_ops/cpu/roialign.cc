@@ -18,6 +18,7 @@
 #include "roialign.h"
 #include "core/util/math_cpuonly.h"
 #include "core/common/common.h"
+#include "core/platform/threadpool.h"
 #include "core/framework/tensor.h"
 
 namespace onnxruntime {
@@ -160,108 +161,107 @@ void ROIAlignForward(
     const T* bottom_rois,
     int64_t roi_cols,
     T* top_data,
-    const std::string& mode) {
+    const std::string& mode,
+    concurrency::ThreadPool* tp) {
   int64_t n_rois = nthreads / channels / pooled_width / pooled_height;
+  const bool avg_mode = mode == "avg";
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int n = 0; n < n_rois; n++) {
-    int64_t index_n = n * channels * pooled_width * pooled_height;
-
-    const T* offset_bottom_rois = bottom_rois + n * roi_cols;
-    const T roi_batch_ind = offset_bottom_rois[0];
-    offset_bottom_rois++;
-
-    // Do not using rounding; this implementation detail is critical
-    T roi_start_w = offset_bottom_rois[0] * spatial_scale;
-    T roi_start_h = offset_bottom_rois[1] * spatial_scale;
-    T roi_end_w = offset_bottom_rois[2] * spatial_scale;
-    T roi_end_h = offset_bottom_rois[3] * spatial_scale;
-
-    // Force malformed ROIs to be 1x1
-    T roi_width = std::max(roi_end_w - roi_start_w, (T)1.);
-    T roi_height = std::max(roi_end_h - roi_start_h, (T)1.);
-    T bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
-    T bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
-
-    // We use roi_bin_grid to sample the grid and mimic integral
-    int64_t roi_bin_grid_h = (sampling_ratio > 0)
-                                 ? sampling_ratio
-                                 : static_cast<int64_t>(ceil(roi_height / pooled_height));  // e.g., = 2
-    int64_t roi_bin_grid_w =
-        (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(ceil(roi_width / pooled_width));
-
-    // We do average (integral) pooling inside a bin
-    const int64_t count = roi_bin_grid_h * roi_bin_grid_w;  // e.g. = 4
+  // rough cost of one output element, used to decide how to split the ROIs and channels across threads
+  const int64_t roi_bin_grid_cost = sampling_ratio > 0 ? sampling_ratio * sampling_ratio * 4 : 16;
 
+  // The work is split over ROI x channel so that a few ROIs with many channels still use every thread.
+  concurrency::ThreadPool::TryParallelFor(tp, n_rois * channels, static_cast<double>(pooled_width * pooled_height * roi_bin_grid_cost), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
     // we want to precalculate indices and weights shared by all channels,
-    // this is the key point of optimization
-    std::vector<PreCalc<T>> pre_calc(
-        roi_bin_grid_h * roi_bin_grid_w * pooled_width * pooled_height);
-    pre_calc_for_bilinear_interpolate(
-        height,
-        width,
-        pooled_height,
-        pooled_width,
-        roi_bin_grid_h,
-        roi_bin_grid_w,
-        roi_start_h,
-        roi_start_w,
-        bin_size_h,
-        bin_size_w,
-        roi_bin_grid_h,
-        roi_bin_grid_w,
-        pre_calc);
-
-    for (int64_t c = 0; c < channels; c++) {
-      int64_t index_n_c = index_n + c * pooled_width * pooled_height;
+    // this is the key point of optimization. The table of the current ROI
+    // is kept while consecutive items of this range stay on the same ROI.
+    std::vector<PreCalc<T>> pre_calc;
+    int64_t pre_calc_roi = -1;
+    int64_t roi_bin_grid_h = 0;
+    int64_t roi_bin_grid_w = 0;
+    T roi_batch_ind = 0;
+
+    for (std::ptrdiff_t i = first; i < last; ++i) {
+      const int64_t n = i / channels;
+      const int64_t c = i % channels;
+
+      if (n != pre_calc_roi) {
+        const T* offset_bottom_rois = bottom_rois + n * roi_cols;
+        roi_batch_ind = offset_bottom_rois[0];
+        offset_bottom_rois++;
+
+        // Do not using rounding; this implementation detail is critical
+        T roi_start_w = offset_bottom_rois[0] * spatial_scale;
+        T roi_start_h = offset_bottom_rois[1] * spatial_scale;
+        T roi_end_w = offset_bottom_rois[2] * spatial_scale;
+        T roi_end_h = offset_bottom_rois[3] * spatial_scale;
+
+        // Force malformed ROIs to be 1x1
+        T roi_width = std::max(roi_end_w - roi_start_w, (T)1.);
+        T roi_height = std::max(roi_end_h - roi_start_h, (T)1.);
+        T bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
+        T bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
+
+        // We use roi_bin_grid to sample the grid and mimic integral
+        roi_bin_grid_h = (sampling_ratio > 0)
+                             ? sampling_ratio
+                             : static_cast<int64_t>(ceil(roi_height / pooled_height));  // e.g., = 2
+        roi_bin_grid_w =
+            (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(ceil(roi_width / pooled_width));
+
+        pre_calc.resize(roi_bin_grid_h * roi_bin_grid_w * pooled_width * pooled_height);
+        pre_calc_for_bilinear_interpolate(
+            height,
+            width,
+            pooled_height,
+            pooled_width,
+            roi_bin_grid_h,
+            roi_bin_grid_w,
+            roi_start_h,
+            roi_start_w,
+            bin_size_h,
+            bin_size_w,
+            roi_bin_grid_h,
+            roi_bin_grid_w,
+            pre_calc);
+        pre_calc_roi = n;
+      }
+
+      // We do average (integral) pooling inside a bin
+      const int64_t count = roi_bin_grid_h * roi_bin_grid_w;  // e.g. = 4
+
+      T* offset_top_data = top_data + i * pooled_width * pooled_height;
       const T* offset_bottom_data =
           bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-      int64_t pre_calc_index = 0;
+      const PreCalc<T>* pc = pre_calc.data();
 
       for (int64_t ph = 0; ph < pooled_height; ph++) {
         for (int64_t pw = 0; pw < pooled_width; pw++) {
-          int64_t index = index_n_c + ph * pooled_width + pw;
-
           T output_val = 0.;
-          if (mode == "avg") {  // avg pooling
-            for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-              for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                PreCalc<T> pc = pre_calc[pre_calc_index];
-                output_val += pc.w1 * offset_bottom_data[pc.pos1] +
-                              pc.w2 * offset_bottom_data[pc.pos2] +
-                              pc.w3 * offset_bottom_data[pc.pos3] +
-                              pc.w4 * offset_bottom_data[pc.pos4];
-
-                pre_calc_index += 1;
-              }
+          if (avg_mode) {  // avg pooling
+            for (int64_t k = 0; k < count; k++, pc++) {
+              output_val += pc->w1 * offset_bottom_data[pc->pos1] +
+                            pc->w2 * offset_bottom_data[pc->pos2] +
+                            pc->w3 * offset_bottom_data[pc->pos3] +
+                            pc->w4 * offset_bottom_data[pc->pos4];
             }
             output_val /= count;
           } else {  // max pooling
-            bool max_flag = false;
-            for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-              for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                PreCalc<T> pc = pre_calc[pre_calc_index];
-                if (!max_flag) {
-                  output_val = pc.w1 * offset_bottom_data[pc.pos1];
-                  max_flag = true;
-                } else {
-                  output_val = std::max(std::max(std::max(output_val, pc.w2 * offset_bottom_data[pc.pos2]),
-                                                 pc.w3 * offset_bottom_data[pc.pos3]),
-                                        pc.w4 * offset_bottom_data[pc.pos4]);
-                }
-
-                pre_calc_index += 1;
+            for (int64_t k = 0; k < count; k++, pc++) {
+              if (k == 0) {
+                output_val = pc->w1 * offset_bottom_data[pc->pos1];
+              } else {
+                output_val = std::max(std::max(std::max(output_val, pc->w2 * offset_bottom_data[pc->pos2]),
+                                               pc->w3 * offset_bottom_data[pc->pos3]),
+                                      pc->w4 * offset_bottom_data[pc->pos4]);
               }
             }
           }
 
-          top_data[index] = output_val;
+          offset_top_data[ph * pooled_width + pw] = output_val;
         }  // for pw
       }    // for ph
-    }      // for c
-  }        // for n
+    }      // for n, c
+  });
 }
 }  // namespace
 
@@ -304,7 +304,8 @@ Status ROIAlign<T>::Compute(OpKernelContext* context) const {
       rois_ptr->Data<T>(),
       rois_dims[1],
       Y.template MutableData<T>(),
-      mode_);
+      mode_,
+      context->GetOperatorThreadPool());
 
   return Status::OK();
 }
@@ -5,14 +5,15 @@
 #include "onnx/defs/schema.h"
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
+#include "core/common/utf8_util.h"
+#include "core/platform/threadpool.h"
 
 #ifdef _MSC_VER
 #include <locale.h>
 #endif
 
-#include <codecvt>
+#include <cstring>
 #include <locale>
-#include <functional>
 #include <unordered_set>
 
 namespace onnxruntime {
@@ -27,8 +28,6 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
     contrib::StringNormalizer);
 
 namespace string_normalizer {
-const std::string conv_error("Conversion Error");
-const std::wstring wconv_error(L"Conversion Error");
 
 // We need to specialize for MS as there is
 // a std::locale creation bug that affects different
@@ -54,16 +53,12 @@ class Locale {
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Locale);
 
-  void ChangeCase(StringNormalizer::CaseAction caseaction,
-                  std::wstring& wstr) const {
+  wchar_t ChangeCase(StringNormalizer::CaseAction caseaction, wchar_t ch) const {
     assert(caseaction != StringNormalizer::NONE);
     if (caseaction == StringNormalizer::LOWER) {
-      std::transform(wstr.begin(), wstr.end(), wstr.begin(),
-                     [this](wchar_t ch) { return ::_towlower_l(ch, loc_); });
-    } else {
-      std::transform(wstr.begin(), wstr.end(), wstr.begin(),
-                     [this](wchar_t ch) { return ::_towupper_l(ch, loc_); });
+      return ::_towlower_l(ch, loc_);
     }
+    return ::_towupper_l(ch, loc_);
   }
 
  private:
@@ -83,16 +78,12 @@ class Locale {
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Locale);
 
-  void ChangeCase(StringNormalizer::CaseAction caseaction,
-                  std::wstring& wstr) const {
+  wchar_t ChangeCase(StringNormalizer::CaseAction caseaction, wchar_t ch) const {
     assert(caseaction != StringNormalizer::NONE);
     if (caseaction == StringNormalizer::LOWER) {
-      std::transform(wstr.begin(), wstr.end(), wstr.begin(),
-                     [this](wchar_t ch) { return std::tolower(ch, loc_); });
-    } else {
-      std::transform(wstr.begin(), wstr.end(), wstr.begin(),
-                     [this](wchar_t ch) { return std::toupper(ch, loc_); });
+      return std::tolower(ch, loc_);
     }
+    return std::toupper(ch, loc_);
   }
 
  private:
@@ -103,54 +94,157 @@ const std::string default_locale("en_US.UTF-8");
 
 #endif
 
-template <class ForwardIter>
-Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
-                      const Locale& loc,
-                      std::wstring_convert<std::codecvt_utf8<wchar_t>>& converter,
-                      size_t N, size_t C,
-                      StringNormalizer::CaseAction caseaction) {
-  std::vector<int64_t> output_dims;
-  if (N == 1) {
-    output_dims.push_back(1);
-  }
+// Case mapping of a locale for one case action.
+// The locale is queried once per code point when the kernel is created
+// so that Compute needs neither the locale nor wide strings and works
+// directly on utf8 bytes.
+// Code points are kept in pages of 256, pages that the locale does not
+// change are not stored at all.
+class CaseMap {
+ public:
+  CaseMap(const Locale& loc, StringNormalizer::CaseAction caseaction)
+      : caseaction_(caseaction), page_index_(kNumPages, kIdentityPage) {
+    assert(caseaction != StringNormalizer::NONE);
+    std::vector<char32_t> page(kPageSize);
+    for (size_t p = 0; p < kNumPages; ++p) {
+      bool identity = true;
+      for (size_t i = 0; i < kPageSize; ++i) {
+        const char32_t cp = static_cast<char32_t>(p * kPageSize + i);
+        const char32_t mapped = static_cast<char32_t>(loc.ChangeCase(caseaction, static_cast<wchar_t>(cp)));
+        page[i] = IsEncodable(mapped) ? mapped : cp;
+        identity = identity && (page[i] == cp);
+      }
+      if (!identity) {
+        page_index_[p] = static_cast<int32_t>(pages_.size() / kPageSize);
+        pages_.insert(pages_.end(), page.cbegin(), page.cend());
+      }
+    }
 
-  // Empty output case
-  if (C == 0) {
-    output_dims.push_back(1);
-    TensorShape output_shape(output_dims);
-    // This will create one empty string
-    ctx->Output(0, output_shape);
-    return Status::OK();
+    // ASCII is handled a word at a time if the locale
+    // maps it the same way as the "C" locale does
+    ascii_standard_ = true;
+    for (char32_t cp = 0; cp < 0x80; ++cp) {
+      const char32_t mapped = Map(cp);
+      ascii_standard_ = ascii_standard_ && (mapped == StandardAsciiCase(cp));
+    }
   }
 
-  output_dims.push_back(C);
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CaseMap);
 
-  TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
+  /**
+  * Writes the case changed utf8 s into out.
+  * Returns false if s is not valid utf8.
+  */
+  bool Apply(const std::string& s, std::string& out) const {
+    size_t chars = 0;
+    if (!utf8_util::utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(), chars)) {
+      return false;
+    }
 
-  size_t output_idx = 0;
-  while (first != end) {
-    auto& s = *first;
-    if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
-      std::wstring wstr = converter.from_bytes(s);
-      if (wstr == wconv_error) {
-        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                      "Input contains invalid utf8 chars at: " + static_cast<const std::string&>(s));
+    const unsigned char* src = reinterpret_cast<const unsigned char*>(s.data());
+    const size_t len = s.size();
+    out.clear();
+    out.reserve(len);
+    size_t idx = 0;
+    while (idx < len) {
+      if (ascii_standard_) {
+        for (; idx + sizeof(uint64_t) <= len; idx += sizeof(uint64_t)) {
+          uint64_t word;
+          memcpy(&word, src + idx, sizeof(word));
+          if ((word & kHighBits) != 0) {
+            break;
+          }
+          word = ChangeAsciiCase(word);
+          out.append(reinterpret_cast<const char*>(&word), sizeof(word));
+        }
+        if (idx == len) {
+          break;
+        }
+      }
+      char32_t cp = src[idx];
+      size_t bytes = 1;
+      if (cp >= 0x80) {
+        utf8_util::utf8_bytes(src[idx], bytes);
+        cp &= (0x7Fu >> bytes);
+        for (size_t b = 1; b < bytes; ++b) {
+          cp = (cp << 6) | (src[idx + b] & 0x3Fu);
+        }
       }
-      // In place transform
-      loc.ChangeCase(caseaction, wstr);
-      *(output_data + output_idx) = converter.to_bytes(wstr);
+      AppendUtf8(Map(cp), out);
+      idx += bytes;
+    }
+    return true;
+  }
+
+ private:
+  static constexpr size_t kPageSize = 256;
+  // Unicode has no case mappings past the Supplementary Multilingual Plane.
+  // wchar_t is utf16 on Windows so only the BMP can be mapped there.
+  static constexpr size_t kNumPages = (sizeof(wchar_t) == 2 ? 0x10000 : 0x20000) / kPageSize;
+  static constexpr int32_t kIdentityPage = -1;
+  static constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+  static constexpr uint64_t kOnes = 0x0101010101010101ULL;
+
+  static bool IsEncodable(char32_t cp) {
+    return cp < 0x110000 && (cp < 0xD800 || cp > 0xDFFF);
+  }
+
+  char32_t StandardAsciiCase(char32_t cp) const {
+    if (caseaction_ == StringNormalizer::LOWER) {
+      return (cp >= 'A' && cp <= 'Z') ? cp + ('a' - 'A') : cp;
+    }
+    return (cp >= 'a' && cp <= 'z') ? cp - ('a' - 'A') : cp;
+  }
+
+  // Flips the case bit of every byte in [first, last] of a word of ASCII chars.
+  // No byte exceeds 0x7F so the additions never carry into the next byte.
+  uint64_t ChangeAsciiCase(uint64_t word) const {
+    const uint64_t first = (caseaction_ == StringNormalizer::LOWER) ? 'A' : 'a';
+    const uint64_t last = first + ('Z' - 'A');
+    const uint64_t ge_first = word + kOnes * (0x80 - first);
+    const uint64_t gt_last = word + kOnes * (0x7F - last);
+    const uint64_t in_range = ge_first & ~gt_last & kHighBits;
+    return word ^ (in_range >> 2);
+  }
+
+  char32_t Map(char32_t cp) const {
+    const size_t page = cp / kPageSize;
+    if (page >= kNumPages || page_index_[page] == kIdentityPage) {
+      return cp;
+    }
+    return pages_[page_index_[page] * kPageSize + cp % kPageSize];
+  }
+
+  static void AppendUtf8(char32_t cp, std::string& out) {
+    if (cp < 0x80) {
+      out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+      out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+      out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+      out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+      out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
     } else {
-      assert(caseaction == StringNormalizer::NONE);
-      // Simple copy or move if the iterator points to a non-const string
-      *(output_data + output_idx) = std::move(s);
+      out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+      out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
     }
-    ++output_idx;
-    ++first;
   }
-  return Status::OK();
-}
+
+  StringNormalizer::CaseAction caseaction_;
+  bool ascii_standard_;
+  std::vector<int32_t> page_index_;
+  std::vector<char32_t> pages_;
+};
+
+constexpr size_t CaseMap::kPageSize;
+constexpr size_t CaseMap::kNumPages;
+constexpr int32_t CaseMap::kIdentityPage;
+constexpr uint64_t CaseMap::kHighBits;
+constexpr uint64_t CaseMap::kOnes;
+
 }  // namespace string_normalizer
 
 using namespace string_normalizer;
@@ -184,7 +278,12 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
 
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
   Locale locale(locale_name_);
-  std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
+  // The compare case always matches the output case unless the output case is NONE
+  // so a single mapping serves both
+  const CaseAction caseaction = (casechangeaction_ != NONE) ? casechangeaction_ : compare_caseaction_;
+  if (caseaction != NONE) {
+    case_map_ = std::make_unique<CaseMap>(locale, caseaction);
+  }
 
   std::vector<std::string> swords = info.GetAttrsOrDefault<std::string>("stopwords");
   for (const auto& sw : swords) {
@@ -193,15 +292,18 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
       auto p = stopwords_.insert(sw);
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
     } else {
-      std::wstring wstr = converter.from_bytes(sw);
-      ORT_ENFORCE(wstr != wconv_error, "Stopword contains invalid utf8 chars");
-      locale.ChangeCase(compare_caseaction_, wstr);
-      auto p = wstopwords_.insert(wstr);
+      std::string cased;
+      ORT_ENFORCE(case_map_->Apply(sw, cased), "Stopword contains invalid utf8 chars");
+      auto p = stopwords_.insert(std::move(cased));
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
     }
   }
 }
 
+// Make CaseMap definition available for destruction
+StringNormalizer::~StringNormalizer() {
+}
+
 Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   using namespace string_normalizer;
 
@@ -229,71 +331,76 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
                   "Input dimensions are either[C > 0] or [1][C > 0] allowed");
   }
 
-  Status status;
-  Locale locale(locale_name_);
-  std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
   auto const input_data = X->template Data<std::string>();
-  using StrRef = std::reference_wrapper<const std::string>;
-  if (is_case_sensitive_) {
-    if (!stopwords_.empty()) {
-      std::vector<StrRef> filtered_strings;
-      filtered_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        if (0 == stopwords_.count(s)) {
-          filtered_strings.push_back(std::cref(s));
-        }
-        ++first;
-      }
-      status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, converter,
-                              N, filtered_strings.size(), casechangeaction_);
-    } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, casechangeaction_);
-    }
-  } else {
-    if (!wstopwords_.empty()) {
-      // Filter input. When no case action is required
-      // we simply store original string references.
-      // Otherwise, we store converted strings.
-      std::vector<StrRef> filtered_orignal_strings;
-      std::vector<std::string> filtered_cased_strings;
-      filtered_orignal_strings.reserve(C);
-      filtered_cased_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        std::wstring wstr = converter.from_bytes(s);
-        if (wstr == wconv_error) {
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Input contains invalid utf8 chars at: " + s);
-        }
-        locale.ChangeCase(compare_caseaction_, wstr);
-        if (0 == wstopwords_.count(wstr)) {
-          if (casechangeaction_ == NONE) {
-            filtered_orignal_strings.push_back(std::cref(s));
-          } else {
-            filtered_cased_strings.push_back(converter.to_bytes(wstr));
+  const bool filter = !stopwords_.empty();
+  const bool change_case = casechangeaction_ != NONE;
+  // Case insensitive filtering compares the cased strings
+  const bool apply_case = change_case || (filter && !is_case_sensitive_);
+
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < C; ++i) {
+    total_bytes += input_data[i].size();
+  }
+
+  // Every string is handled independently
+  enum RowState : uint8_t { kKeep, kFiltered, kInvalid };
+  std::vector<uint8_t> states(C, kKeep);
+  std::vector<std::string> cased(apply_case ? C : 0);
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(C),
+      static_cast<double>(total_bytes / C + 1) * 4,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const std::string& s = input_data[i];
+          if (filter && is_case_sensitive_ && stopwords_.count(s) != 0) {
+            states[i] = kFiltered;
+          } else if (apply_case && !case_map_->Apply(s, cased[i])) {
+            states[i] = kInvalid;
+          } else if (filter && !is_case_sensitive_ && stopwords_.count(cased[i]) != 0) {
+            states[i] = kFiltered;
           }
         }
-        ++first;
-      }
-      if (casechangeaction_ == NONE) {
-        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
-                                N, filtered_orignal_strings.size(), NONE);
-      } else {
-        status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
-                                N, filtered_cased_strings.size(), NONE);
-      }
+      });
+
+  std::vector<size_t> kept;
+  kept.reserve(C);
+  for (size_t i = 0; i < C; ++i) {
+    if (states[i] == kInvalid) {
+      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                    "Input contains invalid utf8 chars at: " + input_data[i]);
+    }
+    if (states[i] == kKeep) {
+      kept.push_back(i);
+    }
+  }
+
+  std::vector<int64_t> output_dims;
+  if (N == 1) {
+    output_dims.push_back(1);
+  }
+
+  // Empty output case
+  if (kept.empty()) {
+    output_dims.push_back(1);
+    TensorShape output_shape(output_dims);
+    // This will create one empty string
+    ctx->Output(0, output_shape);
+    return Status::OK();
+  }
+
+  output_dims.push_back(kept.size());
+  TensorShape output_shape(output_dims);
+  auto output_tensor = ctx->Output(0, output_shape);
+  auto const output_data = output_tensor->template MutableData<std::string>();
+  for (size_t output_idx = 0; output_idx < kept.size(); ++output_idx) {
+    const size_t i = kept[output_idx];
+    if (change_case) {
+      output_data[output_idx] = std::move(cased[i]);
     } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, casechangeaction_);
+      output_data[output_idx] = input_data[i];
     }
   }
-  return status;
+  return Status::OK();
 }
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -5,13 +5,17 @@
 
 #include "core/framework/op_kernel.h"
 
-#include <locale>
+#include <memory>
 #include <string>
 #include <unordered_set>
 
 namespace onnxruntime {
 namespace contrib {
 
+namespace string_normalizer {
+class CaseMap;
+}
+
 class StringNormalizer : public OpKernel {
  public:
   enum CaseAction {
@@ -21,7 +25,7 @@ class StringNormalizer : public OpKernel {
   };
 
   explicit StringNormalizer(const OpKernelInfo& info);
-  ~StringNormalizer() = default;
+  ~StringNormalizer();
 
   Status Compute(OpKernelContext* ctx) const override;
 
@@ -30,9 +34,10 @@ class StringNormalizer : public OpKernel {
   CaseAction casechangeaction_;
   CaseAction compare_caseaction_;  // used for case-insensitive compare
   std::string locale_name_;
-  // Either if these are populated but not both
+  // Case mapping for casechangeaction_ or, if that is NONE, for compare_caseaction_
+  std::unique_ptr<string_normalizer::CaseMap> case_map_;
+  // Cased with compare_caseaction_ when not case sensitive
   std::unordered_set<std::string> stopwords_;
-  std::unordered_set<std::wstring> wstopwords_;
 };
 
 }  // namespace contrib
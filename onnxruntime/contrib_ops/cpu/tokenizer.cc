@@ -7,9 +7,9 @@
 #include "core/framework/tensor.h"
 
 #include "core/common/utf8_util.h"
+#include "core/platform/threadpool.h"
 
-#include <codecvt>
-#include <locale>
+#include <cassert>
 
 namespace onnxruntime {
 namespace contrib {
@@ -29,171 +29,136 @@ namespace tokenizer_details {
 const char start_text = 0x2;
 const char end_text = 0x3;
 
-const std::string conv_error("Conversion Error");
-const std::wstring wconv_error(L"Conversion Error");
-
-// Use a Trie like structure for searching multiple strings
-// at once but convert it to a ternary tree for saving space.
-// We insert separators in the same order they are specified.
-// Template parameter is a CharT which can be a char/wchar_t
-// or anything else that supports operator ><,== as long as
-// this is not a variable length sequence. We convert utf8 to utf16
-// before inserting.
-// Value is a supplementary information useful for search hit
-// and is present in the nodes that terminate the whole search pattern
-template <class CharT, class Value>
-class TernarySearchTree {
- private:
-  struct Node {
-    std::unique_ptr<Node> left_;
-    std::unique_ptr<Node> mid_;
-    std::unique_ptr<Node> right_;
-    CharT c_;  // character
-    Value value_;
-    bool has_val_;
-
-    explicit Node(CharT c) : c_(c), value_(), has_val_(false) {
-    }
-    ~Node() = default;
-  };
-
-  struct GetState {
-    const CharT* const str_;
-    const size_t len_;
-    size_t depth_;
-    const Value* result_;
-  };
-
+// Aho-Corasick automaton over the utf8 bytes of the separators.
+// Both the separators and the input are validated utf8, so a byte
+// level match always starts and ends on a character boundary and
+// there is no need to convert anything to wide chars.
+// Missing transitions are resolved through the failure links at build time
+// so scanning costs a single table lookup per input byte.
+// Separators are numbered in the order they are added and a smaller
+// number means a higher priority.
+class SeparatorMatcher {
  public:
-  TernarySearchTree() = default;
-  ~TernarySearchTree() = default;
+  static constexpr int32_t kNoMatch = -1;
 
-  /**
-  * Returns a ptr to an associated value and nullptr on search miss.
-  * Must use default constructed state.
-  */
-  const Value* get(const CharT* str, size_t len) const {
-    if (len == 0) {
-      return nullptr;
-    }
-    GetState get_state{str, len, 0, nullptr};
-    get(root_.get(), get_state);
-    return get_state.result_;
+  SeparatorMatcher() : transitions_(kAlphabetSize, kNoState), fail_(1, 0), pattern_(1, kNoMatch) {
   }
 
   /**
-  * Returns true if successful and false on empty strings
-  * and duplicates.
+  * Returns false on duplicates. Must be called before Build().
   */
-  bool put(const CharT* str, size_t len, const Value& v) {
-    if (len < 1) {
-      assert(false);
-      return false;
+  bool Add(const std::string& sep) {
+    assert(!sep.empty());
+    int32_t state = 0;
+    for (auto ch : sep) {
+      const size_t idx = state * kAlphabetSize + static_cast<unsigned char>(ch);
+      if (transitions_[idx] == kNoState) {
+        transitions_[idx] = static_cast<int32_t>(pattern_.size());
+        pattern_.push_back(kNoMatch);
+        fail_.push_back(0);
+        transitions_.resize(transitions_.size() + kAlphabetSize, kNoState);
+      }
+      state = transitions_[idx];
     }
-    Node* new_root = put(root_.get(), str, len, v, 0);
-    if (new_root != nullptr) {
-      root_.release();
-      root_.reset(new_root);
-      return true;
+    if (pattern_[state] != kNoMatch) {
+      return false;
     }
-    return false;
+    pattern_[state] = static_cast<int32_t>(lengths_.size());
+    lengths_.push_back(sep.size());
+    return true;
   }
 
- private:
-  void update_state(const Node* node, GetState& state) const {
-    if (node->has_val_) {
-      if (state.result_ == nullptr) {
-        state.result_ = &node->value_;
-      } else if (node->value_ < *state.result_) {
-        state.result_ = &node->value_;
+  // Computes failure links in BFS order and turns the trie into a DFA
+  void Build() {
+    output_.assign(pattern_.size(), kNoMatch);
+    std::vector<int32_t> queue;
+    queue.reserve(pattern_.size());
+    for (size_t c = 0; c < kAlphabetSize; ++c) {
+      if (transitions_[c] == kNoState) {
+        transitions_[c] = 0;
+      } else {
+        queue.push_back(transitions_[c]);
       }
     }
-  }
-  void get(const Node* node, GetState& state) const {
-    if (node == nullptr) {
-      return;
-    }
-    assert(state.depth_ < state.len_);
-    CharT c = state.str_[state.depth_];
-    if (c < node->c_) {
-      get(node->left_.get(), state);
-      return;
-    } else if (c > node->c_) {
-      get(node->right_.get(), state);
-      return;
-    } else if (state.depth_ < (state.len_ - 1)) {
-      // Check if we have a match at this node
-      update_state(node, state);
-      if (node->mid_ != nullptr) {
-        ++state.depth_;
-        get(node->mid_.get(), state);
+    for (size_t q = 0; q < queue.size(); ++q) {
+      const int32_t state = queue[q];
+      const int32_t fail = fail_[state];
+      output_[state] = (pattern_[fail] != kNoMatch) ? fail : output_[fail];
+      for (size_t c = 0; c < kAlphabetSize; ++c) {
+        const size_t idx = state * kAlphabetSize + c;
+        const int32_t fail_next = transitions_[fail * kAlphabetSize + c];
+        if (transitions_[idx] == kNoState) {
+          transitions_[idx] = fail_next;
+        } else {
+          fail_[transitions_[idx]] = fail_next;
+          queue.push_back(transitions_[idx]);
+        }
       }
-      return;
     }
-    update_state(node, state);
   }
 
-  Node* put(Node* node, const CharT* str, size_t len, const Value& v, size_t depth) {
-    CharT c = str[depth];
-
-    std::unique_ptr<Node> new_node;
-    if (node == nullptr) {
-      new_node.reset(new Node(c));
-    }
-
-    Node* new_link = nullptr;
-    Node* n = (node != nullptr) ? node : new_node.get();
-    if (c < n->c_) {
-      new_link = put(n->left_.get(), str, len, v, depth);
-      if (new_link != nullptr) {
-        n->left_.release();
-        n->left_.reset(new_link);
-      }
-    } else if (c > n->c_) {
-      new_link = put(n->right_.get(), str, len, v, depth);
-      if (new_link != nullptr) {
-        n->right_.release();
-        n->right_.reset(new_link);
-      }
-    } else if (depth < (len - 1)) {
-      new_link = put(n->mid_.get(), str, len, v, depth + 1);
-      if (new_link != nullptr) {
-        n->mid_.release();
-        n->mid_.reset(new_link);
-      }
-    } else {
-      if (!n->has_val_) {
-        n->value_ = v;
-        n->has_val_ = true;
-        new_link = n;
+  /**
+  * For every byte offset of s at which at least one separator starts
+  * stores the highest priority separator starting there into best_at[offset].
+  * All other entries are set to kNoMatch.
+  */
+  void Find(const char* s, size_t len, std::vector<int32_t>& best_at) const {
+    best_at.assign(len, kNoMatch);
+    int32_t state = 0;
+    for (size_t i = 0; i < len; ++i) {
+      state = transitions_[state * kAlphabetSize + static_cast<unsigned char>(s[i])];
+      int32_t hit = (pattern_[state] != kNoMatch) ? state : output_[state];
+      while (hit != kNoMatch) {
+        const int32_t sep = pattern_[hit];
+        const size_t start = i + 1 - lengths_[sep];
+        if (best_at[start] == kNoMatch || sep < best_at[start]) {
+          best_at[start] = sep;
+        }
+        hit = output_[hit];
       }
     }
-    if (new_link != nullptr) {
-      new_node.release();
-      return n;
-    }
-    return nullptr;
   }
-  std::unique_ptr<Node> root_;
-};
 
-// We store the length of the original pattern within the
-// Ternary Tree. This allows us to cut out the length of the matching
-// separator from the original string.
-struct SearchValue {
-  size_t w_len;
-  int priority_;
-  bool operator<(const SearchValue& o) const {
-    return priority_ < o.priority_;
+  size_t Length(int32_t sep) const {
+    return lengths_[sep];
   }
+
+ private:
+  static constexpr size_t kAlphabetSize = 256;
+  static constexpr int32_t kNoState = -1;
+
+  std::vector<int32_t> transitions_;  // [states][kAlphabetSize]
+  std::vector<int32_t> fail_;         // longest proper suffix that is also a state
+  std::vector<int32_t> pattern_;      // separator that ends at the state or kNoMatch
+  std::vector<int32_t> output_;       // next state on the failure chain that ends a separator
+  std::vector<size_t> lengths_;       // separator lengths in bytes
+};
+
+constexpr int32_t SeparatorMatcher::kNoMatch;
+constexpr size_t SeparatorMatcher::kAlphabetSize;
+constexpr int32_t SeparatorMatcher::kNoState;
+
+// Byte range of a separator match or of a token within the source string
+struct Span {
+  size_t offset_;
+  size_t size_;
 };
 
+// Number of utf8 chars in a validated sequence
+inline size_t utf8_chars(const char* s, size_t len) {
+  size_t chars = 0;
+  for (size_t i = 0; i < len; ++i) {
+    chars += (static_cast<unsigned char>(s[i]) & 0xC0u) != 0x80u;
+  }
+  return chars;
+}
+
 }  // namespace tokenizer_details
 
 using namespace tokenizer_details;
 
 struct Tokenizer::SearchData {
-  TernarySearchTree<wchar_t, SearchValue> tst_;
+  SeparatorMatcher matcher_;
 };
 
 Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
@@ -220,19 +185,18 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
   ORT_ENFORCE(!char_tokenezation_ || mincharnum_ < 2,
               "mincharnum is too big for char level tokenezation");
 
-  // Create TST and insert separators
+  // Build the automaton, earlier separators get priority
   if (!char_tokenezation_) {
     std::unique_ptr<SearchData> sd(std::make_unique<SearchData>());
-    std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
-    int priority = 0;  // earlier search patterns get priority
     for (const auto& sep : separators) {
       ORT_ENFORCE(!sep.empty(), "No empty separators allowed");
-      std::wstring wsep = converter.from_bytes(sep);
-      ORT_ENFORCE(wsep != wconv_error, "Separator strings contains invalid utf8 chars");
-      bool result = sd->tst_.put(wsep.c_str(), wsep.length(), {wsep.length(), priority});
+      size_t chars = 0;
+      ORT_ENFORCE(utf8_validate(reinterpret_cast<const unsigned char*>(sep.data()), sep.size(), chars),
+                  "Separator strings contains invalid utf8 chars");
+      bool result = sd->matcher_.Add(sep);
       ORT_ENFORCE(result, "duplicate separator detected");
-      ++priority;
     }
+    sd->matcher_.Build();
     search_data_.swap(sd);
   }
 }
@@ -319,82 +283,93 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
 Status Tokenizer::SeparatorTokenize(OpKernelContext* ctx,
                                     size_t N, size_t C,
                                     const std::vector<int64_t>& input_dims) const {
-  struct Match {
-    int priority_;
-    size_t offset_;
-    size_t size_;
-    // create a conflict for overlapping matches
-    // thus if they overlap neither is less than the other
-    // and they are considered equal
-    bool operator<(const Match& o) const {
-      return (offset_ + size_) <= o.offset_;
-    }
-  };
+  const auto& matcher = search_data_->matcher_;
+  const size_t mincharnum = static_cast<size_t>(mincharnum_);
 
-  std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
-  // Scan all strings and attempt to find separators in them
-  // collect all the output tokens here
-  size_t max_tokens = 0;
-  std::vector<std::vector<std::wstring>> tokenized_strings;
-  tokenized_strings.reserve(N * C);
   auto X = ctx->Input<Tensor>(0);
   auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    std::wstring wstr = converter.from_bytes(s);
-    if (wstr == wconv_error) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Invalid utf8 chars in the input: " + s);
-    }
+  const size_t rows = N * C;
+
+  size_t total_bytes = 0;
+  for (size_t row = 0; row < rows; ++row) {
+    total_bytes += input_data[row].size();
+  }
 
-    std::set<Match> matches;
-    const wchar_t* ws = wstr.c_str();
-    size_t len_remaining = wstr.length();
-    size_t offset = 0;
-    while (len_remaining > 0) {
-      const auto* val = search_data_->tst_.get(ws, len_remaining);
-      if (val != nullptr) {
-        auto p = matches.insert({val->priority_, offset, val->w_len});
-        while (!p.second && val->priority_ < p.first->priority_) {
-          // if overlapping matches of the same pattern(priority), then
-          // the earlier match naturally wins
-          matches.erase(p.first);
-          p = matches.insert({val->priority_, offset, val->w_len});
+  // Tokens are kept as byte ranges into the input strings
+  // until the output is allocated. Rows are independent.
+  std::vector<std::vector<Span>> tokenized_strings(rows);
+  std::vector<uint8_t> invalid_rows(rows, 0);
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(rows), static_cast<double>(total_bytes / rows + 1) * 8,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<int32_t> best_at;
+        std::vector<Span> matches;
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const auto& s = input_data[row];
+          const char* const str = s.data();
+          const size_t len = s.size();
+          size_t chars = 0;
+          if (!utf8_validate(reinterpret_cast<const unsigned char*>(str), len, chars)) {
+            invalid_rows[row] = 1;
+            continue;
+          }
+
+          // Of two overlapping matches the one with the higher priority wins
+          // and with the same priority the earlier one wins.
+          // Matches are visited by their start so a new one
+          // may only overlap the last accepted match.
+          matcher.Find(str, len, best_at);
+          matches.clear();
+          int32_t last_sep = SeparatorMatcher::kNoMatch;
+          for (size_t offset = 0; offset < len; ++offset) {
+            const int32_t sep = best_at[offset];
+            if (sep == SeparatorMatcher::kNoMatch) {
+              continue;
+            }
+            if (!matches.empty() &&
+                offset < matches.back().offset_ + matches.back().size_) {
+              if (sep < last_sep) {
+                matches.back() = {offset, matcher.Length(sep)};
+                last_sep = sep;
+              }
+            } else {
+              matches.push_back({offset, matcher.Length(sep)});
+              last_sep = sep;
+            }
+          }
+
+          // Tokenize
+          auto& row_tokens = tokenized_strings[row];
+          row_tokens.reserve(matches.size() + 1);
+          size_t offset = 0;
+          for (const auto& m : matches) {
+            assert(m.offset_ >= offset);
+            size_t sz = (m.offset_ - offset);
+            // chars never outnumber bytes so only count them when it matters
+            if (sz > 0 && sz >= mincharnum &&
+                (mincharnum == 1 || utf8_chars(str + offset, sz) >= mincharnum)) {
+              row_tokens.push_back({offset, sz});
+            }
+            offset = m.offset_ + m.size_;
+          }
+          assert(offset <= len);
+          if (offset < len) {
+            row_tokens.push_back({offset, len - offset});
+          }
         }
-      }
-      ++ws;
-      ++offset;
-      --len_remaining;
-    }
+      });
 
-    // Tokenize
-    tokenized_strings.emplace_back();
-    auto& row_tokens = tokenized_strings.back();
-    row_tokens.reserve(matches.size() + 1);
-    ws = wstr.c_str();
-    offset = 0;
-    for (const auto& m : matches) {
-      assert(m.offset_ >= offset);
-      size_t sz = (m.offset_ - offset);
-      if (sz > 0 && sz >= size_t(mincharnum_)) {
-        row_tokens.emplace_back(ws, sz);
-      }
-      offset = m.offset_ + m.size_;
-      ws = wstr.c_str() + offset;
-    }
-    assert(offset <= wstr.length());
-    if (offset < wstr.length()) {
-      row_tokens.emplace_back(ws, wstr.length() - offset);
+  size_t max_tokens = 0;
+  for (size_t row = 0; row < rows; ++row) {
+    if (invalid_rows[row] != 0) {
+      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                    "Invalid utf8 chars in the input: " + input_data[row]);
     }
-
-    size_t tokens = row_tokens.size();
+    size_t tokens = tokenized_strings[row].size();
     if (mark_) {
       tokens += 2;  // Start/end markers as separate tokens
     }
     max_tokens = std::max(max_tokens, tokens);
-    ++curr_input;
   }
 
   std::vector<int64_t> output_dims(input_dims);
@@ -413,37 +388,34 @@ Status Tokenizer::SeparatorTokenize(OpKernelContext* ctx,
   auto output_tensor = ctx->Output(0, output_shape);
   auto const output_data = output_tensor->template MutableData<std::string>();
 
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  size_t output_index = 0;
-  for (auto& row : tokenized_strings) {
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (auto& token : row) {
-      *(output_data + output_index) = converter.to_bytes(token);
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-  }
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(rows), static_cast<double>(total_bytes / rows + max_tokens),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const auto& s = input_data[row];
+          const auto& row_tokens = tokenized_strings[row];
+          size_t output_index = row * max_tokens;
+          if (mark_) {
+            (output_data + output_index)->assign(&start_text, 1);
+            ++output_index;
+          }
+          // Output tokens for this row
+          for (const auto& token : row_tokens) {
+            (output_data + output_index)->assign(s, token.offset_, token.size_);
+            ++output_index;
+          }
+          if (mark_) {
+            (output_data + output_index)->assign(&end_text, 1);
+            ++output_index;
+          }
+          const size_t pads = max_tokens - (mark_ * 2) - row_tokens.size();
+          for (size_t p = 0; p < pads; ++p) {
+            *(output_data + output_index) = pad_value_;
+            ++output_index;
+          }
+          assert(output_index == (row + 1) * max_tokens);
+        }
+      });
   return Status::OK();
 }
 
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/framework/ml_value.h"
+
+namespace onnxruntime {
+
+class Node;
+
+/**
+Interface of a callback that the executors invoke with the values computed while running the main graph of a
+session, e.g. to collect the activation ranges that static quantization needs.
+The executors call Observe once per feed before running any node, with a null node, and once per output
+after a node has been computed. The value is only valid for the duration of the call.
+The parallel executor may call Observe concurrently from several threads.
+*/
+class IActivationObserver {
+ public:
+  virtual ~IActivationObserver() = default;
+
+  virtual void Observe(const Node* node, const std::string& name, const MLValue& value) = 0;
+};
+}  // namespace onnxruntime
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/activation_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+ActivationStatistics::ActivationStatistics(size_t num_bins) : num_bins_{num_bins} {
+  // the bins are merged in pairs when the range doubles
+  ORT_ENFORCE(num_bins_ % 2 == 0, "The number of histogram bins must be even.");
+}
+
+void ActivationStatistics::Observe(const Node* /*node*/, const std::string& name, const MLValue& value) {
+  if (!value.IsAllocated() || !value.IsTensor()) {
+    return;
+  }
+
+  const auto& tensor = value.Get<Tensor>();
+  if (tensor.DataType() != DataTypeImpl::GetType<float>() || strcmp(tensor.Location().name, CPU) != 0) {
+    return;
+  }
+
+  const float* data = tensor.Data<float>();
+  const size_t size = static_cast<size_t>(tensor.Shape().Size());
+  if (size == 0) {
+    return;
+  }
+
+  const auto minmax = std::minmax_element(data, data + size);
+  const float min = *minmax.first;
+  const float max = *minmax.second;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto entry_it = entries_.find(name);
+  if (entry_it == entries_.end()) {
+    entry_it = entries_.emplace(name, Entry{min, max, std::vector<int64_t>(num_bins_), 0.0f}).first;
+  } else {
+    entry_it->second.min = std::min(entry_it->second.min, min);
+    entry_it->second.max = std::max(entry_it->second.max, max);
+  }
+
+  if (num_bins_ == 0) {
+    return;
+  }
+
+  auto& entry = entry_it->second;
+  const float abs_max = std::max(std::abs(min), std::abs(max));
+  if (entry.histogram_range == 0.0f) {
+    entry.histogram_range = abs_max;
+  }
+
+  if (abs_max > entry.histogram_range) {
+    // double the range until it covers the new values, merging the bins in pairs
+    while (abs_max > entry.histogram_range) {
+      for (size_t i = 0; i < num_bins_ / 2; i++) {
+        entry.histogram[i] = entry.histogram[2 * i] + entry.histogram[2 * i + 1];
+      }
+      std::fill(entry.histogram.begin() + num_bins_ / 2, entry.histogram.end(), 0);
+      entry.histogram_range *= 2.0f;
+    }
+  }
+
+  if (entry.histogram_range == 0.0f) {
+    entry.histogram[0] += static_cast<int64_t>(size);
+    return;
+  }
+
+  const float bins_per_unit = static_cast<float>(num_bins_) / entry.histogram_range;
+  for (size_t i = 0; i < size; i++) {
+    const size_t bin = static_cast<size_t>(std::abs(data[i]) * bins_per_unit);
+    entry.histogram[std::min(bin, num_bins_ - 1)]++;
+  }
+}
+
+std::unordered_map<std::string, ActivationStatistics::Entry> ActivationStatistics::Get() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_;
+}
+
+void ActivationStatistics::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/activation_observer.h"
+
+namespace onnxruntime {
+
+/**
+Activation observer that collects the range of every float tensor computed by a session, accumulated over all
+runs since it was created or cleared. Calibration for static quantization derives the quantization parameters
+of the activations from these statistics.
+If num_bins is not zero, a histogram of the absolute values is collected as well. Its range grows by doubling so
+that it covers every value seen so far, which halves the resolution of the bins collected before.
+Only tensors in CPU memory are observed.
+*/
+class ActivationStatistics final : public IActivationObserver {
+ public:
+  struct Entry {
+    float min;
+    float max;
+    // histogram[i] counts the values with an absolute value in [i, i + 1) * histogram_range / histogram.size()
+    std::vector<int64_t> histogram;
+    float histogram_range;
+  };
+
+  explicit ActivationStatistics(size_t num_bins = 0);
+
+  void Observe(const Node* node, const std::string& name, const MLValue& value) override;
+
+  std::unordered_map<std::string, Entry> Get() const;
+
+  void Clear();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ActivationStatistics);
+
+  const size_t num_bins_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+}  // namespace onnxruntime
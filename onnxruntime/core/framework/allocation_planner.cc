@@ -4,8 +4,12 @@
 #include "core/framework/allocation_planner.h"
 #include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
+#include <functional>
+#include <numeric>
 #include <sstream>
+#include <tuple>
 #include "core/common/exceptions.h"
 #include "core/platform/env.h"
 #include "core/framework/data_types.h"
@@ -36,6 +40,12 @@ std::ostream& operator<<(std::ostream& out, AllocKind alloc_kind) {
     case AllocKind::kAllocateOutput:
       out << "AllocateOutput";
       break;
+    case AllocKind::kSubBuffer:
+      out << "SubBuffer";
+      break;
+    case AllocKind::kView:
+      out << "View";
+      break;
   }
   return out;
 }
@@ -57,7 +67,10 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
     if (0 <= index && static_cast<size_t>(index) < plan_size) {
       auto& elt_plan = plan.allocation_plan[index];
       out << elt_plan.alloc_kind;
-      if (elt_plan.alloc_kind == AllocKind::kReuse) out << " " << elt_plan.reused_buffer;
+      if (elt_plan.alloc_kind == AllocKind::kReuse || elt_plan.alloc_kind == AllocKind::kView)
+        out << " " << elt_plan.reused_buffer;
+      if (elt_plan.alloc_kind == AllocKind::kSubBuffer)
+        out << " " << elt_plan.reused_buffer << " +" << elt_plan.buffer_offset;
 
       auto& loc = elt_plan.location;
       out << ", " << loc.ToString();
@@ -149,6 +162,12 @@ class PlannerImpl {
   // they became free (more recently freed earlier in the list).
   std::list<FreeBufferInfo> freelist_;
 
+  // ml-values whose buffers contain the buffers of kSubBuffer ml-values
+  std::unordered_set<MLValueIndex> sub_buffer_owners_;
+
+  // the consumers of each ml-value, as (node, input arg index) pairs
+  std::unordered_map<std::string, std::vector<std::pair<const onnxruntime::Node*, int>>> consumers_;
+
   MLValueIndex Index(const MLValueName& name) {
     MLValueIndex result;
     auto status = mlvalue_name_idx_map_.GetIdx(name, result);
@@ -224,6 +243,8 @@ class PlannerImpl {
           if (p_input_arg->Exists()) {
             auto input_arg_index = Index(p_input_arg->Name());
             auto original = Buffer(input_arg_index);
+            // a view does not have the layout of the buffer it shares
+            if (AllocPlan(input_arg_index).alloc_kind == AllocKind::kView) continue;
             if (1 == UseCount(original)) {
               if (SameSize(*p_input_arg, *p_output_arg)) {
                 // we can reuse this input since it is its last use and permitted for in-place update
@@ -238,6 +259,41 @@ class PlannerImpl {
     return false;
   }
 
+  // Find if output_arg can be a strided view of the buffer of some input of node
+  bool FindStridedViewInput(const onnxruntime::Node& node, int output_arg_num, MLValueIndex* view_input) {
+    auto p_output_arg = node.OutputDefs()[output_arg_num];
+    auto p_opkernel_def = utils::GetKernelDef(kernel_registry_, node);
+    ORT_ENFORCE(nullptr != p_opkernel_def);
+
+    // the consumers of the output must all accept a strided input for it
+    auto consumers = consumers_.find(p_output_arg->Name());
+    if (p_opkernel_def->StridedViews().empty() || consumers == consumers_.end()) return false;
+    for (auto& consumer : consumers->second) {
+      auto p_consumer_kernel_def = utils::GetKernelDef(kernel_registry_, *consumer.first);
+      if (nullptr == p_consumer_kernel_def) return false;
+      const auto& strided_inputs = p_consumer_kernel_def->StridedInputs();
+      if (std::find(strided_inputs.begin(), strided_inputs.end(), consumer.second) == strided_inputs.end())
+        return false;
+    }
+
+    auto& input_args = node.InputDefs();
+    for (int input_arg_num : p_opkernel_def->StridedViews()) {
+      if ((0 <= input_arg_num) && (static_cast<size_t>(input_arg_num) < input_args.size())) {
+        auto p_input_arg = input_args[input_arg_num];
+        if (p_input_arg->Exists() && p_input_arg->Type() == p_output_arg->Type() &&
+            utils::GetMLDataType(*p_input_arg)->AsTensorType()->GetElementType() !=
+                DataTypeImpl::GetType<std::string>()) {
+          auto input_arg_index = Index(p_input_arg->Name());
+          if (AllocPlan(input_arg_index).location == AllocPlan(Index(p_output_arg->Name())).location) {
+            *view_input = input_arg_index;
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  }
+
   bool SameShape(const TensorShapeProto& shape1, const TensorShapeProto& shape2) {
     // TODO: This should probably be defined to be the equality operator on TensorShapeProto.
     int rank1 = shape1.dim_size();
@@ -301,6 +357,8 @@ class PlannerImpl {
 
     for (auto it = freelist_.begin(); it != freelist_.end(); ++it) {
       auto reusable = it->ml_value;
+      // the buffer of a sub-buffer belongs to a value that may still be live
+      if (AllocPlan(reusable).alloc_kind == AllocKind::kSubBuffer) continue;
       auto p_node_arg = ml_value_info_.at(reusable).p_def_site;
       auto& available_allocator_info = AllocPlan(p_node_arg->Name()).location;
       if (!(available_allocator_info == required_allocator_info)) continue;
@@ -474,6 +532,18 @@ class PlannerImpl {
 
     GeneratePlanForWeights();
 
+    for (auto& node : graph_viewer_.Nodes()) {
+      int input_arg_num = 0;
+      for (auto node_input : node.InputDefs()) {
+        if (node_input->Exists()) consumers_[node_input->Name()].emplace_back(&node, input_arg_num);
+        input_arg_num++;
+      }
+      // implicit inputs are consumed by subgraphs, which never accept strided inputs
+      for (auto node_input : node.ImplicitInputDefs()) {
+        if (node_input->Exists()) consumers_[node_input->Name()].emplace_back(&node, -1);
+      }
+    }
+
     for (size_t program_counter = 0; program_counter < execution_plan.size(); ++program_counter) {
       SequentialExecutionPlan::NodeExecutionPlan step = execution_plan[program_counter];
       auto pnode = graph_viewer_.GetNode(step.node_index);
@@ -489,12 +559,22 @@ class PlannerImpl {
         if (std::find(graph_outputs.begin(), graph_outputs.end(), node_output) != graph_outputs.end()) {
           // node_output is graph's output, so we can't reuse intermedia buffer
           AllocPlan(current).alloc_kind = AllocKind::kAllocateOutput;
+        } else if (AllocPlan(current).alloc_kind == AllocKind::kSubBuffer) {
+          // node_output is computed into a slice of another buffer, as planned by PlanConcatSubBuffers
+        } else if (sub_buffer_owners_.count(current) != 0) {
+          // the buffer is allocated when its first sub-buffer is computed, which is before node_output is
+          // computed, so it cannot reuse a buffer that is only known to be free at this point
+          AllocPlan(current).alloc_kind = AllocKind::kAllocate;
         } else if (IsNonTensor(*node_output)) {
           // we do not try sharing-optimization for non-tensors
           AllocPlan(current).alloc_kind = AllocKind::kAllocate;
         } else if (FindReusableInput(*pnode, output_arg_num, &reused)) {
           // Reuse one of this node's input buffers as the output buffer (for in-place update)
           Reuse(reused, current);
+        } else if (FindStridedViewInput(*pnode, output_arg_num, &reused)) {
+          // The output is a view of one of this node's input buffers that its consumers read in place
+          Reuse(reused, current);
+          AllocPlan(current).alloc_kind = AllocKind::kView;
         } else if (!context_.EnableParallelExecution() && FindReusableTensor(*node_output, &reused)) {
           // Reuse an available (dead) buffer for this output, this is only for sequential execution.
           Reuse(reused, current);
@@ -535,6 +615,121 @@ class PlannerImpl {
     }
   }
 
+  // Get the dimensions of a shape where every dimension is known statically.
+  static bool GetStaticDims(const TensorShapeProto* shape, std::vector<int64_t>& dims) {
+    if (nullptr == shape) return false;
+    dims.clear();
+    for (const auto& dim : shape->dim()) {
+      if (!dim.has_dim_value() || dim.dim_value() < 0) return false;
+      dims.push_back(dim.dim_value());
+    }
+    return true;
+  }
+
+  // Plan the inputs of a CPU Concat that are consumed only by the Concat to be computed directly into their slice
+  // of the Concat output, so that the Concat does not need to copy them. The slices must be contiguous in the
+  // output, so the dimensions before the concatenation axis must all be 1, and all of the shapes must be known
+  // statically so that the offsets of the slices can be planned.
+  void PlanConcatSubBuffers() {
+    std::unordered_map<std::string, std::pair<const onnxruntime::Node*, int>> producers;
+    for (auto& node : graph_viewer_.Nodes()) {
+      int output_arg_num = 0;
+      for (auto node_output : node.OutputDefs()) {
+        if (node_output->Exists()) producers[node_output->Name()] = {&node, output_arg_num};
+        output_arg_num++;
+      }
+    }
+
+    for (auto& node : graph_viewer_.Nodes()) {
+      if (node.OpType() != "Concat" || node.Domain() != kOnnxDomain ||
+          node.GetExecutionProviderType() != kCpuExecutionProvider || node.OutputDefs().empty()) {
+        continue;
+      }
+
+      const NodeArg* node_output = node.OutputDefs()[0];
+      std::vector<int64_t> output_dims;
+      if (!node_output->Exists() || IsNonTensor(*node_output) ||
+          !GetStaticDims(context_.GetShape(*node_output), output_dims)) {
+        continue;
+      }
+
+      // strings are constructed in place, so they are not computed into a shared buffer
+      MLDataType element_type = utils::GetMLDataType(*node_output)->AsTensorType()->GetElementType();
+      if (element_type == DataTypeImpl::GetType<std::string>()) continue;
+
+      const auto& attributes = node.GetAttributes();
+      auto axis_attr = attributes.find("axis");
+      if (axis_attr == attributes.end()) continue;
+      const int64_t rank = static_cast<int64_t>(output_dims.size());
+      int64_t axis = axis_attr->second.i();
+      if (axis < 0) axis += rank;
+      if (axis < 0 || axis >= rank) continue;
+      if (std::any_of(output_dims.begin(), output_dims.begin() + axis, [](int64_t dim) { return dim != 1; })) {
+        continue;
+      }
+
+      MLValueIndex buffer = Index(node_output->Name());
+      const auto& buffer_location = AllocPlan(buffer).location;
+
+      // the ml-value, offset and size in bytes of each slice
+      std::vector<std::tuple<MLValueIndex, size_t, size_t>> slices;
+      std::unordered_set<std::string> seen;
+      int64_t offset = 0;
+      bool eligible = true;
+
+      for (auto node_input : node.InputDefs()) {
+        auto producer = node_input->Exists() ? producers.find(node_input->Name()) : producers.end();
+        // graph inputs, initializers and outer scope values have no producer in the graph
+        if (producer == producers.end() || !seen.insert(node_input->Name()).second) {
+          eligible = false;
+          break;
+        }
+
+        // the use count includes the definition, so the Concat must be the only consumer
+        MLValueIndex index = Index(node_input->Name());
+        std::vector<int64_t> input_dims;
+        if (UseCount(index) != 2 || node_input->Type() != node_output->Type() ||
+            !(AllocPlan(index).location == buffer_location) ||
+            !GetStaticDims(context_.GetShape(*node_input), input_dims)) {
+          eligible = false;
+          break;
+        }
+
+        // an output that must alias an input of its producer cannot be placed in another buffer
+        auto p_kernel_def = utils::GetKernelDef(kernel_registry_, *producer->second.first);
+        if (nullptr == p_kernel_def ||
+            std::any_of(p_kernel_def->Alias().begin(), p_kernel_def->Alias().end(),
+                        [&producer](const std::pair<int, int>& alias) {
+                          return alias.second == producer->second.second;
+                        })) {
+          eligible = false;
+          break;
+        }
+
+        const int64_t input_size =
+            std::accumulate(input_dims.begin(), input_dims.end(), int64_t{1}, std::multiplies<int64_t>());
+        slices.emplace_back(index, static_cast<size_t>(offset) * element_type->Size(),
+                            static_cast<size_t>(input_size) * element_type->Size());
+        offset += input_size;
+      }
+
+      if (!eligible ||
+          offset != std::accumulate(output_dims.begin(), output_dims.end(), int64_t{1}, std::multiplies<int64_t>())) {
+        continue;
+      }
+
+      for (const auto& slice : slices) {
+        auto& slice_plan = AllocPlan(std::get<0>(slice));
+        slice_plan.alloc_kind = AllocKind::kSubBuffer;
+        slice_plan.reused_buffer = buffer;
+        slice_plan.buffer_offset = std::get<1>(slice);
+        slice_plan.sub_buffer_size = std::get<2>(slice);
+        slice_plan.buffer_shape = output_dims;
+      }
+      sub_buffer_owners_.insert(buffer);
+    }
+  }
+
   // Convert information in a freelist (about which ml-value becomes free when) into
   // a deallocation plan in the format required in an ExecutionPlan
   void GenerateDeallocationPlan() {
@@ -589,6 +784,11 @@ Status PlannerImpl::CreatePlan() {
   // compute use counts for all ml-values
   ORT_RETURN_IF_ERROR(ComputeUseCounts());
 
+  // plan the inputs of Concat nodes to be computed into their slice of the output
+  if (!context_.EnableParallelExecution()) {
+    PlanConcatSubBuffers();
+  }
+
   // determine sharing/reuse among ml-values
   ComputeReusePlan();
 
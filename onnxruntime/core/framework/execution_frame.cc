@@ -298,6 +298,22 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(int mlvalue_index,
                                                                          per_alloc_plan.create_fence_if_async));
       break;
     }
+    // A view that the kernel computes densely instead gets a buffer of its own.
+    case AllocKind::kView: {
+      ORT_RETURN_IF_ERROR(AllocateMLValueTensorSelfOwnBufferHelper(mlvalue_index,
+                                                                   ml_data_type,
+                                                                   alloc_info,
+                                                                   parameters.GetTensorShape(),
+                                                                   per_alloc_plan.create_fence_if_async));
+      break;
+    }
+    case AllocKind::kSubBuffer: {
+      ORT_RETURN_IF_ERROR(AllocateMLValueTensorSubBuffer(mlvalue_index,
+                                                         per_alloc_plan,
+                                                         ml_data_type,
+                                                         parameters.GetTensorShape()));
+      break;
+    }
     default: {
       std::ostringstream ostr;
       ostr << "Invalid allocation kind: " << static_cast<std::underlying_type<AllocKind>::type>(alloc_kind);
@@ -308,6 +324,77 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(int mlvalue_index,
   return Status::OK();
 }
 
+// Allocate an MLValue in a slice of the buffer of another MLValue, allocating that buffer first if this is the
+// first of its sub-buffers. Falls back to a buffer of its own if the sizes differ from the planned ones.
+Status ExecutionFrame::AllocateMLValueTensorSubBuffer(int mlvalue_index,
+                                                      const SequentialExecutionPlan::AllocPlanPerValue& per_alloc_plan,
+                                                      const DataTypeImpl* element_type,
+                                                      const TensorShape& shape) {
+  int buffer_mlvalue_index = per_alloc_plan.reused_buffer;
+  ORT_ENFORCE(buffer_mlvalue_index >= 0 && buffer_mlvalue_index < all_values_.size());
+  MLValue* p_mlvalue_buffer = &all_values_[buffer_mlvalue_index];
+
+  const TensorShape buffer_shape(per_alloc_plan.buffer_shape);
+  if (!p_mlvalue_buffer->IsAllocated()) {
+    ORT_RETURN_IF_ERROR(AllocateAsPerAllocationPlan(buffer_mlvalue_index, MLValueAllocationParameters(&buffer_shape)));
+    sub_buffer_owners_.insert(buffer_mlvalue_index);
+  }
+
+  size_t size;
+  if (shape.Size() < 0 || !IAllocator::CalcMemSizeForArray(shape.Size(), element_type->Size(), &size)) {
+    return Status(ONNXRUNTIME, FAIL, "size overflow");
+  }
+
+  // a slice of another size would overlap the other slices
+  auto* buffer_tensor = p_mlvalue_buffer->GetMutable<Tensor>();
+  if (buffer_tensor->Shape() != buffer_shape || buffer_tensor->DataType() != element_type ||
+      size != per_alloc_plan.sub_buffer_size) {
+    return AllocateMLValueTensorSelfOwnBufferHelper(mlvalue_index, element_type, per_alloc_plan.location, shape,
+                                                    per_alloc_plan.create_fence_if_async);
+  }
+
+  MLValue* p_mlvalue = &all_values_[mlvalue_index];
+  if (per_alloc_plan.create_fence_if_async && p_mlvalue_buffer->Fence() == nullptr) {
+    FencePtr f = GetAllocator(per_alloc_plan.location)->CreateFence(&SessionState());
+    p_mlvalue_buffer->SetFence(f);
+  }
+  p_mlvalue->ShareFenceWith(*p_mlvalue_buffer);
+
+  void* buffer = static_cast<char*>(buffer_tensor->MutableDataRaw()) + per_alloc_plan.buffer_offset;
+  return AllocateTensorWithPreAllocateBufferHelper(p_mlvalue, buffer, element_type, per_alloc_plan.location, shape);
+}
+
+// Give a sub-buffer owner whose computed shape differs from the planned one a buffer of the computed shape.
+// The planned buffer is kept alive as sub-buffers computed into it may still be read, and the new buffer is
+// neither taken from nor traced in the memory pattern, which only has a block for the planned buffer.
+Status ExecutionFrame::ReallocateSubBufferOwner(int mlvalue_index, const TensorShape& shape) {
+  MLValue* p_mlvalue = &all_values_[mlvalue_index];
+  replaced_sub_buffer_owners_.push_back(*p_mlvalue);
+  MLValue& planned = replaced_sub_buffer_owners_.back();
+  const Tensor& planned_tensor = planned.Get<Tensor>();
+
+  size_t size;
+  if (shape.Size() < 0 ||
+      !IAllocator::CalcMemSizeForArrayWithAlignment<64>(shape.Size(), planned_tensor.DataType()->Size(), &size)) {
+    return Status(ONNXRUNTIME, FAIL, "size overflow");
+  }
+
+  const auto& location = GetAllocationPlan(mlvalue_index).location;
+  auto alloc = GetAllocator(location);
+  void* buffer = size == 0 ? nullptr : alloc->Alloc(size);
+  std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(planned_tensor.DataType(),
+                                                              shape,
+                                                              buffer,
+                                                              location,
+                                                              alloc);
+  *p_mlvalue = MLValue();
+  p_mlvalue->Init(p_tensor.release(),
+                  DataTypeImpl::GetType<Tensor>(),
+                  DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+  p_mlvalue->ShareFenceWith(planned);
+  return Status::OK();
+}
+
 void ExecutionFrame::Init(const onnxruntime::GraphViewer& graph,
                           const std::unordered_map<std::string, MLValue>& feeds,
                           const std::vector<std::string>& output_names,
@@ -485,6 +572,12 @@ Status ExecutionFrame::GetOrCreateNodeOutputMLValue(int index,
   p_mlvalue = &all_values_.at(node_values_[index]);
 
   if (p_mlvalue->IsAllocated()) {
+    // A buffer allocated for sub-buffers has the planned shape, which the shapes seen at runtime may not match.
+    if (sub_buffer_owners_.count(node_values_[index]) != 0 && p_mlvalue->IsTensor() &&
+        p_mlvalue->Get<Tensor>().Shape() != parameters.GetTensorShape()) {
+      return ReallocateSubBufferOwner(node_values_[index], parameters.GetTensorShape());
+    }
+
     // The ml has already been allocated.
     // Now only tensor need to be check.
     VerifyShape(p_mlvalue, parameters);  // TODO find a better way to do this
@@ -496,6 +589,42 @@ Status ExecutionFrame::GetOrCreateNodeOutputMLValue(int index,
     return Status::OK();
 }
 
+Status ExecutionFrame::GetOrCreateNodeOutputMLValueView(int index,
+                                                        const TensorShape& shape,
+                                                        const Tensor& source,
+                                                        int64_t offset,
+                                                        const std::vector<int64_t>& strides,
+                                                        MLValue*& p_mlvalue) {
+  if (index < 0 || static_cast<size_t>(index) >= node_values_.size()) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Try to access with invalid node value index: " + std::to_string(index));
+  }
+
+  p_mlvalue = nullptr;
+  int mlvalue_index = node_values_[index];
+  if (mlvalue_index < 0) {
+    return Status::OK();
+  }
+
+  const auto& per_alloc_plan = GetAllocationPlan(mlvalue_index);
+  MLValue* p_mlvalue_view = &all_values_[mlvalue_index];
+  if (per_alloc_plan.alloc_kind != AllocKind::kView || p_mlvalue_view->IsAllocated() ||
+      !(source.Location() == per_alloc_plan.location)) {
+    return Status::OK();
+  }
+
+  // the view shares the fence of the buffer it is a view of
+  p_mlvalue_view->ShareFenceWith(all_values_[per_alloc_plan.reused_buffer]);
+
+  void* buffer = static_cast<char*>(const_cast<void*>(source.DataRaw())) + offset * source.DataType()->Size();
+  ORT_RETURN_IF_ERROR(AllocateTensorWithPreAllocateBufferHelper(p_mlvalue_view, buffer, source.DataType(),
+                                                                source.Location(), shape));
+  p_mlvalue_view->GetMutable<Tensor>()->SetStrides(strides);
+
+  p_mlvalue = p_mlvalue_view;
+  return Status::OK();
+}
+
 Status ExecutionFrame::ReleaseMLValue(int mlvalue_idx) {
   if (mlvalue_idx < 0 || static_cast<size_t>(mlvalue_idx) >= all_values_.size()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid index ", mlvalue_idx);
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <unordered_set>
 #include <vector>
 
 #include "core/common/common.h"
@@ -108,6 +109,17 @@ class ExecutionFrame {
                                       const MLValueAllocationParameters& parameters,
                                       MLValue*& p_mlvalue);
 
+  // This method is not thread safe!
+  // Create the output as a view of the data of source, starting offset elements into it with the given strides,
+  // if the allocation plan allows it. Return S_OK and nullptr if the output must be allocated with
+  // GetOrCreateNodeOutputMLValue instead.
+  Status GetOrCreateNodeOutputMLValueView(int index,
+                                          const TensorShape& shape,
+                                          const Tensor& source,
+                                          int64_t offset,
+                                          const std::vector<int64_t>& strides,
+                                          MLValue*& p_mlvalue);
+
   AllocatorPtr GetAllocator(const OrtAllocatorInfo& info);
 
   Status ReleaseMLValue(int mlvalue_idx);
@@ -137,6 +149,13 @@ class ExecutionFrame {
                                                   const TensorShape& shape,
                                                   bool create_fence);
 
+  Status AllocateMLValueTensorSubBuffer(int mlvalue_index,
+                                        const SequentialExecutionPlan::AllocPlanPerValue& per_alloc_plan,
+                                        MLDataType element_type,
+                                        const TensorShape& shape);
+
+  Status ReallocateSubBufferOwner(int mlvalue_index, const TensorShape& shape);
+
   void Init(const onnxruntime::GraphViewer& graph,
             const std::unordered_map<std::string, MLValue>& feeds,
             const std::vector<std::string>& output_names,
@@ -191,5 +210,12 @@ class ExecutionFrame {
 
   // Big chunks on different locations that will be used by mem_pattern.
   std::map<OrtAllocatorInfo, BufferUniquePtr> buffers_;
+
+  // The ml values allocated with their planned shape before being computed, as the buffer of their sub-buffers.
+  std::unordered_set<int> sub_buffer_owners_;
+
+  // The buffers of sub-buffer owners that were reallocated because their computed shape differed from the
+  // planned one. They are kept as they may still hold sub-buffers to be read.
+  std::vector<MLValue> replaced_sub_buffer_owners_;
 };
 }  // namespace onnxruntime
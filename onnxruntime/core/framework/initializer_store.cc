@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/initializer_store.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace onnxruntime {
+
+std::shared_ptr<InitializerStore> InitializerStore::GetOrCreate(const std::string& key) {
+  // the registry doesn't own the stores, the sessions using them do
+  static OrtMutex registry_mutex;
+  static std::unordered_map<std::string, std::weak_ptr<InitializerStore>> registry;
+
+  std::lock_guard<OrtMutex> lock(registry_mutex);
+
+  // forget the stores released by their last session
+  for (auto it = registry.begin(); it != registry.end();) {
+    if (it->second.expired()) {
+      it = registry.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  auto& entry = registry[key];
+  std::shared_ptr<InitializerStore> store = entry.lock();
+  if (!store) {
+    store = std::make_shared<InitializerStore>();
+    entry = store;
+  }
+  return store;
+}
+
+bool InitializerStore::Find(const std::string& name, const OrtAllocatorInfo& location, MLValue& value) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = initializers_.find(std::make_pair(name, location));
+  if (it == initializers_.end()) {
+    return false;
+  }
+  value = it->second;
+  return true;
+}
+
+MLValue InitializerStore::Add(const std::string& name, const OrtAllocatorInfo& location, const MLValue& value) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return initializers_.emplace(std::make_pair(name, location), value).first->second;
+}
+
+size_t InitializerStore::Size() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return initializers_.size();
+}
+}  // namespace onnxruntime
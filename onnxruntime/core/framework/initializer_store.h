@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ml_value.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+  * Initializers shared by the sessions of a model, so that N sessions of the model keep a single copy of its weights.
+  * The first session needing an initializer deserializes it and adds it to the store, the next sessions use the
+  * same tensor. The tensors own their buffer and are never written to, so they stay valid as long as the store or
+  * a session using them is alive.
+  * The initializers are looked up by name and location: the sessions sharing a store must load the same model with
+  * the same execution providers and graph transformers, so that the initializers with the same name have the same
+  * content. Only the initializers of the main graph are shared.
+  */
+class InitializerStore {
+ public:
+  InitializerStore() = default;
+
+  /**
+    * The store shared by the sessions with the same key, created by the first one and released with the last one.
+    * @param key identifies the model and the configuration of the sessions.
+    */
+  static std::shared_ptr<InitializerStore> GetOrCreate(const std::string& key);
+
+  /**
+    * Find the initializer with the given name on the given location.
+    * @return false if the store doesn't have it.
+    */
+  bool Find(const std::string& name, const OrtAllocatorInfo& location, MLValue& value) const;
+
+  /**
+    * Add an initializer unless the store has one with the same name on the same location already, e.g. added by
+    * another session initialized concurrently.
+    * @return the initializer in the store.
+    */
+  MLValue Add(const std::string& name, const OrtAllocatorInfo& location, const MLValue& value);
+
+  size_t Size() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(InitializerStore);
+
+  mutable OrtMutex mutex_;
+  std::map<std::pair<std::string, OrtAllocatorInfo>, MLValue> initializers_;
+};
+}  // namespace onnxruntime
@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/framework/insert_cast_transformer.h"
+
+#include <algorithm>
+#include <unordered_set>
+
 #include "core/framework/data_types.h"
 
 using namespace ONNX_NAMESPACE;
@@ -32,7 +36,8 @@ onnxruntime::NodeArg* AddCastNode(onnxruntime::Graph& graph,
                                   TypeProto* new_type,
                                   bool new_on_input,
                                   int64_t to_type,
-                                  onnxruntime::ProviderType providerType) {
+                                  onnxruntime::ProviderType providerType,
+                                  std::unordered_set<onnxruntime::NodeIndex>& inserted_casts) {
   //insert cast op to cast input
   int id = id_generator.Next();
 
@@ -47,6 +52,7 @@ onnxruntime::NodeArg* AddCastNode(onnxruntime::Graph& graph,
   auto& cast_node = graph.AddNode(str, "Cast", "cast node to cast from float16 to float32 on cpu", input_defs, output_defs);
   cast_node.AddAttribute("to", to_type);
   cast_node.SetExecutionProviderType(providerType);
+  inserted_casts.insert(cast_node.Index());
   return new_arg;
 }
 
@@ -89,6 +95,83 @@ Status ForceSingleNodeCPUFloat16ToFloat32(onnxruntime::Graph& graph) {
   return graph.Resolve();
 }
 
+static int32_t GetTensorElemType(const onnxruntime::NodeArg& arg) {
+  auto* type = arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type()) {
+    return TensorProto_DataType_UNDEFINED;
+  }
+  return type->tensor_type().elem_type();
+}
+
+static bool IsGraphOutput(const onnxruntime::Graph& graph, const onnxruntime::NodeArg* arg) {
+  const auto& graph_outputs = graph.GetOutputs();
+  return std::find(graph_outputs.begin(), graph_outputs.end(), arg) != graph_outputs.end();
+}
+
+// Merge a Cast with a following Cast that converts back to the first Cast's input type by linking the consumers of
+// the second Cast to the input of the first. A pair is only merged if both Casts were inserted by this transformer,
+// which keeps the values of consecutive CPU nodes in float, or if the first Cast widens float16 to float, in which
+// case the pair is exact. Merging a narrowing Cast authored in the model would change the results.
+static Status RemoveCastPairs(onnxruntime::Graph& graph,
+                              const std::unordered_set<onnxruntime::NodeIndex>& inserted_casts,
+                              bool& modified) {
+  std::unordered_set<onnxruntime::NodeIndex> removed_nodes;
+
+  GraphViewer graph_viewer(graph);
+  for (auto index : graph_viewer.GetNodesInTopologicalOrder()) {
+    if (removed_nodes.count(index) != 0) {
+      continue;
+    }
+    auto& node = *graph.GetNode(index);
+    if (node.OpType() != "Cast") {
+      continue;
+    }
+
+    auto* input = node.MutableInputDefs()[0];
+    const auto src_type = GetTensorElemType(*input);
+    const auto dst_type = GetTensorElemType(*node.OutputDefs()[0]);
+    const bool is_widening = src_type == TensorProto_DataType_FLOAT16 && dst_type == TensorProto_DataType_FLOAT;
+    const bool is_inserted = inserted_casts.count(index) != 0;
+
+    int child_removed = 0;
+    int num_child = 0;
+    for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+      const Node& output_node{*it};
+      num_child++;
+      if (output_node.OpType() != "Cast" ||
+          GetTensorElemType(*output_node.OutputDefs()[0]) != src_type ||
+          !(is_widening || (is_inserted && inserted_casts.count(output_node.Index()) != 0)) ||
+          IsGraphOutput(graph, output_node.OutputDefs()[0])) {
+        continue;
+      }
+
+      //node *it's output's follower could be linked with node's input.
+      std::map<const onnxruntime::NodeArg*, onnxruntime::NodeArg*> replacement_defs;
+      replacement_defs[output_node.OutputDefs()[0]] = input;
+      for (auto next_it = output_node.OutputNodesBegin(); next_it != output_node.OutputNodesEnd(); ++next_it) {
+        const_cast<onnxruntime::Node*>(&(*next_it))->ReplaceDefs(replacement_defs);
+      }
+      removed_nodes.insert(output_node.Index());
+      child_removed++;
+    }
+
+    if (child_removed == num_child && child_removed > 0 && !IsGraphOutput(graph, node.OutputDefs()[0])) {
+      removed_nodes.insert(index);
+    }
+  }
+
+  if (removed_nodes.empty()) {
+    return Status::OK();
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  modified = true;
+  return graph.Resolve();
+}
+
 Status InsertCastTransformer::Apply(onnxruntime::Graph& graph, bool& modified) const {
   ORT_RETURN_IF_ERROR(graph.Resolve());
   if (force_cpu_fp32_)
@@ -100,6 +183,7 @@ Status InsertCastTransformer::Apply(onnxruntime::Graph& graph, bool& modified) c
   float_16_tensor_proto.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT16);
   float_tensor_proto.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
   IdGenerator id_generator;
+  std::unordered_set<onnxruntime::NodeIndex> inserted_casts;
   std::map<onnxruntime::NodeArg*, onnxruntime::NodeArg*> input_def_updates;
   for (onnxruntime::NodeIndex i : order) {
     auto node = graph.GetNode(i);
@@ -123,7 +207,8 @@ Status InsertCastTransformer::Apply(onnxruntime::Graph& graph, bool& modified) c
                                      false,
                                      static_cast<int64_t>(TensorProto_DataType_FLOAT),
                                      //right now we only cast for cpu cases.
-                                     onnxruntime::kCpuExecutionProvider);
+                                     onnxruntime::kCpuExecutionProvider,
+                                     inserted_casts);
           replacement_defs[src_arg] = dst_arg;
           input_def_updates[src_arg] = dst_arg;
         }
@@ -153,7 +238,8 @@ Status InsertCastTransformer::Apply(onnxruntime::Graph& graph, bool& modified) c
                                    &float_tensor_proto,
                                    true,
                                    static_cast<int64_t>(TensorProto_DataType_FLOAT16),
-                                   onnxruntime::kCpuExecutionProvider);
+                                   onnxruntime::kCpuExecutionProvider,
+                                   inserted_casts);
         replacement_defs[dst_arg] = src_arg;
       }
     }
@@ -164,46 +250,6 @@ Status InsertCastTransformer::Apply(onnxruntime::Graph& graph, bool& modified) c
 
   //Resolve it to build the edges.
   ORT_RETURN_IF_ERROR(graph.Resolve());
-  std::map<const onnxruntime::NodeArg*, onnxruntime::NodeArg*> replacement_defs;
-  std::vector<onnxruntime::NodeIndex> removed_nodes;
-  for (auto& node : graph.Nodes()) {
-    if (node.OpType() == "Cast") {
-      // if cast's next node is also cast and next cast's output type equal to cast's input type
-      // remove those two cast.
-      auto src_type = node.InputDefs()[0]->Type();
-      auto dst_type = node.OutputDefs()[0]->Type();
-      auto input = node.MutableInputDefs()[0];
-      int child_removed = 0;
-      int num_child = 0;
-      for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
-        const Node& output_node{*it};
-        if (output_node.OpType() == "Cast") {
-          auto src_type1 = output_node.InputDefs()[0]->Type();
-          auto dst_type1 = output_node.OutputDefs()[0]->Type();
-          if (src_type == dst_type1 && src_type1 == dst_type) {
-            //node *it's output's follower could be linked with node's input.
-            replacement_defs.clear();
-            replacement_defs[const_cast<onnxruntime::NodeArg*>(output_node.OutputDefs()[0])] = input;
-            for (auto next_it = output_node.OutputNodesBegin(); next_it != output_node.OutputNodesEnd(); ++next_it) {
-              const_cast<onnxruntime::Node*>(&(*next_it))->ReplaceDefs(replacement_defs);
-            }
-            removed_nodes.push_back(output_node.Index());
-            child_removed++;
-          }
-        }
-        num_child++;
-      }
-      if (child_removed == num_child && child_removed > 0) {
-        removed_nodes.push_back(node.Index());
-      }
-    }
-  }
-
-  for (auto i : removed_nodes) {
-    graph.RemoveNode(i);
-  }
-
-  modified = modified || !removed_nodes.empty();
-  return Status::OK();
+  return RemoveCastPairs(graph, inserted_casts, modified);
 }
 }  // namespace onnxruntime
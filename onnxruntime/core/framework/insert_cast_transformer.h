@@ -10,9 +10,9 @@
 namespace onnxruntime {
 class InsertCastTransformer : public onnxruntime::GraphTransformer {
  public:
-  InsertCastTransformer(const std::string& name)
+  InsertCastTransformer(const std::string& name, bool force_cpu_fp32 = false)
       : onnxruntime::GraphTransformer(name, "Transformer to insert cast node that casts float16 to float for cpu nodes"),
-        force_cpu_fp32_(true) {
+        force_cpu_fp32_(force_cpu_fp32) {
   }
 
   void AddKernelRegistries(const std::vector<const KernelRegistry*>& kernels) {
@@ -32,10 +32,9 @@ class InsertCastTransformer : public onnxruntime::GraphTransformer {
   bool NeedInsertCast(const onnxruntime::Node* node, const onnxruntime::NodeArg* input) const;
 
   std::vector<const KernelRegistry*> kernels_registries_;
-  // Currently because we only have very few cpu kernels support float16, place those nodes on float16
-  // will introduce many cast between fp32 and fp16, which will slow the execution. 
-  // A better solution is to have a cost model to evaluate does it works to place the node on float16.
-  // Here for simplify, we only force the single-node-float16 sub-graph to float32
+  // The cpu float16 kernels convert to float internally and only keep float16 data between nodes, so nodes that
+  // have a float16 kernel are left on float16. If set, a single-node-float16 sub-graph on cpu is forced to float32
+  // with cast nodes instead, which trades memory for avoiding the conversions inside the kernel.
   bool force_cpu_fp32_;
 };
 }  // namespace onnxruntime
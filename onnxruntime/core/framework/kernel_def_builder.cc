@@ -155,4 +155,24 @@ KernelDefBuilder& KernelDefBuilder::Alias(int input_index, int output_index) {
   return *this;
 }
 
+KernelDefBuilder& KernelDefBuilder::StridedInput(int input_index) {
+  kernel_def_->strided_inputs_.push_back(input_index);
+  return *this;
+}
+
+KernelDefBuilder& KernelDefBuilder::StridedView(int input_index) {
+  kernel_def_->strided_views_.push_back(input_index);
+  return *this;
+}
+
+KernelDefBuilder& KernelDefBuilder::ReleasableInput(int input_index) {
+  kernel_def_->releasable_inputs_.push_back(input_index);
+  return *this;
+}
+
+KernelDefBuilder& KernelDefBuilder::CompactStringInput(int input_index) {
+  kernel_def_->compact_string_inputs_.push_back(input_index);
+  return *this;
+}
+
 }  // namespace onnxruntime
@@ -13,13 +13,19 @@ Status KernelRegistryManager::CreateKernel(const onnxruntime::Node& node,
                                            const IExecutionProvider& execution_provider,
                                            const SessionState& session_state,
                                            /*out*/ std::unique_ptr<OpKernel>& op_kernel) const {
-  std::lock_guard<std::mutex> lock(lock_);
-  if (kernel_registries_.empty()) {
+  // the kernel is constructed outside of the lock so that kernels can be created concurrently
+  std::vector<std::shared_ptr<KernelRegistry>> kernel_registries;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    kernel_registries.assign(kernel_registries_.cbegin(), kernel_registries_.cend());
+  }
+
+  if (kernel_registries.empty()) {
     return Status(ONNXRUNTIME, FAIL, "Kernel not found.");
   }
 
   Status status;
-  for (auto& registry : kernel_registries_) {
+  for (auto& registry : kernel_registries) {
     status = registry->CreateKernel(node, execution_provider, session_state, op_kernel);
     if (status.IsOK()) {
       return status;
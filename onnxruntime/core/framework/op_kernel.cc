@@ -41,6 +41,18 @@ Tensor* OpKernelContext::Output(int index, const TensorShape& shape) {
   return p_ml_value ? p_ml_value->GetMutable<Tensor>() : nullptr;
 }
 
+Tensor* OpKernelContext::OutputView(int index, const TensorShape& shape, const Tensor& source, int64_t offset,
+                                    const std::vector<int64_t>& strides) {
+  if (index < 0 || index >= OutputCount())
+    return nullptr;
+
+  MLValue* p_ml_value = nullptr;
+  Status status = execution_frame_->GetOrCreateNodeOutputMLValueView(GetOutputArgIndex(index), shape, source, offset,
+                                                                     strides, p_ml_value);
+  ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+  return p_ml_value ? p_ml_value->GetMutable<Tensor>() : nullptr;
+}
+
 int OpKernelContext::NumVariadicInputs(size_t arg_num) const {
   auto& arg_counts = kernel_->Node().InputArgCount();
 
@@ -56,6 +68,10 @@ Status OpKernelContext::GetTempSpaceAllocator(AllocatorPtr* output) const {
   return Status::OK();
 }
 
+concurrency::ThreadPool* OpKernelContext::GetOperatorThreadPool() const {
+  return GetSessionState().GetOperatorThreadPool();
+}
+
 MLDataType OpKernelContext::InputType(int index) const {
   int input_arg_index = GetInputArgIndex(index);
   const MLValue* p_ml_value = execution_frame_->GetNodeInputOrOutputMLValue(input_arg_index);
@@ -42,6 +42,14 @@ Status ParallelExecutor::Execute(const SessionState& session_state,
   }
 
   root_frame_ = std::make_unique<ExecutionFrame>(feeds, output_names, fetches, session_state);
+
+  IActivationObserver* activation_observer = session_state.GetActivationObserver();
+  if (activation_observer) {
+    for (const auto& feed : feeds) {
+      activation_observer->Observe(nullptr, feed.first, feed.second);
+    }
+  }
+
   //std::cout << "start nodes:" << std::endl;
   for (auto node_index : session_state.GetGraphViewer()->GetRootNodes()) {
     auto p_op_kernel = session_state.GetKernel(node_index);
@@ -208,6 +216,17 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
                                                      sync_time_begin,
                                                      {{"op_name", p_op_kernel->KernelDef().OpName()}});
     }
+
+    IActivationObserver* activation_observer = session_state.GetActivationObserver();
+    if (activation_observer) {
+      const auto& output_defs = p_op_kernel->Node().OutputDefs();
+      for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+        const MLValue* p_output = op_kernel_context.GetOutputMLValue(output_index);
+        if (p_output != nullptr) {
+          activation_observer->Observe(&p_op_kernel->Node(), output_defs[output_index]->Name(), *p_output);
+        }
+      }
+    }
     //std::cout << "Run async node finish: " << p_node_index << std::endl;
 
     keep_running = false;
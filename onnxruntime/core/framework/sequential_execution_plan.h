@@ -30,9 +30,16 @@ struct SequentialExecutionPlan {
     AllocKind alloc_kind{AllocKind::kAllocate};
     MLDataType value_type{nullptr};
     OrtAllocatorInfo location;
-    // reused_buffer is valid only if alloc_kind == kReuse. It indicates
+    // reused_buffer is valid only if alloc_kind == kReuse, kSubBuffer or kView. It indicates
     // which MLValue's buffer must be reused for this MLValue.
     MLValueIndex reused_buffer{0};
+    // buffer_offset, sub_buffer_size and buffer_shape are valid only if alloc_kind == kSubBuffer.
+    // The MLValue occupies sub_buffer_size bytes starting buffer_offset bytes into the buffer of
+    // reused_buffer, which has the static shape buffer_shape and is allocated when the first of
+    // its sub-buffers is allocated.
+    size_t buffer_offset{0};
+    size_t sub_buffer_size{0};
+    std::vector<int64_t> buffer_shape;
     // if the value is used in async kernel, a fence object would be created
     // note the fence object would be shared between MLValues reusing the same buffer
     bool create_fence_if_async{false};
@@ -42,6 +42,13 @@ Status SequentialExecutor::Execute(const SessionState& session_state,
 
   ExecutionFrame frame{feeds, output_names, fetches, session_state};
 
+  IActivationObserver* activation_observer = session_state.GetActivationObserver();
+  if (activation_observer) {
+    for (const auto& feed : feeds) {
+      activation_observer->Observe(nullptr, feed.first, feed.second);
+    }
+  }
+
   LOGS(logger, INFO) << "Begin execution";
   const SequentialExecutionPlan& seq_exec_plan = *session_state.GetExecutionPlan();
   const auto& exec_plan_vec = seq_exec_plan.execution_plan;
@@ -147,6 +154,16 @@ Status SequentialExecutor::Execute(const SessionState& session_state,
                                                      {{"op_name", p_op_kernel->KernelDef().OpName()}});
     }
 
+    if (activation_observer) {
+      const auto& output_defs = p_op_kernel->Node().OutputDefs();
+      for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+        const MLValue* p_output = op_kernel_context.GetOutputMLValue(output_index);
+        if (p_output != nullptr) {
+          activation_observer->Observe(&p_op_kernel->Node(), output_defs[output_index]->Name(), *p_output);
+        }
+      }
+    }
+
     // free ml-values corresponding to this node
     VLOGS(logger, 1) << "Releasing node ML values after computing kernel: " << p_op_kernel->Node().Name();
     ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_exec_plan, logger));
@@ -46,6 +46,10 @@ void SessionState::AddInitializedTensor(int mlvalue_index, const MLValue& mlvalu
   initialized_tensors_.insert({mlvalue_index, mlvalue});
 }
 
+void SessionState::RemoveInitializedTensor(int mlvalue_index) {
+  initialized_tensors_.erase(mlvalue_index);
+}
+
 const std::unordered_map<int, MLValue>& SessionState::GetInitializedTensors() const {
   return initialized_tensors_;
 }
@@ -133,6 +137,14 @@ const SessionState::NameNodeInfoMapType& SessionState::GetOutputNodeInfoMap() co
   return output_names_to_nodeinfo_mapping_;
 }
 
+void SessionState::AddCompactStringInput(const std::string& input_name) {
+  compact_string_inputs_.insert(input_name);
+}
+
+bool SessionState::AcceptsCompactStringInput(const std::string& input_name) const {
+  return compact_string_inputs_.count(input_name) != 0;
+}
+
 void SessionState::AddSubgraphSessionState(onnxruntime::NodeIndex index,
                                            const std::string& attribute_name,
                                            const SessionState& session_state) {
@@ -6,12 +6,14 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include "gsl/gsl_util"
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/common/profiler.h"
+#include "core/framework/activation_observer.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/kernel_registry_manager.h"
@@ -37,6 +39,10 @@ struct MemoryPatternGroup;
 class TaskThreadPool;
 #endif
 
+namespace concurrency {
+class ThreadPool;
+}
+
 // SessionState should be modified by the inference session class only.
 // It is supposed to be passed by const-ref only to all the executors.
 class SessionState {
@@ -68,6 +74,12 @@ class SessionState {
   */
   void AddInitializedTensor(int mlvalue_index, const MLValue& mlvalue);
 
+  /**
+  * Removes an initialized tensor that the kernels don't read anymore. Its memory is released unless it is
+  * shared, e.g. with another session or the other weights in a single buffer.
+  */
+  void RemoveInitializedTensor(int mlvalue_index);
+
   /**
   * Gets the list of all initialized tensors (weights) so that it can be used by the
   * execution frame to setup the appropriate MLValue vectors.
@@ -100,6 +112,13 @@ class SessionState {
   */
   profiling::Profiler& Profiler() const;
 
+  /**
+  Set the observer the executors report the computed values to, or nullptr to stop observing.
+  */
+  void SetActivationObserver(IActivationObserver* observer) { activation_observer_ = observer; }
+
+  IActivationObserver* GetActivationObserver() const { return activation_observer_; }
+
   /**
   Get cached memory pattern based on input shapes
   */
@@ -143,6 +162,13 @@ class SessionState {
   void AddOutputNameToNodeInfoMapping(const std::string& output_name, const NodeInfo& node_info);
   const NameNodeInfoMapType& GetOutputNodeInfoMap() const;
 
+  /**
+    Add a graph input that may be fed as a string tensor in the compact layout, because all the kernels
+    that consume it read it in place. Other compact string feeds are expanded to std::string elements.
+  */
+  void AddCompactStringInput(const std::string& input_name);
+  bool AcceptsCompactStringInput(const std::string& input_name) const;
+
   /// Add a SessionState instance for executing a subgraph in a Node
   /// @param index Index of Node containing subgraph
   /// @param attribute_name Name of attribute containing the subgraph GraphProto
@@ -161,6 +187,10 @@ class SessionState {
   void SetThreadPool(TaskThreadPool* p_pool) { thread_pool_ = p_pool; }
 #endif
 
+  /// Thread pool used by kernels to parallelize their computation. May be null.
+  concurrency::ThreadPool* GetOperatorThreadPool() const { return operator_thread_pool_; }
+  void SetOperatorThreadPool(concurrency::ThreadPool* p_pool) { operator_thread_pool_ = p_pool; }
+
   bool ExportDll() const { return export_fused_dll_; }
   void SetExportDllFlag(bool flag) { export_fused_dll_ = flag; }
   const FuncManager* GetFuncMgr() const { return &fused_funcs_mgr_; }
@@ -182,6 +212,7 @@ class SessionState {
 
   const logging::Logger* logger_;
   profiling::Profiler* profiler_;
+  IActivationObserver* activation_observer_ = nullptr;
 
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_ = true;
@@ -192,6 +223,7 @@ class SessionState {
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
+  std::unordered_set<std::string> compact_string_inputs_;
 
   // subgraph SessionState. entry for node containing subgraph, with value containing attribute:SessionState pair
   // as a node may contain multiple subgraphs (e.g. 'If' has one for both the 'then' and 'else' branches).
@@ -205,6 +237,7 @@ class SessionState {
 #else
   TaskThreadPool* thread_pool_ = nullptr;
 #endif
+  concurrency::ThreadPool* operator_thread_pool_ = nullptr;
 
   bool export_fused_dll_ = false;
   FuncManager fused_funcs_mgr_;
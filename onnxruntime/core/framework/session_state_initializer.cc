@@ -3,6 +3,7 @@
 
 #include "core/framework/session_state_initializer.h"
 
+#include <algorithm>
 #include <functional>
 
 #include "core/common/common.h"
@@ -13,7 +14,9 @@
 #include "core/graph/graph_transformer_mgr.h"
 
 #include "core/framework/graph_partitioner.h"
+#include "core/framework/initializer_store.h"
 #include "core/framework/insert_cast_transformer.h"
+#include "core/framework/kernel_def_builder.h"
 #include "core/framework/ml_value.h"
 #include "core/framework/ml_value_patterns_planner.h"
 #include "core/framework/mlvalue_name_idx_map.h"
@@ -23,9 +26,14 @@
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/transformer_memcpy.h"
 #include "core/framework/utils.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
+// Deserializing an initializer or creating a kernel costs enough for any of them to be worth scheduling on
+// its own in the load thread pool.
+static constexpr double kLoadCostPerItem = 1e6;
+
 static common::Status SaveMLValueNameIndexMapping(const onnxruntime::Graph& graph,
                                                   MLValueNameIdxMap& mlvalue_name_idx_map,
                                                   const logging::Logger& logger);
@@ -39,11 +47,18 @@ static common::Status SaveInitializedTensors(const onnxruntime::Graph& graph,
                                              const MLValueNameIdxMap& mlvalue_name_idx_map,
                                              std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
                                              const SaveTensorFunc& save_tensor_func,
+                                             concurrency::ThreadPool* load_thread_pool,
+                                             InitializerStore* initializer_store,
+                                             const std::unordered_set<std::string>& releasable_initializers,
                                              const logging::Logger& logger);
 
+static std::unordered_set<std::string> FindReleasableInitializers(const onnxruntime::Graph& graph,
+                                                                  const KernelRegistryManager& kernel_registry_manager);
+
 static common::Status SaveKernels(const ExecutionProviders& execution_providers,
                                   SessionState& session_state,
                                   const KernelRegistryManager& custom_registry_manager,
+                                  concurrency::ThreadPool* load_thread_pool,
                                   const logging::Logger& logger);
 
 static common::Status SaveInputOutputNamesToNodeMapping(const onnxruntime::Graph& graph,
@@ -54,12 +69,14 @@ SessionStateInitializer::SessionStateInitializer(onnxruntime::Graph& graph,
                                                  SessionState& session_state,
                                                  const ExecutionProviders& providers,
                                                  KernelRegistryManager& kernel_registry_manager,
-                                                 const logging::Logger& logger)
+                                                 const logging::Logger& logger,
+                                                 concurrency::ThreadPool* load_thread_pool)
     : graph_{graph},
       session_state_{session_state},
       execution_providers_{providers},
       kernel_registry_manager_{kernel_registry_manager},
-      logger_{logger} {
+      logger_{logger},
+      load_thread_pool_{load_thread_pool} {
 }
 
 common::Status SessionStateInitializer::CreatePlan(const std::vector<NodeArg*>& outer_scope_node_args,
@@ -105,6 +122,13 @@ common::Status SessionStateInitializer::CreatePlan(const std::vector<NodeArg*>&
 
 common::Status SessionStateInitializer::InitializeAndSave(bool enable_memory_pattern,
                                                           std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers) {
+  ORT_RETURN_IF_ERROR(InitializeTensors(enable_memory_pattern, weights_buffers));
+  return CreateKernels();
+}
+
+common::Status SessionStateInitializer::InitializeTensors(bool enable_memory_pattern,
+                                                          std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
+                                                          InitializerStore* initializer_store) {
   const auto* exec_plan_ptr = session_state_.GetExecutionPlan();
   ORT_ENFORCE(exec_plan_ptr, "Execution plan was not found in SessionState. CreatePlan must be called first.");
 
@@ -116,15 +140,32 @@ common::Status SessionStateInitializer::InitializeAndSave(bool enable_memory_pat
     session_state_.AddInitializedTensor(idx, value);
   };
 
+  releasable_initializers_ = FindReleasableInitializers(graph_, kernel_registry_manager_);
+
   ORT_RETURN_IF_ERROR(SaveInitializedTensors(graph_, enable_memory_pattern, exec_plan,
                                              execution_providers_, mlvalue_name_idx_map, weights_buffers,
-                                             add_initialized_tensor, logger_));
+                                             add_initialized_tensor, load_thread_pool_, initializer_store,
+                                             releasable_initializers_, logger_));
 
   graph_.CleanAllInitializedTensors();  // remove weights from the graph now to save memory
 
-  ORT_RETURN_IF_ERROR(SaveKernels(execution_providers_, session_state_, kernel_registry_manager_, logger_));
+  return Status::OK();
+}
+
+common::Status SessionStateInitializer::CreateKernels() {
+  ORT_RETURN_IF_ERROR(SaveKernels(execution_providers_, session_state_, kernel_registry_manager_, load_thread_pool_,
+                                  logger_));
   ORT_RETURN_IF_ERROR(SaveInputOutputNamesToNodeMapping(graph_, kernel_registry_manager_, session_state_));
 
+  const auto& mlvalue_name_idx_map = session_state_.GetMLValueNameIdxMap();
+  for (const auto& name : releasable_initializers_) {
+    int mlvalue_index;
+    ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(name, mlvalue_index));
+    VLOGS(logger_, 1) << "Releasing the initializer " << name << " as the kernels don't read it anymore.";
+    session_state_.RemoveInitializedTensor(mlvalue_index);
+  }
+  releasable_initializers_.clear();
+
   return Status::OK();
 }
 
@@ -182,6 +223,10 @@ common::Status SaveMLValueNameIndexMapping(const onnxruntime::Graph& graph,
   return Status::OK();
 }
 
+static bool DeserializesToCpu(const OrtAllocatorInfo& alloc_info) {
+  return strcmp(alloc_info.name, CPU) == 0 || alloc_info.mem_type == OrtMemTypeCPUOutput;
+}
+
 common::Status DeserializeTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                       const OrtAllocatorInfo& alloc_info,
                                       const ExecutionProviders& exec_providers,
@@ -191,7 +236,7 @@ common::Status DeserializeTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_
     return Status(common::ONNXRUNTIME, common::FAIL, "Failed to get allocator for alloc_info: " + alloc_info.ToString());
   }
 
-  if (strcmp(alloc_info.name, CPU) == 0 || alloc_info.mem_type == OrtMemTypeCPUOutput) {
+  if (DeserializesToCpu(alloc_info)) {
     // deserialize directly to CPU tensor
     return utils::TensorProtoToMLValue(tensor_proto, alloc_ptr, preallocated, preallocated_size, mlvalue);
   }
@@ -230,6 +275,96 @@ common::Status DeserializeTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_
   return common::Status::OK();
 }
 
+// An initializer to deserialize and where to
+struct InitializerToLoad {
+  const std::string* name;
+  const ONNX_NAMESPACE::TensorProto* tensor_proto;
+  const OrtAllocatorInfo* location;
+  int mlvalue_index;
+  void* preallocated;
+  size_t preallocated_size;
+};
+
+// Whether a tensor from an initializer store can be used for the given initializer.
+// Protects against sessions sharing a store while loading different models.
+static bool MatchesTensorProto(const MLValue& mlvalue, const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  if (!mlvalue.IsTensor()) {
+    return false;
+  }
+  const Tensor& tensor = mlvalue.Get<Tensor>();
+  return utils::GetTensorProtoType(tensor) == tensor_proto.data_type() &&
+         tensor.Shape() == TensorShape(utils::GetTensorShapeFromTensorProto(tensor_proto));
+}
+
+// Deserialize the initializers and save them in order.
+// The initializers deserialized directly to CPU don't depend on each other so they are deserialized on the load
+// thread pool. The others are copied to their device on the calling thread, as execution providers may keep
+// per thread device state.
+// With an initializer store, the initializers found in it are used as is and the others are added to it.
+static common::Status LoadInitializers(const std::vector<InitializerToLoad>& initializers,
+                                       const ExecutionProviders& exec_providers,
+                                       const SaveTensorFunc& save_tensor_func,
+                                       concurrency::ThreadPool* load_thread_pool,
+                                       InitializerStore* initializer_store,
+                                       const logging::Logger& logger) {
+  std::vector<MLValue> mlvalues(initializers.size());
+  std::vector<Status> statuses(initializers.size());
+
+  auto deserialize = [&](size_t i) {
+    const auto& initializer = initializers[i];
+    if (initializer_store != nullptr &&
+        initializer_store->Find(*initializer.name, *initializer.location, mlvalues[i]) &&
+        MatchesTensorProto(mlvalues[i], *initializer.tensor_proto)) {
+      return;
+    }
+
+    MLValue mlvalue;
+    statuses[i] = DeserializeTensorProto(*initializer.tensor_proto, *initializer.location, exec_providers,
+                                         mlvalue, initializer.preallocated, initializer.preallocated_size);
+    if (statuses[i].IsOK() && initializer_store != nullptr) {
+      // another session may have added it meanwhile, keep a single copy
+      MLValue stored = initializer_store->Add(*initializer.name, *initializer.location, mlvalue);
+      if (MatchesTensorProto(stored, *initializer.tensor_proto)) {
+        mlvalue = stored;
+      }
+    }
+    mlvalues[i] = mlvalue;
+  };
+
+  std::vector<size_t> cpu_initializers;
+  for (size_t i = 0; i < initializers.size(); ++i) {
+    if (DeserializesToCpu(*initializers[i].location)) {
+      cpu_initializers.push_back(i);
+    } else {
+      deserialize(i);
+    }
+  }
+
+  concurrency::ThreadPool::TryParallelFor(load_thread_pool, static_cast<std::ptrdiff_t>(cpu_initializers.size()),
+                                          kLoadCostPerItem, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                            for (std::ptrdiff_t i = first; i < last; ++i) {
+                                              deserialize(cpu_initializers[i]);
+                                            }
+                                          });
+
+  for (size_t i = 0; i < initializers.size(); ++i) {
+    const auto& initializer = initializers[i];
+    const Status& st = statuses[i];
+    if (!st.IsOK()) {
+      std::ostringstream oss;
+      oss << "Deserialize tensor " << *initializer.name << " failed." << st.ErrorMessage();
+      return Status(st.Category(), st.Code(), oss.str());
+    }
+
+    save_tensor_func(initializer.mlvalue_index, mlvalues[i]);
+
+    VLOGS(logger, 1) << "Added weight with name : " << *initializer.name
+                     << " with index: " << initializer.mlvalue_index;
+  }
+
+  return Status::OK();
+}
+
 static common::Status PlanTensor(MLValuePatternPlanner& planner, const MLValueNameIdxMap& mlvalue_name_idx_map, const std::string& name, const ONNX_NAMESPACE::TensorProto& tensor_proto) {
   int mlvalue_index;
   ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(name, mlvalue_index));
@@ -246,6 +381,8 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
                                                     const MLValueNameIdxMap& mlvalue_name_idx_map,
                                                     std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
                                                     const SaveTensorFunc& save_tensor_func,
+                                                    concurrency::ThreadPool* load_thread_pool,
+                                                    const std::unordered_set<std::string>& releasable_initializers,
                                                     const logging::Logger& logger) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
 
@@ -254,8 +391,12 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
   MLValuePatternPlanner planner(execution_plan);
 
   //1. first plan the memory
+  // the initializers to be released get a buffer of their own instead, so that releasing them frees it
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   for (const auto& entry : initialized_tensor_set) {
+    if (releasable_initializers.count(entry.first) > 0) {
+      continue;
+    }
     //string/complex64/complex128 tensors will be skipped
     ORT_RETURN_IF_ERROR(PlanTensor(planner, mlvalue_name_idx_map, entry.first, *entry.second));
   }
@@ -278,6 +419,8 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
   }
 
   //3. create weight tensors based on weights buffer
+  std::vector<InitializerToLoad> initializers;
+  initializers.reserve(initialized_tensor_set.size());
   for (const auto& entry : initialized_tensor_set) {
     const std::string& name = entry.first;
     int mlvalue_index;
@@ -293,7 +436,6 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
     if (pattern == nullptr)
       return Status(common::ONNXRUNTIME, common::FAIL, "mem pattern not found");
     auto block = pattern->GetBlock(mlvalue_index);
-    MLValue mlvalue;
     // if block is not found, means this mlvalue is not traced
     // fall back to allocate separate buffer.
 
@@ -301,24 +443,17 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
     if (it->second == nullptr) {
       block = nullptr;
     }
-    Status st;
     if (!block) {
-      st = DeserializeTensorProto(tensor_proto, location, exec_providers, mlvalue, nullptr, 0);
+      initializers.push_back({&name, &tensor_proto, &location, mlvalue_index, nullptr, 0});
     } else {
-      st = DeserializeTensorProto(tensor_proto, location, exec_providers, mlvalue,
-                                  (uint8_t*)it->second.get() + block->offset_, block->size_);
-    }
-    if (!st.IsOK()) {
-      std::ostringstream oss;
-      oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-      return Status(st.Category(), st.Code(), oss.str());
+      initializers.push_back({&name, &tensor_proto, &location, mlvalue_index,
+                              (uint8_t*)it->second.get() + block->offset_, block->size_});
     }
-
-    save_tensor_func(mlvalue_index, mlvalue);
-
-    VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << mlvalue_index;
   }
 
+  ORT_RETURN_IF_ERROR(LoadInitializers(initializers, exec_providers, save_tensor_func, load_thread_pool, nullptr,
+                                       logger));
+
   LOGS(logger, INFO) << "Done saving initialized tensors";
   return common::Status::OK();
 }
@@ -328,24 +463,28 @@ common::Status SaveInitializedTensorsWithSeperateBuffer(const onnxruntime::Graph
                                                         const ExecutionProviders& exec_providers,
                                                         const MLValueNameIdxMap& mlvalue_name_idx_map,
                                                         const SaveTensorFunc& save_tensor_func,
+                                                        concurrency::ThreadPool* load_thread_pool,
+                                                        InitializerStore* initializer_store,
                                                         const logging::Logger& logger) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
 
   ORT_ENFORCE(mlvalue_name_idx_map.MaxIdx() > 0, "MLValue indexes should have been populated.");
 
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
+  std::vector<InitializerToLoad> initializers;
+  initializers.reserve(initialized_tensor_set.size());
   for (const auto& entry : initialized_tensor_set) {
     const std::string& name = entry.first;
     int mlvalue_index;
     ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(name, mlvalue_index));
     VLOGS(logger, 1) << "About to add weight with name: " << name << " and index: " << mlvalue_index;
     auto& location = execution_plan.allocation_plan[mlvalue_index].location;
-    MLValue mlvalue;
-    ORT_RETURN_IF_ERROR(DeserializeTensorProto(*(entry.second), location, exec_providers, mlvalue, nullptr, 0));
-    save_tensor_func(mlvalue_index, mlvalue);
-    VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << mlvalue_index;
+    initializers.push_back({&name, entry.second, &location, mlvalue_index, nullptr, 0});
   }
 
+  ORT_RETURN_IF_ERROR(LoadInitializers(initializers, exec_providers, save_tensor_func, load_thread_pool,
+                                       initializer_store, logger));
+
   LOGS(logger, INFO) << "Done saving initialized tensors";
   return common::Status::OK();
 }
@@ -357,16 +496,61 @@ common::Status SaveInitializedTensors(const onnxruntime::Graph& graph,
                                       const MLValueNameIdxMap& mlvalue_name_idx_map,
                                       std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
                                       const SaveTensorFunc& save_tensor_func,
+                                      concurrency::ThreadPool* load_thread_pool,
+                                      InitializerStore* initializer_store,
+                                      const std::unordered_set<std::string>& releasable_initializers,
                                       const logging::Logger& logger) {
   // if we enable the memory pattern and already have the execution plan
   // go with mem pattern approach, which will allocate a big chunk for all
-  // the weights.
-  if (enable_memory_pattern) {
+  // the weights. shared initializers can't be carved from a buffer owned by the session.
+  if (enable_memory_pattern && initializer_store == nullptr) {
     return SaveInitializedTensorsWithMemPattern(graph, execution_plan, exec_providers,
-                                                mlvalue_name_idx_map, weights_buffers, save_tensor_func, logger);
+                                                mlvalue_name_idx_map, weights_buffers, save_tensor_func,
+                                                load_thread_pool, releasable_initializers, logger);
   }
   return SaveInitializedTensorsWithSeperateBuffer(graph, execution_plan, exec_providers,
-                                                  mlvalue_name_idx_map, save_tensor_func, logger);
+                                                  mlvalue_name_idx_map, save_tensor_func, load_thread_pool,
+                                                  initializer_store, logger);
+}
+
+// Find the initializers that all their consumers only read when their kernels are created, see
+// KernelDefBuilder::ReleasableInput. The graph outputs and the initializers used by subgraphs are kept.
+std::unordered_set<std::string> FindReleasableInitializers(const onnxruntime::Graph& graph,
+                                                           const KernelRegistryManager& kernel_registry_manager) {
+  const auto& initializers = graph.GetAllInitializedTensors();
+  std::unordered_set<std::string> releasable;
+  std::unordered_set<std::string> used;
+
+  for (const auto& node : graph.Nodes()) {
+    const KernelDef* kernel_def = utils::GetKernelDef(kernel_registry_manager, node);
+    const auto& input_defs = node.InputDefs();
+    for (int i = 0; i < static_cast<int>(input_defs.size()); ++i) {
+      const auto& name = input_defs[i]->Name();
+      if (!input_defs[i]->Exists() || initializers.find(name) == initializers.end()) {
+        continue;
+      }
+
+      bool is_releasable = false;
+      if (kernel_def != nullptr) {
+        const auto& inputs = kernel_def->ReleasableInputs();
+        is_releasable = std::find(inputs.cbegin(), inputs.cend(), i) != inputs.cend();
+      }
+      (is_releasable ? releasable : used).insert(name);
+    }
+
+    for (const auto* implicit_input_def : node.ImplicitInputDefs()) {
+      used.insert(implicit_input_def->Name());
+    }
+  }
+
+  for (const auto* output_def : graph.GetOutputs()) {
+    used.insert(output_def->Name());
+  }
+  for (const auto& name : used) {
+    releasable.erase(name);
+  }
+
+  return releasable;
 }
 
 static common::Status CreateOpKernelInternal(const onnxruntime::Node& node,
@@ -406,14 +590,45 @@ static common::Status CreateOpKernel(const onnxruntime::Node& node,
 common::Status SaveKernels(const ExecutionProviders& execution_providers,
                            SessionState& session_state,
                            const KernelRegistryManager& custom_registry_manager,
+                           concurrency::ThreadPool* load_thread_pool,
                            const logging::Logger& logger) {
   LOGS(logger, INFO) << "Saving kernels.";
 
+  std::vector<const onnxruntime::Node*> nodes;
   for (auto& node : session_state.GetGraphViewer()->Nodes()) {
-    // construct and save the kernels
-    std::unique_ptr<OpKernel> op_kernel;
-    ORT_RETURN_IF_ERROR(CreateOpKernel(node, execution_providers, session_state, custom_registry_manager, op_kernel, logger));
-    session_state.AddKernel(node.Index(), std::move(op_kernel));
+    nodes.push_back(&node);
+  }
+
+  std::vector<std::unique_ptr<OpKernel>> op_kernels(nodes.size());
+  std::vector<Status> statuses(nodes.size());
+
+  auto create_kernel = [&](size_t i) {
+    statuses[i] = CreateOpKernel(*nodes[i], execution_providers, session_state, custom_registry_manager,
+                                 op_kernels[i], logger);
+  };
+
+  // the CPU kernels are independent of each other and can be constructed concurrently. kernels of other execution
+  // providers may set up device state in their constructor, which is done on the calling thread.
+  std::vector<size_t> cpu_nodes;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (nodes[i]->GetExecutionProviderType() == kCpuExecutionProvider) {
+      cpu_nodes.push_back(i);
+    } else {
+      create_kernel(i);
+    }
+  }
+
+  concurrency::ThreadPool::TryParallelFor(load_thread_pool, static_cast<std::ptrdiff_t>(cpu_nodes.size()),
+                                          kLoadCostPerItem, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                            for (std::ptrdiff_t i = first; i < last; ++i) {
+                                              create_kernel(cpu_nodes[i]);
+                                            }
+                                          });
+
+  // construct and save the kernels
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    ORT_RETURN_IF_ERROR(statuses[i]);
+    session_state.AddKernel(nodes[i]->Index(), std::move(op_kernels[i]));
   }
 
   LOGS(logger, INFO) << "Done saving kernels.";
@@ -435,6 +650,9 @@ common::Status SaveInputOutputNamesToNodeMapping(const onnxruntime::Graph& graph
   auto& graph_inputs = graph.GetInputsIncludingInitializers();
   auto& graph_outputs = graph.GetOutputs();
 
+  // whether all the kernels that consume a graph input accept a compact string tensor for it
+  std::unordered_map<std::string, bool> compact_string_inputs;
+
   for (auto& node : graph.Nodes()) {
     ORT_RETURN_IF_ERROR(
         onnxruntime::Node::ForEachWithIndex(
@@ -452,6 +670,15 @@ common::Status SaveInputOutputNamesToNodeMapping(const onnxruntime::Graph& graph
 
               if (IsArgNameInInputsOutputs(arg.Name(), graph_inputs)) {
                 session_state.AddInputNameToNodeInfoMapping(arg.Name(), node_info);
+
+                bool accepts_compact_string = false;
+                if (kci != nullptr) {
+                  const auto& inputs = kci->kernel_def->CompactStringInputs();
+                  accepts_compact_string = std::find(inputs.begin(), inputs.end(), static_cast<int>(index)) !=
+                                           inputs.end();
+                }
+                auto entry = compact_string_inputs.emplace(arg.Name(), true).first;
+                entry->second = entry->second && accepts_compact_string;
                 return Status::OK();
               }
 
@@ -462,6 +689,25 @@ common::Status SaveInputOutputNamesToNodeMapping(const onnxruntime::Graph& graph
 
               return Status::OK();
             }));
+
+    // the kernels of a subgraph read its implicit inputs as std::string
+    for (auto* arg : node.ImplicitInputDefs()) {
+      compact_string_inputs[arg->Name()] = false;
+    }
+  }
+
+  // a graph input that is also a graph output is returned to the caller as std::string
+  for (auto* arg : graph_outputs) {
+    auto entry = compact_string_inputs.find(arg->Name());
+    if (entry != compact_string_inputs.end()) {
+      entry->second = false;
+    }
+  }
+
+  for (auto& entry : compact_string_inputs) {
+    if (entry.second) {
+      session_state.AddCompactStringInput(entry.first);
+    }
   }
 
   return Status::OK();
@@ -3,6 +3,8 @@
 
 #pragma once
 #include <map>
+#include <string>
+#include <unordered_set>
 
 #include "core/framework/allocator.h"
 #include "core/framework/tensor.h"
@@ -11,11 +13,16 @@ namespace onnxruntime {
 class ExecutionProviders;
 class Graph;
 class GraphTransformerManager;
+class InitializerStore;
 class InsertCastTransformer;
 class KernelRegistryManager;
 class NodeArg;
 class SessionState;
 
+namespace concurrency {
+class ThreadPool;
+}
+
 namespace logging {
 class Logger;
 }
@@ -26,7 +33,8 @@ class SessionStateInitializer {
                           SessionState& session_state,
                           const ExecutionProviders& providers,
                           KernelRegistryManager& kernel_registry_manager,
-                          const logging::Logger& logger);
+                          const logging::Logger& logger,
+                          concurrency::ThreadPool* load_thread_pool = nullptr);
 
   // First perform any transformations and create the execution plan
   common::Status CreatePlan(const std::vector<NodeArg*>& outer_scope_node_args,
@@ -37,6 +45,19 @@ class SessionStateInitializer {
   common::Status InitializeAndSave(bool enable_memory_pattern,
                                    std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers);
 
+  // initialize tensors and save them. the initializers are removed from the graph afterwards.
+  // initializers on CPU are deserialized on the load thread pool if one was provided.
+  // if an initializer store is provided the initializers are taken from it, or deserialized and added to it. they
+  // get their own buffer then instead of being allocated from weights_buffers, so they can outlive this session.
+  common::Status InitializeTensors(bool enable_memory_pattern,
+                                   std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
+                                   InitializerStore* initializer_store = nullptr);
+
+  // create and save the kernels and the input/output node mappings. must follow InitializeTensors as the kernels
+  // may read constant initializers. kernels of the CPU execution provider are created on the load thread pool
+  // if one was provided. the initializers that are only read by the kernels being created are released then.
+  common::Status CreateKernels();
+
  private:
   onnxruntime::Graph& graph_;
   SessionState& session_state_;
@@ -44,5 +65,9 @@ class SessionStateInitializer {
   const ExecutionProviders& execution_providers_;
   KernelRegistryManager& kernel_registry_manager_;
   const logging::Logger& logger_;
+  concurrency::ThreadPool* const load_thread_pool_;
+
+  // initializers that the kernels only read when they are created, released once they are
+  std::unordered_set<std::string> releasable_initializers_;
 };
 }  // namespace onnxruntime
@@ -19,6 +19,24 @@ Tensor::Tensor(MLDataType p_type,
   Init(p_type, shape, p_data, alloc, std::move(deleter), offset);
 }
 
+Tensor::Tensor(const TensorShape& shape,
+               const char* chars,
+               size_t chars_len,
+               const size_t* offsets,
+               const OrtAllocatorInfo& alloc,
+               BufferNakedPtr p_buffer,
+               AllocatorPtr deleter)
+    : alloc_info_(alloc) {
+  // no deleter yet, so that no std::string is constructed in the buffer
+  Init(DataTypeImpl::GetType<string>(), shape, p_buffer, alloc, nullptr);
+  buffer_deleter_ = std::move(deleter);
+  compact_string_.enabled = true;
+  compact_string_.chars = chars;
+  compact_string_.chars_len = chars_len;
+  compact_string_.offsets = offsets;
+  compact_string_.count = shape.Size();
+}
+
 void Tensor::Init(MLDataType p_type,
                   const TensorShape& shape,
                   void* p_raw_data,
@@ -43,6 +61,8 @@ void Tensor::Init(MLDataType p_type,
   }
   alloc_info_ = alloc;
   byte_offset_ = offset;
+  strides_.clear();
+  compact_string_ = CompactString();
 }
 
 Tensor::Tensor(Tensor&& other)
@@ -51,12 +71,16 @@ Tensor::Tensor(Tensor&& other)
       shape_(other.shape_),
       dtype_(other.dtype_),
       alloc_info_(other.alloc_info_),
-      byte_offset_(other.byte_offset_) {
+      byte_offset_(other.byte_offset_),
+      strides_(std::move(other.strides_)),
+      compact_string_(other.compact_string_) {
   other.dtype_ = DataTypeImpl::GetType<float>();
   other.shape_ = TensorShape(vector<int64_t>(1, 0));
   other.p_data_ = nullptr;
   other.buffer_deleter_ = nullptr;
   other.byte_offset_ = 0;
+  other.strides_.clear();
+  other.compact_string_ = CompactString();
 }
 
 Tensor& Tensor::operator=(Tensor&& other) {
@@ -67,6 +91,8 @@ Tensor& Tensor::operator=(Tensor&& other) {
     shape_ = other.shape_;
     alloc_info_ = other.alloc_info_;
     byte_offset_ = other.byte_offset_;
+    strides_ = std::move(other.strides_);
+    compact_string_ = other.compact_string_;
     p_data_ = other.p_data_;
     buffer_deleter_ = other.buffer_deleter_;
 
@@ -74,13 +100,20 @@ Tensor& Tensor::operator=(Tensor&& other) {
     other.shape_ = TensorShape(vector<int64_t>(1, 0));
     other.p_data_ = nullptr;
     other.byte_offset_ = 0;
+    other.strides_.clear();
+    other.compact_string_ = CompactString();
     other.buffer_deleter_ = nullptr;
   }
   return *this;
 }
 
 Tensor::Tensor(const Tensor& src)
-    : shape_(src.shape_), dtype_(src.dtype_), alloc_info_(src.alloc_info_), byte_offset_(src.byte_offset_) {
+    : shape_(src.shape_),
+      dtype_(src.dtype_),
+      alloc_info_(src.alloc_info_),
+      byte_offset_(src.byte_offset_),
+      strides_(src.strides_),
+      compact_string_(src.compact_string_) {
   // it may be better to refactor it a little bit to make it a compile error
   // but right now just keep it simple first.
   ORT_ENFORCE(src.buffer_deleter_ == nullptr,
@@ -104,18 +137,55 @@ Tensor& Tensor::ShallowCopy(const Tensor& other) {
     alloc_info_ = other.alloc_info_;
     shape_ = other.shape_;
     byte_offset_ = other.byte_offset_;
+    strides_ = other.strides_;
+    compact_string_ = other.compact_string_;
     p_data_ = other.p_data_;
     buffer_deleter_ = nullptr;
   }
   return *this;
 }
 
+std::vector<int64_t> Tensor::Strides() const {
+  if (!strides_.empty()) {
+    return strides_;
+  }
+  const auto& dims = shape_.GetDims();
+  std::vector<int64_t> strides(dims.size());
+  int64_t stride = 1;
+  for (size_t i = dims.size(); i-- > 0;) {
+    strides[i] = stride;
+    stride *= dims[i];
+  }
+  return strides;
+}
+
+void Tensor::SetStrides(const std::vector<int64_t>& strides) {
+  const auto& dims = shape_.GetDims();
+  ORT_ENFORCE(strides.size() == dims.size(), "Tensor rank (", dims.size(), ") != number of strides (",
+              strides.size(), ")");
+  // the stride of an axis with a single index is never used, so it does not make a tensor strided
+  bool is_contiguous = true;
+  int64_t stride = 1;
+  for (size_t i = dims.size(); i-- > 0;) {
+    if (dims[i] != 1 && strides[i] != stride) {
+      is_contiguous = false;
+      break;
+    }
+    stride *= dims[i];
+  }
+  if (is_contiguous) {
+    strides_.clear();
+  } else {
+    strides_ = strides;
+  }
+}
+
 void Tensor::ReleaseBuffer() {
   if (buffer_deleter_) {
     // if current tensor is responsible for delete the buffer
     // and it is a string tensor, need to explict call string's
     // deconstructor.
-    if (dtype_ == DataTypeImpl::GetType<string>()) {
+    if (dtype_ == DataTypeImpl::GetType<string>() && !compact_string_.enabled) {
       auto* ptr = static_cast<string*>(p_data_);
       int64_t len = shape_.Size();
       for (int64_t i = 0; i < len; i++)
@@ -4,6 +4,7 @@
 #include "core/graph/constants.h"
 #include "core/graph/contrib_ops/attn_lstm_schema_defs.h"
 #include "core/graph/contrib_ops/contrib_defs.h"
+#include "core/graph/contrib_ops/dynamic_quantize_rnn_schema_defs.h"
 #include "core/graph/contrib_ops/range_schema_defs.h"
 #include "core/graph/op.h"
 #include "onnx/defs/shape_inference.h"
@@ -253,6 +254,8 @@ activation.)DOC")
 
   ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(AttnLSTM, RegisterAttnLSTMContribOpSchema);
   ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(Range, RegisterRangeOpSchema);
+  ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(DynamicQuantizeLSTM, RegisterDynamicQuantizeLSTMOpSchema);
+  ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(DynamicQuantizeGRU, RegisterDynamicQuantizeGRUOpSchema);
 
   ONNX_CONTRIB_OPERATOR_SCHEMA(Tokenizer)
       .SetDomain(kMSDomain)
@@ -786,10 +789,13 @@ Note that this algorithm is agnostic to where the origin is in the coordinate sy
 orthogonal transformations and translations of the coordinate system;
 thus translating or reflections of the coordinate system result in the same boxes being selected by the algorithm.
 The output of this operation is a set of integers indexing into the input collection of bounding boxes representing the selected boxes.
-The bounding box coordinates corresponding to the selected indices can then be obtained using the gather operation.)DOC")
-      .Input(0, "boxes", "An input tensor. 2D tensor with shape [num_boxes, 4]", "T1")
-      .Input(1, "scores", "An input tensor. 1D tensor with shape [num_boxes]", "T1")
-      .Output(0, "selected_indices", "selected indices from the boxes tensor.", "T2")
+The bounding box coordinates corresponding to the selected indices can then be obtained using the gather operation.
+The boxes may also be batched with shape [num_batches, num_boxes, 4] and scores of shape [num_batches, num_classes, num_boxes].
+The boxes of every batch and class are then suppressed independently, max_output_size applies to each of them and the
+selected indices are returned as [num_selected_indices, 3] triples of [batch_index, class_index, box_index].)DOC")
+      .Input(0, "boxes", "An input tensor. 2D tensor with shape [num_boxes, 4] or 3D tensor with shape [num_batches, num_boxes, 4]", "T1")
+      .Input(1, "scores", "An input tensor. 1D tensor with shape [num_boxes] or 3D tensor with shape [num_batches, num_classes, num_boxes]", "T1")
+      .Output(0, "selected_indices", "selected indices from the boxes tensor. 1D for 2D boxes, [num_selected_indices, 3] for 3D boxes.", "T2")
       .Output(
           1,
           "valid_outputs",
@@ -815,7 +821,7 @@ The bounding box coordinates corresponding to the selected indices can then be o
           AttributeProto::FLOAT)
       .Attr(
           "pad_to_max_output_size",
-          "Optional. 1(true) - the output selected_indices is padded to be of length max_output_size. Defaults to 0(false).",
+          "Optional. 1(true) - the output selected_indices is padded to be of length max_output_size. Only supported for 2D boxes. Defaults to 0(false).",
           AttributeProto::INT,
           OPTIONAL)
       .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
@@ -0,0 +1,220 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "dynamic_quantize_rnn_schema_defs.h"
+
+#include "core/graph/constants.h"
+#include "core/graph/op.h"
+#include "onnx/defs/shape_inference.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+using ::ONNX_NAMESPACE::AttributeProto;
+using ::ONNX_NAMESPACE::InferenceContext;
+using ::ONNX_NAMESPACE::OPTIONAL;
+using ::ONNX_NAMESPACE::OpSchema;
+using ::ONNX_NAMESPACE::TensorShapeProto;
+
+static const char* DynamicQuantizeLSTM_ver1_doc = R"DOC(
+Computes a one-layer LSTM. Inputs, outputs, attributes and equations are the same as the ONNX LSTM operator.
+
+W and R must be initializers. They are quantized to uint8 with a scale and zero point per direction when the
+kernel is created. The inputs and the hidden state are quantized on each step using their range, and the
+gate projections Xt*(W[iofc]^T) and Ht-1*(R[iofc]^T) are computed with an integer GEMM. Everything else,
+including the bias, peepholes, activations and cell state, is computed in float.
+)DOC";
+
+static const char* DynamicQuantizeGRU_ver1_doc = R"DOC(
+Computes a one-layer GRU. Inputs, outputs, attributes and equations are the same as the ONNX GRU operator.
+
+W and R must be initializers. They are quantized to uint8 with a scale and zero point per direction when the
+kernel is created. The inputs and the hidden state are quantized on each step using their range, and the
+gate projections Xt*(W[zrh]^T) and Ht-1*(R[zrh]^T) are computed with an integer GEMM. Everything else,
+including the bias and activations, is computed in float.
+)DOC";
+
+// Y has shape [seq_length, num_directions, batch_size, hidden_size]
+// Y_h (and Y_c for LSTM) have shape [num_directions, batch_size, hidden_size]
+static void DynamicQuantizeRnnShapeInference(InferenceContext& ctx) {
+  for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+    propagateElemTypeFromInputToOutput(ctx, 0, i);
+  }
+
+  if (!hasInputShape(ctx, 0))
+    return;
+
+  auto& X_shape = getInputShape(ctx, 0);
+  if (X_shape.dim_size() != 3)
+    fail_shape_inference("Input X must have 3 dimensions.");
+
+  TensorShapeProto::Dimension num_directions;
+  auto* direction = ctx.getAttribute("direction");
+  num_directions.set_dim_value(direction != nullptr && direction->s() == "bidirectional" ? 2 : 1);
+
+  TensorShapeProto::Dimension hidden_size;
+  auto* hidden_size_attr = ctx.getAttribute("hidden_size");
+  if (hidden_size_attr != nullptr)
+    hidden_size.set_dim_value(hidden_size_attr->i());
+
+  const auto& seq_length = X_shape.dim(0);
+  const auto& batch_size = X_shape.dim(1);
+
+  if (ctx.getNumOutputs() > 0)
+    updateOutputShape(ctx, 0, {seq_length, num_directions, batch_size, hidden_size});
+
+  for (size_t i = 1; i < ctx.getNumOutputs(); ++i) {
+    updateOutputShape(ctx, i, {num_directions, batch_size, hidden_size});
+  }
+}
+
+// attributes, inputs and outputs that LSTM and GRU have in common
+static OpSchema& CommonRnnSchema(OpSchema& op_schema, int num_gates) {
+  const std::string gates = std::to_string(num_gates);
+  return op_schema
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr(
+          "activations",
+          "A list of activation functions for the gates. See the ONNX operator for the defaults.",
+          AttributeProto::STRINGS,
+          OPTIONAL)
+      .Attr(
+          "activation_alpha",
+          "Optional scaling values used by some activation functions. The values are consumed "
+          "in the order of activation functions.",
+          AttributeProto::FLOATS,
+          OPTIONAL)
+      .Attr(
+          "activation_beta",
+          "Optional scaling values used by some activation functions. The values are consumed "
+          "in the order of activation functions.",
+          AttributeProto::FLOATS,
+          OPTIONAL)
+      .Attr(
+          "clip",
+          "Cell clip threshold. Clipping bounds the elements of a tensor in the range of "
+          "[-threshold, +threshold] and is applied to the input of activations. No clip if not "
+          "specified.",
+          AttributeProto::FLOAT,
+          OPTIONAL)
+      .Attr(
+          "hidden_size",
+          "Number of neurons in the hidden layer.",
+          AttributeProto::INT,
+          OPTIONAL)
+      .Attr(
+          "direction",
+          "Specify if the RNN is forward, reverse, or bidirectional. Must be one of "
+          "forward (default), reverse, or bidirectional.",
+          AttributeProto::STRING,
+          std::string("forward"))
+      .TypeConstraint(
+          "T",
+          {"tensor(float)"},
+          "Constrain input and output types to float tensors.")
+      .TypeConstraint(
+          "T1",
+          {"tensor(int32)"},
+          "Constrain seq_lens to integral tensors.")
+      .Input(
+          0,
+          "X",
+          "The input sequences packed (and potentially padded) into one 3-D tensor "
+          "with the shape of `[seq_length, batch_size, input_size]`.",
+          "T")
+      .Input(
+          1,
+          "W",
+          "The weight tensor for the gates. Must be an initializer. It has shape "
+          "`[num_directions, " + gates + "*hidden_size, input_size]`.",
+          "T")
+      .Input(
+          2,
+          "R",
+          "The recurrence weight tensor. Must be an initializer. It has shape "
+          "`[num_directions, " + gates + "*hidden_size, hidden_size]`.",
+          "T")
+      .Input(
+          3,
+          "B",
+          "The bias tensor. It has shape `[num_directions, " + std::to_string(2 * num_gates) +
+              "*hidden_size]`. Optional: If not specified - assumed to be 0.",
+          "T",
+          OpSchema::Optional)
+      .Input(
+          4,
+          "sequence_lens",
+          "Optional tensor specifying lengths of the sequences in a batch. If not "
+          "specified - assumed all sequences in the batch to have length `seq_length`. "
+          "It has shape `[batch_size]`.",
+          "T1",
+          OpSchema::Optional)
+      .Input(
+          5,
+          "initial_h",
+          "Optional initial value of the hidden. If not specified - assumed to be 0. "
+          "It has shape `[num_directions, batch_size, hidden_size]`.",
+          "T",
+          OpSchema::Optional)
+      .Output(
+          0,
+          "Y",
+          "A tensor that concats all the intermediate output values of the hidden. "
+          "It has shape `[seq_length, num_directions, batch_size, hidden_size]`.",
+          "T",
+          OpSchema::Optional)
+      .Output(
+          1,
+          "Y_h",
+          "The last output value of the hidden. It has shape `[num_directions, "
+          "batch_size, hidden_size]`.",
+          "T",
+          OpSchema::Optional)
+      .TypeAndShapeInferenceFunction(DynamicQuantizeRnnShapeInference);
+}
+
+OpSchema& RegisterDynamicQuantizeLSTMOpSchema(OpSchema&& op_schema) {
+  return CommonRnnSchema(op_schema, 4)
+      .Attr(
+          "input_forget",
+          "Couple the input and forget gates if 1, default 0.",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .Input(
+          6,
+          "initial_c",
+          "Optional initial value of the cell. If not specified - assumed "
+          "to be 0. It has shape `[num_directions, batch_size, hidden_size]`.",
+          "T",
+          OpSchema::Optional)
+      .Input(
+          7,
+          "P",
+          "The weight tensor for peepholes. It has shape `[num_directions, 3*hidden_size]`. "
+          "Optional: If not specified - assumed to be 0.",
+          "T",
+          OpSchema::Optional)
+      .Output(
+          2,
+          "Y_c",
+          "The last output value of the cell. It has shape "
+          "`[num_directions, batch_size, hidden_size]`.",
+          "T",
+          OpSchema::Optional)
+      .SetDoc(DynamicQuantizeLSTM_ver1_doc);
+}
+
+OpSchema& RegisterDynamicQuantizeGRUOpSchema(OpSchema&& op_schema) {
+  return CommonRnnSchema(op_schema, 3)
+      .Attr(
+          "linear_before_reset",
+          "When computing the output of the hidden gate, apply the linear transformation "
+          "before multiplying by the output of the reset gate.",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .SetDoc(DynamicQuantizeGRU_ver1_doc);
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
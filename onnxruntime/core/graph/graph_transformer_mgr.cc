@@ -21,4 +21,12 @@ Status GraphTransformerManager::ApplyAll(Graph& graph) const {
   return Status::OK();
 }
 
+std::string GraphTransformerManager::Description() const {
+  std::string description = std::to_string(steps_);
+  for (auto& transformer : transformers_) {
+    description += "," + transformer->Name();
+  }
+  return description;
+}
+
 }  // namespace onnxruntime
@@ -24,6 +24,10 @@ class GraphTransformerManager {
   // up to the given number of steps.
   common::Status ApplyAll(Graph& graph) const;
 
+  // The number of steps and the names of the registered transformers in order,
+  // e.g. to tell apart graphs transformed differently.
+  std::string Description() const;
+
  private:
   GraphTransformerManager() = default;
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphTransformerManager);
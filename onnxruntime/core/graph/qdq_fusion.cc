@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/qdq_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include <deque>
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+// returns the node producing the input at input_index, or nullptr for a graph input or initializer
+Node* GetInputNode(Graph& graph, const Node& node, int input_index) {
+  for (auto it = node.InputEdgesBegin(); it != node.InputEdgesEnd(); ++it) {
+    if (it->GetDstArgIndex() == input_index) {
+      return graph.GetNode(it->GetNode().Index());
+    }
+  }
+  return nullptr;
+}
+
+bool IsUInt8(const NodeArg* arg) {
+  const auto* type = arg->TypeAsProto();
+  return type != nullptr && type->has_tensor_type() && type->tensor_type().elem_type() == TensorProto_DataType_UINT8;
+}
+
+// the fused kernels only support per-tensor uint8 quantization
+bool IsPerTensorUInt8(const Node& node, const std::string& op_type) {
+  return utils::IsSupportedOptypeVersionAndDomain(node, op_type, 1, kMSDomain) &&
+         node.GetAttributes().find("axis") == node.GetAttributes().end() &&
+         node.InputDefs().size() == 3 && IsUInt8(node.InputDefs()[2]);
+}
+
+// a DequantizeLinear node can be fused if the op is its only consumer
+bool IsFusableDequantize(Graph& graph, const Node* node) {
+  return node != nullptr && IsPerTensorUInt8(*node, "DequantizeLinear") &&
+         node->GetOutputEdgesCount() == 1 && !graph.IsNodeOutputsInGraphOutputs(*node);
+}
+
+bool IsFusableOp(const Node& node) {
+  if (utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", 1) ||
+      utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", 9)) {
+    return true;
+  }
+  // a float bias can't be folded into the int32 accumulators without its scale, so only Conv without bias is fused
+  return utils::IsSupportedOptypeVersionAndDomain(node, "Conv", 1) &&
+         (node.InputDefs().size() < 3 || !node.InputDefs()[2]->Exists());
+}
+
+void HandleQuantizeNodeEdges(Graph& g, const Node& quantize, Node& fused_node) {
+  Node::EdgeSet output_edges;
+  for (auto it = quantize.OutputEdgesBegin(); it != quantize.OutputEdgesEnd(); ++it) {
+    output_edges.insert(*it);
+  }
+
+  //remove output edges of QuantizeLinear
+  //connect the fused node and nodes after QuantizeLinear
+  for (auto& output_edge : output_edges) {
+    NodeIndex dst_node_index = output_edge.GetNode().Index();
+    int src_arg_index = output_edge.GetSrcArgIndex();
+    int dst_arg_index = output_edge.GetDstArgIndex();
+    g.RemoveEdge(quantize.Index(), dst_node_index, src_arg_index, dst_arg_index);
+    g.AddEdge(fused_node.Index(), dst_node_index, 0, dst_arg_index);
+  }
+}
+
+}  // namespace
+
+Status QDQFusion::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::deque<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : order) {
+    auto node = graph.GetNode(index);
+    if (!IsFusableOp(*node) || node->GetOutputEdgesCount() != 1 || graph.IsNodeOutputsInGraphOutputs(*node)) {
+      continue;
+    }
+
+    Node* dequantize_a = GetInputNode(graph, *node, 0);
+    Node* dequantize_b = GetInputNode(graph, *node, 1);
+    if (dequantize_a == dequantize_b || !IsFusableDequantize(graph, dequantize_a) ||
+        !IsFusableDequantize(graph, dequantize_b)) {
+      continue;
+    }
+
+    Node* quantize = graph.GetNode(node->OutputNodesBegin()->Index());
+    if (!IsPerTensorUInt8(*quantize, "QuantizeLinear")) {
+      continue;
+    }
+
+    // QLinearMatMul/QLinearConv inputs are (a, a_scale, a_zero_point, b, b_scale, b_zero_point, y_scale, y_zero_point)
+    std::vector<NodeArg*> fused_inputs;
+    for (auto* dequantize : {dequantize_a, dequantize_b}) {
+      const auto& dequantize_inputs = dequantize->MutableInputDefs();
+      fused_inputs.insert(fused_inputs.end(), dequantize_inputs.begin(), dequantize_inputs.end());
+    }
+    fused_inputs.push_back(quantize->MutableInputDefs()[1]);
+    fused_inputs.push_back(quantize->MutableInputDefs()[2]);
+
+    const bool is_conv = node->OpType() == "Conv";
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("fused " + node->Name()),
+                                     is_conv ? "QLinearConv" : "QLinearMatMul",
+                                     "fused " + node->OpType() + " " + node->Name() + " with DequantizeLinear and QuantizeLinear",
+                                     fused_inputs,
+                                     quantize->MutableOutputDefs(),
+                                     is_conv ? &node->GetAttributes() : nullptr,
+                                     kMSDomain);
+
+    HandleQuantizeNodeEdges(graph, *quantize, fused_node);
+
+    // remove consumers before producers, as removing a node also removes its input edges
+    removed_nodes.push_back(quantize->Index());
+    removed_nodes.push_back(node->Index());
+    removed_nodes.push_back(dequantize_a->Index());
+    removed_nodes.push_back(dequantize_b->Index());
+  }
+
+  for (auto node : removed_nodes) {
+    graph.RemoveNode(node);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ORT_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class QDQFusion
+Fuses DequantizeLinear -> MatMul/Conv -> QuantizeLinear into QLinearMatMul/QLinearConv, which run the integer
+GEMM on the quantized inputs and requantize the 32-bit accumulators directly to the output scale and zero point.
+Only per-tensor uint8 quantization is fused.
+*/
+class QDQFusion : public onnxruntime::GraphTransformer {
+ public:
+  QDQFusion() noexcept : onnxruntime::GraphTransformer("QDQFusion", "Fusing DequantizeLinear and QuantizeLinear around MatMul and Conv") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
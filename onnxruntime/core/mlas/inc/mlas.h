@@ -65,6 +65,107 @@ MlasSgemm(
     size_t ldc
     );
 
+//
+// Quantized integer matrix/matrix multiply routines.
+//
+// Matrix A is always unsigned 8-bit. Matrix B is unsigned 8-bit or signed
+// 8-bit as selected by BIsSigned, in which case offb is interpreted as a
+// signed 8-bit value. The zero point offsets are subtracted from the inputs
+// before multiplying, so C = (A - offa) * (B - offb).
+//
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    bool BIsSigned,
+    int32_t* C,
+    size_t ldc
+    );
+
+size_t
+MLASCALL
+MlasQgemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasQgemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    bool BIsSigned,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasQgemmPacked(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const void* PackedB,
+    int32_t* C,
+    size_t ldc
+    );
+
+//
+// Linear quantization routines.
+//
+// The quantization routines are implemented for uint8_t and int8_t. Halfway
+// cases are rounded away from zero.
+//
+
+template<typename OutputType>
+void
+MLASCALL
+MlasQuantizeLinear(
+    const float* Input,
+    OutputType* Output,
+    size_t N,
+    float Scale,
+    OutputType ZeroPoint
+    );
+
+template<typename InputType>
+void
+MLASCALL
+MlasDequantizeLinear(
+    const InputType* Input,
+    float* Output,
+    size_t N,
+    float Scale,
+    InputType ZeroPoint
+    );
+
+void
+MLASCALL
+MlasRequantizeOutput(
+    const int32_t* Input,
+    uint8_t* Output,
+    const int32_t* Bias,
+    size_t M,
+    size_t N,
+    const float* Scale,
+    bool PerRowScale,
+    uint8_t ZeroPoint
+    );
+
 //
 // Convolution routines.
 //
@@ -120,6 +221,14 @@ MlasConvPrepare(
     size_t* WorkingBufferSize
     );
 
+bool
+MLASCALL
+MlasConvSetAlgorithm(
+    MLAS_CONV_PARAMETERS* Parameters,
+    MLAS_CONV_ALGORITHM Algorithm,
+    size_t* WorkingBufferSize
+    );
+
 void
 MLASCALL
 MlasConv(
@@ -131,9 +240,77 @@ MlasConv(
     float* Output
     );
 
+//
+// Transposed convolution routines.
+//
+// The filter tensor has the layout [GroupCount * InputChannels, FilterCount,
+// KernelShape] of the ONNX ConvTranspose operator.
+//
+
+enum MLAS_CONV_TRANSPOSE_ALGORITHM {
+    MlasConvTransposeAlgorithmGemmThenCol2Im,
+    MlasConvTransposeAlgorithmDirectStride2,
+};
+
+struct MLAS_CONV_TRANSPOSE_PARAMETERS {
+    size_t BatchCount;
+    size_t GroupCount;
+    size_t InputChannels;
+    size_t InputShape[2];
+    size_t KernelShape[2];
+    size_t DilationShape[2];
+    size_t Padding[4];
+    size_t StrideShape[2];
+    size_t FilterCount;
+    size_t OutputShape[2];
+    size_t InputSize;
+    size_t OutputSize;
+    size_t K;
+    MLAS_CONV_TRANSPOSE_ALGORITHM Algorithm;
+};
+
+void
+MLASCALL
+MlasConvTransposePrepare(
+    MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t FilterCount,
+    size_t* WorkingBufferSize
+    );
+
+bool
+MLASCALL
+MlasConvTransposeSetAlgorithm(
+    MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    MLAS_CONV_TRANSPOSE_ALGORITHM Algorithm,
+    size_t* WorkingBufferSize
+    );
+
+void
+MLASCALL
+MlasConvTranspose(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    );
+
 //
 // Pooling routines.
 //
+// The batch and channel planes are processed on the calling thread, so callers
+// parallelize by invoking MlasPool for disjoint ranges of the planes.
+//
 
 enum MLAS_POOLING_KIND {
     MlasMaximumPooling,
@@ -189,11 +366,61 @@ MlasComputeTanh(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeLog(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeErf(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+float
+MLASCALL
+MlasReduceMaximum(
+    const float* Input,
+    size_t N
+    );
+
+//
+// Softmax routine.
+//
+// Computes the softmax or log softmax along each of the N rows of D elements.
+// The rows are partitioned across threads.
+//
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax
+    );
+
+//
+// Half precision and bfloat16 floating-point routines.
 //
-// Half-precision floating-point routines.
+// The values are passed as their raw 16-bit encodings. Conversions to the
+// 16-bit formats round to nearest even.
 //
 
-extern "C"
 void
 MLASCALL
 MlasConvertHalfToFloatBuffer(
@@ -201,3 +428,27 @@ MlasConvertHalfToFloatBuffer(
     float* Destination,
     size_t Count
     );
+
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
@@ -0,0 +1,1076 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute.cpp
+
+Abstract:
+
+    This module implements routines to compute the exponential, natural
+    logarithm and error functions and the softmax of a set of rows.
+
+    The exponential function reduces the input by the nearest multiple of
+    ln(2) and evaluates a polynomial over the remainder before scaling by the
+    power of two. The implementation below targets the base instruction set
+    (typically SSE2) while the kernels that are used by the softmax routine
+    are also implemented for newer instruction sets (such as FMA3).
+
+--*/
+
+#include "mlasi.h"
+#include <cmath>
+
+//
+// Bundles the constants for the exponential function. The kernels compiled
+// for other instruction sets share these constants.
+//
+
+extern "C" const MLAS_EXP_CONSTANTS MlasExpConstants = {
+    -103.9720840454f,
+    88.7762626647950f,
+    -88.3762626647949f,
+    12582912.0f,
+    1.44269504088896341f,
+    -6.93145752e-1f,
+    -1.42860677e-6f,
+    1.378059387e-03f,
+    8.373124525e-03f,
+    4.166953638e-02f,
+    1.666647196e-01f,
+    4.999998510e-01f,
+    1.0f,
+    int32_t(0xC1000000),
+    int32_t(0x3F800000),
+};
+
+//
+// Bundles the constants for the natural logarithm function. The polynomial
+// coefficients are the same as found in the Cephes library.
+//
+
+const struct {
+    float MinimumNormal;
+    float DenormalScale;
+    float DenormalExponent;
+    float SqrtHalf;
+    float poly_0;
+    float poly_1;
+    float poly_2;
+    float poly_3;
+    float poly_4;
+    float poly_5;
+    float poly_6;
+    float poly_7;
+    float poly_8;
+    float Log2Low;
+    float Log2High;
+    int32_t MantissaMask;
+    int32_t OneHalf;
+} MlasLogConstants = {
+    1.17549435e-38f,
+    8388608.0f,
+    23.0f,
+    0.707106781186547524f,
+    7.0376836292e-2f,
+    -1.1514610310e-1f,
+    1.1676998740e-1f,
+    -1.2420140846e-1f,
+    1.4249322787e-1f,
+    -1.6668057665e-1f,
+    2.0000714765e-1f,
+    -2.4999993993e-1f,
+    3.3333331174e-1f,
+    -2.12194440e-4f,
+    0.693359375f,
+    int32_t(0x007FFFFF),
+    int32_t(0x3F000000),
+};
+
+//
+// Bundles the constants for the error function. For small inputs, the error
+// function is approximated by x*P(x^2). For the remaining inputs, the error
+// function is approximated by 1-exp(Q(x)). The inputs are clamped to the
+// range where the error function rounds to one.
+//
+
+const struct {
+    float UpperAbsRange;
+    float SplitBoundary;
+    float small_poly_0;
+    float small_poly_1;
+    float small_poly_2;
+    float small_poly_3;
+    float small_poly_4;
+    float small_poly_5;
+    float big_poly_0;
+    float big_poly_1;
+    float big_poly_2;
+    float big_poly_3;
+    float big_poly_4;
+    float big_poly_5;
+    float big_poly_6;
+    float big_poly_7;
+} MlasErfConstants = {
+    3.925f,
+    0.921875f,
+    -5.986210890e-04f,
+    4.992183298e-03f,
+    -2.676586434e-02f,
+    1.128179282e-01f,
+    -3.761249185e-01f,
+    1.128379107e+00f,
+    -1.428355972e-05f,
+    3.343865683e-04f,
+    -3.557968652e-03f,
+    2.309268527e-02f,
+    -1.043828651e-01f,
+    -6.376981735e-01f,
+    -1.126906872e+00f,
+    -4.721175937e-04f,
+};
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasComputeExpVector(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for a vector of elements.
+
+Arguments:
+
+    Vector - Supplies the values to operate on.
+
+Return Value:
+
+    Returns the exponential of the supplied values.
+
+--*/
+{
+    Vector = MlasMaximumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.LowerRange), Vector);
+    Vector = MlasMinimumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.UpperRange), Vector);
+
+    //
+    // Range reduce the input by computing x = n*ln(2) + r where n is the
+    // nearest integer to x/ln(2). The integer is available in the low bits of
+    // the biased value.
+    //
+
+    const MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasExpConstants.RoundingBias);
+    const MLAS_FLOAT32X4 Biased = MlasMultiplyAddFloat32x4(Vector,
+        MlasBroadcastFloat32x4(MlasExpConstants.Log2Reciprocal), RoundingBias);
+    const MLAS_FLOAT32X4 m = MlasSubtractFloat32x4(Biased, RoundingBias);
+
+    Vector = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2High), Vector);
+    Vector = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2Low), Vector);
+
+    //
+    // Split the power of two into a normal exponent and an overflow exponent
+    // so that results in the denormal range are rounded only once.
+    //
+
+    const MLAS_INT32X4 MaximumExponent = MlasBroadcastInt32x4(MlasExpConstants.MaximumExponent);
+
+    MLAS_INT32X4 Overflow = MlasShiftLeftInt32x4<23>(MlasReinterpretAsInt32x4(Biased));
+    MLAS_INT32X4 Normal = MlasMinimumInt32x4(Overflow, MaximumExponent);
+    Normal = MlasMaximumInt32x4(Normal, MlasBroadcastInt32x4(MlasExpConstants.MinimumExponent));
+    Overflow = MlasSubtractInt32x4(Overflow, Normal);
+    Overflow = MlasAddInt32x4(Overflow, MaximumExponent);
+    Normal = MlasAddInt32x4(Normal, MaximumExponent);
+
+    MLAS_FLOAT32X4 p = MlasBroadcastFloat32x4(MlasExpConstants.poly_0);
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_1));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_2));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_3));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_4));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+
+    p = MlasMultiplyFloat32x4(p, MlasReinterpretAsFloat32x4(Overflow));
+    p = MlasMultiplyFloat32x4(p, MlasReinterpretAsFloat32x4(Normal));
+
+    return p;
+}
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasComputeSumExpVector(
+    MLAS_FLOAT32X4 Vector,
+    MLAS_FLOAT32X4 NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for a vector of elements
+    that are offset by the negative of the maximum element of the row, so the
+    exponent is never positive and results in the denormal range are flushed
+    to zero.
+
+Arguments:
+
+    Vector - Supplies the values to operate on.
+
+    NegativeMaximum - Supplies the negative of the maximum element.
+
+Return Value:
+
+    Returns the exponential of the offset values.
+
+--*/
+{
+    Vector = MlasAddFloat32x4(Vector, NegativeMaximum);
+    Vector = MlasMaximumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.LowerRangeSumExp), Vector);
+
+    const MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasExpConstants.RoundingBias);
+    const MLAS_FLOAT32X4 Biased = MlasMultiplyAddFloat32x4(Vector,
+        MlasBroadcastFloat32x4(MlasExpConstants.Log2Reciprocal), RoundingBias);
+    const MLAS_FLOAT32X4 m = MlasSubtractFloat32x4(Biased, RoundingBias);
+
+    Vector = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2High), Vector);
+    Vector = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2Low), Vector);
+
+    MLAS_INT32X4 Normal = MlasShiftLeftInt32x4<23>(MlasReinterpretAsInt32x4(Biased));
+    Normal = MlasAddInt32x4(Normal, MlasBroadcastInt32x4(MlasExpConstants.MaximumExponent));
+
+    MLAS_FLOAT32X4 p = MlasBroadcastFloat32x4(MlasExpConstants.poly_0);
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_1));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_2));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_3));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_4));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+
+    return MlasMultiplyFloat32x4(p, MlasReinterpretAsFloat32x4(Normal));
+}
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasComputeLogVector(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the natural logarithm function for a vector of
+    elements.
+
+Arguments:
+
+    Vector - Supplies the values to operate on.
+
+Return Value:
+
+    Returns the natural logarithm of the supplied values.
+
+--*/
+{
+    const MLAS_FLOAT32X4 One = MlasBroadcastFloat32x4(1.0f);
+
+    //
+    // Scale denormal inputs into the normal range.
+    //
+
+    MLAS_FLOAT32X4 DenormalMask = MlasLessThanFloat32x4(Vector,
+        MlasBroadcastFloat32x4(MlasLogConstants.MinimumNormal));
+    MLAS_FLOAT32X4 Value = MlasBlendFloat32x4(Vector,
+        MlasMultiplyFloat32x4(Vector, MlasBroadcastFloat32x4(MlasLogConstants.DenormalScale)), DenormalMask);
+
+    //
+    // Split the value into an exponent and a mantissa in the range
+    // [sqrt(0.5), sqrt(2)) offset by one.
+    //
+
+    MLAS_INT32X4 Bits = MlasReinterpretAsInt32x4(Value);
+
+    MLAS_FLOAT32X4 e = MlasCastToFloat32x4(MlasSubtractInt32x4(MlasShiftRightInt32x4<23>(Bits),
+        MlasBroadcastInt32x4(126)));
+    e = MlasSubtractFloat32x4(e, MlasAndFloat32x4(DenormalMask,
+        MlasBroadcastFloat32x4(MlasLogConstants.DenormalExponent)));
+
+    MLAS_FLOAT32X4 x = MlasAndFloat32x4(Value,
+        MlasReinterpretAsFloat32x4(MlasBroadcastInt32x4(MlasLogConstants.MantissaMask)));
+    x = MlasOrFloat32x4(x, MlasReinterpretAsFloat32x4(MlasBroadcastInt32x4(MlasLogConstants.OneHalf)));
+
+    MLAS_FLOAT32X4 SmallMask = MlasLessThanFloat32x4(x, MlasBroadcastFloat32x4(MlasLogConstants.SqrtHalf));
+    e = MlasSubtractFloat32x4(e, MlasAndFloat32x4(SmallMask, One));
+    x = MlasAddFloat32x4(MlasSubtractFloat32x4(x, One), MlasAndFloat32x4(SmallMask, x));
+
+    MLAS_FLOAT32X4 z = MlasMultiplyFloat32x4(x, x);
+
+    MLAS_FLOAT32X4 y = MlasBroadcastFloat32x4(MlasLogConstants.poly_0);
+    y = MlasMultiplyAddFloat32x4(y, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_1));
+    y = MlasMultiplyAddFloat32x4(y, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_2));
+    y = MlasMultiplyAddFloat32x4(y, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_3));
+    y = MlasMultiplyAddFloat32x4(y, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_4));
+    y = MlasMultiplyAddFloat32x4(y, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_5));
+    y = MlasMultiplyAddFloat32x4(y, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_6));
+    y = MlasMultiplyAddFloat32x4(y, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_7));
+    y = MlasMultiplyAddFloat32x4(y, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_8));
+    y = MlasMultiplyFloat32x4(MlasMultiplyFloat32x4(y, x), z);
+
+    y = MlasMultiplyAddFloat32x4(e, MlasBroadcastFloat32x4(MlasLogConstants.Log2Low), y);
+    y = MlasMultiplyAddFloat32x4(z, MlasBroadcastFloat32x4(-0.5f), y);
+    x = MlasAddFloat32x4(x, y);
+    x = MlasMultiplyAddFloat32x4(e, MlasBroadcastFloat32x4(MlasLogConstants.Log2High), x);
+
+    //
+    // Fix up the special cases: zero maps to negative infinity, negative
+    // values map to NaN, and infinity and NaN are passed through.
+    //
+
+    const MLAS_FLOAT32X4 Zero = MlasZeroFloat32x4();
+    const MLAS_FLOAT32X4 Infinity = MlasBroadcastFloat32x4(std::numeric_limits<float>::infinity());
+
+    x = MlasBlendFloat32x4(x, MlasSubtractFloat32x4(Zero, Infinity), MlasEqualFloat32x4(Vector, Zero));
+    x = MlasBlendFloat32x4(x, MlasBroadcastFloat32x4(std::numeric_limits<float>::quiet_NaN()),
+        MlasLessThanFloat32x4(Vector, Zero));
+    x = MlasBlendFloat32x4(x, Vector, MlasEqualFloat32x4(Vector, Infinity));
+    x = MlasBlendFloat32x4(Vector, x, MlasEqualFloat32x4(Vector, Vector));
+
+    return x;
+}
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasComputeErfVector(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the error function for a vector of elements.
+
+Arguments:
+
+    Vector - Supplies the values to operate on.
+
+Return Value:
+
+    Returns the error function of the supplied values.
+
+--*/
+{
+    const MLAS_FLOAT32X4 SignMask = MlasBroadcastFloat32x4(-0.0f);
+
+    MLAS_FLOAT32X4 SignValue = MlasAndFloat32x4(Vector, SignMask);
+    MLAS_FLOAT32X4 AbsValue = MlasAndNotFloat32x4(SignMask, Vector);
+    AbsValue = MlasMinimumFloat32x4(MlasBroadcastFloat32x4(MlasErfConstants.UpperAbsRange), AbsValue);
+
+    MLAS_FLOAT32X4 SquareValue = MlasMultiplyFloat32x4(AbsValue, AbsValue);
+
+    MLAS_FLOAT32X4 r_small = MlasBroadcastFloat32x4(MlasErfConstants.small_poly_0);
+    r_small = MlasMultiplyAddFloat32x4(r_small, SquareValue, MlasBroadcastFloat32x4(MlasErfConstants.small_poly_1));
+    r_small = MlasMultiplyAddFloat32x4(r_small, SquareValue, MlasBroadcastFloat32x4(MlasErfConstants.small_poly_2));
+    r_small = MlasMultiplyAddFloat32x4(r_small, SquareValue, MlasBroadcastFloat32x4(MlasErfConstants.small_poly_3));
+    r_small = MlasMultiplyAddFloat32x4(r_small, SquareValue, MlasBroadcastFloat32x4(MlasErfConstants.small_poly_4));
+    r_small = MlasMultiplyAddFloat32x4(r_small, SquareValue, MlasBroadcastFloat32x4(MlasErfConstants.small_poly_5));
+    r_small = MlasMultiplyFloat32x4(r_small, AbsValue);
+
+    MLAS_FLOAT32X4 r_big = MlasBroadcastFloat32x4(MlasErfConstants.big_poly_0);
+    r_big = MlasMultiplyAddFloat32x4(r_big, AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.big_poly_1));
+    r_big = MlasMultiplyAddFloat32x4(r_big, AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.big_poly_2));
+    r_big = MlasMultiplyAddFloat32x4(r_big, AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.big_poly_3));
+    r_big = MlasMultiplyAddFloat32x4(r_big, AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.big_poly_4));
+    r_big = MlasMultiplyAddFloat32x4(r_big, AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.big_poly_5));
+    r_big = MlasMultiplyAddFloat32x4(r_big, AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.big_poly_6));
+    r_big = MlasMultiplyAddFloat32x4(r_big, AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.big_poly_7));
+    r_big = MlasSubtractFloat32x4(MlasBroadcastFloat32x4(1.0f), MlasComputeExpVector(r_big));
+
+    MLAS_FLOAT32X4 SmallMask = MlasLessThanFloat32x4(AbsValue,
+        MlasBroadcastFloat32x4(MlasErfConstants.SplitBoundary));
+
+    return MlasOrFloat32x4(MlasBlendFloat32x4(r_big, r_small, SmallMask), SignValue);
+}
+
+//
+// Applies a vector routine to a buffer. The remaining elements are staged
+// through a local buffer so that all elements use the same vector routine.
+//
+
+template<MLAS_FLOAT32X4 (*VectorRoutine)(MLAS_FLOAT32X4)>
+MLAS_FORCEINLINE
+void
+MlasComputeUnaryVectorKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, VectorRoutine(MlasLoadFloat32x4(Input)));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    if (N > 0) {
+
+        float Buffer[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+        for (size_t n = 0; n < N; n++) {
+            Buffer[n] = Input[n];
+        }
+
+        MlasStoreFloat32x4(Buffer, VectorRoutine(MlasLoadFloat32x4(Buffer)));
+
+        for (size_t n = 0; n < N; n++) {
+            Output[n] = Buffer[n];
+        }
+    }
+}
+
+void
+MLASCALL
+MlasComputeExpKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasComputeUnaryVectorKernel<MlasComputeExpVector>(Input, Output, N);
+}
+
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ComputeExpKernelRoutine(Input, Output, N);
+#else
+    MlasComputeExpKernel(Input, Output, N);
+#endif
+}
+
+void
+MLASCALL
+MlasComputeLog(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the natural logarithm function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasComputeUnaryVectorKernel<MlasComputeLogVector>(Input, Output, N);
+}
+
+void
+MLASCALL
+MlasComputeErf(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the error function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasComputeUnaryVectorKernel<MlasComputeErfVector>(Input, Output, N);
+}
+
+float
+MLASCALL
+MlasComputeSumExpKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to compute the exponential of
+    the elements of a row offset by the negative of the maximum element and
+    to accumulate the sum of the results.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Optionally supplies the output buffer to receive the exponential
+        values.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the negative of the maximum element of the
+        input buffer.
+
+Return Value:
+
+    Returns the sum of the exponential values.
+
+--*/
+{
+    const MLAS_FLOAT32X4 NegativeMaximumVector = MlasBroadcastFloat32x4(NegativeMaximum);
+
+    MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+
+    while (N >= 8) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasComputeSumExpVector(MlasLoadFloat32x4(Input), NegativeMaximumVector);
+        MLAS_FLOAT32X4 Vector1 = MlasComputeSumExpVector(MlasLoadFloat32x4(Input + 4), NegativeMaximumVector);
+
+        Accumulator0 = MlasAddFloat32x4(Accumulator0, Vector0);
+        Accumulator1 = MlasAddFloat32x4(Accumulator1, Vector1);
+
+        if (Output != nullptr) {
+            MlasStoreFloat32x4(Output, Vector0);
+            MlasStoreFloat32x4(Output + 4, Vector1);
+            Output += 8;
+        }
+
+        Input += 8;
+        N -= 8;
+    }
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasComputeSumExpVector(MlasLoadFloat32x4(Input), NegativeMaximumVector);
+
+        Accumulator0 = MlasAddFloat32x4(Accumulator0, Vector0);
+
+        if (Output != nullptr) {
+            MlasStoreFloat32x4(Output, Vector0);
+            Output += 4;
+        }
+
+        Input += 4;
+        N -= 4;
+    }
+
+    float Accumulation = MlasReduceAddFloat32x4(MlasAddFloat32x4(Accumulator0, Accumulator1));
+
+    if (N > 0) {
+
+        float Buffer[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+        for (size_t n = 0; n < N; n++) {
+            Buffer[n] = Input[n];
+        }
+
+        MlasStoreFloat32x4(Buffer, MlasComputeSumExpVector(MlasLoadFloat32x4(Buffer), NegativeMaximumVector));
+
+        for (size_t n = 0; n < N; n++) {
+
+            Accumulation += Buffer[n];
+
+            if (Output != nullptr) {
+                Output[n] = Buffer[n];
+            }
+        }
+    }
+
+    return Accumulation;
+}
+
+float
+MLASCALL
+MlasReduceMaximumKernel(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to find the maximum element of
+    a buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum element.
+
+--*/
+{
+    float Maximum = std::numeric_limits<float>::lowest();
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 MaximumVector0 = MlasBroadcastFloat32x4(Maximum);
+
+        if (N >= 16) {
+
+            MLAS_FLOAT32X4 MaximumVector1 = MaximumVector0;
+            MLAS_FLOAT32X4 MaximumVector2 = MaximumVector0;
+            MLAS_FLOAT32X4 MaximumVector3 = MaximumVector0;
+
+            while (N >= 16) {
+
+                MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MlasLoadFloat32x4(Input));
+                MaximumVector1 = MlasMaximumFloat32x4(MaximumVector1, MlasLoadFloat32x4(Input + 4));
+                MaximumVector2 = MlasMaximumFloat32x4(MaximumVector2, MlasLoadFloat32x4(Input + 8));
+                MaximumVector3 = MlasMaximumFloat32x4(MaximumVector3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                N -= 16;
+            }
+
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MaximumVector1);
+            MaximumVector2 = MlasMaximumFloat32x4(MaximumVector2, MaximumVector3);
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MaximumVector2);
+        }
+
+        while (N >= 4) {
+
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Maximum = MlasReduceMaximumFloat32x4(MaximumVector0);
+    }
+
+    while (N > 0) {
+
+        Maximum = (std::max)(Maximum, *Input);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Maximum;
+}
+
+float
+MLASCALL
+MlasReduceMaximum(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine finds the maximum element of a buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum element or the lowest float value if the buffer is
+    empty.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    return MlasPlatform.ReduceMaximumKernelRoutine(Input, N);
+#else
+    return MlasReduceMaximumKernel(Input, N);
+#endif
+}
+
+void
+MlasComputeSoftmaxOutputKernel(
+    float* Output,
+    size_t N,
+    float Scale
+    )
+/*++
+
+Routine Description:
+
+    This routine scales the exponential values of a row by the reciprocal of
+    their sum to produce the softmax output.
+
+Arguments:
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Scale - Supplies the reciprocal of the sum of the exponential values.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+    while (N >= 16) {
+
+        MlasStoreFloat32x4(Output, MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output)));
+        MlasStoreFloat32x4(Output + 4, MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 4)));
+        MlasStoreFloat32x4(Output + 8, MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 8)));
+        MlasStoreFloat32x4(Output + 12, MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 12)));
+
+        Output += 16;
+        N -= 16;
+    }
+
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output)));
+
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output *= Scale;
+
+        Output += 1;
+        N -= 1;
+    }
+}
+
+void
+MlasComputeLogSoftmaxOutputKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine offsets the elements of a row by the negative of the maximum
+    element and the logarithm of the sum of the exponential values to produce
+    the log softmax output.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Bias - Supplies the negative of the maximum element minus the logarithm
+        of the sum of the exponential values.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 BiasVector = MlasBroadcastFloat32x4(Bias);
+
+    while (N >= 16) {
+
+        MlasStoreFloat32x4(Output, MlasAddFloat32x4(BiasVector, MlasLoadFloat32x4(Input)));
+        MlasStoreFloat32x4(Output + 4, MlasAddFloat32x4(BiasVector, MlasLoadFloat32x4(Input + 4)));
+        MlasStoreFloat32x4(Output + 8, MlasAddFloat32x4(BiasVector, MlasLoadFloat32x4(Input + 8)));
+        MlasStoreFloat32x4(Output + 12, MlasAddFloat32x4(BiasVector, MlasLoadFloat32x4(Input + 12)));
+
+        Input += 16;
+        Output += 16;
+        N -= 16;
+    }
+
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasAddFloat32x4(BiasVector, MlasLoadFloat32x4(Input)));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output = *Input + Bias;
+
+        Input += 1;
+        Output += 1;
+        N -= 1;
+    }
+}
+
+//
+// Define the parameters to execute segments of a softmax operation on worker
+// threads.
+//
+
+struct MLAS_SOFTMAX_WORK_BLOCK {
+    int32_t ThreadCountN;
+    bool LogSoftmax;
+    const float* Input;
+    float* Output;
+    size_t N;
+    size_t D;
+};
+
+void
+MlasComputeSoftmaxThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    softmax or log softmax operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_SOFTMAX_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    const size_t N = WorkBlock->N;
+    const size_t D = WorkBlock->D;
+    const size_t ThreadCountN = size_t(WorkBlock->ThreadCountN);
+
+    const size_t WorkPerThread = N / ThreadCountN;
+    const size_t WorkPerThreadExtra = N % ThreadCountN;
+
+    size_t n;
+    size_t CountN;
+
+    if (size_t(Index) < WorkPerThreadExtra) {
+        n = (WorkPerThread + 1) * size_t(Index);
+        CountN = WorkPerThread + 1;
+    } else {
+        n = WorkPerThread * size_t(Index) + WorkPerThreadExtra;
+        CountN = WorkPerThread;
+    }
+
+    const float* Input = WorkBlock->Input + n * D;
+    float* Output = WorkBlock->Output + n * D;
+
+    while (CountN > 0) {
+
+#if defined(MLAS_TARGET_AMD64)
+        float Maximum = MlasPlatform.ReduceMaximumKernelRoutine(Input, D);
+#else
+        float Maximum = MlasReduceMaximumKernel(Input, D);
+#endif
+        float NegativeMaximum = -Maximum;
+
+        if (WorkBlock->LogSoftmax) {
+
+            //
+            // Compute the sum of the exponential values without storing the
+            // intermediate results.
+            //
+
+#if defined(MLAS_TARGET_AMD64)
+            float Accumulation = MlasPlatform.ComputeSumExpKernelRoutine(Input, nullptr, D, NegativeMaximum);
+#else
+            float Accumulation = MlasComputeSumExpKernel(Input, nullptr, D, NegativeMaximum);
+#endif
+
+            MlasComputeLogSoftmaxOutputKernel(Input, Output, D, NegativeMaximum - std::log(Accumulation));
+
+        } else {
+
+            //
+            // Store the exponential values to the output buffer and then
+            // scale by the reciprocal of their sum.
+            //
+
+#if defined(MLAS_TARGET_AMD64)
+            float Accumulation = MlasPlatform.ComputeSumExpKernelRoutine(Input, Output, D, NegativeMaximum);
+#else
+            float Accumulation = MlasComputeSumExpKernel(Input, Output, D, NegativeMaximum);
+#endif
+
+            MlasComputeSoftmaxOutputKernel(Output, D, 1.0f / Accumulation);
+        }
+
+        Input += D;
+        Output += D;
+        CountN--;
+    }
+}
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function along each row
+    of the input matrix.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SOFTMAX_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the softmax parameters to the work block.
+    //
+
+    WorkBlock.LogSoftmax = LogSoftmax;
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+
+    //
+    // Compute the number of target threads given the complexity of the softmax
+    // operation. Limit the number of threads to the number of rows and try to
+    // keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    const double Complexity = double(N) * double(D);
+
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SOFTMAX_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SOFTMAX_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > N) {
+        TargetThreadCount = int32_t(N);
+    }
+
+    if (TargetThreadCount == 0) {
+        return;
+    }
+
+    WorkBlock.ThreadCountN = TargetThreadCount;
+
+    MlasExecuteThreaded(MlasComputeSoftmaxThreaded, &WorkBlock, TargetThreadCount);
+}
@@ -0,0 +1,100 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute_kernel_avx.cpp
+
+Abstract:
+
+    This module implements the kernel to find the maximum element of a row
+    used by the softmax routine.
+
+    This implementation uses AVX instructions.
+
+--*/
+
+#include "mlasi.h"
+
+float
+MLASCALL
+MlasReduceMaximumKernelAvx(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the vectorized kernel to find the maximum element
+    of a buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum element.
+
+--*/
+{
+    float Maximum = std::numeric_limits<float>::lowest();
+
+    if (N >= 8) {
+
+        __m256 MaximumVector0 = _mm256_set1_ps(Maximum);
+
+        if (N >= 32) {
+
+            __m256 MaximumVector1 = MaximumVector0;
+            __m256 MaximumVector2 = MaximumVector0;
+            __m256 MaximumVector3 = MaximumVector0;
+
+            while (N >= 32) {
+
+                MaximumVector0 = _mm256_max_ps(MaximumVector0, _mm256_loadu_ps(Input));
+                MaximumVector1 = _mm256_max_ps(MaximumVector1, _mm256_loadu_ps(Input + 8));
+                MaximumVector2 = _mm256_max_ps(MaximumVector2, _mm256_loadu_ps(Input + 16));
+                MaximumVector3 = _mm256_max_ps(MaximumVector3, _mm256_loadu_ps(Input + 24));
+
+                Input += 32;
+                N -= 32;
+            }
+
+            MaximumVector0 = _mm256_max_ps(MaximumVector0, MaximumVector1);
+            MaximumVector2 = _mm256_max_ps(MaximumVector2, MaximumVector3);
+            MaximumVector0 = _mm256_max_ps(MaximumVector0, MaximumVector2);
+        }
+
+        while (N >= 8) {
+
+            MaximumVector0 = _mm256_max_ps(MaximumVector0, _mm256_loadu_ps(Input));
+
+            Input += 8;
+            N -= 8;
+        }
+
+        __m128 MaximumVector = _mm_max_ps(_mm256_castps256_ps128(MaximumVector0),
+            _mm256_extractf128_ps(MaximumVector0, 1));
+        MaximumVector = _mm_max_ps(MaximumVector, _mm_movehl_ps(MaximumVector, MaximumVector));
+        MaximumVector = _mm_max_ss(MaximumVector, _mm_shuffle_ps(MaximumVector, MaximumVector, 1));
+
+        Maximum = _mm_cvtss_f32(MaximumVector);
+    }
+
+    while (N > 0) {
+
+        Maximum = (std::max)(Maximum, *Input);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Maximum;
+}
@@ -0,0 +1,292 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute_kernel_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernels for the exponential function, the sum
+    of exponential values and the maximum element of a row used by the
+    softmax routine.
+
+    This implementation uses AVX512F instructions.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+__m512
+MlasComputeExpVectorAvx512F(
+    __m512 Vector,
+    __m512 LowerRange
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for a vector of elements.
+
+Arguments:
+
+    Vector - Supplies the values to operate on.
+
+    LowerRange - Supplies the value to clamp the input to. If this is the
+        lower range for the sum of exponential values, then the result is
+        flushed to zero for the denormal range.
+
+Return Value:
+
+    Returns the exponential of the supplied values.
+
+--*/
+{
+    const __m512i MaximumExponent = _mm512_set1_epi32(MlasExpConstants.MaximumExponent);
+    const __m512 RoundingBias = _mm512_set1_ps(MlasExpConstants.RoundingBias);
+
+    Vector = _mm512_max_ps(LowerRange, Vector);
+    Vector = _mm512_min_ps(_mm512_set1_ps(MlasExpConstants.UpperRange), Vector);
+
+    __m512 Biased = _mm512_fmadd_ps(Vector, _mm512_set1_ps(MlasExpConstants.Log2Reciprocal), RoundingBias);
+    __m512 m = _mm512_sub_ps(Biased, RoundingBias);
+
+    Vector = _mm512_fmadd_ps(m, _mm512_set1_ps(MlasExpConstants.Log2High), Vector);
+    Vector = _mm512_fmadd_ps(m, _mm512_set1_ps(MlasExpConstants.Log2Low), Vector);
+
+    __m512i Overflow = _mm512_slli_epi32(_mm512_castps_si512(Biased), 23);
+    __m512i Normal = _mm512_min_epi32(Overflow, MaximumExponent);
+    Normal = _mm512_max_epi32(Normal, _mm512_set1_epi32(MlasExpConstants.MinimumExponent));
+    Overflow = _mm512_sub_epi32(Overflow, Normal);
+    Overflow = _mm512_add_epi32(Overflow, MaximumExponent);
+    Normal = _mm512_add_epi32(Normal, MaximumExponent);
+
+    __m512 p = _mm512_set1_ps(MlasExpConstants.poly_0);
+    p = _mm512_fmadd_ps(p, Vector, _mm512_set1_ps(MlasExpConstants.poly_1));
+    p = _mm512_fmadd_ps(p, Vector, _mm512_set1_ps(MlasExpConstants.poly_2));
+    p = _mm512_fmadd_ps(p, Vector, _mm512_set1_ps(MlasExpConstants.poly_3));
+    p = _mm512_fmadd_ps(p, Vector, _mm512_set1_ps(MlasExpConstants.poly_4));
+    p = _mm512_fmadd_ps(p, Vector, _mm512_set1_ps(MlasExpConstants.poly_56));
+    p = _mm512_fmadd_ps(p, Vector, _mm512_set1_ps(MlasExpConstants.poly_56));
+
+    p = _mm512_mul_ps(p, _mm512_castsi512_ps(Overflow));
+    p = _mm512_mul_ps(p, _mm512_castsi512_ps(Normal));
+
+    return p;
+}
+
+void
+MLASCALL
+MlasComputeExpKernelAvx512F(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the vectorized kernel for the exponential
+    function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const __m512 LowerRange = _mm512_set1_ps(MlasExpConstants.LowerRange);
+
+    while (N >= 16) {
+
+        _mm512_storeu_ps(Output, MlasComputeExpVectorAvx512F(_mm512_loadu_ps(Input), LowerRange));
+
+        Input += 16;
+        Output += 16;
+        N -= 16;
+    }
+
+    if (N > 0) {
+
+        const __mmask16 Mask = __mmask16((1u << N) - 1);
+
+        __m512 Vector = _mm512_maskz_loadu_ps(Mask, Input);
+
+        _mm512_mask_storeu_ps(Output, Mask, MlasComputeExpVectorAvx512F(Vector, LowerRange));
+    }
+}
+
+float
+MLASCALL
+MlasComputeSumExpKernelAvx512F(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the vectorized kernel to compute the exponential
+    of the elements of a row offset by the negative of the maximum element and
+    to accumulate the sum of the results.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Optionally supplies the output buffer to receive the exponential
+        values.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the negative of the maximum element of the
+        input buffer.
+
+Return Value:
+
+    Returns the sum of the exponential values.
+
+--*/
+{
+    const __m512 LowerRange = _mm512_set1_ps(MlasExpConstants.LowerRangeSumExp);
+    const __m512 NegativeMaximumVector = _mm512_set1_ps(NegativeMaximum);
+
+    __m512 Accumulator0 = _mm512_setzero_ps();
+    __m512 Accumulator1 = _mm512_setzero_ps();
+
+    while (N >= 32) {
+
+        __m512 Vector0 = _mm512_add_ps(_mm512_loadu_ps(Input), NegativeMaximumVector);
+        __m512 Vector1 = _mm512_add_ps(_mm512_loadu_ps(Input + 16), NegativeMaximumVector);
+
+        Vector0 = MlasComputeExpVectorAvx512F(Vector0, LowerRange);
+        Vector1 = MlasComputeExpVectorAvx512F(Vector1, LowerRange);
+
+        Accumulator0 = _mm512_add_ps(Accumulator0, Vector0);
+        Accumulator1 = _mm512_add_ps(Accumulator1, Vector1);
+
+        if (Output != nullptr) {
+            _mm512_storeu_ps(Output, Vector0);
+            _mm512_storeu_ps(Output + 16, Vector1);
+            Output += 32;
+        }
+
+        Input += 32;
+        N -= 32;
+    }
+
+    if (N >= 16) {
+
+        __m512 Vector0 = _mm512_add_ps(_mm512_loadu_ps(Input), NegativeMaximumVector);
+
+        Vector0 = MlasComputeExpVectorAvx512F(Vector0, LowerRange);
+
+        Accumulator0 = _mm512_add_ps(Accumulator0, Vector0);
+
+        if (Output != nullptr) {
+            _mm512_storeu_ps(Output, Vector0);
+            Output += 16;
+        }
+
+        Input += 16;
+        N -= 16;
+    }
+
+    if (N > 0) {
+
+        const __mmask16 Mask = __mmask16((1u << N) - 1);
+
+        __m512 Vector0 = _mm512_add_ps(_mm512_maskz_loadu_ps(Mask, Input), NegativeMaximumVector);
+
+        Vector0 = MlasComputeExpVectorAvx512F(Vector0, LowerRange);
+
+        Accumulator1 = _mm512_mask_add_ps(Accumulator1, Mask, Accumulator1, Vector0);
+
+        if (Output != nullptr) {
+            _mm512_mask_storeu_ps(Output, Mask, Vector0);
+        }
+    }
+
+    return _mm512_reduce_add_ps(_mm512_add_ps(Accumulator0, Accumulator1));
+}
+
+float
+MLASCALL
+MlasReduceMaximumKernelAvx512F(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the vectorized kernel to find the maximum element
+    of a buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum element.
+
+--*/
+{
+    __m512 MaximumVector0 = _mm512_set1_ps(std::numeric_limits<float>::lowest());
+
+    if (N >= 64) {
+
+        __m512 MaximumVector1 = MaximumVector0;
+        __m512 MaximumVector2 = MaximumVector0;
+        __m512 MaximumVector3 = MaximumVector0;
+
+        while (N >= 64) {
+
+            MaximumVector0 = _mm512_max_ps(MaximumVector0, _mm512_loadu_ps(Input));
+            MaximumVector1 = _mm512_max_ps(MaximumVector1, _mm512_loadu_ps(Input + 16));
+            MaximumVector2 = _mm512_max_ps(MaximumVector2, _mm512_loadu_ps(Input + 32));
+            MaximumVector3 = _mm512_max_ps(MaximumVector3, _mm512_loadu_ps(Input + 48));
+
+            Input += 64;
+            N -= 64;
+        }
+
+        MaximumVector0 = _mm512_max_ps(MaximumVector0, MaximumVector1);
+        MaximumVector2 = _mm512_max_ps(MaximumVector2, MaximumVector3);
+        MaximumVector0 = _mm512_max_ps(MaximumVector0, MaximumVector2);
+    }
+
+    while (N >= 16) {
+
+        MaximumVector0 = _mm512_max_ps(MaximumVector0, _mm512_loadu_ps(Input));
+
+        Input += 16;
+        N -= 16;
+    }
+
+    if (N > 0) {
+
+        const __mmask16 Mask = __mmask16((1u << N) - 1);
+
+        MaximumVector0 = _mm512_mask_max_ps(MaximumVector0, Mask, MaximumVector0, _mm512_maskz_loadu_ps(Mask, Input));
+    }
+
+    return _mm512_reduce_max_ps(MaximumVector0);
+}
@@ -0,0 +1,237 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute_kernel_fma3.cpp
+
+Abstract:
+
+    This module implements the kernels for the exponential function and the
+    sum of exponential values used by the softmax routine.
+
+    This implementation uses AVX2 and FMA3 instructions.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+__m256
+MlasComputeExpVectorFma3(
+    __m256 Vector,
+    __m256 LowerRange
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for a vector of elements.
+
+Arguments:
+
+    Vector - Supplies the values to operate on.
+
+    LowerRange - Supplies the value to clamp the input to. If this is the
+        lower range for the sum of exponential values, then the result is
+        flushed to zero for the denormal range.
+
+Return Value:
+
+    Returns the exponential of the supplied values.
+
+--*/
+{
+    const __m256i MaximumExponent = _mm256_set1_epi32(MlasExpConstants.MaximumExponent);
+    const __m256 RoundingBias = _mm256_set1_ps(MlasExpConstants.RoundingBias);
+
+    Vector = _mm256_max_ps(LowerRange, Vector);
+    Vector = _mm256_min_ps(_mm256_set1_ps(MlasExpConstants.UpperRange), Vector);
+
+    __m256 Biased = _mm256_fmadd_ps(Vector, _mm256_set1_ps(MlasExpConstants.Log2Reciprocal), RoundingBias);
+    __m256 m = _mm256_sub_ps(Biased, RoundingBias);
+
+    Vector = _mm256_fmadd_ps(m, _mm256_set1_ps(MlasExpConstants.Log2High), Vector);
+    Vector = _mm256_fmadd_ps(m, _mm256_set1_ps(MlasExpConstants.Log2Low), Vector);
+
+    __m256i Overflow = _mm256_slli_epi32(_mm256_castps_si256(Biased), 23);
+    __m256i Normal = _mm256_min_epi32(Overflow, MaximumExponent);
+    Normal = _mm256_max_epi32(Normal, _mm256_set1_epi32(MlasExpConstants.MinimumExponent));
+    Overflow = _mm256_sub_epi32(Overflow, Normal);
+    Overflow = _mm256_add_epi32(Overflow, MaximumExponent);
+    Normal = _mm256_add_epi32(Normal, MaximumExponent);
+
+    __m256 p = _mm256_set1_ps(MlasExpConstants.poly_0);
+    p = _mm256_fmadd_ps(p, Vector, _mm256_set1_ps(MlasExpConstants.poly_1));
+    p = _mm256_fmadd_ps(p, Vector, _mm256_set1_ps(MlasExpConstants.poly_2));
+    p = _mm256_fmadd_ps(p, Vector, _mm256_set1_ps(MlasExpConstants.poly_3));
+    p = _mm256_fmadd_ps(p, Vector, _mm256_set1_ps(MlasExpConstants.poly_4));
+    p = _mm256_fmadd_ps(p, Vector, _mm256_set1_ps(MlasExpConstants.poly_56));
+    p = _mm256_fmadd_ps(p, Vector, _mm256_set1_ps(MlasExpConstants.poly_56));
+
+    p = _mm256_mul_ps(p, _mm256_castsi256_ps(Overflow));
+    p = _mm256_mul_ps(p, _mm256_castsi256_ps(Normal));
+
+    return p;
+}
+
+void
+MLASCALL
+MlasComputeExpKernelFma3(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the vectorized kernel for the exponential
+    function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const __m256 LowerRange = _mm256_set1_ps(MlasExpConstants.LowerRange);
+
+    while (N >= 8) {
+
+        _mm256_storeu_ps(Output, MlasComputeExpVectorFma3(_mm256_loadu_ps(Input), LowerRange));
+
+        Input += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    if (N > 0) {
+
+        const __m256i Mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(int32_t(N)),
+            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+        __m256 Vector = _mm256_maskload_ps(Input, Mask);
+
+        _mm256_maskstore_ps(Output, Mask, MlasComputeExpVectorFma3(Vector, LowerRange));
+    }
+}
+
+float
+MLASCALL
+MlasComputeSumExpKernelFma3(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the vectorized kernel to compute the exponential
+    of the elements of a row offset by the negative of the maximum element and
+    to accumulate the sum of the results.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Optionally supplies the output buffer to receive the exponential
+        values.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the negative of the maximum element of the
+        input buffer.
+
+Return Value:
+
+    Returns the sum of the exponential values.
+
+--*/
+{
+    const __m256 LowerRange = _mm256_set1_ps(MlasExpConstants.LowerRangeSumExp);
+    const __m256 NegativeMaximumVector = _mm256_set1_ps(NegativeMaximum);
+
+    __m256 Accumulator0 = _mm256_setzero_ps();
+    __m256 Accumulator1 = _mm256_setzero_ps();
+
+    while (N >= 16) {
+
+        __m256 Vector0 = _mm256_add_ps(_mm256_loadu_ps(Input), NegativeMaximumVector);
+        __m256 Vector1 = _mm256_add_ps(_mm256_loadu_ps(Input + 8), NegativeMaximumVector);
+
+        Vector0 = MlasComputeExpVectorFma3(Vector0, LowerRange);
+        Vector1 = MlasComputeExpVectorFma3(Vector1, LowerRange);
+
+        Accumulator0 = _mm256_add_ps(Accumulator0, Vector0);
+        Accumulator1 = _mm256_add_ps(Accumulator1, Vector1);
+
+        if (Output != nullptr) {
+            _mm256_storeu_ps(Output, Vector0);
+            _mm256_storeu_ps(Output + 8, Vector1);
+            Output += 16;
+        }
+
+        Input += 16;
+        N -= 16;
+    }
+
+    while (N >= 8) {
+
+        __m256 Vector0 = _mm256_add_ps(_mm256_loadu_ps(Input), NegativeMaximumVector);
+
+        Vector0 = MlasComputeExpVectorFma3(Vector0, LowerRange);
+
+        Accumulator0 = _mm256_add_ps(Accumulator0, Vector0);
+
+        if (Output != nullptr) {
+            _mm256_storeu_ps(Output, Vector0);
+            Output += 8;
+        }
+
+        Input += 8;
+        N -= 8;
+    }
+
+    if (N > 0) {
+
+        const __m256i Mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(int32_t(N)),
+            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+        __m256 Vector0 = _mm256_add_ps(_mm256_maskload_ps(Input, Mask), NegativeMaximumVector);
+
+        Vector0 = MlasComputeExpVectorFma3(Vector0, LowerRange);
+        Vector0 = _mm256_and_ps(Vector0, _mm256_castsi256_ps(Mask));
+
+        Accumulator1 = _mm256_add_ps(Accumulator1, Vector0);
+
+        if (Output != nullptr) {
+            _mm256_maskstore_ps(Output, Mask, Vector0);
+        }
+    }
+
+    //
+    // Reduce the accumulators to a single value.
+    //
+
+    Accumulator0 = _mm256_add_ps(Accumulator0, Accumulator1);
+
+    __m128 Accumulator = _mm_add_ps(_mm256_castps256_ps128(Accumulator0), _mm256_extractf128_ps(Accumulator0, 1));
+    Accumulator = _mm_add_ps(Accumulator, _mm_movehl_ps(Accumulator, Accumulator));
+    Accumulator = _mm_add_ss(Accumulator, _mm_shuffle_ps(Accumulator, Accumulator, 1));
+
+    return _mm_cvtss_f32(Accumulator);
+}
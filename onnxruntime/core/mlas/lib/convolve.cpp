@@ -1020,6 +1020,87 @@ Return Value:
     }
 }
 
+void
+MlasConvPrepareExpandThenGemmSegmented(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a convolution operation that expands the input
+    tensor into segments of the working buffer on multiple threads.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+
+    //
+    // Segment the operation across multiple threads by slicing the N
+    // dimension (see MlasSgemmTryMultithread).
+    //
+    // Compute the number of target threads given the complexity of the
+    // convolution operation. Small requests should run using the single
+    // threaded path.
+    //
+
+    int32_t TargetThreadCount;
+    double Complexity = double(FilterCount) * double(OutputSize) * double(K);
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Compute the thread stride for slicing the N dimension.
+    //
+
+    size_t StrideN = OutputSize / TargetThreadCount;
+
+    if ((StrideN * TargetThreadCount) != OutputSize) {
+        StrideN++;
+    }
+
+    if (TargetThreadCount > 1) {
+
+        StrideN = (StrideN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+        if (StrideN >= OutputSize) {
+            TargetThreadCount = 1;
+        } else if (StrideN * (TargetThreadCount - 1) >= OutputSize) {
+            TargetThreadCount--;
+        }
+    }
+
+    Parameters->Algorithm = MlasConvAlgorithmExpandThenGemmSegmented;
+    Parameters->u.ExpandThenGemmSegmented.ThreadStrideN = StrideN;
+
+    *WorkingBufferSize = TargetThreadCount * MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD;
+}
+
 void
 MLASCALL
 MlasConvPrepare(
@@ -1185,54 +1266,59 @@ Return Value:
 
     } else {
 
-        //
-        // Segment the operation across multiple threads by slicing the N
-        // dimension (see MlasSgemmTryMultithread).
-        //
-        // Compute the number of target threads given the complexity of the
-        // convolution operation. Small requests should run using the single
-        // threaded path.
-        //
+        MlasConvPrepareExpandThenGemmSegmented(Parameters, WorkingBufferSize);
+    }
+}
 
-        int32_t TargetThreadCount;
-        double Complexity = double(FilterCount) * double(OutputSize) * double(K);
+bool
+MLASCALL
+MlasConvSetAlgorithm(
+    MLAS_CONV_PARAMETERS* Parameters,
+    MLAS_CONV_ALGORITHM Algorithm,
+    size_t* WorkingBufferSize
+    )
+/*++
 
-        if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
-            TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
-        } else {
-            TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
-        }
+Routine Description:
 
-        int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+    This routine overrides the algorithm selected by MlasConvPrepare, for
+    example after timing the candidate algorithms for the convolution.
 
-        if (TargetThreadCount >= MaximumThreadCount) {
-            TargetThreadCount = MaximumThreadCount;
-        }
+    A convolution that MlasConvPrepare mapped directly to a GEMM cannot be
+    switched to another algorithm and no other convolution can be switched to
+    the direct GEMM algorithm.
 
-        //
-        // Compute the thread stride for slicing the N dimension.
-        //
+Arguments:
 
-        size_t StrideN = OutputSize / TargetThreadCount;
+    Parameters - Supplies the structure returned by MlasConvPrepare.
 
-        if ((StrideN * TargetThreadCount) != OutputSize) {
-            StrideN++;
-        }
+    Algorithm - Supplies the algorithm to use for the convolution.
 
-        if (TargetThreadCount > 1) {
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
 
-            StrideN = (StrideN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+Return Value:
 
-            if (StrideN >= OutputSize) {
-                TargetThreadCount = 1;
-            } else if (StrideN * (TargetThreadCount - 1) >= OutputSize) {
-                TargetThreadCount--;
-            }
-        }
+    Returns true if the algorithm can be used for the convolution, else false
+    and the parameters are not modified.
+
+--*/
+{
+    if (Parameters->Algorithm == MlasConvAlgorithmGemmDirect ||
+        Algorithm == MlasConvAlgorithmGemmDirect) {
+        return false;
+    }
+
+    if (Algorithm == MlasConvAlgorithmExpandThenGemm) {
 
-        Parameters->Algorithm = MlasConvAlgorithmExpandThenGemmSegmented;
-        Parameters->u.ExpandThenGemmSegmented.ThreadStrideN = StrideN;
+        Parameters->Algorithm = MlasConvAlgorithmExpandThenGemm;
 
-        *WorkingBufferSize = TargetThreadCount * MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD;
+        *WorkingBufferSize = Parameters->OutputSize * Parameters->K;
+
+    } else {
+
+        MlasConvPrepareExpandThenGemmSegmented(Parameters, WorkingBufferSize);
     }
+
+    return true;
 }
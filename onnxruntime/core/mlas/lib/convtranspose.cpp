@@ -0,0 +1,981 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convtranspose.cpp
+
+Abstract:
+
+    This module implements the transposed convolution operation.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of elements processed by a thread before the operation is
+// partitioned across another thread.
+//
+
+#define MLAS_CONV_TRANSPOSE_THREAD_COMPLEXITY       (64 * 1024)
+
+//
+// Define the maximum number of input channels per group for which the direct
+// stride 2 algorithm is faster than expanding the GEMM output.
+//
+
+#define MLAS_CONV_TRANSPOSE_DIRECT_MAXIMUM_CHANNELS 4
+
+//
+// Define the parameters to execute segments of a transposed convolution
+// operation on worker threads. The operation is partitioned by output planes.
+//
+
+struct MLAS_CONV_TRANSPOSE_WORK_BLOCK {
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters;
+    const float* Input;
+    const float* Filter;
+    const float* Bias;
+    float* WorkingBuffer;
+    float* Output;
+    size_t PlaneCount;
+    int32_t TargetThreadCount;
+};
+
+inline
+void
+MlasConvTransposeComputeValidRange(
+    size_t InputLength,
+    size_t Stride,
+    ptrdiff_t Offset,
+    size_t OutputLength,
+    size_t* Begin,
+    size_t* End
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the range of input indices i such that the output
+    index i * Stride + Offset lies inside the output.
+
+Arguments:
+
+    InputLength - Supplies the number of input indices.
+
+    Stride - Supplies the stride between the output indices.
+
+    Offset - Supplies the output index of the first input index.
+
+    OutputLength - Supplies the number of output indices.
+
+    Begin - Receives the first valid input index.
+
+    End - Receives the input index following the last valid input index.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t begin = 0;
+    size_t end = 0;
+
+    if (Offset < 0) {
+        begin = (size_t(-Offset) + Stride - 1) / Stride;
+    }
+
+    if (Offset < ptrdiff_t(OutputLength)) {
+
+        end = (size_t(ptrdiff_t(OutputLength) - 1 - Offset)) / Stride + 1;
+
+        if (end > InputLength) {
+            end = InputLength;
+        }
+    }
+
+    if (begin > end) {
+        begin = end;
+    }
+
+    *Begin = begin;
+    *End = end;
+}
+
+inline
+void
+MlasConvTransposeFill(
+    float* Output,
+    float Value,
+    size_t N
+    )
+{
+    MLAS_FLOAT32X4 ValueVector = MlasBroadcastFloat32x4(Value);
+
+    while (N >= 4) {
+        MlasStoreFloat32x4(Output, ValueVector);
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+        *Output++ = Value;
+        N -= 1;
+    }
+}
+
+inline
+void
+MlasConvTransposeAccumulate(
+    float* Output,
+    const float* Input,
+    size_t N
+    )
+{
+    while (N >= 4) {
+        MLAS_FLOAT32X4 Vector = MlasAddFloat32x4(MlasLoadFloat32x4(Output), MlasLoadFloat32x4(Input));
+        MlasStoreFloat32x4(Output, Vector);
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+        *Output++ += *Input++;
+        N -= 1;
+    }
+}
+
+void
+MlasConvTransposeCol2Im(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* ColumnBuffer,
+    float Bias,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine accumulates the convolution patches of an output channel
+    computed by the GEMM operation into the output image.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the transposed
+        convolution parameters.
+
+    ColumnBuffer - Supplies the rows of the GEMM output for the output channel.
+
+    Bias - Supplies the initial value of the output image.
+
+    Output - Supplies the output image.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+
+    const size_t KernelHeight = Parameters->KernelShape[0];
+    const size_t KernelWidth = Parameters->KernelShape[1];
+    const size_t DilationHeight = Parameters->DilationShape[0];
+    const size_t DilationWidth = Parameters->DilationShape[1];
+    const size_t PaddingLeftY = Parameters->Padding[0];
+    const size_t PaddingLeftX = Parameters->Padding[1];
+    const size_t StrideHeight = Parameters->StrideShape[0];
+    const size_t StrideWidth = Parameters->StrideShape[1];
+
+    MlasConvTransposeFill(Output, Bias, Parameters->OutputSize);
+
+    for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+        const ptrdiff_t OffsetY = ptrdiff_t(kh * DilationHeight) - ptrdiff_t(PaddingLeftY);
+
+        size_t ihBegin;
+        size_t ihEnd;
+
+        MlasConvTransposeComputeValidRange(InputHeight, StrideHeight, OffsetY,
+            OutputHeight, &ihBegin, &ihEnd);
+
+        for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+            const ptrdiff_t OffsetX = ptrdiff_t(kw * DilationWidth) - ptrdiff_t(PaddingLeftX);
+
+            size_t iwBegin;
+            size_t iwEnd;
+
+            MlasConvTransposeComputeValidRange(InputWidth, StrideWidth, OffsetX,
+                OutputWidth, &iwBegin, &iwEnd);
+
+            const size_t CountX = iwEnd - iwBegin;
+
+            if (CountX > 0) {
+
+                for (size_t ih = ihBegin; ih < ihEnd; ih++) {
+
+                    const float* col = ColumnBuffer + ih * InputWidth + iwBegin;
+                    float* output = Output + (ih * StrideHeight + OffsetY) * OutputWidth +
+                        (iwBegin * StrideWidth + OffsetX);
+
+                    if (StrideWidth == 1) {
+                        MlasConvTransposeAccumulate(output, col, CountX);
+                    } else {
+                        for (size_t iw = 0; iw < CountX; iw++) {
+                            output[iw * StrideWidth] += col[iw];
+                        }
+                    }
+                }
+            }
+
+            ColumnBuffer += InputSize;
+        }
+    }
+}
+
+void
+MlasConvTransposeDirectStride2(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    float Bias,
+    float* RowBuffer,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine computes an output channel of a transposed convolution with
+    a stride of 2 and a kernel of 2 or 3 elements in each dimension without
+    expanding the convolution patches.
+
+    Each output row receives at most two input rows from each input channel.
+    The even and odd columns of the output row are accumulated separately so
+    that the input rows are loaded contiguously.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the transposed
+        convolution parameters.
+
+    Input - Supplies the input channels of the group.
+
+    Filter - Supplies the filter of the group offset to the output channel.
+
+    Bias - Supplies the initial value of the output image.
+
+    RowBuffer - Supplies the thread local slice of the working buffer.
+
+    Output - Supplies the output image.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+
+    const size_t KernelHeight = Parameters->KernelShape[0];
+    const size_t KernelWidth = Parameters->KernelShape[1];
+    const size_t KernelSize = KernelHeight * KernelWidth;
+    const size_t PaddingLeftY = Parameters->Padding[0];
+    const size_t PaddingLeftX = Parameters->Padding[1];
+
+    const size_t FilterChannelStride = Parameters->FilterCount * KernelSize;
+
+    //
+    // The output row before cropping the padding has (InputWidth - 1) * 2 +
+    // KernelWidth columns. Its even columns are accumulated to EvenBuffer and
+    // its odd columns to OddBuffer.
+    //
+
+    const size_t FullWidth = (InputWidth - 1) * 2 + KernelWidth;
+
+    float* EvenBuffer = RowBuffer;
+    float* OddBuffer = RowBuffer + InputWidth + 1;
+
+    for (size_t oh = 0; oh < OutputHeight; oh++) {
+
+        float* output = Output + oh * OutputWidth;
+
+        const size_t uh = oh + PaddingLeftY;
+
+        //
+        // Find the input rows that contribute to the output row.
+        //
+
+        const float* InputRows[2];
+        const float* FilterRows[2];
+        size_t RowCount = 0;
+
+        for (size_t kh = (uh & 1); kh < KernelHeight && kh <= uh; kh += 2) {
+
+            const size_t ih = (uh - kh) / 2;
+
+            if (ih < InputHeight) {
+                InputRows[RowCount] = Input + ih * InputWidth;
+                FilterRows[RowCount] = Filter + kh * KernelWidth;
+                RowCount++;
+            }
+        }
+
+        if (RowCount == 0) {
+            MlasConvTransposeFill(output, Bias, OutputWidth);
+            continue;
+        }
+
+        //
+        // Accumulate blocks of 8 even and 8 odd columns over the input
+        // channels in registers. The even column j also receives the input
+        // column j - 1 scaled by the third kernel column, so the blocks start
+        // at column 1 for kernels of 3 columns.
+        //
+
+        const size_t FirstColumn = KernelWidth - 2;
+
+        size_t ColumnsRemaining = InputWidth - FirstColumn;
+        size_t j = FirstColumn;
+
+        while (ColumnsRemaining >= 8) {
+
+            MLAS_FLOAT32X4 Even0 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Even1 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Odd0 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Odd1 = MlasZeroFloat32x4();
+
+            for (size_t r = 0; r < RowCount; r++) {
+
+                const float* input = InputRows[r] + j;
+                const float* filter = FilterRows[r];
+
+                for (size_t ic = 0; ic < InputChannels; ic++) {
+
+                    MLAS_FLOAT32X4 Input0 = MlasLoadFloat32x4(input);
+                    MLAS_FLOAT32X4 Input1 = MlasLoadFloat32x4(input + 4);
+
+                    MLAS_FLOAT32X4 Filter0 = MlasBroadcastFloat32x4(filter[0]);
+                    MLAS_FLOAT32X4 Filter1 = MlasBroadcastFloat32x4(filter[1]);
+
+                    Even0 = MlasMultiplyAddFloat32x4(Input0, Filter0, Even0);
+                    Even1 = MlasMultiplyAddFloat32x4(Input1, Filter0, Even1);
+                    Odd0 = MlasMultiplyAddFloat32x4(Input0, Filter1, Odd0);
+                    Odd1 = MlasMultiplyAddFloat32x4(Input1, Filter1, Odd1);
+
+                    if (KernelWidth == 3) {
+
+                        MLAS_FLOAT32X4 Filter2 = MlasBroadcastFloat32x4(filter[2]);
+
+                        Even0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input - 1), Filter2, Even0);
+                        Even1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input + 3), Filter2, Even1);
+                    }
+
+                    input += InputSize;
+                    filter += FilterChannelStride;
+                }
+            }
+
+            MlasStoreFloat32x4(EvenBuffer + j, Even0);
+            MlasStoreFloat32x4(EvenBuffer + j + 4, Even1);
+            MlasStoreFloat32x4(OddBuffer + j, Odd0);
+            MlasStoreFloat32x4(OddBuffer + j + 4, Odd1);
+
+            j += 8;
+            ColumnsRemaining -= 8;
+        }
+
+        //
+        // Accumulate the columns before and after the blocks one at a time.
+        //
+
+        for (size_t jj = 0; jj <= InputWidth; jj++) {
+
+            //
+            // Skip the columns computed by the blocks.
+            //
+
+            if (jj == FirstColumn) {
+                jj = j;
+            }
+
+            float Even = 0.0f;
+            float Odd = 0.0f;
+
+            for (size_t r = 0; r < RowCount; r++) {
+
+                const float* input = InputRows[r];
+                const float* filter = FilterRows[r];
+
+                for (size_t ic = 0; ic < InputChannels; ic++) {
+
+                    if (jj < InputWidth) {
+                        Even += input[jj] * filter[0];
+                        Odd += input[jj] * filter[1];
+                    }
+
+                    if (KernelWidth == 3 && jj > 0) {
+                        Even += input[jj - 1] * filter[2];
+                    }
+
+                    input += InputSize;
+                    filter += FilterChannelStride;
+                }
+            }
+
+            EvenBuffer[jj] = Even;
+
+            if (jj < InputWidth) {
+                OddBuffer[jj] = Odd;
+            }
+        }
+
+        //
+        // Interleave the even and odd columns to the output row.
+        //
+
+        MLAS_FLOAT32X4 BiasVector = MlasBroadcastFloat32x4(Bias);
+
+        size_t ow = 0;
+
+        while (ow < OutputWidth) {
+
+            const size_t uw = ow + PaddingLeftX;
+
+            if ((uw & 1) == 0 && uw + 8 <= FullWidth && ow + 8 <= OutputWidth) {
+
+                MLAS_FLOAT32X4 Even = MlasLoadFloat32x4(EvenBuffer + uw / 2);
+                MLAS_FLOAT32X4 Odd = MlasLoadFloat32x4(OddBuffer + uw / 2);
+
+                MlasStoreFloat32x4(output + ow, MlasAddFloat32x4(BiasVector, MlasInterleaveLowFloat32x4(Even, Odd)));
+                MlasStoreFloat32x4(output + ow + 4, MlasAddFloat32x4(BiasVector, MlasInterleaveHighFloat32x4(Even, Odd)));
+
+                ow += 8;
+                continue;
+            }
+
+            float Value = Bias;
+
+            if (uw < FullWidth) {
+                Value += ((uw & 1) != 0) ? OddBuffer[uw / 2] : EvenBuffer[uw / 2];
+            }
+
+            output[ow] = Value;
+            ow += 1;
+        }
+    }
+}
+
+inline
+void
+MlasConvTransposePartitionWork(
+    int32_t Index,
+    int32_t TargetThreadCount,
+    size_t TotalWork,
+    size_t* WorkIndex,
+    size_t* WorkRemaining
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the range of work items executed by a thread.
+
+Arguments:
+
+    Index - Supplies the index of the thread.
+
+    TargetThreadCount - Supplies the number of threads.
+
+    TotalWork - Supplies the number of work items.
+
+    WorkIndex - Receives the first work item of the thread.
+
+    WorkRemaining - Receives the number of work items of the thread.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t WorkPerThread = TotalWork / TargetThreadCount;
+    const size_t WorkPerThreadExtra = TotalWork % TargetThreadCount;
+
+    if (uint32_t(Index) < WorkPerThreadExtra) {
+        *WorkIndex = (WorkPerThread + 1) * Index;
+        *WorkRemaining = WorkPerThread + 1;
+    } else {
+        *WorkIndex = WorkPerThread * Index + WorkPerThreadExtra;
+        *WorkRemaining = WorkPerThread;
+    }
+}
+
+void
+MlasConvTransposeCol2ImThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to accumulate a range of the
+    output channels of a group.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_TRANSPOSE_WORK_BLOCK* WorkBlock = (MLAS_CONV_TRANSPOSE_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t ColumnPlaneSize = Parameters->KernelShape[0] * Parameters->KernelShape[1] *
+        Parameters->InputSize;
+
+    size_t PlaneIndex;
+    size_t PlaneRemaining;
+
+    MlasConvTransposePartitionWork(Index, WorkBlock->TargetThreadCount,
+        WorkBlock->PlaneCount, &PlaneIndex, &PlaneRemaining);
+
+    for (size_t p = PlaneIndex; p < PlaneIndex + PlaneRemaining; p++) {
+
+        float Bias = (WorkBlock->Bias != nullptr) ? WorkBlock->Bias[p] : 0.0f;
+
+        MlasConvTransposeCol2Im(Parameters, WorkBlock->Input + p * ColumnPlaneSize,
+            Bias, WorkBlock->Output + p * OutputSize);
+    }
+}
+
+void
+MlasConvTransposeDirectStride2Threaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to compute a range of the
+    output channels of all batches and groups with the direct algorithm.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_TRANSPOSE_WORK_BLOCK* WorkBlock = (MLAS_CONV_TRANSPOSE_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t KernelSize = Parameters->KernelShape[0] * Parameters->KernelShape[1];
+
+    const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
+    const size_t FilterGroupSize = Parameters->InputChannels * FilterCount * KernelSize;
+
+    float* RowBuffer = WorkBlock->WorkingBuffer + Index * (Parameters->InputShape[1] * 2 + 1);
+
+    size_t PlaneIndex;
+    size_t PlaneRemaining;
+
+    MlasConvTransposePartitionWork(Index, WorkBlock->TargetThreadCount,
+        WorkBlock->PlaneCount, &PlaneIndex, &PlaneRemaining);
+
+    for (size_t p = PlaneIndex; p < PlaneIndex + PlaneRemaining; p++) {
+
+        const size_t bg = p / FilterCount;
+        const size_t group = bg % GroupCount;
+        const size_t f = p % FilterCount;
+
+        float Bias = (WorkBlock->Bias != nullptr) ? WorkBlock->Bias[group * FilterCount + f] : 0.0f;
+
+        MlasConvTransposeDirectStride2(Parameters, WorkBlock->Input + bg * InputGroupSize,
+            WorkBlock->Filter + group * FilterGroupSize + f * KernelSize, Bias,
+            RowBuffer, WorkBlock->Output + p * OutputSize);
+    }
+}
+
+int32_t
+MlasConvTransposeGetTargetThreadCount(
+    size_t PlaneCount,
+    double Complexity
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of threads to partition the output planes
+    of an operation given its complexity. Small requests run on a single
+    thread.
+
+Arguments:
+
+    PlaneCount - Supplies the number of output planes.
+
+    Complexity - Supplies the number of elements processed by the operation.
+
+Return Value:
+
+    Returns the number of threads.
+
+--*/
+{
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_CONV_TRANSPOSE_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_CONV_TRANSPOSE_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) >= PlaneCount) {
+        TargetThreadCount = int32_t(PlaneCount);
+    }
+
+    if (TargetThreadCount < 1) {
+        TargetThreadCount = 1;
+    }
+
+    return TargetThreadCount;
+}
+
+void
+MLASCALL
+MlasConvTranspose(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the transposed convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the transposed
+        convolution parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvTransposePrepare.
+
+    Output - Supplies the output tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BatchCount = Parameters->BatchCount;
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+
+    MLAS_CONV_TRANSPOSE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Filter = Filter;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+
+    if (Parameters->Algorithm == MlasConvTransposeAlgorithmDirectStride2) {
+
+        //
+        // Compute all the output planes of all batches and groups directly
+        // from the input tensor.
+        //
+
+        const size_t PlaneCount = BatchCount * GroupCount * FilterCount;
+        const double Complexity = double(PlaneCount) * double(InputChannels) * double(K / FilterCount) *
+            double(InputSize);
+
+        WorkBlock.Input = Input;
+        WorkBlock.Bias = Bias;
+        WorkBlock.Output = Output;
+        WorkBlock.PlaneCount = PlaneCount;
+        WorkBlock.TargetThreadCount = MlasConvTransposeGetTargetThreadCount(PlaneCount, Complexity);
+
+        MlasExecuteThreaded(MlasConvTransposeDirectStride2Threaded, &WorkBlock, WorkBlock.TargetThreadCount);
+
+        return;
+    }
+
+    //
+    // Iterate over each batch and group.
+    //
+
+    const size_t InputGroupSize = InputChannels * InputSize;
+    const size_t OutputGroupSize = FilterCount * OutputSize;
+    const size_t FilterGroupSize = InputChannels * K;
+
+    const double Complexity = double(K) * double(InputSize) + double(OutputGroupSize);
+
+    WorkBlock.Input = WorkingBuffer;
+    WorkBlock.PlaneCount = FilterCount;
+    WorkBlock.TargetThreadCount = MlasConvTransposeGetTargetThreadCount(FilterCount, Complexity);
+
+    for (size_t batch = 0; batch < BatchCount; batch++) {
+
+        const float* filter = Filter;
+        const float* bias = Bias;
+
+        for (size_t group = 0; group < GroupCount; group++) {
+
+            //
+            // Invoke the threaded GEMM to compute the convolution patches of
+            // the output channels from the input channels.
+            //
+
+            MlasSgemm(CblasTrans, CblasNoTrans, K, InputSize, InputChannels, 1.0f,
+                filter, K, Input, InputSize, 0.0f, WorkingBuffer, InputSize);
+
+            //
+            // Accumulate the convolution patches to the output channels
+            // initialized with the optional bias vector.
+            //
+
+            WorkBlock.Bias = bias;
+            WorkBlock.Output = Output;
+
+            MlasExecuteThreaded(MlasConvTransposeCol2ImThreaded, &WorkBlock, WorkBlock.TargetThreadCount);
+
+            //
+            // Advance the buffer pointers.
+            //
+
+            if (bias != nullptr) {
+                bias += FilterCount;
+            }
+
+            filter += FilterGroupSize;
+            Input += InputGroupSize;
+            Output += OutputGroupSize;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasConvTransposePrepare(
+    MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t FilterCount,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a two dimensional transposed convolution
+    operation by computing required parameters including the required working
+    buffer size for intermediate results.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the transposed convolution operation.
+
+    BatchCount - Supplies the number of batches to the processed.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    InputShape - Supplies the shape of the input tensor.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    Padding - Supplies the number of elements cropped from the edges of the
+        output tensor.
+
+    StrideShape - Supplies the shape of the stride.
+
+    OutputShape - Supplies the shape of the output tensor.
+
+    FilterCount - Supplies the number of output channels per group.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Save the transposed convolution parameters.
+    //
+
+    Parameters->BatchCount = BatchCount;
+    Parameters->GroupCount = GroupCount;
+    Parameters->InputChannels = InputChannels;
+    Parameters->FilterCount = FilterCount;
+
+    size_t InputSize = 1;
+    size_t OutputSize = 1;
+    size_t K = FilterCount;
+
+    for (size_t dim = 0; dim < 2; dim++) {
+
+        Parameters->InputShape[dim] = size_t(InputShape[dim]);
+        Parameters->OutputShape[dim] = size_t(OutputShape[dim]);
+        Parameters->KernelShape[dim] = size_t(KernelShape[dim]);
+        Parameters->DilationShape[dim] = size_t(DilationShape[dim]);
+        Parameters->Padding[dim] = size_t(Padding[dim]);
+        Parameters->Padding[dim + 2] = size_t(Padding[dim + 2]);
+        Parameters->StrideShape[dim] = size_t(StrideShape[dim]);
+
+        InputSize *= Parameters->InputShape[dim];
+        OutputSize *= Parameters->OutputShape[dim];
+        K *= Parameters->KernelShape[dim];
+    }
+
+    Parameters->InputSize = InputSize;
+    Parameters->OutputSize = OutputSize;
+    Parameters->K = K;
+
+    //
+    // Evaluate how the transposed convolution will be performed.
+    //
+    // Upsampling layers with few input channels per group, such as depthwise
+    // transposed convolutions, are computed directly from the input tensor:
+    // the GEMM would have a small inner dimension and the expanded patches
+    // would be larger than the output.
+    //
+
+    if (InputChannels > MLAS_CONV_TRANSPOSE_DIRECT_MAXIMUM_CHANNELS ||
+        !MlasConvTransposeSetAlgorithm(Parameters, MlasConvTransposeAlgorithmDirectStride2,
+            WorkingBufferSize)) {
+
+        MlasConvTransposeSetAlgorithm(Parameters, MlasConvTransposeAlgorithmGemmThenCol2Im,
+            WorkingBufferSize);
+    }
+}
+
+bool
+MLASCALL
+MlasConvTransposeSetAlgorithm(
+    MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    MLAS_CONV_TRANSPOSE_ALGORITHM Algorithm,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine overrides the algorithm selected by MlasConvTransposePrepare,
+    for example after timing the candidate algorithms for the transposed
+    convolution.
+
+    The direct algorithm can only be selected for transposed convolutions
+    with a stride of 2, a dilation of 1 and a kernel of 2 or 3 elements in
+    each dimension.
+
+Arguments:
+
+    Parameters - Supplies the structure returned by MlasConvTransposePrepare.
+
+    Algorithm - Supplies the algorithm to use for the transposed convolution.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
+
+    Returns true if the algorithm can be used for the transposed convolution,
+    else false and the parameters are not modified.
+
+--*/
+{
+    if (Algorithm == MlasConvTransposeAlgorithmDirectStride2) {
+
+        for (size_t dim = 0; dim < 2; dim++) {
+
+            if (Parameters->StrideShape[dim] != 2 || Parameters->DilationShape[dim] != 1 ||
+                (Parameters->KernelShape[dim] != 2 && Parameters->KernelShape[dim] != 3)) {
+                return false;
+            }
+        }
+
+        Parameters->Algorithm = MlasConvTransposeAlgorithmDirectStride2;
+
+        *WorkingBufferSize = MLAS_MAXIMUM_THREAD_COUNT * (Parameters->InputShape[1] * 2 + 1);
+
+    } else {
+
+        Parameters->Algorithm = MlasConvTransposeAlgorithmGemmThenCol2Im;
+
+        *WorkingBufferSize = Parameters->K * Parameters->InputSize;
+    }
+
+    return true;
+}
@@ -0,0 +1,707 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfconvert.cpp
+
+Abstract:
+
+    This module implements routines to convert between single precision
+    floats and the 16-bit IEEE half precision and bfloat16 formats.
+
+    Conversions to the 16-bit formats round to nearest even. Infinities are
+    preserved and NaNs are converted to quiet NaNs.
+
+--*/
+
+#include "mlasi.h"
+#include <string.h>
+
+//
+// Define the bit patterns used by the half precision conversions.
+//
+
+#define MLAS_HALF_EXPONENT_MASK_SHIFTED         0x0F800000  // half exponent mask shifted into float position
+#define MLAS_HALF_EXPONENT_ADJUST               0x38000000  // (127 - 15) << 23
+#define MLAS_HALF_DENORMAL_ADJUST               0x00800000  // 1 << 23
+#define MLAS_HALF_DENORMAL_MAGIC                0x38800000  // 2^-14, smallest normal half
+#define MLAS_HALF_OVERFLOW_THRESHOLD            0x47800000  // 2^16, smallest float rounding to infinity
+#define MLAS_HALF_ROUNDING_BIAS                 0xC8000FFF  // ((15 - 127) << 23) + 0xFFF
+#define MLAS_FLOAT_ONE_HALF                     0x3F000000  // 0.5f
+
+inline
+uint32_t
+MlasFloatToBits(
+    float Value
+    )
+{
+    uint32_t Bits;
+    memcpy(&Bits, &Value, sizeof(Bits));
+    return Bits;
+}
+
+inline
+float
+MlasBitsToFloat(
+    uint32_t Bits
+    )
+{
+    float Value;
+    memcpy(&Value, &Bits, sizeof(Value));
+    return Value;
+}
+
+inline
+float
+MlasConvertHalfToFloat(
+    unsigned short Half
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a half precision float to a single precision float.
+
+    The exponent and mantissa are shifted into place and the exponent bias is
+    adjusted. Infinities and NaNs need a second exponent adjustment and
+    denormals are renormalized by subtracting the smallest normal value, so
+    the conversion does not depend on the processor's denormal handling.
+
+Arguments:
+
+    Half - Supplies the half precision value to convert.
+
+Return Value:
+
+    Returns the single precision value.
+
+--*/
+{
+    uint32_t Bits = uint32_t(Half & 0x7FFF) << 13;
+    uint32_t Exponent = Bits & MLAS_HALF_EXPONENT_MASK_SHIFTED;
+
+    Bits += MLAS_HALF_EXPONENT_ADJUST;
+
+    float Value;
+
+    if (Exponent == MLAS_HALF_EXPONENT_MASK_SHIFTED) {
+        Value = MlasBitsToFloat(Bits + MLAS_HALF_EXPONENT_ADJUST);
+    } else if (Exponent == 0) {
+        Value = MlasBitsToFloat(Bits + MLAS_HALF_DENORMAL_ADJUST) - MlasBitsToFloat(MLAS_HALF_DENORMAL_MAGIC);
+    } else {
+        Value = MlasBitsToFloat(Bits);
+    }
+
+    return MlasBitsToFloat(MlasFloatToBits(Value) | (uint32_t(Half & 0x8000) << 16));
+}
+
+inline
+unsigned short
+MlasConvertFloatToHalf(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a single precision float to a half precision float
+    rounding to nearest even.
+
+    Values that are too large for the half precision range become infinity.
+    Values below the smallest normal half are rounded by adding one half,
+    which aligns the result to the bottom of the float mantissa so that the
+    floating point unit performs the rounding. Otherwise the exponent bias is
+    adjusted and the discarded mantissa bits are rounded with integer
+    arithmetic.
+
+Arguments:
+
+    Value - Supplies the single precision value to convert.
+
+Return Value:
+
+    Returns the half precision value.
+
+--*/
+{
+    uint32_t Bits = MlasFloatToBits(Value);
+    uint32_t Sign = Bits & 0x80000000;
+
+    Bits ^= Sign;
+
+    uint32_t Half;
+
+    if (Bits >= MLAS_HALF_OVERFLOW_THRESHOLD) {
+        Half = (Bits > 0x7F800000) ? 0x7E00 : 0x7C00;
+    } else if (Bits < MLAS_HALF_DENORMAL_MAGIC) {
+        Half = MlasFloatToBits(MlasBitsToFloat(Bits) + MlasBitsToFloat(MLAS_FLOAT_ONE_HALF)) - MLAS_FLOAT_ONE_HALF;
+    } else {
+        uint32_t MantissaOdd = (Bits >> 13) & 1;
+        Bits += MLAS_HALF_ROUNDING_BIAS;
+        Bits += MantissaOdd;
+        Half = Bits >> 13;
+    }
+
+    return (unsigned short)(Half | (Sign >> 16));
+}
+
+inline
+float
+MlasConvertBFloat16ToFloat(
+    unsigned short Value
+    )
+{
+    return MlasBitsToFloat(uint32_t(Value) << 16);
+}
+
+inline
+unsigned short
+MlasConvertFloatToBFloat16(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a single precision float to a bfloat16 value
+    rounding to nearest even. NaNs are converted to quiet NaNs so that the
+    truncation cannot produce an infinity.
+
+Arguments:
+
+    Value - Supplies the single precision value to convert.
+
+Return Value:
+
+    Returns the bfloat16 value.
+
+--*/
+{
+    uint32_t Bits = MlasFloatToBits(Value);
+
+    if ((Bits & 0x7FFFFFFF) > 0x7F800000) {
+        return (unsigned short)((Bits >> 16) | 0x0040);
+    }
+
+    Bits += 0x7FFF + ((Bits >> 16) & 1);
+
+    return (unsigned short)(Bits >> 16);
+}
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+inline
+__m128i
+MlasPackInt32x4ToUInt16x8(
+    __m128i Vector0,
+    __m128i Vector1
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the low 16 bits of each element of the supplied
+    vectors. SSE2 only has a signed saturating pack, so each element is
+    first sign extended from its low 16 bits.
+
+Arguments:
+
+    Vector0 - Supplies the vector that provides the low four elements.
+
+    Vector1 - Supplies the vector that provides the high four elements.
+
+Return Value:
+
+    Returns the packed vector.
+
+--*/
+{
+    Vector0 = _mm_srai_epi32(_mm_slli_epi32(Vector0, 16), 16);
+    Vector1 = _mm_srai_epi32(_mm_slli_epi32(Vector1, 16), 16);
+
+    return _mm_packs_epi32(Vector0, Vector1);
+}
+
+#endif
+
+inline
+MLAS_FLOAT32X4
+MlasConvertHalfToFloat32x4(
+    MLAS_INT32X4 Half
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a vector of half precision floats, zero extended to
+    32 bits, to single precision floats. See MlasConvertHalfToFloat.
+
+Arguments:
+
+    Half - Supplies the vector to convert.
+
+Return Value:
+
+    Returns the vector of single precision values.
+
+--*/
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    uint32x4_t HalfVector = vreinterpretq_u32_s32(Half);
+    uint32x4_t ExponentMantissa = vandq_u32(HalfVector, vdupq_n_u32(0x7FFF));
+    uint32x4_t Sign = vshlq_n_u32(veorq_u32(HalfVector, ExponentMantissa), 16);
+
+    uint32x4_t Bits = vshlq_n_u32(ExponentMantissa, 13);
+    uint32x4_t Exponent = vandq_u32(Bits, vdupq_n_u32(MLAS_HALF_EXPONENT_MASK_SHIFTED));
+
+    Bits = vaddq_u32(Bits, vdupq_n_u32(MLAS_HALF_EXPONENT_ADJUST));
+
+    uint32x4_t InfinityMask = vceqq_u32(Exponent, vdupq_n_u32(MLAS_HALF_EXPONENT_MASK_SHIFTED));
+    uint32x4_t DenormalMask = vceqq_u32(Exponent, vdupq_n_u32(0));
+
+    Bits = vaddq_u32(Bits, vandq_u32(InfinityMask, vdupq_n_u32(MLAS_HALF_EXPONENT_ADJUST)));
+    Bits = vaddq_u32(Bits, vandq_u32(DenormalMask, vdupq_n_u32(MLAS_HALF_DENORMAL_ADJUST)));
+
+    float32x4_t Value = vsubq_f32(vreinterpretq_f32_u32(Bits),
+        vreinterpretq_f32_u32(vandq_u32(DenormalMask, vdupq_n_u32(MLAS_HALF_DENORMAL_MAGIC))));
+
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(Value), Sign));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128i ExponentMantissa = _mm_and_si128(Half, _mm_set1_epi32(0x7FFF));
+    __m128i Sign = _mm_slli_epi32(_mm_xor_si128(Half, ExponentMantissa), 16);
+
+    __m128i Bits = _mm_slli_epi32(ExponentMantissa, 13);
+    __m128i Exponent = _mm_and_si128(Bits, _mm_set1_epi32(MLAS_HALF_EXPONENT_MASK_SHIFTED));
+
+    Bits = _mm_add_epi32(Bits, _mm_set1_epi32(MLAS_HALF_EXPONENT_ADJUST));
+
+    __m128i InfinityMask = _mm_cmpeq_epi32(Exponent, _mm_set1_epi32(MLAS_HALF_EXPONENT_MASK_SHIFTED));
+    __m128i DenormalMask = _mm_cmpeq_epi32(Exponent, _mm_setzero_si128());
+
+    Bits = _mm_add_epi32(Bits, _mm_and_si128(InfinityMask, _mm_set1_epi32(MLAS_HALF_EXPONENT_ADJUST)));
+    Bits = _mm_add_epi32(Bits, _mm_and_si128(DenormalMask, _mm_set1_epi32(MLAS_HALF_DENORMAL_ADJUST)));
+
+    __m128 Value = _mm_sub_ps(_mm_castsi128_ps(Bits),
+        _mm_castsi128_ps(_mm_and_si128(DenormalMask, _mm_set1_epi32(MLAS_HALF_DENORMAL_MAGIC))));
+
+    return _mm_or_ps(Value, _mm_castsi128_ps(Sign));
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasConvertFloat32x4ToHalf(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a vector of single precision floats to half
+    precision floats, rounding to nearest even. The results are returned in
+    the low 16 bits of each element. See MlasConvertFloatToHalf.
+
+Arguments:
+
+    Vector - Supplies the vector to convert.
+
+Return Value:
+
+    Returns the vector of half precision values.
+
+--*/
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    uint32x4_t Bits = vreinterpretq_u32_f32(Vector);
+    uint32x4_t Sign = vandq_u32(Bits, vdupq_n_u32(0x80000000));
+
+    Bits = veorq_u32(Bits, Sign);
+
+    uint32x4_t OverflowMask = vcgeq_u32(Bits, vdupq_n_u32(MLAS_HALF_OVERFLOW_THRESHOLD));
+    uint32x4_t DenormalMask = vcltq_u32(Bits, vdupq_n_u32(MLAS_HALF_DENORMAL_MAGIC));
+
+    uint32x4_t OverflowHalf = vorrq_u32(vdupq_n_u32(0x7C00),
+        vandq_u32(vcgtq_u32(Bits, vdupq_n_u32(0x7F800000)), vdupq_n_u32(0x0200)));
+
+    uint32x4_t DenormalHalf = vsubq_u32(vreinterpretq_u32_f32(vaddq_f32(vreinterpretq_f32_u32(Bits),
+        vreinterpretq_f32_u32(vdupq_n_u32(MLAS_FLOAT_ONE_HALF)))), vdupq_n_u32(MLAS_FLOAT_ONE_HALF));
+
+    uint32x4_t MantissaOdd = vandq_u32(vshrq_n_u32(Bits, 13), vdupq_n_u32(1));
+    uint32x4_t NormalHalf = vshrq_n_u32(vaddq_u32(vaddq_u32(Bits,
+        vdupq_n_u32(MLAS_HALF_ROUNDING_BIAS)), MantissaOdd), 13);
+
+    uint32x4_t Half = vbslq_u32(DenormalMask, DenormalHalf, NormalHalf);
+    Half = vbslq_u32(OverflowMask, OverflowHalf, Half);
+    Half = vorrq_u32(Half, vshrq_n_u32(Sign, 16));
+
+    return vreinterpretq_s32_u32(Half);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128i Bits = _mm_castps_si128(Vector);
+    __m128i Sign = _mm_and_si128(Bits, _mm_set1_epi32(int32_t(0x80000000)));
+
+    Bits = _mm_xor_si128(Bits, Sign);
+
+    //
+    // The sign bit has been cleared, so the signed comparisons below order
+    // the values correctly.
+    //
+
+    __m128i OverflowMask = _mm_cmpgt_epi32(Bits, _mm_set1_epi32(MLAS_HALF_OVERFLOW_THRESHOLD - 1));
+    __m128i DenormalMask = _mm_cmplt_epi32(Bits, _mm_set1_epi32(MLAS_HALF_DENORMAL_MAGIC));
+
+    __m128i OverflowHalf = _mm_or_si128(_mm_set1_epi32(0x7C00),
+        _mm_and_si128(_mm_cmpgt_epi32(Bits, _mm_set1_epi32(0x7F800000)), _mm_set1_epi32(0x0200)));
+
+    __m128i DenormalHalf = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(Bits),
+        _mm_castsi128_ps(_mm_set1_epi32(MLAS_FLOAT_ONE_HALF)))), _mm_set1_epi32(MLAS_FLOAT_ONE_HALF));
+
+    __m128i MantissaOdd = _mm_and_si128(_mm_srli_epi32(Bits, 13), _mm_set1_epi32(1));
+    __m128i NormalHalf = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(Bits,
+        _mm_set1_epi32(int32_t(MLAS_HALF_ROUNDING_BIAS))), MantissaOdd), 13);
+
+    __m128i Half = _mm_or_si128(_mm_and_si128(DenormalMask, DenormalHalf), _mm_andnot_si128(DenormalMask, NormalHalf));
+    Half = _mm_or_si128(_mm_and_si128(OverflowMask, OverflowHalf), _mm_andnot_si128(OverflowMask, Half));
+    Half = _mm_or_si128(Half, _mm_srli_epi32(Sign, 16));
+
+    return Half;
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasConvertFloat32x4ToBFloat16(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a vector of single precision floats to bfloat16
+    values, rounding to nearest even. The results are returned in the low 16
+    bits of each element. See MlasConvertFloatToBFloat16.
+
+Arguments:
+
+    Vector - Supplies the vector to convert.
+
+Return Value:
+
+    Returns the vector of bfloat16 values.
+
+--*/
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    uint32x4_t Bits = vreinterpretq_u32_f32(Vector);
+    uint32x4_t NaNMask = vcgtq_u32(vandq_u32(Bits, vdupq_n_u32(0x7FFFFFFF)), vdupq_n_u32(0x7F800000));
+
+    uint32x4_t RoundingBias = vaddq_u32(vdupq_n_u32(0x7FFF), vandq_u32(vshrq_n_u32(Bits, 16), vdupq_n_u32(1)));
+    uint32x4_t Rounded = vshrq_n_u32(vaddq_u32(Bits, RoundingBias), 16);
+    uint32x4_t QuietNaN = vorrq_u32(vshrq_n_u32(Bits, 16), vdupq_n_u32(0x0040));
+
+    return vreinterpretq_s32_u32(vbslq_u32(NaNMask, QuietNaN, Rounded));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128i Bits = _mm_castps_si128(Vector);
+    __m128i NaNMask = _mm_cmpgt_epi32(_mm_and_si128(Bits, _mm_set1_epi32(0x7FFFFFFF)), _mm_set1_epi32(0x7F800000));
+
+    __m128i RoundingBias = _mm_add_epi32(_mm_set1_epi32(0x7FFF), _mm_and_si128(_mm_srli_epi32(Bits, 16), _mm_set1_epi32(1)));
+    __m128i Rounded = _mm_srli_epi32(_mm_add_epi32(Bits, RoundingBias), 16);
+    __m128i QuietNaN = _mm_or_si128(_mm_srli_epi32(Bits, 16), _mm_set1_epi32(0x0040));
+
+    return _mm_or_si128(_mm_and_si128(NaNMask, QuietNaN), _mm_andnot_si128(NaNMask, Rounded));
+#endif
+}
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernel(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half precision floats to the
+    destination buffer of single precision floats.
+
+    This implementation uses baseline SSE2 or NEON integer instructions.
+
+Arguments:
+
+    Source - Supplies the source buffer of half precision floats.
+
+    Destination - Supplies the destination buffer of single precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count >= 8) {
+
+#if defined(MLAS_NEON_INTRINSICS)
+        uint16x8_t HalfVector = vld1q_u16(Source);
+        MLAS_INT32X4 Half0 = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(HalfVector)));
+        MLAS_INT32X4 Half1 = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(HalfVector)));
+#elif defined(MLAS_SSE2_INTRINSICS)
+        __m128i HalfVector = _mm_loadu_si128((const __m128i*)Source);
+        MLAS_INT32X4 Half0 = _mm_unpacklo_epi16(HalfVector, _mm_setzero_si128());
+        MLAS_INT32X4 Half1 = _mm_unpackhi_epi16(HalfVector, _mm_setzero_si128());
+#endif
+
+        MlasStoreFloat32x4(Destination, MlasConvertHalfToFloat32x4(Half0));
+        MlasStoreFloat32x4(Destination + 4, MlasConvertHalfToFloat32x4(Half1));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    while (Count > 0) {
+
+        *Destination++ = MlasConvertHalfToFloat(*Source++);
+        Count -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernel(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single precision floats to the
+    destination buffer of half precision floats.
+
+    This implementation uses baseline SSE2 or NEON integer instructions.
+
+Arguments:
+
+    Source - Supplies the source buffer of single precision floats.
+
+    Destination - Supplies the destination buffer of half precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count >= 8) {
+
+        MLAS_INT32X4 Half0 = MlasConvertFloat32x4ToHalf(MlasLoadFloat32x4(Source));
+        MLAS_INT32X4 Half1 = MlasConvertFloat32x4ToHalf(MlasLoadFloat32x4(Source + 4));
+
+#if defined(MLAS_NEON_INTRINSICS)
+        vst1q_u16(Destination, vcombine_u16(vmovn_u32(vreinterpretq_u32_s32(Half0)),
+            vmovn_u32(vreinterpretq_u32_s32(Half1))));
+#elif defined(MLAS_SSE2_INTRINSICS)
+        _mm_storeu_si128((__m128i*)Destination, MlasPackInt32x4ToUInt16x8(Half0, Half1));
+#endif
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    while (Count > 0) {
+
+        *Destination++ = MlasConvertFloatToHalf(*Source++);
+        Count -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasConvertHalfToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half precision floats to the
+    destination buffer of single precision floats.
+
+Arguments:
+
+    Source - Supplies the source buffer of half precision floats.
+
+    Destination - Supplies the destination buffer of single precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ConvertHalfToFloatRoutine(Source, Destination, Count);
+#else
+    MlasConvertHalfToFloatKernel(Source, Destination, Count);
+#endif
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single precision floats to the
+    destination buffer of half precision floats, rounding to nearest even.
+
+Arguments:
+
+    Source - Supplies the source buffer of single precision floats.
+
+    Destination - Supplies the destination buffer of half precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ConvertFloatToHalfRoutine(Source, Destination, Count);
+#else
+    MlasConvertFloatToHalfKernel(Source, Destination, Count);
+#endif
+}
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of bfloat16 values to the
+    destination buffer of single precision floats.
+
+Arguments:
+
+    Source - Supplies the source buffer of bfloat16 values.
+
+    Destination - Supplies the destination buffer of single precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count >= 8) {
+
+#if defined(MLAS_NEON_INTRINSICS)
+        uint16x8_t Vector = vld1q_u16(Source);
+        uint32x4_t Bits0 = vshll_n_u16(vget_low_u16(Vector), 16);
+        uint32x4_t Bits1 = vshll_n_u16(vget_high_u16(Vector), 16);
+
+        MlasStoreFloat32x4(Destination, vreinterpretq_f32_u32(Bits0));
+        MlasStoreFloat32x4(Destination + 4, vreinterpretq_f32_u32(Bits1));
+#elif defined(MLAS_SSE2_INTRINSICS)
+        __m128i Vector = _mm_loadu_si128((const __m128i*)Source);
+        __m128i Bits0 = _mm_unpacklo_epi16(_mm_setzero_si128(), Vector);
+        __m128i Bits1 = _mm_unpackhi_epi16(_mm_setzero_si128(), Vector);
+
+        MlasStoreFloat32x4(Destination, _mm_castsi128_ps(Bits0));
+        MlasStoreFloat32x4(Destination + 4, _mm_castsi128_ps(Bits1));
+#endif
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    while (Count > 0) {
+
+        *Destination++ = MlasConvertBFloat16ToFloat(*Source++);
+        Count -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single precision floats to the
+    destination buffer of bfloat16 values, rounding to nearest even.
+
+Arguments:
+
+    Source - Supplies the source buffer of single precision floats.
+
+    Destination - Supplies the destination buffer of bfloat16 values.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count >= 8) {
+
+        MLAS_INT32X4 Value0 = MlasConvertFloat32x4ToBFloat16(MlasLoadFloat32x4(Source));
+        MLAS_INT32X4 Value1 = MlasConvertFloat32x4ToBFloat16(MlasLoadFloat32x4(Source + 4));
+
+#if defined(MLAS_NEON_INTRINSICS)
+        vst1q_u16(Destination, vcombine_u16(vmovn_u32(vreinterpretq_u32_s32(Value0)),
+            vmovn_u32(vreinterpretq_u32_s32(Value1))));
+#elif defined(MLAS_SSE2_INTRINSICS)
+        _mm_storeu_si128((__m128i*)Destination, MlasPackInt32x4ToUInt16x8(Value0, Value1));
+#endif
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    while (Count > 0) {
+
+        *Destination++ = MlasConvertFloatToBFloat16(*Source++);
+        Count -= 1;
+    }
+}
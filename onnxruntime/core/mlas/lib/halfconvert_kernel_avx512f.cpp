@@ -0,0 +1,145 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfconvert_kernel_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernels to convert between single precision
+    and half precision floats using AVX512F instructions.
+
+--*/
+
+#include "mlasi.h"
+#include <string.h>
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernelAvx512F(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half precision floats to the
+    destination buffer of single precision floats.
+
+    This implementation uses AVX512F instructions.
+
+Arguments:
+
+    Source - Supplies the source buffer of half precision floats.
+
+    Destination - Supplies the destination buffer of single precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count >= 32) {
+
+        __m256i HalfVector0 = _mm256_loadu_si256((const __m256i*)Source);
+        __m256i HalfVector1 = _mm256_loadu_si256((const __m256i*)(Source + 16));
+
+        _mm512_storeu_ps(Destination, _mm512_cvtph_ps(HalfVector0));
+        _mm512_storeu_ps(Destination + 16, _mm512_cvtph_ps(HalfVector1));
+
+        Source += 32;
+        Destination += 32;
+        Count -= 32;
+    }
+
+    if (Count >= 16) {
+
+        _mm512_storeu_ps(Destination, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)Source)));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count > 0) {
+
+        unsigned short HalfBuffer[16] = { 0 };
+        float FloatBuffer[16];
+
+        memcpy(HalfBuffer, Source, Count * sizeof(unsigned short));
+        _mm512_storeu_ps(FloatBuffer, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)HalfBuffer)));
+        memcpy(Destination, FloatBuffer, Count * sizeof(float));
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernelAvx512F(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single precision floats to the
+    destination buffer of half precision floats, rounding to nearest even.
+
+    This implementation uses AVX512F instructions.
+
+Arguments:
+
+    Source - Supplies the source buffer of single precision floats.
+
+    Destination - Supplies the destination buffer of half precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count >= 32) {
+
+        __m256i HalfVector0 = _mm512_cvtps_ph(_mm512_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT);
+        __m256i HalfVector1 = _mm512_cvtps_ph(_mm512_loadu_ps(Source + 16), _MM_FROUND_TO_NEAREST_INT);
+
+        _mm256_storeu_si256((__m256i*)Destination, HalfVector0);
+        _mm256_storeu_si256((__m256i*)(Destination + 16), HalfVector1);
+
+        Source += 32;
+        Destination += 32;
+        Count -= 32;
+    }
+
+    if (Count >= 16) {
+
+        _mm256_storeu_si256((__m256i*)Destination, _mm512_cvtps_ph(_mm512_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count > 0) {
+
+        float FloatBuffer[16] = { 0 };
+        unsigned short HalfBuffer[16];
+
+        memcpy(FloatBuffer, Source, Count * sizeof(float));
+        _mm256_storeu_si256((__m256i*)HalfBuffer, _mm512_cvtps_ph(_mm512_loadu_ps(FloatBuffer), _MM_FROUND_TO_NEAREST_INT));
+        memcpy(Destination, HalfBuffer, Count * sizeof(unsigned short));
+    }
+}
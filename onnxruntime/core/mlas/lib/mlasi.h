@@ -55,6 +55,16 @@ Abstract:
 
 #define MLAS_UNREFERENCED_PARAMETER(parameter) ((void)(parameter))
 
+//
+// Macro to force inline expansion of a function.
+//
+
+#if defined(_MSC_VER)
+#define MLAS_FORCEINLINE __forceinline
+#else
+#define MLAS_FORCEINLINE __attribute__ ((always_inline)) inline
+#endif
+
 //
 // Select the target architecture.
 //
@@ -112,6 +122,21 @@ Abstract:
 
 #define MLAS_SGEMM_STRIDEN_THREAD_ALIGN             16
 
+//
+// Define the default strides to step through slices of the input matrices
+// for the quantized integer GEMM. Matrix A is packed in blocks of rows and
+// matrix B is packed in blocks of columns with each block widened to 16-bit
+// values and interleaved as pairs along the K dimension.
+//
+// N.B. MLAS_QGEMM_STRIDEK must be a multiple of 2 and MLAS_QGEMM_STRIDEN must
+// be a multiple of MLAS_QGEMM_PACKED_COLUMNS.
+//
+
+#define MLAS_QGEMM_STRIDEM                          16
+#define MLAS_QGEMM_STRIDEN                          128
+#define MLAS_QGEMM_STRIDEK                          256
+#define MLAS_QGEMM_PACKED_COLUMNS                   16
+
 //
 // Define the prototypes of the platform optimized routines.
 //
@@ -176,6 +201,71 @@ void
 
 typedef MLAS_TANH_KERNEL_ROUTINE* PMLAS_TANH_KERNEL_ROUTINE;
 
+typedef
+void
+(MLASCALL MLAS_COMPUTE_EXP_KERNEL_ROUTINE)(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+typedef MLAS_COMPUTE_EXP_KERNEL_ROUTINE* PMLAS_COMPUTE_EXP_KERNEL_ROUTINE;
+
+typedef
+float
+(MLASCALL MLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE)(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    );
+
+typedef MLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE* PMLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE;
+
+typedef
+float
+(MLASCALL MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE)(
+    const float* Input,
+    size_t N
+    );
+
+typedef MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE* PMLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE;
+
+typedef
+void
+(MLASCALL MLAS_QGEMM_KERNEL_ROUTINE)(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    );
+
+typedef MLAS_QGEMM_KERNEL_ROUTINE* PMLAS_QGEMM_KERNEL_ROUTINE;
+
+typedef
+void
+(MLASCALL MLAS_CONVERT_HALF_TO_FLOAT_ROUTINE)(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef MLAS_CONVERT_HALF_TO_FLOAT_ROUTINE* PMLAS_CONVERT_HALF_TO_FLOAT_ROUTINE;
+
+typedef
+void
+(MLASCALL MLAS_CONVERT_FLOAT_TO_HALF_ROUTINE)(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+typedef MLAS_CONVERT_FLOAT_TO_HALF_ROUTINE* PMLAS_CONVERT_FLOAT_TO_HALF_ROUTINE;
+
 extern "C" {
 
     MLAS_SGEMM_KERNEL_ROUTINE MlasSgemmKernelZero;
@@ -210,6 +300,34 @@ extern "C" {
     MLAS_TANH_KERNEL_ROUTINE MlasTanhKernelFma3;
 #endif
 
+    MLAS_COMPUTE_EXP_KERNEL_ROUTINE MlasComputeExpKernel;
+    MLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE MlasComputeSumExpKernel;
+    MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE MlasReduceMaximumKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_COMPUTE_EXP_KERNEL_ROUTINE MlasComputeExpKernelFma3;
+    MLAS_COMPUTE_EXP_KERNEL_ROUTINE MlasComputeExpKernelAvx512F;
+    MLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE MlasComputeSumExpKernelFma3;
+    MLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE MlasComputeSumExpKernelAvx512F;
+    MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE MlasReduceMaximumKernelAvx;
+    MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE MlasReduceMaximumKernelAvx512F;
+#endif
+
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernelAvx2;
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernelAvx512BW;
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernelAvx512Vnni;
+#endif
+
+    MLAS_CONVERT_HALF_TO_FLOAT_ROUTINE MlasConvertHalfToFloatKernel;
+    MLAS_CONVERT_FLOAT_TO_HALF_ROUTINE MlasConvertFloatToHalfKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_CONVERT_HALF_TO_FLOAT_ROUTINE MlasConvertHalfToFloatKernelF16C;
+    MLAS_CONVERT_FLOAT_TO_HALF_ROUTINE MlasConvertFloatToHalfKernelF16C;
+    MLAS_CONVERT_HALF_TO_FLOAT_ROUTINE MlasConvertHalfToFloatKernelAvx512F;
+    MLAS_CONVERT_FLOAT_TO_HALF_ROUTINE MlasConvertFloatToHalfKernelAvx512F;
+#endif
+
 }
 
 //
@@ -231,6 +349,20 @@ extern "C" {
 #endif
 #endif
 
+//
+// Define the target number of per-thread multiplies before using another
+// thread to perform additional work for the quantized integer GEMM.
+//
+
+#define MLAS_QGEMM_THREAD_COMPLEXITY                (MLAS_SGEMM_THREAD_COMPLEXITY)
+
+//
+// Define the target number of per-thread elements before using another
+// thread to compute additional rows of a softmax operation.
+//
+
+#define MLAS_SOFTMAX_THREAD_COMPLEXITY              (64 * 1024)
+
 //
 // Single-threaded single precision matrix/matrix multiply operation.
 //
@@ -271,6 +403,12 @@ struct MLAS_PLATFORM {
     PMLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE TransposePackB16x4Routine;
     PMLAS_LOGISTIC_KERNEL_ROUTINE LogisticKernelRoutine;
     PMLAS_TANH_KERNEL_ROUTINE TanhKernelRoutine;
+    PMLAS_COMPUTE_EXP_KERNEL_ROUTINE ComputeExpKernelRoutine;
+    PMLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE ComputeSumExpKernelRoutine;
+    PMLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE ReduceMaximumKernelRoutine;
+    PMLAS_QGEMM_KERNEL_ROUTINE QgemmKernelRoutine;
+    PMLAS_CONVERT_HALF_TO_FLOAT_ROUTINE ConvertHalfToFloatRoutine;
+    PMLAS_CONVERT_FLOAT_TO_HALF_ROUTINE ConvertFloatToHalfRoutine;
 #endif
 
 #if defined(MLAS_USE_WIN32_THREADPOOL)
@@ -294,6 +432,34 @@ struct MLAS_PLATFORM {
 
 extern MLAS_PLATFORM MlasPlatform;
 
+//
+// Bundles the constants for the exponential function kernels.
+//
+// The exponential is computed as 2^n * exp(r) where n is the nearest integer
+// to x/ln(2) and r = x - n*ln(2). The power of two is split into a normal and
+// an overflow exponent so that results in the denormal range are rounded once.
+//
+
+struct MLAS_EXP_CONSTANTS {
+    float LowerRange;
+    float UpperRange;
+    float LowerRangeSumExp;
+    float RoundingBias;
+    float Log2Reciprocal;
+    float Log2High;
+    float Log2Low;
+    float poly_0;
+    float poly_1;
+    float poly_2;
+    float poly_3;
+    float poly_4;
+    float poly_56;
+    int32_t MinimumExponent;
+    int32_t MaximumExponent;
+};
+
+extern "C" const MLAS_EXP_CONSTANTS MlasExpConstants;
+
 //
 // Threading support.
 //
@@ -575,6 +741,262 @@ MlasMinimumFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #endif
 }
 
+#if defined(MLAS_NEON_INTRINSICS)
+typedef int32x4_t MLAS_INT32X4;
+#elif defined(MLAS_SSE2_INTRINSICS)
+typedef __m128i MLAS_INT32X4;
+#endif
+
+inline
+MLAS_INT32X4
+MlasBroadcastInt32x4(int32_t Value)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vdupq_n_s32(Value);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_set1_epi32(Value);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasLoadInt32x4(const int32_t* Buffer)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vld1q_s32(Buffer);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_loadu_si128((const __m128i*)Buffer);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasAddInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vaddq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_add_epi32(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasSubtractInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vsubq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_sub_epi32(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasCastToFloat32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vcvtq_f32_s32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_cvtepi32_ps(Vector);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasMaximumInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vmaxq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128i Selection = _mm_cmpgt_epi32(Vector1, Vector2);
+    return _mm_or_si128(_mm_and_si128(Selection, Vector1), _mm_andnot_si128(Selection, Vector2));
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasMinimumInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vminq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128i Selection = _mm_cmpgt_epi32(Vector1, Vector2);
+    return _mm_or_si128(_mm_and_si128(Selection, Vector2), _mm_andnot_si128(Selection, Vector1));
+#endif
+}
+
+template<unsigned ShiftCount>
+inline
+MLAS_INT32X4
+MlasShiftLeftInt32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vshlq_n_s32(Vector, ShiftCount);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_slli_epi32(Vector, ShiftCount);
+#endif
+}
+
+template<unsigned ShiftCount>
+inline
+MLAS_INT32X4
+MlasShiftRightInt32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vshrq_n_s32(Vector, ShiftCount);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_srai_epi32(Vector, ShiftCount);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasReinterpretAsInt32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_s32_f32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castps_si128(Vector);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasReinterpretAsFloat32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_s32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castsi128_ps(Vector);
+#endif
+}
+
+//
+// The bitwise and comparison routines operate on masks where each lane is
+// either all zero bits or all one bits.
+//
+
+inline
+MLAS_FLOAT32X4
+MlasAndFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(Vector1), vreinterpretq_u32_f32(Vector2)));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_and_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasOrFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(Vector1), vreinterpretq_u32_f32(Vector2)));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_or_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasAndNotFloat32x4(MLAS_FLOAT32X4 VectorNot, MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(Vector), vreinterpretq_u32_f32(VectorNot)));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_andnot_ps(VectorNot, Vector);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasBlendFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2, MLAS_FLOAT32X4 Selection)
+{
+    return MlasOrFloat32x4(MlasAndFloat32x4(Vector2, Selection), MlasAndNotFloat32x4(Selection, Vector1));
+}
+
+inline
+MLAS_FLOAT32X4
+MlasLessThanFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vcltq_f32(Vector1, Vector2));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_cmplt_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasEqualFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vceqq_f32(Vector1, Vector2));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_cmpeq_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasInterleaveLowFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vzip1q_f32(Vector1, Vector2);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    return vzipq_f32(Vector1, Vector2).val[0];
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_unpacklo_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasInterleaveHighFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vzip2q_f32(Vector1, Vector2);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    return vzipq_f32(Vector1, Vector2).val[1];
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_unpackhi_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+float
+MlasReduceAddFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vaddvq_f32(Vector);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    float32x2_t VectorLow = vadd_f32(vget_low_f32(Vector), vget_high_f32(Vector));
+    return vget_lane_f32(vpadd_f32(VectorLow, VectorLow), 0);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    Vector = _mm_add_ps(Vector, _mm_movehl_ps(Vector, Vector));
+    Vector = _mm_add_ss(Vector, _mm_shuffle_ps(Vector, Vector, 1));
+    return _mm_cvtss_f32(Vector);
+#endif
+}
+
+inline
+float
+MlasReduceMaximumFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vmaxvq_f32(Vector);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    float32x2_t VectorLow = vmax_f32(vget_low_f32(Vector), vget_high_f32(Vector));
+    return vget_lane_f32(vpmax_f32(VectorLow, VectorLow), 0);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    Vector = _mm_max_ps(Vector, _mm_movehl_ps(Vector, Vector));
+    Vector = _mm_max_ss(Vector, _mm_shuffle_ps(Vector, Vector, 1));
+    return _mm_cvtss_f32(Vector);
+#endif
+}
+
 //
 // Reads a platform specific time stamp counter.
 //
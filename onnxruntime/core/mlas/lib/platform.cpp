@@ -55,6 +55,12 @@ Return Value:
     this->TransposePackB16x4Routine = MlasSgemmTransposePackB16x4Sse;
     this->LogisticKernelRoutine = MlasLogisticKernel;
     this->TanhKernelRoutine = MlasTanhKernel;
+    this->ComputeExpKernelRoutine = MlasComputeExpKernel;
+    this->ComputeSumExpKernelRoutine = MlasComputeSumExpKernel;
+    this->ReduceMaximumKernelRoutine = MlasReduceMaximumKernel;
+    this->QgemmKernelRoutine = MlasQgemmKernel;
+    this->ConvertHalfToFloatRoutine = MlasConvertHalfToFloatKernel;
+    this->ConvertFloatToHalfRoutine = MlasConvertFloatToHalfKernel;
 #endif
 
     //
@@ -89,6 +95,19 @@ Return Value:
 
 #else
 
+            this->ReduceMaximumKernelRoutine = MlasReduceMaximumKernelAvx;
+
+            //
+            // Check if the processor supports the F16C half precision
+            // conversion instructions.
+            //
+
+            if ((Cpuid1[2] & 0x20000000) != 0) {
+
+                this->ConvertHalfToFloatRoutine = MlasConvertHalfToFloatKernelF16C;
+                this->ConvertFloatToHalfRoutine = MlasConvertFloatToHalfKernelF16C;
+            }
+
             //
             // Check if the processor supports AVX512F (and the operating
             // system supports saving AVX512F state) or AVX2/FMA3 features.
@@ -103,12 +122,38 @@ Return Value:
 
             if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0)) {
 
+                this->QgemmKernelRoutine = MlasQgemmKernelAvx2;
+
                 if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0)) {
+
                     this->KernelZeroRoutine = MlasSgemmKernelZeroAvx512F;
                     this->KernelAddRoutine = MlasSgemmKernelAddAvx512F;
+                    this->ConvertHalfToFloatRoutine = MlasConvertHalfToFloatKernelAvx512F;
+                    this->ConvertFloatToHalfRoutine = MlasConvertFloatToHalfKernelAvx512F;
+                    this->ComputeExpKernelRoutine = MlasComputeExpKernelAvx512F;
+                    this->ComputeSumExpKernelRoutine = MlasComputeSumExpKernelAvx512F;
+                    this->ReduceMaximumKernelRoutine = MlasReduceMaximumKernelAvx512F;
+
+                    //
+                    // Check if the processor supports AVX512BW and optionally
+                    // the AVX512 vector neural network instructions.
+                    //
+
+                    if ((Cpuid7[1] & 0x40000000) != 0) {
+
+                        if ((Cpuid7[2] & 0x800) != 0) {
+                            this->QgemmKernelRoutine = MlasQgemmKernelAvx512Vnni;
+                        } else {
+                            this->QgemmKernelRoutine = MlasQgemmKernelAvx512BW;
+                        }
+                    }
+
                 } else {
+
                     this->KernelZeroRoutine = MlasSgemmKernelZeroFma3;
                     this->KernelAddRoutine = MlasSgemmKernelAddFma3;
+                    this->ComputeExpKernelRoutine = MlasComputeExpKernelFma3;
+                    this->ComputeSumExpKernelRoutine = MlasComputeSumExpKernelFma3;
                 }
 
                 this->LogisticKernelRoutine = MlasLogisticKernelFma3;
@@ -1066,11 +1066,38 @@ Return Value:
         size_t InputSizeRemaining = InputSize;
 
         //
-        // Iterate over the input buffer a vector at a time.
+        // Iterate over the input buffer four vectors at a time using
+        // independent accumulators to hide the latency of the reduction.
         //
 
         MLAS_FLOAT32X4 Reduction = PoolingType::InitialVector();
 
+        if (InputSizeRemaining >= 16) {
+
+            MLAS_FLOAT32X4 Reduction1 = Reduction;
+            MLAS_FLOAT32X4 Reduction2 = Reduction;
+            MLAS_FLOAT32X4 Reduction3 = Reduction;
+
+            while (InputSizeRemaining >= 16) {
+
+                Reduction = PoolingType::Reduce(Reduction, MlasLoadFloat32x4(Input));
+                Reduction1 = PoolingType::Reduce(Reduction1, MlasLoadFloat32x4(Input + 4));
+                Reduction2 = PoolingType::Reduce(Reduction2, MlasLoadFloat32x4(Input + 8));
+                Reduction3 = PoolingType::Reduce(Reduction3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                InputSizeRemaining -= 16;
+            }
+
+            Reduction = PoolingType::Reduce(Reduction, Reduction1);
+            Reduction2 = PoolingType::Reduce(Reduction2, Reduction3);
+            Reduction = PoolingType::Reduce(Reduction, Reduction2);
+        }
+
+        //
+        // Iterate over the remaining input buffer a vector at a time.
+        //
+
         while (InputSizeRemaining >= 4) {
             Reduction = PoolingType::Reduce(Reduction, MlasLoadFloat32x4(Input));
             Input += 4;
@@ -1190,6 +1217,10 @@ Routine Description:
 
     This routine implements the pooling operation.
 
+    The batch and channel planes are processed on the calling thread. Callers
+    parallelize the operation by invoking this routine for disjoint ranges of
+    the planes.
+
 Arguments:
 
     PoolingKind - Supplies the kind of pooling operation to perform.
@@ -1217,6 +1248,25 @@ Return Value:
 
 --*/
 {
+    //
+    // Promote a one dimensional pooling operation to a two dimensional
+    // operation over a single row so that the vectorized kernels can be used.
+    //
+
+    if (Dimensions == 1 && KernelShape != nullptr) {
+
+        const int64_t InputShape2D[] = { InputShape[0], InputShape[1], 1, InputShape[2] };
+        const int64_t KernelShape2D[] = { 1, KernelShape[0] };
+        const int64_t Padding2D[] = { 0, (Padding != nullptr) ? Padding[0] : 0, 0, (Padding != nullptr) ? Padding[1] : 0 };
+        const int64_t StrideShape2D[] = { 1, (StrideShape != nullptr) ? StrideShape[0] : 1 };
+        const int64_t OutputShape2D[] = { OutputShape[0], OutputShape[1], 1, OutputShape[2] };
+
+        MlasPool(PoolingKind, 2, InputShape2D, KernelShape2D, Padding2D,
+            StrideShape2D, OutputShape2D, Input, Output);
+
+        return;
+    }
+
     MLAS_WORK_BLOCK WorkBlock;
 
     WorkBlock.PoolingKind = PoolingKind;
@@ -1236,7 +1286,6 @@ Return Value:
     //
 
     size_t InputSize = 1;
-    size_t OutputSize = 1;
 
     bool InputAndKernelShapeMatch = true;
     bool AllStridesAreOne = true;
@@ -1269,7 +1318,6 @@ Return Value:
         }
 
         InputSize *= WorkBlock.InputShape[dim];
-        OutputSize *= WorkBlock.OutputShape[dim];
 
         InputAndKernelShapeMatch &= (WorkBlock.KernelShape[dim] == int64_t(WorkBlock.InputShape[dim]));
         AllStridesAreOne &= (WorkBlock.StrideShape[dim] == 1);
@@ -1319,17 +1367,5 @@ Return Value:
     // Execute the pooling kernel routine.
     //
 
-#if defined(MLAS_USE_OPENMP)
-
-    #pragma omp parallel for
-    for (int64_t c = 0; c < int64_t(TotalChannelCount); c++) {
-        PoolKernelRoutine(&WorkBlock, 1, Input + c * InputSize, Output + c * OutputSize);
-    }
-
-#else
-
     PoolKernelRoutine(&WorkBlock, TotalChannelCount, Input, Output);
-
-#endif
-
 }
@@ -0,0 +1,1075 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm.cpp
+
+Abstract:
+
+    This module implements the quantized integer matrix/matrix multiply
+    operation (QGEMM).
+
+    Matrix A is unsigned 8-bit and matrix B is unsigned or signed 8-bit. Both
+    matrices are widened to 16-bit values with the zero point offsets
+    subtracted as they are copied to the packed buffers, so the kernels only
+    need to compute the sum of 16-bit products into 32-bit accumulators. A
+    signed matrix B is handled by flipping the sign bit of each value and of
+    the zero point offset, which maps the values to the unsigned range without
+    changing the value of (B - offb).
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters to execute segments of a QGEMM operation on worker
+// threads.
+//
+
+struct MLAS_QGEMM_WORK_BLOCK {
+    size_t K;
+    size_t lda;
+    size_t ldb;
+    size_t ldc;
+    uint8_t offa;
+    uint8_t offb;
+    bool BIsSigned;
+    struct SEGMENT {
+        size_t M;
+        size_t N;
+        const uint8_t* A;
+        const uint8_t* B;
+        const int16_t* PackedB;
+        int32_t* C;
+    } Segments[MLAS_MAXIMUM_THREAD_COUNT];
+};
+
+inline
+size_t
+MlasQgemmAlignPackedCountK(
+    size_t CountK
+    )
+{
+    return (CountK + 1) & ~size_t(1);
+}
+
+inline
+size_t
+MlasQgemmAlignPackedCountN(
+    size_t CountN
+    )
+{
+    return (CountN + MLAS_QGEMM_PACKED_COLUMNS - 1) & ~size_t(MLAS_QGEMM_PACKED_COLUMNS - 1);
+}
+
+void
+MlasQgemmCopyPackA(
+    int16_t* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    uint8_t offa
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer. The elements are widened to 16-bit values and the zero
+    point offset is subtracted.
+
+    The rows of the packed buffer are padded to an even number of columns
+    with zeroes so that the kernels can process pairs of values along the K
+    dimension.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the number of elements per row of the source matrix.
+
+    CountM - Supplies the number of rows of the source matrix to copy.
+
+    CountK - Supplies the number of columns of the source matrix to copy.
+
+    offa - Supplies the zero point offset of the source matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t PackedCountK = MlasQgemmAlignPackedCountK(CountK);
+
+#if defined(MLAS_SSE2_INTRINSICS)
+    const __m128i ZeroVector = _mm_setzero_si128();
+    const __m128i OffsetVector = _mm_set1_epi16(offa);
+#elif defined(MLAS_NEON_INTRINSICS)
+    const int16x8_t OffsetVector = vdupq_n_s16(offa);
+#endif
+
+    while (CountM-- > 0) {
+
+        const uint8_t* a = A;
+        int16_t* d = D;
+        size_t k = CountK;
+
+        while (k >= 8) {
+
+#if defined(MLAS_SSE2_INTRINSICS)
+            __m128i Bytes = _mm_loadl_epi64((const __m128i*)a);
+            __m128i Words = _mm_sub_epi16(_mm_unpacklo_epi8(Bytes, ZeroVector), OffsetVector);
+            _mm_storeu_si128((__m128i*)d, Words);
+#elif defined(MLAS_NEON_INTRINSICS)
+            int16x8_t Words = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(a)));
+            vst1q_s16(d, vsubq_s16(Words, OffsetVector));
+#endif
+
+            a += 8;
+            d += 8;
+            k -= 8;
+        }
+
+        while (k > 0) {
+            *d++ = int16_t(*a++) - int16_t(offa);
+            k--;
+        }
+
+        if (PackedCountK != CountK) {
+            *d = 0;
+        }
+
+        A += lda;
+        D += PackedCountK;
+    }
+}
+
+void
+MlasQgemmCopyPackB(
+    int16_t* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    uint8_t offb,
+    bool BIsSigned
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer.
+
+    Columns of 16 elements from the source matrix are unrolled to be physically
+    contiguous for better locality inside the QGEMM kernels. Each pair of rows
+    is interleaved so that a column stores its two values from the pair next
+    to each other. Any partial block of 16 columns or odd row count is padded
+    with zeroes.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountN - Supplies the number of columns of the source matrix to copy.
+
+    CountK - Supplies the number of rows of the source matrix to copy.
+
+    offb - Supplies the zero point offset of the source matrix.
+
+    BIsSigned - Supplies true if the source matrix is signed 8-bit.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const uint8_t BitFlip = BIsSigned ? 0x80 : 0;
+    const int16_t Offset = int16_t(uint8_t(offb ^ BitFlip));
+
+#if defined(MLAS_SSE2_INTRINSICS)
+    const __m128i ZeroVector = _mm_setzero_si128();
+    const __m128i BitFlipVector = _mm_set1_epi8(char(BitFlip));
+    const __m128i OffsetVector = _mm_set1_epi16(Offset);
+#elif defined(MLAS_NEON_INTRINSICS)
+    const uint8x16_t BitFlipVector = vdupq_n_u8(BitFlip);
+    const int16x8_t OffsetVector = vdupq_n_s16(Offset);
+#endif
+
+    //
+    // Copy data from matrix B into the destination buffer 16 columns at a
+    // time.
+    //
+
+    while (CountN >= MLAS_QGEMM_PACKED_COLUMNS) {
+
+        const uint8_t* b = B;
+        size_t k = CountK;
+
+        while (k >= 2) {
+
+#if defined(MLAS_SSE2_INTRINSICS)
+            __m128i Row0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)&b[0]), BitFlipVector);
+            __m128i Row1 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)&b[ldb]), BitFlipVector);
+            __m128i Interleave0 = _mm_unpacklo_epi8(Row0, Row1);
+            __m128i Interleave1 = _mm_unpackhi_epi8(Row0, Row1);
+
+            _mm_storeu_si128((__m128i*)&D[0], _mm_sub_epi16(_mm_unpacklo_epi8(Interleave0, ZeroVector), OffsetVector));
+            _mm_storeu_si128((__m128i*)&D[8], _mm_sub_epi16(_mm_unpackhi_epi8(Interleave0, ZeroVector), OffsetVector));
+            _mm_storeu_si128((__m128i*)&D[16], _mm_sub_epi16(_mm_unpacklo_epi8(Interleave1, ZeroVector), OffsetVector));
+            _mm_storeu_si128((__m128i*)&D[24], _mm_sub_epi16(_mm_unpackhi_epi8(Interleave1, ZeroVector), OffsetVector));
+#elif defined(MLAS_NEON_INTRINSICS)
+            uint8x16x2_t Interleave;
+            Interleave.val[0] = veorq_u8(vld1q_u8(&b[0]), BitFlipVector);
+            Interleave.val[1] = veorq_u8(vld1q_u8(&b[ldb]), BitFlipVector);
+            Interleave = vzipq_u8(Interleave.val[0], Interleave.val[1]);
+
+            vst1q_s16(&D[0], vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(Interleave.val[0]))), OffsetVector));
+            vst1q_s16(&D[8], vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(Interleave.val[0]))), OffsetVector));
+            vst1q_s16(&D[16], vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(Interleave.val[1]))), OffsetVector));
+            vst1q_s16(&D[24], vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(Interleave.val[1]))), OffsetVector));
+#endif
+
+            D += MLAS_QGEMM_PACKED_COLUMNS * 2;
+            b += ldb * 2;
+            k -= 2;
+        }
+
+        if (k > 0) {
+
+            for (size_t n = 0; n < MLAS_QGEMM_PACKED_COLUMNS; n++) {
+                D[n * 2] = int16_t(uint8_t(b[n] ^ BitFlip)) - Offset;
+                D[n * 2 + 1] = 0;
+            }
+
+            D += MLAS_QGEMM_PACKED_COLUMNS * 2;
+        }
+
+        B += MLAS_QGEMM_PACKED_COLUMNS;
+        CountN -= MLAS_QGEMM_PACKED_COLUMNS;
+    }
+
+    //
+    // Special case the handling of the remaining columns less than 16.
+    //
+
+    if (CountN > 0) {
+
+        const uint8_t* b = B;
+
+        for (size_t k = 0; k < CountK; k += 2) {
+
+            for (size_t n = 0; n < MLAS_QGEMM_PACKED_COLUMNS; n++) {
+
+                int16_t Value0 = 0;
+                int16_t Value1 = 0;
+
+                if (n < CountN) {
+
+                    Value0 = int16_t(uint8_t(b[n] ^ BitFlip)) - Offset;
+
+                    if (k + 1 < CountK) {
+                        Value1 = int16_t(uint8_t(b[ldb + n] ^ BitFlip)) - Offset;
+                    }
+                }
+
+                D[n * 2] = Value0;
+                D[n * 2 + 1] = Value1;
+            }
+
+            D += MLAS_QGEMM_PACKED_COLUMNS * 2;
+            b += ldb * 2;
+        }
+    }
+}
+
+#if defined(MLAS_SSE2_INTRINSICS)
+typedef __m128i MLAS_QGEMM_ACCUMULATOR;
+#define MLAS_QGEMM_ACCUMULATORS_PER_ROW         4
+#else
+typedef int32x4_t MLAS_QGEMM_ACCUMULATOR;
+#define MLAS_QGEMM_ACCUMULATORS_PER_ROW         8
+#endif
+
+template<size_t RowCount>
+inline
+void
+MlasQgemmKernelBlock(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of up to 16 columns of the output matrix for
+    the specified number of rows using the baseline vector instructions of the
+    target architecture.
+
+    N.B. With NEON, each accumulator holds the products for two columns and
+    both values of the K pair, which are reduced with a pairwise add after
+    the last pair has been processed.
+
+Arguments:
+
+    A - Supplies the address of the packed matrix A.
+
+    B - Supplies the address of the packed block of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    PackedCountK - Supplies the number of packed columns of matrix A and the
+        number of packed rows of matrix B.
+
+    CountN - Supplies the number of columns of matrix C to store.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ZeroMode - Supplies true if the output matrix is overwritten, else false
+        if the results are accumulated into the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_QGEMM_ACCUMULATOR Accumulators[RowCount][MLAS_QGEMM_ACCUMULATORS_PER_ROW];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t i = 0; i < MLAS_QGEMM_ACCUMULATORS_PER_ROW; i++) {
+#if defined(MLAS_SSE2_INTRINSICS)
+            Accumulators[r][i] = _mm_setzero_si128();
+#else
+            Accumulators[r][i] = vdupq_n_s32(0);
+#endif
+        }
+    }
+
+    for (size_t k = 0; k < PackedCountK; k += 2) {
+
+#if defined(MLAS_SSE2_INTRINSICS)
+        __m128i BElements[4];
+
+        for (size_t i = 0; i < 4; i++) {
+            BElements[i] = _mm_loadu_si128((const __m128i*)&B[i * 8]);
+        }
+#else
+        int16x4_t BElements[8];
+
+        for (size_t i = 0; i < 4; i++) {
+            int16x8_t Elements = vld1q_s16(&B[i * 8]);
+            BElements[i * 2] = vget_low_s16(Elements);
+            BElements[i * 2 + 1] = vget_high_s16(Elements);
+        }
+#endif
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            int32_t PairValue;
+            memcpy(&PairValue, &A[r * PackedCountK + k], sizeof(int32_t));
+
+#if defined(MLAS_SSE2_INTRINSICS)
+            __m128i APair = _mm_set1_epi32(PairValue);
+
+            for (size_t i = 0; i < 4; i++) {
+                Accumulators[r][i] = _mm_add_epi32(Accumulators[r][i], _mm_madd_epi16(APair, BElements[i]));
+            }
+#else
+            int16x4_t APair = vreinterpret_s16_s32(vdup_n_s32(PairValue));
+
+            for (size_t i = 0; i < 8; i++) {
+                Accumulators[r][i] = vmlal_s16(Accumulators[r][i], BElements[i], APair);
+            }
+#endif
+        }
+
+        B += MLAS_QGEMM_PACKED_COLUMNS * 2;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        MLAS_DECLSPEC_ALIGN(int32_t Output[MLAS_QGEMM_PACKED_COLUMNS], 16);
+
+#if defined(MLAS_SSE2_INTRINSICS)
+        for (size_t i = 0; i < 4; i++) {
+            _mm_store_si128((__m128i*)&Output[i * 4], Accumulators[r][i]);
+        }
+#else
+        for (size_t i = 0; i < 8; i++) {
+            int32x2_t Sum = vpadd_s32(vget_low_s32(Accumulators[r][i]), vget_high_s32(Accumulators[r][i]));
+            vst1_s32(&Output[i * 2], Sum);
+        }
+#endif
+
+        int32_t* c = C + r * ldc;
+
+        if (ZeroMode) {
+            for (size_t n = 0; n < CountN; n++) {
+                c[n] = Output[n];
+            }
+        } else {
+            for (size_t n = 0; n < CountN; n++) {
+                c[n] += Output[n];
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasQgemmKernel(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows using the baseline vector instructions of the target
+    architecture.
+
+Arguments:
+
+    A - Supplies the address of the packed matrix A. The rows of the packed
+        matrix are PackedCountK elements apart.
+
+    B - Supplies the address of the packed matrix B. Each block of 16 columns
+        is PackedCountK * 16 elements apart.
+
+    C - Supplies the address of matrix C.
+
+    PackedCountK - Supplies the number of packed columns of matrix A and the
+        number of packed rows of matrix B.
+
+    CountM - Supplies the number of rows of matrix A and matrix C.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ZeroMode - Supplies true if the output matrix is overwritten, else false
+        if the results are accumulated into the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_NEON32_INTRINSICS)
+    constexpr size_t RowsPerBlock = 1;
+#else
+    constexpr size_t RowsPerBlock = 2;
+#endif
+
+    while (CountN > 0) {
+
+        const size_t CountNBlock = std::min(CountN, size_t(MLAS_QGEMM_PACKED_COLUMNS));
+
+        const int16_t* a = A;
+        int32_t* c = C;
+        size_t RowsRemaining = CountM;
+
+        while (RowsRemaining >= RowsPerBlock) {
+            MlasQgemmKernelBlock<RowsPerBlock>(a, B, c, PackedCountK, CountNBlock, ldc, ZeroMode);
+            a += RowsPerBlock * PackedCountK;
+            c += RowsPerBlock * ldc;
+            RowsRemaining -= RowsPerBlock;
+        }
+
+        if (RowsRemaining > 0) {
+            MlasQgemmKernelBlock<1>(a, B, c, PackedCountK, CountNBlock, ldc, ZeroMode);
+        }
+
+        B += PackedCountK * MLAS_QGEMM_PACKED_COLUMNS;
+        C += MLAS_QGEMM_PACKED_COLUMNS;
+        CountN -= CountNBlock;
+    }
+}
+
+void
+MlasQgemmOperation(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    bool BIsSigned,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) on a single thread.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    offa - Supplies the zero point offset of matrix A.
+
+    B - Supplies the address of matrix B. Ignored if PackedB is supplied.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point offset of matrix B.
+
+    BIsSigned - Supplies true if matrix B is signed 8-bit.
+
+    PackedB - Optionally supplies the address of matrix B as packed by
+        MlasQgemmPackB. The address must refer to the start of a block of
+        MLAS_QGEMM_STRIDEN columns.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(int16_t PanelA[MLAS_QGEMM_STRIDEM * MLAS_QGEMM_STRIDEK], 64);
+    MLAS_DECLSPEC_ALIGN(int16_t PanelB[MLAS_QGEMM_STRIDEN * MLAS_QGEMM_STRIDEK], 64);
+
+#if defined(MLAS_TARGET_AMD64)
+    PMLAS_QGEMM_KERNEL_ROUTINE KernelRoutine = MlasPlatform.QgemmKernelRoutine;
+#else
+    PMLAS_QGEMM_KERNEL_ROUTINE KernelRoutine = MlasQgemmKernel;
+#endif
+
+    //
+    // Handle the case of an empty inner dimension, which produces zeroes.
+    //
+
+    if (K == 0) {
+
+        for (size_t m = 0; m < M; m++) {
+            std::fill_n(C + m * ldc, N, 0);
+        }
+
+        return;
+    }
+
+    const size_t PackedK = MlasQgemmAlignPackedCountK(K);
+
+    //
+    // Step through each slice of matrix B along the N dimension.
+    //
+
+    size_t CountN;
+
+    for (size_t n = 0; n < N; n += CountN) {
+
+        CountN = std::min(N - n, size_t(MLAS_QGEMM_STRIDEN));
+
+        //
+        // Step through each slice of matrix B along the K dimension.
+        //
+
+        size_t CountK;
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            CountK = std::min(K - k, size_t(MLAS_QGEMM_STRIDEK));
+
+            const size_t PackedCountK = MlasQgemmAlignPackedCountK(CountK);
+
+            //
+            // Copy a panel of matrix B to a local packed buffer or locate the
+            // panel inside the caller's packed buffer.
+            //
+
+            const int16_t* pb;
+
+            if (PackedB != nullptr) {
+                pb = PackedB + n * PackedK + k * MlasQgemmAlignPackedCountN(CountN);
+            } else {
+                MlasQgemmCopyPackB(PanelB, B + k * ldb + n, ldb, CountN, CountK, offb, BIsSigned);
+                pb = PanelB;
+            }
+
+            //
+            // Step through each slice of matrix A along the M dimension.
+            //
+
+            size_t CountM;
+
+            for (size_t m = 0; m < M; m += CountM) {
+
+                CountM = std::min(M - m, size_t(MLAS_QGEMM_STRIDEM));
+
+                MlasQgemmCopyPackA(PanelA, A + m * lda + k, lda, CountM, CountK, offa);
+
+                KernelRoutine(PanelA, pb, C + m * ldc + n, PackedCountK, CountM,
+                    CountN, ldc, k == 0);
+            }
+        }
+    }
+}
+
+void
+MlasQgemmOperationThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    QGEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_QGEMM_WORK_BLOCK* WorkBlock = (MLAS_QGEMM_WORK_BLOCK*)Context;
+
+    MLAS_QGEMM_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
+
+    MlasQgemmOperation(Segment->M, Segment->N, WorkBlock->K, Segment->A,
+        WorkBlock->lda, WorkBlock->offa, Segment->B, WorkBlock->ldb,
+        WorkBlock->offb, WorkBlock->BIsSigned, Segment->PackedB, Segment->C,
+        WorkBlock->ldc);
+}
+
+inline
+bool
+MlasQgemmTryMultithread(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    bool BIsSigned,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine attempts to launch a quantized integer matrix/matrix multiply
+    operation (QGEMM) across multiple threads.
+
+Arguments:
+
+    See MlasQgemmOperation.
+
+Return Value:
+
+    Returns true if the operation was completed across multiple threads, else
+    false if the operation should fall back to a single thread.
+
+--*/
+{
+
+#if defined(MLAS_HAS_THREADING_SUPPORT)
+
+    MLAS_QGEMM_WORK_BLOCK WorkBlock;
+    int32_t TargetThreadCount;
+
+    //
+    // Compute the number of target threads given the complexity of the QGEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    double Complexity = double(M) * double(N) * double(K);
+
+    if (Complexity < double(MLAS_QGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (TargetThreadCount == 1) {
+        return false;
+    }
+
+    //
+    // Initialize the common fields of the work block.
+    //
+
+    WorkBlock.K = K;
+    WorkBlock.lda = lda;
+    WorkBlock.ldb = ldb;
+    WorkBlock.ldc = ldc;
+    WorkBlock.offa = offa;
+    WorkBlock.offb = offb;
+    WorkBlock.BIsSigned = BIsSigned;
+
+    //
+    // Segment the operation across multiple threads.
+    //
+    // N.B. A packed matrix B can only be split at the boundaries of the
+    // blocks that were used to pack the matrix.
+    //
+
+    int32_t Index = 0;
+
+    const size_t ThreadAlignN = (PackedB != nullptr) ? MLAS_QGEMM_STRIDEN : MLAS_QGEMM_PACKED_COLUMNS;
+
+    if (N > M && N > ThreadAlignN) {
+
+        size_t StrideN = N / TargetThreadCount;
+
+        if ((StrideN * TargetThreadCount) != N) {
+            StrideN++;
+        }
+
+        StrideN = (StrideN + ThreadAlignN - 1) / ThreadAlignN * ThreadAlignN;
+
+        const size_t PackedK = MlasQgemmAlignPackedCountK(K);
+
+        for (size_t CountN, n = 0; n < N; n += CountN) {
+
+            CountN = StrideN;
+
+            if (CountN > (N - n)) {
+                CountN = N - n;
+            }
+
+            WorkBlock.Segments[Index].M = M;
+            WorkBlock.Segments[Index].N = CountN;
+            WorkBlock.Segments[Index].A = A;
+            WorkBlock.Segments[Index].B = B + n;
+            WorkBlock.Segments[Index].PackedB = (PackedB != nullptr) ? PackedB + n * PackedK : nullptr;
+            WorkBlock.Segments[Index].C = C + n;
+
+            Index++;
+        }
+
+    } else {
+
+        size_t StrideM = M / TargetThreadCount;
+
+        if ((StrideM * TargetThreadCount) != M) {
+            StrideM++;
+        }
+
+        for (size_t CountM, m = 0; m < M; m += CountM) {
+
+            CountM = StrideM;
+
+            if (CountM > (M - m)) {
+                CountM = M - m;
+            }
+
+            WorkBlock.Segments[Index].M = CountM;
+            WorkBlock.Segments[Index].N = N;
+            WorkBlock.Segments[Index].A = A + m * lda;
+            WorkBlock.Segments[Index].B = B;
+            WorkBlock.Segments[Index].PackedB = PackedB;
+            WorkBlock.Segments[Index].C = C + m * ldc;
+
+            Index++;
+        }
+    }
+
+    MlasExecuteThreaded(MlasQgemmOperationThreaded, &WorkBlock, Index);
+
+    return true;
+
+#else
+
+    //
+    // No threading implementation is available.
+    //
+
+    MLAS_UNREFERENCED_PARAMETER(M);
+    MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(K);
+    MLAS_UNREFERENCED_PARAMETER(A);
+    MLAS_UNREFERENCED_PARAMETER(lda);
+    MLAS_UNREFERENCED_PARAMETER(offa);
+    MLAS_UNREFERENCED_PARAMETER(B);
+    MLAS_UNREFERENCED_PARAMETER(ldb);
+    MLAS_UNREFERENCED_PARAMETER(offb);
+    MLAS_UNREFERENCED_PARAMETER(BIsSigned);
+    MLAS_UNREFERENCED_PARAMETER(PackedB);
+    MLAS_UNREFERENCED_PARAMETER(C);
+    MLAS_UNREFERENCED_PARAMETER(ldc);
+
+    return false;
+
+#endif
+
+}
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    bool BIsSigned,
+    int32_t* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM).
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    offa - Supplies the zero point offset of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point offset of matrix B.
+
+    BIsSigned - Supplies true if matrix B is signed 8-bit.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Try to run the operation across multiple threads or fall back to a
+    // single thread based on the GEMM parameters and system configuration.
+    //
+
+    if (!MlasQgemmTryMultithread(M, N, K, A, lda, offa, B, ldb, offb, BIsSigned, nullptr, C, ldc)) {
+        MlasQgemmOperation(M, N, K, A, lda, offa, B, ldb, offb, BIsSigned, nullptr, C, ldc);
+    }
+}
+
+size_t
+MLASCALL
+MlasQgemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of bytes required to pack matrix B with
+    MlasQgemmPackB.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size of the packed buffer in bytes.
+
+--*/
+{
+    return MlasQgemmAlignPackedCountN(N) * MlasQgemmAlignPackedCountK(K) * sizeof(int16_t);
+}
+
+void
+MLASCALL
+MlasQgemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    bool BIsSigned,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs matrix B ahead of time so that repeated calls to
+    MlasQgemmPacked with the same matrix B avoid the cost of packing.
+
+    The packed buffer stores the blocks of MLAS_QGEMM_STRIDEN columns one
+    after another. Each block stores its slices of MLAS_QGEMM_STRIDEK rows
+    one after another in the format consumed by the kernels.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point offset of matrix B.
+
+    BIsSigned - Supplies true if matrix B is signed 8-bit.
+
+    PackedB - Supplies the address of the packed buffer, which must be at
+        least MlasQgemmPackBSize bytes.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    int16_t* pb = (int16_t*)PackedB;
+
+    size_t CountN;
+
+    for (size_t n = 0; n < N; n += CountN) {
+
+        CountN = std::min(N - n, size_t(MLAS_QGEMM_STRIDEN));
+
+        size_t CountK;
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            CountK = std::min(K - k, size_t(MLAS_QGEMM_STRIDEK));
+
+            MlasQgemmCopyPackB(pb, B + k * ldb + n, ldb, CountN, CountK, offb, BIsSigned);
+
+            pb += MlasQgemmAlignPackedCountN(CountN) * MlasQgemmAlignPackedCountK(CountK);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasQgemmPacked(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const void* PackedB,
+    int32_t* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) with a matrix B that was packed by MlasQgemmPackB.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    offa - Supplies the zero point offset of matrix A.
+
+    PackedB - Supplies the address of the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const int16_t* pb = (const int16_t*)PackedB;
+
+    if (!MlasQgemmTryMultithread(M, N, K, A, lda, offa, nullptr, 0, 0, false, pb, C, ldc)) {
+        MlasQgemmOperation(M, N, K, A, lda, offa, nullptr, 0, 0, false, pb, C, ldc);
+    }
+}
@@ -0,0 +1,196 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel for the quantized integer matrix/matrix
+    multiply operation (QGEMM) using AVX2 instructions.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t RowCount>
+inline
+void
+MlasQgemmKernelAvx2Block(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of up to 16 columns of the output matrix for
+    the specified number of rows.
+
+Arguments:
+
+    A - Supplies the address of the packed matrix A.
+
+    B - Supplies the address of the packed block of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    PackedCountK - Supplies the number of packed columns of matrix A and the
+        number of packed rows of matrix B.
+
+    CountN - Supplies the number of columns of matrix C to store.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ZeroMode - Supplies true if the output matrix is overwritten, else false
+        if the results are accumulated into the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    __m256i Accumulators[RowCount][2];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r][0] = _mm256_setzero_si256();
+        Accumulators[r][1] = _mm256_setzero_si256();
+    }
+
+    for (size_t k = 0; k < PackedCountK; k += 2) {
+
+        __m256i BElements0 = _mm256_loadu_si256((const __m256i*)&B[0]);
+        __m256i BElements1 = _mm256_loadu_si256((const __m256i*)&B[16]);
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            int32_t PairValue;
+            memcpy(&PairValue, &A[r * PackedCountK + k], sizeof(int32_t));
+
+            __m256i APair = _mm256_set1_epi32(PairValue);
+
+            Accumulators[r][0] = _mm256_add_epi32(Accumulators[r][0], _mm256_madd_epi16(APair, BElements0));
+            Accumulators[r][1] = _mm256_add_epi32(Accumulators[r][1], _mm256_madd_epi16(APair, BElements1));
+        }
+
+        B += MLAS_QGEMM_PACKED_COLUMNS * 2;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        int32_t* c = C + r * ldc;
+
+        if (CountN == MLAS_QGEMM_PACKED_COLUMNS) {
+
+            if (!ZeroMode) {
+                Accumulators[r][0] = _mm256_add_epi32(Accumulators[r][0], _mm256_loadu_si256((const __m256i*)&c[0]));
+                Accumulators[r][1] = _mm256_add_epi32(Accumulators[r][1], _mm256_loadu_si256((const __m256i*)&c[8]));
+            }
+
+            _mm256_storeu_si256((__m256i*)&c[0], Accumulators[r][0]);
+            _mm256_storeu_si256((__m256i*)&c[8], Accumulators[r][1]);
+
+        } else {
+
+            MLAS_DECLSPEC_ALIGN(int32_t Output[MLAS_QGEMM_PACKED_COLUMNS], 32);
+
+            _mm256_store_si256((__m256i*)&Output[0], Accumulators[r][0]);
+            _mm256_store_si256((__m256i*)&Output[8], Accumulators[r][1]);
+
+            if (ZeroMode) {
+                for (size_t n = 0; n < CountN; n++) {
+                    c[n] = Output[n];
+                }
+            } else {
+                for (size_t n = 0; n < CountN; n++) {
+                    c[n] += Output[n];
+                }
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasQgemmKernelAvx2(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    A - Supplies the address of the packed matrix A. The rows of the packed
+        matrix are PackedCountK elements apart.
+
+    B - Supplies the address of the packed matrix B. Each block of 16 columns
+        is PackedCountK * 16 elements apart.
+
+    C - Supplies the address of matrix C.
+
+    PackedCountK - Supplies the number of packed columns of matrix A and the
+        number of packed rows of matrix B.
+
+    CountM - Supplies the number of rows of matrix A and matrix C.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ZeroMode - Supplies true if the output matrix is overwritten, else false
+        if the results are accumulated into the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountN > 0) {
+
+        const size_t CountNBlock = std::min(CountN, size_t(MLAS_QGEMM_PACKED_COLUMNS));
+
+        const int16_t* a = A;
+        int32_t* c = C;
+        size_t RowsRemaining = CountM;
+
+        while (RowsRemaining >= 4) {
+            MlasQgemmKernelAvx2Block<4>(a, B, c, PackedCountK, CountNBlock, ldc, ZeroMode);
+            a += 4 * PackedCountK;
+            c += 4 * ldc;
+            RowsRemaining -= 4;
+        }
+
+        while (RowsRemaining > 0) {
+            MlasQgemmKernelAvx2Block<1>(a, B, c, PackedCountK, CountNBlock, ldc, ZeroMode);
+            a += PackedCountK;
+            c += ldc;
+            RowsRemaining -= 1;
+        }
+
+        B += PackedCountK * MLAS_QGEMM_PACKED_COLUMNS;
+        C += MLAS_QGEMM_PACKED_COLUMNS;
+        CountN -= CountNBlock;
+    }
+}
@@ -0,0 +1,167 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_kernel_avx512.h
+
+Abstract:
+
+    This module implements the common kernel code for the quantized integer
+    matrix/matrix multiply operation (QGEMM) using AVX512 instructions.
+
+    The multiply/accumulate step is supplied by the including module so that
+    the same code can be compiled for AVX512BW and for the AVX512 vector
+    neural network instructions (VNNI).
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+template<size_t RowCount, typename MultiplyAdd>
+inline
+void
+MlasQgemmKernelAvx512Block(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of up to 16 columns of the output matrix for
+    the specified number of rows.
+
+Arguments:
+
+    A - Supplies the address of the packed matrix A.
+
+    B - Supplies the address of the packed block of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    PackedCountK - Supplies the number of packed columns of matrix A and the
+        number of packed rows of matrix B.
+
+    CountN - Supplies the number of columns of matrix C to store.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ZeroMode - Supplies true if the output matrix is overwritten, else false
+        if the results are accumulated into the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    __m512i Accumulators[RowCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r] = _mm512_setzero_si512();
+    }
+
+    for (size_t k = 0; k < PackedCountK; k += 2) {
+
+        __m512i BElements = _mm512_loadu_si512(B);
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            int32_t PairValue;
+            memcpy(&PairValue, &A[r * PackedCountK + k], sizeof(int32_t));
+
+            Accumulators[r] = MultiplyAdd::Apply(Accumulators[r], _mm512_set1_epi32(PairValue), BElements);
+        }
+
+        B += MLAS_QGEMM_PACKED_COLUMNS * 2;
+    }
+
+    const __mmask16 StoreMask = __mmask16((1u << CountN) - 1);
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        int32_t* c = C + r * ldc;
+
+        if (!ZeroMode) {
+            Accumulators[r] = _mm512_add_epi32(Accumulators[r], _mm512_maskz_loadu_epi32(StoreMask, c));
+        }
+
+        _mm512_mask_storeu_epi32(c, StoreMask, Accumulators[r]);
+    }
+}
+
+template<typename MultiplyAdd>
+inline
+void
+MlasQgemmKernelAvx512(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    See MlasQgemmKernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountN > 0) {
+
+        const size_t CountNBlock = std::min(CountN, size_t(MLAS_QGEMM_PACKED_COLUMNS));
+
+        const int16_t* a = A;
+        int32_t* c = C;
+        size_t RowsRemaining = CountM;
+
+        while (RowsRemaining >= 8) {
+            MlasQgemmKernelAvx512Block<8, MultiplyAdd>(a, B, c, PackedCountK, CountNBlock, ldc, ZeroMode);
+            a += 8 * PackedCountK;
+            c += 8 * ldc;
+            RowsRemaining -= 8;
+        }
+
+        if (RowsRemaining >= 4) {
+            MlasQgemmKernelAvx512Block<4, MultiplyAdd>(a, B, c, PackedCountK, CountNBlock, ldc, ZeroMode);
+            a += 4 * PackedCountK;
+            c += 4 * ldc;
+            RowsRemaining -= 4;
+        }
+
+        while (RowsRemaining > 0) {
+            MlasQgemmKernelAvx512Block<1, MultiplyAdd>(a, B, c, PackedCountK, CountNBlock, ldc, ZeroMode);
+            a += PackedCountK;
+            c += ldc;
+            RowsRemaining -= 1;
+        }
+
+        B += PackedCountK * MLAS_QGEMM_PACKED_COLUMNS;
+        C += MLAS_QGEMM_PACKED_COLUMNS;
+        CountN -= CountNBlock;
+    }
+}
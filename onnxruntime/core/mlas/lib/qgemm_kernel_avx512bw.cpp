@@ -0,0 +1,49 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_kernel_avx512bw.cpp
+
+Abstract:
+
+    This module implements the kernel for the quantized integer matrix/matrix
+    multiply operation (QGEMM) using AVX512BW instructions.
+
+--*/
+
+#include "qgemm_kernel_avx512.h"
+
+struct MLAS_QGEMM_MULTIPLY_ADD_AVX512BW
+{
+    static
+    __m512i
+    Apply(
+        __m512i Accumulator,
+        __m512i APair,
+        __m512i BElements
+        )
+    {
+        return _mm512_add_epi32(Accumulator, _mm512_madd_epi16(APair, BElements));
+    }
+};
+
+void
+MLASCALL
+MlasQgemmKernelAvx512BW(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    MlasQgemmKernelAvx512<MLAS_QGEMM_MULTIPLY_ADD_AVX512BW>(A, B, C, PackedCountK,
+        CountM, CountN, ldc, ZeroMode);
+}
@@ -0,0 +1,456 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    quantize.cpp
+
+Abstract:
+
+    This module implements routines to quantize and dequantize buffers of
+    8-bit integers using a linear scale and zero point. This module also
+    implements the routine to requantize the 32-bit accumulators produced by
+    the quantized integer matrix multiply to 8-bit integers.
+
+    Quantization rounds halfway cases away from zero to match the behavior
+    of the QuantizeLinear operator.
+
+--*/
+
+#include "mlasi.h"
+#include <cmath>
+
+inline
+MLAS_INT32X4
+MlasQuantizeRoundFloat32x4(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine rounds the supplied vector to the nearest integer, rounding
+    halfway cases away from zero.
+
+    The vector is truncated and then adjusted by one if the discarded
+    fraction is at least one half, which avoids the double rounding of the
+    naive "add one half then truncate" approach.
+
+Arguments:
+
+    Vector - Supplies the vector to round. The elements must be within the
+        range of a 32-bit signed integer.
+
+Return Value:
+
+    Returns the rounded vector.
+
+--*/
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    int32x4_t IntegerVector = vcvtq_s32_f32(Vector);
+    float32x4_t Fraction = vsubq_f32(Vector, vcvtq_f32_s32(IntegerVector));
+
+    IntegerVector = vsubq_s32(IntegerVector, vreinterpretq_s32_u32(vcgeq_f32(Fraction, vdupq_n_f32(0.5f))));
+    IntegerVector = vaddq_s32(IntegerVector, vreinterpretq_s32_u32(vcleq_f32(Fraction, vdupq_n_f32(-0.5f))));
+
+    return IntegerVector;
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128i IntegerVector = _mm_cvttps_epi32(Vector);
+    __m128 Fraction = _mm_sub_ps(Vector, _mm_cvtepi32_ps(IntegerVector));
+
+    IntegerVector = _mm_sub_epi32(IntegerVector, _mm_castps_si128(_mm_cmpge_ps(Fraction, _mm_set1_ps(0.5f))));
+    IntegerVector = _mm_add_epi32(IntegerVector, _mm_castps_si128(_mm_cmple_ps(Fraction, _mm_set1_ps(-0.5f))));
+
+    return IntegerVector;
+#endif
+}
+
+template<typename OutputType>
+void
+MlasQuantizePackStore8(
+    OutputType* Output,
+    MLAS_INT32X4 IntegerVector0,
+    MLAS_INT32X4 IntegerVector1
+    );
+
+template<>
+inline
+void
+MlasQuantizePackStore8<uint8_t>(
+    uint8_t* Output,
+    MLAS_INT32X4 IntegerVector0,
+    MLAS_INT32X4 IntegerVector1
+    )
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    int16x8_t WordVector = vcombine_s16(vmovn_s32(IntegerVector0), vmovn_s32(IntegerVector1));
+    vst1_u8(Output, vqmovun_s16(WordVector));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128i WordVector = _mm_packs_epi32(IntegerVector0, IntegerVector1);
+    _mm_storel_epi64((__m128i*)Output, _mm_packus_epi16(WordVector, WordVector));
+#endif
+}
+
+template<>
+inline
+void
+MlasQuantizePackStore8<int8_t>(
+    int8_t* Output,
+    MLAS_INT32X4 IntegerVector0,
+    MLAS_INT32X4 IntegerVector1
+    )
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    int16x8_t WordVector = vcombine_s16(vmovn_s32(IntegerVector0), vmovn_s32(IntegerVector1));
+    vst1_s8(Output, vqmovn_s16(WordVector));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128i WordVector = _mm_packs_epi32(IntegerVector0, IntegerVector1);
+    _mm_storel_epi64((__m128i*)Output, _mm_packs_epi16(WordVector, WordVector));
+#endif
+}
+
+template<typename InputType>
+void
+MlasDequantizeLoad8(
+    const InputType* Input,
+    MLAS_INT32X4* IntegerVector0,
+    MLAS_INT32X4* IntegerVector1
+    );
+
+template<>
+inline
+void
+MlasDequantizeLoad8<uint8_t>(
+    const uint8_t* Input,
+    MLAS_INT32X4* IntegerVector0,
+    MLAS_INT32X4* IntegerVector1
+    )
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    uint16x8_t WordVector = vmovl_u8(vld1_u8(Input));
+    *IntegerVector0 = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(WordVector)));
+    *IntegerVector1 = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(WordVector)));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128i ZeroVector = _mm_setzero_si128();
+    __m128i WordVector = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)Input), ZeroVector);
+    *IntegerVector0 = _mm_unpacklo_epi16(WordVector, ZeroVector);
+    *IntegerVector1 = _mm_unpackhi_epi16(WordVector, ZeroVector);
+#endif
+}
+
+template<>
+inline
+void
+MlasDequantizeLoad8<int8_t>(
+    const int8_t* Input,
+    MLAS_INT32X4* IntegerVector0,
+    MLAS_INT32X4* IntegerVector1
+    )
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    int16x8_t WordVector = vmovl_s8(vld1_s8(Input));
+    *IntegerVector0 = vmovl_s16(vget_low_s16(WordVector));
+    *IntegerVector1 = vmovl_s16(vget_high_s16(WordVector));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128i ByteVector = _mm_loadl_epi64((const __m128i*)Input);
+    __m128i WordVector = _mm_srai_epi16(_mm_unpacklo_epi8(ByteVector, ByteVector), 8);
+    *IntegerVector0 = _mm_srai_epi32(_mm_unpacklo_epi16(WordVector, WordVector), 16);
+    *IntegerVector1 = _mm_srai_epi32(_mm_unpackhi_epi16(WordVector, WordVector), 16);
+#endif
+}
+
+template<typename OutputType>
+void
+MLASCALL
+MlasQuantizeLinear(
+    const float* Input,
+    OutputType* Output,
+    size_t N,
+    float Scale,
+    OutputType ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine quantizes the input buffer using the supplied quantization
+    parameters.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Scale - Supplies the quantization scale.
+
+    ZeroPoint - Supplies the quantization zero point value.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // The value is clamped before rounding so that the conversion to integer
+    // cannot overflow. The clamp bounds are integers, so clamping does not
+    // change the rounded result.
+    //
+
+    const float MinimumValue = float(int32_t(std::numeric_limits<OutputType>::lowest()) - int32_t(ZeroPoint));
+    const float MaximumValue = float(int32_t(std::numeric_limits<OutputType>::max()) - int32_t(ZeroPoint));
+
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+    MLAS_FLOAT32X4 MinimumValueVector = MlasBroadcastFloat32x4(MinimumValue);
+    MLAS_FLOAT32X4 MaximumValueVector = MlasBroadcastFloat32x4(MaximumValue);
+    MLAS_INT32X4 ZeroPointVector = MlasBroadcastInt32x4(ZeroPoint);
+
+    while (N >= 8) {
+
+        MLAS_FLOAT32X4 FloatVector0 = MlasDivideFloat32x4(MlasLoadFloat32x4(Input), ScaleVector);
+        MLAS_FLOAT32X4 FloatVector1 = MlasDivideFloat32x4(MlasLoadFloat32x4(Input + 4), ScaleVector);
+
+        FloatVector0 = MlasMinimumFloat32x4(MlasMaximumFloat32x4(FloatVector0, MinimumValueVector), MaximumValueVector);
+        FloatVector1 = MlasMinimumFloat32x4(MlasMaximumFloat32x4(FloatVector1, MinimumValueVector), MaximumValueVector);
+
+        MLAS_INT32X4 IntegerVector0 = MlasAddInt32x4(MlasQuantizeRoundFloat32x4(FloatVector0), ZeroPointVector);
+        MLAS_INT32X4 IntegerVector1 = MlasAddInt32x4(MlasQuantizeRoundFloat32x4(FloatVector1), ZeroPointVector);
+
+        MlasQuantizePackStore8(Output, IntegerVector0, IntegerVector1);
+
+        Input += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    while (N > 0) {
+
+        float FloatValue = std::min(std::max(*Input / Scale, MinimumValue), MaximumValue);
+
+        *Output = OutputType(int32_t(std::round(FloatValue)) + int32_t(ZeroPoint));
+
+        Input += 1;
+        Output += 1;
+        N -= 1;
+    }
+}
+
+template<typename InputType>
+void
+MLASCALL
+MlasDequantizeLinear(
+    const InputType* Input,
+    float* Output,
+    size_t N,
+    float Scale,
+    InputType ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes the input buffer using the supplied quantization
+    parameters.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Scale - Supplies the quantization scale.
+
+    ZeroPoint - Supplies the quantization zero point value.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+    MLAS_INT32X4 ZeroPointVector = MlasBroadcastInt32x4(ZeroPoint);
+
+    while (N >= 8) {
+
+        MLAS_INT32X4 IntegerVector0;
+        MLAS_INT32X4 IntegerVector1;
+
+        MlasDequantizeLoad8(Input, &IntegerVector0, &IntegerVector1);
+
+        IntegerVector0 = MlasSubtractInt32x4(IntegerVector0, ZeroPointVector);
+        IntegerVector1 = MlasSubtractInt32x4(IntegerVector1, ZeroPointVector);
+
+        MlasStoreFloat32x4(Output, MlasMultiplyFloat32x4(MlasCastToFloat32x4(IntegerVector0), ScaleVector));
+        MlasStoreFloat32x4(Output + 4, MlasMultiplyFloat32x4(MlasCastToFloat32x4(IntegerVector1), ScaleVector));
+
+        Input += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    while (N > 0) {
+
+        *Output = float(int32_t(*Input) - int32_t(ZeroPoint)) * Scale;
+
+        Input += 1;
+        Output += 1;
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasRequantizeOutput(
+    const int32_t* Input,
+    uint8_t* Output,
+    const int32_t* Bias,
+    size_t M,
+    size_t N,
+    const float* Scale,
+    bool PerRowScale,
+    uint8_t ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine requantizes the 32-bit accumulators of a quantized integer
+    matrix multiply to unsigned 8-bit values: the optional per-row bias is
+    added, the result is multiplied by the scale, rounded and offset by the
+    output zero point.
+
+Arguments:
+
+    Input - Supplies the input matrix. The rows are N elements apart.
+
+    Output - Supplies the output matrix. The rows are N elements apart.
+
+    Bias - Optionally supplies the bias vector with M elements.
+
+    M - Supplies the number of rows.
+
+    N - Supplies the number of columns.
+
+    Scale - Supplies the address of the scale. If PerRowScale is true, this
+        is a vector of M elements, else a single value applied to all rows.
+
+    PerRowScale - Supplies true if each row uses its own scale.
+
+    ZeroPoint - Supplies the output zero point value.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float MinimumValue = float(0 - int32_t(ZeroPoint));
+    const float MaximumValue = float(255 - int32_t(ZeroPoint));
+
+    MLAS_FLOAT32X4 MinimumValueVector = MlasBroadcastFloat32x4(MinimumValue);
+    MLAS_FLOAT32X4 MaximumValueVector = MlasBroadcastFloat32x4(MaximumValue);
+    MLAS_INT32X4 ZeroPointVector = MlasBroadcastInt32x4(ZeroPoint);
+
+    for (size_t m = 0; m < M; m++) {
+
+        const float RowScale = Scale[PerRowScale ? m : 0];
+        const int32_t RowBias = (Bias != nullptr) ? Bias[m] : 0;
+
+        MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(RowScale);
+        MLAS_INT32X4 BiasVector = MlasBroadcastInt32x4(RowBias);
+
+        size_t n = N;
+
+        while (n >= 8) {
+
+            MLAS_INT32X4 IntegerVector0 = MlasAddInt32x4(MlasLoadInt32x4(Input), BiasVector);
+            MLAS_INT32X4 IntegerVector1 = MlasAddInt32x4(MlasLoadInt32x4(Input + 4), BiasVector);
+
+            MLAS_FLOAT32X4 FloatVector0 = MlasMultiplyFloat32x4(MlasCastToFloat32x4(IntegerVector0), ScaleVector);
+            MLAS_FLOAT32X4 FloatVector1 = MlasMultiplyFloat32x4(MlasCastToFloat32x4(IntegerVector1), ScaleVector);
+
+            FloatVector0 = MlasMinimumFloat32x4(MlasMaximumFloat32x4(FloatVector0, MinimumValueVector), MaximumValueVector);
+            FloatVector1 = MlasMinimumFloat32x4(MlasMaximumFloat32x4(FloatVector1, MinimumValueVector), MaximumValueVector);
+
+            IntegerVector0 = MlasAddInt32x4(MlasQuantizeRoundFloat32x4(FloatVector0), ZeroPointVector);
+            IntegerVector1 = MlasAddInt32x4(MlasQuantizeRoundFloat32x4(FloatVector1), ZeroPointVector);
+
+            MlasQuantizePackStore8(Output, IntegerVector0, IntegerVector1);
+
+            Input += 8;
+            Output += 8;
+            n -= 8;
+        }
+
+        while (n > 0) {
+
+            float FloatValue = float(*Input + RowBias) * RowScale;
+
+            FloatValue = std::min(std::max(FloatValue, MinimumValue), MaximumValue);
+
+            *Output = uint8_t(int32_t(std::round(FloatValue)) + int32_t(ZeroPoint));
+
+            Input += 1;
+            Output += 1;
+            n -= 1;
+        }
+    }
+}
+
+//
+// Explicit instantiations of the quantization routines.
+//
+
+template
+void
+MLASCALL
+MlasQuantizeLinear<uint8_t>(
+    const float* Input,
+    uint8_t* Output,
+    size_t N,
+    float Scale,
+    uint8_t ZeroPoint
+    );
+
+template
+void
+MLASCALL
+MlasQuantizeLinear<int8_t>(
+    const float* Input,
+    int8_t* Output,
+    size_t N,
+    float Scale,
+    int8_t ZeroPoint
+    );
+
+template
+void
+MLASCALL
+MlasDequantizeLinear<uint8_t>(
+    const uint8_t* Input,
+    float* Output,
+    size_t N,
+    float Scale,
+    uint8_t ZeroPoint
+    );
+
+template
+void
+MLASCALL
+MlasDequantizeLinear<int8_t>(
+    const int8_t* Input,
+    float* Output,
+    size_t N,
+    float Scale,
+    int8_t ZeroPoint
+    );
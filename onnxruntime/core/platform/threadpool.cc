@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/platform/threadpool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4267)
+#endif
+#include <unsupported/Eigen/CXX11/ThreadPool>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+namespace onnxruntime {
+namespace concurrency {
+
+namespace {
+
+// Minimum estimated cost, in cycles, of a block of iterations before it is worth handing
+// to another thread. Waking a pool thread costs on the order of a few microseconds.
+constexpr double kMinCostPerBlock = 10000;
+
+// Number of blocks created per participating thread so that uneven blocks balance out.
+constexpr std::ptrdiff_t kBlocksPerThread = 4;
+
+// State shared between the thread calling ParallelFor and the helper tasks. Helpers that are
+// scheduled after all blocks have been claimed may still reference it, so it is reference counted.
+struct ParallelForState {
+  std::ptrdiff_t total;
+  std::ptrdiff_t block_size;
+  std::ptrdiff_t num_blocks;
+  const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>* fn;
+
+  std::atomic<std::ptrdiff_t> next_block{0};
+  std::atomic<std::ptrdiff_t> finished_blocks{0};
+
+  std::mutex mutex;
+  std::condition_variable done;
+  std::exception_ptr error;
+
+  // Claim and run blocks until none are left.
+  void RunBlocks() {
+    for (;;) {
+      const std::ptrdiff_t block = next_block.fetch_add(1);
+      if (block >= num_blocks) {
+        return;
+      }
+
+      const std::ptrdiff_t first = block * block_size;
+      const std::ptrdiff_t last = std::min(total, first + block_size);
+      try {
+        (*fn)(first, last);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+
+      if (finished_blocks.fetch_add(1) + 1 == num_blocks) {
+        std::lock_guard<std::mutex> lock(mutex);
+        done.notify_all();
+      }
+    }
+  }
+};
+
+}  // namespace
+
+class ThreadPool::Impl : public Eigen::NonBlockingThreadPool {
+ public:
+  explicit Impl(int num_threads) : Eigen::NonBlockingThreadPool(num_threads) {}
+};
+
+ThreadPool::ThreadPool(const std::string& name, int num_threads)
+    : impl_(std::make_unique<Impl>(num_threads)) {
+  ORT_UNUSED_PARAMETER(name);
+}
+
+ThreadPool::~ThreadPool() = default;
+
+void ThreadPool::Schedule(std::function<void()> fn) {
+  impl_->Schedule(std::move(fn));
+}
+
+int ThreadPool::NumThreads() const {
+  return impl_->NumThreads();
+}
+
+std::ptrdiff_t ThreadPool::ComputeNumBlocks(int num_threads, std::ptrdiff_t total, double cost_per_unit) {
+  if (total <= 1 || num_threads <= 0) {
+    return 1;
+  }
+
+  const double total_cost = static_cast<double>(total) * std::max(cost_per_unit, 1.0);
+  const double blocks_by_cost = total_cost / kMinCostPerBlock;
+  const std::ptrdiff_t max_blocks = std::min<std::ptrdiff_t>(total, (num_threads + 1) * kBlocksPerThread);
+
+  if (blocks_by_cost >= static_cast<double>(max_blocks)) {
+    return max_blocks;
+  }
+  return std::max<std::ptrdiff_t>(1, static_cast<std::ptrdiff_t>(blocks_by_cost));
+}
+
+void ThreadPool::ParallelFor(std::ptrdiff_t total, double cost_per_unit,
+                             const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
+  if (total <= 0) {
+    return;
+  }
+
+  std::ptrdiff_t num_blocks = ComputeNumBlocks(NumThreads(), total, cost_per_unit);
+  if (num_blocks == 1) {
+    fn(0, total);
+    return;
+  }
+
+  auto state = std::make_shared<ParallelForState>();
+  state->total = total;
+  state->block_size = (total + num_blocks - 1) / num_blocks;
+  // rounding the block size up may leave trailing blocks empty
+  state->num_blocks = (total + state->block_size - 1) / state->block_size;
+  state->fn = &fn;
+
+  const std::ptrdiff_t num_helpers = std::min<std::ptrdiff_t>(state->num_blocks - 1, NumThreads());
+  for (std::ptrdiff_t i = 0; i < num_helpers; ++i) {
+    impl_->Schedule([state]() { state->RunBlocks(); });
+  }
+
+  state->RunBlocks();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done.wait(lock, [&state]() { return state->finished_blocks.load() == state->num_blocks; });
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
+
+void ThreadPool::TryParallelFor(ThreadPool* tp, std::ptrdiff_t total, double cost_per_unit,
+                                const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
+  if (tp == nullptr) {
+    if (total > 0) {
+      fn(0, total);
+    }
+    return;
+  }
+  tp->ParallelFor(total, cost_per_unit, fn);
+}
+
+}  // namespace concurrency
+}  // namespace onnxruntime
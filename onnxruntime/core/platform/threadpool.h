@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace concurrency {
+
+/**
+ * Thread pool used by the CPU kernels to parallelize loops.
+ *
+ * ParallelFor splits a loop into blocks sized from the estimated cost of one iteration and
+ * runs them on the pool threads and on the calling thread. The calling thread always takes
+ * part in the work and never waits for a block that hasn't been started, so loops can be
+ * nested or issued from tasks running on the same pool without deadlocking.
+ */
+class ThreadPool {
+ public:
+  /**
+   * Create a pool with num_threads worker threads.
+   * The name is used to identify the pool's threads when debugging.
+   */
+  ThreadPool(const std::string& name, int num_threads);
+  ~ThreadPool();
+
+  /** Run fn on one of the pool threads. */
+  void Schedule(std::function<void()> fn);
+
+  /** Number of worker threads, not counting the threads that call ParallelFor. */
+  int NumThreads() const;
+
+  /**
+   * Call fn(first, last) on disjoint ranges covering [0, total).
+   * @param cost_per_unit Approximate number of CPU cycles spent on one iteration. Loops
+   *        whose total cost is too small to amortize the scheduling overhead run inline.
+   * Returns once every range has been processed. If fn throws, the first exception is
+   * rethrown on the calling thread.
+   */
+  void ParallelFor(std::ptrdiff_t total, double cost_per_unit,
+                   const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
+
+  /**
+   * ParallelFor on tp, or a single inline call fn(0, total) if tp is nullptr.
+   */
+  static void TryParallelFor(ThreadPool* tp, std::ptrdiff_t total, double cost_per_unit,
+                             const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
+
+  /**
+   * Number of blocks ParallelFor would split a loop into on a pool with num_threads threads.
+   * Exposed so the block sizing can be tested independently of thread scheduling.
+   */
+  static std::ptrdiff_t ComputeNumBlocks(int num_threads, std::ptrdiff_t total, double cost_per_unit);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPool);
+};
+
+}  // namespace concurrency
+}  // namespace onnxruntime
@@ -4,6 +4,9 @@
 #include "core/providers/cpu/activation/activations.h"
 #include "core/mlas/inc/mlas.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace onnxruntime {
 
 #define REGISTER_UNARY_ELEMENTWISE_KERNEL_ALIAS(alias, x, sinceVersion)                              \
@@ -30,6 +33,82 @@ REGISTER_UNARY_ELEMENTWISE_KERNEL(Softsign, 1);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(Tanh, 6);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ThresholdedRelu, 1);
 
+// The exponential activations may run in place, so the intermediate values are
+// computed in blocks through a buffer on the stack instead of the output.
+static constexpr int64_t kActivationBlockSize = 256;
+
+template <>
+Status Elu<float>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& x_shape = X->Shape();
+  Tensor* Y = context->Output(0, x_shape);
+  const float* x = X->template Data<float>();
+  float* y = Y->template MutableData<float>();
+  float buffer[kActivationBlockSize];
+  for (int64_t remaining = x_shape.Size(); remaining > 0;) {
+    const int64_t count = std::min(remaining, kActivationBlockSize);
+    MlasComputeExp(x, buffer, static_cast<size_t>(count));
+    for (int64_t i = 0; i < count; i++) {
+      y[i] = x[i] >= 0 ? x[i] : alpha_ * (buffer[i] - 1.0f);
+    }
+    x += count;
+    y += count;
+    remaining -= count;
+  }
+  return Status::OK();
+}
+
+template <>
+Status ParametricSoftplus<float>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& x_shape = X->Shape();
+  Tensor* Y = context->Output(0, x_shape);
+  const float* x = X->template Data<float>();
+  float* y = Y->template MutableData<float>();
+  float buffer[kActivationBlockSize];
+  for (int64_t remaining = x_shape.Size(); remaining > 0;) {
+    const int64_t count = std::min(remaining, kActivationBlockSize);
+    // softplus(z) = max(z, 0) + log(1 + exp(-|z|)), which cannot overflow for large |z|.
+    for (int64_t i = 0; i < count; i++) {
+      buffer[i] = -std::abs(x[i] * beta_);
+    }
+    MlasComputeExp(buffer, buffer, static_cast<size_t>(count));
+    for (int64_t i = 0; i < count; i++) {
+      buffer[i] += 1.0f;
+    }
+    MlasComputeLog(buffer, buffer, static_cast<size_t>(count));
+    for (int64_t i = 0; i < count; i++) {
+      y[i] = alpha_ * (std::max(x[i] * beta_, 0.0f) + buffer[i]);
+    }
+    x += count;
+    y += count;
+    remaining -= count;
+  }
+  return Status::OK();
+}
+
+template <>
+Status Selu<float>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& x_shape = X->Shape();
+  Tensor* Y = context->Output(0, x_shape);
+  const float* x = X->template Data<float>();
+  float* y = Y->template MutableData<float>();
+  const float gamma_alpha = gamma_ * alpha_;
+  float buffer[kActivationBlockSize];
+  for (int64_t remaining = x_shape.Size(); remaining > 0;) {
+    const int64_t count = std::min(remaining, kActivationBlockSize);
+    MlasComputeExp(x, buffer, static_cast<size_t>(count));
+    for (int64_t i = 0; i < count; i++) {
+      y[i] = x[i] > 0 ? gamma_ * x[i] : gamma_alpha * (buffer[i] - 1.0f);
+    }
+    x += count;
+    y += count;
+    remaining -= count;
+  }
+  return Status::OK();
+}
+
 template <>
 Status Sigmoid<float>::Compute(OpKernelContext* context) const {
   const Tensor* X = context->Input<Tensor>(0);
@@ -31,6 +31,9 @@ class Elu final : public OpKernel {
   const float alpha_;
 };
 
+template <>
+Status Elu<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class HardSigmoid final : public OpKernel {
  public:
@@ -89,6 +92,9 @@ class ParametricSoftplus final : public OpKernel {
   const float beta_;
 };
 
+template <>
+Status ParametricSoftplus<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class Relu : public OpKernel {
  public:
@@ -142,6 +148,9 @@ class Selu final : public OpKernel {
   const float gamma_;
 };
 
+template <>
+Status Selu<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class Sigmoid final : public OpKernel {
  public:
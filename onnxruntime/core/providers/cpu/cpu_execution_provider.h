@@ -14,6 +14,9 @@ namespace onnxruntime {
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
 
+  // time the convolution algorithms on the first run of each input shape and keep the fastest
+  bool enable_conv_autotune{false};
+
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
   CPUExecutionProviderInfo() = default;
@@ -24,7 +27,8 @@ using FuseRuleFn = std::function<void(const onnxruntime::GraphViewer&, std::vect
 // Logical device representation.
 class CPUExecutionProvider : public IExecutionProvider {
  public:
-  explicit CPUExecutionProvider(const CPUExecutionProviderInfo& info) {
+  explicit CPUExecutionProvider(const CPUExecutionProviderInfo& info)
+      : enable_conv_autotune_(info.enable_conv_autotune) {
     DeviceAllocatorRegistrationInfo device_info({OrtMemTypeDefault, [](int) { return std::make_unique<CPUAllocator>(); }, std::numeric_limits<size_t>::max()});
 #ifdef USE_JEMALLOC
     ORT_UNUSED_PARAMETER(info);
@@ -74,7 +78,14 @@ class CPUExecutionProvider : public IExecutionProvider {
 
   void InsertFusedRules(FuseRuleFn rule);
 
+  bool IsConvAutotuneEnabled() const noexcept {
+    return enable_conv_autotune_;
+  }
+
  protected:
   std::vector<FuseRuleFn> fuse_rules_;
+
+ private:
+  const bool enable_conv_autotune_;
 };
 }  // namespace onnxruntime
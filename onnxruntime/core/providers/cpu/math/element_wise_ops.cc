@@ -2,7 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/element_wise_ops.h"
-#include <unsupported/Eigen/SpecialFunctions>
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -13,6 +13,13 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Add<float>);
 
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Add,
+    7,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Add<MLFloat16>);
+
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Add,
     7,
@@ -34,6 +41,13 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Sub<float>);
 
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Sub,
+    7,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Sub<MLFloat16>);
+
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Sub,
     7,
@@ -55,6 +69,13 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Mul<float>);
 
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Mul,
+    7,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Mul<MLFloat16>);
+
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Mul,
     7,
@@ -83,6 +104,13 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Div<float>);
 
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Div,
+    7,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Div<MLFloat16>);
+
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Div,
     7,
@@ -354,6 +382,42 @@ Status Div<T>::Compute(OpKernelContext* context) const {
       [](EigenVectorMap<T> output, ConstEigenVectorMap<T> input0, ConstEigenVectorMap<T> input1) { output = input0.cwiseQuotient(input1); });
 }
 
+template <>
+Status Add<MLFloat16>::Compute(OpKernelContext* context) const {
+  return BroadcastTwoFloat16(
+      *context,
+      [](EigenVectorMap<float> output, float input0, ConstEigenVectorMap<float> input1) { output = input0 + input1.array(); },
+      [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, float input1) { output = input0.array() + input1; },
+      [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, ConstEigenVectorMap<float> input1) { output = input0 + input1; });
+}
+
+template <>
+Status Sub<MLFloat16>::Compute(OpKernelContext* context) const {
+  return BroadcastTwoFloat16(
+      *context,
+      [](EigenVectorMap<float> output, float input0, ConstEigenVectorMap<float> input1) { output = input0 - input1.array(); },
+      [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, float input1) { output = input0.array() - input1; },
+      [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, ConstEigenVectorMap<float> input1) { output = input0 - input1; });
+}
+
+template <>
+Status Mul<MLFloat16>::Compute(OpKernelContext* context) const {
+  return BroadcastTwoFloat16(
+      *context,
+      [](EigenVectorMap<float> output, float input0, ConstEigenVectorMap<float> input1) { output = input0 * input1.array(); },
+      [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, float input1) { output = input0.array() * input1; },
+      [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, ConstEigenVectorMap<float> input1) { output = input0.cwiseProduct(input1); });
+}
+
+template <>
+Status Div<MLFloat16>::Compute(OpKernelContext* context) const {
+  return BroadcastTwoFloat16(
+      *context,
+      [](EigenVectorMap<float> output, float input0, ConstEigenVectorMap<float> input1) { output = input0 / input1.array(); },
+      [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, float input1) { output = input0.array() / input1; },
+      [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, ConstEigenVectorMap<float> input1) { output = input0.cwiseQuotient(input1); });
+}
+
 template <>
 Status Floor<float>::Compute(OpKernelContext* ctx) const {
   auto& X = *ctx->Input<Tensor>(0);
@@ -420,7 +484,7 @@ Status Exp<float>::Compute(OpKernelContext* ctx) const {
   auto& X = *ctx->Input<Tensor>(0);
   auto& Y = *ctx->Output(0, X.Shape());
 
-  EigenMap<float>(Y) = EigenMap<float>(X).array().exp();
+  MlasComputeExp(X.template Data<float>(), Y.template MutableData<float>(), X.Shape().Size());
 
   return Status::OK();
 }
@@ -430,7 +494,7 @@ Status Log<float>::Compute(OpKernelContext* ctx) const {
   auto& X = *ctx->Input<Tensor>(0);
   auto& Y = *ctx->Output(0, X.Shape());
 
-  EigenMap<float>(Y) = EigenMap<float>(X).array().log();
+  MlasComputeLog(X.template Data<float>(), Y.template MutableData<float>(), X.Shape().Size());
 
   return Status::OK();
 }
@@ -1022,7 +1086,7 @@ Status Erf<float>::Compute(OpKernelContext* context) const {
   ORT_ENFORCE(X_ptr != nullptr);
   auto& X = *X_ptr;
   auto& Y = *context->Output(0, X.Shape());
-  EigenMap<float>(Y) = EigenMap<float>(X).array().erf();
+  MlasComputeErf(X.template Data<float>(), Y.template MutableData<float>(), X.Shape().Size());
 
   return Status::OK();
 }
@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/float16_util.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -594,6 +595,27 @@ Status BroadcastTwo(OpKernelContext& context, Input0Scalar input0scalar, Input1S
   return Status::OK();
 }
 
+// Broadcast loop for float16 tensors that are computed in float. The inputs are converted to float once, the
+// functions take the same forms as for BroadcastTwo<float, float> and the output is rounded to float16 once.
+template <typename Input0Scalar, typename Input1Scalar, typename General>
+Status BroadcastTwoFloat16(OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context.GetTempSpaceAllocator(&allocator));
+
+  auto input0 = ConvertFloat16TensorToFloat(*context.Input<Tensor>(0), allocator);
+  auto input1 = ConvertFloat16TensorToFloat(*context.Input<Tensor>(1), allocator);
+
+  TBroadcaster<float> bc(*input0, *input1);
+  Tensor& Y = *context.Output(0, bc.GetOutputShape());
+  auto Y_float = AllocateFloatTensor(Y.Shape(), allocator);
+  TBroadcastOutput<float> output(bc.GetSpanSize(), *Y_float);
+  BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+
+  ConvertFloatTensorToFloat16(*Y_float, Y);
+
+  return Status::OK();
+}
+
 template <typename TInput, typename TOutput, typename Input0Scalar, typename Input1Scalar, typename General>
 Status BroadcastVariadic(const Node& node, OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
   auto input_count = node.InputArgCount().front();
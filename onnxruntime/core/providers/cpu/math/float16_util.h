@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+
+// Helpers for kernels that store float16 tensors but compute in float. The float tensors are allocated from the
+// supplied allocator, normally the kernel's temp space allocator, and are released when they go out of scope.
+
+inline std::unique_ptr<Tensor> AllocateFloatTensor(const TensorShape& shape, const AllocatorPtr& allocator) {
+  return std::make_unique<Tensor>(DataTypeImpl::GetType<float>(),
+                                  shape,
+                                  allocator->Alloc(sizeof(float) * shape.Size()),
+                                  allocator->Info(),
+                                  allocator);
+}
+
+inline std::unique_ptr<Tensor> ConvertFloat16TensorToFloat(const Tensor& input, const AllocatorPtr& allocator) {
+  auto output = AllocateFloatTensor(input.Shape(), allocator);
+  MlasConvertHalfToFloatBuffer(&input.template Data<MLFloat16>()[0].val,
+                               output->template MutableData<float>(),
+                               static_cast<size_t>(input.Shape().Size()));
+  return output;
+}
+
+inline void ConvertFloatTensorToFloat16(const Tensor& input, Tensor& output) {
+  ORT_ENFORCE(input.Shape() == output.Shape());
+  MlasConvertFloatToHalfBuffer(input.template Data<float>(),
+                               &output.template MutableData<MLFloat16>()[0].val,
+                               static_cast<size_t>(input.Shape().Size()));
+}
+
+}  // namespace onnxruntime
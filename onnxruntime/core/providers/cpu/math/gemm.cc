@@ -2,13 +2,61 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/gemm.h"
+#include "core/providers/cpu/math/float16_util.h"
 
 namespace onnxruntime {
 
-ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     Gemm,
     7,
     9,
+    float,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Gemm<float, float, float, float>);
-}
\ No newline at end of file
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    7,
+    9,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16, MLFloat16, MLFloat16, MLFloat16>);
+
+// The float16 inputs are converted to float and the bias and products are accumulated in float, so each output
+// element is rounded to float16 once.
+template <>
+Status Gemm<MLFloat16, MLFloat16, MLFloat16, MLFloat16>::Compute(OpKernelContext* context) const {
+  const auto X = context->Input<Tensor>(0);
+  const auto W = context->Input<Tensor>(1);
+  const auto B = context->Input<Tensor>(2);
+  GemmHelper helper(X->Shape(), trans_A_ != CblasNoTrans, W->Shape(), trans_B_ != CblasNoTrans, B->Shape());
+
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  int64_t M = helper.M();
+  int64_t N = helper.N();
+  int64_t K = helper.K();
+  auto Y = context->Output(0, TensorShape({M, N}));
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  auto X_float = ConvertFloat16TensorToFloat(*X, allocator);
+  auto W_float = ConvertFloat16TensorToFloat(*W, allocator);
+  auto B_float = ConvertFloat16TensorToFloat(*B, allocator);
+  auto Y_float = AllocateFloatTensor(Y->Shape(), allocator);
+
+  ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, beta_,
+              X_float->template Data<float>(),
+              W_float->template Data<float>(),
+              B_float->template Data<float>(),
+              B->Shape(),
+              Y_float->template MutableData<float>());
+
+  ConvertFloatTensorToFloat16(*Y_float, *Y);
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
\ No newline at end of file
@@ -11,6 +11,72 @@
 
 namespace onnxruntime {
 
+// Computes Y = alpha * op(X) * op(W) + beta * B, where B is broadcast to the (M, N) shape of Y.
+template <typename T_X,
+          typename T_W,
+          typename T_B,
+          typename T_Y>
+void ComputeGemm(CBLAS_TRANSPOSE trans_A,
+                 CBLAS_TRANSPOSE trans_B,
+                 int64_t M,
+                 int64_t N,
+                 int64_t K,
+                 float alpha,
+                 float beta,
+                 const T_X* X,
+                 const T_W* W,
+                 const T_B* B,
+                 const TensorShape& b_shape,
+                 T_Y* Y) {
+  //bias
+  // Todo: we might should move this part into math::gemm to let eigen
+  // have better chance to further optimize it.
+  if (beta != 0) {
+    auto output_mat = EigenMatrixMapRowMajor<T_Y>(Y, M, N);
+    output_mat.setZero();
+
+    // if B is (), (1,) or (1, 1), add the scalar
+    if (b_shape.Size() == 1) {
+      output_mat.array() += *B;
+    }
+    // B is (N,)
+    else if (b_shape.NumDimensions() == 1) {
+      auto bias_vec = ConstEigenVectorMap<T_B>(B, N);
+      output_mat.rowwise() += bias_vec.transpose();
+    } else if (b_shape.NumDimensions() == 2) {
+      // B is (M, 1)
+      if (b_shape[1] == 1) {
+        auto bias_vec = ConstEigenVectorMap<T_B>(B, M);
+        output_mat.colwise() += bias_vec;
+      }
+      // B is (1, N)
+      else if (b_shape[0] == 1) {
+        auto bias_vec = ConstEigenVectorMap<T_B>(B, N);
+        output_mat.rowwise() += bias_vec.transpose();
+      }
+      // B is (M, N), no broadcast needed.
+      else {
+        auto bias_mat = ConstEigenMatrixMapRowMajor<T_B>(B, M, N);
+        output_mat += bias_mat;
+      }
+    }
+  }
+
+  // W * x
+  math::Gemm<T_X, CPUMathUtil>(
+      trans_A,
+      trans_B,
+      M,
+      N,
+      K,
+      alpha,
+      X,
+      W,
+      beta,
+      Y,
+      &CPUMathUtil::Instance());
+}
+
 template <typename T_X,
           typename T_W,
           typename T_B,
@@ -43,66 +109,12 @@ class Gemm final : public OpKernel {
     int64_t K = helper.K();
     auto Y = context->Output(0, TensorShape({M, N}));
 
-    //bias
-    // Todo: we might should move this part into math::gemm to let eigen
-    // have better chance to further optimize it.
-    if (beta_ != 0) {
-      auto output_mat = EigenMatrixMapRowMajor<T_Y>(
-          Y->template MutableData<T_Y>(),
-          M,
-          N);
-      output_mat.setZero();
-
-      auto& b_shape = B->Shape();
-      // if B is (), (1,) or (1, 1), add the scalar
-      if (b_shape.Size() == 1) {
-        output_mat.array() += *(B->template Data<T_B>());
-      }
-      // B is (N,)
-      else if (b_shape.NumDimensions() == 1) {
-        auto bias_vec = ConstEigenVectorMap<T_B>(
-            B->template Data<T_B>(),
-            N);
-        output_mat.rowwise() += bias_vec.transpose();
-      } else if (b_shape.NumDimensions() == 2) {
-        // B is (M, 1)
-        if (b_shape[1] == 1) {
-          auto bias_vec = ConstEigenVectorMap<T_B>(
-              B->template Data<T_B>(),
-              M);
-          output_mat.colwise() += bias_vec;
-        }
-        // B is (1, N)
-        else if (b_shape[0] == 1) {
-          auto bias_vec = ConstEigenVectorMap<T_B>(
-              B->template Data<T_B>(),
-              N);
-          output_mat.rowwise() += bias_vec.transpose();
-        }
-        // B is (M, N), no broadcast needed.
-        else {
-          auto bias_mat = ConstEigenMatrixMapRowMajor<T_B>(
-              B->template Data<T_B>(),
-              M,
-              N);
-          output_mat += bias_mat;
-        }
-      }
-    }
-
-    // W * x
-    math::Gemm<T_X, CPUMathUtil>(
-        trans_A_,
-        trans_B_,
-        M,
-        N,
-        K,
-        alpha_,
-        X->template Data<T_X>(),
-        W->template Data<T_W>(),
-        beta_,
-        Y->template MutableData<T_Y>(),
-        &CPUMathUtil::Instance());
+    ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, beta_,
+                X->template Data<T_X>(),
+                W->template Data<T_W>(),
+                B->template Data<T_B>(),
+                B->Shape(),
+                Y->template MutableData<T_Y>());
 
     return Status::OK();
   }
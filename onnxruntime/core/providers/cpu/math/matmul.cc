@@ -3,19 +3,29 @@
 
 #include "core/providers/cpu/math/matmul.h"
 
+#include "core/providers/cpu/math/float16_util.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "matmul_helper.h"
 
 namespace onnxruntime {
 
-ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
   MatMul,
   1,
   9,
+  float,
   KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
   MatMul<float>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+  MatMul,
+  1,
+  9,
+  MLFloat16,
+  KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+  MatMul<MLFloat16>);
+
 template <>
 Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const Tensor* left_X = ctx->Input<Tensor>(0);
@@ -45,4 +55,43 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+// The float16 inputs are converted to float once, the products are accumulated in float and each output element
+// is rounded to float16 once, so the result matches a float MatMul followed by a Cast.
+template <>
+Status MatMul<MLFloat16>::Compute(OpKernelContext* ctx) const {
+  const Tensor* left_X = ctx->Input<Tensor>(0);
+  const Tensor* right_X = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(left_X->Shape(), right_X->Shape()));
+
+  Tensor* Y = ctx->Output(0, helper.OutputShape());
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+
+  auto left_float = ConvertFloat16TensorToFloat(*left_X, allocator);
+  auto right_float = ConvertFloat16TensorToFloat(*right_X, allocator);
+  auto Y_float = AllocateFloatTensor(Y->Shape(), allocator);
+
+  for (int i = 0; i < helper.OutputOffsets().size(); i++) {
+    math::Gemm<float, CPUMathUtil>(
+        CblasNoTrans,
+        CblasNoTrans,
+        static_cast<int>(helper.M()),
+        static_cast<int>(helper.N()),
+        static_cast<int>(helper.K()),
+        /* alpha */ 1.0f,
+        left_float->template Data<float>() + helper.LeftOffsets()[i],
+        right_float->template Data<float>() + helper.RightOffsets()[i],
+        /* beta */ 0.0f,
+        Y_float->template MutableData<float>() + helper.OutputOffsets()[i],
+        &CPUMathUtil::Instance());
+  }
+
+  ConvertFloatTensorToFloat16(*Y_float, *Y);
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
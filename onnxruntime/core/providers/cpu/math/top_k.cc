@@ -19,8 +19,9 @@
 #include "core/common/exceptions.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
-#include "core/util/math_cpuonly.h"
-#include <queue>
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+#include <algorithm>
 using namespace std;
 namespace onnxruntime {
 // spec https://github.com/onnx/onnx/blob/master/docs/Operators.md#TopK
@@ -30,105 +31,184 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()),
     TopK<float>);
 
-static int64_t SizeToDim(size_t k, const vector<int64_t>& dims) {
-  ORT_ENFORCE(k <= dims.size());
-  int64_t r = 1;
-  for (size_t i = 0; i < k; ++i) {
-    r *= dims[i];
-  }
-  return r;
-}
-
-// Define these two names to allow lookup into the 2d tensors like
-// mytensor(i, j)
-template <typename T>
-using EigenMatrixMapRowMajor = Eigen::Map<
-    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>;
-
-template <typename T>
-using ConstEigenMatrixMapRowMajor = Eigen::Map<
-    const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>;
-
+// Orders (value, index) pairs best first: larger values first, and the lower index first for equal values.
 template <typename T>
 struct ValueCmp {
   bool operator()(
       const pair<T, int64_t>& lhs,
-      const pair<T, int64_t>& rhs) {
+      const pair<T, int64_t>& rhs) const {
     return (
         lhs.first > rhs.first ||
         (lhs.first == rhs.first && lhs.second < rhs.second));
   }
 };
 
+// Contiguous rows are scanned in blocks of this many elements that are only looked at
+// one by one if one of them beats the smallest value kept so far.
+static constexpr int64_t kTopKFilterBlockSize = 16;
+
+// Rows shorter than this are never split across threads.
+static constexpr int64_t kTopKMinimumChunkSize = 16 * 1024;
+
+// Finds the k best elements of input[j * stride] for j in [begin, end) and stores them
+// best first in top. k must not exceed end - begin.
+template <typename T>
+static void SelectTopK(const T* input, int64_t begin, int64_t end, int64_t stride, int64_t k,
+                       vector<pair<T, int64_t>>& top) {
+  const ValueCmp<T> cmp;
+  const int64_t n = end - begin;
+  top.clear();
+
+  // When a large part of the row is kept, partitioning the whole row beats maintaining a heap.
+  if (k * 8 >= n) {
+    top.reserve(n);
+    for (int64_t j = begin; j < end; ++j) {
+      top.emplace_back(input[j * stride], j);
+    }
+    nth_element(top.begin(), top.begin() + (k - 1), top.end(), cmp);
+    top.resize(k);
+    sort(top.begin(), top.end(), cmp);
+    return;
+  }
+
+  // Otherwise keep the k best elements seen so far in a heap whose front is the worst of them. The
+  // elements are visited in index order, so an element equal to the front never replaces it.
+  top.reserve(k);
+  for (int64_t j = begin; j < begin + k; ++j) {
+    top.emplace_back(input[j * stride], j);
+  }
+  make_heap(top.begin(), top.end(), cmp);
+
+  auto push = [&](int64_t j) {
+    const T value = input[j * stride];
+    if (value > top.front().first) {
+      pop_heap(top.begin(), top.end(), cmp);
+      top.back() = {value, j};
+      push_heap(top.begin(), top.end(), cmp);
+    }
+  };
+
+  int64_t j = begin + k;
+  if (stride == 1) {
+    // Most elements of a long row cannot enter the heap, so test whole blocks against the
+    // threshold with a loop the compiler vectorizes and skip the blocks without a candidate.
+    for (; j + kTopKFilterBlockSize <= end; j += kTopKFilterBlockSize) {
+      const T threshold = top.front().first;
+      const T* block = input + j;
+      int any = 0;
+      for (int64_t b = 0; b < kTopKFilterBlockSize; ++b) {
+        any |= static_cast<int>(block[b] > threshold);
+      }
+      if (any != 0) {
+        for (int64_t b = 0; b < kTopKFilterBlockSize; ++b) {
+          push(j + b);
+        }
+      }
+    }
+  }
+  for (; j < end; ++j) {
+    push(j);
+  }
+
+  sort_heap(top.begin(), top.end(), cmp);
+}
+
 template <>
 Status TopK<float>::Compute(OpKernelContext* p_op_kernel_context) const {
   const Tensor* X = p_op_kernel_context->Input<Tensor>(0);
   if (X == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-  const vector<int64_t>& in_dims = X->Shape().GetDims();
+  const TensorShape& in_shape = X->Shape();
+  const vector<int64_t>& in_dims = in_shape.GetDims();
 
-  // Linearize input tensor except for last dimension
-  // e.g. [3, 4, 5] -> [12, 5]
-  // [5] -> [5]
-  if (in_dims.back() < k_) {
+  // The input is viewed as [outer, n, inner] around the axis, so every (outer, inner) pair is
+  // a row of n elements that are inner apart, e.g. [3, 4, 5] with axis 1 is 15 rows of 4.
+  const auto axis = static_cast<size_t>(HandleNegativeAxis(axis_, static_cast<int64_t>(in_dims.size())));
+  const int64_t n = in_dims[axis];
+  const int64_t k = k_;
+  if (n < k) {
     ostringstream err_msg;
-    err_msg << "k argment [" << k_ << "] should not be greater than last dim [" << in_dims.back() << "]";
+    err_msg << "k argment [" << k_ << "] should not be greater than axis dim [" << n << "]";
     return Status(common::ONNXRUNTIME, common::FAIL, err_msg.str());
   }
 
-  vector<int64_t> linear_shape = {SizeToDim(in_dims.size() - 1, in_dims),
-                                  in_dims[in_dims.size() - 1]};
-  auto input_map = ConstEigenMatrixMapRowMajor<float>(
-      static_cast<const float*>(X->template Data<float>()),
-      linear_shape[0],
-      linear_shape[1]);
-
-  // Resize output tensors to be the same shape as the linearized input except
-  // for the last dimension, which will be of size k. E.x. for an input tensor
-  // of shape [3, 4, 5] and k=2, both of these will be shape [3, 4, 2]
-  vector<int64_t> output_linear_shape = {linear_shape[0], k_};
-  auto* Values = p_op_kernel_context->Output(0, output_linear_shape);
-  auto* Indices = p_op_kernel_context->Output(1, output_linear_shape);
-
-  // Use Eigen maps to allow indexing into the 2d tensors like Values_map(i,j)
-  auto Values_map = EigenMatrixMapRowMajor<float>(
-      Values->template MutableData<float>(), linear_shape[0], k_);
-  auto Indices_map = EigenMatrixMapRowMajor<int64_t>(
-      Indices->template MutableData<int64_t>(), linear_shape[0], k_);
-
-  // Sort preserving Indices
-  for (int64_t i = 0; i < linear_shape[0]; ++i) {
-    // Build a min-heap, the heap element is pair of (value, idx)
-    // the top of the heap is the smallest value
-    priority_queue<
-        pair<float, int64_t>,
-        vector<pair<float, int64_t>>,
-        ValueCmp<float>>
-        min_heap;
-
-    // Maintain the size of heap to be less or equal to k_, so the
-    // heap will hold the k_ largest Values
-    for (int64_t j = 0; j < linear_shape[1]; ++j) {
-      const auto value = input_map(i, j);
-      if (min_heap.size() < k_ || value > min_heap.top().first) {
-        min_heap.push({value, j});
-      }
-      if (min_heap.size() > k_) {
-        min_heap.pop();
+  const int64_t outer = in_shape.SizeToDimension(axis);
+  const int64_t inner = in_shape.SizeFromDimension(axis + 1);
+  const int64_t rows = outer * inner;
+
+  // Output tensors have the shape of the input with the axis dimension replaced by k,
+  // e.g. [3, 4, 5] with axis 1 and k=2 gives [3, 2, 5]
+  auto out_dims = in_dims;
+  out_dims[axis] = k;
+  auto* Values = p_op_kernel_context->Output(0, out_dims);
+  auto* Indices = p_op_kernel_context->Output(1, out_dims);
+  if (rows == 0) {
+    return Status::OK();
+  }
+
+  const float* input = X->template Data<float>();
+  float* values = Values->template MutableData<float>();
+  int64_t* indices = Indices->template MutableData<int64_t>();
+
+  auto write_row = [&](int64_t row, const vector<pair<float, int64_t>>& top) {
+    const int64_t offset = (row / inner) * k * inner + (row % inner);
+    for (int64_t j = 0; j < k; ++j) {
+      values[offset + j * inner] = top[j].first;
+      indices[offset + j * inner] = top[j].second;
+    }
+  };
+
+  concurrency::ThreadPool* tp = p_op_kernel_context->GetOperatorThreadPool();
+  const int64_t num_threads = tp != nullptr ? tp->NumThreads() + 1 : 1;
+
+  // Rows are processed in parallel. When there are fewer rows than threads, long rows are
+  // also split into chunks whose results are merged afterwards.
+  int64_t chunks = 1;
+  if (rows < num_threads) {
+    chunks = std::min((num_threads + rows - 1) / rows, n / std::max(k, kTopKMinimumChunkSize));
+    chunks = std::max<int64_t>(chunks, 1);
+  }
+
+  if (chunks == 1) {
+    concurrency::ThreadPool::TryParallelFor(tp, rows, static_cast<double>(n), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      vector<pair<float, int64_t>> top;
+      for (int64_t row = first; row < last; ++row) {
+        const float* row_input = input + (row / inner) * n * inner + (row % inner);
+        SelectTopK(row_input, 0, n, inner, k, top);
+        write_row(row, top);
       }
+    });
+    return Status::OK();
+  }
+
+  // Every chunk holds at least k elements, so each contributes exactly k candidates.
+  vector<vector<pair<float, int64_t>>> candidates(rows * chunks);
+  const int64_t chunk_size = n / chunks;
+  concurrency::ThreadPool::TryParallelFor(tp, rows * chunks, static_cast<double>(chunk_size), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (int64_t i = first; i < last; ++i) {
+      const int64_t row = i / chunks;
+      const int64_t chunk = i % chunks;
+      const float* row_input = input + (row / inner) * n * inner + (row % inner);
+      const int64_t begin = chunk * chunk_size;
+      const int64_t end = chunk == chunks - 1 ? n : begin + chunk_size;
+      SelectTopK(row_input, begin, end, inner, k, candidates[i]);
     }
-    for (int64_t j = 0; j < k_; ++j) {
-      auto& pqElem = min_heap.top();
-      Values_map(i, k_ - j - 1) = pqElem.first;
-      Indices_map(i, k_ - j - 1) = pqElem.second;
-      min_heap.pop();
+  });
+
+  // Merge the candidates of each row. They carry their indices along the axis, so selecting
+  // the best k of them orders ties the same way as a single pass over the row.
+  const ValueCmp<float> cmp;
+  for (int64_t row = 0; row < rows; ++row) {
+    vector<pair<float, int64_t>>& top = candidates[row * chunks];
+    for (int64_t chunk = 1; chunk < chunks; ++chunk) {
+      const auto& chunk_top = candidates[row * chunks + chunk];
+      top.insert(top.end(), chunk_top.begin(), chunk_top.end());
     }
+    nth_element(top.begin(), top.begin() + (k - 1), top.end(), cmp);
+    top.resize(k);
+    sort(top.begin(), top.end(), cmp);
+    write_row(row, top);
   }
 
-  // Reshape output tensors to [a_1, a_2, ..., a_n, k]
-  auto out_dims = in_dims;
-  out_dims[out_dims.size() - 1] = k_;
-  Values->Reshape(out_dims);
-  Indices->Reshape(out_dims);
   return Status::OK();
 }
 }  // namespace onnxruntime
@@ -17,7 +17,8 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                                               DataTypeImpl::GetTensorType<int64_t>()})
         .TypeConstraint("T2",
                         std::vector<MLDataType>{DataTypeImpl::GetTensorType<std::string>(),
-                                                DataTypeImpl::GetTensorType<int64_t>()}),
+                                                DataTypeImpl::GetTensorType<int64_t>()})
+        .CompactStringInput(0),
     CategoryMapper);
 
 Status CategoryMapper::Compute(OpKernelContext* context) const {
@@ -33,19 +34,30 @@ Status CategoryMapper::Compute(OpKernelContext* context) const {
     if (Y.DataType() != DataTypeImpl::GetType<int64_t>())
       return Status(ONNXRUNTIME, FAIL, "Input of string must have output of int64");
 
-    auto input = gsl::make_span(X.template Data<std::string>(), shape.Size());
     auto output = gsl::make_span(Y.template MutableData<int64_t>(), shape.Size());
     auto out = output.begin();
 
     // map isn't going to change so get end() once instead of calling inside the for_each loop
     const auto map_end = string_to_int_map_.end();
 
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const std::string& value) {
-                    auto map_to = string_to_int_map_.find(value);
-                    *out = map_to == map_end ? default_int_ : map_to->second;
-                    ++out;
-                  });
+    auto map_value = [&out, &map_end, this](const std::string& value) {
+      auto map_to = string_to_int_map_.find(value);
+      *out = map_to == map_end ? default_int_ : map_to->second;
+      ++out;
+    };
+
+    if (X.IsCompactString()) {
+      // look the elements up through one reused key rather than a std::string per element
+      std::string key;
+      for (int64_t i = 0, len = shape.Size(); i < len; ++i) {
+        auto value = X.StringElement(i);
+        key.assign(value.data(), value.size());
+        map_value(key);
+      }
+    } else {
+      auto input = gsl::make_span(X.template Data<std::string>(), shape.Size());
+      std::for_each(input.cbegin(), input.cend(), map_value);
+    }
   } else {
     if (Y.DataType() != DataTypeImpl::GetType<std::string>())
       return Status(ONNXRUNTIME, FAIL, "Input of int64 must have output of string ");
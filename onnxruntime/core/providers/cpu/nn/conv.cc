@@ -2,41 +2,110 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/nn/conv_impl.h"
+#include "core/providers/cpu/math/float16_util.h"
+
+#include <chrono>
+#include <limits>
 
 namespace onnxruntime {
 
-template <>
-Status Conv<float>::Compute(OpKernelContext* context) const {
-  size_t num_inputs = OpKernel::Node().InputDefs().size();
-  const Tensor* X = context->Input<Tensor>(0);
-  const Tensor* W = context->Input<Tensor>(1);
-  const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
+template <typename T>
+Status Conv<T>::PrepareCompute(const Tensor* X,
+                               const Tensor* W,
+                               std::vector<int64_t>& kernel_shape,
+                               std::vector<int64_t>& pads,
+                               std::vector<int64_t>& dilations,
+                               std::vector<int64_t>& strides,
+                               std::vector<int64_t>& Y_dims) const {
   const int64_t N = X->Shape()[0];
-  const int64_t C = X->Shape()[1];
   const int64_t M = W->Shape()[0];
   ORT_RETURN_IF_ERROR(ValidateInputShape(X, W));
 
-  std::vector<int64_t> kernel_shape;
   ORT_RETURN_IF_ERROR(ComputeKernelShape(W->Shape(), kernel_shape));
 
-  std::vector<int64_t> pads(pads_);
+  pads = pads_;
   if (pads.empty()) {
     pads.resize(kernel_shape.size() * 2, 0);
   }
-  std::vector<int64_t> dilations(dilations_);
+  dilations = dilations_;
   if (dilations.empty()) {
     dilations.resize(kernel_shape.size(), 1);
   }
-  std::vector<int64_t> strides(strides_);
+  strides = strides_;
   if (strides.empty()) {
     strides.resize(kernel_shape.size(), 1);
   }
 
-  std::vector<int64_t> Y_dims;
+  Y_dims.clear();
   Y_dims.insert(Y_dims.begin(), {N, M});
   TensorShape input_shape = X->Shape().Slice(2);
-  ORT_RETURN_IF_ERROR(InferOutputShape(input_shape, kernel_shape, strides, dilations, &pads, &Y_dims));
-  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  return InferOutputShape(input_shape, kernel_shape, strides, dilations, &pads, &Y_dims);
+}
+
+template <typename T>
+Status Conv<T>::AutotuneAlgorithm(const AllocatorPtr& alloc,
+                                  const float* Xdata,
+                                  const float* Wdata,
+                                  const float* Bdata,
+                                  float* Ydata) const {
+  static const MLAS_CONV_ALGORITHM candidates[] = {
+      MlasConvAlgorithmExpandThenGemm,
+      MlasConvAlgorithmExpandThenGemmSegmented,
+  };
+
+  // The prepared algorithm is the first candidate and wins ties. Each candidate runs twice so that the second run
+  // is timed with warm caches. The output is overwritten by the run that follows the tuning.
+  MLAS_CONV_PARAMETERS best_parameters = s_.parameters;
+  size_t best_working_buffer_size = s_.working_buffer_size;
+  double best_time = std::numeric_limits<double>::max();
+
+  for (int i = -1; i < static_cast<int>(sizeof(candidates) / sizeof(candidates[0])); ++i) {
+    MLAS_CONV_PARAMETERS parameters = s_.parameters;
+    size_t working_buffer_size = s_.working_buffer_size;
+    if (i >= 0 &&
+        (candidates[i] == s_.parameters.Algorithm ||
+         !MlasConvSetAlgorithm(&parameters, candidates[i], &working_buffer_size))) {
+      continue;
+    }
+
+    auto working_data = working_buffer_size > 0 ? alloc->Alloc(sizeof(float) * working_buffer_size) : nullptr;
+    BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
+
+    double run_time = std::numeric_limits<double>::max();
+    for (int run = 0; run < 2; ++run) {
+      auto start = std::chrono::high_resolution_clock::now();
+      MlasConv(&parameters, Xdata, Wdata, Bdata, static_cast<float*>(working_buffer.get()), Ydata);
+      std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+      run_time = elapsed.count();
+    }
+
+    if (run_time < best_time) {
+      best_time = run_time;
+      best_parameters = parameters;
+      best_working_buffer_size = working_buffer_size;
+    }
+  }
+
+  s_.parameters = best_parameters;
+  s_.working_buffer_size = best_working_buffer_size;
+
+  return Status::OK();
+}
+
+template <typename T>
+Status Conv<T>::ComputeFloat(OpKernelContext* context,
+                             const Tensor* X,
+                             const Tensor* W,
+                             const Tensor* B,
+                             Tensor* Y,
+                             const std::vector<int64_t>& kernel_shape,
+                             const std::vector<int64_t>& pads,
+                             const std::vector<int64_t>& dilations,
+                             const std::vector<int64_t>& strides) const {
+  const int64_t N = X->Shape()[0];
+  const int64_t C = X->Shape()[1];
+  const int64_t M = W->Shape()[0];
+  TensorShape input_shape = X->Shape().Slice(2);
   TensorShape output_shape = Y->Shape().Slice(2);
 
   AllocatorPtr alloc;
@@ -48,30 +117,67 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   const size_t kernel_rank = kernel_shape.size();
 
   if (kernel_rank == 2 || kernel_rank == 3) {
+    const float* Wdata = W->template Data<float>();
+    const float* Bdata = B != nullptr ? B->template Data<float>() : nullptr;
+
     MLAS_CONV_PARAMETERS Parameters;
     size_t WorkingBufferSize;
-    MlasConvPrepare(&Parameters,
-                    kernel_rank,
-                    static_cast<size_t>(N),
-                    static_cast<size_t>(group_),
-                    static_cast<size_t>(C / group_),
-                    input_shape.GetDims().data(),
-                    kernel_shape.data(),
-                    dilations.data(),
-                    pads.data(),
-                    strides.data(),
-                    output_shape.GetDims().data(),
-                    static_cast<size_t>(M / group_),
-                    &WorkingBufferSize);
-
-    auto working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * WorkingBufferSize) : nullptr;
-    BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
+
+    {
+      std::lock_guard<std::mutex> lock(s_.mutex);
+      const auto& x_dims = X->Shape().GetDims();
+      const auto& w_dims = W->Shape().GetDims();
+      if (s_.last_x_dims != x_dims || s_.last_w_dims != w_dims) {
+        MlasConvPrepare(&s_.parameters,
+                        kernel_rank,
+                        static_cast<size_t>(N),
+                        static_cast<size_t>(group_),
+                        static_cast<size_t>(C / group_),
+                        input_shape.GetDims().data(),
+                        kernel_shape.data(),
+                        dilations.data(),
+                        pads.data(),
+                        strides.data(),
+                        output_shape.GetDims().data(),
+                        static_cast<size_t>(M / group_),
+                        &s_.working_buffer_size);
+
+        if (autotune_) {
+          ORT_RETURN_IF_ERROR(AutotuneAlgorithm(alloc, Xdata, Wdata, Bdata, Ydata));
+        }
+
+        s_.last_x_dims = x_dims;
+        s_.last_w_dims = w_dims;
+      }
+
+      Parameters = s_.parameters;
+      WorkingBufferSize = s_.working_buffer_size;
+    }
+
+    // Reuse the working buffer of the kernel unless a concurrent run is using it.
+    std::unique_lock<std::mutex> working_buffer_lock(s_.working_buffer_mutex, std::try_to_lock);
+    BufferUniquePtr run_working_buffer;
+    float* working_data = nullptr;
+
+    if (WorkingBufferSize > 0) {
+      if (working_buffer_lock.owns_lock()) {
+        if (s_.working_buffer_capacity < WorkingBufferSize) {
+          s_.working_buffer.reset();
+          s_.working_buffer = BufferUniquePtr(alloc->Alloc(sizeof(float) * WorkingBufferSize), BufferDeleter(alloc));
+          s_.working_buffer_capacity = WorkingBufferSize;
+        }
+        working_data = static_cast<float*>(s_.working_buffer.get());
+      } else {
+        run_working_buffer = BufferUniquePtr(alloc->Alloc(sizeof(float) * WorkingBufferSize), BufferDeleter(alloc));
+        working_data = static_cast<float*>(run_working_buffer.get());
+      }
+    }
 
     MlasConv(&Parameters,
              Xdata,
-             W->template Data<float>(),
-             B != nullptr ? B->template Data<float>() : nullptr,
-             static_cast<float*>(working_buffer.get()),
+             Wdata,
+             Bdata,
+             working_data,
              Ydata);
 
     //TODO: this will be replaced with Tracy's changes.
@@ -141,9 +247,60 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
-ONNX_CPU_OPERATOR_KERNEL(
+template <>
+Status Conv<float>::Compute(OpKernelContext* context) const {
+  size_t num_inputs = OpKernel::Node().InputDefs().size();
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
+
+  std::vector<int64_t> kernel_shape, pads, dilations, strides, Y_dims;
+  ORT_RETURN_IF_ERROR(PrepareCompute(X, W, kernel_shape, pads, dilations, strides, Y_dims));
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+
+  return ComputeFloat(context, X, W, B, Y, kernel_shape, pads, dilations, strides);
+}
+
+// The float16 inputs are converted to float and the convolution is accumulated in float, so each output element
+// is rounded to float16 once.
+template <>
+Status Conv<MLFloat16>::Compute(OpKernelContext* context) const {
+  size_t num_inputs = OpKernel::Node().InputDefs().size();
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
+
+  std::vector<int64_t> kernel_shape, pads, dilations, strides, Y_dims;
+  ORT_RETURN_IF_ERROR(PrepareCompute(X, W, kernel_shape, pads, dilations, strides, Y_dims));
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  auto X_float = ConvertFloat16TensorToFloat(*X, alloc);
+  auto W_float = ConvertFloat16TensorToFloat(*W, alloc);
+  auto B_float = B != nullptr ? ConvertFloat16TensorToFloat(*B, alloc) : nullptr;
+  auto Y_float = AllocateFloatTensor(Y->Shape(), alloc);
+
+  ORT_RETURN_IF_ERROR(ComputeFloat(context, X_float.get(), W_float.get(), B_float.get(), Y_float.get(),
+                                   kernel_shape, pads, dilations, strides));
+
+  ConvertFloatTensorToFloat16(*Y_float, *Y);
+
+  return Status::OK();
+}
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Conv,
     1,
+    float,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Conv<float>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Conv,
+    1,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Conv<MLFloat16>);
 }  // namespace onnxruntime
@@ -17,17 +17,74 @@
 
 #pragma once
 
+#include <mutex>
+
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/providers/cpu/nn/conv_base.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
+// cached MLAS convolution parameters
+struct MlasConvState {
+  // if x/w dims changed, prepare the parameters again
+  std::vector<int64_t> last_x_dims;
+  std::vector<int64_t> last_w_dims;
+
+  // these would be recomputed if x/w dims change
+  MLAS_CONV_PARAMETERS parameters;
+  size_t working_buffer_size = 0;
+
+  // note that conv objects are shared between execution frames, and a lock is needed to avoid multi-thread racing
+  std::mutex mutex;
+
+  // working buffer kept across runs. a run that finds it in use by a concurrent run allocates its own buffer.
+  BufferUniquePtr working_buffer;
+  size_t working_buffer_capacity = 0;
+  std::mutex working_buffer_mutex;
+};
+
 template <typename T>
 class Conv : public OpKernel, public ConvBase {
  public:
   Conv(const OpKernelInfo& info) : OpKernel(info), ConvBase(info) {
+    auto cpu_provider = dynamic_cast<const CPUExecutionProvider*>(info.GetExecutionProvider());
+    autotune_ = cpu_provider != nullptr && cpu_provider->IsConvAutotuneEnabled();
   }
 
   Status Compute(OpKernelContext* context) const override;
+
+ protected:
+  // Computes the kernel shape, the effective pads, dilations and strides and the output dimensions for the inputs.
+  Status PrepareCompute(const Tensor* X,
+                        const Tensor* W,
+                        std::vector<int64_t>& kernel_shape,
+                        std::vector<int64_t>& pads,
+                        std::vector<int64_t>& dilations,
+                        std::vector<int64_t>& strides,
+                        std::vector<int64_t>& Y_dims) const;
+
+  // Computes the convolution of float tensors into Y, which has the dimensions returned by PrepareCompute.
+  Status ComputeFloat(OpKernelContext* context,
+                      const Tensor* X,
+                      const Tensor* W,
+                      const Tensor* B,
+                      Tensor* Y,
+                      const std::vector<int64_t>& kernel_shape,
+                      const std::vector<int64_t>& pads,
+                      const std::vector<int64_t>& dilations,
+                      const std::vector<int64_t>& strides) const;
+
+ private:
+  // Times the MLAS algorithms that can compute the convolution and keeps the fastest one in s_.
+  Status AutotuneAlgorithm(const AllocatorPtr& alloc,
+                           const float* Xdata,
+                           const float* Wdata,
+                           const float* Bdata,
+                           float* Ydata) const;
+
+  bool autotune_;
+  mutable MlasConvState s_;
 };
 
 }  // namespace onnxruntime
@@ -20,7 +20,6 @@
 #include "core/providers/cpu/nn/conv.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
-#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 template <typename T>
@@ -167,4 +166,7 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
 template <>
 Status Conv<float>::Compute(OpKernelContext* context) const;
 
+template <>
+Status Conv<MLFloat16>::Compute(OpKernelContext* context) const;
+
 }  // namespace onnxruntime
@@ -9,38 +9,63 @@
 #include "core/providers/cpu/nn/conv_integer.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
-#include "onnxruntime_config.h"
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#ifdef HAS_IGNORED_ATTRIBUTES
-#pragma GCC diagnostic ignored "-Wignored-attributes"
-#endif
-#else
-#pragma warning(push)
-#pragma warning(disable : 4100) //'identifier' : unreferenced formal parameter
-#endif
-
-#include "public/gemmlowp.h"
-
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
-#else
-#pragma warning(pop)
-#endif
+#include "core/platform/threadpool.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace contrib {
+
+namespace {
+
+// 2-D im2col for NCHW uint8 input. copies the contiguous runs of each input row when the stride is 1 and fills
+// the padding with the input zero point so that it contributes nothing once the zero point is subtracted.
+void Im2col2D(const uint8_t* data_im, int64_t channels, int64_t height, int64_t width,
+              int64_t kernel_h, int64_t kernel_w, int64_t dilation_h, int64_t dilation_w,
+              int64_t pad_t, int64_t pad_l, int64_t stride_h, int64_t stride_w,
+              int64_t output_h, int64_t output_w, uint8_t padding_value, uint8_t* data_col) {
+  for (int64_t c = 0; c < channels; ++c) {
+    for (int64_t kh = 0; kh < kernel_h; ++kh) {
+      for (int64_t kw = 0; kw < kernel_w; ++kw) {
+        for (int64_t oh = 0; oh < output_h; ++oh) {
+          const int64_t ih = oh * stride_h - pad_t + kh * dilation_h;
+          if (ih < 0 || ih >= height) {
+            std::fill_n(data_col, output_w, padding_value);
+          } else {
+            const uint8_t* row = data_im + ih * width;
+            const int64_t iw = kw * dilation_w - pad_l;
+            if (stride_w == 1) {
+              const int64_t leading = std::min(output_w, std::max<int64_t>(0, -iw));
+              const int64_t count = std::max<int64_t>(0, std::min(output_w - leading, width - (iw + leading)));
+              std::fill_n(data_col, leading, padding_value);
+              memcpy(data_col + leading, row + iw + leading, static_cast<size_t>(count));
+              std::fill_n(data_col + leading + count, output_w - leading - count, padding_value);
+            } else {
+              for (int64_t ow = 0; ow < output_w; ++ow) {
+                const int64_t x = iw + ow * stride_w;
+                data_col[ow] = (x >= 0 && x < width) ? row[x] : padding_value;
+              }
+            }
+          }
+          data_col += output_w;
+        }
+      }
+    }
+    data_im += height * width;
+  }
+}
+
+}  // namespace
+
 Status ConvInteger::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
   const Tensor* W = context->Input<Tensor>(1);
-  int32_t input_offset = 0, filter_offset = 0;
+  uint8_t input_offset = 0, filter_offset = 0;
   if (num_inputs >= 3) {
     const Tensor* X_Zero_Point = context->Input<Tensor>(2);
     if (X_Zero_Point->Shape().NumDimensions() == 0 ||
         (X_Zero_Point->Shape().NumDimensions() == 1 && X_Zero_Point->Shape().GetDims().size() == 1)) {
-      input_offset = static_cast<int32_t>(*(X_Zero_Point->Data<uint8_t>()));
+      input_offset = *(X_Zero_Point->Data<uint8_t>());
     } else {
       //TODO: Add support for per-channel quantization.
       return Status(common::ONNXRUNTIME, common::FAIL, "Non per-tensor quantization is not supported now.");
@@ -50,13 +75,69 @@ Status ConvInteger::Compute(OpKernelContext* context) const {
     const Tensor* W_Zero_Point = context->Input<Tensor>(3);
     if (W_Zero_Point->Shape().NumDimensions() == 0 ||
         (W_Zero_Point->Shape().NumDimensions() == 1 && W_Zero_Point->Shape().GetDims().size() == 1)) {
-      filter_offset = static_cast<int32_t>(*(W_Zero_Point->Data<uint8_t>()));
+      filter_offset = *(W_Zero_Point->Data<uint8_t>());
     } else {
       //TODO: Add support for per-channel quantization.
       return Status(common::ONNXRUNTIME, common::FAIL, "Non per-tensor quantization is not supported now.");
     }
   }
 
+  return ComputeInternal(context, X, W, input_offset, filter_offset, nullptr);
+}
+
+Status QLinearConv::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* X_Scale = context->Input<Tensor>(1);
+  const Tensor* X_Zero_Point = context->Input<Tensor>(2);
+  const Tensor* W = context->Input<Tensor>(3);
+  const Tensor* W_Scale = context->Input<Tensor>(4);
+  const Tensor* W_Zero_Point = context->Input<Tensor>(5);
+  const Tensor* Y_Scale = context->Input<Tensor>(6);
+  const Tensor* Y_Zero_Point = context->Input<Tensor>(7);
+  const Tensor* B = context->Input<Tensor>(8);
+
+  const int64_t M = W->Shape()[0];
+
+  auto is_scalar = [](const Tensor* t) {
+    return t->Shape().NumDimensions() == 0 ||
+           (t->Shape().NumDimensions() == 1 && t->Shape().GetDims()[0] == 1);
+  };
+
+  // the filter scale may be per output channel. the zero points are subtracted inside the GEMM and must be scalars.
+  if (!is_scalar(X_Scale) || !is_scalar(X_Zero_Point) || !is_scalar(W_Zero_Point) ||
+      !is_scalar(Y_Scale) || !is_scalar(Y_Zero_Point)) {
+    return Status(common::ONNXRUNTIME, common::FAIL, "Non per-tensor quantization is not supported now.");
+  }
+  const bool per_channel = !is_scalar(W_Scale);
+  if (per_channel && (W_Scale->Shape().NumDimensions() != 1 || W_Scale->Shape()[0] != M)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "w_scale must be a scalar or a 1D tensor with size ", M);
+  }
+  if (B != nullptr && (B->Shape().NumDimensions() != 1 || B->Shape()[0] != M)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "B must be a 1D tensor with size ", M);
+  }
+
+  // fold the input and output scales into the filter scale
+  const float x_scale = *(X_Scale->Data<float>());
+  const float y_scale = *(Y_Scale->Data<float>());
+  const float* w_scale = W_Scale->Data<float>();
+  std::vector<float> output_scale(per_channel ? static_cast<size_t>(M) : 1);
+  for (size_t i = 0; i < output_scale.size(); i++) {
+    output_scale[i] = x_scale * w_scale[i] / y_scale;
+  }
+
+  RequantizeParams requantize;
+  requantize.scale = output_scale.data();
+  requantize.per_channel = per_channel;
+  requantize.bias = B != nullptr ? B->Data<int32_t>() : nullptr;
+  requantize.zero_point = *(Y_Zero_Point->Data<uint8_t>());
+
+  return ComputeInternal(context, X, W, *(X_Zero_Point->Data<uint8_t>()), *(W_Zero_Point->Data<uint8_t>()),
+                         &requantize);
+}
+
+Status ConvInteger::ComputeInternal(OpKernelContext* context, const Tensor* X, const Tensor* W,
+                                    uint8_t input_offset, uint8_t filter_offset,
+                                    const RequantizeParams* requantize) const {
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
   const int64_t M = W->Shape()[0];
@@ -89,7 +170,9 @@ Status ConvInteger::Compute(OpKernelContext* context) const {
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
   const uint8_t* Xdata = X->template Data<uint8_t>();
-  int32_t* Ydata = Y->template MutableData<int32_t>();
+  const uint8_t* Wdata = W->template Data<uint8_t>();
+  int32_t* Ydata = requantize == nullptr ? Y->template MutableData<int32_t>() : nullptr;
+  uint8_t* Ydata_quantized = requantize != nullptr ? Y->template MutableData<uint8_t>() : nullptr;
 
   const int64_t input_image_size = input_shape.Size();
   const int64_t output_image_size = output_shape.Size();
@@ -99,57 +182,99 @@ Status ConvInteger::Compute(OpKernelContext* context) const {
   const int64_t W_offset = W->Shape().Size() / group_;
   const int64_t kernel_dim = C / group_ * kernel_size;
   const int64_t col_buffer_size = kernel_dim * output_image_size;
+  const int64_t group_output_channels = M / group_;
 
-  auto col_data = alloc->Alloc(sizeof(uint8_t) * col_buffer_size);
-  BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
-  uint8_t* col_buffer_data = static_cast<uint8_t*>(col_buffer.get());
+  // a 1x1 kernel with unit strides and no padding reads the input image directly
+  const bool is_pointwise = kernel_size == 1 &&
+                            std::all_of(strides.cbegin(), strides.cend(), [](int64_t v) { return v == 1; }) &&
+                            std::all_of(pads.cbegin(), pads.cend(), [](int64_t v) { return v == 0; });
 
   TensorShape image_shape = X->Shape().Slice(1);
   std::vector<int64_t> col_buffer_shape{kernel_dim};
   col_buffer_shape.insert(col_buffer_shape.end(), output_shape.GetDims().begin(),
                           output_shape.GetDims().end());
 
-  for (int image_id = 0; image_id < N; ++image_id) {
-    for (int group_id = 0; group_id < group_; ++group_id) {
-      math::Im2colNd<uint8_t, CPUMathUtil, StorageOrder::NCHW>()(
-          Xdata + group_id * X_offset,
-          image_shape.GetDims().data(),
-          col_buffer_shape.data(),
-          C * input_image_size,
-          col_buffer_size,
-          kernel_shape.data(),
-          strides.data(),
-          dilations.data(),
-          pads.data(),
-          static_cast<int>(kernel_shape.size()),
-          col_buffer_data,
-          &CPUMathUtil::Instance(),
-		  false,
-		  input_offset);
-
-      const uint8_t* filter_data_as_uint8 = W->template Data<uint8_t>() + group_id * W_offset;
-      static const gemmlowp::MapOrder ResultOrder = gemmlowp::MapOrder::RowMajor;
-      static const gemmlowp::MapOrder LhsOrder = gemmlowp::MapOrder::RowMajor;
-      static const gemmlowp::MapOrder RhsOrder = gemmlowp::MapOrder::RowMajor;
-      gemmlowp::MatrixMap<const std::uint8_t, LhsOrder> lhs(
-          filter_data_as_uint8, static_cast<int>(M / group_), static_cast<int>(kernel_dim));
-      gemmlowp::MatrixMap<const std::uint8_t, RhsOrder> rhs(
-          col_buffer_data, static_cast<int>(kernel_dim), static_cast<int>(output_image_size));
-      gemmlowp::MatrixMap<std::int32_t, ResultOrder> result(
-          Ydata, static_cast<int>(M / group_), static_cast<int>(output_image_size));
-      const std::tuple<> empty_pipeline = {};
-
-      gemmlowp::GemmContext gemm_context;
-      // TODO: worker thread pool needs to be handled.
-      gemmlowp::GemmWithOutputPipeline<std::uint8_t, std::int32_t,
-                                       gemmlowp::DefaultL8R8BitDepthParams>(
-          &gemm_context, lhs, rhs, &result, -filter_offset, -input_offset,
-          empty_pipeline);
-    }
+  // each (image, group) pair is an independent im2col + GEMM, so run them on the operator thread pool.
+  // every range gets its own column buffer, and its own accumulator buffer if the output is requantized.
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), N * group_,
+      static_cast<double>(group_output_channels * kernel_dim * output_image_size),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        BufferUniquePtr col_buffer;
+        uint8_t* col_buffer_data = nullptr;
+        if (!is_pointwise) {
+          col_buffer = BufferUniquePtr(alloc->Alloc(sizeof(uint8_t) * col_buffer_size), BufferDeleter(alloc));
+          col_buffer_data = static_cast<uint8_t*>(col_buffer.get());
+        }
 
-    Xdata += X_offset * group_;
-    Ydata += Y_offset * group_;
-  }
+        BufferUniquePtr gemm_buffer;
+        int32_t* gemm_buffer_data = nullptr;
+        if (requantize != nullptr) {
+          gemm_buffer = BufferUniquePtr(alloc->Alloc(sizeof(int32_t) * Y_offset), BufferDeleter(alloc));
+          gemm_buffer_data = static_cast<int32_t*>(gemm_buffer.get());
+        }
+
+        for (std::ptrdiff_t unit = first; unit < last; ++unit) {
+          const int64_t image_id = unit / group_;
+          const int64_t group_id = unit % group_;
+          const uint8_t* image_data = Xdata + (image_id * group_ + group_id) * X_offset;
+
+          const uint8_t* gemm_b = image_data;
+          if (!is_pointwise) {
+            if (kernel_shape.size() == 2) {
+              Im2col2D(image_data, C / group_, input_shape[0], input_shape[1],
+                       kernel_shape[0], kernel_shape[1], dilations[0], dilations[1],
+                       pads[0], pads[1], strides[0], strides[1],
+                       output_shape[0], output_shape[1], input_offset, col_buffer_data);
+            } else {
+              math::Im2colNd<uint8_t, CPUMathUtil, StorageOrder::NCHW>()(
+                  image_data,
+                  image_shape.GetDims().data(),
+                  col_buffer_shape.data(),
+                  C * input_image_size,
+                  col_buffer_size,
+                  kernel_shape.data(),
+                  strides.data(),
+                  dilations.data(),
+                  pads.data(),
+                  static_cast<int>(kernel_shape.size()),
+                  col_buffer_data,
+                  &CPUMathUtil::Instance(),
+                  false,
+                  input_offset);
+            }
+            gemm_b = col_buffer_data;
+          }
+
+          int32_t* gemm_output = requantize == nullptr ? Ydata + (image_id * group_ + group_id) * Y_offset
+                                                       : gemm_buffer_data;
+
+          MlasQgemm(static_cast<size_t>(group_output_channels),
+                    static_cast<size_t>(output_image_size),
+                    static_cast<size_t>(kernel_dim),
+                    Wdata + group_id * W_offset,
+                    static_cast<size_t>(kernel_dim),
+                    filter_offset,
+                    gemm_b,
+                    static_cast<size_t>(output_image_size),
+                    input_offset,
+                    false,
+                    gemm_output,
+                    static_cast<size_t>(output_image_size));
+
+          if (requantize != nullptr) {
+            const int64_t channel_offset = group_id * group_output_channels;
+            MlasRequantizeOutput(gemm_output,
+                                 Ydata_quantized + (image_id * group_ + group_id) * Y_offset,
+                                 requantize->bias != nullptr ? requantize->bias + channel_offset : nullptr,
+                                 static_cast<size_t>(group_output_channels),
+                                 static_cast<size_t>(output_image_size),
+                                 requantize->scale + (requantize->per_channel ? channel_offset : 0),
+                                 requantize->per_channel,
+                                 requantize->zero_point);
+          }
+        }
+      });
 
   return Status::OK();
 }
@@ -164,5 +289,17 @@ ONNX_OPERATOR_KERNEL_EX(
 	.TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
 	.TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
     ConvInteger);
+
+ONNX_OPERATOR_KERNEL_EX(
+    QLinearConv,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T4", DataTypeImpl::GetTensorType<int32_t>()),
+    QLinearConv);
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -12,6 +12,29 @@ class ConvInteger : public OpKernel, public ConvBase {
   ConvInteger(const OpKernelInfo& info) : OpKernel(info), ConvBase(info) {
   }
 
+  Status Compute(OpKernelContext* context) const override;
+
+ protected:
+  // parameters of the output stage that requantizes the int32 accumulators to uint8.
+  // scale has one element, or one element per output channel if per_channel is set. bias is optional.
+  struct RequantizeParams {
+    const float* scale;
+    bool per_channel;
+    const int32_t* bias;
+    uint8_t zero_point;
+  };
+
+  // computes the convolution of X and W. the output is int32 if requantize is nullptr, else uint8.
+  Status ComputeInternal(OpKernelContext* context, const Tensor* X, const Tensor* W,
+                         uint8_t input_offset, uint8_t filter_offset,
+                         const RequantizeParams* requantize) const;
+};
+
+class QLinearConv final : public ConvInteger {
+ public:
+  QLinearConv(const OpKernelInfo& info) : ConvInteger(info) {
+  }
+
   Status Compute(OpKernelContext* context) const override;
 };
 }
@@ -16,8 +16,6 @@
 /* Modifications Copyright (c) Microsoft. */
 
 #include "core/providers/cpu/nn/conv_transpose.h"
-#include "core/util/math.h"
-#include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
 
@@ -214,70 +212,71 @@ Status ConvTranspose<T>::Compute(OpKernelContext* context) const {
   Prepare p;
   ORT_RETURN_IF_ERROR(PrepareForCompute(context, num_inputs == 3, p));
 
-  const int64_t input_image_size = p.H * p.W;
-  const int64_t X_offset = p.num_input_channels / group_ * input_image_size;
-  const int64_t Y_offset = p.Y->Shape().Size() / p.Y->Shape()[0] / group_;
-  const int64_t W_offset = p.F->Shape().Size() / group_;
-  const int64_t kernel_dim = p.num_output_channels / group_ * p.kernel_shape[0] * p.kernel_shape[1];
-  const int64_t output_image_size = p.Y->Shape()[2] * p.Y->Shape()[3];
-
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
-  auto col_data = alloc->Alloc(sizeof(T) * kernel_dim * p.H * p.W);
-  BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
-  T* col_buffer_data = static_cast<T*>(col_buffer.get());
-
-  const T* Xdata = p.X->template Data<T>();
-  const T* filter_data = p.F->template Data<T>();
-  T* Ydata = p.Y->template MutableData<T>();
-
-  for (auto image_id = 0; image_id < p.N; ++image_id) {
-    for (int group_id = 0; group_id < group_; ++group_id) {
-      // Weight term
-      math::Gemm<T, CPUMathUtil>(
-          CblasTrans,
-          CblasNoTrans,
-          kernel_dim,
-          input_image_size,
-          p.num_input_channels / group_,
-          1,
-          filter_data + group_id * W_offset,
-          Xdata + group_id * X_offset,
-          0,
-          col_buffer_data,
-          &CPUMathUtil::Instance());
-
-      // Col2im
-      math::Col2im<T, CPUMathUtil, StorageOrder::NCHW>(
-          col_buffer_data,
-          p.num_output_channels / group_,
-          p.Y->Shape()[2],
-          p.Y->Shape()[3],
-          p.kernel_shape[0],
-          p.kernel_shape[1],
-          1,
-          1,
-          p.pads[0],
-          p.pads[1],
-          p.pads[2],
-          p.pads[3],
-          p.strides[0],
-          p.strides[1],
-          Ydata + group_id * Y_offset,
-          &CPUMathUtil::Instance());
+  const float* Xdata = p.X->template Data<float>();
+  const float* filter_data = p.F->template Data<float>();
+  const float* bias_data = p.B != nullptr ? p.B->template Data<float>() : nullptr;
+  float* Ydata = p.Y->template MutableData<float>();
+
+  MLAS_CONV_TRANSPOSE_PARAMETERS Parameters;
+  size_t WorkingBufferSize;
+
+  {
+    std::lock_guard<std::mutex> lock(s_.mutex);
+    const auto& x_dims = p.X->Shape().GetDims();
+    const auto& w_dims = p.F->Shape().GetDims();
+    if (s_.last_x_dims != x_dims || s_.last_w_dims != w_dims) {
+      // the output shape computed by PrepareForCompute doesn't account for the dilations
+      const int64_t dilations[] = {1, 1};
+      MlasConvTransposePrepare(&s_.parameters,
+                               static_cast<size_t>(p.N),
+                               static_cast<size_t>(group_),
+                               static_cast<size_t>(p.num_input_channels / group_),
+                               x_dims.data() + 2,
+                               p.kernel_shape.data(),
+                               dilations,
+                               p.pads.data(),
+                               p.strides.data(),
+                               p.Y->Shape().GetDims().data() + 2,
+                               static_cast<size_t>(p.num_output_channels / group_),
+                               &s_.working_buffer_size);
+
+      s_.last_x_dims = x_dims;
+      s_.last_w_dims = w_dims;
     }
 
-    if (p.B != nullptr) {
-      auto Ymatrix = EigenMatrixMap<T>(Ydata, output_image_size, p.num_output_channels);
-      auto Bvec = ConstEigenVectorMap<T>(p.B->template Data<T>(), p.num_output_channels);
-      Ymatrix.rowwise() += Bvec.transpose();
-    }
+    Parameters = s_.parameters;
+    WorkingBufferSize = s_.working_buffer_size;
+  }
 
-    Xdata += X_offset * group_;
-    Ydata += Y_offset * group_;
+  // Reuse the working buffer of the kernel unless a concurrent run is using it.
+  std::unique_lock<std::mutex> working_buffer_lock(s_.working_buffer_mutex, std::try_to_lock);
+  BufferUniquePtr run_working_buffer;
+  float* working_data = nullptr;
+
+  if (WorkingBufferSize > 0) {
+    if (working_buffer_lock.owns_lock()) {
+      if (s_.working_buffer_capacity < WorkingBufferSize) {
+        s_.working_buffer.reset();
+        s_.working_buffer = BufferUniquePtr(alloc->Alloc(sizeof(float) * WorkingBufferSize), BufferDeleter(alloc));
+        s_.working_buffer_capacity = WorkingBufferSize;
+      }
+      working_data = static_cast<float*>(s_.working_buffer.get());
+    } else {
+      run_working_buffer = BufferUniquePtr(alloc->Alloc(sizeof(float) * WorkingBufferSize), BufferDeleter(alloc));
+      working_data = static_cast<float*>(run_working_buffer.get());
+    }
   }
 
+  MlasConvTranspose(&Parameters,
+                    Xdata,
+                    filter_data,
+                    bias_data,
+                    working_data,
+                    Ydata);
+
   return Status::OK();
 }
 
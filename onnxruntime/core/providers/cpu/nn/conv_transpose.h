@@ -17,7 +17,10 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "core/providers/cpu/nn/conv_base.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -60,12 +63,32 @@ class ConvTransposeBase : public ConvBase {
   const std::vector<int64_t> output_shape_;
 };
 
+// cached MLAS transposed convolution parameters, see MlasConvState
+struct MlasConvTransposeState {
+  // if x/w dims changed, prepare the parameters again
+  std::vector<int64_t> last_x_dims;
+  std::vector<int64_t> last_w_dims;
+
+  MLAS_CONV_TRANSPOSE_PARAMETERS parameters;
+  size_t working_buffer_size = 0;
+
+  std::mutex mutex;
+
+  // working buffer kept across runs. a run that finds it in use by a concurrent run allocates its own buffer.
+  BufferUniquePtr working_buffer;
+  size_t working_buffer_capacity = 0;
+  std::mutex working_buffer_mutex;
+};
+
 template <typename T>
 class ConvTranspose : public OpKernel, public ConvTransposeBase {
  public:
   ConvTranspose(const OpKernelInfo& info) : OpKernel(info), ConvTransposeBase(info) {}
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  mutable MlasConvTransposeState s_;
 };
 
 }  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/nn/pool.h"
+#include "core/platform/threadpool.h"
 #include <cmath>
 using namespace ::onnxruntime::common;
 
@@ -44,29 +45,28 @@ Status Pool<T, PoolType>::Compute(OpKernelContext* context) const {
       int64_t y_step = pooled_height;
       const int64_t total_channels = x_shape[0] * channels;
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-      for (int64_t c = 0; c < total_channels; ++c) {
-        const float* x_d = X_data + c * x_step;
-        float* y_d = Y_data + c * y_step;
-
-        for (int64_t ph = 0; ph < pooled_height; ++ph) {
-          int64_t hstart = ph * stride_h() - pads[0];
-          int64_t hend = std::min(hstart + kernel_shape[0], height);
-          hstart = std::max(hstart, static_cast<int64_t>(0));
-          T Yh = PoolType::Initialize();
-          for (int64_t h = hstart; h < hend; ++h) {
-            PoolType::Process(x_d[h], Yh, pool_context_);
-          }
-          if (count_include_pad_) {
-            PoolType::Finalize(kernel_shape[0], Yh, pool_context_);
-          } else {
-            PoolType::Finalize(hend - hstart, Yh, pool_context_);
+      concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), total_channels, static_cast<double>(y_step * kernel_shape[0]), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t c = first; c < last; ++c) {
+          const float* x_d = X_data + c * x_step;
+          float* y_d = Y_data + c * y_step;
+
+          for (int64_t ph = 0; ph < pooled_height; ++ph) {
+            int64_t hstart = ph * stride_h() - pads[0];
+            int64_t hend = std::min(hstart + kernel_shape[0], height);
+            hstart = std::max(hstart, static_cast<int64_t>(0));
+            T Yh = PoolType::Initialize();
+            for (int64_t h = hstart; h < hend; ++h) {
+              PoolType::Process(x_d[h], Yh, pool_context_);
+            }
+            if (count_include_pad_) {
+              PoolType::Finalize(kernel_shape[0], Yh, pool_context_);
+            } else {
+              PoolType::Finalize(hend - hstart, Yh, pool_context_);
+            }
+            y_d[ph] = Yh;
           }
-          y_d[ph] = Yh;
         }
-      }
+      });
 
       break;
     }
@@ -76,38 +76,37 @@ Status Pool<T, PoolType>::Compute(OpKernelContext* context) const {
       int64_t y_step = pooled_height * pooled_width;
       const int64_t total_channels = x_shape[0] * channels;
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-      for (int64_t c = 0; c < total_channels; ++c) {
-        const float* x_d = X_data + c * x_step;
-        float* y_d = Y_data + c * y_step;
-
-        for (int64_t ph = 0; ph < pooled_height; ++ph) {
-          int64_t hstart = ph * stride_h() - pads[0];
-          int64_t hend = std::min(hstart + kernel_shape[0], height);
-          hstart = std::max(hstart, static_cast<int64_t>(0));
-          for (int64_t pw = 0; pw < pooled_width; ++pw) {
-            int64_t wstart = pw * stride_w() - pads[1];
-            int64_t wend = std::min(wstart + kernel_shape[1], width);
-            wstart = std::max(wstart, static_cast<int64_t>(0));
-            const int64_t pool_index = ph * pooled_width + pw;
-            T Yh = PoolType::Initialize();
-            for (int64_t h = hstart; h < hend; ++h) {
-              for (int64_t w = wstart; w < wend; ++w) {
-                const int64_t input_index = h * width + w;
-                PoolType::Process(x_d[input_index], Yh, pool_context_);
+      concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), total_channels, static_cast<double>(y_step * kernel_shape[0] * kernel_shape[1]), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t c = first; c < last; ++c) {
+          const float* x_d = X_data + c * x_step;
+          float* y_d = Y_data + c * y_step;
+
+          for (int64_t ph = 0; ph < pooled_height; ++ph) {
+            int64_t hstart = ph * stride_h() - pads[0];
+            int64_t hend = std::min(hstart + kernel_shape[0], height);
+            hstart = std::max(hstart, static_cast<int64_t>(0));
+            for (int64_t pw = 0; pw < pooled_width; ++pw) {
+              int64_t wstart = pw * stride_w() - pads[1];
+              int64_t wend = std::min(wstart + kernel_shape[1], width);
+              wstart = std::max(wstart, static_cast<int64_t>(0));
+              const int64_t pool_index = ph * pooled_width + pw;
+              T Yh = PoolType::Initialize();
+              for (int64_t h = hstart; h < hend; ++h) {
+                for (int64_t w = wstart; w < wend; ++w) {
+                  const int64_t input_index = h * width + w;
+                  PoolType::Process(x_d[input_index], Yh, pool_context_);
+                }
               }
+              if (count_include_pad_) {
+                PoolType::Finalize(kernel_shape[0] * kernel_shape[1], Yh, pool_context_);
+              } else {
+                PoolType::Finalize((hend - hstart) * (wend - wstart), Yh, pool_context_);
+              }
+              y_d[pool_index] = Yh;
             }
-            if (count_include_pad_) {
-              PoolType::Finalize(kernel_shape[0] * kernel_shape[1], Yh, pool_context_);
-            } else {
-              PoolType::Finalize((hend - hstart) * (wend - wstart), Yh, pool_context_);
-            }
-            y_d[pool_index] = Yh;
           }
         }
-      }
+      });
 
       break;
     }
@@ -116,47 +115,46 @@ Status Pool<T, PoolType>::Compute(OpKernelContext* context) const {
       int64_t y_step = pooled_height * pooled_width * pooled_depth;
       const int64_t total_channels = x_shape[0] * channels;
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-      for (int64_t c = 0; c < total_channels; ++c) {
-        const float* x_d = X_data + c * x_step;
-        float* y_d = Y_data + c * y_step;
-
-        for (int64_t ph = 0; ph < pooled_height; ++ph) {
-          int64_t hstart = ph * stride_h() - pads[0];
-          int64_t hend = std::min(hstart + kernel_shape[0], height);
-          hstart = std::max(hstart, static_cast<int64_t>(0));
-          for (int64_t pw = 0; pw < pooled_width; ++pw) {
-            int64_t wstart = pw * stride_w() - pads[1];
-            int64_t wend = std::min(wstart + kernel_shape[1], width);
-            wstart = std::max(wstart, static_cast<int64_t>(0));
-            for (int64_t pd = 0; pd < pooled_depth; ++pd) {
-              int64_t dstart = pd * stride_d() - pads[2];
-              int64_t dend = std::min(dstart + kernel_shape[2], depth);
-              dstart = std::max(dstart, static_cast<int64_t>(0));
-              const int64_t pool_index =
-                  ph * pooled_width * pooled_depth + pw * pooled_depth + pd;
-              T Yh = PoolType::Initialize();
-              for (int64_t h = hstart; h < hend; ++h) {
-                for (int64_t w = wstart; w < wend; ++w) {
-                  for (int64_t d = dstart; d < dend; ++d) {
-                    const int64_t input_index = h * width * depth + w * depth + d;
-                    PoolType::Process(x_d[input_index], Yh, pool_context_);
+      concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), total_channels, static_cast<double>(y_step * kernel_shape[0] * kernel_shape[1] * kernel_shape[2]), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t c = first; c < last; ++c) {
+          const float* x_d = X_data + c * x_step;
+          float* y_d = Y_data + c * y_step;
+
+          for (int64_t ph = 0; ph < pooled_height; ++ph) {
+            int64_t hstart = ph * stride_h() - pads[0];
+            int64_t hend = std::min(hstart + kernel_shape[0], height);
+            hstart = std::max(hstart, static_cast<int64_t>(0));
+            for (int64_t pw = 0; pw < pooled_width; ++pw) {
+              int64_t wstart = pw * stride_w() - pads[1];
+              int64_t wend = std::min(wstart + kernel_shape[1], width);
+              wstart = std::max(wstart, static_cast<int64_t>(0));
+              for (int64_t pd = 0; pd < pooled_depth; ++pd) {
+                int64_t dstart = pd * stride_d() - pads[2];
+                int64_t dend = std::min(dstart + kernel_shape[2], depth);
+                dstart = std::max(dstart, static_cast<int64_t>(0));
+                const int64_t pool_index =
+                    ph * pooled_width * pooled_depth + pw * pooled_depth + pd;
+                T Yh = PoolType::Initialize();
+                for (int64_t h = hstart; h < hend; ++h) {
+                  for (int64_t w = wstart; w < wend; ++w) {
+                    for (int64_t d = dstart; d < dend; ++d) {
+                      const int64_t input_index = h * width * depth + w * depth + d;
+                      PoolType::Process(x_d[input_index], Yh, pool_context_);
+                    }
                   }
                 }
+                if (count_include_pad_) {
+                  PoolType::Finalize(kernel_shape[0] * kernel_shape[1] * kernel_shape[2], Yh, pool_context_);
+                } else {
+                  PoolType::Finalize(
+                      (hend - hstart) * (wend - wstart) * (dend - dstart), Yh, pool_context_);
+                }
+                y_d[pool_index] = Yh;
               }
-              if (count_include_pad_) {
-                PoolType::Finalize(kernel_shape[0] * kernel_shape[1] * kernel_shape[2], Yh, pool_context_);
-              } else {
-                PoolType::Finalize(
-                    (hend - hstart) * (wend - wstart) * (dend - dstart), Yh, pool_context_);
-              }
-              y_d[pool_index] = Yh;
             }
           }
         }
-      }
+      });
 
       break;
     }
@@ -186,15 +184,38 @@ Status PoolBase::Compute(OpKernelContext* context, MLAS_POOLING_KIND kind) const
   std::vector<int64_t> output_dims = PoolBase::SetOutputSize(x_shape, x_shape[1], &pads);
   Tensor* Y = context->Output(0, TensorShape(output_dims));
 
-  MlasPool(kind,
-           pooling_dims,
-           X->Shape().GetDims().data(),
-           global_pooling_ ? nullptr : kernel_shape_.data(),
-           global_pooling_ ? nullptr : pads.data(),
-           global_pooling_ ? nullptr : strides_.data(),
-           output_dims.data(),
-           X->template Data<float>(),
-           Y->template MutableData<float>());
+  const float* X_data = X->template Data<float>();
+  float* Y_data = Y->template MutableData<float>();
+
+  const int64_t total_channels = x_shape[0] * x_shape[1];
+  const int64_t x_step = x_shape.SizeFromDimension(2);
+  const int64_t y_step = Y->Shape().SizeFromDimension(2);
+
+  int64_t kernel_size = x_step;
+  if (!global_pooling_) {
+    kernel_size = 1;
+    for (int64_t k : kernel_shape_) {
+      kernel_size *= k;
+    }
+  }
+
+  // MLAS pools the channels on the calling thread, so split them across the operator thread pool.
+  concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), total_channels, static_cast<double>(y_step * kernel_size), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    std::vector<int64_t> input_dims = x_shape.GetDims();
+    std::vector<int64_t> pooled_dims = output_dims;
+    input_dims[0] = pooled_dims[0] = 1;
+    input_dims[1] = pooled_dims[1] = last - first;
+
+    MlasPool(kind,
+             pooling_dims,
+             input_dims.data(),
+             global_pooling_ ? nullptr : kernel_shape_.data(),
+             global_pooling_ ? nullptr : pads.data(),
+             global_pooling_ ? nullptr : strides_.data(),
+             pooled_dims.data(),
+             X_data + first * x_step,
+             Y_data + first * y_step);
+  });
 
   return Status::OK();
 }
@@ -211,26 +232,31 @@ Status Pool<float, AveragePool>::Compute(OpKernelContext* context) const {
 
 template <>
 Status Pool<float, MaxPool<8 /*VERSION*/>>::Compute(OpKernelContext* context) const {
-  // Use MLAS pooling if the index output tensor is not used.
+  // MLAS computes the pooled values. If the index output tensor is used, the index of each output
+  // is then found as the first element of its pooling window that equals the pooled value, which
+  // is the element the row major scan of the window selects.
+  ORT_RETURN_IF_ERROR(PoolBase::Compute(context, MlasMaximumPooling));
+
   if (OpKernel::Node().OutputDefs().size() == 1) {
-    return PoolBase::Compute(context, MlasMaximumPooling);
+    return Status::OK();
   }
 
   const Tensor* X = context->Input<Tensor>(0);
   const TensorShape& x_shape = X->Shape();
 
-  ORT_RETURN_IF_NOT(x_shape.NumDimensions() >= 3, "Input dimension cannot be less than 3.");
-
   std::vector<int64_t> pads = pads_;
   std::vector<int64_t> kernel_shape = kernel_shape_;
 
   std::vector<int64_t> output_dims = PoolBase::SetOutputSize(x_shape, x_shape[1], &pads);
-  Tensor* Y = context->Output(0, TensorShape(output_dims));
+  const Tensor* Y = context->Output(0, TensorShape(output_dims));
   Tensor* I = context->Output(1, TensorShape(output_dims));
+  if (I == nullptr) {
+    return Status::OK();
+  }
 
   const float* X_data = X->template Data<float>();
-  float* Y_data = Y->template MutableData<float>();
-  int64_t* I_data = I != nullptr ? I->template MutableData<int64_t>() : nullptr;
+  const float* Y_data = Y->template Data<float>();
+  int64_t* I_data = I->template MutableData<int64_t>();
 
   // The main loop
   int64_t channels = x_shape[1];
@@ -247,29 +273,24 @@ Status Pool<float, MaxPool<8 /*VERSION*/>>::Compute(OpKernelContext* context) co
       int64_t y_step = pooled_height;
       const int64_t total_channels = x_shape[0] * channels;
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-      for (int64_t c = 0; c < total_channels; ++c) {
-        const float* x_d = X_data + c * x_step;
-        float* y_d = Y_data + c * y_step;
-        int64_t* i_d = I_data ? I_data + c * y_step : nullptr;
-        for (int64_t ph = 0; ph < pooled_height; ++ph) {
-          int64_t hstart = ph * stride_h() - pads[0];
-          int64_t hend = std::min(hstart + kernel_shape[0], height);
-          hstart = std::max(hstart, static_cast<int64_t>(0));
-          float Yh = std::numeric_limits<float>::lowest();
-          int64_t h_index = -1;
-          for (int64_t h = hstart; h < hend; ++h) {
-            if (x_d[h] > Yh) {
-              Yh = x_d[h];
-              h_index = h;
+      concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), total_channels, static_cast<double>(y_step * kernel_shape[0]), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t c = first; c < last; ++c) {
+          const float* x_d = X_data + c * x_step;
+          const float* y_d = Y_data + c * y_step;
+          int64_t* i_d = I_data + c * y_step;
+          for (int64_t ph = 0; ph < pooled_height; ++ph) {
+            int64_t hstart = ph * stride_h() - pads[0];
+            int64_t hend = std::min(hstart + kernel_shape[0], height);
+            hstart = std::max(hstart, static_cast<int64_t>(0));
+            const float Yh = y_d[ph];
+            int64_t h_index = hstart;
+            while (h_index < hend - 1 && x_d[h_index] != Yh) {
+              ++h_index;
             }
+            i_d[ph] = c * x_step + h_index;
           }
-          y_d[ph] = Yh;
-          if (i_d != nullptr) i_d[ph] = c * x_step + h_index;
         }
-      }
+      });
 
       break;
     }
@@ -279,43 +300,41 @@ Status Pool<float, MaxPool<8 /*VERSION*/>>::Compute(OpKernelContext* context) co
       int64_t y_step = pooled_height * pooled_width;
       const int64_t total_channels = x_shape[0] * channels;
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-      for (int64_t c = 0; c < total_channels; ++c) {
-        const float* x_d = X_data + c * x_step;
-        float* y_d = Y_data + c * y_step;
-        int64_t* i_d = I_data ? I_data + c * y_step : nullptr;
-
-        for (int64_t ph = 0; ph < pooled_height; ++ph) {
-          int64_t hstart = ph * stride_h() - pads[0];
-          int64_t hend = std::min(hstart + kernel_shape[0], height);
-          hstart = std::max(hstart, static_cast<int64_t>(0));
-          for (int64_t pw = 0; pw < pooled_width; ++pw) {
-            int64_t wstart = pw * stride_w() - pads[1];
-            int64_t wend = std::min(wstart + kernel_shape[1], width);
-            wstart = std::max(wstart, static_cast<int64_t>(0));
-            const int64_t pool_index = ph * pooled_width + pw;
-            float Yh = std::numeric_limits<float>::lowest();
-            int64_t h_index = -1;
-            int64_t w_index = -1;
-            for (int64_t h = hstart; h < hend; ++h) {
-              for (int64_t w = wstart; w < wend; ++w) {
-                const int64_t input_index = h * width + w;
-                if (x_d[input_index] > Yh) {
-                  Yh = x_d[input_index];
-                  h_index = h;
-                  w_index = w;
+      concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), total_channels, static_cast<double>(y_step * kernel_shape[0] * kernel_shape[1]), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t c = first; c < last; ++c) {
+          const float* x_d = X_data + c * x_step;
+          const float* y_d = Y_data + c * y_step;
+          int64_t* i_d = I_data + c * y_step;
+
+          for (int64_t ph = 0; ph < pooled_height; ++ph) {
+            int64_t hstart = ph * stride_h() - pads[0];
+            int64_t hend = std::min(hstart + kernel_shape[0], height);
+            hstart = std::max(hstart, static_cast<int64_t>(0));
+            for (int64_t pw = 0; pw < pooled_width; ++pw) {
+              int64_t wstart = pw * stride_w() - pads[1];
+              int64_t wend = std::min(wstart + kernel_shape[1], width);
+              wstart = std::max(wstart, static_cast<int64_t>(0));
+              const int64_t pool_index = ph * pooled_width + pw;
+              const float Yh = y_d[pool_index];
+              int64_t h_index = hstart;
+              int64_t w_index = wstart;
+              bool found = false;
+              for (int64_t h = hstart; h < hend && !found; ++h) {
+                for (int64_t w = wstart; w < wend; ++w) {
+                  if (x_d[h * width + w] == Yh) {
+                    h_index = h;
+                    w_index = w;
+                    found = true;
+                    break;
+                  }
                 }
               }
-            }
-            y_d[pool_index] = Yh;
-            if (i_d != nullptr)
               i_d[pool_index] = storage_order_ == 0 ? c * x_step + h_index * width + w_index
                                                     : c * x_step + h_index + w_index * height;
+            }
           }
         }
-      }
+      });
       break;
     }
     case 3: {
@@ -323,53 +342,51 @@ Status Pool<float, MaxPool<8 /*VERSION*/>>::Compute(OpKernelContext* context) co
       int64_t y_step = pooled_height * pooled_width * pooled_depth;
       const int64_t total_channels = x_shape[0] * channels;
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-      for (int64_t c = 0; c < total_channels; ++c) {
-        const float* x_d = X_data + c * x_step;
-        float* y_d = Y_data + c * y_step;
-        int64_t* i_d = I_data ? I_data + c * y_step : nullptr;
-
-        for (int64_t ph = 0; ph < pooled_height; ++ph) {
-          int64_t hstart = ph * stride_h() - pads[0];
-          int64_t hend = std::min(hstart + kernel_shape[0], height);
-          hstart = std::max(hstart, static_cast<int64_t>(0));
-          for (int64_t pw = 0; pw < pooled_width; ++pw) {
-            int64_t wstart = pw * stride_w() - pads[1];
-            int64_t wend = std::min(wstart + kernel_shape[1], width);
-            wstart = std::max(wstart, static_cast<int64_t>(0));
-            for (int64_t pd = 0; pd < pooled_depth; ++pd) {
-              int64_t dstart = pd * stride_d() - pads[2];
-              int64_t dend = std::min(dstart + kernel_shape[2], depth);
-              dstart = std::max(dstart, static_cast<int64_t>(0));
-              const int64_t pool_index =
-                  ph * pooled_width * pooled_depth + pw * pooled_depth + pd;
-              float Yh = std::numeric_limits<float>::lowest();
-              int64_t h_index = -1;
-              int64_t w_index = -1;
-              int64_t d_index = -1;
-              for (int64_t h = hstart; h < hend; ++h) {
-                for (int64_t w = wstart; w < wend; ++w) {
-                  for (int64_t d = dstart; d < dend; ++d) {
-                    const int64_t input_index = h * width * depth + w * depth + d;
-                    if (x_d[input_index] > Yh) {
-                      Yh = x_d[input_index];
-                      h_index = h;
-                      w_index = w;
-                      d_index = d;
+      concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), total_channels, static_cast<double>(y_step * kernel_shape[0] * kernel_shape[1] * kernel_shape[2]), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t c = first; c < last; ++c) {
+          const float* x_d = X_data + c * x_step;
+          const float* y_d = Y_data + c * y_step;
+          int64_t* i_d = I_data + c * y_step;
+
+          for (int64_t ph = 0; ph < pooled_height; ++ph) {
+            int64_t hstart = ph * stride_h() - pads[0];
+            int64_t hend = std::min(hstart + kernel_shape[0], height);
+            hstart = std::max(hstart, static_cast<int64_t>(0));
+            for (int64_t pw = 0; pw < pooled_width; ++pw) {
+              int64_t wstart = pw * stride_w() - pads[1];
+              int64_t wend = std::min(wstart + kernel_shape[1], width);
+              wstart = std::max(wstart, static_cast<int64_t>(0));
+              for (int64_t pd = 0; pd < pooled_depth; ++pd) {
+                int64_t dstart = pd * stride_d() - pads[2];
+                int64_t dend = std::min(dstart + kernel_shape[2], depth);
+                dstart = std::max(dstart, static_cast<int64_t>(0));
+                const int64_t pool_index =
+                    ph * pooled_width * pooled_depth + pw * pooled_depth + pd;
+                const float Yh = y_d[pool_index];
+                int64_t h_index = hstart;
+                int64_t w_index = wstart;
+                int64_t d_index = dstart;
+                bool found = false;
+                for (int64_t h = hstart; h < hend && !found; ++h) {
+                  for (int64_t w = wstart; w < wend && !found; ++w) {
+                    for (int64_t d = dstart; d < dend; ++d) {
+                      if (x_d[h * width * depth + w * depth + d] == Yh) {
+                        h_index = h;
+                        w_index = w;
+                        d_index = d;
+                        found = true;
+                        break;
+                      }
                     }
                   }
                 }
-              }
-              y_d[pool_index] = Yh;
-              if (i_d != nullptr)
                 i_d[pool_index] = storage_order_ == 0 ? c * x_step + h_index * width * depth + w_index * depth + d_index
                                                       : c * x_step + h_index + w_index * height + d_index * height * width;
+              }
             }
           }
         }
-      }
+      });
       break;
     }
     default:
@@ -377,7 +394,7 @@ Status Pool<float, MaxPool<8 /*VERSION*/>>::Compute(OpKernelContext* context) co
   }
 
   return Status::OK();
-}  // namespace onnxruntime
+}
 
 ONNX_CPU_OPERATOR_KERNEL(
     AveragePool,
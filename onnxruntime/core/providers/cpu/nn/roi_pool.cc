@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/nn/roi_pool.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include <cmath>
 
 namespace onnxruntime {
@@ -35,68 +37,96 @@ Status RoiPool<float>::Compute(OpKernelContext* context) const {
 
   float* Ydata = Y->template MutableData<float>();
 
+  const int64_t roi_cols = R->Shape().SizeFromDimension(1);
+  const int64_t x_batch_size = X->Shape().SizeFromDimension(1);
+  const int64_t x_channel_size = X->Shape().SizeFromDimension(2);
+  const int64_t y_channel_size = Y->Shape().SizeFromDimension(2);
+
+  // Validate the ROIs up front so that the parallel loop below cannot fail. The average ROI area
+  // approximates the cost of pooling one channel of one ROI.
+  double roi_area = 0;
   for (int n = 0; n < num_rois; n++) {
-    int roi_batch_id = static_cast<int>(rois[0]);
-    int roi_start_w = static_cast<int>(round(rois[1] * spatial_scale_));
-    int roi_start_h = static_cast<int>(round(rois[2] * spatial_scale_));
-    int roi_end_w = static_cast<int>(round(rois[3] * spatial_scale_));
-    int roi_end_h = static_cast<int>(round(rois[4] * spatial_scale_));
+    const float* roi = rois + n * roi_cols;
+    int roi_batch_id = static_cast<int>(roi[0]);
     ORT_ENFORCE(roi_batch_id >= 0);
     ORT_ENFORCE(roi_batch_id < batch_size);
+    roi_area += std::max(std::abs(roi[3] - roi[1]) * spatial_scale_, 1.0f) *
+                std::max(std::abs(roi[4] - roi[2]) * spatial_scale_, 1.0f);
+  }
+  const double cost = static_cast<double>(y_channel_size) + (num_rois > 0 ? roi_area / num_rois : 0);
+
+  concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_rois) * channels, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    // The bin boundaries only depend on the ROI, so they are shared by all of its channels.
+    std::vector<int> hstarts(pooled_height_), hends(pooled_height_);
+    std::vector<int> wstarts(pooled_width_), wends(pooled_width_);
+    std::ptrdiff_t bins_roi = -1;
+
+    for (std::ptrdiff_t i = first; i < last; ++i) {
+      const std::ptrdiff_t n = i / channels;
+      const std::ptrdiff_t c = i % channels;
+      const float* roi = rois + n * roi_cols;
+
+      if (n != bins_roi) {
+        int roi_start_w = static_cast<int>(round(roi[1] * spatial_scale_));
+        int roi_start_h = static_cast<int>(round(roi[2] * spatial_scale_));
+        int roi_end_w = static_cast<int>(round(roi[3] * spatial_scale_));
+        int roi_end_h = static_cast<int>(round(roi[4] * spatial_scale_));
+
+        // Force malformed ROIs to be 1x1
+        int roi_height = std::max(roi_end_h - roi_start_h + 1, 1);
+        int roi_width = std::max(roi_end_w - roi_start_w + 1, 1);
+
+        const float bin_size_h =
+            static_cast<float>(roi_height) / static_cast<float>(pooled_height_);
+        const float bin_size_w =
+            static_cast<float>(roi_width) / static_cast<float>(pooled_width_);
+
+        // Compute pooling region for each output unit:
+        //  start (included) = floor(ph * roi_height / pooled_height_)
+        //  end (excluded) = ceil((ph + 1) * roi_height / pooled_height_)
+        // then add roi offsets and clip to input boundaries
+        for (int64_t ph = 0; ph < pooled_height_; ++ph) {
+          int hstart = static_cast<int>(floor(static_cast<float>(ph) * bin_size_h));
+          int hend = static_cast<int>(ceil(static_cast<float>(ph + 1) * bin_size_h));
+          hstarts[ph] = std::min(std::max(hstart + roi_start_h, 0), height);
+          hends[ph] = std::min(std::max(hend + roi_start_h, 0), height);
+        }
+        for (int64_t pw = 0; pw < pooled_width_; ++pw) {
+          int wstart = static_cast<int>(floor(static_cast<float>(pw) * bin_size_w));
+          int wend = static_cast<int>(ceil(static_cast<float>(pw + 1) * bin_size_w));
+          wstarts[pw] = std::min(std::max(wstart + roi_start_w, 0), width);
+          wends[pw] = std::min(std::max(wend + roi_start_w, 0), width);
+        }
 
-    // Force malformed ROIs to be 1x1
-    int roi_height = std::max(roi_end_h - roi_start_h + 1, 1);
-    int roi_width = std::max(roi_end_w - roi_start_w + 1, 1);
-
-    const float bin_size_h =
-        static_cast<float>(roi_height) / static_cast<float>(pooled_height_);
-    const float bin_size_w =
-        static_cast<float>(roi_width) / static_cast<float>(pooled_width_);
-
-    const float* batch_data = Xdata + roi_batch_id * X->Shape().SizeFromDimension(1);
-
-    for (int c = 0; c < channels; ++c) {
-      for (int ph = 0; ph < pooled_height_; ++ph) {
-        for (int pw = 0; pw < pooled_width_; ++pw) {
-          // Compute pooling region for this output unit:
-          //  start (included) = floor(ph * roi_height / pooled_height_)
-          //  end (excluded) = ceil((ph + 1) * roi_height / pooled_height_)
-          int hstart =
-              static_cast<int>(floor(static_cast<float>(ph) * bin_size_h));
-          int wstart =
-              static_cast<int>(floor(static_cast<float>(pw) * bin_size_w));
-          int hend =
-              static_cast<int>(ceil(static_cast<float>(ph + 1) * bin_size_h));
-          int wend =
-              static_cast<int>(ceil(static_cast<float>(pw + 1) * bin_size_w));
-
-          // Add roi offsets and clip to input boundaries
-          hstart = std::min(std::max(hstart + roi_start_h, 0), height);
-          hend = std::min(std::max(hend + roi_start_h, 0), height);
-          wstart = std::min(std::max(wstart + roi_start_w, 0), width);
-          wend = std::min(std::max(wend + roi_start_w, 0), width);
-
-          const int pool_index = static_cast<int>(ph * pooled_width_ + pw);
+        bins_roi = n;
+      }
+
+      const float* x_d = Xdata + static_cast<int>(roi[0]) * x_batch_size + c * x_channel_size;
+      float* y_d = Ydata + i * y_channel_size;
+
+      for (int64_t ph = 0; ph < pooled_height_; ++ph) {
+        const int hstart = hstarts[ph];
+        const int hend = hends[ph];
+        for (int64_t pw = 0; pw < pooled_width_; ++pw) {
+          const int wstart = wstarts[pw];
+          const int wend = wends[pw];
 
           // Define an empty pooling region to be zero
-          bool is_empty = (hend <= hstart) || (wend <= wstart);
-          Ydata[pool_index] = is_empty ? 0 : std::numeric_limits<float>::lowest();
+          if ((hend <= hstart) || (wend <= wstart)) {
+            y_d[ph * pooled_width_ + pw] = 0;
+            continue;
+          }
 
+          // Each row of the pooling region is contiguous, so reduce it with MLAS.
+          float y = std::numeric_limits<float>::lowest();
           for (int h = hstart; h < hend; ++h) {
-            for (int w = wstart; w < wend; ++w) {
-              const int index = h * width + w;
-              Ydata[pool_index] = std::max(batch_data[index], Ydata[pool_index]);
-            }
+            y = std::max(MlasReduceMaximum(x_d + h * width + wstart, static_cast<size_t>(wend - wstart)), y);
           }
+          y_d[ph * pooled_width_ + pw] = y;
         }
       }
-      // Increment all data pointers by one channel
-      batch_data += X->Shape().SizeFromDimension(2);
-      Ydata += Y->Shape().SizeFromDimension(2);
     }
-    // Increment ROI data pointer
-    rois += R->Shape().SizeFromDimension(1);
-  }
+  });
 
   return Status::OK();
 }
@@ -2,7 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/reduction/reduction_ops.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
+
+#include <algorithm>
+#include <functional>
 using namespace std;
 namespace onnxruntime {
 
@@ -34,391 +38,445 @@ REGISTER_UNARY_ELEMENTWISE_KERNEL(ReduceSumSquare, 1);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMax, 1);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMin, 1);
 
-// When all reduce axises located at the tail of the dims, quite general cases, transpose and extra
-// copy could be skiped to improve performance, if required by check_no_transpose = true;
-// return value: true means transposedInputData is not created/copied, input tensor data could
-//               be direct use as row major matrix [block_size, blocks], where blocks is the
-//               size of each reduce.
-template <typename T>
-bool PrepareForReduce(OpKernelContext* ctx,
-                      std::vector<T>& transposedInputData,
-                      Tensor** reducedTensor,
-                      int64_t& block_size,
-                      int64_t& blocks,
-                      const std::vector<int64_t>& axes_,
-                      bool keepdims_,
-                      bool check_no_transpose = false) {
-  const Tensor* input_tensor_ptr = ctx->Input<Tensor>(0);
-  ORT_ENFORCE(input_tensor_ptr != nullptr);
-  const Tensor& input = *input_tensor_ptr;
 
-  size_t ndim = input.Shape().GetDims().size();
-  for (int64_t axe : axes_) {
-    ORT_ENFORCE(axe >= 0 && axe < (int64_t)ndim, "Axis attribute out of range");
-  }
-
-  std::vector<int64_t> axes = axes_;
-  if (axes.empty()) {
-    // This is the default case for non-arg kind reductions. Reduce on all dimensions.
-    for (size_t i = 0; i < ndim; i++)
-      axes.push_back(i);
+namespace {
+
+// Describes how to walk the input of a reduction in place instead of materializing a transposed copy.
+// Adjacent axes of the same kind (kept or reduced) are merged and unit axes are dropped, so the input
+// becomes an interleaving of kept and reduced blocks. The innermost block is either a contiguous run of
+// reduced elements (inner_kept == 1) or a contiguous run of kept elements (reduced_run == 1).
+struct ReducePlan {
+  std::vector<int64_t> output_dims;
+  // kept blocks other than the innermost one, outermost first. used to locate the start of an output row.
+  std::vector<int64_t> outer_dims;
+  std::vector<int64_t> outer_strides;
+  int64_t outer_count = 1;
+  int64_t inner_kept = 1;
+  int64_t reduced_run = 1;
+  int64_t reduced_count = 1;
+  // input offset of every reduced run relative to the start of an output row, in row-major order
+  IAllocatorUniquePtr<int64_t> reduced_offsets;
+  int64_t num_reduced_offsets = 0;
+
+  int64_t OuterOffset(int64_t index) const {
+    int64_t offset = 0;
+    for (size_t i = outer_dims.size(); i-- > 0;) {
+      offset += (index % outer_dims[i]) * outer_strides[i];
+      index /= outer_dims[i];
+    }
+    return offset;
   }
+};
 
-  std::sort(axes.begin(), axes.end());
+// Number of output columns handled by one task when the innermost axis is kept. The accumulators for
+// a block stay in L1 while the reduced rows are streamed through.
+constexpr int64_t kReduceColumnBlock = 512;
 
-  // If all reduced axes are located at the tail of the input shape, then copy could be skipped is required
-  bool need_copy = true;
-  if (axes.size() <= ndim && axes.front() == static_cast<int64_t>(ndim - axes.size()) 
-      && axes.back() == static_cast<int64_t>(ndim) - 1) {
-    need_copy = false;
+Status PrepareForReduce(OpKernelContext* ctx,
+                        const std::vector<int64_t>& axes,
+                        bool keepdims,
+                        ReducePlan& plan,
+                        Tensor** reduced) {
+  const Tensor* input_tensor_ptr = ctx->Input<Tensor>(0);
+  ORT_ENFORCE(input_tensor_ptr != nullptr);
+  const std::vector<int64_t>& in_dims = input_tensor_ptr->Shape().GetDims();
+  const size_t ndim = in_dims.size();
+
+  // an empty axes list is the default for the non-arg reductions and means reduce over all dimensions
+  std::vector<bool> reduce_axis(ndim, axes.empty());
+  for (int64_t axis : axes) {
+    ORT_ENFORCE(axis >= 0 && axis < static_cast<int64_t>(ndim), "Axis attribute out of range");
+    reduce_axis[axis] = true;
   }
 
-  vector<bool> keep_axis(ndim, true);
-  for (auto i : axes) {
-    keep_axis[i] = false;
+  for (size_t i = 0; i < ndim; ++i) {
+    if (!reduce_axis[i]) {
+      plan.output_dims.push_back(in_dims[i]);
+    } else if (keepdims) {
+      plan.output_dims.push_back(1);
+    }
   }
 
-  //transpose the input so that all to-be-reduced axes are at the head
-  vector<int64_t> transposed_axes(axes.begin(), axes.end());
-  for (int i = 0; i < ndim; ++i) {
-    if (keep_axis[i]) {
-      transposed_axes.push_back(i);
+  // merge the axes into blocks, innermost first
+  struct Block {
+    int64_t size;
+    int64_t stride;
+    bool reduced;
+  };
+  std::vector<Block> blocks;
+  int64_t stride = 1;
+  for (size_t i = ndim; i-- > 0;) {
+    const int64_t dim = in_dims[i];
+    if (reduce_axis[i]) {
+      plan.reduced_count *= dim;
+    }
+    if (dim != 1) {
+      if (!blocks.empty() && blocks.back().reduced == reduce_axis[i]) {
+        blocks.back().size *= dim;
+      } else {
+        blocks.push_back({dim, stride, reduce_axis[i]});
+      }
     }
+    stride *= dim;
   }
 
-  vector<int64_t> new_dims_(transposed_axes.size());
-  for (int i = 0; i < transposed_axes.size(); ++i) {
-    new_dims_[i] = input.Shape().GetDims().at(transposed_axes[i]);
+  std::vector<Block> reduced_blocks;
+  for (size_t b = blocks.size(); b-- > 0;) {
+    const Block& block = blocks[b];
+    if (b == 0) {
+      if (block.reduced) {
+        plan.reduced_run = block.size;
+      } else {
+        plan.inner_kept = block.size;
+      }
+    } else if (block.reduced) {
+      reduced_blocks.push_back(block);
+    } else {
+      plan.outer_dims.push_back(block.size);
+      plan.outer_strides.push_back(block.stride);
+      plan.outer_count *= block.size;
+    }
   }
 
-  int num_axes = static_cast<int>(transposed_axes.size());
-  auto in_dims = input.Shape().GetDims();
-
-  // Measure amount of contiguous data we can copy at once
-  int64_t blocksize = 1;
-  int n_shared_idxs = 0;
-  for (int i = num_axes - 1; i >= 0; --i) {
-    if (transposed_axes[i] == i) {
-      blocksize *= new_dims_[i];
-      ++n_shared_idxs;
-    } else {
-      break;
+  plan.num_reduced_offsets = plan.reduced_run == 0 ? 0 : plan.reduced_count / plan.reduced_run;
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+  plan.reduced_offsets = IAllocator::MakeUniquePtr<int64_t>(alloc, std::max<int64_t>(plan.num_reduced_offsets, 1));
+  int64_t* offsets = plan.reduced_offsets.get();
+  for (int64_t n = 0; n < plan.num_reduced_offsets; ++n) {
+    int64_t offset = 0;
+    int64_t index = n;
+    for (size_t b = reduced_blocks.size(); b-- > 0;) {
+      offset += (index % reduced_blocks[b].size) * reduced_blocks[b].stride;
+      index /= reduced_blocks[b].size;
     }
+    offsets[n] = offset;
   }
 
-  const T* from_data = input.template Data<T>();
-  size_t count = input.Shape().Size();
+  *reduced = ctx->Output(0, plan.output_dims);
+  return Status::OK();
+}
 
-  //set to-be-reduced axes to one. squeeze is keepdims_ is false
-  int64_t first_dim = 1;
-  std::vector<int64_t> reduced_dims;
-  for (int i = 0; i < in_dims.size(); i++) {
-    if (keep_axis[i]) {
-      reduced_dims.push_back(in_dims[i]);
-    } else {
-      first_dim *= in_dims[i];
-      if (keepdims_) {
-        reduced_dims.push_back(1);
-      }
-    }
+// Runs fn(task) for every task in [0, count), spreading the tasks across the threads of tp.
+// cost_per_task is the approximate number of input elements a task reads.
+template <typename F>
+void ForEachReduceTask(concurrency::ThreadPool* tp, int64_t count, int64_t cost_per_task, F&& fn) {
+  concurrency::ThreadPool::TryParallelFor(tp, count, static_cast<double>(cost_per_task),
+                                          [&fn](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                            for (std::ptrdiff_t i = first; i < last; ++i) {
+                                              fn(i);
+                                            }
+                                          });
+}
+
+// The aggregators describe a reduction to ReduceWithPlan:
+//  Init      - value of an empty reduction
+//  Reduce    - reduces a contiguous run of input values to a single value
+//  Merge     - combines two partial results
+//  MergeRow  - combines a contiguous run of input values element-wise into a row of partial results
+//  Finalize  - produces the output value from the partial result and the number of reduced elements
+template <typename T>
+struct ReduceAggregatorSum {
+  static T Init() { return 0; }
+  static T Reduce(const T* data, int64_t n) { return ConstEigenVectorMap<T>(data, n).sum(); }
+  static T Merge(T acc, T v) { return acc + v; }
+  static void MergeRow(T* acc, const T* data, int64_t n) {
+    EigenVectorMap<T>(acc, n) += ConstEigenVectorMap<T>(data, n);
   }
+  static T Finalize(T acc, int64_t) { return acc; }
+};
 
-  *reducedTensor = ctx->Output(0, reduced_dims);
-  block_size = input.Shape().Size() / first_dim;
-  blocks = first_dim;
+template <typename T>
+struct ReduceAggregatorMean : ReduceAggregatorSum<T> {
+  static T Finalize(T acc, int64_t count) { return acc / static_cast<T>(count); }
+};
+
+template <typename T>
+struct ReduceAggregatorLogSum : ReduceAggregatorSum<T> {
+  static T Finalize(T acc, int64_t) { return static_cast<T>(std::log(acc)); }
+};
 
-  if (!need_copy && check_no_transpose) {
-    return true;
+template <typename T>
+struct ReduceAggregatorL1 : ReduceAggregatorSum<T> {
+  static T Reduce(const T* data, int64_t n) { return ConstEigenVectorArrayMap<T>(data, n).abs().sum(); }
+  static void MergeRow(T* acc, const T* data, int64_t n) {
+    EigenVectorArrayMap<T>(acc, n) += ConstEigenVectorArrayMap<T>(data, n).abs();
   }
+};
 
-  transposedInputData.resize(input.Shape().Size(), 0);
-  T* to_data = &transposedInputData[0];
-  if (num_axes < 2 || n_shared_idxs == num_axes) {
-    memcpy(to_data, from_data, count * sizeof(T));
-    return false;
+template <typename T>
+struct ReduceAggregatorSumSquare : ReduceAggregatorSum<T> {
+  static T Reduce(const T* data, int64_t n) { return ConstEigenVectorMap<T>(data, n).squaredNorm(); }
+  static void MergeRow(T* acc, const T* data, int64_t n) {
+    EigenVectorArrayMap<T>(acc, n) += ConstEigenVectorArrayMap<T>(data, n).square();
   }
+};
 
-  int itr_axes = num_axes - n_shared_idxs;
+template <typename T>
+struct ReduceAggregatorL2 : ReduceAggregatorSumSquare<T> {
+  static T Finalize(T acc, int64_t) { return static_cast<T>(std::sqrt(acc)); }
+};
 
-  // Calculate strides
-  std::vector<int64_t> stride_x(itr_axes, 0);
-  for (size_t i = 0; i < itr_axes; i++) {
-    stride_x[i] = 1;
-    for (size_t j = transposed_axes[i] + 1; j < itr_axes; j++) {
-      stride_x[i] *= in_dims[j];
-    }
+template <typename T>
+struct ReduceAggregatorProd {
+  static T Init() { return 1; }
+  static T Reduce(const T* data, int64_t n) { return ConstEigenVectorMap<T>(data, n).prod(); }
+  static T Merge(T acc, T v) { return acc * v; }
+  static void MergeRow(T* acc, const T* data, int64_t n) {
+    EigenVectorArrayMap<T>(acc, n) *= ConstEigenVectorArrayMap<T>(data, n);
   }
+  static T Finalize(T acc, int64_t) { return acc; }
+};
 
-  std::vector<int64_t> itr_idxs(itr_axes, 0);
+template <typename T>
+struct ReduceAggregatorMax {
+  static T Init() { return std::numeric_limits<T>::lowest(); }
+  static T Reduce(const T* data, int64_t n) { return ConstEigenVectorMap<T>(data, n).maxCoeff(); }
+  static T Merge(T acc, T v) { return std::max(acc, v); }
+  static void MergeRow(T* acc, const T* data, int64_t n) {
+    EigenVectorArrayMap<T> acc_map(acc, n);
+    acc_map = acc_map.max(ConstEigenVectorArrayMap<T>(data, n));
+  }
+  static T Finalize(T acc, int64_t) { return acc; }
+};
 
-  // Branch here to avoid branching within the loop
-  if (blocksize > 1) {
-    for (size_t index = 0; index < (count / blocksize); index++) {
-      int64_t from_index = 0;
-      for (int i = 0; i < itr_axes; ++i) {
-        from_index += stride_x[i] * itr_idxs[i];
+template <typename T>
+struct ReduceAggregatorMin {
+  static T Init() { return std::numeric_limits<T>::max(); }
+  static T Reduce(const T* data, int64_t n) { return ConstEigenVectorMap<T>(data, n).minCoeff(); }
+  static T Merge(T acc, T v) { return std::min(acc, v); }
+  static void MergeRow(T* acc, const T* data, int64_t n) {
+    EigenVectorArrayMap<T> acc_map(acc, n);
+    acc_map = acc_map.min(ConstEigenVectorArrayMap<T>(data, n));
+  }
+  static T Finalize(T acc, int64_t) { return acc; }
+};
+
+// Reduces input into output following plan. When the innermost axis is reduced each task produces one
+// output value from contiguous runs of input. Otherwise each task produces a block of adjacent output
+// values by merging contiguous input rows into them, which keeps the inner loop vectorized.
+template <typename T, typename Agg>
+void ReduceWithPlan(concurrency::ThreadPool* tp, const ReducePlan& plan, const T* input, T* output) {
+  const int64_t* offsets = plan.reduced_offsets.get();
+
+  if (plan.inner_kept == 1) {
+    ForEachReduceTask(tp, plan.outer_count, plan.reduced_count, [&](int64_t o) {
+      const T* base = input + plan.OuterOffset(o);
+      T acc = Agg::Init();
+      for (int64_t k = 0; k < plan.num_reduced_offsets; ++k) {
+        acc = Agg::Merge(acc, Agg::Reduce(base + offsets[k], plan.reduced_run));
       }
+      output[o] = Agg::Finalize(acc, plan.reduced_count);
+    });
+    return;
+  }
+
+  const int64_t column_blocks = (plan.inner_kept + kReduceColumnBlock - 1) / kReduceColumnBlock;
+  ForEachReduceTask(tp, plan.outer_count * column_blocks, plan.num_reduced_offsets * kReduceColumnBlock, [&](int64_t task) {
+    const int64_t o = task / column_blocks;
+    const int64_t column = (task % column_blocks) * kReduceColumnBlock;
+    const int64_t width = std::min(kReduceColumnBlock, plan.inner_kept - column);
+    const T* base = input + plan.OuterOffset(o) + column;
+    T* row = output + o * plan.inner_kept + column;
+    std::fill_n(row, width, Agg::Init());
+    for (int64_t k = 0; k < plan.num_reduced_offsets; ++k) {
+      Agg::MergeRow(row, base + offsets[k], width);
+    }
+    for (int64_t j = 0; j < width; ++j) {
+      row[j] = Agg::Finalize(row[j], plan.reduced_count);
+    }
+  });
+}
 
-      memcpy(
-          to_data + blocksize * index,
-          from_data + blocksize * from_index,
-          blocksize * sizeof(T));
+template <typename T, typename Agg>
+Status ReduceCompute(OpKernelContext* ctx, const std::vector<int64_t>& axes, bool keepdims) {
+  ReducePlan plan;
+  Tensor* reduced;
+  ORT_RETURN_IF_ERROR(PrepareForReduce(ctx, axes, keepdims, plan, &reduced));
+  ReduceWithPlan<T, Agg>(ctx->GetOperatorThreadPool(), plan, ctx->Input<Tensor>(0)->template Data<T>(),
+                         reduced->template MutableData<T>());
+  return Status::OK();
+}
+
+// Finds the index of the first maximum (or minimum if Greater is std::less) along the single reduced axis.
+template <typename T, typename Greater>
+Status ArgReduceCompute(OpKernelContext* ctx, const std::vector<int64_t>& axes, bool keepdims) {
+  ReducePlan plan;
+  Tensor* reduced;
+  ORT_RETURN_IF_ERROR(PrepareForReduce(ctx, axes, keepdims, plan, &reduced));
+
+  const T* input = ctx->Input<Tensor>(0)->template Data<T>();
+  int64_t* output = reduced->template MutableData<int64_t>();
+  const int64_t* offsets = plan.reduced_offsets.get();
+  const Greater greater;
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  if (plan.num_reduced_offsets == 0) {
+    std::fill_n(output, plan.outer_count * plan.inner_kept, 0);
+    return Status::OK();
+  }
 
-      ++itr_idxs[itr_axes - 1];
-      for (int i = itr_axes - 1; i >= 1; --i) {
-        auto expected_dim = new_dims_[i];
-        if (itr_idxs[i] < expected_dim) {
-          break;
+  if (plan.inner_kept == 1) {
+    ForEachReduceTask(tp, plan.outer_count, plan.reduced_count, [&](int64_t o) {
+      const T* base = input + plan.OuterOffset(o);
+      T best = base[offsets[0]];
+      int64_t best_index = 0;
+      for (int64_t k = 0; k < plan.num_reduced_offsets; ++k) {
+        const T* run = base + offsets[k];
+        for (int64_t i = 0; i < plan.reduced_run; ++i) {
+          if (greater(run[i], best)) {
+            best = run[i];
+            best_index = k * plan.reduced_run + i;
+          }
         }
-        itr_idxs[i] %= expected_dim;
-        ++itr_idxs[i - 1];
       }
-    }
-  } else {
-    for (size_t index = 0; index < count; index++) {
-      int64_t from_index = 0;
-      for (int i = 0; i < itr_axes; ++i) {
-        from_index += stride_x[i] * itr_idxs[i];
-      }
-
-      *(to_data + index) = *(from_data + from_index);
+      output[o] = best_index;
+    });
+    return Status::OK();
+  }
 
-      ++itr_idxs[itr_axes - 1];
-      for (int i = itr_axes - 1; i >= 1; --i) {
-        auto expected_dim = new_dims_[i];
-        if (itr_idxs[i] < expected_dim) {
-          break;
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+  auto best_values = IAllocator::MakeUniquePtr<T>(alloc, plan.outer_count * plan.inner_kept);
+  T* best = best_values.get();
+
+  const int64_t column_blocks = (plan.inner_kept + kReduceColumnBlock - 1) / kReduceColumnBlock;
+  ForEachReduceTask(tp, plan.outer_count * column_blocks, plan.num_reduced_offsets * kReduceColumnBlock, [&](int64_t task) {
+    const int64_t o = task / column_blocks;
+    const int64_t column = (task % column_blocks) * kReduceColumnBlock;
+    const int64_t width = std::min(kReduceColumnBlock, plan.inner_kept - column);
+    const T* base = input + plan.OuterOffset(o) + column;
+    T* best_row = best + o * plan.inner_kept + column;
+    int64_t* index_row = output + o * plan.inner_kept + column;
+    std::copy_n(base + offsets[0], width, best_row);
+    std::fill_n(index_row, width, 0);
+    for (int64_t k = 1; k < plan.num_reduced_offsets; ++k) {
+      const T* data = base + offsets[k];
+      for (int64_t j = 0; j < width; ++j) {
+        if (greater(data[j], best_row[j])) {
+          best_row[j] = data[j];
+          index_row[j] = k;
         }
-        itr_idxs[i] %= expected_dim;
-        ++itr_idxs[i - 1];
       }
     }
-  }
-  return false;
+  });
+
+  return Status::OK();
 }
 
+}  // namespace
+
 template <typename T>
 Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).cwiseAbs().rowwise().sum();
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorL1<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().norm();
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorL2<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  for (int j = 0; j < block_size; ++j) {
-    *(output_data) = static_cast<T>(std::log(*(output_data)));
-    ++output_data;
-  }
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorLogSum<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+  ReducePlan plan;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
+  ORT_RETURN_IF_ERROR(PrepareForReduce(ctx, axes_, keepdims_, plan, &reduced));
+
+  const T* input = ctx->Input<Tensor>(0)->template Data<T>();
+  T* output = reduced->template MutableData<T>();
+  const int64_t* offsets = plan.reduced_offsets.get();
+
+  // the maximum is subtracted before exponentiating so large inputs don't overflow
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  ReduceWithPlan<T, ReduceAggregatorMax<T>>(tp, plan, input, output);
+
+  if (plan.inner_kept == 1) {
+    ForEachReduceTask(tp, plan.outer_count, plan.reduced_count, [&](int64_t o) {
+      const T* base = input + plan.OuterOffset(o);
+      const T max_value = output[o];
+      T scaled_exp_sum = 0;
+      for (int64_t k = 0; k < plan.num_reduced_offsets; ++k) {
+        const T* run = base + offsets[k];
+        for (int64_t i = 0; i < plan.reduced_run; ++i) {
+          scaled_exp_sum += static_cast<T>(std::exp(run[i] - max_value));
+        }
+      }
+      output[o] = static_cast<T>(std::log(scaled_exp_sum) + max_value);
+    });
+    return Status::OK();
+  }
 
-  for (int j = 0; j < block_size; ++j) {
-    T max_value = std::numeric_limits<T>::lowest();
-    for (int i = 0; i < blocks; ++i) {
-      max_value = std::max(max_value, transposedInputData[i * block_size + j]);
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+  auto exp_sums = IAllocator::MakeUniquePtr<T>(alloc, plan.outer_count * plan.inner_kept);
+  T* sums = exp_sums.get();
+
+  const int64_t column_blocks = (plan.inner_kept + kReduceColumnBlock - 1) / kReduceColumnBlock;
+  ForEachReduceTask(tp, plan.outer_count * column_blocks, plan.num_reduced_offsets * kReduceColumnBlock, [&](int64_t task) {
+    const int64_t o = task / column_blocks;
+    const int64_t column = (task % column_blocks) * kReduceColumnBlock;
+    const int64_t width = std::min(kReduceColumnBlock, plan.inner_kept - column);
+    const T* base = input + plan.OuterOffset(o) + column;
+    T* max_row = output + o * plan.inner_kept + column;
+    T* sum_row = sums + o * plan.inner_kept + column;
+    std::fill_n(sum_row, width, static_cast<T>(0));
+    for (int64_t k = 0; k < plan.num_reduced_offsets; ++k) {
+      const T* data = base + offsets[k];
+      for (int64_t j = 0; j < width; ++j) {
+        sum_row[j] += static_cast<T>(std::exp(data[j] - max_row[j]));
+      }
     }
-    T scaled_exp_sum = 0;
-    for (int i = 0; i < blocks; ++i) {
-      scaled_exp_sum += static_cast<T>(std::exp(transposedInputData[i * block_size + j] - max_value));
+    for (int64_t j = 0; j < width; ++j) {
+      max_row[j] = static_cast<T>(std::log(sum_row[j]) + max_row[j]);
     }
-    *(output_data++) = static_cast<T>(std::log(scaled_exp_sum) + max_value);
-  }
+  });
+
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().maxCoeff();
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorMax<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).mean();
-    }
-  }
-  else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().mean();
-  }
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorMean<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceMin<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().minCoeff();
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorMin<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceProd<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().prod();
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorProd<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceSum<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).sum();
-    }
-  }
-  else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  }
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorSum<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().squaredNorm();
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorSumSquare<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  int64_t* output_data = reduced->template MutableData<int64_t>();
-
-  Eigen::MatrixXf::Index maxIndex;
-  auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
-  for (int i = 0; i < block_size; ++i) {
-    matrixData.row(i).maxCoeff(&maxIndex);
-    *(output_data++) = maxIndex;
-  }
-
-  return Status::OK();
+  return ArgReduceCompute<T, std::greater<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ArgMin<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  int64_t* output_data = reduced->template MutableData<int64_t>();
-
-  Eigen::MatrixXf::Index minIndex;
-  auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
-  for (int i = 0; i < block_size; ++i) {
-    matrixData.row(i).minCoeff(&minIndex);
-    *(output_data++) = minIndex;
-  }
-
-  return Status::OK();
+  return ArgReduceCompute<T, std::less<T>>(ctx, axes_, keepdims_);
 }
 
 }  // namespace onnxruntime
@@ -186,8 +186,8 @@ class UniDirectionalGru {
   void Compute(const gsl::span<const T>& inputs,
                const gsl::span<const int>& sequence_lengths,
                const int num_directions,
-               const gsl::span<const T>& input_weights,
-               const gsl::span<const T>& recurrent_weights,
+               const GemmWeights<T>& input_weights,
+               const GemmWeights<T>& recurrent_weights,
                gsl::span<T>& outputs,
                gsl::span<T>& final_hidden_state);
 
@@ -294,8 +294,15 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   auto& logger = context.Logger();
 
   const Tensor& X = *context.Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
-  const Tensor& W = *context.Input<Tensor>(1);  // weights. [num_directions, 3*hidden_size, input_size]
-  const Tensor& R = *context.Input<Tensor>(2);  // recurrence weights. [num_directions, 3*hidden_size, hidden_size]
+
+  // weights. [num_directions, 3*hidden_size, input_size]
+  // recurrence weights. [num_directions, 3*hidden_size, hidden_size]
+  // not read if they were quantized when the kernel was created, as they may have been released then
+  const bool quantized = !quantized_input_weights_.empty();
+  const Tensor* W = quantized ? nullptr : context.Input<Tensor>(1);
+  const Tensor* R = quantized ? nullptr : context.Input<Tensor>(2);
+  const TensorShape& W_shape = quantized ? quantized_input_weights_shape_ : W->Shape();
+  const TensorShape& R_shape = quantized ? quantized_recurrent_weights_shape_ : R->Shape();
 
   // optional
   const Tensor* B = context.Input<Tensor>(3);              // bias. [num_directions, 6*hidden_size]
@@ -308,7 +315,8 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   int batch_size = gsl::narrow<int>(X_shape[1]);
   int input_size = gsl::narrow<int>(X_shape[2]);
 
-  auto status = ValidateCommonRnnInputs(X, W, R, B, 3, sequence_lens, initial_h, num_directions_, hidden_size_);
+  auto status = ValidateCommonRnnInputs(X, W_shape, R_shape, B, 3, sequence_lens, initial_h,
+                                        num_directions_, hidden_size_);
   ORT_RETURN_IF_ERROR(status);
 
   // GRU outputs are optional but must be in the same order
@@ -321,8 +329,8 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   AllocatorPtr alloc;
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
-  gsl::span<const T> input_weights = W.DataAsSpan<T>();
-  gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
+  gsl::span<const T> input_weights = W != nullptr ? W->DataAsSpan<T>() : gsl::span<const T>();
+  gsl::span<const T> recurrent_weights = R != nullptr ? R->DataAsSpan<T>() : gsl::span<const T>();
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
 
   // spans for first direction
@@ -330,8 +338,21 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   const size_t recurrent_weights_size_per_direction = 3 * hidden_size_ * hidden_size_;
   const size_t bias_size_per_direction = 6 * hidden_size_;
 
-  gsl::span<const T> input_weights_1 = input_weights.subspan(0, input_weights_size_per_direction);
-  gsl::span<const T> recurrent_weights_1 = recurrent_weights.subspan(0, recurrent_weights_size_per_direction);
+  // weights for a direction. use the quantized weights if we have them
+  auto direction_weights = [&](int direction, GemmWeights<T>& W_direction, GemmWeights<T>& R_direction) {
+    if (quantized) {
+      W_direction = GemmWeights<T>(quantized_input_weights_[direction]);
+      R_direction = GemmWeights<T>(quantized_recurrent_weights_[direction]);
+    } else {
+      W_direction = input_weights.subspan(direction * input_weights_size_per_direction,
+                                          input_weights_size_per_direction);
+      R_direction = recurrent_weights.subspan(direction * recurrent_weights_size_per_direction,
+                                              recurrent_weights_size_per_direction);
+    }
+  };
+
+  GemmWeights<T> input_weights_1, recurrent_weights_1;
+  direction_weights(0, input_weights_1, recurrent_weights_1);
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
 
   gsl::span<const T> input = X.DataAsSpan<T>();
@@ -366,10 +387,8 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
 
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
-    gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
-                                                               input_weights_size_per_direction);
-    gsl::span<const T> recurrent_weights_2 = recurrent_weights.subspan(recurrent_weights_size_per_direction,
-                                                                       recurrent_weights_size_per_direction);
+    GemmWeights<T> input_weights_2, recurrent_weights_2;
+    direction_weights(1, input_weights_2, recurrent_weights_2);
     gsl::span<const T> bias_2 = bias.empty() ? bias : bias.subspan(bias_size_per_direction, bias_size_per_direction);
 
     gsl::span<const T> initial_hidden_2 = initial_hidden.empty()
@@ -462,6 +481,40 @@ DumpMatrix("Y_h", hidden_output.data(), num_directions_* batch_size, hidden_size
 return Status::OK();
 }  // namespace onnxruntime
 
+void DeepCpuGruOp::QuantizeWeights(const OpKernelInfo& info) {
+  const Tensor* W = nullptr;
+  const Tensor* R = nullptr;
+  ORT_ENFORCE(info.TryGetConstantInput(1, &W) && info.TryGetConstantInput(2, &R),
+              "W and R must be initializers to quantize the weights.");
+  ORT_ENFORCE(W->DataType() == DataTypeImpl::GetType<float>() && R->DataType() == DataTypeImpl::GetType<float>(),
+              "Only float weights can be quantized.");
+
+  auto& W_shape = W->Shape();
+  auto& R_shape = R->Shape();
+  ORT_ENFORCE(W_shape.NumDimensions() == 3 && W_shape[0] == num_directions_ && W_shape[1] == 3 * hidden_size_,
+              "Input W must have shape {", num_directions_, ",", 3 * hidden_size_, ",input_size}. Actual:", W_shape);
+  ORT_ENFORCE(R_shape.NumDimensions() == 3 && R_shape[0] == num_directions_ && R_shape[1] == 3 * hidden_size_ &&
+                  R_shape[2] == hidden_size_,
+              "Input R must have shape {", num_directions_, ",", 3 * hidden_size_, ",", hidden_size_,
+              "}. Actual:", R_shape);
+
+  const auto W_size_per_direction = gsl::narrow<size_t>(W_shape.SizeFromDimension(1));
+  const auto R_size_per_direction = gsl::narrow<size_t>(R_shape.SizeFromDimension(1));
+  quantized_input_weights_shape_ = W_shape;
+  quantized_recurrent_weights_shape_ = R_shape;
+
+  // the recurrent weights of the ZR gates and of the H gate are multiplied separately
+  const size_t hidden_rows = static_cast<size_t>(hidden_size_);
+  quantized_input_weights_.resize(num_directions_);
+  quantized_recurrent_weights_.resize(num_directions_);
+  for (int i = 0; i < num_directions_; ++i) {
+    rnn::detail::QuantizeWeights(W->DataAsSpan<float>().subspan(i * W_size_per_direction, W_size_per_direction),
+                                 gsl::narrow<size_t>(W_shape[2]), {3 * hidden_rows}, quantized_input_weights_[i]);
+    rnn::detail::QuantizeWeights(R->DataAsSpan<float>().subspan(i * R_size_per_direction, R_size_per_direction),
+                                 hidden_rows, {2 * hidden_rows, hidden_rows}, quantized_recurrent_weights_[i]);
+  }
+}
+
 //
 // Implementation of internal helper code
 namespace detail {
@@ -559,8 +612,8 @@ template <typename T>
 void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
                                    const gsl::span<const int>& sequence_lengths_arg,
                                    const int num_directions,
-                                   const gsl::span<const T>& input_weights,
-                                   const gsl::span<const T>& recurrent_weights,
+                                   const GemmWeights<T>& input_weights,
+                                   const GemmWeights<T>& recurrent_weights,
                                    gsl::span<T>& outputs,
                                    gsl::span<T>& final_hidden_state) {
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
@@ -577,11 +630,11 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   }
 
   DumpMatrix("Inputs", inputs.data(), seq_length_ * batch_size_, input_size_);
-  DumpMatrix("input_weights", input_weights.data(), 3 * hidden_size_, input_size_);
-  DumpMatrix("recurrent_weights", recurrent_weights.data(), 3 * hidden_size_, hidden_size_);
+  DumpMatrix("input_weights", input_weights.Weights().data(), 3 * hidden_size_, input_size_);
+  DumpMatrix("recurrent_weights", recurrent_weights.Weights().data(), 3 * hidden_size_, hidden_size_);
 
-  gsl::span<const T> recurrent_weightsZR = recurrent_weights.subspan(0, 2 * hidden_size_ * hidden_size_);
-  gsl::span<const T> recurrent_weightsH = recurrent_weights.subspan(2 * hidden_size_ * hidden_size_, hidden_size_ * hidden_size_);
+  GemmWeights<T> recurrent_weightsZR = recurrent_weights.Subspan(0, 2 * hidden_size_ * hidden_size_);
+  GemmWeights<T> recurrent_weightsH = recurrent_weights.Subspan(2 * hidden_size_ * hidden_size_, hidden_size_ * hidden_size_);
 
   gsl::span<T> original_outputs = outputs;
   const bool output_sequence = !outputs.empty();
@@ -609,14 +662,16 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   float alpha = 1.0f;
   float beta = 0.0f;  // zero out outputZRH_ when calling ComputeGemm.
 
+  QuantizedGemmBuffers quantized_gemm_buffers;
+
   // apply weights to all the inputs
   ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
               inputs.cbegin(), inputs.cend(),
               input_size_,
-              input_weights.cbegin(), input_weights.cend(),
+              input_weights,
               input_size_, beta,
               outputZRH_.begin(), outputZRH_.end(),
-              hidden_size_x3);
+              hidden_size_x3, quantized_gemm_buffers);
 
   DumpMatrix("inputs with weights applied", outputZRH_.data(), seq_length_ * batch_size_ * 3, hidden_size_);
 
@@ -652,6 +707,9 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       if ((row + fused_hidden_rows) > batch_size_)
         local_fused_hidden_rows = batch_size_ - row;
 
+      // each batch of rows is processed on its own thread so needs its own scratch buffers
+      QuantizedGemmBuffers row_quantized_gemm_buffers;
+
       size_t out_added_offset;
       span_T_const_iter prev_Ht = batched_hidden0_.cbegin() + row * hidden_size_;  // Ht-1
       span_T_const_iter prev_Ht_end = batched_hidden0_.cend();
@@ -691,10 +749,10 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         ComputeGemm(local_fused_hidden_rows, hidden_size_x2, hidden_size_, alpha,
                     prev_Ht, prev_Ht_end,
                     hidden_size_,
-                    recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
+                    recurrent_weightsZR,
                     hidden_size_, beta,
                     outputZRH_.begin() + out_added_offset, outputZRH_.end(),
-                    hidden_size_x3);
+                    hidden_size_x3, row_quantized_gemm_buffers);
 
         DumpMatrix("Xt*(W[zr]^T) + Ht-1 * R[zr]" + row_str,
                    outputZRH_.data() + out_added_offset, local_fused_hidden_rows, hidden_size_x2, 0, hidden_size_x3);
@@ -708,10 +766,10 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
           ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
                       prev_Ht, prev_Ht_end,  // Ht-1
                       hidden_size_,
-                      recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
+                      recurrent_weightsH,  // Rh^T
                       hidden_size_, beta,
                       linear_output_local, linear_output_.end(),  // pre: Rbh, post:output
-                      hidden_size_);
+                      hidden_size_, row_quantized_gemm_buffers);
 
           DumpMatrix("Ht-1 * (Rh^T) + Rbh " + row_str, &*linear_output_local, batch_size_, hidden_size_);
         }
@@ -771,10 +829,10 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
           ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
                       cur_h_local, cur_h_local_end,
                       hidden_size_,
-                      recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),
+                      recurrent_weightsH,
                       hidden_size_, beta,
                       outputZRH_.begin() + out_added_offset + hidden_size_x2, outputZRH_.end(),
-                      hidden_size_x3);
+                      hidden_size_x3, row_quantized_gemm_buffers);
         }
 
         DumpMatrix("Xt*(Wh^T) + (" + label + ")" + row_str,
@@ -897,10 +955,10 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
                   prev_Ht, prev_Ht_end,
                   hidden_size_,
-                  recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
+                  recurrent_weightsZR,
                   hidden_size_, beta,
                   outputZRH_.begin() + out_added_offset, outputZRH_.end(),
-                  hidden_size_x3);
+                  hidden_size_x3, quantized_gemm_buffers);
 
       DumpMatrix("Ht-1 * R[zr] + Xt*(W[zr]^T)" + seqno_str,
                  outputZRH_.data() + out_added_offset, batch_size_, hidden_size_x2, 0, hidden_size_x3);
@@ -913,10 +971,10 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
                     prev_Ht, prev_Ht_end,  // Ht-1
                     hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
+                    recurrent_weightsH,  // Rh^T
                     hidden_size_, beta,
                     linear_output_.begin(), linear_output_.end(),  // pre: Rbh, post:output
-                    hidden_size_);
+                    hidden_size_, quantized_gemm_buffers);
 
         DumpMatrix("Ht-1 * (Rh^T) + Rbh " + seqno_str, linear_output_.data(), batch_size_, hidden_size_);
       }
@@ -980,10 +1038,10 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
                     cur_h_local, cur_h_local_end,  // rt (.) Ht-1
                     hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
+                    recurrent_weightsH,  // Rh^T
                     hidden_size_, beta,
                     out_H, outputZRH_.end(),
-                    hidden_size_x3);
+                    hidden_size_x3, quantized_gemm_buffers);
       }
 
       DumpMatrix("Xt*(Wh^T) + (" + label + ")" + seqno_str, outputZRH_.data() + out_added_offset,
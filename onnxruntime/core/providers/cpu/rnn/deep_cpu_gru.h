@@ -13,9 +13,19 @@ namespace onnxruntime {
 
 /// The class represents GRU operator using DeepCPU implementation for
 /// fast inference computation on CPU machines.
-class DeepCpuGruOp final : public OpKernel {
+class DeepCpuGruOp : public OpKernel {
  public:
-  DeepCpuGruOp(const OpKernelInfo& info) : OpKernel(info) {
+  DeepCpuGruOp(const OpKernelInfo& info) : DeepCpuGruOp(info, false) {}
+
+  Status Compute(OpKernelContext* context) const override;
+
+  ~DeepCpuGruOp() override = default;
+
+ protected:
+  // If quantize_weights is true W and R must be initializers. They are quantized to uint8 and packed here and
+  // the gate projections use an integer GEMM. Compute doesn't read W and R then, so that the session can release
+  // them (see KernelDefBuilder::ReleasableInput).
+  DeepCpuGruOp(const OpKernelInfo& info, bool quantize_weights) : OpKernel(info) {
     // required attributes
     std::string direction;
     ORT_ENFORCE(info.GetAttr("direction", &direction).IsOK());
@@ -50,13 +60,14 @@ class DeepCpuGruOp final : public OpKernel {
     activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
                                                      activation_func_alphas,
                                                      activation_func_betas);
-  }
 
-  Status Compute(OpKernelContext* context) const override;
-
-  ~DeepCpuGruOp() override = default;
+    if (quantize_weights)
+      QuantizeWeights(info);
+  }
 
  private:
+  void QuantizeWeights(const OpKernelInfo& info);
+
   rnn::detail::Direction direction_;
   int num_directions_;
 
@@ -66,6 +77,12 @@ class DeepCpuGruOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
+  // W and R for each direction if the weights were quantized when the kernel was created, and their shapes
+  std::vector<rnn::detail::QuantizedWeights> quantized_input_weights_;
+  std::vector<rnn::detail::QuantizedWeights> quantized_recurrent_weights_;
+  TensorShape quantized_input_weights_shape_;
+  TensorShape quantized_recurrent_weights_shape_;
+
   // Threadpool for operator. If concurrent Compute calls are possible, it will be shared
   // across them. mutable due to this.
   // The alternative would be to create a threadpool in each call to Compute but that would incur thread creation
@@ -212,8 +212,8 @@ class UniDirectionalLstm {
   void Compute(const gsl::span<const T>& inputs,
                const gsl::span<const int>& sequence_lengths,
                const int num_directions,
-               const gsl::span<const T>& input_weights,
-               const gsl::span<const T>& recurrent_weights,
+               const GemmWeights<T>& input_weights,
+               const GemmWeights<T>& recurrent_weights,
                gsl::span<T>& outputs,
                gsl::span<T>& final_hidden_state,
                gsl::span<T>& final_cell_state);
@@ -340,8 +340,15 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   auto& logger = context.Logger();
 
   const Tensor& X = *context.Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
-  const Tensor& W = *context.Input<Tensor>(1);  // weights. [num_directions, 4*hidden_size, input_size]
-  const Tensor& R = *context.Input<Tensor>(2);  // recurrence weights. [num_directions, 4*hidden_size, hidden_size]
+
+  // weights. [num_directions, 4*hidden_size, input_size]
+  // recurrence weights. [num_directions, 4*hidden_size, hidden_size]
+  // not read if they were quantized when the kernel was created, as they may have been released then
+  const bool quantized = !quantized_input_weights_.empty();
+  const Tensor* W = quantized ? nullptr : context.Input<Tensor>(1);
+  const Tensor* R = quantized ? nullptr : context.Input<Tensor>(2);
+  const TensorShape& W_shape = quantized ? quantized_input_weights_shape_ : W->Shape();
+  const TensorShape& R_shape = quantized ? quantized_recurrent_weights_shape_ : R->Shape();
 
   // optional
   const Tensor* B = context.Input<Tensor>(3);              // bias. [num_directions, 8*hidden_size]
@@ -356,7 +363,7 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   int batch_size = gsl::narrow<int>(X_shape[1]);
   int input_size = gsl::narrow<int>(X_shape[2]);
 
-  Status status = ValidateInputs(X, W, R, B, sequence_lens, initial_h, initial_c, P, batch_size);
+  Status status = ValidateInputs(X, W_shape, R_shape, B, sequence_lens, initial_h, initial_c, P, batch_size);
   ORT_RETURN_IF_ERROR(status);
 
   // LSTM outputs are optional but must be in the same order
@@ -373,8 +380,8 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
 
-  gsl::span<const T> input_weights = W.DataAsSpan<T>();
-  gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
+  gsl::span<const T> input_weights = W != nullptr ? W->DataAsSpan<T>() : gsl::span<const T>();
+  gsl::span<const T> recurrent_weights = R != nullptr ? R->DataAsSpan<T>() : gsl::span<const T>();
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
   gsl::span<const T> peephole_weights = P != nullptr ? P->DataAsSpan<T>() : gsl::span<const T>();
 
@@ -384,8 +391,21 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   const size_t bias_size_per_direction = 8 * hidden_size_;
   const size_t peephole_weights_size_per_direction = 3 * hidden_size_;
 
-  gsl::span<const T> input_weights_1 = input_weights.subspan(0, input_weights_size_per_direction);
-  gsl::span<const T> recurrent_weights_1 = recurrent_weights.subspan(0, hidden_weights_size_per_direction);
+  // weights for a direction. use the quantized weights if we have them
+  auto direction_weights = [&](int direction, GemmWeights<T>& W_direction, GemmWeights<T>& R_direction) {
+    if (quantized) {
+      W_direction = GemmWeights<T>(quantized_input_weights_[direction]);
+      R_direction = GemmWeights<T>(quantized_recurrent_weights_[direction]);
+    } else {
+      W_direction = input_weights.subspan(direction * input_weights_size_per_direction,
+                                          input_weights_size_per_direction);
+      R_direction = recurrent_weights.subspan(direction * hidden_weights_size_per_direction,
+                                              hidden_weights_size_per_direction);
+    }
+  };
+
+  GemmWeights<T> input_weights_1, recurrent_weights_1;
+  direction_weights(0, input_weights_1, recurrent_weights_1);
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
   gsl::span<const T> peephole_weights_1 =
       peephole_weights.empty() ? peephole_weights
@@ -440,10 +460,8 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
 
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
-    gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
-                                                               input_weights_size_per_direction);
-    gsl::span<const T> hidden_weights_2 = recurrent_weights.subspan(hidden_weights_size_per_direction,
-                                                                    hidden_weights_size_per_direction);
+    GemmWeights<T> input_weights_2, hidden_weights_2;
+    direction_weights(1, input_weights_2, hidden_weights_2);
     gsl::span<const T> bias_2 = bias.empty() ? bias : bias.subspan(bias_size_per_direction, bias_size_per_direction);
     gsl::span<const T> peephole_weights_2 =
         peephole_weights.empty() ? peephole_weights
@@ -509,10 +527,44 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   return Status::OK();
 }
 
-Status DeepCpuLstmOp::ValidateInputs(const Tensor& X, const Tensor& W, const Tensor& R, const Tensor* B,
-                                     const Tensor* sequence_lens, const Tensor* initial_h, const Tensor* initial_c,
-                                     const Tensor* P, int batch_size) const {
-  auto status = rnn::detail::ValidateCommonRnnInputs(X, W, R, B, 4, sequence_lens, initial_h,
+void DeepCpuLstmOp::QuantizeWeights(const OpKernelInfo& info) {
+  const Tensor* W = nullptr;
+  const Tensor* R = nullptr;
+  ORT_ENFORCE(info.TryGetConstantInput(1, &W) && info.TryGetConstantInput(2, &R),
+              "W and R must be initializers to quantize the weights.");
+  ORT_ENFORCE(W->DataType() == DataTypeImpl::GetType<float>() && R->DataType() == DataTypeImpl::GetType<float>(),
+              "Only float weights can be quantized.");
+
+  auto& W_shape = W->Shape();
+  auto& R_shape = R->Shape();
+  ORT_ENFORCE(W_shape.NumDimensions() == 3 && W_shape[0] == num_directions_ && W_shape[1] == 4 * hidden_size_,
+              "Input W must have shape {", num_directions_, ",", 4 * hidden_size_, ",input_size}. Actual:", W_shape);
+  ORT_ENFORCE(R_shape.NumDimensions() == 3 && R_shape[0] == num_directions_ && R_shape[1] == 4 * hidden_size_ &&
+                  R_shape[2] == hidden_size_,
+              "Input R must have shape {", num_directions_, ",", 4 * hidden_size_, ",", hidden_size_,
+              "}. Actual:", R_shape);
+
+  const auto W_size_per_direction = gsl::narrow<size_t>(W_shape.SizeFromDimension(1));
+  const auto R_size_per_direction = gsl::narrow<size_t>(R_shape.SizeFromDimension(1));
+  quantized_input_weights_shape_ = W_shape;
+  quantized_recurrent_weights_shape_ = R_shape;
+
+  // the gates are multiplied together
+  const size_t gate_rows = 4 * static_cast<size_t>(hidden_size_);
+  quantized_input_weights_.resize(num_directions_);
+  quantized_recurrent_weights_.resize(num_directions_);
+  for (int i = 0; i < num_directions_; ++i) {
+    rnn::detail::QuantizeWeights(W->DataAsSpan<float>().subspan(i * W_size_per_direction, W_size_per_direction),
+                                 gsl::narrow<size_t>(W_shape[2]), {gate_rows}, quantized_input_weights_[i]);
+    rnn::detail::QuantizeWeights(R->DataAsSpan<float>().subspan(i * R_size_per_direction, R_size_per_direction),
+                                 static_cast<size_t>(hidden_size_), {gate_rows}, quantized_recurrent_weights_[i]);
+  }
+}
+
+Status DeepCpuLstmOp::ValidateInputs(const Tensor& X, const TensorShape& W_shape, const TensorShape& R_shape,
+                                     const Tensor* B, const Tensor* sequence_lens, const Tensor* initial_h,
+                                     const Tensor* initial_c, const Tensor* P, int batch_size) const {
+  auto status = rnn::detail::ValidateCommonRnnInputs(X, W_shape, R_shape, B, 4, sequence_lens, initial_h,
                                                      num_directions_, hidden_size_);
   ORT_RETURN_IF_ERROR(status);
 
@@ -734,8 +786,8 @@ template <typename T>
 void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
                                     const gsl::span<const int>& sequence_lengths_arg,
                                     const int num_directions,
-                                    const gsl::span<const T>& input_weights,
-                                    const gsl::span<const T>& recurrent_weights,
+                                    const GemmWeights<T>& input_weights,
+                                    const GemmWeights<T>& recurrent_weights,
                                     gsl::span<T>& outputs,
                                     gsl::span<T>& final_hidden_state,
                                     gsl::span<T>& final_cell_state) {
@@ -791,14 +843,16 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
   const int hidden_size_x4 = 4 * hidden_size_;
   const int total_rows = max_sequence_length * batch_size_;
 
+  QuantizedGemmBuffers quantized_gemm_buffers;
+
   // apply the weights to all the inputs and save to output_IOFC
   ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
               inputs.cbegin(), inputs.cend(),
               input_size_,
-              input_weights.cbegin(), input_weights.cend(),  // W[iofc]
+              input_weights,  // W[iofc]
               input_size_, beta,
               output_iofc_.begin(), output_iofc_.end(),
-              hidden_size_x4);
+              hidden_size_x4, quantized_gemm_buffers);
 
   DumpMatrix("Xt*(W[iofc]^T)", output_iofc_.data(), total_rows, hidden_size_x4);
 
@@ -832,6 +886,9 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       // after the first step this will switch to the output from the previous step
       span_T_const_iter previous_state = batched_hidden_state_one_step.cbegin() + row * hidden_size_;
 
+      // each batch of rows is processed on its own thread so needs its own scratch buffers
+      QuantizedGemmBuffers row_quantized_gemm_buffers;
+
       // run through steps sequentially
       for (int step = 0; step < max_sequence_length; step++) {
 #if defined(DUMP_MATRIXES)
@@ -844,10 +901,10 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
         ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
                     previous_state, previous_state_end,  // Ht-1
                     hidden_size_,
-                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
+                    recurrent_weights,  // R[iofc]
                     hidden_size_, beta,
                     step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                    hidden_size_x4);
+                    hidden_size_x4, row_quantized_gemm_buffers);
 
         DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str,
                    &*step_out_IOFC, local_fused_hidden_rows, hidden_size_x4);
@@ -917,10 +974,10 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
                   previous_state, previous_state_end,  // Ht-1
                   hidden_size_,
-                  recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
+                  recurrent_weights,  // R[iofc]
                   hidden_size_, beta,
                   step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4);
+                  hidden_size_x4, quantized_gemm_buffers);
 
       span_T_iter batched_output, batched_output_end;
       if (output_sequence) {
@@ -16,9 +16,19 @@ namespace onnxruntime {
 
 /// The class represents DeepCPU implementation of a long short term memory (LSTM) operator.
 /// For details, refer to http://aka.ms/dl-optimization/.
-class DeepCpuLstmOp final : public OpKernel {
+class DeepCpuLstmOp : public OpKernel {
  public:
-  DeepCpuLstmOp(const OpKernelInfo& info)
+  DeepCpuLstmOp(const OpKernelInfo& info) : DeepCpuLstmOp(info, false) {}
+
+  Status Compute(OpKernelContext* context) const override;
+
+  ~DeepCpuLstmOp() override = default;
+
+ protected:
+  // If quantize_weights is true W and R must be initializers. They are quantized to uint8 and packed here and
+  // the gate projections use an integer GEMM. Compute doesn't read W and R then, so that the session can release
+  // them (see KernelDefBuilder::ReleasableInput).
+  DeepCpuLstmOp(const OpKernelInfo& info, bool quantize_weights)
       : OpKernel(info), clip_(info.GetAttrOrDefault<float>("clip", std::numeric_limits<float>::max())) {
     std::string direction;
     ORT_ENFORCE(info.GetAttr("direction", &direction).IsOK());
@@ -52,19 +62,20 @@ class DeepCpuLstmOp final : public OpKernel {
     activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
                                                      activation_func_alphas,
                                                      activation_func_betas);
-  }
 
-  Status Compute(OpKernelContext* context) const override;
-
-  ~DeepCpuLstmOp() override = default;
+    if (quantize_weights)
+      QuantizeWeights(info);
+  }
 
  private:
+  void QuantizeWeights(const OpKernelInfo& info);
+
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
 
   Status ValidateInputs(const Tensor& X,
-                        const Tensor& W,
-                        const Tensor& R,
+                        const TensorShape& W_shape,
+                        const TensorShape& R_shape,
                         const Tensor* B,
                         const Tensor* sequence_lens,
                         const Tensor* initial_h,
@@ -81,6 +92,12 @@ class DeepCpuLstmOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
+  // W and R for each direction if the weights were quantized when the kernel was created, and their shapes
+  std::vector<rnn::detail::QuantizedWeights> quantized_input_weights_;
+  std::vector<rnn::detail::QuantizedWeights> quantized_recurrent_weights_;
+  TensorShape quantized_input_weights_shape_;
+  TensorShape quantized_recurrent_weights_shape_;
+
   // Threadpool for operator. If concurrent Compute calls are possible, it will be shared
   // across them. mutable due to this.
   // The alternative would be to create a threadpool in each call to Compute but that would incur thread creation
@@ -13,6 +13,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/rnn/rnn_activation_functors.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
@@ -24,8 +25,8 @@ namespace detail {
 using namespace ::onnxruntime::common;
 
 Status ValidateCommonRnnInputs(const Tensor& X,
-                               const Tensor& W,
-                               const Tensor& R,
+                               const TensorShape& W_shape,
+                               const TensorShape& R_shape,
                                const Tensor* B,
                                int WRB_dim_1_multipler,
                                const Tensor* sequence_lens,
@@ -33,8 +34,6 @@ Status ValidateCommonRnnInputs(const Tensor& X,
                                int64_t num_directions,
                                int64_t hidden_size) {
   auto& X_shape = X.Shape();
-  auto& W_shape = W.Shape();
-  auto& R_shape = R.Shape();
 
   int64_t seq_length = X_shape[0];
   int64_t batch_size = X_shape[1];
@@ -203,6 +202,128 @@ void DumpMatrixImpl(const std::string& name, const float* src, int row, int col,
   std::cout << std::endl;
 }
 
+// uint8 quantization parameters for values in [min, max].
+// The range is extended to include 0 so that zero padding and zeroed state are exactly representable.
+static void GetQuantizationParameters(float min, float max, float& scale, uint8_t& zero_point) {
+  min = std::min(min, 0.f);
+  max = std::max(max, 0.f);
+
+  scale = (max - min) / 255.f;
+  if (scale == 0.f) {
+    // all values are 0
+    scale = 1.f;
+  }
+
+  const float zero_point_from_min = -min / scale;
+  zero_point = static_cast<uint8_t>(std::round(std::max(0.f, std::min(255.f, zero_point_from_min))));
+}
+
+static inline uint8_t QuantizeValue(float value, float scale, uint8_t zero_point) {
+  const float quantized = std::round(value / scale) + zero_point;
+  return static_cast<uint8_t>(std::max(0.f, std::min(255.f, quantized)));
+}
+
+void QuantizeWeights(gsl::span<const float> weights, size_t K, const std::vector<size_t>& part_rows,
+                     QuantizedWeights& quantized) {
+  float min = 0.f;
+  float max = 0.f;
+  if (!weights.empty()) {
+    auto min_max = std::minmax_element(weights.cbegin(), weights.cend());
+    min = *min_max.first;
+    max = *min_max.second;
+  }
+
+  GetQuantizationParameters(min, max, quantized.scale, quantized.zero_point);
+  quantized.K = K;
+  quantized.parts.clear();
+
+  // the weights are B^T for the GEMM, so each part is transposed to B ([K, rows], row major) to be packed
+  std::vector<uint8_t> part_b;
+  size_t first_row = 0;
+  for (size_t rows : part_rows) {
+    ORT_ENFORCE((first_row + rows) * K <= weights.size());
+    part_b.resize(K * rows);
+    const float* w = weights.data() + first_row * K;
+    for (size_t r = 0; r < rows; ++r) {
+      for (size_t k = 0; k < K; ++k) {
+        part_b[k * rows + r] = QuantizeValue(w[r * K + k], quantized.scale, quantized.zero_point);
+      }
+    }
+
+    QuantizedWeights::Part part;
+    part.first_row = first_row;
+    part.rows = rows;
+    part.packed_b.resize(MlasQgemmPackBSize(rows, K));
+    MlasQgemmPackB(rows, K, part_b.data(), rows, quantized.zero_point, false, part.packed_b.data());
+    quantized.parts.push_back(std::move(part));
+
+    first_row += rows;
+  }
+  ORT_ENFORCE(first_row * K == weights.size(), "The parts don't cover all the rows of the weights.");
+}
+
+void QuantizedGemm(int M, int K, float alpha,
+                   const float* A, int lda,
+                   const QuantizedWeights& B, size_t first_part, size_t end_part,
+                   float beta, float* C, int ldc,
+                   QuantizedGemmBuffers& buffers) {
+  // the activations change on every call so they are quantized with the range of the values in A
+  float min = 0.f;
+  float max = 0.f;
+  for (int m = 0; m < M; ++m) {
+    const float* row = A + m * lda;
+    auto min_max = std::minmax_element(row, row + K);
+    min = std::min(min, *min_max.first);
+    max = std::max(max, *min_max.second);
+  }
+
+  float a_scale;
+  uint8_t a_zero_point;
+  GetQuantizationParameters(min, max, a_scale, a_zero_point);
+
+  size_t N = 0;
+  for (size_t i = first_part; i < end_part; ++i) {
+    N += B.parts[i].rows;
+  }
+
+  buffers.quantized_a.resize(static_cast<size_t>(M) * K);
+  buffers.result.resize(static_cast<size_t>(M) * N);
+
+  uint8_t* quantized_a = buffers.quantized_a.data();
+  for (int m = 0; m < M; ++m) {
+    const float* row = A + m * lda;
+    for (int k = 0; k < K; ++k) {
+      *quantized_a++ = QuantizeValue(row[k], a_scale, a_zero_point);
+    }
+  }
+
+  // each part fills its columns of the result. the zero point of B was applied when it was packed
+  size_t n = 0;
+  for (size_t i = first_part; i < end_part; ++i) {
+    const auto& part = B.parts[i];
+    MlasQgemmPacked(static_cast<size_t>(M), part.rows, static_cast<size_t>(K),
+                    buffers.quantized_a.data(), static_cast<size_t>(K), a_zero_point,
+                    part.packed_b.data(), buffers.result.data() + n, N);
+    n += part.rows;
+  }
+
+  const float multiplier = alpha * a_scale * B.scale;
+  const int32_t* acc = buffers.result.data();
+  for (int m = 0; m < M; ++m) {
+    float* c = C + m * ldc;
+    if (beta == 0.f) {
+      for (size_t j = 0; j < N; ++j) {
+        c[j] = multiplier * acc[j];
+      }
+    } else {
+      for (size_t j = 0; j < N; ++j) {
+        c[j] = multiplier * acc[j] + beta * c[j];
+      }
+    }
+    acc += N;
+  }
+}
+
 namespace deepcpu {
 
 const float alpha_1 = 4.89352455891786e-03f;
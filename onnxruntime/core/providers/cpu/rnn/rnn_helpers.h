@@ -79,9 +79,10 @@ gsl::span<TAlloc> Allocate(std::shared_ptr<IAllocator> allocator,
 }
 
 // validate the common inputs to RNN, LSTM and GRU operators
+// W and R are passed by shape as the kernels that quantize them don't read them after they are created
 Status ValidateCommonRnnInputs(const Tensor& X,
-                               const Tensor& W,
-                               const Tensor& R,
+                               const TensorShape& W_shape,
+                               const TensorShape& R_shape,
                                const Tensor* B,
                                int WRB_dim_1_multipler,  // multiplier used with hidden_size for W, R and B inputs
                                const Tensor* sequence_lens,
@@ -180,6 +181,127 @@ void ComputeGemm(const int M,
       &*C, ldc, &CPUMathUtil::Instance());
 }
 
+// Weights for one direction quantized to uint8 with a single scale and zero point, and packed for MlasQgemmPacked.
+// The float weights are [N, K] row major. Their rows are packed in parts that are multiplied on their own,
+// e.g. the ZR and H gates of the GRU recurrent weights.
+struct QuantizedWeights {
+  struct Part {
+    size_t first_row = 0;
+    size_t rows = 0;
+    std::vector<uint8_t> packed_b;
+  };
+
+  std::vector<Part> parts;
+  size_t K = 0;
+  float scale = 1.f;
+  uint8_t zero_point = 0;
+};
+
+// Quantize weights [N, K] once and pack them in parts of part_rows rows, so the gate projections can use an
+// integer GEMM.
+void QuantizeWeights(gsl::span<const float> weights, size_t K, const std::vector<size_t>& part_rows,
+                     QuantizedWeights& quantized);
+
+// Scratch space used to quantize the activations and hold the integer GEMM result.
+// Owned by the caller so it can be reused across the steps of a sequence.
+struct QuantizedGemmBuffers {
+  std::vector<uint8_t> quantized_a;
+  std::vector<int32_t> result;
+};
+
+// C = alpha * A * dequantize(B)^T + beta * C
+// A (M x K) is quantized on the fly to uint8, multiplied with the parts [first_part, end_part) of the pre-quantized
+// B as integers, and the result is scaled back to float. The columns of C are the rows of the parts.
+void QuantizedGemm(int M, int K, float alpha,
+                   const float* A, int lda,
+                   const QuantizedWeights& B, size_t first_part, size_t end_part,
+                   float beta, float* C, int ldc,
+                   QuantizedGemmBuffers& buffers);
+
+// Weights used by the gate GEMMs. Either the float weights from the input tensor, or a view over
+// parts of the weights that were quantized when the kernel was created.
+template <typename T>
+class GemmWeights {
+ public:
+  GemmWeights() = default;
+
+  GemmWeights(gsl::span<const T> weights) : weights_(weights) {}
+
+  GemmWeights(const QuantizedWeights& quantized)
+      : quantized_(&quantized), end_part_(quantized.parts.size()) {}
+
+  bool IsQuantized() const { return quantized_ != nullptr; }
+
+  gsl::span<const T> Weights() const { return weights_; }
+  const QuantizedWeights& Quantized() const { return *quantized_; }
+  size_t FirstPart() const { return first_part_; }
+  size_t EndPart() const { return end_part_; }
+
+  // the quantized weights can only be split at the boundaries of their parts
+  GemmWeights Subspan(size_t offset, size_t count) const {
+    GemmWeights sub = *this;
+    if (IsQuantized()) {
+      const size_t K = quantized_->K;
+      ORT_ENFORCE(K > 0 && offset % K == 0 && count % K == 0);
+      const size_t first_row = quantized_->parts[first_part_].first_row + offset / K;
+      const size_t end_row = first_row + count / K;
+      sub.first_part_ = sub.end_part_ = end_part_;
+      for (size_t i = first_part_; i < end_part_; ++i) {
+        const auto& part = quantized_->parts[i];
+        if (part.first_row == first_row)
+          sub.first_part_ = i;
+        if (part.first_row + part.rows == end_row)
+          sub.end_part_ = i + 1;
+      }
+      ORT_ENFORCE(sub.first_part_ < sub.end_part_ && sub.end_part_ <= end_part_,
+                  "The quantized weights aren't packed in parts for rows ", first_row, " to ", end_row);
+    } else {
+      sub.weights_ = weights_.subspan(offset, count);
+    }
+    return sub;
+  }
+
+ private:
+  gsl::span<const T> weights_;
+  const QuantizedWeights* quantized_ = nullptr;
+  size_t first_part_ = 0;
+  size_t end_part_ = 0;
+};
+
+// ComputeGemm for GemmWeights. Dispatches to the integer GEMM if the weights were quantized.
+template <typename TSpanAIter, typename T, typename TSpanCIter>
+void ComputeGemm(const int M,
+                 const int N,
+                 const int K,
+                 const float alpha,
+                 TSpanAIter A,
+                 TSpanAIter A_end,
+                 const int lda,
+                 const GemmWeights<T>& B,
+                 const int ldb,
+                 const float beta,
+                 TSpanCIter C,
+                 TSpanCIter C_end,
+                 const int ldc,
+                 QuantizedGemmBuffers& buffers) {
+  if (!B.IsQuantized()) {
+    ComputeGemm(M, N, K, alpha, A, A_end, lda, B.Weights().cbegin(), B.Weights().cend(), ldb, beta, C, C_end, ldc);
+    return;
+  }
+
+  const auto& quantized = B.Quantized();
+  const size_t rows = quantized.parts[B.EndPart() - 1].first_row + quantized.parts[B.EndPart() - 1].rows -
+                      quantized.parts[B.FirstPart()].first_row;
+  ORT_ENFORCE(lda >= K && ldb == K && ldc >= N);
+  ORT_ENFORCE(static_cast<size_t>(K) == quantized.K && static_cast<size_t>(N) == rows);
+  ORT_ENFORCE(A + (M * lda - (lda - K)) <= A_end);
+  ORT_ENFORCE(C + (M * ldc - (ldc - N)) <= C_end);
+
+  QuantizedGemm(M, K, alpha, &*A, lda,
+                quantized, B.FirstPart(), B.EndPart(),
+                beta, &*C, ldc, buffers);
+}
+
 // helper to convert a span to a raw pointer
 // after validating the memory covered by the span supports the size required
 template <typename T>
@@ -7,11 +7,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
-#include "Eigen/src/Core/arch/CUDA/Half.h"
-
-#if defined(USE_MLAS) && defined(_M_AMD64)
 #include "core/mlas/inc/mlas.h"
-#endif
 
 namespace onnxruntime {
 
@@ -27,10 +23,9 @@ inline void CastData(const Tensor* in, Tensor* out, const TensorShape& shape) {
 template <>
 inline void CastData<float, MLFloat16>(const Tensor* in, Tensor* out, const TensorShape& shape) {
   auto out_data = out->template MutableData<MLFloat16>();
+  auto in_data = in->template Data<float>();
   auto shape_size = shape.Size();
-  auto in_vector = ConstEigenVectorMap<float>(in->template Data<float>(), shape_size);
-  auto output_vector = EigenVectorMap<Eigen::half>(static_cast<Eigen::half*>(static_cast<void*>(out_data)), shape_size);
-  output_vector = in_vector.template cast<Eigen::half>();
+  MlasConvertFloatToHalfBuffer(in_data, &out_data[0].val, shape_size);
 }
 
 template <>
@@ -38,13 +33,7 @@ inline void CastData<MLFloat16, float>(const Tensor* in, Tensor* out, const Tens
   auto out_data = out->template MutableData<float>();
   auto in_data = in->template Data<MLFloat16>();
   auto shape_size = shape.Size();
-#if defined(USE_MLAS) && defined(_M_AMD64)
   MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
-#else
-  auto in_vector = ConstEigenVectorMap<Eigen::half>(static_cast<const Eigen::half*>(static_cast<const void*>(in_data)), shape_size);
-  auto output_vector = EigenVectorMap<float>(out_data, shape_size);
-  output_vector = in_vector.template cast<float>();
-#endif
 }
 
 template <typename SrcType,
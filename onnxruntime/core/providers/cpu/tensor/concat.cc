@@ -4,6 +4,8 @@
 #include "core/providers/cpu/tensor/concat.h"
 #include "core/providers/common.h"
 
+#include <algorithm>
+
 namespace onnxruntime {
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -83,28 +85,47 @@ Status Concat::Compute(OpKernelContext* ctx) const {
 
   auto is_string_type = ctx->Input<Tensor>(0)->DataType() == DataTypeImpl::GetType<std::string>();
 
-  int64_t output_offset = 0;
   auto element_bytes = p.output_tensor->DataType()->Size();
-  for (int input_index = 0; input_index < input_count; input_index++) {
-    const auto& prep = p.inputs[input_index];
-    auto input_axis_pitch = prep.axis_pitch;
-    const uint8_t* input = static_cast<const uint8_t*>(prep.tensor->DataRaw());
-    auto input_size = prep.tensor->Shape().Size();
-
-    // Copy the data across. For every 'input_axis_pitch' values copied, we move over by the 'output_axis_pitch'
-    uint8_t* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
-    for (int idxCopy = 0; idxCopy < input_size / input_axis_pitch; ++idxCopy) {
-      if (is_string_type) {
-        for (int idxItem = 0; idxItem < input_axis_pitch; ++idxItem)
-          reinterpret_cast<std::string*>(output)[output_offset + idxCopy * p.output_axis_pitch + idxItem] =
-              reinterpret_cast<const std::string*>(input)[idxCopy * input_axis_pitch + idxItem];
-      } else
-        memcpy(
-            output + (output_offset + idxCopy * p.output_axis_pitch) * element_bytes,
-            input + idxCopy * input_axis_pitch * element_bytes,
-            input_axis_pitch * element_bytes);
+  uint8_t* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
+  int64_t output_size = p.output_tensor->Shape().Size();
+  if (output_size == 0) {
+    return Status::OK();
+  }
+
+  // The output is written sequentially: for each of the 'outer_count' blocks of 'output_axis_pitch' values, the
+  // next 'input_axis_pitch' values of each input are appended in turn.
+  int64_t outer_count = output_size / p.output_axis_pitch;
+
+  // An input that the allocation planner placed in its slice of the output buffer is already in place.
+  std::vector<bool> in_place(input_count, false);
+  if (outer_count == 1 && !is_string_type) {
+    int64_t output_offset = 0;
+    for (int input_index = 0; input_index < input_count; input_index++) {
+      const auto& prep = p.inputs[input_index];
+      in_place[input_index] = prep.tensor->DataRaw() == output + output_offset * element_bytes;
+      output_offset += prep.axis_pitch;
+    }
+  }
+
+  for (int64_t outer = 0; outer < outer_count; outer++) {
+    for (int input_index = 0; input_index < input_count; input_index++) {
+      const auto& prep = p.inputs[input_index];
+      int64_t input_axis_pitch = prep.axis_pitch;
+      if (input_axis_pitch == 0) {
+        continue;
+      }
+
+      if (!in_place[input_index]) {
+        if (is_string_type) {
+          const std::string* input = prep.tensor->Data<std::string>() + outer * input_axis_pitch;
+          std::copy(input, input + input_axis_pitch, reinterpret_cast<std::string*>(output));
+        } else {
+          const uint8_t* input = static_cast<const uint8_t*>(prep.tensor->DataRaw());
+          memcpy(output, input + outer * input_axis_pitch * element_bytes, input_axis_pitch * element_bytes);
+        }
+      }
+      output += input_axis_pitch * element_bytes;
     }
-    output_offset += input_axis_pitch;
   }
   return Status::OK();
 }
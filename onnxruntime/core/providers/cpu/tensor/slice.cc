@@ -13,7 +13,10 @@ namespace onnxruntime {
       Slice,                                                                            \
       1,                                                                                \
       data_type,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()), \
+      KernelDefBuilder()                                                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>())                \
+          .StridedInput(0)                                                              \
+          .StridedView(0),                                                              \
       Slice<data_type, indice_type, false>);
 
 ADD_TYPED_SLICE_OP(uint8_t,  int64_t);
@@ -36,7 +39,9 @@ ADD_TYPED_SLICE_OP(string,   int64_t);
       1,                                                                                     \
       data_type##_##indice_type,                                                             \
       KernelDefBuilder().TypeConstraint("T",    DataTypeImpl::GetTensorType<data_type>())    \
-                        .TypeConstraint("Tind", DataTypeImpl::GetTensorType<indice_type>()), \
+                        .TypeConstraint("Tind", DataTypeImpl::GetTensorType<indice_type>())  \
+                        .StridedInput(0)                                                     \
+                        .StridedView(0),                                                     \
       Slice<data_type, indice_type, true>);
 
 ADD_TYPED_DYNAMIC_SLICE_OP(uint8_t,  int32_t);
@@ -161,8 +166,24 @@ Status Slice<T, Tind, dynamic>::Compute(OpKernelContext* ctx) const {
   }
 
   TensorShape output_shape(output_dims);
+
+  // The slice starts at the element at 'starts' and keeps the strides of the input
+  auto input_strides = input_tensor.Strides();
+  int64_t input_offset = 0;
+  for (size_t i = 0; i < dimension_count; i++)
+    input_offset += starts[i] * input_strides[i];
+
+  if (ctx->OutputView(0, output_shape, input_tensor, input_offset, input_strides) != nullptr)
+    return Status::OK();
+
   auto& output_tensor = *ctx->Output(0, output_shape);
   auto* output = output_tensor.template MutableData<T>();
+
+  if (!input_tensor.IsContiguous()) {
+    CopyStrided(input_tensor.template Data<T>() + input_offset, output_dims, input_strides, output);
+    return Status::OK();
+  }
+
   const auto* output_end = output + output_shape.Size();
 
   SliceIterator<T> input_iterator(input_tensor, starts, output_dims);
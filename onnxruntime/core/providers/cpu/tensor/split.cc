@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/split.h"
+#include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/common.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
@@ -17,7 +18,9 @@ ONNX_CPU_OPERATOR_KERNEL(
                                       std::vector<MLDataType>{
                                           DataTypeImpl::GetTensorType<float>(),
                                           DataTypeImpl::GetTensorType<double>(),
-                                      }),
+                                      })
+        .StridedInput(0)
+        .StridedView(0),
     Split);
 
 Status Split::Compute(OpKernelContext* context) const {
@@ -85,25 +88,37 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
   int64_t input_offset = 0;
   const T* input_data = input.template Data<T>();
 
+  // Each output starts at its offset along the axis and keeps the strides of the input
+  auto input_strides = input.Strides();
+  int64_t view_offset = 0;
+
   for (int i = 0; i < num_outputs; ++i) {
     // update size of dimension for axis we're splitting on
     auto split_size = gsl::narrow<int>(split_sizes[i]);
     output_dimensions[axis] = split_size;
 
-    Tensor* output = context.Output(i, TensorShape{output_dimensions});
-    T* output_data = output->template MutableData<T>();
-
-    ::onnxruntime::math::CopyMatrix<CPUMathUtil>(
-        sizeof(T),
-        before_dims,                                          // M
-        split_size * after_dims_excluding_split,              // N
-        static_cast<const void*>(input_data + input_offset),  // A
-        after_dims_including_split_axis,                      // lda
-        static_cast<void*>(output_data),                      // B
-        split_size * after_dims_excluding_split,              // ldb
-        &CPUMathUtil::Instance());
+    TensorShape output_shape{output_dimensions};
+    if (context.OutputView(i, output_shape, input, view_offset, input_strides) == nullptr) {
+      Tensor* output = context.Output(i, output_shape);
+      T* output_data = output->template MutableData<T>();
+
+      if (!input.IsContiguous()) {
+        CopyStrided(input_data + view_offset, output_dimensions, input_strides, output_data);
+      } else {
+        ::onnxruntime::math::CopyMatrix<CPUMathUtil>(
+            sizeof(T),
+            before_dims,                                          // M
+            split_size * after_dims_excluding_split,              // N
+            static_cast<const void*>(input_data + input_offset),  // A
+            after_dims_including_split_axis,                      // lda
+            static_cast<void*>(output_data),                      // B
+            split_size * after_dims_excluding_split,              // ldb
+            &CPUMathUtil::Instance());
+      }
+    }
 
     input_offset += split_size * after_dims_excluding_split;  // offset by the N data we used in this iteration
+    view_offset += split_size * input_strides[axis];
   }
 
   return Status::OK();
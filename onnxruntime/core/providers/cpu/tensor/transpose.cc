@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/transpose.h"
+#include "core/providers/cpu/tensor/utils.h"
 #include "core/framework/utils.h"
 
 namespace onnxruntime {
@@ -165,8 +166,23 @@ Status Transpose<float>::Compute(OpKernelContext* ctx) const {
   ComputeOutputShape(X, output_dims, default_perm, p_perm);
 
   TensorShape output_shape{output_dims};
+
+  // The transpose of X is X with its strides permuted
+  auto input_strides = X.Strides();
+  std::vector<int64_t> output_strides(rank);
+  for (size_t i = 0; i < rank; i++)
+    output_strides[i] = input_strides[(*p_perm)[i]];
+
+  if (ctx->OutputView(0, output_shape, X, 0, output_strides) != nullptr)
+    return Status::OK();
+
   Tensor& Y = *ctx->Output(0, output_shape);
 
+  if (!X.IsContiguous()) {
+    CopyStrided(X.Data<float>(), output_dims, output_strides, Y.MutableData<float>());
+    return Status::OK();
+  }
+
   DoTypedTranspose<float>(*p_perm, X, Y);
 
   return Status::OK();
@@ -175,7 +191,10 @@ Status Transpose<float>::Compute(OpKernelContext* ctx) const {
 ONNX_CPU_OPERATOR_KERNEL(
     Transpose,
     1,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .StridedInput(0)
+        .StridedView(0),
     Transpose<float>);
 
 }  // namespace onnxruntime
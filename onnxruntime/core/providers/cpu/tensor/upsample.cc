@@ -2,7 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/upsample.h"
+#include <algorithm>
 #include <math.h>  //for fabs
+#include <type_traits>
+#include "core/platform/threadpool.h"
 
 using namespace ::onnxruntime::common;
 using namespace std;
@@ -22,57 +25,79 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<int32_t>()),
     Upsample<int32_t>);
 
-void upsampleNearest2x(
-    int64_t batch_size,
-    int64_t num_channels,
-    int64_t input_height,
-    int64_t input_width,
-    const float* input,
-    float* output) {
-  const int64_t output_height = input_height * 2;
-  const int64_t output_width = input_width * 2;
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        const int64_t in_y = y / 2;
-        for (int64_t x = 0; x < input_width; ++x) {
-          const float v = input[in_y * input_width + x];
-          const int64_t oidx = output_width * y + x * 2;
-          output[oidx + 0] = v;
-          output[oidx + 1] = v;
-        }
-      }
-      input += input_height * input_width;
-      output += output_height * output_width;
-    }
-  }
-}
-
 template <typename T>
 Status upsampleNearest(const T* input,
                        T* output,
                        const TensorShape& input_shape,
                        const TensorShape& output_shape,
-                       const vector<float>& scales) {
+                       const vector<float>& scales,
+                       concurrency::ThreadPool* tp) {
   if (!input || !output)
     return Status(ONNXRUNTIME, FAIL, "Upsample: input/output value is nullptr");
   if (input_shape.NumDimensions() != output_shape.NumDimensions())
     return Status(ONNXRUNTIME, FAIL, "Upsample: input/output value's dimension mismatch");
-  auto n_dim = input_shape.NumDimensions();
-  for (size_t i = 0, size = output_shape.Size(); i < size; i++) {
-    size_t old_idx = 0;
-    size_t cur_idx = i;
+  const int64_t n_dim = static_cast<int64_t>(input_shape.NumDimensions());
+  if (n_dim == 0) {
+    output[0] = input[0];
+    return Status::OK();
+  }
+  if (output_shape.Size() == 0)
+    return Status::OK();
 
-    int64_t base = 1;
-    for (int64_t j = static_cast<int64_t>(n_dim - 1); j >= 0; j--) {
-      auto tmp = cur_idx % output_shape[j];
-      old_idx += (std::min(static_cast<int64_t>(tmp / scales[j]), input_shape[j] - 1)) * base;
-      base *= input_shape[j];
-      cur_idx /= output_shape[j];
+  // for each axis, the offset in the input of the elements read by each output coordinate along the axis
+  std::vector<std::vector<int64_t>> input_offsets(static_cast<size_t>(n_dim));
+  int64_t input_stride = 1;
+  for (int64_t j = n_dim - 1; j >= 0; j--) {
+    auto& offsets = input_offsets[j];
+    offsets.resize(static_cast<size_t>(output_shape[j]));
+    for (int64_t i = 0; i < output_shape[j]; i++) {
+      offsets[i] = std::min(static_cast<int64_t>(i / scales[j]), input_shape[j] - 1) * input_stride;
     }
-
-    output[i] = input[old_idx];
+    input_stride *= input_shape[j];
   }
+
+  // the output is processed one row of the innermost axis at a time. with an integer scale on that axis each input
+  // element is repeated width_scale times, otherwise the elements are gathered with the offsets.
+  const int64_t input_width = input_shape[n_dim - 1];
+  const int64_t output_width = output_shape[n_dim - 1];
+  const int64_t num_rows = output_shape.Size() / output_width;
+  const auto& width_offsets = input_offsets[n_dim - 1];
+  const auto width_scale = static_cast<int64_t>(scales[n_dim - 1]);
+  const bool integer_width_scale = width_scale == scales[n_dim - 1] && input_width * width_scale == output_width;
+
+  concurrency::ThreadPool::TryParallelFor(tp, num_rows, static_cast<double>(output_width), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    const T* previous_input_row = nullptr;
+    for (int64_t row = first; row < last; row++) {
+      int64_t input_offset = 0;
+      for (int64_t j = n_dim - 2, cur_idx = row; j >= 0; j--) {
+        input_offset += input_offsets[j][cur_idx % output_shape[j]];
+        cur_idx /= output_shape[j];
+      }
+
+      const T* input_row = input + input_offset;
+      T* output_row = output + row * output_width;
+      if (input_row == previous_input_row) {
+        // upsampled along an outer axis, the previous output row has the same content
+        std::copy(output_row - output_width, output_row, output_row);
+      } else if (integer_width_scale && width_scale == 1) {
+        std::copy(input_row, input_row + input_width, output_row);
+      } else if (integer_width_scale && width_scale == 2) {
+        for (int64_t x = 0; x < input_width; x++) {
+          output_row[2 * x] = input_row[x];
+          output_row[2 * x + 1] = input_row[x];
+        }
+      } else if (integer_width_scale) {
+        for (int64_t x = 0; x < input_width; x++) {
+          std::fill_n(output_row + x * width_scale, width_scale, input_row[x]);
+        }
+      } else {
+        for (int64_t x = 0; x < output_width; x++) {
+          output_row[x] = input_row[width_offsets[x]];
+        }
+      }
+      previous_input_row = input_row;
+    }
+  });
   return Status::OK();
 }
 
@@ -132,6 +157,35 @@ Status upsampleLiner(const T* input,
   return Status::OK();
 }
 
+// The input coordinates and the weights of the output coordinates along an axis for the bilinear mode.
+// The weight of coordinate1 is weight2 and the weight of coordinate2 is weight1, the distances to the other one.
+struct BilinearAxisParams {
+  std::vector<int64_t> coordinate1;
+  std::vector<int64_t> coordinate2;
+  std::vector<float> weight1;
+  std::vector<float> weight2;
+
+  BilinearAxisParams(int64_t input_size, int64_t output_size, float scale)
+      : coordinate1(output_size), coordinate2(output_size), weight1(output_size), weight2(output_size) {
+    for (int64_t i = 0; i < output_size; ++i) {
+      float in = std::min(i / scale, static_cast<float>(input_size - 1));
+      coordinate1[i] = std::min(static_cast<int64_t>(in), input_size - 1);
+      coordinate2[i] = std::min(coordinate1[i] + 1, input_size - 1);
+      if (coordinate1[i] == coordinate2[i]) {
+        weight1[i] = 0.5f;
+        weight2[i] = 0.5f;
+      } else {
+        weight1[i] = std::abs(in - coordinate1[i]);
+        weight2[i] = std::abs(in - coordinate2[i]);
+      }
+    }
+  }
+};
+
+// Floating point planes are interpolated separably: the input rows are interpolated along the width once, then
+// each output row blends two of them. Both inner loops are contiguous in the output so they vectorize.
+// Integer planes round the four taps of each output element as a whole, as the result is truncated.
+// The planes are processed in parallel.
 template <typename T>
 void upsampleBilinear(
     int64_t batch_size,
@@ -141,53 +195,72 @@ void upsampleBilinear(
     float height_scale,
     float width_scale,
     const T* Xdata,
-    T* Ydata) {
+    T* Ydata,
+    concurrency::ThreadPool* tp) {
   int64_t output_width = static_cast<int64_t>(input_width * width_scale);
   int64_t output_height = static_cast<int64_t>(input_height * height_scale);
+  if (output_width == 0 || output_height == 0)
+    return;
 
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        float in_y = std::min(y / height_scale, static_cast<float>(input_height - 1));
-        const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
-        const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-        float dy1 = fabs(in_y - in_y1);
-        float dy2 = fabs(in_y - in_y2);
-        if (in_y1 == in_y2) {
-          dy1 = 0.5f;
-          dy2 = 0.5f;
-        }
+  const BilinearAxisParams y_params(input_height, output_height, height_scale);
+  const BilinearAxisParams x_params(input_width, output_width, width_scale);
 
-        const int64_t input_width_mul_y1 = input_width * in_y1;
-        const int64_t input_width_mul_y2 = input_width * in_y2;
+  const int64_t input_plane_size = input_height * input_width;
+  const int64_t output_plane_size = output_height * output_width;
 
-        for (int64_t x = 0; x < output_width; ++x) {
-          float in_x = std::min(x / width_scale, static_cast<float>(input_width - 1));
-          const int64_t in_x1 = std::min(static_cast<int64_t>(in_x), input_width - 1);
-          const int64_t in_x2 = std::min(in_x1 + 1, input_width - 1);
-
-          float dx1 = std::abs(in_x - in_x1);
-          float dx2 = std::abs(in_x - in_x2);
-          if (in_x1 == in_x2) {
-            dx1 = 0.5f;
-            dx2 = 0.5f;
+  concurrency::ThreadPool::TryParallelFor(tp, batch_size * num_channels, static_cast<double>(output_plane_size * 4), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    // the input rows of a plane interpolated along the width
+    std::vector<float> rows;
+    if (std::is_floating_point<T>::value) {
+      rows.resize(static_cast<size_t>(input_height * output_width));
+    }
+
+    for (std::ptrdiff_t plane = first; plane < last; ++plane) {
+      const T* X = Xdata + plane * input_plane_size;
+      T* Y = Ydata + plane * output_plane_size;
+
+      if (!std::is_floating_point<T>::value) {
+        for (int64_t y = 0; y < output_height; ++y) {
+          const T* X_row1 = X + y_params.coordinate1[y] * input_width;
+          const T* X_row2 = X + y_params.coordinate2[y] * input_width;
+          const float dy1 = y_params.weight1[y];
+          const float dy2 = y_params.weight2[y];
+          T* Y_row = Y + y * output_width;
+          for (int64_t x = 0; x < output_width; ++x) {
+            const int64_t in_x1 = x_params.coordinate1[x];
+            const int64_t in_x2 = x_params.coordinate2[x];
+            const float dx1 = x_params.weight1[x];
+            const float dx2 = x_params.weight2[x];
+            Y_row[x] = static_cast<T>(dx2 * dy2 * X_row1[in_x1] +
+                                      dx1 * dy2 * X_row1[in_x2] +
+                                      dx2 * dy1 * X_row2[in_x1] +
+                                      dx1 * dy1 * X_row2[in_x2]);
           }
+        }
+        continue;
+      }
 
-          T X11 = Xdata[input_width_mul_y1 + in_x1];
-          T X21 = Xdata[input_width_mul_y1 + in_x2];
-          T X12 = Xdata[input_width_mul_y2 + in_x1];
-          T X22 = Xdata[input_width_mul_y2 + in_x2];
+      for (int64_t y = 0; y < input_height; ++y) {
+        const T* X_row = X + y * input_width;
+        float* row = rows.data() + y * output_width;
+        for (int64_t x = 0; x < output_width; ++x) {
+          row[x] = x_params.weight2[x] * X_row[x_params.coordinate1[x]] +
+                   x_params.weight1[x] * X_row[x_params.coordinate2[x]];
+        }
+      }
 
-          Ydata[output_width * y + x] = static_cast<T>(dx2 * dy2 * X11 +
-                                                       dx1 * dy2 * X21 +
-                                                       dx2 * dy1 * X12 +
-                                                       dx1 * dy1 * X22);
+      for (int64_t y = 0; y < output_height; ++y) {
+        const float* row1 = rows.data() + y_params.coordinate1[y] * output_width;
+        const float* row2 = rows.data() + y_params.coordinate2[y] * output_width;
+        const float weight1 = y_params.weight2[y];
+        const float weight2 = y_params.weight1[y];
+        T* Y_row = Y + y * output_width;
+        for (int64_t x = 0; x < output_width; ++x) {
+          Y_row[x] = static_cast<T>(weight1 * row1[x] + weight2 * row2[x]);
         }
       }
-      Xdata += input_height * input_width;
-      Ydata += output_width * output_height;
     }
-  }
+  });
 }
 
 template <typename T>
@@ -208,7 +281,8 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context, const std::vector<floa
 
   switch (mode_) {
     case UpsampleMode::NN:
-      return upsampleNearest<T>(X->template Data<T>(), Y->template MutableData<T>(), X->Shape(), Y->Shape(), scales);
+      return upsampleNearest<T>(X->template Data<T>(), Y->template MutableData<T>(), X->Shape(), Y->Shape(), scales,
+                                context->GetOperatorThreadPool());
     case UpsampleMode::LINEAR: {
       //What's the correct behavior of linear mode is not clear right now,
       //Only support bilinear with 4D tensor to keep consistent with previous behavior
@@ -219,7 +293,8 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context, const std::vector<floa
       const int64_t input_height = dims[2], input_width = dims[3];
 
       upsampleBilinear(batch_size, num_channels, input_height, input_width,
-                       scales[2], scales[3], X->template Data<T>(), Y->template MutableData<T>());
+                       scales[2], scales[3], X->template Data<T>(), Y->template MutableData<T>(),
+                       context->GetOperatorThreadPool());
       return Status::OK();
     }
     default:
@@ -189,6 +189,43 @@ struct SliceIterator {
   std::vector<int64_t> indices_;  // There is no index for innermost axis since it's a special case
 };
 
+// Copy the elements of a strided view into a contiguous buffer. 'source' points to the first element of the view
+// and 'strides' holds the number of elements to move by along each axis of 'dims'.
+template <typename T>
+void CopyStrided(const T* source, const std::vector<int64_t>& dims, const std::vector<int64_t>& strides, T* target) {
+  const int64_t rank = static_cast<int64_t>(dims.size());
+  if (rank == 0) {
+    *target = *source;
+    return;
+  }
+  if (std::find(dims.cbegin(), dims.cend(), 0) != dims.cend())
+    return;
+
+  const int64_t inner_extent = dims[rank - 1];
+  const int64_t inner_stride = strides[rank - 1];
+  std::vector<int64_t> indices(rank - 1, 0);  // There is no index for innermost axis since it's a special case
+
+  for (;;) {
+    if (inner_stride == 1) {
+      target = std::copy(source, source + inner_extent, target);
+    } else {
+      for (int64_t i = 0; i < inner_extent; i++)
+        *target++ = source[i * inner_stride];
+    }
+
+    int64_t axis = rank - 2;
+    for (; axis >= 0; --axis) {
+      source += strides[axis];
+      if (++indices[axis] != dims[axis])
+        break;
+      source -= strides[axis] * dims[axis];
+      indices[axis] = 0;
+    }
+    if (axis < 0)
+      break;
+  }
+}
+
 inline void CopyCpuTensor(const Tensor* src, Tensor* tgt) {
   void* target = tgt->MutableDataRaw();
   const void* source = src->DataRaw();
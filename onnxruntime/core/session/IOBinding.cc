@@ -45,12 +45,43 @@ static common::Status AllocateHelper(const SessionState& session_state,
   return Status::OK();
 }
 
+// Copies a string tensor in the compact layout to std::string elements for the kernels that read std::string.
+static common::Status ExpandCompactStringTensor(const SessionState& session_state,
+                                                const MLValue& orig_mlvalue,
+                                                MLValue& new_mlvalue) {
+  auto* p_provider = session_state.GetExecutionProviders().Get(onnxruntime::kCpuExecutionProvider);
+  ORT_ENFORCE(p_provider);
+  auto allocator = p_provider->GetAllocator(0, OrtMemTypeDefault);
+  ORT_ENFORCE(allocator != nullptr);
+  auto& orig_tensor = orig_mlvalue.Get<Tensor>();
+  std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(orig_tensor.DataType(),
+                                                              orig_tensor.Shape(),
+                                                              allocator->Alloc(orig_tensor.Size()),
+                                                              allocator->Info(),
+                                                              allocator);
+  auto* dst = p_tensor->MutableData<std::string>();
+  for (int64_t i = 0, len = orig_tensor.Shape().Size(); i < len; ++i) {
+    auto element = orig_tensor.StringElement(i);
+    dst[i].assign(element.data(), element.size());
+  }
+  new_mlvalue.Init(p_tensor.release(),
+                   DataTypeImpl::GetType<Tensor>(),
+                   DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+
+  return Status::OK();
+}
+
 // TODO should we handle the case of one input name feeding 2 nodes placed on different
 // devices.
 common::Status IOBinding::CopyOneInputAcrossDevices(const SessionState& session_state,
                                                     const std::string& input_name,
                                                     const MLValue& orig_mlvalue,
                                                     MLValue& new_mlvalue) {
+  if (orig_mlvalue.IsTensor() && orig_mlvalue.Get<Tensor>().IsCompactString() &&
+      !session_state.AcceptsCompactStringInput(input_name)) {
+    return ExpandCompactStringTensor(session_state, orig_mlvalue, new_mlvalue);
+  }
+
   //TODO: make it configurable
   const int target_device_id = 0;
   std::vector<SessionState::NodeInfo> node_info_vec;
@@ -151,15 +182,27 @@ static std::pair<bool, size_t> Contains(const std::vector<std::string>& output_n
 common::Status IOBinding::BindOutput(const std::string& name, const MLValue& ml_value) {
   auto rc = Contains(output_names_, name);
   if (rc.first) {
+    bound_outputs_[rc.second] = ml_value;
     outputs_[rc.second] = ml_value;
     return Status::OK();
   }
 
   output_names_.push_back(name);
+  bound_outputs_.push_back(ml_value);
   outputs_.push_back(ml_value);
   return Status::OK();
 }
 
+void IOBinding::ClearInputs() {
+  feeds_.clear();
+}
+
+void IOBinding::ClearOutputs() {
+  output_names_.clear();
+  bound_outputs_.clear();
+  outputs_.clear();
+}
+
 const std::vector<std::string>& IOBinding::GetOutputNames() const {
   return output_names_;
 }
@@ -168,6 +211,10 @@ std::vector<MLValue>& IOBinding::GetOutputs() {
   return outputs_;
 }
 
+const std::vector<MLValue>& IOBinding::GetOutputs() const {
+  return outputs_;
+}
+
 const std::unordered_map<std::string, MLValue>& IOBinding::GetInputs() const {
   return feeds_;
 }
@@ -59,14 +59,24 @@ class IOBinding {
   common::Status SynchronizeOutputs();
   /**
     * This simply provides the names and optionally allocated output containers.
+    * A preallocated tensor is written to in place by every Run() so a caller that binds all its outputs
+    * to preallocated buffers doesn't cause any allocation of output memory.
+    * An empty ml_value lets Run() allocate the output, again on every call, so its shape may change between runs.
     */
   common::Status BindOutput(const std::string& name, const MLValue& ml_value);
 
+  /**
+    * Remove all bound inputs or outputs.
+    */
+  void ClearInputs();
+  void ClearOutputs();
+
   /**
     * This simply collects the outputs obtained after calling Run() inside the @param outputs.
     */
   const std::vector<std::string>& GetOutputNames() const;
   std::vector<MLValue>& GetOutputs();
+  const std::vector<MLValue>& GetOutputs() const;
 
   const std::unordered_map<std::string, MLValue>& GetInputs() const;
 
@@ -84,6 +94,8 @@ class IOBinding {
   const SessionState& session_state_;
   std::unordered_map<std::string, MLValue> feeds_;
   std::vector<std::string> output_names_;
+  // what the caller bound, outputs_ is reset to this before each run
+  std::vector<MLValue> bound_outputs_;
   std::vector<MLValue> outputs_;
 
   static common::Status CopyOneInputAcrossDevices(const SessionState& session_state,
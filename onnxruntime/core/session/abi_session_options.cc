@@ -80,6 +80,32 @@ ORT_API(void, OrtDisableCpuMemArena, _In_ OrtSessionOptions* options) {
   options->value.enable_cpu_mem_arena = false;
 }
 
+// cache the graph optimized by the session initialization next to the model file
+ORT_API(void, OrtEnableOptimizedModelCache, _In_ OrtSessionOptions* options) {
+  options->value.enable_optimized_model_cache = true;
+}
+
+ORT_API(void, OrtDisableOptimizedModelCache, _In_ OrtSessionOptions* options) {
+  options->value.enable_optimized_model_cache = false;
+}
+
+// share the initializers with the other sessions of the same model
+ORT_API(void, OrtEnableSharedInitializers, _In_ OrtSessionOptions* options) {
+  options->value.share_initializers = true;
+}
+
+ORT_API(void, OrtDisableSharedInitializers, _In_ OrtSessionOptions* options) {
+  options->value.share_initializers = false;
+}
+
+ORT_API(void, OrtSetInitializerStore, _In_ OrtSessionOptions* options, _In_opt_ OrtInitializerStore* store) {
+  if (store == nullptr) {
+    options->value.initializer_store.reset();
+  } else {
+    options->value.initializer_store = *reinterpret_cast<std::shared_ptr<onnxruntime::InitializerStore>*>(store);
+  }
+}
+
 ///< logger id to use for session output
 ORT_API(void, OrtSetSessionLogId, _In_ OrtSessionOptions* options, const char* logid) {
   options->value.session_logid = logid;
@@ -97,6 +123,20 @@ ORT_API(int, OrtSetSessionThreadPoolSize, _In_ OrtSessionOptions* options, int s
   return 0;
 }
 
+///How many threads kernels may use to parallelize a single operator.
+ORT_API(int, OrtSetOperatorThreadPoolSize, _In_ OrtSessionOptions* options, int operator_thread_pool_size) {
+  if (operator_thread_pool_size <= 0) return -1;
+  options->value.operator_thread_pool_size = operator_thread_pool_size;
+  return 0;
+}
+
+///How many threads session initialization may use to load the initializers and create the kernels.
+ORT_API(int, OrtSetLoadThreadPoolSize, _In_ OrtSessionOptions* options, int load_thread_pool_size) {
+  if (load_thread_pool_size <= 0) return -1;
+  options->value.load_thread_pool_size = load_thread_pool_size;
+  return 0;
+}
+
 ORT_API(void, OrtAppendCustomOpLibPath, _In_ OrtSessionOptions* options, const char* lib_path) {
   options->custom_op_paths.emplace_back(lib_path);
 }
@@ -3,18 +3,29 @@
 
 #ifdef _WIN32
 #pragma warning(disable : 4267)
+#include <windows.h>
 #endif
 
 #include "core/session/inference_session.h"
 
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <functional>
 #include <memory>
 #include "core/platform/ort_mutex.h"
+#include <fstream>
+#include <iterator>
 #include <sstream>
 #include <unordered_set>
 #include <list>
+#include <map>
 
 #include "core/common/logging/logging.h"
 #include "core/common/task_thread_pool.h"
+#include "core/platform/threadpool.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/graph_transformer.h"
 #include "core/graph/graph_transformer_mgr.h"
@@ -25,6 +36,7 @@
 #include "core/framework/environment.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/graph_partitioner.h"
+#include "core/framework/initializer_store.h"
 #include "core/framework/insert_cast_transformer.h"
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/kernel_registry.h"
@@ -39,6 +51,7 @@
 #include "core/framework/tensorutils.h"
 #include "core/framework/transformer_memcpy.h"
 #include "core/framework/utils.h"
+#include "core/platform/env.h"
 #include "core/platform/notification.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/CustomOpsLoader.h"
@@ -50,8 +63,205 @@
 
 using namespace ONNX_NAMESPACE;
 
+#ifndef ORT_VERSION
+#define ORT_VERSION "unknown"
+#endif
+
 namespace onnxruntime {
 
+// metadata of the models saved by SessionOptions::enable_optimized_model_cache
+static const char* const kOptimizedModelCacheKey = "onnxruntime.optimized_model_cache.key";
+static const char* const kOptimizedModelCacheProviders = "onnxruntime.optimized_model_cache.providers";
+static const char* const kOptimizedModelCacheNodeProviders = "onnxruntime.optimized_model_cache.node_providers";
+static const char* const kOptimizedModelCacheModelFile = "onnxruntime.optimized_model_cache.model_file";
+static const char* const kOptimizedModelCacheTransformers = "onnxruntime.optimized_model_cache.transformers";
+
+struct OptimizedModelCacheMetadata {
+  std::string key;                          // version of onnxruntime and hash of the model
+  std::string model_file;                   // size and modification time of the model file
+  std::string transformers;                 // graph transformers the cached model was transformed by
+  std::string providers;                    // execution providers the cached model was partitioned for
+  std::vector<std::string> node_providers;  // execution provider of each node of the cached model
+};
+
+// 64 bit FNV-1a hash, updated with the bytes of each part of the hashed content
+class ContentHasher {
+ public:
+  void Add(const void* data, size_t len) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < len; ++i) {
+      hash_ ^= bytes[i];
+      hash_ *= 1099511628211ULL;
+    }
+  }
+
+  // the length is hashed too so that consecutive strings can't be confused with each other
+  void Add(const std::string& str) {
+    const uint64_t len = str.size();
+    Add(&len, sizeof(len));
+    Add(str.data(), str.size());
+  }
+
+  template <typename T>
+  void Add(const google::protobuf::RepeatedField<T>& values) {
+    const uint64_t len = values.size();
+    Add(&len, sizeof(len));
+    Add(values.data(), values.size() * sizeof(T));
+  }
+
+  std::string ToString() const {
+    std::ostringstream oss;
+    oss << std::hex << hash_;
+    return oss.str();
+  }
+
+ private:
+  uint64_t hash_ = 14695981039346656037ULL;
+};
+
+// hash of the model content
+static std::string HashModel(const std::string& model_bytes) {
+  ContentHasher hasher;
+  hasher.Add(model_bytes.data(), model_bytes.size());
+  return hasher.ToString();
+}
+
+// hash of the content of a loaded graph, read from the graph itself so the model doesn't need to be serialized
+// again. unordered containers are hashed in name order.
+static std::string HashGraph(const Graph& graph) {
+  ContentHasher hasher;
+
+  std::map<std::string, int> opsets(graph.DomainToVersionMap().cbegin(), graph.DomainToVersionMap().cend());
+  for (const auto& opset : opsets) {
+    hasher.Add(opset.first);
+    hasher.Add(&opset.second, sizeof(opset.second));
+  }
+
+  for (const auto* input : graph.GetInputsIncludingInitializers()) {
+    hasher.Add(input->Name());
+  }
+  for (const auto* output : graph.GetOutputs()) {
+    hasher.Add(output->Name());
+  }
+
+  for (const auto& node : graph.Nodes()) {
+    hasher.Add(node.OpType());
+    hasher.Add(node.Domain());
+    for (const auto* def : node.InputDefs()) {
+      hasher.Add(def->Name());
+    }
+    for (const auto* def : node.OutputDefs()) {
+      hasher.Add(def->Name());
+    }
+    // the attributes are small except for subgraphs and Constant values, so they are hashed serialized
+    std::map<std::string, const AttributeProto*> attributes;
+    for (const auto& attribute : node.GetAttributes()) {
+      attributes.emplace(attribute.first, &attribute.second);
+    }
+    for (const auto& attribute : attributes) {
+      hasher.Add(attribute.second->SerializeAsString());
+    }
+  }
+
+  std::map<std::string, const TensorProto*> initializers(graph.GetAllInitializedTensors().cbegin(),
+                                                         graph.GetAllInitializedTensors().cend());
+  for (const auto& initializer : initializers) {
+    const TensorProto& tensor = *initializer.second;
+    hasher.Add(initializer.first);
+    const int32_t data_type = tensor.data_type();
+    hasher.Add(&data_type, sizeof(data_type));
+    hasher.Add(tensor.dims());
+    hasher.Add(tensor.raw_data());
+    hasher.Add(tensor.float_data());
+    hasher.Add(tensor.int32_data());
+    hasher.Add(tensor.int64_data());
+    hasher.Add(tensor.double_data());
+    hasher.Add(tensor.uint64_data());
+    for (const auto& str : tensor.string_data()) {
+      hasher.Add(str);
+    }
+  }
+
+  return hasher.ToString();
+}
+
+// replace the file to with the file from, atomically so that readers of to see either file in full
+static bool ReplaceFileAtomically(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+  return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+  return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+#ifdef _WIN32
+static bool ReplaceFileAtomically(const std::wstring& from, const std::wstring& to) {
+  return MoveFileExW(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+static void RemoveFile(const std::wstring& path) {
+  _wremove(path.c_str());
+}
+#endif
+
+static void RemoveFile(const std::string& path) {
+  std::remove(path.c_str());
+}
+
+// size and modification time of a file, to tell cheaply whether it changed. empty if the file can't be queried.
+static std::string GetFileStamp(const std::string& path) {
+#ifdef _WIN32
+  struct _stat64 file_stat;
+  if (_stat64(path.c_str(), &file_stat) != 0) {
+#else
+  struct stat file_stat;
+  if (stat(path.c_str(), &file_stat) != 0) {
+#endif
+    return {};
+  }
+  return std::to_string(file_stat.st_size) + ";" + std::to_string(file_stat.st_mtime);
+}
+
+#ifdef _WIN32
+static std::string GetFileStamp(const std::wstring& path) {
+  struct _stat64 file_stat;
+  if (_wstat64(path.c_str(), &file_stat) != 0) {
+    return {};
+  }
+  return std::to_string(file_stat.st_size) + ";" + std::to_string(file_stat.st_mtime);
+}
+#endif
+
+// The operator thread pool of the sessions with the default SessionOptions::operator_thread_pool_size, with one
+// thread per hardware thread besides the threads running the operators. It is created with the first of these
+// sessions and destroyed with the last one, so that no threads are left running without sessions.
+static std::shared_ptr<concurrency::ThreadPool> GetSharedOperatorThreadPool() {
+  static OrtMutex mutex;
+  static std::weak_ptr<concurrency::ThreadPool> shared_pool;
+
+  std::lock_guard<OrtMutex> lock(mutex);
+  std::shared_ptr<concurrency::ThreadPool> pool = shared_pool.lock();
+  const int num_threads = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+  if (!pool && num_threads > 0) {
+    pool = std::make_shared<concurrency::ThreadPool>("ORT_operator", num_threads);
+    shared_pool = pool;
+  }
+  return pool;
+}
+
+static std::vector<std::string> SplitString(const std::string& str, char separator) {
+  std::vector<std::string> parts;
+  if (str.empty()) {
+    return parts;
+  }
+  size_t start = 0;
+  for (size_t end; (end = str.find(separator, start)) != std::string::npos; start = end + 1) {
+    parts.push_back(str.substr(start, end - start));
+  }
+  parts.push_back(str.substr(start));
+  return parts;
+}
+
 class InferenceSession::Impl {
  public:
   Impl(const SessionOptions& session_options, logging::LoggingManager* logging_manager)
@@ -80,6 +290,16 @@ class InferenceSession::Impl {
     }
 
     session_state_.SetThreadPool(thread_pool_.get());
+
+    // the thread running an operator takes part in its parallel loops, so the pool needs one thread fewer.
+    // by default the sessions share a pool so that the threads don't multiply with the number of sessions.
+    if (session_options_.operator_thread_pool_size == 0) {
+      operator_thread_pool_ = GetSharedOperatorThreadPool();
+    } else if (session_options_.operator_thread_pool_size > 1) {
+      operator_thread_pool_ = std::make_shared<concurrency::ThreadPool>("ORT_operator",
+                                                                        session_options_.operator_thread_pool_size - 1);
+    }
+    session_state_.SetOperatorThreadPool(operator_thread_pool_.get());
     session_state_.SetEnableMemoryPattern(session_options.enable_mem_pattern);
     session_profiler_.Initialize(session_logger_);
     session_state_.SetProfiler(session_profiler_);
@@ -144,8 +364,12 @@ class InferenceSession::Impl {
       }
 
       std::shared_ptr<onnxruntime::Model> p_tmp_model;
-      ORT_RETURN_IF_ERROR(onnxruntime::Model::Load(model_uri, p_tmp_model,
-                                                   HasLocalSchema() ? &custom_schema_registries_ : nullptr));
+      if (session_options_.enable_optimized_model_cache) {
+        ORT_RETURN_IF_ERROR(LoadWithOptimizedModelCache(model_uri, p_tmp_model));
+      } else {
+        ORT_RETURN_IF_ERROR(onnxruntime::Model::Load(model_uri, p_tmp_model,
+                                                     HasLocalSchema() ? &custom_schema_registries_ : nullptr));
+      }
       model_ = p_tmp_model;
 
       ORT_RETURN_IF_ERROR(DoPostLoadProcessing(*model_.get()));
@@ -158,6 +382,7 @@ class InferenceSession::Impl {
       LOGS(*session_logger_, ERROR) << "Unknown exception in Load()";
       return Status(common::ONNXRUNTIME, common::RUNTIME_EXCEPTION, "Encountered unknown exception in Load()");
     }
+    load_timings_.model_loading = TimeDiffMicroSeconds(tp);
     if (session_profiler_.FEnabled()) {
       session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_loading_uri", tp);
     }
@@ -191,6 +416,7 @@ class InferenceSession::Impl {
       LOGS(*session_logger_, ERROR) << "Unknown exception in Load()";
       return Status(common::ONNXRUNTIME, common::RUNTIME_EXCEPTION, "Encountered unknown exception in Load()");
     }
+    load_timings_.model_loading = TimeDiffMicroSeconds(tp);
     if (session_profiler_.FEnabled()) {
       session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_loading_proto", tp);
     }
@@ -224,6 +450,7 @@ class InferenceSession::Impl {
       LOGS(*session_logger_, ERROR) << "Unknown exception in Load()";
       return Status(common::ONNXRUNTIME, common::RUNTIME_EXCEPTION, "Encountered unknown exception in Load()");
     }
+    load_timings_.model_loading = TimeDiffMicroSeconds(tp);
     if (session_profiler_.FEnabled()) {
       session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_loading_proto", tp);
     }
@@ -263,6 +490,7 @@ class InferenceSession::Impl {
       LOGS(*session_logger_, ERROR) << "Unknown exception in Load()";
       return Status(common::ONNXRUNTIME, common::RUNTIME_EXCEPTION, "Encountered unknown exception in Load()");
     }
+    load_timings_.model_loading = TimeDiffMicroSeconds(tp);
     if (session_profiler_.FEnabled()) {
       session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_loading_istream", tp);
     }
@@ -318,7 +546,8 @@ class InferenceSession::Impl {
   /// @param graph The graph to iterate
   /// @param session_state The SessionState instance for 'graph'.
   /// @remarks We pass in graph and session_state so we can handled nested subgraphs in the future
-  common::Status InitializeSubgraphSessions(Graph& graph, SessionState& session_state) {
+  common::Status InitializeSubgraphSessions(Graph& graph, SessionState& session_state,
+                                            concurrency::ThreadPool* load_thread_pool) {
     for (auto& node : graph.Nodes()) {
       for (auto& attribute : node.GetAttributes()) {
         auto& name = attribute.first;
@@ -333,10 +562,12 @@ class InferenceSession::Impl {
           // create SessionState for executing subgraph
           subgraph_info.session_state = std::make_unique<SessionState>(execution_providers_);
           subgraph_info.session_state->SetProfiler(session_profiler_);
+          subgraph_info.session_state->SetOperatorThreadPool(operator_thread_pool_.get());
 
           // setup everything required to execute the subgraph and save it in subgraph_session_state
           SessionStateInitializer initializer{*subgraph, *subgraph_info.session_state,
-                                              execution_providers_, kernel_registry_manager_, *session_logger_};
+                                              execution_providers_, kernel_registry_manager_, *session_logger_,
+                                              load_thread_pool};
 
           ORT_RETURN_IF_ERROR(initializer.CreatePlan(node.ImplicitInputDefs(),
                                                      session_options_.enable_sequential_execution));
@@ -352,7 +583,7 @@ class InferenceSession::Impl {
           //                                                   &*subgraph_info.session_state);
 
           // recurse
-          ORT_RETURN_IF_ERROR(InitializeSubgraphSessions(*subgraph, *subgraph_info.session_state));
+          ORT_RETURN_IF_ERROR(InitializeSubgraphSessions(*subgraph, *subgraph_info.session_state, load_thread_pool));
 
           // save subgraph_info as InferenceSession owns these so they remain valid
           // for the entire InferenceSession.
@@ -364,7 +595,9 @@ class InferenceSession::Impl {
     return Status::OK();
   }
 
-  common::Status Initialize() {
+  /// @param load_thread_pool pool to initialize the session on. If nullptr a pool sized from
+  /// SessionOptions::load_thread_pool_size is created for the duration of the call.
+  common::Status Initialize(concurrency::ThreadPool* load_thread_pool = nullptr) {
     Status status = Status::OK();
     auto tp = session_profiler_.StartTime();
 
@@ -381,14 +614,65 @@ class InferenceSession::Impl {
         return common::Status::OK();
       }
 
+      // the thread calling Initialize takes part in the parallel loops, so the pool needs one thread fewer
+      std::unique_ptr<concurrency::ThreadPool> owned_load_thread_pool;
+      if (load_thread_pool == nullptr) {
+        int load_pool_size = session_options_.load_thread_pool_size == 0
+                                 ? static_cast<int>(std::thread::hardware_concurrency())
+                                 : session_options_.load_thread_pool_size;
+        if (load_pool_size > 1) {
+          owned_load_thread_pool = std::make_unique<concurrency::ThreadPool>("ORT_load", load_pool_size - 1);
+          load_thread_pool = owned_load_thread_pool.get();
+        }
+      }
+
+      // time a phase of the initialization and start the next one
+      auto phase_tp = session_profiler_.StartTime();
+      auto end_phase = [this, &phase_tp](const char* event_name, long long& duration) {
+        duration = TimeDiffMicroSeconds(phase_tp);
+        if (session_profiler_.FEnabled()) {
+          session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, event_name, phase_tp);
+        }
+        phase_tp = session_profiler_.StartTime();
+      };
+
       // Register default CPUExecutionProvider if user didn't provide it through the Register() calls
       if (!execution_providers_.Get(onnxruntime::kCpuExecutionProvider)) {
         LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
         CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+        epi.enable_conv_autotune = session_options_.enable_conv_autotune;
         execution_providers_.Add(onnxruntime::kCpuExecutionProvider,
                                  std::make_unique<CPUExecutionProvider>(epi));
       }
 
+      // the cached model can be used as is if it was transformed by the same graph transformers and partitioned for
+      // the same execution providers. these are only known now, as they may be registered after Load.
+      bool use_cached_model = false;
+      if (optimized_model_cache_.is_cached_model_loaded) {
+        if (optimized_model_cache_.cached.providers == GetProviderTypes() &&
+            optimized_model_cache_.cached.transformers == graph_transformation_mgr_.Description()) {
+          use_cached_model = true;
+        } else {
+          LOGS(*session_logger_, INFO) << "The optimized model cache is for the execution providers "
+                                       << optimized_model_cache_.cached.providers << " and the graph transformers "
+                                       << optimized_model_cache_.cached.transformers
+                                       << ", loading the original model.";
+          ORT_RETURN_IF_ERROR(optimized_model_cache_.load_original_model(model_));
+          ORT_RETURN_IF_ERROR(DoPostLoadProcessing(*model_));
+          optimized_model_cache_.is_cached_model_loaded = false;
+        }
+      }
+
+      // sessions sharing their initializers look them up in a store, identified by the model content, the
+      // execution providers and the graph transformers if the user didn't provide one, as the transformers may
+      // rewrite initializers without renaming them. must be done before the graph is transformed.
+      initializer_store_ = session_options_.initializer_store;
+      if (!initializer_store_ && session_options_.share_initializers) {
+        initializer_store_ = InitializerStore::GetOrCreate(HashGraph(model_->MainGraph()) + ";" +
+                                                           GetProviderTypes() + ";" +
+                                                           graph_transformation_mgr_.Description());
+      }
+
       onnxruntime::Graph& graph = model_->MainGraph();
 
       // Collect the kernel registries from execution provider instances;
@@ -404,30 +688,49 @@ class InferenceSession::Impl {
       insert_cast_transformer_.AddKernelRegistries(kernel_registry_manager_.GetAllKernelRegistries());
 
       SessionStateInitializer session_initializer{graph, session_state_, execution_providers_,
-                                                  kernel_registry_manager_, *session_logger_};
-
-      // apply any transformations to the main graph and any subgraphs
-      ORT_RETURN_IF_ERROR(TransformGraph(graph, graph_transformation_mgr_,
-                                         execution_providers_, kernel_registry_manager_,
-                                         insert_cast_transformer_,
-                                         session_state_));
+                                                  kernel_registry_manager_, *session_logger_, load_thread_pool};
 
-      ORT_RETURN_IF_ERROR(utils::ForAllMutableSubgraphs(graph, [this](Graph& subgraph) {
-        return TransformGraph(subgraph, graph_transformation_mgr_,
-                              execution_providers_, kernel_registry_manager_,
-                              insert_cast_transformer_,
-                              session_state_);
-      }));
+      if (use_cached_model) {
+        // the cached model is transformed already and only needs the placement of its nodes
+        ApplyCachedNodeProviders(graph);
+      } else {
+        // apply any transformations to the main graph and any subgraphs
+        ORT_RETURN_IF_ERROR(TransformGraph(graph, graph_transformation_mgr_,
+                                           execution_providers_, kernel_registry_manager_,
+                                           insert_cast_transformer_,
+                                           session_state_));
+
+        ORT_RETURN_IF_ERROR(utils::ForAllMutableSubgraphs(graph, [this](Graph& subgraph) {
+          return TransformGraph(subgraph, graph_transformation_mgr_,
+                                execution_providers_, kernel_registry_manager_,
+                                insert_cast_transformer_,
+                                session_state_);
+        }));
+      }
 
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
       ORT_RETURN_IF_ERROR(graph.Resolve());
 
+      if (optimized_model_cache_.save && !use_cached_model) {
+        SaveOptimizedModelCache(graph);
+      }
+      end_phase("graph_transformation", load_timings_.graph_transformation);
+
       ORT_RETURN_IF_ERROR(session_initializer.CreatePlan({}, session_options_.enable_sequential_execution));
-      ORT_RETURN_IF_ERROR(session_initializer.InitializeAndSave(session_state_.GetEnableMemoryPattern(),
-                                                                weights_buffers_));
+      end_phase("plan_creation", load_timings_.plan_creation);
+
+      ORT_RETURN_IF_ERROR(session_initializer.InitializeTensors(session_state_.GetEnableMemoryPattern(),
+                                                                weights_buffers_, initializer_store_.get()));
+      end_phase("initializers_loading", load_timings_.initializers_loading);
+
+      ORT_RETURN_IF_ERROR(session_initializer.CreateKernels());
+      end_phase("kernel_creation", load_timings_.kernel_creation);
 
       // handle any subgraphs
-      ORT_RETURN_IF_ERROR(InitializeSubgraphSessions(graph, session_state_));
+      ORT_RETURN_IF_ERROR(InitializeSubgraphSessions(graph, session_state_, load_thread_pool));
+      end_phase("subgraphs_initialization", load_timings_.subgraphs_initialization);
+
+      ORT_RETURN_IF_ERROR(ValidateStateTensors());
 
       is_inited_ = true;
 
@@ -443,12 +746,17 @@ class InferenceSession::Impl {
       LOGS(*session_logger_, ERROR) << status.ErrorMessage();
     }
 
+    load_timings_.session_initialization = TimeDiffMicroSeconds(tp);
     if (session_profiler_.FEnabled()) {
       session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_initialization", tp);
     }
     return status;
   }
 
+  const SessionLoadTimings& GetLoadTimings() const {
+    return load_timings_;
+  }
+
   int GetCurrentNumRuns() const {
     return current_num_runs_.load();
   }
@@ -873,6 +1181,115 @@ class InferenceSession::Impl {
     return retval;
   }
 
+  common::Status ValidateStateTensors() const {
+    for (const auto& state : session_options_.state_tensors) {
+      if (model_output_names_.find(state.first) == model_output_names_.end()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "State tensor ", state.first, " is not a model output.");
+      }
+      if (model_input_names_.find(state.second) == model_input_names_.end()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "State tensor ", state.second, " is not a model input.");
+      }
+    }
+    return Status::OK();
+  }
+
+  common::Status CreateStream(const std::string& stream_id) {
+    {
+      std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+      if (!is_inited_) {
+        LOGS(*session_logger_, ERROR) << "Session was not initialized";
+        return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+      }
+    }
+
+    auto stream = std::make_shared<StreamState>();
+    stream->values.resize(session_options_.state_tensors.size());
+    stream->spare.resize(session_options_.state_tensors.size());
+
+    std::lock_guard<onnxruntime::OrtMutex> l(streams_mutex_);
+    if (!streams_.insert(std::make_pair(stream_id, std::move(stream))).second) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Stream ", stream_id, " already exists.");
+    }
+    return Status::OK();
+  }
+
+  common::Status ResetStream(const std::string& stream_id) {
+    std::shared_ptr<StreamState> stream;
+    ORT_RETURN_IF_ERROR(GetStream(stream_id, stream));
+
+    std::lock_guard<onnxruntime::OrtMutex> l(stream->mutex);
+    for (auto& value : stream->values) {
+      value = MLValue();
+    }
+    for (auto& value : stream->spare) {
+      value = MLValue();
+    }
+    return Status::OK();
+  }
+
+  common::Status DropStream(const std::string& stream_id) {
+    std::lock_guard<onnxruntime::OrtMutex> l(streams_mutex_);
+    if (streams_.erase(stream_id) == 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unknown stream ", stream_id);
+    }
+    return Status::OK();
+  }
+
+  common::Status Run(const RunOptions& run_options,
+                     const std::string& stream_id,
+                     const NameMLValMap& feeds,
+                     const std::vector<std::string>& output_names,
+                     std::vector<MLValue>* p_fetches) {
+    ORT_RETURN_IF_ERROR(ValidateOutputs(output_names, p_fetches));
+
+    std::shared_ptr<StreamState> stream;
+    ORT_RETURN_IF_ERROR(GetStream(stream_id, stream));
+    std::lock_guard<onnxruntime::OrtMutex> l(stream->mutex);
+
+    const auto& states = session_options_.state_tensors;
+    NameMLValMap stream_feeds(feeds);
+    std::vector<std::string> stream_output_names(output_names);
+    std::vector<MLValue> stream_fetches(*p_fetches);
+    stream_fetches.resize(output_names.size());
+    std::vector<size_t> state_fetch_index(states.size());
+
+    for (size_t i = 0; i < states.size(); ++i) {
+      auto& value = stream->values[i];
+      // an explicitly fed state takes precedence
+      bool fed_state = value.IsAllocated() && stream_feeds.insert(std::make_pair(states[i].second, value)).second;
+
+      auto it = std::find(output_names.cbegin(), output_names.cend(), states[i].first);
+      if (it != output_names.cend()) {
+        state_fetch_index[i] = it - output_names.cbegin();
+        continue;
+      }
+
+      state_fetch_index[i] = stream_output_names.size();
+      stream_output_names.push_back(states[i].first);
+
+      // compute the new state into the buffer of the state before the current one if nothing else refers
+      // to it any more and the state keeps its shape
+      auto& spare = stream->spare[i];
+      if (fed_state && spare.IsAllocated() && spare.IsUnique() && spare.IsTensor() && value.IsTensor() &&
+          spare.Get<Tensor>().Shape() == value.Get<Tensor>().Shape()) {
+        stream_fetches.push_back(spare);
+      } else {
+        stream_fetches.emplace_back();
+      }
+    }
+
+    ORT_RETURN_IF_ERROR(Run(run_options, stream_feeds, stream_output_names, &stream_fetches));
+
+    for (size_t i = 0; i < states.size(); ++i) {
+      stream->spare[i] = stream->values[i];
+      stream->values[i] = stream_fetches[state_fetch_index[i]];
+    }
+
+    stream_fetches.resize(output_names.size());
+    *p_fetches = std::move(stream_fetches);
+    return Status::OK();
+  }
+
   std::pair<common::Status, const ModelMetadata*> GetModelMetadata() const {
     {
       std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
@@ -929,6 +1346,10 @@ class InferenceSession::Impl {
   common::Status Run(const RunOptions& run_options, IOBinding& io_binding) {
     // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
     // io_binding.SynchronizeInputs();
+
+    // drop the outputs allocated by the previous run so that they don't constrain the shapes of this one.
+    // copying the MLValues only adds references, the vector keeps its storage.
+    io_binding.outputs_ = io_binding.bound_outputs_;
     return Run(run_options, io_binding.feeds_, io_binding.output_names_, &io_binding.outputs_);
   }
 
@@ -955,6 +1376,15 @@ class InferenceSession::Impl {
     return std::string();
   }
 
+  void SetActivationObserver(std::shared_ptr<IActivationObserver> observer) {
+    activation_observer_ = std::move(observer);
+    session_state_.SetActivationObserver(activation_observer_.get());
+  }
+
+  const SessionState& GetSessionState() const {
+    return session_state_;
+  }
+
  private:
   static std::pair<bool, size_t> Contains(const std::vector<std::string>& output_names,
                                           const std::string& name) {
@@ -970,6 +1400,217 @@ class InferenceSession::Impl {
   }
 
   // assumes model has already been loaded before
+  // the types of the registered execution providers, in the order of preference
+  std::string GetProviderTypes() const {
+    std::string provider_types;
+    for (const auto& provider : execution_providers_) {
+      if (!provider_types.empty()) {
+        provider_types += ',';
+      }
+      provider_types += provider->Type();
+    }
+    return provider_types;
+  }
+
+  /// Load the model from its optimized model cache if the cache is up to date, otherwise from model_uri.
+  /// Whether the cached model can be used also depends on the execution providers and the graph transformers,
+  /// which Initialize checks.
+  template <typename T>
+  common::Status LoadWithOptimizedModelCache(const T& model_uri, std::shared_ptr<onnxruntime::Model>& model) {
+    static const std::string cache_suffix = ".optimized";
+    T cache_path = model_uri;
+    cache_path.append(cache_suffix.cbegin(), cache_suffix.cend());
+
+    const auto* local_registries = HasLocalSchema() ? &custom_schema_registries_ : nullptr;
+    optimized_model_cache_.load_original_model = [model_uri, local_registries](
+                                                     std::shared_ptr<onnxruntime::Model>& original_model) {
+      return onnxruntime::Model::Load(model_uri, original_model, local_registries);
+    };
+    optimized_model_cache_.save = [cache_path](const ModelProto& model_proto) {
+      // the cache is written to a file of its own and then moved into place, so that a crash or another session
+      // saving the cache at the same time never leaves a partial cache to load
+      static std::atomic<unsigned> save_count{0};
+      const std::string temp_suffix = ".tmp" + std::to_string(Env::Default().GetSelfPid()) + "_" +
+                                      std::to_string(save_count++);
+      T temp_path = cache_path;
+      temp_path.append(temp_suffix.cbegin(), temp_suffix.cend());
+
+      {
+        std::ofstream temp_file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!temp_file || !model_proto.SerializeToOstream(&temp_file) || !temp_file.flush()) {
+          temp_file.close();
+          RemoveFile(temp_path);
+          return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the optimized model cache.");
+        }
+      }
+      if (!ReplaceFileAtomically(temp_path, cache_path)) {
+        RemoveFile(temp_path);
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to replace the optimized model cache.");
+      }
+      return Status::OK();
+    };
+
+    // taken before the model is read, so that a change made while it is read shows in the next sessions
+    optimized_model_cache_.model_file = GetFileStamp(model_uri);
+
+    std::unique_ptr<ModelProto> cached_model_proto;
+    {
+      std::ifstream cache_file(cache_path, std::ios::binary);
+      if (cache_file) {
+        cached_model_proto = ReadOptimizedModelCache(cache_file, optimized_model_cache_.cached);
+      }
+    }
+
+    // the model file is only read and hashed if it changed since the cache was saved, to find out whether its
+    // content did
+    const std::string version = std::string(ORT_VERSION) + ";";
+    const auto& cached = optimized_model_cache_.cached;
+    std::string model_bytes;
+    if (cached_model_proto && !optimized_model_cache_.model_file.empty() &&
+        cached.model_file == optimized_model_cache_.model_file && cached.key.compare(0, version.size(), version) == 0) {
+      optimized_model_cache_.key = cached.key;
+    } else {
+      std::ifstream model_file(model_uri, std::ios::binary);
+      if (!model_file) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, NO_SUCHFILE, "Failed to open the model file.");
+      }
+      model_bytes.assign(std::istreambuf_iterator<char>(model_file), std::istreambuf_iterator<char>());
+      optimized_model_cache_.key = version + HashModel(model_bytes);
+    }
+
+    if (cached_model_proto) {
+      if (cached.key != optimized_model_cache_.key) {
+        LOGS(*session_logger_, INFO) << "The optimized model cache is out of date, ignoring it.";
+      } else if (LoadOptimizedModel(std::move(cached_model_proto), model)) {
+        LOGS(*session_logger_, INFO) << "Loaded the model from the optimized model cache.";
+        optimized_model_cache_.is_cached_model_loaded = true;
+        return Status::OK();
+      }
+    }
+
+    if (model_bytes.empty()) {
+      return optimized_model_cache_.load_original_model(model);
+    }
+    return onnxruntime::Model::LoadFromBytes(static_cast<int>(model_bytes.size()), &model_bytes[0], model,
+                                             local_registries);
+  }
+
+  /// Parse an optimized model cache and take its metadata out of the model.
+  /// @return nullptr if the cache is corrupt.
+  std::unique_ptr<ModelProto> ReadOptimizedModelCache(std::istream& cache_stream,
+                                                      OptimizedModelCacheMetadata& metadata) {
+    auto model_proto = std::make_unique<ModelProto>();
+    if (!model_proto->ParseFromIstream(&cache_stream)) {
+      LOGS(*session_logger_, WARNING) << "Failed to parse the optimized model cache, ignoring it.";
+      return nullptr;
+    }
+
+    auto* metadata_props = model_proto->mutable_metadata_props();
+    for (auto it = metadata_props->begin(); it != metadata_props->end();) {
+      if (it->key() == kOptimizedModelCacheKey) {
+        metadata.key = it->value();
+      } else if (it->key() == kOptimizedModelCacheModelFile) {
+        metadata.model_file = it->value();
+      } else if (it->key() == kOptimizedModelCacheTransformers) {
+        metadata.transformers = it->value();
+      } else if (it->key() == kOptimizedModelCacheProviders) {
+        metadata.providers = it->value();
+      } else if (it->key() == kOptimizedModelCacheNodeProviders) {
+        metadata.node_providers = SplitString(it->value(), ',');
+      } else {
+        ++it;
+        continue;
+      }
+      it = metadata_props->erase(it);
+    }
+    return model_proto;
+  }
+
+  /// Load the model of an up to date optimized model cache.
+  /// @return false if the cache can't be used.
+  bool LoadOptimizedModel(std::unique_ptr<ModelProto> model_proto, std::shared_ptr<onnxruntime::Model>& model) {
+    std::shared_ptr<onnxruntime::Model> cached_model;
+    Status status = onnxruntime::Model::Load(std::move(model_proto), cached_model,
+                                             HasLocalSchema() ? &custom_schema_registries_ : nullptr);
+    if (!status.IsOK() || static_cast<size_t>(cached_model->MainGraph().NumberOfNodes()) !=
+                              optimized_model_cache_.cached.node_providers.size()) {
+      LOGS(*session_logger_, WARNING) << "Failed to load the optimized model cache, ignoring it. "
+                                      << status.ErrorMessage();
+      return false;
+    }
+
+    model = cached_model;
+    return true;
+  }
+
+  /// Place the nodes of the cached model on the execution providers they were assigned to when the cache was saved.
+  /// The nodes of a graph loaded from a model are in the order of the model.
+  void ApplyCachedNodeProviders(Graph& graph) {
+    auto node_provider = optimized_model_cache_.cached.node_providers.cbegin();
+    for (auto& node : graph.Nodes()) {
+      node.SetExecutionProviderType(*node_provider++);
+    }
+  }
+
+  /// Save the transformed and partitioned main graph in the optimized model cache.
+  /// Failing to save the cache doesn't fail the initialization.
+  void SaveOptimizedModelCache(const Graph& graph) {
+    // the nodes of the saved model may be in another order than the nodes of the graph, so the placement of the
+    // nodes is keyed by their first output
+    std::unordered_map<std::string, std::string> output_providers;
+    for (const auto& node : graph.Nodes()) {
+      const auto& attributes = node.GetAttributes();
+      bool has_subgraph = std::any_of(attributes.cbegin(), attributes.cend(),
+                                      [](const NodeAttributes::value_type& attribute) {
+                                        return attribute.second.has_g();
+                                      });
+      if (has_subgraph || node.NodeType() == Node::Type::Fused) {
+        LOGS(*session_logger_, INFO) << "Models with subgraphs or compiled nodes are not cached.";
+        return;
+      }
+
+      for (const auto* output_def : node.OutputDefs()) {
+        if (output_def->Exists()) {
+          output_providers[output_def->Name()] = node.GetExecutionProviderType();
+          break;
+        }
+      }
+    }
+
+    ModelProto model_proto = model_->ToProto();
+    std::string node_providers;
+    for (const auto& node_proto : model_proto.graph().node()) {
+      const auto& outputs = node_proto.output();
+      auto output = std::find_if(outputs.cbegin(), outputs.cend(), [](const std::string& name) { return !name.empty(); });
+      auto output_provider = output == outputs.cend() ? output_providers.end() : output_providers.find(*output);
+      if (output_provider == output_providers.end()) {
+        LOGS(*session_logger_, INFO) << "Models with nodes without outputs are not cached.";
+        return;
+      }
+
+      if (!node_providers.empty()) {
+        node_providers += ',';
+      }
+      node_providers += output_provider->second;
+    }
+
+    auto add_metadata = [&model_proto](const char* key, const std::string& value) {
+      auto* metadata_prop = model_proto.add_metadata_props();
+      metadata_prop->set_key(key);
+      metadata_prop->set_value(value);
+    };
+    add_metadata(kOptimizedModelCacheKey, optimized_model_cache_.key);
+    add_metadata(kOptimizedModelCacheModelFile, optimized_model_cache_.model_file);
+    add_metadata(kOptimizedModelCacheTransformers, graph_transformation_mgr_.Description());
+    add_metadata(kOptimizedModelCacheProviders, GetProviderTypes());
+    add_metadata(kOptimizedModelCacheNodeProviders, node_providers);
+
+    Status status = optimized_model_cache_.save(model_proto);
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << status.ErrorMessage();
+    }
+  }
+
   common::Status DoPostLoadProcessing(onnxruntime::Model& model) {
     // TODO add other post load processing here
     common::Status status = SaveModelMetadata(model);
@@ -988,6 +1629,14 @@ class InferenceSession::Impl {
     model_metadata_.custom_metadata_map = model.MetaData();
     model_metadata_.graph_name = graph.Name();
 
+    // the original model replaces a cached one if the cache doesn't match the execution providers
+    required_input_def_list_.clear();
+    required_model_input_names_.clear();
+    input_def_list_.clear();
+    model_input_names_.clear();
+    output_def_list_.clear();
+    model_output_names_.clear();
+
     // save required inputs
     const auto& required_inputs = graph.GetInputs();  // inputs excluding initializers
     required_input_def_list_.reserve(required_inputs.size());
@@ -1108,6 +1757,9 @@ class InferenceSession::Impl {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
+  // observer of the values computed by the runs. the session state refers to it.
+  std::shared_ptr<IActivationObserver> activation_observer_;
+
   ExecutionProviders execution_providers_;
 
   KernelRegistryManager kernel_registry_manager_;
@@ -1149,6 +1801,22 @@ class InferenceSession::Impl {
   std::unique_ptr<TaskThreadPool> thread_pool_;
 #endif
 
+  // Threadpool kernels use to parallelize a single operator, shared with other sessions by default
+  std::shared_ptr<concurrency::ThreadPool> operator_thread_pool_;
+
+  SessionLoadTimings load_timings_;
+
+  // state of SessionOptions::enable_optimized_model_cache between Load and Initialize
+  struct OptimizedModelCache {
+    std::string key;                      // version of onnxruntime and hash of the model
+    std::string model_file;               // size and modification time of the model file
+    bool is_cached_model_loaded = false;  // model_ was loaded from the cache
+    OptimizedModelCacheMetadata cached;   // metadata of the cache file
+    std::function<common::Status(std::shared_ptr<onnxruntime::Model>&)> load_original_model;
+    std::function<common::Status(const ONNX_NAMESPACE::ModelProto&)> save;
+  };
+  OptimizedModelCache optimized_model_cache_;
+
   // Number of concurrently running executors
   std::atomic<int>
       current_num_runs_;
@@ -1158,10 +1826,33 @@ class InferenceSession::Impl {
   bool is_inited_ = false;                       // GUARDED_BY(session_mutex_)
 
   std::map<OrtAllocatorInfo, BufferUniquePtr> weights_buffers_;
+  // initializers shared with the other sessions of the model. keeps the store alive for the next sessions.
+  std::shared_ptr<InitializerStore> initializer_store_;
   InsertCastTransformer insert_cast_transformer_;
 
   // memory allocations for any subgraphs
   std::vector<SubgraphMemory> subgraph_memory_;
+
+  // State of a stream, in the order of SessionOptions::state_tensors
+  struct StreamState {
+    onnxruntime::OrtMutex mutex;  // serializes the runs of the stream
+    std::vector<MLValue> values;  // fed to the next run
+    std::vector<MLValue> spare;   // the state before, its buffer is reused for the output of the next run
+  };
+
+  common::Status GetStream(const std::string& stream_id, std::shared_ptr<StreamState>& stream) {
+    std::lock_guard<onnxruntime::OrtMutex> l(streams_mutex_);
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unknown stream ", stream_id);
+    }
+    // shared so that dropping the stream doesn't pull the state from under a run in progress
+    stream = it->second;
+    return Status::OK();
+  }
+
+  onnxruntime::OrtMutex streams_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<StreamState>> streams_;  // GUARDED_BY(streams_mutex_)
 };  // namespace onnxruntime
 
 //
@@ -1190,6 +1881,54 @@ common::Status InferenceSession::Initialize() {
   return impl_->Initialize();
 }
 
+common::Status InferenceSession::LoadAndInitialize(const std::vector<InferenceSession*>& sessions,
+                                                   const std::vector<std::string>& model_uris,
+                                                   int num_threads,
+                                                   std::vector<common::Status>* session_statuses) {
+  if (!model_uris.empty() && model_uris.size() != sessions.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Expected a model for each of the ", sessions.size(),
+                           " sessions but got ", model_uris.size());
+  }
+
+  int pool_size = num_threads == 0 ? static_cast<int>(std::thread::hardware_concurrency()) : num_threads;
+  std::unique_ptr<concurrency::ThreadPool> load_thread_pool;
+  if (pool_size > 1) {
+    load_thread_pool = std::make_unique<concurrency::ThreadPool>("ORT_load", pool_size - 1);
+  }
+
+  // the sessions are loaded on the pool, and the initialization of each session is parallelized on the same pool.
+  // the threads loading a session take part in its parallel loops so the nesting can't deadlock.
+  // loading a session costs far more than scheduling it, so every session may run on a thread of its own
+  const double cost_per_session = 1e9;
+  std::vector<common::Status> statuses(sessions.size());
+  concurrency::ThreadPool::TryParallelFor(
+      load_thread_pool.get(), static_cast<std::ptrdiff_t>(sessions.size()), cost_per_session,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          Impl& impl = *sessions[i]->impl_;
+          common::Status status = model_uris.empty() ? Status::OK() : impl.Load(model_uris[i]);
+          statuses[i] = status.IsOK() ? impl.Initialize(load_thread_pool.get()) : status;
+        }
+      });
+
+  common::Status status = Status::OK();
+  for (const auto& session_status : statuses) {
+    if (!session_status.IsOK()) {
+      status = session_status;
+      break;
+    }
+  }
+
+  if (session_statuses != nullptr) {
+    *session_statuses = std::move(statuses);
+  }
+  return status;
+}
+
+const SessionLoadTimings& InferenceSession::GetLoadTimings() const {
+  return impl_->GetLoadTimings();
+}
+
 common::Status InferenceSession::Run(const NameMLValMap& feeds,
                                      const std::vector<std::string>& output_names,
                                      std::vector<MLValue>* p_fetches) {
@@ -1231,6 +1970,14 @@ std::string InferenceSession::EndProfiling() {
   return impl_->EndProfiling();
 }
 
+void InferenceSession::SetActivationObserver(std::shared_ptr<IActivationObserver> observer) {
+  impl_->SetActivationObserver(std::move(observer));
+}
+
+const SessionState& InferenceSession::GetSessionState() const {
+  return impl_->GetSessionState();
+}
+
 common::Status InferenceSession::RegisterExecutionProvider(std::unique_ptr<IExecutionProvider> p_exec_provider) {
   return impl_->RegisterExecutionProvider(std::move(p_exec_provider));
 }
@@ -1255,6 +2002,26 @@ common::Status InferenceSession::NewIOBinding(std::unique_ptr<IOBinding>* io_bin
   return impl_->NewIOBinding(io_binding);
 }
 
+common::Status InferenceSession::CreateStream(const std::string& stream_id) {
+  return impl_->CreateStream(stream_id);
+}
+
+common::Status InferenceSession::ResetStream(const std::string& stream_id) {
+  return impl_->ResetStream(stream_id);
+}
+
+common::Status InferenceSession::DropStream(const std::string& stream_id) {
+  return impl_->DropStream(stream_id);
+}
+
+common::Status InferenceSession::Run(const RunOptions& run_options,
+                                     const std::string& stream_id,
+                                     const NameMLValMap& feeds,
+                                     const std::vector<std::string>& output_names,
+                                     std::vector<MLValue>* p_fetches) {
+  return impl_->Run(run_options, stream_id, feeds, output_names, p_fetches);
+}
+
 common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& io_binding) {
   return impl_->Run(run_options, io_binding);
 }
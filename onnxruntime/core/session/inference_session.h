@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "core/common/common.h"
 #include "core/common/status.h"
@@ -23,6 +26,9 @@ class ModelProto;
 namespace onnxruntime {
 class IExecutionProvider;  // forward decl
 class IOBinding;
+class IActivationObserver;
+class InitializerStore;
+class SessionState;
 
 class CustomRegistry;
 
@@ -51,6 +57,10 @@ struct SessionOptions {
   // set this option to false if you don't want it.
   bool enable_cpu_mem_arena = true;
 
+  // enable autotuning of the convolution algorithm on CPU.
+  // The first run of a Conv node for an input shape times each algorithm and the fastest is used by later runs.
+  bool enable_conv_autotune = false;
+
   // the prefix of the profile file. The current time will be appended to the file name.
   std::string profile_file_prefix = "onnxruntime_profile_";
 
@@ -61,6 +71,54 @@ struct SessionOptions {
 
   // How many threads in the session thread pool.
   int session_thread_pool_size = 0;
+
+  // How many threads kernels may use to parallelize a single operator, including the thread running it.
+  // 0 uses a pool shared by all the sessions using 0, with one thread per hardware thread, so that the number of
+  // threads doesn't grow with the number of sessions. Other values create a pool for the session only.
+  // 1 runs every operator on the calling thread only.
+  int operator_thread_pool_size = 0;
+
+  // How many threads Initialize uses to deserialize the initializers and create the kernels, including the calling
+  // thread. 0 uses one thread per hardware thread. 1 initializes the session on the calling thread only.
+  int load_thread_pool_size = 0;
+
+  // cache the graph optimized and partitioned by Initialize next to the model file, in <model path>.optimized, so
+  // that the next sessions of the model skip the graph transformations and partitioning.
+  // The cache is keyed by the content of the model, the version of onnxruntime, the execution providers and the
+  // graph transformers with the number of steps they run. The model file is only read again to check its content
+  // if its size or modification time changed since the cache was saved. It assumes the other options stay the same.
+  // Only models loaded from a path are cached, and not if they have subgraphs or nodes compiled by an execution
+  // provider.
+  bool enable_optimized_model_cache = false;
+
+  // share the initializers of the main graph with the other sessions of the same model that enable it, so that
+  // they keep a single copy of the weights. The sessions share if they load the same model content and use the
+  // same execution providers and graph transformers. The shared initializers are allocated separately instead of
+  // with the memory pattern.
+  bool share_initializers = false;
+
+  // share the initializers with the sessions created with the same store instead, e.g. to share between sessions
+  // loading the model from different copies. Takes precedence over share_initializers. The sessions using a store
+  // must load the same model with the same execution providers and graph transformers.
+  std::shared_ptr<InitializerStore> initializer_store;
+
+  // Recurrent state kept by the session for streaming, as (model output, model input) pairs, e.g. the Y_h
+  // output of an LSTM and the graph input feeding its initial_h. See InferenceSession::CreateStream.
+  std::vector<std::pair<std::string, std::string>> state_tensors;
+};
+
+/**
+  * Time spent in the phases of loading and initializing a session, in microseconds.
+  * The phases that were not reached are 0.
+  */
+struct SessionLoadTimings {
+  long long model_loading = 0;             ///< Load: parse the model and build the graph
+  long long graph_transformation = 0;      ///< graph transformers, partitioning and resolve
+  long long plan_creation = 0;             ///< execution plan of the main graph
+  long long initializers_loading = 0;      ///< deserialize the initializers of the main graph
+  long long kernel_creation = 0;           ///< create the kernels of the main graph
+  long long subgraphs_initialization = 0;  ///< plans, initializers and kernels of the subgraphs
+  long long session_initialization = 0;    ///< Initialize overall, including the phases above
 };
 
 /**
@@ -172,6 +230,26 @@ class InferenceSession {
     */
   common::Status Initialize();
 
+  /**
+    * Load and initialize several sessions concurrently, e.g. the models served by a process at startup.
+    * The sessions share one thread pool that loads the sessions and parallelizes their initialization.
+    * The load_thread_pool_size option of the sessions is ignored in favor of the shared pool.
+    * @param sessions the sessions to initialize.
+    * @param model_uris the model to load in each session, or empty if the models were loaded already.
+    * @param num_threads size of the thread pool, including the calling thread. 0 uses one thread per hardware thread.
+    * @param session_statuses optional, receives the status of each session.
+    * @return OK if all the sessions were initialized, otherwise the error of the first session that failed.
+    */
+  static common::Status LoadAndInitialize(const std::vector<InferenceSession*>& sessions,
+                                          const std::vector<std::string>& model_uris,
+                                          int num_threads = 0,
+                                          std::vector<common::Status>* session_statuses = nullptr);
+
+  /**
+    * Get the time spent in the phases of Load and Initialize.
+    */
+  const SessionLoadTimings& GetLoadTimings() const;
+
   /**
     * Run a pre-loaded and pre-intialized model.
     * Multiple threads are allowed to run this function; hence its thread-safe.
@@ -206,6 +284,41 @@ class InferenceSession {
   common::Status Run(const RunOptions& run_options, IOBinding& io_binding);
   common::Status Run(IOBinding& io_binding);
 
+  /**
+    * Create a stream for chunked inference with the state tensors of SessionOptions::state_tensors.
+    * The state computed by a run of the stream is kept in the session and fed to its next run, so it doesn't
+    * have to round trip through the fetches and feeds of the caller.
+    * A new stream has no state and its first run uses the values of the model for the state inputs
+    * (initializers or omitted optional inputs) unless they are fed explicitly.
+    * @return OK if success, INVALID_ARGUMENT if a stream with this id exists.
+    */
+  common::Status CreateStream(const std::string& stream_id);
+
+  /**
+    * Discard the state of a stream so that its next run starts from the initial state.
+    */
+  common::Status ResetStream(const std::string& stream_id);
+
+  /**
+    * Remove a stream and release its state.
+    */
+  common::Status DropStream(const std::string& stream_id);
+
+  /**
+    * Run the next chunk of a stream.
+    * State inputs that are not in feeds receive the state left by the previous run of the stream, and the state
+    * outputs are kept for the next run whether or not they are in output_names.
+    * The stream owns two buffers per state that the runs alternately read from and write to, so in the steady state
+    * the state is neither copied nor allocated. This requires the shape of a state output to be the same for
+    * consecutive runs.
+    * Runs of the same stream are serialized, different streams may run concurrently.
+    */
+  common::Status Run(const RunOptions& run_options,
+                     const std::string& stream_id,
+                     const NameMLValMap& feeds,
+                     const std::vector<std::string>& output_names,
+                     std::vector<MLValue>* p_fetches);
+
   /**
     * @return pair.first = OK; FAIL otherwise. pair.second is non-NULL when pair.first = OK.
     * @note lifetime of the returned pointer is valid as long as the Session object is live.
@@ -252,6 +365,13 @@ class InferenceSession {
     */
   std::string EndProfiling();
 
+  /**
+    * Set an observer that is called with the feeds and the node outputs of the main graph in the subsequent
+    * runs, or nullptr to stop observing. Values computed inside subgraphs are not observed.
+    * Don't call this while a Run is in progress.
+    */
+  void SetActivationObserver(std::shared_ptr<IActivationObserver> observer);
+
  protected:
   /**
     * Load an ONNX model.
@@ -267,6 +387,12 @@ class InferenceSession {
     */
   common::Status Load(std::unique_ptr<ONNX_NAMESPACE::ModelProto> p_model_proto);
 
+  /**
+    * Get the session state, which holds the kernels and the execution plan once the session is initialized.
+    * This is for the tests that check how the model was planned.
+    */
+  const SessionState& GetSessionState() const;
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(InferenceSession);
 
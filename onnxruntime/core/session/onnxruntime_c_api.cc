@@ -18,10 +18,12 @@
 #include "core/framework/tensor.h"
 #include "core/framework/ml_value.h"
 #include "core/framework/environment.h"
+#include "core/framework/initializer_store.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/onnxruntime_typeinfo.h"
 #include "core/framework/onnx_object_cxx.h"
 #include "core/session/inference_session.h"
+#include "core/session/IOBinding.h"
 
 #include "abi_session_options_impl.h"
 
@@ -134,12 +136,11 @@ ORT_API_STATUS_IMPL(OrtInitialize, OrtLoggingLevel default_warning_level,
 
 ORT_API_STATUS_IMPL(OrtGetStringTensorDataLength, _In_ const OrtValue* value, _Out_ size_t* out) {
   TENSOR_READ_API_BEGIN
-  const auto* src = tensor.Data<std::string>();
   int64_t len = tensor.Shape().Size();
   if (len >= 0) {
     size_t ret = 0;
     for (int64_t i = 0; i != len; ++i) {
-      ret += src[i].size();
+      ret += tensor.StringElement(i).size();
     }
     *out = ret;
   } else
@@ -288,6 +289,46 @@ ORT_API_STATUS_IMPL(OrtCreateTensorWithDataAsOrtValue, _In_ const OrtAllocatorIn
   API_IMPL_END
 }
 
+// Checks the layout produced by OrtGetStringTensorContent:
+// element i occupies [offsets[i], offsets[i + 1]) and the last one ends at s_len
+static OrtStatus* ValidateStringBuffer(size_t s_len, const size_t* offsets, size_t offsets_len, size_t len) {
+  if (offsets_len != len) {
+    return OrtCreateStatus(ORT_INVALID_ARGUMENT, "offsets_len doesn't match the number of elements");
+  }
+  for (size_t i = 0; i != len; ++i) {
+    size_t end = i + 1 != len ? offsets[i + 1] : s_len;
+    if (offsets[i] > end || end > s_len) {
+      return OrtCreateStatus(ORT_INVALID_ARGUMENT, "offsets must be non-decreasing and within s_len");
+    }
+  }
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtCreateStringTensorWithDataAsOrtValue, _In_ const OrtAllocatorInfo* info,
+                    _In_ const void* s, size_t s_len, _In_ const size_t* offsets, size_t offsets_len,
+                    _In_ const size_t* shape, size_t shape_len, _Out_ OrtValue** out) {
+  API_IMPL_BEGIN
+  size_t elem_count = 1;
+  std::vector<int64_t> shapes(shape_len);
+  for (size_t i = 0; i != shape_len; ++i) {
+    elem_count *= shape[i];
+    shapes[i] = shape[i];
+  }
+  ORT_API_RETURN_IF_ERROR(ValidateStringBuffer(s_len, offsets, offsets_len, elem_count));
+  std::unique_ptr<Tensor> tensor = std::make_unique<Tensor>(onnxruntime::TensorShape(shapes),
+                                                            static_cast<const char*>(s),
+                                                            s_len,
+                                                            offsets,
+                                                            *info);
+  std::unique_ptr<MLValue> value = std::make_unique<MLValue>();
+  value->Init(tensor.release(),
+              DataTypeImpl::GetType<Tensor>(),
+              DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+  *out = reinterpret_cast<OrtValue*>(value.release());
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtCreateTensorAsOrtValue, _Inout_ OrtAllocator* allocator,
                     _In_ const size_t* shape, size_t shape_len, ONNXTensorElementDataType type,
                     _Out_ OrtValue** out) {
@@ -460,6 +501,100 @@ ORT_API_STATUS_IMPL(OrtRun, _In_ OrtSession* sess,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtCreateIoBinding, _Inout_ OrtSession* sess, _Out_ OrtIoBinding** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  std::unique_ptr<::onnxruntime::IOBinding> binding;
+  auto status = session->NewIOBinding(&binding);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  *out = reinterpret_cast<OrtIoBinding*>(binding.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtIoBindingBindInput, _Inout_ OrtIoBinding* binding, _In_ const char* name,
+                    _In_ const OrtValue* value) {
+  API_IMPL_BEGIN
+  if (name == nullptr || name[0] == '\0' || value == nullptr) {
+    return OrtCreateStatus(ORT_INVALID_ARGUMENT, "input name and value cannot be empty");
+  }
+  auto status = reinterpret_cast<::onnxruntime::IOBinding*>(binding)->BindInput(
+      name, *reinterpret_cast<const ::onnxruntime::MLValue*>(value));
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtIoBindingBindOutput, _Inout_ OrtIoBinding* binding, _In_ const char* name,
+                    _In_opt_ const OrtValue* value) {
+  API_IMPL_BEGIN
+  if (name == nullptr || name[0] == '\0') {
+    return OrtCreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+  }
+  auto status = reinterpret_cast<::onnxruntime::IOBinding*>(binding)->BindOutput(
+      name, value == nullptr ? MLValue() : *reinterpret_cast<const ::onnxruntime::MLValue*>(value));
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtIoBindingClearInputs, _Inout_ OrtIoBinding* binding) {
+  reinterpret_cast<::onnxruntime::IOBinding*>(binding)->ClearInputs();
+}
+
+ORT_API(void, OrtIoBindingClearOutputs, _Inout_ OrtIoBinding* binding) {
+  reinterpret_cast<::onnxruntime::IOBinding*>(binding)->ClearOutputs();
+}
+
+ORT_API_STATUS_IMPL(OrtRunWithIoBinding, _Inout_ OrtSession* sess, _In_opt_ OrtRunOptions* run_options,
+                    _Inout_ OrtIoBinding* binding) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  auto& io_binding = *reinterpret_cast<::onnxruntime::IOBinding*>(binding);
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions op;
+    status = session->Run(op, io_binding);
+  } else {
+    status = session->Run(*run_options, io_binding);
+  }
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtIoBindingGetOutputCount, _In_ const OrtIoBinding* binding, _Out_ size_t* out) {
+  API_IMPL_BEGIN
+  *out = reinterpret_cast<const ::onnxruntime::IOBinding*>(binding)->GetOutputs().size();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtIoBindingGetOutputValue, _In_ const OrtIoBinding* binding, size_t index,
+                    _Out_ OrtValue** out) {
+  API_IMPL_BEGIN
+  const auto& outputs = reinterpret_cast<const ::onnxruntime::IOBinding*>(binding)->GetOutputs();
+  if (index >= outputs.size())
+    return OrtCreateStatus(ORT_INVALID_ARGUMENT, "output index out of range");
+  if (!outputs[index].IsAllocated())
+    return OrtCreateStatus(ORT_FAIL, "output has not been computed, run the session first");
+  *out = reinterpret_cast<OrtValue*>(new MLValue(outputs[index]));
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtCreateInitializerStore, _Out_ OrtInitializerStore** out) {
+  API_IMPL_BEGIN
+  *out = reinterpret_cast<OrtInitializerStore*>(
+      new std::shared_ptr<::onnxruntime::InitializerStore>(std::make_shared<::onnxruntime::InitializerStore>()));
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtGetTensorMutableData, _In_ OrtValue* value, _Out_ void** output) {
   TENSOR_READWRITE_API_BEGIN
   //TODO: test if it's a string tensor
@@ -471,7 +606,6 @@ ORT_API_STATUS_IMPL(OrtGetTensorMutableData, _In_ OrtValue* value, _Out_ void**
 ORT_API_STATUS_IMPL(OrtGetStringTensorContent, _In_ const OrtValue* value,
                     _Out_ void* s, size_t s_len, _Out_ size_t* offsets, size_t offsets_len) {
   TENSOR_READ_API_BEGIN
-  const auto* input = tensor.Data<std::string>();
   auto len = static_cast<size_t>(tensor.Shape().Size());
   if (offsets_len < len) {
     return OrtCreateStatus(ORT_FAIL, "space is not enough");
@@ -479,7 +613,7 @@ ORT_API_STATUS_IMPL(OrtGetStringTensorContent, _In_ const OrtValue* value,
   {
     size_t ret = 0;
     for (size_t i = 0; i != len; ++i) {
-      ret += input[i].size();
+      ret += tensor.StringElement(i).size();
     }
     if (s_len < ret) {
       return OrtCreateStatus(ORT_FAIL, "space is not enough");
@@ -487,12 +621,41 @@ ORT_API_STATUS_IMPL(OrtGetStringTensorContent, _In_ const OrtValue* value,
   }
   size_t f = 0;
   char* p = static_cast<char*>(s);
-  for (size_t i = 0; i != offsets_len; ++i, ++offsets) {
-    memcpy(p, input[i].data(), input[i].size());
-    p += input[i].size();
+  for (size_t i = 0; i != len; ++i, ++offsets) {
+    auto element = tensor.StringElement(i);
+    memcpy(p, element.data(), element.size());
+    p += element.size();
     *offsets = f;
-    f += input[i].size();
+    f += element.size();
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtFillStringTensorFromBuffer, _In_ OrtValue* value, _In_ const void* s, size_t s_len,
+                    _In_ const size_t* offsets, size_t offsets_len) {
+  TENSOR_READWRITE_API_BEGIN
+  auto* dst = tensor->MutableData<std::string>();
+  auto len = static_cast<size_t>(tensor->Shape().Size());
+  ORT_API_RETURN_IF_ERROR(ValidateStringBuffer(s_len, offsets, offsets_len, len));
+  const char* data = static_cast<const char*>(s);
+  for (size_t i = 0; i != len; ++i) {
+    size_t end = i + 1 != len ? offsets[i + 1] : s_len;
+    dst[i].assign(data + offsets[i], end - offsets[i]);
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtGetStringTensorElement, _In_ const OrtValue* value, size_t index,
+                    _Out_ const char** s, _Out_ size_t* len) {
+  TENSOR_READ_API_BEGIN
+  if (index >= static_cast<size_t>(tensor.Shape().Size())) {
+    return OrtCreateStatus(ORT_INVALID_ARGUMENT, "index is out of bounds");
   }
+  auto element = tensor.StringElement(index);
+  *s = element.data();
+  *len = element.size();
   return nullptr;
   API_IMPL_END
 }
@@ -639,4 +802,6 @@ ORT_API_STATUS_IMPL(OrtSessionGetOutputName, _In_ const OrtSession* sess, size_t
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Env, OrtEnv)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Value, MLValue)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Session, ::onnxruntime::InferenceSession)
+DEFINE_RELEASE_ORT_OBJECT_FUNCTION(IoBinding, ::onnxruntime::IOBinding)
+DEFINE_RELEASE_ORT_OBJECT_FUNCTION(InitializerStore, std::shared_ptr<::onnxruntime::InitializerStore>)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION_FOR_ARRAY(Status, char)
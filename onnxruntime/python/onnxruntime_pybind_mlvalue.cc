@@ -71,11 +71,122 @@ const DataTypeImpl* NumpyToOnnxRuntimeTensorType(int numpy_type) {
   }
 }
 
+// Trims the zeros that numpy pads the shorter items of a unicode array (UCS-4) with, and computes the length
+// of the utf8 encoding of the item.
+// Returns false if the item holds a code point that can't be encoded.
+static bool NumpyUnicodeUtf8Length(const char* src, size_t& num_chars, size_t& utf8_len) {
+  uint32_t cp;
+  while (num_chars > 0) {
+    memcpy(&cp, src + (num_chars - 1) * sizeof(cp), sizeof(cp));
+    if (cp != 0) break;
+    --num_chars;
+  }
+  utf8_len = 0;
+  for (size_t i = 0; i < num_chars; ++i, src += sizeof(cp)) {
+    memcpy(&cp, src, sizeof(cp));
+    if (cp < 0x80) {
+      utf8_len += 1;
+    } else if (cp < 0x800) {
+      utf8_len += 2;
+    } else if (cp < 0x10000) {
+      if (cp >= 0xD800 && cp <= 0xDFFF) {
+        return false;  // surrogates
+      }
+      utf8_len += 3;
+    } else if (cp < 0x110000) {
+      utf8_len += 4;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Encodes num_chars code points of a numpy unicode item as utf8 without creating an intermediate
+// Python object. The item must have been checked with NumpyUnicodeUtf8Length.
+// Returns the end of the encoded item.
+static char* NumpyUnicodeToUtf8(const char* src, size_t num_chars, char* dst) {
+  uint32_t cp;
+  for (size_t i = 0; i < num_chars; ++i, src += sizeof(cp)) {
+    memcpy(&cp, src, sizeof(cp));
+    if (cp < 0x80) {
+      *dst++ = static_cast<char>(cp);
+    } else if (cp < 0x800) {
+      *dst++ = static_cast<char>(0xC0 | (cp >> 6));
+      *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+      *dst++ = static_cast<char>(0xE0 | (cp >> 12));
+      *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+      *dst++ = static_cast<char>(0xF0 | (cp >> 18));
+      *dst++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+      *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+    }
+  }
+  return dst;
+}
+
+// Creates a string tensor in the compact layout from a numpy array of unicode or byte strings. The offsets and
+// the characters of all the elements are stored in one allocation, so no std::string is created per element.
+static void CreateCompactStringTensorMLValue(AllocatorPtr alloc, PyArrayObject* darray, const TensorShape& shape,
+                                             MLValue* p_mlvalue) {
+  const int npy_type = PyArray_TYPE(darray);
+  const auto item_size = static_cast<size_t>(PyArray_ITEMSIZE(darray));
+  const auto count = static_cast<size_t>(shape.Size());
+  const char* data = static_cast<const char*>(PyArray_DATA(darray));
+
+  // the number of characters of each item that are converted and their length once converted
+  std::vector<std::pair<size_t, size_t>> lengths(count);
+  size_t chars_len = 0;
+  const char* src = data;
+  for (size_t i = 0; i < count; ++i, src += item_size) {
+    if (npy_type == NPY_UNICODE) {
+      // Python unicode strings are assumed to be USC-4. Strings are stored as UTF-8.
+      lengths[i].first = item_size / PyUnicode_4BYTE_KIND;
+      if (!NumpyUnicodeUtf8Length(src, lengths[i].first, lengths[i].second)) {
+        lengths[i] = {0, 0};
+      }
+    } else if (npy_type == NPY_STRING) {
+      // a string as long as the item size is not null terminated
+      lengths[i].second = strnlen(src, item_size);
+    } else {
+      // NPY_VOID does not trim final 0.
+      lengths[i].second = item_size;
+    }
+    chars_len += lengths[i].second;
+  }
+
+  void* buffer = alloc->Alloc(count * sizeof(size_t) + chars_len);
+  size_t* offsets = static_cast<size_t*>(buffer);
+  char* chars = static_cast<char*>(buffer) + count * sizeof(size_t);
+  std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(shape, chars, chars_len, offsets, alloc->Info(),
+                                                              buffer, alloc);
+
+  char* dst = chars;
+  src = data;
+  for (size_t i = 0; i < count; ++i, src += item_size) {
+    offsets[i] = static_cast<size_t>(dst - chars);
+    if (npy_type == NPY_UNICODE) {
+      dst = NumpyUnicodeToUtf8(src, lengths[i].first, dst);
+    } else {
+      memcpy(dst, src, lengths[i].second);
+      dst += lengths[i].second;
+    }
+  }
+
+  p_mlvalue->Init(p_tensor.release(),
+                  DataTypeImpl::GetType<Tensor>(),
+                  DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+}
+
 bool PyObjectCheck_Array(PyObject* o) {
   return PyObject_HasAttrString(o, "__array_finalize__");
 }
 
-void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyArrayObject* pyObject, MLValue* p_mlvalue) {
+void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyArrayObject* pyObject, MLValue* p_mlvalue,
+                         bool use_numpy_data_memory) {
   PyArrayObject* darray = PyArray_GETCONTIGUOUS(pyObject);
   if (darray == NULL) {
     throw std::runtime_error(std::string("The object must be a contiguous array for input '") + name_input + std::string("'."));
@@ -94,9 +205,33 @@ void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyAr
 
     TensorShape shape(dims);
     auto element_type = NumpyToOnnxRuntimeTensorType(npy_type);
+
+    // PyArray_GETCONTIGUOUS returns the array itself if it is already contiguous.
+    // Its memory can then be used directly as the caller holds a reference to it.
+    if (use_numpy_data_memory && darray == pyObject &&
+        element_type != DataTypeImpl::GetType<std::string>() &&
+        PyArray_ISBEHAVED_RO(darray) &&
+        static_cast<size_t>(PyArray_ITEMSIZE(darray)) == element_type->Size()) {
+      std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(element_type,
+                                                                  shape,
+                                                                  PyArray_DATA(darray),
+                                                                  alloc->Info());
+      p_mlvalue->Init(p_tensor.release(),
+                      DataTypeImpl::GetType<Tensor>(),
+                      DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+      Py_XDECREF(darray);
+      return;
+    }
+
+    if (npy_type == NPY_UNICODE || npy_type == NPY_STRING || npy_type == NPY_VOID) {
+      CreateCompactStringTensorMLValue(alloc, darray, shape, p_mlvalue);
+      Py_XDECREF(darray);
+      return;
+    }
+
     void* buffer = alloc->Alloc(element_type->Size() * shape.Size());
 
-    if (npy_type != NPY_UNICODE && npy_type != NPY_OBJECT) {
+    if (element_type != DataTypeImpl::GetType<std::string>()) {
       memcpy(buffer, static_cast<void*>(PyArray_DATA(darray)), element_type->Size() * shape.Size());
     }
 
@@ -105,46 +240,7 @@ void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyAr
                                                                 static_cast<void*>(buffer),
                                                                 alloc->Info(), alloc);
 
-    if (npy_type == NPY_UNICODE) {
-      // Copy string data which needs to be done after Tensor is allocated.
-      // Strings are Python strings or numpy.unicode string.
-      std::string* dst = static_cast<std::string*>(buffer);
-      auto item_size = PyArray_ITEMSIZE(darray);
-      auto num_chars = item_size / PyUnicode_4BYTE_KIND;
-      char* src = static_cast<char*>(PyArray_DATA(darray));
-      const char* str;
-      Py_ssize_t size;
-      PyObject* pStr;
-      for (int i = 0; i < shape.Size(); i++, src += item_size) {
-        // Python unicode strings are assumed to be USC-4. Strings are stored as UTF-8.
-        pStr = PyUnicode_FromKindAndData(PyUnicode_4BYTE_KIND, src, num_chars);
-        str = PyUnicode_AsUTF8AndSize(pStr, &size);
-        if (str == NULL) {
-          dst[i] = "";
-        } else {
-          // Size is equal to the longest string size, numpy stores
-          // strings in a single array. Those code assumes a string ends with a final 0.
-          dst[i] = str;
-        }
-        Py_XDECREF(pStr);
-      }
-    } else if (npy_type == NPY_STRING || npy_type == NPY_VOID) {
-      // Copy string data which needs to be done after Tensor is allocated.
-      // Strings are given as bytes (encoded strings).
-      // NPY_VOID does not trim final 0.
-      // NPY_STRING assumes bytes string ends with a final 0.
-      std::string* dst = static_cast<std::string*>(buffer);
-      auto item_size = PyArray_ITEMSIZE(darray);
-      char* src = static_cast<char*>(PyArray_DATA(darray));
-      for (int i = 0; i < shape.Size(); i++, src += item_size) {
-        if (npy_type == NPY_STRING) {
-          dst[i] = src;
-        } else {
-          dst[i].resize(item_size);
-          memcpy((void*)dst[i].c_str(), src, item_size);
-        }
-      }
-    } else if (npy_type == NPY_OBJECT) {
+    if (npy_type == NPY_OBJECT) {
       // Converts object into string.
       std::string* dst = static_cast<std::string*>(buffer);
       auto item_size = PyArray_ITEMSIZE(darray);
@@ -382,11 +478,48 @@ void CreateGenericIterableMLValue(PyObject* iterator, AllocatorPtr alloc, const
   }
 }
 
-void CreateGenericMLValue(AllocatorPtr alloc, const std::string& name_input, py::object& value, MLValue* p_mlvalue) {
+void CreateTensorMLValueOverNumpyArray(AllocatorPtr alloc, const std::string& name_output, py::object& value,
+                                       MLValue* p_mlvalue) {
+  if (!PyArray_Check(value.ptr())) {
+    throw std::runtime_error(std::string("The object bound to output '") + name_output +
+                             std::string("' must be a numpy array."));
+  }
+  PyArrayObject* darray = reinterpret_cast<PyArrayObject*>(value.ptr());
+  // onnxruntime writes to the array directly, it can't go through a copy
+  if (!PyArray_ISCARRAY(darray) || !PyArray_ISNOTSWAPPED(darray)) {
+    throw std::runtime_error(std::string("The array bound to output '") + name_output +
+                             std::string("' must be a writeable, aligned, contiguous array in native byte order."));
+  }
+
+  auto element_type = NumpyToOnnxRuntimeTensorType(PyArray_TYPE(darray));
+  if (element_type == DataTypeImpl::GetType<std::string>() ||
+      static_cast<size_t>(PyArray_ITEMSIZE(darray)) != element_type->Size()) {
+    throw std::runtime_error(std::string("The array bound to output '") + name_output +
+                             std::string("' has a type that can't be written to in place."));
+  }
+
+  int ndim = PyArray_NDIM(darray);
+  npy_intp* npy_dims = PyArray_DIMS(darray);
+  std::vector<int64_t> dims(ndim);
+  for (int i = 0; i < ndim; ++i) {
+    dims[i] = npy_dims[i];
+  }
+
+  std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(element_type,
+                                                              TensorShape(dims),
+                                                              PyArray_DATA(darray),
+                                                              alloc->Info());
+  p_mlvalue->Init(p_tensor.release(),
+                  DataTypeImpl::GetType<Tensor>(),
+                  DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+}
+
+void CreateGenericMLValue(AllocatorPtr alloc, const std::string& name_input, py::object& value, MLValue* p_mlvalue,
+                          bool use_numpy_data_memory) {
   if (PyObjectCheck_Array(value.ptr())) {
     // The most frequent case: input comes as an array.
     PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(value.ptr());
-    CreateTensorMLValue(alloc, name_input, arr, p_mlvalue);
+    CreateTensorMLValue(alloc, name_input, arr, p_mlvalue, use_numpy_data_memory);
   } else if (PyDict_Check(value.ptr())) {
     CreateMapMLValue_AgnosticVectorMap((PyObject*)NULL, value.ptr(), alloc, name_input, p_mlvalue);
   } else {
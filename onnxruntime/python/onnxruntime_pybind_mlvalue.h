@@ -24,7 +24,15 @@ namespace py = pybind11;
 
 int OnnxRuntimeTensorToNumpyType(const DataTypeImpl* tensor_type);
 
-void CreateGenericMLValue(AllocatorPtr alloc, const std::string& name_input, py::object& value, MLValue* p_mlvalue);
+// If use_numpy_data_memory is true, contiguous numpy arrays are not copied and the
+// tensor refers to their memory. The caller must keep value alive while the MLValue is used.
+void CreateGenericMLValue(AllocatorPtr alloc, const std::string& name_input, py::object& value, MLValue* p_mlvalue,
+                          bool use_numpy_data_memory = false);
+
+// Creates a tensor over the memory of a writeable numpy array so that an output can be computed in place.
+// The caller must keep value alive while the MLValue is used.
+void CreateTensorMLValueOverNumpyArray(AllocatorPtr alloc, const std::string& name_output, py::object& value,
+                                       MLValue* p_mlvalue);
 
 }  // namespace python
 }  // namespace onnxruntime
@@ -8,6 +8,8 @@
 #include <numpy/arrayobject.h>
 
 #include "core/graph/graph_viewer.h"
+#include "core/session/IOBinding.h"
+#include "core/framework/activation_statistics.h"
 
 #if USE_CUDA
 #define BACKEND_PROC "GPU"
@@ -58,6 +60,7 @@
 #pragma warning(disable : 4267 4996 4503 4003)
 #endif  // _MSC_VER
 
+#include <algorithm>
 #include <iterator>
 
 #if defined(_MSC_VER)
@@ -132,6 +135,23 @@ void AddTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
 
   MLDataType dtype = rtensor.DataType();
   const int numpy_type = OnnxRuntimeTensorToNumpyType(dtype);
+
+  // A buffer that nothing else refers to is handed over to numpy without a copy.
+  // The capsule set as the array base keeps the tensor alive.
+  if (numpy_type != NPY_OBJECT && rtensor.OwnsBuffer() && val.IsUnique()) {
+    py::object obj = py::reinterpret_steal<py::object>(PyArray_SimpleNewFromData(
+        shape.NumDimensions(), npy_dims.data(), numpy_type, const_cast<void*>(rtensor.DataRaw(dtype))));
+    if (!obj) {
+      throw py::error_already_set();
+    }
+    py::capsule base(new MLValue(val), [](void* p) { delete static_cast<MLValue*>(p); });
+    if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(obj.ptr()), base.release().ptr()) != 0) {
+      throw py::error_already_set();
+    }
+    pyobjs.push_back(obj);
+    return;
+  }
+
   py::object obj = py::reinterpret_steal<py::object>(PyArray_SimpleNew(
       shape.NumDimensions(), npy_dims.data(), numpy_type));
 
@@ -141,11 +161,11 @@ void AddTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
   if (numpy_type != NPY_OBJECT) {
     memcpy(outPtr, rtensor.DataRaw(dtype), dtype->Size() * shape.Size());
   } else {
-    // Handle string type.
+    // Handle string type, in either layout.
     py::object* outObj = static_cast<py::object*>(outPtr);
-    const std::string* src = rtensor.template Data<std::string>();
-    for (int i = 0; i < rtensor.Shape().Size(); i++, src++) {
-      outObj[i] = py::cast(*src);
+    for (int64_t i = 0, len = rtensor.Shape().Size(); i < len; i++) {
+      auto element = rtensor.StringElement(i);
+      outObj[i] = py::str(element.data(), element.size());
     }
   }
   pyobjs.push_back(obj);
@@ -182,6 +202,88 @@ inline void RegisterExecutionProvider(InferenceSession* sess, OrtProviderFactory
   }
 }
 
+// Converts a Python error raised while creating an input into an exception
+static void ThrowIfPyErrorOccurred() {
+  if (PyErr_Occurred()) {
+    PyObject *ptype, *pvalue, *ptraceback;
+    PyErr_Fetch(&ptype, &pvalue, &ptraceback);
+
+    PyObject* pStr = PyObject_Str(ptype);
+    std::string sType = py::reinterpret_borrow<py::str>(pStr);
+    Py_XDECREF(pStr);
+    pStr = PyObject_Str(pvalue);
+    sType += ": ";
+    sType += py::reinterpret_borrow<py::str>(pStr);
+    Py_XDECREF(pStr);
+    throw std::runtime_error(sType);
+  }
+}
+
+// Runs sess, or the next chunk of a stream if stream_id is set, and converts the outputs to Python objects
+static std::vector<py::object> RunSession(InferenceSession* sess, const std::string* stream_id,
+                                          const std::vector<std::string>& output_names,
+                                          std::map<std::string, py::object>& pyfeeds, RunOptions* run_options) {
+  NameMLValMap feeds;
+  for (auto& _ : pyfeeds) {
+    MLValue ml_value;
+    // pyfeeds keeps the numpy arrays alive until Run returns
+    CreateGenericMLValue(GetAllocator(), _.first, _.second, &ml_value, true);
+    ThrowIfPyErrorOccurred();
+    feeds.insert(std::make_pair(_.first, ml_value));
+  }
+
+  std::vector<MLValue> fetches;
+  common::Status status;
+
+  {
+    // Let other Python threads run while the session executes
+    py::gil_scoped_release release;
+    RunOptions default_run_options;
+    const RunOptions& options = run_options != nullptr ? *run_options : default_run_options;
+    if (stream_id != nullptr) {
+      status = sess->Run(options, *stream_id, feeds, output_names, &fetches);
+    } else {
+      status = sess->Run(options, feeds, output_names, &fetches);
+    }
+  }
+
+  if (!status.IsOK()) {
+    auto mes = status.ToString();
+    throw std::runtime_error(std::string("Method run failed due to: ") + std::string(mes.c_str()));
+  }
+
+  // Feeds may share buffers with the outputs, release them first
+  // so that output buffers nothing else refers to can be passed to numpy as is.
+  feeds.clear();
+
+  std::vector<py::object> rfetch;
+  rfetch.reserve(fetches.size());
+  for (auto& _ : fetches) {
+    if (_.IsTensor()) {
+      AddTensorAsPyObj(_, rfetch);
+    } else {
+      AddNonTensorAsPyObj(_, rfetch);
+    }
+  }
+  return rfetch;
+}
+
+// IOBinding exposed to Python.
+// The tensors refer to the memory of the bound numpy arrays, so the arrays are kept alive with the binding.
+struct SessionIOBinding {
+  explicit SessionIOBinding(InferenceSession* sess) {
+    auto status = sess->NewIOBinding(&binding);
+    if (!status.IsOK()) {
+      throw std::runtime_error(status.ToString().c_str());
+    }
+  }
+
+  std::unique_ptr<IOBinding> binding;
+  std::map<std::string, py::object> input_arrays;
+  // same order as the outputs of the binding, None for outputs allocated by the run
+  std::vector<py::object> output_arrays;
+};
+
 #define FACTORY_PTR_HOLDER \
   std::unique_ptr<OrtProviderFactoryInterface*, decltype(&OrtReleaseObject)> ptr_holder_(f, OrtReleaseObject);
 
@@ -240,6 +342,17 @@ with a big chunk for all the internal memory allocation. Default is true.)pbdoc"
       .def_readwrite("enable_cpu_mem_arena", &SessionOptions::enable_cpu_mem_arena,
                      R"pbdoc(Enables the memory arena on CPU. Arena may pre-allocate memory for future usage.
 Set this option to false if you don't want it. Default is True.)pbdoc")
+      .def_readwrite("enable_conv_autotune", &SessionOptions::enable_conv_autotune,
+                     R"pbdoc(Times the convolution algorithms on the CPU on the first run of each input shape and uses
+the fastest for later runs. Default is False.)pbdoc")
+      .def_readwrite("enable_optimized_model_cache", &SessionOptions::enable_optimized_model_cache,
+                     R"pbdoc(Caches the graph optimized by the session initialization next to the model file, in
+<model path>.optimized, so that the next sessions of the model skip the graph optimizations. Only applies to
+models loaded from a path. Default is False.)pbdoc")
+      .def_readwrite("share_initializers", &SessionOptions::share_initializers,
+                     R"pbdoc(Shares the initializers with the other sessions of the same model that enable it, so
+that they keep a single copy of the weights. The sessions share if they load the same model with the same execution
+providers. Default is False.)pbdoc")
       .def_readwrite("enable_profiling", &SessionOptions::enable_profiling,
                      R"pbdoc(Enable profiling for this session. Default is false.)pbdoc")
       .def_readwrite("enable_sequential_execution", &SessionOptions::enable_sequential_execution,
@@ -252,7 +365,18 @@ Set this option to false if you don't want it. Default is True.)pbdoc")
                      R"pbdoc(Applies to session load, initialization, etc. Default is 0.)pbdoc")
       .def_readwrite("session_thread_pool_size", &SessionOptions::session_thread_pool_size,
                      R"pbdoc(How many threads in the session thread pool. Default is 0 to let onnxruntime choose.
-This parameter is unused unless *enable_sequential_execution* is false.)pbdoc");
+This parameter is unused unless *enable_sequential_execution* is false.)pbdoc")
+      .def_readwrite("operator_thread_pool_size", &SessionOptions::operator_thread_pool_size,
+                     R"pbdoc(How many threads an operator may use to parallelize its computation, including the
+thread running it. Default is 0 to use a pool shared by the sessions using 0, with one thread per hardware thread.
+Other values give the session a pool of its own. 1 disables intra-operator parallelism.)pbdoc")
+      .def_readwrite("load_thread_pool_size", &SessionOptions::load_thread_pool_size,
+                     R"pbdoc(How many threads the session initialization may use to load the initializers and create the
+kernels, including the calling thread. Default is 0 to use one thread per hardware thread. 1 initializes the session
+on the calling thread only.)pbdoc")
+      .def_readwrite("state_tensors", &SessionOptions::state_tensors,
+                     R"pbdoc(List of (output name, input name) pairs of recurrent state kept by the streams of the
+session. The output of a pair computed by one run of a stream is fed to the input of the pair by the next run.)pbdoc");
 
   py::class_<RunOptions>(m, "RunOptions", R"pbdoc(Configuration information for a single Run.)pbdoc")
       .def(py::init())
@@ -329,6 +453,90 @@ including arg name, arg type (contains both type and shape).)pbdoc")
           },
           "node shape (assuming the node holds a tensor)");
 
+  py::class_<SessionIOBinding>(m, "SessionIOBinding", R"pbdoc(Inputs and outputs bound once for repeated runs of a session.)pbdoc")
+      // the binding refers to the state of the session
+      .def(py::init<InferenceSession*>(), py::keep_alive<1, 2>())
+      .def(
+          "bind_input", [](SessionIOBinding* io_binding, const std::string& name, py::object value) {
+            MLValue ml_value;
+            // the binding keeps the numpy array alive while it is bound
+            CreateGenericMLValue(GetAllocator(), name, value, &ml_value, true);
+            ThrowIfPyErrorOccurred();
+            auto status = io_binding->binding->BindInput(name, ml_value);
+            if (!status.IsOK()) {
+              throw std::runtime_error(status.ToString().c_str());
+            }
+            io_binding->input_arrays[name] = value;
+          },
+          R"pbdoc(Bind an input to a value. Contiguous numpy arrays are used without a copy and must not
+be modified while a run is in progress.)pbdoc")
+      .def(
+          "bind_output", [](SessionIOBinding* io_binding, const std::string& name, py::object value) {
+            MLValue ml_value;
+            if (!value.is_none()) {
+              CreateTensorMLValueOverNumpyArray(GetAllocator(), name, value, &ml_value);
+            }
+            auto status = io_binding->binding->BindOutput(name, ml_value);
+            if (!status.IsOK()) {
+              throw std::runtime_error(status.ToString().c_str());
+            }
+            const auto& names = io_binding->binding->GetOutputNames();
+            size_t index = std::find(names.cbegin(), names.cend(), name) - names.cbegin();
+            if (index == io_binding->output_arrays.size()) {
+              io_binding->output_arrays.push_back(value);
+            } else {
+              io_binding->output_arrays[index] = value;
+            }
+          },
+          R"pbdoc(Bind an output to a numpy array the run writes to in place, or to None to let every run
+allocate the output. The array must have the type and shape of the output.)pbdoc")
+      .def(
+          "clear_binding_inputs", [](SessionIOBinding* io_binding) {
+            io_binding->binding->ClearInputs();
+            io_binding->input_arrays.clear();
+          })
+      .def(
+          "clear_binding_outputs", [](SessionIOBinding* io_binding) {
+            io_binding->binding->ClearOutputs();
+            io_binding->output_arrays.clear();
+          })
+      .def(
+          "get_outputs", [](SessionIOBinding* io_binding) -> std::vector<py::object> {
+            auto& outputs = io_binding->binding->GetOutputs();
+            std::vector<py::object> rfetch;
+            rfetch.reserve(outputs.size());
+            for (size_t i = 0; i < outputs.size(); ++i) {
+              if (!io_binding->output_arrays[i].is_none()) {
+                // computed in place
+                rfetch.push_back(io_binding->output_arrays[i]);
+              } else if (!outputs[i].IsAllocated()) {
+                rfetch.push_back(py::none());
+              } else if (outputs[i].IsTensor()) {
+                AddTensorAsPyObj(outputs[i], rfetch);
+              } else {
+                AddNonTensorAsPyObj(outputs[i], rfetch);
+              }
+            }
+            return rfetch;
+          },
+          R"pbdoc(Return the outputs of the last run in the order they were bound.)pbdoc");
+
+  py::class_<ActivationStatistics, std::shared_ptr<ActivationStatistics>>(m, "ActivationStatistics", R"pbdoc(Range and histogram of the float tensors computed by the runs of a session.)pbdoc")
+      .def(py::init<size_t>(), py::arg("num_bins") = 0,
+           R"pbdoc(Collect a histogram of the absolute values with num_bins bins if it is not zero. num_bins must be even.)pbdoc")
+      .def(
+          "get", [](const ActivationStatistics* statistics) -> py::dict {
+            py::dict result;
+            for (const auto& entry : statistics->Get()) {
+              result[py::str(entry.first)] = py::make_tuple(entry.second.min, entry.second.max,
+                                                            entry.second.histogram, entry.second.histogram_range);
+            }
+            return result;
+          },
+          R"pbdoc(Return a dictionary {name: (min, max, histogram, histogram_range)}. histogram[i] counts the values
+with an absolute value in [i, i + 1) * histogram_range / len(histogram).)pbdoc")
+      .def("clear", &ActivationStatistics::Clear, R"pbdoc(Discard the statistics collected so far.)pbdoc");
+
   py::class_<SessionObjectInitializer>(m, "SessionObjectInitializer");
   py::class_<InferenceSession>(m, "InferenceSession", R"pbdoc(This is the main class used to run a model.)pbdoc")
       .def(py::init<SessionObjectInitializer, SessionObjectInitializer>())
@@ -353,54 +561,62 @@ including arg name, arg type (contains both type and shape).)pbdoc")
           },
           R"pbdoc(Load a model serialized in ONNX format.)pbdoc")
       .def("run", [](InferenceSession* sess, std::vector<std::string> output_names, std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr) -> std::vector<py::object> {
-        NameMLValMap feeds;
-        for (auto _ : pyfeeds) {
-          MLValue ml_value;
-          CreateGenericMLValue(GetAllocator(), _.first, _.second, &ml_value);
-          if (PyErr_Occurred()) {
-            PyObject *ptype, *pvalue, *ptraceback;
-            PyErr_Fetch(&ptype, &pvalue, &ptraceback);
-
-            PyObject* pStr = PyObject_Str(ptype);
-            std::string sType = py::reinterpret_borrow<py::str>(pStr);
-            Py_XDECREF(pStr);
-            pStr = PyObject_Str(pvalue);
-            sType += ": ";
-            sType += py::reinterpret_borrow<py::str>(pStr);
-            Py_XDECREF(pStr);
-            throw std::runtime_error(sType);
-          }
-          feeds.insert(std::make_pair(_.first, ml_value));
-        }
-
-        std::vector<MLValue> fetches;
+        return RunSession(sess, nullptr, output_names, pyfeeds, run_options);
+      })
+      .def(
+          "run_stream", [](InferenceSession* sess, const std::string& stream_id, std::vector<std::string> output_names, std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr) -> std::vector<py::object> {
+            return RunSession(sess, &stream_id, output_names, pyfeeds, run_options);
+          },
+          R"pbdoc(Run the next chunk of a stream created with create_stream.)pbdoc")
+      .def(
+          "create_stream", [](InferenceSession* sess, const std::string& stream_id) {
+            auto status = sess->CreateStream(stream_id);
+            if (!status.IsOK()) {
+              throw std::runtime_error(status.ToString().c_str());
+            }
+          },
+          R"pbdoc(Create a stream keeping the state tensors of the session between runs.)pbdoc")
+      .def(
+          "reset_stream", [](InferenceSession* sess, const std::string& stream_id) {
+            auto status = sess->ResetStream(stream_id);
+            if (!status.IsOK()) {
+              throw std::runtime_error(status.ToString().c_str());
+            }
+          },
+          R"pbdoc(Discard the state of a stream.)pbdoc")
+      .def(
+          "drop_stream", [](InferenceSession* sess, const std::string& stream_id) {
+            auto status = sess->DropStream(stream_id);
+            if (!status.IsOK()) {
+              throw std::runtime_error(status.ToString().c_str());
+            }
+          },
+          R"pbdoc(Remove a stream and release its state.)pbdoc")
+      .def("run_with_iobinding", [](InferenceSession* sess, SessionIOBinding& io_binding, RunOptions* run_options = nullptr) {
         common::Status status;
-
-        if (run_options != nullptr) {
-          status = sess->Run(*run_options, feeds, output_names, &fetches);
-        } else {
-          status = sess->Run(feeds, output_names, &fetches);
+        {
+          // Let other Python threads run while the session executes
+          py::gil_scoped_release release;
+          if (run_options != nullptr) {
+            status = sess->Run(*run_options, *io_binding.binding);
+          } else {
+            status = sess->Run(*io_binding.binding);
+          }
         }
 
         if (!status.IsOK()) {
           auto mes = status.ToString();
-          throw std::runtime_error(std::string("Method run failed due to: ") + std::string(mes.c_str()));
-        }
-
-        std::vector<py::object> rfetch;
-        rfetch.reserve(fetches.size());
-        for (auto _ : fetches) {
-          if (_.IsTensor()) {
-            AddTensorAsPyObj(_, rfetch);
-          } else {
-            AddNonTensorAsPyObj(_, rfetch);
-          }
+          throw std::runtime_error(std::string("Method run_with_iobinding failed due to: ") + std::string(mes.c_str()));
         }
-        return rfetch;
       })
       .def("end_profiling", [](InferenceSession* sess) -> std::string {
         return sess->EndProfiling();
       })
+      .def(
+          "set_activation_observer", [](InferenceSession* sess, std::shared_ptr<ActivationStatistics> statistics) {
+            sess->SetActivationObserver(std::move(statistics));
+          },
+          R"pbdoc(Collect the statistics of the values computed by the subsequent runs, or stop if None.)pbdoc")
       .def_property_readonly("inputs_meta", [](const InferenceSession* sess) -> const std::vector<const onnxruntime::NodeArg*>& {
         auto res = sess->GetModelInputs();
         if (!res.first.IsOK()) {
@@ -71,6 +71,86 @@ class InferenceSession:
             output_names = [output.name for output in self._outputs_meta]
         return self._sess.run(output_names, input_feed, run_options)
 
+    def create_stream(self, stream_id):
+        """
+        Create a stream for chunked inference. The session keeps the state tensors
+        listed in :meth:`onnxruntime.SessionOptions.state_tensors` for each stream
+        and feeds the state computed by a run to the next run of the same stream.
+
+        :param stream_id: name of the stream
+        """
+        self._sess.create_stream(stream_id)
+
+    def reset_stream(self, stream_id):
+        "Discard the state of a stream so that its next run starts from the initial state."
+        self._sess.reset_stream(stream_id)
+
+    def drop_stream(self, stream_id):
+        "Remove a stream and release its state."
+        self._sess.drop_stream(stream_id)
+
+    def run_stream(self, stream_id, output_names, input_feed, run_options=None):
+        """
+        Compute the predictions for the next chunk of a stream.
+        State inputs missing from *input_feed* receive the state left by the previous run of the stream.
+
+        :param stream_id: name of a stream created with :meth:`create_stream`
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: input_value }``
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+
+        ::
+
+            sess.create_stream("s1")
+            for chunk in chunks:
+                res = sess.run_stream("s1", [output_name], {input_name: chunk})
+        """
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        return self._sess.run_stream(stream_id, output_names, input_feed, run_options)
+
+    def io_binding(self):
+        "Return an :class:`onnxruntime.IOBinding` to bind the inputs and outputs of this session."
+        return IOBinding(self)
+
+    def run_with_iobinding(self, iobinding, run_options=None):
+        """
+        Compute the predictions for the inputs and outputs bound to *iobinding*.
+        Outputs bound to numpy arrays are written to in place, so repeated runs
+        do not allocate any output memory.
+
+        :param iobinding: the :class:`onnxruntime.IOBinding` object
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+
+        ::
+
+            binding = sess.io_binding()
+            binding.bind_input(input_name, x)
+            binding.bind_output(output_name, y)
+            sess.run_with_iobinding(binding)
+        """
+        self._sess.run_with_iobinding(iobinding._iobinding, run_options)
+
+    def set_activation_observer(self, statistics):
+        """
+        Collect the range of the inputs and of the float values computed by the
+        nodes of the main graph in the subsequent runs. This is how calibration
+        for static quantization observes the activations.
+
+        :param statistics: :class:`onnxruntime.ActivationStatistics` accumulating
+            the statistics, or None to stop collecting
+
+        ::
+
+            statistics = onnxruntime.ActivationStatistics(num_bins=2048)
+            sess.set_activation_observer(statistics)
+            for x in calibration_data:
+                sess.run(None, {input_name: x})
+            sess.set_activation_observer(None)
+            min_value, max_value, histogram, histogram_range = statistics.get()[name]
+        """
+        self._sess.set_activation_observer(statistics)
+
     def end_profiling(self):
         """
         End profiling and return results in a file.
@@ -79,3 +159,37 @@ class InferenceSession:
         :meth:`onnxruntime.SessionOptions.enable_profiling`.
         """
         return self._sess.end_profiling()
+
+
+class IOBinding:
+    """
+    Inputs and outputs of a session bound once and reused across runs.
+    """
+    def __init__(self, session):
+        self._iobinding = C.SessionIOBinding(session._sess)
+
+    def bind_input(self, name, value):
+        """
+        :param name: input name
+        :param value: input value, contiguous numpy arrays are used without a copy
+            and must not be modified while a run is in progress
+        """
+        self._iobinding.bind_input(name, value)
+
+    def bind_output(self, name, value=None):
+        """
+        :param name: output name
+        :param value: contiguous, writeable numpy array of the output type and shape
+            the output is computed into, or None to allocate the output on every run
+        """
+        self._iobinding.bind_output(name, value)
+
+    def get_outputs(self):
+        "Return the outputs of the last run in the order they were bound."
+        return self._iobinding.get_outputs()
+
+    def clear_binding_inputs(self):
+        self._iobinding.clear_binding_inputs()
+
+    def clear_binding_outputs(self):
+        self._iobinding.clear_binding_outputs()
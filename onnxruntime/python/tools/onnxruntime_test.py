@@ -8,6 +8,7 @@ import onnxruntime as onnxrt
 import numpy as np
 import os
 import sys
+import threading
 from timeit import default_timer as timer
 
 float_dict = {
@@ -38,6 +39,8 @@ def main():
                         help='pause execution to allow attaching a debugger.')
     parser.add_argument('--profile', action='store_true',
                         help='enable chrome timeline trace profiling.')
+    parser.add_argument('--threads', type=int, default=1,
+                        help='number of python threads calling run concurrently. default=1')
     args = parser.parse_args()
     iters = args.num_iters
 
@@ -74,15 +77,33 @@ def main():
                 input_meta.type, input_meta.name))
             sys.exit(-1)
 
+    num_threads = max(1, args.threads)
+    latencies = [0.0] * num_threads
+
+    def run_iters(index, count):
+        thread_start = timer()
+        for i in range(count):
+            sess.run([], feeds)  # fetch all outputs
+        if count:
+            latencies[index] = (timer() - thread_start) / count
+
+    # run() releases the GIL so the threads execute the model concurrently
+    counts = [iters // num_threads + (1 if i < iters % num_threads else 0) for i in range(num_threads)]
+    threads = [threading.Thread(target=run_iters, args=(i, counts[i])) for i in range(num_threads)]
     start = timer()
-    for i in range(iters):
-        sess.run([], feeds)  # fetch all outputs
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
     end = timer()
 
     print("model: {}".format(meta.graph_name))
     print("version: {}".format(meta.version))
     print("iterations: {}".format(iters))
-    print("avg latency: {} ms".format(((end - start)*1000)/iters))
+    print("threads: {}".format(num_threads))
+    print("avg latency: {} ms".format(
+        sum(l * c for l, c in zip(latencies, counts)) * 1000 / max(1, iters)))
+    print("throughput: {} runs/s".format(iters / (end - start)))
 
     if args.profile:
         trace_file = sess.end_profiling()
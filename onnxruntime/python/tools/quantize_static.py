@@ -0,0 +1,320 @@
+#-------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+#--------------------------------------------------------------------------
+
+import argparse
+import glob
+import os
+import sys
+
+import numpy as np
+import onnx
+from onnx import helper, numpy_helper, TensorProto
+import onnxruntime as onnxrt
+
+# static post-training quantization.
+# the model is run on a calibration data set while the session collects the range of every activation,
+# then the float Conv and MatMul nodes are replaced by QLinearConv and QLinearMatMul nodes with uint8 inputs
+# and outputs. the weights are quantized offline and the activations at the boundaries of the quantized
+# regions are converted with QuantizeLinear and DequantizeLinear.
+
+ms_domain = 'com.microsoft'
+
+
+def load_calibration_data(data_dir, input_names, max_samples):
+    """
+    Load the feeds of the calibration runs from the test_data_set_* directories in data_dir.
+    Each directory holds the serialized TensorProto of the inputs in input_<index>.pb files,
+    the layout used by onnx_test_runner and onnxruntime_perf_test.
+    """
+    data_sets = sorted(glob.glob(os.path.join(data_dir, 'test_data_set_*')))
+    if not data_sets:
+        raise ValueError("No test_data_set_* directories found in '{}'".format(data_dir))
+    if max_samples > 0:
+        data_sets = data_sets[:max_samples]
+
+    feeds = []
+    for data_set in data_sets:
+        input_files = sorted(glob.glob(os.path.join(data_set, 'input_*.pb')),
+                             key=lambda f: int(os.path.basename(f)[len('input_'):-len('.pb')]))
+        feed = {}
+        for index, input_file in enumerate(input_files):
+            tensor = TensorProto()
+            with open(input_file, 'rb') as f:
+                tensor.ParseFromString(f.read())
+            name = tensor.name if tensor.name else input_names[index]
+            feed[name] = numpy_helper.to_array(tensor)
+        feeds.append(feed)
+    return feeds
+
+
+def collect_statistics(model_path, feeds, num_bins):
+    sess = onnxrt.InferenceSession(model_path)
+    statistics = onnxrt.ActivationStatistics(num_bins=num_bins)
+    sess.set_activation_observer(statistics)
+    for feed in feeds:
+        sess.run([], feed)
+    sess.set_activation_observer(None)
+    return statistics.get()
+
+
+def compute_range(entry, percentile):
+    """
+    Return the range [rmin, rmax] of an activation, which always includes zero so that it is exactly representable.
+    With a percentile below 100 the range is clipped to the absolute value below which that percentage of the
+    values falls, trading the precision of the outliers for the precision of the bulk of the values.
+    """
+    rmin, rmax, histogram, histogram_range = entry
+    if percentile < 100.0 and histogram and histogram_range > 0:
+        cumulative = np.cumsum(histogram)
+        index = int(np.searchsorted(cumulative, cumulative[-1] * percentile / 100.0))
+        threshold = (index + 1) * histogram_range / len(histogram)
+        rmin = max(rmin, -threshold)
+        rmax = min(rmax, threshold)
+    return min(rmin, 0.0), max(rmax, 0.0)
+
+
+def compute_scale_zero_point(rmin, rmax):
+    scale = (rmax - rmin) / 255.0
+    if scale == 0.0:
+        return 1.0, 0
+    zero_point = int(np.clip(np.round(-rmin / scale), 0, 255))
+    return scale, zero_point
+
+
+def quantize_weight(weight, per_channel):
+    """
+    Quantize a weight to uint8. Per channel quantization is symmetric with a zero point of 128, because the
+    integer kernels only accept a per channel scale.
+    """
+    if per_channel:
+        abs_max = np.abs(weight.reshape(weight.shape[0], -1)).max(axis=1)
+        scale = np.where(abs_max > 0, abs_max / 127.0, 1.0).astype(np.float32)
+        zero_point = 128
+        broadcast_scale = scale.reshape([-1] + [1] * (weight.ndim - 1))
+    else:
+        scale, zero_point = compute_scale_zero_point(min(float(weight.min()), 0.0), max(float(weight.max()), 0.0))
+        scale = np.float32(scale)
+        broadcast_scale = scale
+    quantized = np.clip(np.round(weight / broadcast_scale) + zero_point, 0, 255).astype(np.uint8)
+    return quantized, scale, zero_point
+
+
+class StaticQuantizer:
+    def __init__(self, model, ranges, op_types, per_channel):
+        self.model = model
+        self.ranges = ranges
+        self.op_types = op_types
+        self.per_channel = per_channel
+        self.initializers = {init.name: init for init in model.graph.initializer}
+        self.new_initializers = []
+        self.new_nodes = []
+        # names of the activations with scale and zero point initializers
+        self.parameterized = set()
+        # name of a weight -> names of its quantized tensor, scale and zero point, and the scale values
+        self.quantized_weights = {}
+        # name of a float tensor -> name of its uint8 version
+        self.quantized_names = {}
+
+    def add_initializer(self, name, array):
+        self.new_initializers.append(numpy_helper.from_array(np.asarray(array), name))
+        return name
+
+    def quantization_parameters(self, name):
+        """
+        Add the scale and zero point of an activation as initializers and return their names.
+        """
+        scale_name = name + '_scale'
+        zero_point_name = name + '_zero_point'
+        if name not in self.parameterized:
+            self.parameterized.add(name)
+            scale, zero_point = compute_scale_zero_point(*self.ranges[name])
+            self.add_initializer(scale_name, np.float32(scale))
+            self.add_initializer(zero_point_name, np.uint8(zero_point))
+        return scale_name, zero_point_name
+
+    def activation_scale(self, name):
+        return compute_scale_zero_point(*self.ranges[name])[0]
+
+    def quantize_activation(self, name):
+        """
+        Return the name of the uint8 version of an activation, adding a QuantizeLinear node if the activation
+        isn't already available quantized.
+        """
+        if name not in self.quantized_names:
+            scale_name, zero_point_name = self.quantization_parameters(name)
+            quantized_name = name + '_quantized'
+            self.new_nodes.append(helper.make_node('QuantizeLinear', [name, scale_name, zero_point_name],
+                                                   [quantized_name], name + '_QuantizeLinear', domain=ms_domain))
+            self.quantized_names[name] = quantized_name
+        return self.quantized_names[name]
+
+    def quantize_input(self, name, per_channel=False):
+        """
+        Return the names of the quantized tensor, scale and zero point of a node input, and the scale values.
+        """
+        if name in self.initializers:
+            if name not in self.quantized_weights:
+                weight = numpy_helper.to_array(self.initializers[name])
+                quantized, scale, zero_point = quantize_weight(weight, per_channel)
+                self.quantized_weights[name] = (self.add_initializer(name + '_quantized', quantized),
+                                                self.add_initializer(name + '_scale', scale),
+                                                self.add_initializer(name + '_zero_point', np.uint8(zero_point)),
+                                                scale)
+            return self.quantized_weights[name]
+        quantized_name = self.quantize_activation(name)
+        scale_name, zero_point_name = self.quantization_parameters(name)
+        return quantized_name, scale_name, zero_point_name, np.float32(self.activation_scale(name))
+
+    def dequantize_output(self, name):
+        """
+        Return the name the quantized node writes its output to, adding a DequantizeLinear node that
+        produces the float output for the consumers that aren't quantized.
+        """
+        scale_name, zero_point_name = self.quantization_parameters(name)
+        quantized_name = name + '_quantized'
+        self.quantized_names[name] = quantized_name
+        self.new_nodes.append(helper.make_node('DequantizeLinear', [quantized_name, scale_name, zero_point_name],
+                                               [name], name + '_DequantizeLinear', domain=ms_domain))
+        return quantized_name
+
+    def can_quantize(self, node):
+        if node.op_type not in self.op_types or node.domain not in ('', 'ai.onnx'):
+            return False
+        if node.op_type == 'Conv':
+            if node.input[1] not in self.initializers:
+                return False
+            if len(node.input) > 2 and node.input[2] and node.input[2] not in self.initializers:
+                return False
+        activations = [name for name in node.input[:2] if name not in self.initializers]
+        return all(name in self.ranges for name in activations) and node.output[0] in self.ranges
+
+    def quantize_conv(self, node):
+        x, x_scale, x_zero_point, x_scale_value = self.quantize_input(node.input[0])
+        w, w_scale, w_zero_point, w_scale_value = self.quantize_input(node.input[1], self.per_channel)
+        inputs = [x, x_scale, x_zero_point, w, w_scale, w_zero_point]
+
+        y_scale, y_zero_point = self.quantization_parameters(node.output[0])
+        inputs += [y_scale, y_zero_point]
+
+        if len(node.input) > 2 and node.input[2]:
+            # the bias is added to the int32 accumulators, so its scale is the product of the input scales
+            bias = numpy_helper.to_array(self.initializers[node.input[2]])
+            bias_scale = x_scale_value * w_scale_value
+            quantized_bias = np.round(bias / bias_scale).astype(np.int32)
+            inputs.append(self.add_initializer(node.input[2] + '_quantized', quantized_bias))
+
+        y = self.dequantize_output(node.output[0])
+        conv = helper.make_node('QLinearConv', inputs, [y], (node.name or node.output[0]) + '_quant',
+                                domain=ms_domain)
+        conv.attribute.extend(node.attribute)
+        # the dequantize node has been added already, the conv must come first
+        self.new_nodes.insert(len(self.new_nodes) - 1, conv)
+
+    def quantize_matmul(self, node):
+        a, a_scale, a_zero_point, _ = self.quantize_input(node.input[0])
+        b, b_scale, b_zero_point, _ = self.quantize_input(node.input[1])
+        y_scale, y_zero_point = self.quantization_parameters(node.output[0])
+        y = self.dequantize_output(node.output[0])
+        matmul = helper.make_node('QLinearMatMul', [a, a_scale, a_zero_point, b, b_scale, b_zero_point,
+                                                    y_scale, y_zero_point], [y],
+                                  (node.name or node.output[0]) + '_quant', domain=ms_domain)
+        self.new_nodes.insert(len(self.new_nodes) - 1, matmul)
+
+    def remove_unused_dequantize_nodes(self):
+        graph_outputs = set(output.name for output in self.model.graph.output)
+        consumed = set(name for node in self.new_nodes for name in node.input)
+        self.new_nodes = [node for node in self.new_nodes
+                          if node.op_type != 'DequantizeLinear' or node.domain != ms_domain or
+                          node.output[0] in consumed or node.output[0] in graph_outputs]
+
+    def quantize(self):
+        num_quantized = 0
+        for node in self.model.graph.node:
+            if not self.can_quantize(node):
+                # consumers that aren't quantized read the float value, produced by a DequantizeLinear node
+                self.new_nodes.append(node)
+                continue
+            if node.op_type == 'Conv':
+                self.quantize_conv(node)
+            else:
+                self.quantize_matmul(node)
+            num_quantized += 1
+
+        # a chain of quantized nodes passes the uint8 values along, the float version may not be needed
+        self.remove_unused_dequantize_nodes()
+
+        # weights that are only used by the quantized nodes are dropped
+        consumed = set(name for node in self.new_nodes for name in node.input)
+        initializers = [init for init in self.model.graph.initializer if init.name in consumed]
+        initializers += self.new_initializers
+
+        graph = self.model.graph
+        del graph.node[:]
+        graph.node.extend(self.new_nodes)
+        del graph.initializer[:]
+        graph.initializer.extend(initializers)
+        # initializers that were inputs of the graph so they could be overridden are removed with them
+        kept_inputs = [value for value in graph.input
+                       if value.name in consumed or value.name not in self.initializers]
+        del graph.input[:]
+        graph.input.extend(kept_inputs)
+
+        if not any(opset.domain == ms_domain for opset in self.model.opset_import):
+            opset = self.model.opset_import.add()
+            opset.domain = ms_domain
+            opset.version = 1
+        return num_quantized
+
+
+def quantize_static(model_path, output_path, calibration_data_dir, op_types=('Conv', 'MatMul'),
+                    per_channel=False, percentile=100.0, num_bins=2048, max_samples=0):
+    """
+    Quantize the Conv and MatMul nodes of a float model using the activation ranges observed while running
+    the calibration data, and save the model to output_path.
+    :return: the number of nodes that were quantized
+    """
+    model = onnx.load(model_path)
+    initializer_names = set(init.name for init in model.graph.initializer)
+    input_names = [value.name for value in model.graph.input if value.name not in initializer_names]
+
+    feeds = load_calibration_data(calibration_data_dir, input_names, max_samples)
+    statistics = collect_statistics(model_path, feeds, num_bins if percentile < 100.0 else 0)
+    ranges = {name: compute_range(entry, percentile) for name, entry in statistics.items()}
+
+    quantizer = StaticQuantizer(model, ranges, set(op_types), per_channel)
+    num_quantized = quantizer.quantize()
+    onnx.save(model, output_path)
+    return num_quantized
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Quantize the Conv and MatMul nodes of an ONNX model to uint8 '
+                                     'using activation ranges collected by calibration runs.')
+    parser.add_argument('model_path', help='float model path')
+    parser.add_argument('calibration_data_dir',
+                        help='directory with test_data_set_* directories holding the input_*.pb of each run')
+    parser.add_argument('output_path', help='quantized model path')
+    parser.add_argument('--op_types', default='Conv,MatMul',
+                        help='comma separated operator types to quantize. default=Conv,MatMul')
+    parser.add_argument('--per_channel', action='store_true',
+                        help='quantize the Conv weights per output channel.')
+    parser.add_argument('--percentile', type=float, default=100.0,
+                        help='percentile of the absolute values of each activation its range is clipped to. '
+                        'default=100, the observed minimum and maximum')
+    parser.add_argument('--num_bins', type=int, default=2048,
+                        help='number of histogram bins used with --percentile. default=2048')
+    parser.add_argument('--max_samples', type=int, default=0,
+                        help='maximum number of calibration runs, 0 for all. default=0')
+    args = parser.parse_args()
+
+    num_quantized = quantize_static(args.model_path, args.output_path, args.calibration_data_dir,
+                                    args.op_types.split(','), args.per_channel, args.percentile, args.num_bins,
+                                    args.max_samples)
+    print("Quantized {} nodes. Saved the model to {}".format(num_quantized, args.output_path))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
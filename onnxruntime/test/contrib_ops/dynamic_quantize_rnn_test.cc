@@ -0,0 +1,236 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+std::vector<float> RandomData(size_t count, float range, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-range, range);
+  std::vector<float> data(count);
+  for (auto& v : data) {
+    v = dist(rng);
+  }
+  return data;
+}
+
+float Sigmoid(float x) {
+  return 1.f / (1.f + std::exp(-x));
+}
+
+// out[n] = bias[n] + sum(in[k] * weights[n, k])
+void MatVec(const float* in, const float* weights, const float* bias, int N, int K, float* out) {
+  for (int n = 0; n < N; ++n) {
+    float sum = bias != nullptr ? bias[n] : 0.f;
+    for (int k = 0; k < K; ++k) {
+      sum += in[k] * weights[n * K + k];
+    }
+    out[n] = sum;
+  }
+}
+
+struct RnnData {
+  int64_t seq_length;
+  int64_t batch_size;
+  int64_t input_size;
+  int64_t hidden_size;
+  int64_t num_directions;
+  std::vector<float> X, W, R, B;
+  std::vector<float> Y, Y_h, Y_c;
+};
+
+RnnData MakeRnnData(int num_gates, int64_t seq_length, int64_t batch_size, int64_t input_size, int64_t hidden_size,
+                    const std::string& direction) {
+  RnnData data;
+  data.seq_length = seq_length;
+  data.batch_size = batch_size;
+  data.input_size = input_size;
+  data.hidden_size = hidden_size;
+  data.num_directions = direction == "bidirectional" ? 2 : 1;
+
+  data.X = RandomData(seq_length * batch_size * input_size, 1.f, 1);
+  data.W = RandomData(data.num_directions * num_gates * hidden_size * input_size, 0.5f, 2);
+  data.R = RandomData(data.num_directions * num_gates * hidden_size * hidden_size, 0.5f, 3);
+  data.B = RandomData(data.num_directions * 2 * num_gates * hidden_size, 0.2f, 4);
+
+  data.Y.resize(seq_length * data.num_directions * batch_size * hidden_size);
+  data.Y_h.resize(data.num_directions * batch_size * hidden_size);
+  data.Y_c.resize(data.num_directions * batch_size * hidden_size);
+  return data;
+}
+
+// fp32 reference with the default activations
+void ReferenceLstm(RnnData& data, const std::string& direction) {
+  const int H = static_cast<int>(data.hidden_size);
+  const int I = static_cast<int>(data.input_size);
+  for (int64_t dir = 0; dir < data.num_directions; ++dir) {
+    const bool reverse = direction == "reverse" || dir == 1;
+    const float* W = data.W.data() + dir * 4 * H * I;
+    const float* R = data.R.data() + dir * 4 * H * H;
+    const float* Wb = data.B.data() + dir * 8 * H;
+    const float* Rb = Wb + 4 * H;
+
+    for (int64_t b = 0; b < data.batch_size; ++b) {
+      std::vector<float> h(H, 0.f), c(H, 0.f), xw(4 * H), hr(4 * H);
+      for (int64_t s = 0; s < data.seq_length; ++s) {
+        const int64_t t = reverse ? data.seq_length - 1 - s : s;
+        MatVec(&data.X[(t * data.batch_size + b) * I], W, Wb, 4 * H, I, xw.data());
+        MatVec(h.data(), R, Rb, 4 * H, H, hr.data());
+        for (int j = 0; j < H; ++j) {
+          // gates are in iofc order
+          const float i_gate = Sigmoid(xw[j] + hr[j]);
+          const float o_gate = Sigmoid(xw[H + j] + hr[H + j]);
+          const float f_gate = Sigmoid(xw[2 * H + j] + hr[2 * H + j]);
+          const float c_gate = std::tanh(xw[3 * H + j] + hr[3 * H + j]);
+          c[j] = f_gate * c[j] + i_gate * c_gate;
+          h[j] = o_gate * std::tanh(c[j]);
+        }
+        std::copy(h.cbegin(), h.cend(), &data.Y[((t * data.num_directions + dir) * data.batch_size + b) * H]);
+      }
+      std::copy(h.cbegin(), h.cend(), &data.Y_h[(dir * data.batch_size + b) * H]);
+      std::copy(c.cbegin(), c.cend(), &data.Y_c[(dir * data.batch_size + b) * H]);
+    }
+  }
+}
+
+// fp32 reference with the default activations
+void ReferenceGru(RnnData& data, const std::string& direction, bool linear_before_reset) {
+  const int H = static_cast<int>(data.hidden_size);
+  const int I = static_cast<int>(data.input_size);
+  for (int64_t dir = 0; dir < data.num_directions; ++dir) {
+    const bool reverse = direction == "reverse" || dir == 1;
+    const float* W = data.W.data() + dir * 3 * H * I;
+    const float* R = data.R.data() + dir * 3 * H * H;
+    const float* Wb = data.B.data() + dir * 6 * H;
+    const float* Rb = Wb + 3 * H;
+
+    for (int64_t b = 0; b < data.batch_size; ++b) {
+      std::vector<float> h(H, 0.f), xw(3 * H), hr(3 * H), rh(H), rh_r(H);
+      for (int64_t s = 0; s < data.seq_length; ++s) {
+        const int64_t t = reverse ? data.seq_length - 1 - s : s;
+        MatVec(&data.X[(t * data.batch_size + b) * I], W, Wb, 3 * H, I, xw.data());
+        MatVec(h.data(), R, Rb, 3 * H, H, hr.data());
+
+        // gates are in zrh order
+        std::vector<float> z(H), r(H);
+        for (int j = 0; j < H; ++j) {
+          z[j] = Sigmoid(xw[j] + hr[j]);
+          r[j] = Sigmoid(xw[H + j] + hr[H + j]);
+          rh[j] = r[j] * h[j];
+        }
+
+        // (rt (.) Ht-1) * Rh^T + Rbh
+        MatVec(rh.data(), R + 2 * H * H, Rb + 2 * H, H, H, rh_r.data());
+
+        for (int j = 0; j < H; ++j) {
+          const float h_input = linear_before_reset ? xw[2 * H + j] + r[j] * hr[2 * H + j]
+                                                    : xw[2 * H + j] + rh_r[j];
+          const float h_gate = std::tanh(h_input);
+          h[j] = (1.f - z[j]) * h_gate + z[j] * h[j];
+        }
+        std::copy(h.cbegin(), h.cend(), &data.Y[((t * data.num_directions + dir) * data.batch_size + b) * H]);
+      }
+      std::copy(h.cbegin(), h.cend(), &data.Y_h[(dir * data.batch_size + b) * H]);
+    }
+  }
+}
+
+// run the fp32 kernel (op_type LSTM/GRU) or the quantized contrib op against the reference output
+void RunRnn(const char* op_type, const char* domain, int num_gates, const RnnData& data, const std::string& direction,
+            float abs_error, bool weights_are_initializers = true, bool linear_before_reset = false,
+            OpTester::ExpectResult expect_result = OpTester::ExpectResult::kExpectSuccess,
+            const std::string& expected_failure = "") {
+  OpTester test(op_type, std::string(domain) == kMSDomain ? 1 : 7, domain);
+  test.AddAttribute("direction", direction);
+  test.AddAttribute("hidden_size", data.hidden_size);
+  if (num_gates == 3)
+    test.AddAttribute<int64_t>("linear_before_reset", linear_before_reset ? 1 : 0);
+
+  const int64_t H = data.hidden_size;
+  test.AddInput<float>("X", {data.seq_length, data.batch_size, data.input_size}, data.X);
+  test.AddInput<float>("W", {data.num_directions, num_gates * H, data.input_size}, data.W, weights_are_initializers);
+  test.AddInput<float>("R", {data.num_directions, num_gates * H, H}, data.R, weights_are_initializers);
+  test.AddInput<float>("B", {data.num_directions, 2 * num_gates * H}, data.B);
+
+  test.AddOutput<float>("Y", {data.seq_length, data.num_directions, data.batch_size, H}, data.Y);
+  test.AddOutput<float>("Y_h", {data.num_directions, data.batch_size, H}, data.Y_h);
+  test.SetOutputAbsErr("Y", abs_error);
+  test.SetOutputAbsErr("Y_h", abs_error);
+  if (num_gates == 4) {
+    test.AddOutput<float>("Y_c", {data.num_directions, data.batch_size, H}, data.Y_c);
+    test.SetOutputAbsErr("Y_c", abs_error);
+  }
+
+  test.Run(expect_result, expected_failure);
+}
+
+// the fp32 kernels should match the reference closely. the quantized kernels are compared against
+// the same reference with a tolerance that allows for the error from quantizing weights and activations.
+constexpr float kFloatError = 1e-3f;
+constexpr float kQuantizedError = 5e-2f;
+
+}  // namespace
+
+TEST(DynamicQuantizeRnnTest, LSTMForward) {
+  auto data = MakeRnnData(4, 5, 3, 8, 6, "forward");
+  ReferenceLstm(data, "forward");
+  RunRnn("LSTM", kOnnxDomain, 4, data, "forward", kFloatError);
+  RunRnn("DynamicQuantizeLSTM", kMSDomain, 4, data, "forward", kQuantizedError);
+}
+
+TEST(DynamicQuantizeRnnTest, LSTMReverse) {
+  auto data = MakeRnnData(4, 4, 2, 8, 6, "reverse");
+  ReferenceLstm(data, "reverse");
+  RunRnn("LSTM", kOnnxDomain, 4, data, "reverse", kFloatError);
+  RunRnn("DynamicQuantizeLSTM", kMSDomain, 4, data, "reverse", kQuantizedError);
+}
+
+TEST(DynamicQuantizeRnnTest, LSTMBidirectionalLargeBatch) {
+  // large enough batch that the rows are processed in parallel
+  auto data = MakeRnnData(4, 3, 32, 16, 8, "bidirectional");
+  ReferenceLstm(data, "bidirectional");
+  RunRnn("LSTM", kOnnxDomain, 4, data, "bidirectional", kFloatError);
+  RunRnn("DynamicQuantizeLSTM", kMSDomain, 4, data, "bidirectional", kQuantizedError);
+}
+
+TEST(DynamicQuantizeRnnTest, LSTMWeightsMustBeInitializers) {
+  auto data = MakeRnnData(4, 2, 1, 4, 3, "forward");
+  ReferenceLstm(data, "forward");
+  RunRnn("DynamicQuantizeLSTM", kMSDomain, 4, data, "forward", kQuantizedError, false, false,
+         OpTester::ExpectResult::kExpectFailure, "W and R must be initializers");
+}
+
+TEST(DynamicQuantizeRnnTest, GRUForward) {
+  auto data = MakeRnnData(3, 5, 3, 8, 6, "forward");
+  ReferenceGru(data, "forward", false);
+  RunRnn("GRU", kOnnxDomain, 3, data, "forward", kFloatError);
+  RunRnn("DynamicQuantizeGRU", kMSDomain, 3, data, "forward", kQuantizedError);
+}
+
+TEST(DynamicQuantizeRnnTest, GRULinearBeforeReset) {
+  auto data = MakeRnnData(3, 5, 3, 8, 6, "forward");
+  ReferenceGru(data, "forward", true);
+  RunRnn("GRU", kOnnxDomain, 3, data, "forward", kFloatError, true, true);
+  RunRnn("DynamicQuantizeGRU", kMSDomain, 3, data, "forward", kQuantizedError, true, true);
+}
+
+TEST(DynamicQuantizeRnnTest, GRUBidirectionalLargeBatch) {
+  auto data = MakeRnnData(3, 3, 32, 16, 8, "bidirectional");
+  ReferenceGru(data, "bidirectional", false);
+  RunRnn("GRU", kOnnxDomain, 3, data, "bidirectional", kFloatError);
+  RunRnn("DynamicQuantizeGRU", kMSDomain, 3, data, "bidirectional", kQuantizedError);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -8,6 +8,8 @@
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
 
+#include <random>
+
 namespace onnxruntime {
 namespace test {
 
@@ -30,5 +32,68 @@ TEST(MatmulIntegerOpTest, MatMulInteger) {
   test.AddOutput<int32_t>("T3", {1, 1}, {-1});
   test.Run();
 }
+
+TEST(MatmulIntegerOpTest, MatMulInteger_Int8_B) {
+  OpTester test("MatMulInteger", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("T1", {2, 3}, {11, 7, 3, 255, 0, 128});
+  test.AddInput<int8_t>("T2", {3, 2}, {1, -4, 2, 5, -128, 127});
+  test.AddInput<uint8_t>("a_zero_point", {}, {12});
+  test.AddInput<int8_t>("b_zero_point", {}, {-1});
+  // (A - 12) * (B + 1)
+  test.AddOutput<int32_t>("T3", {2, 2}, {(-1 * 2) + (-5 * 3) + (-9 * -127), (-1 * -3) + (-5 * 6) + (-9 * 128),
+                                         (243 * 2) + (-12 * 3) + (116 * -127), (243 * -3) + (-12 * 6) + (116 * 128)});
+  test.Run();
+}
+
+// compare against a reference for shapes that span several blocks of the packed kernels, with B supplied either
+// as an initializer (packed when the kernel is created) or as a graph input.
+template <typename T2>
+void RunMatMulIntegerRandom(const std::vector<int64_t>& a_dims, int64_t N, bool b_is_initializer) {
+  std::mt19937 rng(static_cast<unsigned>(N + a_dims.size()));
+  std::uniform_int_distribution<int> dist(0, 255);
+
+  const int64_t K = a_dims.back();
+  int64_t M = 1;
+  for (size_t i = 0; i + 1 < a_dims.size(); i++) M *= a_dims[i];
+
+  std::vector<uint8_t> a(M * K);
+  std::vector<T2> b(K * N);
+  for (auto& v : a) v = static_cast<uint8_t>(dist(rng));
+  for (auto& v : b) v = static_cast<T2>(dist(rng));
+  const uint8_t a_zero_point = 100;
+  const T2 b_zero_point = static_cast<T2>(30);
+
+  std::vector<int32_t> y(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      int32_t sum = 0;
+      for (int64_t k = 0; k < K; k++) {
+        sum += (static_cast<int32_t>(a[m * K + k]) - a_zero_point) *
+               (static_cast<int32_t>(b[k * N + n]) - static_cast<int32_t>(b_zero_point));
+      }
+      y[m * N + n] = sum;
+    }
+  }
+
+  std::vector<int64_t> y_dims(a_dims);
+  y_dims.back() = N;
+
+  OpTester test("MatMulInteger", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("T1", a_dims, a);
+  test.AddInput<T2>("T2", {K, N}, b, b_is_initializer);
+  test.AddInput<uint8_t>("a_zero_point", {}, {a_zero_point});
+  test.AddInput<T2>("b_zero_point", {}, {b_zero_point}, b_is_initializer);
+  test.AddOutput<int32_t>("T3", y_dims, y);
+  test.Run();
+}
+
+TEST(MatmulIntegerOpTest, MatMulInteger_Random) {
+  for (bool b_is_initializer : {false, true}) {
+    RunMatMulIntegerRandom<uint8_t>({1, 300}, 200, b_is_initializer);
+    RunMatMulIntegerRandom<uint8_t>({2, 17, 261}, 131, b_is_initializer);
+    RunMatMulIntegerRandom<int8_t>({1, 300}, 200, b_is_initializer);
+    RunMatMulIntegerRandom<int8_t>({2, 17, 261}, 131, b_is_initializer);
+  }
+}
 }  // namespace test
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
@@ -80,5 +80,34 @@ TEST(ContribOpTest, MaxPoolWithMask) {
   test.Run();
 }
 
+TEST(ContribOpTest, MaxPoolWithMask_Unmasked) {
+  OpTester test("MaxpoolWithMask", 1, onnxruntime::kMSDomain);
+
+  test.AddAttribute("auto_pad", "");
+  test.AddAttribute("strides", std::vector<int64_t>{1, 1});
+  test.AddAttribute("pads", std::vector<int64_t>{0, 0, 0, 0});
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+
+  std::vector<float> x_vals = {
+      1, 5, 2,
+      4, 3, 9,
+      7, 0, 6,
+
+      -1, -5, -2,
+      -4, -3, -9,
+      -7, 0, -6};
+  std::vector<int64_t> x_dims = {1, 2, 3, 3};
+  std::vector<int32_t> m_vals(18, 1);
+
+  std::vector<int64_t> expected_dims = {1, 2, 2, 2};
+  std::vector<float> expected_vals = {5, 9, 7, 9,
+                                      -1, -2, 0, 0};
+
+  test.AddInput<float>("X", x_dims, x_vals);
+  test.AddInput<int32_t>("M", x_dims, m_vals);
+  test.AddOutput<float>("Y", expected_dims, expected_vals);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
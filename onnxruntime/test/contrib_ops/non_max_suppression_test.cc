@@ -239,5 +239,39 @@ TEST(NonMaxSuppressionOpTest, WithScoreThresholdPadToSixOutput) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, BatchedWithMultipleClasses) {
+  OpTester test("NonMaxSuppression", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("boxes", {2, 6, 4},
+                       {0.0f, 0.0f, 1.0f, 1.0f,
+                        0.0f, 0.1f, 1.0f, 1.1f,
+                        0.0f, -0.1f, 1.0f, 0.9f,
+                        0.0f, 10.0f, 1.0f, 11.0f,
+                        0.0f, 10.1f, 1.0f, 11.1f,
+                        0.0f, 100.0f, 1.0f, 101.0f,
+
+                        0.0f, 0.0f, 1.0f, 1.0f,
+                        0.0f, 0.1f, 1.0f, 1.1f,
+                        0.0f, -0.1f, 1.0f, 0.9f,
+                        0.0f, 10.0f, 1.0f, 11.0f,
+                        0.0f, 10.1f, 1.0f, 11.1f,
+                        0.0f, 100.0f, 1.0f, 101.0f});
+  test.AddInput<float>("scores", {2, 2, 6},
+                       {0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.1f, 0.8f, 0.7f, 0.2f, 0.9f, 0.05f,
+
+                        0.1f, 0.8f, 0.7f, 0.2f, 0.9f, 0.05f,
+                        0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f});
+  test.AddAttribute<int64_t>("max_output_size", 3LL);
+  test.AddAttribute<float>("iou_threshold", 0.5f);
+  test.AddAttribute<float>("score_threshold", 0.0f);
+  test.AddOutput<int32_t>("selected_indices", {12, 3},
+                          {0L, 0L, 3L, 0L, 0L, 0L, 0L, 0L, 5L,
+                           0L, 1L, 4L, 0L, 1L, 1L, 0L, 1L, 5L,
+                           1L, 0L, 4L, 1L, 0L, 1L, 1L, 0L, 5L,
+                           1L, 1L, 3L, 1L, 1L, 0L, 1L, 1L, 5L});
+  test.AddOutput<int32_t>("valid_outputs", {1}, {12L});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -4,6 +4,9 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
+#include <cmath>
+#include <random>
+
 namespace onnxruntime {
 namespace test {
 
@@ -188,6 +191,45 @@ TEST(QuantizeLinearOpTest, QuantizeLinear_2) {
   test.Run();
 }
 
+// quantize with scalar zero point and scale with int8
+TEST(QuantizeLinearOpTest, QuantizeLinear_3) {
+  OpTester test("QuantizeLinear", 1, onnxruntime::kMSDomain);
+  std::vector<int64_t> dims{8};
+  test.AddInput<float>("x", dims, {0, 2, 3, -3, 5, 1000, -254, -1000});
+  test.AddInput<float>("y_scale", {}, {2.0f});
+  test.AddInput<int8_t>("y_zero_point", {}, {-10});
+  test.AddOutput<int8_t>("y", dims, {-10, -9, -8, -12, -7, 127, -128, -128});
+  test.Run();
+}
+
+// quantize enough elements per channel that the work is split into chunks
+TEST(QuantizeLinearOpTest, QuantizeLinear_Large) {
+  const int64_t channels = 3;
+  const int64_t channel_size = 20000;
+  const std::vector<float> scale{0.5f, 0.03f, 7.0f};
+  const std::vector<uint8_t> zero_point{0, 128, 255};
+
+  std::vector<float> x(channels * channel_size);
+  std::vector<uint8_t> y(x.size());
+  for (int64_t c = 0; c < channels; c++) {
+    for (int64_t i = 0; i < channel_size; i++) {
+      const int64_t index = c * channel_size + i;
+      x[index] = static_cast<float>((i % 1031) - 515) * 0.25f;
+      float value = std::round(x[index] / scale[c]) + zero_point[c];
+      y[index] = static_cast<uint8_t>(std::min(std::max(value, 0.0f), 255.0f));
+    }
+  }
+
+  OpTester test("QuantizeLinear", 1, onnxruntime::kMSDomain);
+  std::vector<int64_t> dims{channels, channel_size};
+  test.AddInput<float>("x", dims, x);
+  test.AddAttribute<int64_t>("axis", 0);
+  test.AddInput<float>("y_scale", {channels}, scale);
+  test.AddInput<uint8_t>("y_zero_point", {channels}, zero_point);
+  test.AddOutput<uint8_t>("y", dims, y);
+  test.Run();
+}
+
 TEST(ConvIntegerTest, ConvIntegerTest) {
   OpTester test("ConvInteger", 1, onnxruntime::kMSDomain);
   std::vector<int64_t> x_dims{1, 1, 3, 3};
@@ -229,5 +271,155 @@ TEST(ConvIntegerTest_with_padding, ConvIntegerTest) {
   test.Run();
 }
 
+// reference ConvInteger for 2-D NCHW input with symmetric strides/pads
+static std::vector<int32_t> ReferenceConvInteger(const std::vector<uint8_t>& x, const std::vector<int64_t>& x_dims,
+                                                 const std::vector<uint8_t>& w, const std::vector<int64_t>& w_dims,
+                                                 uint8_t x_zero_point, uint8_t w_zero_point, int64_t group,
+                                                 int64_t pad, int64_t stride, std::vector<int64_t>& y_dims) {
+  const int64_t N = x_dims[0], C = x_dims[1], H = x_dims[2], W = x_dims[3];
+  const int64_t M = w_dims[0], KH = w_dims[2], KW = w_dims[3];
+  const int64_t OH = (H + 2 * pad - KH) / stride + 1;
+  const int64_t OW = (W + 2 * pad - KW) / stride + 1;
+  const int64_t group_channels = C / group;
+  const int64_t group_filters = M / group;
+  y_dims = {N, M, OH, OW};
+
+  std::vector<int32_t> y(N * M * OH * OW);
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t m = 0; m < M; m++) {
+      const int64_t g = m / group_filters;
+      for (int64_t oh = 0; oh < OH; oh++) {
+        for (int64_t ow = 0; ow < OW; ow++) {
+          int32_t sum = 0;
+          for (int64_t c = 0; c < group_channels; c++) {
+            for (int64_t kh = 0; kh < KH; kh++) {
+              for (int64_t kw = 0; kw < KW; kw++) {
+                const int64_t ih = oh * stride - pad + kh;
+                const int64_t iw = ow * stride - pad + kw;
+                if (ih < 0 || ih >= H || iw < 0 || iw >= W) continue;
+                const int32_t xv = x[((n * C + g * group_channels + c) * H + ih) * W + iw];
+                const int32_t wv = w[((m * group_channels + c) * KH + kh) * KW + kw];
+                sum += (xv - x_zero_point) * (wv - w_zero_point);
+              }
+            }
+          }
+          y[((n * M + m) * OH + oh) * OW + ow] = sum;
+        }
+      }
+    }
+  }
+  return y;
+}
+
+static void RunConvIntegerRandom(const std::vector<int64_t>& x_dims, const std::vector<int64_t>& w_dims,
+                                 int64_t group, int64_t pad, int64_t stride) {
+  std::mt19937 rng(static_cast<unsigned>(x_dims[1] * 7 + w_dims[2]));
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<uint8_t> x(x_dims[0] * x_dims[1] * x_dims[2] * x_dims[3]);
+  std::vector<uint8_t> w(w_dims[0] * w_dims[1] * w_dims[2] * w_dims[3]);
+  for (auto& v : x) v = static_cast<uint8_t>(dist(rng));
+  for (auto& v : w) v = static_cast<uint8_t>(dist(rng));
+  const uint8_t x_zero_point = 131;
+  const uint8_t w_zero_point = 120;
+
+  std::vector<int64_t> y_dims;
+  auto y = ReferenceConvInteger(x, x_dims, w, w_dims, x_zero_point, w_zero_point, group, pad, stride, y_dims);
+
+  OpTester test("ConvInteger", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("group", group);
+  test.AddAttribute<std::vector<int64_t>>("pads", {pad, pad, pad, pad});
+  test.AddAttribute<std::vector<int64_t>>("strides", {stride, stride});
+  test.AddInput<uint8_t>("x", x_dims, x);
+  test.AddInput<uint8_t>("w", w_dims, w);
+  test.AddInput<uint8_t>("x_zero_point", {}, {x_zero_point});
+  test.AddInput<uint8_t>("w_zero_point", {}, {w_zero_point});
+  test.AddOutput<int32_t>("y", y_dims, y);
+  test.Run();
+}
+
+TEST(ConvIntegerTest, ConvIntegerTest_Grouped) {
+  RunConvIntegerRandom({2, 4, 7, 6}, {6, 2, 3, 3}, 2, 1, 1);
+  RunConvIntegerRandom({1, 6, 9, 9}, {6, 1, 3, 3}, 6, 1, 2);
+}
+
+TEST(ConvIntegerTest, ConvIntegerTest_Pointwise) {
+  RunConvIntegerRandom({2, 16, 5, 7}, {24, 16, 1, 1}, 1, 0, 1);
+  RunConvIntegerRandom({1, 8, 5, 5}, {8, 4, 1, 1}, 2, 0, 1);
+}
+
+TEST(ConvIntegerTest, ConvIntegerTest_LargeChannels) {
+  RunConvIntegerRandom({1, 40, 12, 12}, {33, 40, 3, 3}, 1, 1, 1);
+}
+
+static void RunQLinearConvRandom(const std::vector<int64_t>& x_dims, const std::vector<int64_t>& w_dims,
+                                 int64_t group, bool per_channel, bool has_bias) {
+  std::mt19937 rng(static_cast<unsigned>(x_dims[1] * 13 + w_dims[0]));
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<uint8_t> x(x_dims[0] * x_dims[1] * x_dims[2] * x_dims[3]);
+  std::vector<uint8_t> w(w_dims[0] * w_dims[1] * w_dims[2] * w_dims[3]);
+  for (auto& v : x) v = static_cast<uint8_t>(dist(rng));
+  for (auto& v : w) v = static_cast<uint8_t>(dist(rng));
+  const int64_t M = w_dims[0];
+  const float x_scale = 0.02f;
+  const uint8_t x_zero_point = 125;
+  const uint8_t w_zero_point = 129;
+  const float y_scale = 0.75f;
+  const uint8_t y_zero_point = 110;
+
+  std::vector<float> w_scale(per_channel ? M : 1);
+  for (size_t i = 0; i < w_scale.size(); i++) {
+    w_scale[i] = 0.01f + 0.005f * i;
+  }
+  std::vector<int32_t> bias(M);
+  for (int64_t m = 0; m < M; m++) {
+    bias[m] = static_cast<int32_t>(m * 1000 - 3000);
+  }
+
+  std::vector<int64_t> y_dims;
+  auto y_int32 = ReferenceConvInteger(x, x_dims, w, w_dims, x_zero_point, w_zero_point, group, 1, 1, y_dims);
+  const int64_t output_image_size = y_dims[2] * y_dims[3];
+  std::vector<uint8_t> y(y_int32.size());
+  for (size_t i = 0; i < y.size(); i++) {
+    const int64_t m = (static_cast<int64_t>(i) / output_image_size) % M;
+    const float output_scale = x_scale * w_scale[per_channel ? m : 0] / y_scale;
+    float value = float(y_int32[i] + (has_bias ? bias[m] : 0)) * output_scale;
+    value = std::min(std::max(value, float(0 - y_zero_point)), float(255 - y_zero_point));
+    y[i] = static_cast<uint8_t>(static_cast<int32_t>(std::round(value)) + y_zero_point);
+  }
+
+  OpTester test("QLinearConv", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("group", group);
+  test.AddAttribute<std::vector<int64_t>>("pads", {1, 1, 1, 1});
+  test.AddInput<uint8_t>("x", x_dims, x);
+  test.AddInput<float>("x_scale", {}, {x_scale});
+  test.AddInput<uint8_t>("x_zero_point", {}, {x_zero_point});
+  test.AddInput<uint8_t>("w", w_dims, w);
+  if (per_channel) {
+    test.AddInput<float>("w_scale", {M}, w_scale);
+  } else {
+    test.AddInput<float>("w_scale", {}, w_scale);
+  }
+  test.AddInput<uint8_t>("w_zero_point", {}, {w_zero_point});
+  test.AddInput<float>("y_scale", {}, {y_scale});
+  test.AddInput<uint8_t>("y_zero_point", {}, {y_zero_point});
+  if (has_bias) {
+    test.AddInput<int32_t>("B", {M}, bias);
+  }
+  test.AddOutput<uint8_t>("y", y_dims, y);
+  test.Run();
+}
+
+TEST(QLinearConvTest, QLinearConvTest) {
+  RunQLinearConvRandom({1, 8, 7, 7}, {16, 8, 3, 3}, 1, false, false);
+}
+
+TEST(QLinearConvTest, QLinearConvTest_PerChannelBias) {
+  RunQLinearConvRandom({2, 8, 6, 5}, {12, 8, 3, 3}, 1, true, true);
+}
+
+TEST(QLinearConvTest, QLinearConvTest_Grouped) {
+  RunQLinearConvRandom({1, 6, 9, 9}, {6, 2, 3, 3}, 3, true, true);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -214,5 +214,45 @@ TEST(ContribOpTest, StringNormalizerTest) {
   }
 }
 
+TEST(ContribOpTest, StringNormalizerMixedScriptsTest) {
+  // Long ASCII runs mixed with non-ASCII chars
+  // - casesensitive approach
+  // - no stopwords
+  // - LOWER
+  {
+    OpTester test("StringNormalizer", opset_ver, domain);
+    InitTestAttr(test, "LOWER", true, {}, test_locale);
+    std::vector<int64_t> dims{3};
+    std::vector<std::string> input = {std::string("THE QUICK BROWN FOX @[`{ JUMPS"),
+                                      std::string(u8"ÉCOLE Москва ΑΘΗΝΑ ABCDEFGHIJ"),
+                                      std::string(u8"中文 MIXED Ñandú")};
+    test.AddInput<std::string>("T", dims, input);
+
+    std::vector<std::string> output = {std::string("the quick brown fox @[`{ jumps"),
+                                       std::string(u8"école москва αθηνα abcdefghij"),
+                                       std::string(u8"中文 mixed ñandú")};
+    test.AddOutput<std::string>("Y", dims, output);
+    test.Run(OpTester::ExpectResult::kExpectSuccess);
+  }
+  // - case insensitive approach
+  // - filter out non-ASCII stopwords in any case
+  // - UPPER
+  {
+    OpTester test("StringNormalizer", opset_ver, domain);
+    InitTestAttr(test, "UPPER", false, {u8"москва", u8"école"}, test_locale);
+    std::vector<int64_t> dims{4};
+    std::vector<std::string> input = {std::string(u8"МОСКВА"),
+                                      std::string(u8"Ecole"),
+                                      std::string(u8"ÉCOLE"),
+                                      std::string(u8"straße")};
+    test.AddInput<std::string>("T", dims, input);
+
+    std::vector<std::string> output = {std::string(u8"ECOLE"),
+                                       std::string(u8"STRAßE")};
+    test.AddOutput<std::string>("Y", {2}, output);
+    test.Run(OpTester::ExpectResult::kExpectSuccess);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -704,5 +704,52 @@ TEST(ContribOpTest, TokenizerWithSeparators_MixCharCommonPrefixC) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(ContribOpTest, TokenizerWithSeparators_OverlappingSeparatorsPriorityC) {
+  // Of the overlapping matches the earlier specified separator wins
+  // even if it starts later
+  std::vector<std::string> separators = {
+      u8"ñó",
+      u8"Кñ"};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, false, separators, 1);
+
+  std::vector<int64_t> dims{2};
+  std::vector<std::string> input{u8"Кñó", u8"xКñy"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(2));
+  std::vector<std::string> output{
+      u8"К",
+      padval,
+      u8"x",
+      u8"y"};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
+TEST(ContribOpTest, TokenizerWithSeparators_InvalidUtf8InputC) {
+  std::vector<std::string> separators = {
+      u8"ó"};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, false, separators, 1);
+
+  std::vector<int64_t> dims{2};
+  std::vector<std::string> input{u8"Коñó", "\xc3\x28"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(1));
+  std::vector<std::string> output{
+      u8"Коñ",
+      padval};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Invalid utf8 chars in the input");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
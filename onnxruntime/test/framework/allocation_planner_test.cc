@@ -149,6 +149,8 @@ class PlannerTest : public ::testing::Test {
 
   std::unique_ptr<::onnxruntime::KernelDef> std_kernel_;       // a unary kernel with no-aliasing and no-in-place
   std::unique_ptr<::onnxruntime::KernelDef> in_place_kernel_;  // a unary kernel with in-place
+  std::unique_ptr<::onnxruntime::KernelDef> concat_kernel_;    // the kernel of the ONNX Concat operator
+  std::unique_ptr<::onnxruntime::KernelDef> view_kernel_;      // a unary kernel whose output may be a strided view
 
   std::unordered_map<std::string, onnxruntime::NodeArg*> name_to_arg_;
   std::vector<std::unique_ptr<UnaryNode>> nodes_;
@@ -161,8 +163,10 @@ class PlannerTest : public ::testing::Test {
 
  public:
   PlannerTest() : model_("test"), graph_{model_.MainGraph()}, state_{execution_providers_} {
-    std_kernel_ = KernelDefBuilder().SetName("Transpose").Build();
+    std_kernel_ = KernelDefBuilder().SetName("Floor").Build();
     in_place_kernel_ = KernelDefBuilder().SetName("Clip").MayInplace(0, 0).Build();
+    concat_kernel_ = KernelDefBuilder().SetName("Concat").Build();
+    view_kernel_ = KernelDefBuilder().SetName("Transpose").StridedInput(0).StridedView(0).Build();
     CPUExecutionProviderInfo epi;
     auto execution_provider = std::make_unique<CPUExecutionProvider>(epi);
     execution_providers_.Add("CPUExecutionProvider", std::move(execution_provider));
@@ -193,6 +197,22 @@ class PlannerTest : public ::testing::Test {
     return AddNode(*in_place_kernel_, input, output);
   }
 
+  onnxruntime::Node* AddViewNode(std::string& input, std::string& output) {
+    return AddNode(*view_kernel_, input, output);
+  }
+
+  onnxruntime::Node* AddConcatNode(std::initializer_list<std::string> inputs, std::string& output, int64_t axis) {
+    std::vector<onnxruntime::NodeArg*> input_args;
+    for (auto& input : inputs) input_args.push_back(Arg(input));
+    std::vector<onnxruntime::NodeArg*> output_args{Arg(output)};
+    auto* p_node = &graph_.AddNode("node" + std::to_string(NodeCounter::Next()), "Concat", "test op",
+                                   input_args, output_args);
+    p_node->AddAttribute("axis", axis);
+    p_node->SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+    kernel_bindings_.emplace_back(p_node, *concat_kernel_);
+    return p_node;
+  }
+
   void BindKernel(onnxruntime::Node* p_node, ::onnxruntime::KernelDef& kernel_def) {
     auto info = std::make_unique<OpKernelInfo>(*p_node, kernel_def, *execution_providers_.Get(*p_node), state_);
     auto dummy = std::make_unique<DummyOpKernel>(*info);
@@ -247,6 +267,17 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  void CheckSubBuffer(const std::string& name, const std::string& buffer_name, size_t offset, size_t size) {
+    int id, buffer_id;
+    index(name, id);
+    index(buffer_name, buffer_id);
+    auto& plan = plan_->allocation_plan[id];
+    EXPECT_EQ(plan.alloc_kind, AllocKind::kSubBuffer) << "Error in allocation kind for " << name;
+    EXPECT_EQ(plan.reused_buffer, buffer_id) << "Error in buffer for " << name;
+    EXPECT_EQ(plan.buffer_offset, offset) << "Error in buffer offset for " << name;
+    EXPECT_EQ(plan.sub_buffer_size, size) << "Error in sub-buffer size for " << name;
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // create set and check equality
     std::unordered_set<int> expected;
@@ -409,6 +440,88 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+// ConcatSubBufferTest: Check that the inputs of a Concat are computed directly into the Concat output.
+TEST_F(PlannerTest, ConcatSubBufferTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddNormalNode(X1, X2);           // X1: input; X2: temporary
+  AddNormalNode(X1, X3);           // X3: temporary
+  AddConcatNode({X2, X3}, X4, 1);  // X4: temporary
+  AddNormalNode(X4, X5);           // X5: output
+
+  // simulate shape-inference results:
+  Shape shape1{1, 2, 4}, shape2{1, 3, 4}, shape3{1, 5, 4};
+  SetShape({{X1, &shape1.value}, {X2, &shape1.value}, {X3, &shape2.value}, {X4, &shape3.value}, {X5, &shape3.value}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckSubBuffer(X2, X4, 0, 2 * 4 * sizeof(float));
+  CheckSubBuffer(X3, X4, 2 * 4 * sizeof(float), 3 * 4 * sizeof(float));
+  CheckAllocKind(X4, AllocKind::kAllocate);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+
+  // check each ml-value is freed at appropriate step
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {X2, X3});
+  CheckFreed(3, {X4});
+}
+
+// ConcatSubBufferSymbolicShapeTest: Check that the inputs of a Concat are not planned as sub-buffers
+// when the offsets cannot be determined statically.
+TEST_F(PlannerTest, ConcatSubBufferSymbolicShapeTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4");
+
+  // graph structure:
+  AddNormalNode(X1, X2);           // X1: input; X2: temporary
+  AddNormalNode(X1, X3);           // X3: temporary
+  AddConcatNode({X2, X3}, X4, 0);  // X4: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"}, shape2{"K", "N"};
+  SetShape({{X1, &shape1.value}, {X2, &shape1.value}, {X3, &shape1.value}, {X4, &shape2.value}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kAllocateOutput);
+}
+
+// StridedViewTest: Check that an output is planned as a view of an input only if its consumers accept strided inputs.
+TEST_F(PlannerTest, StridedViewTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4");
+
+  // graph structure:
+  AddViewNode(X1, X2);    // X1: input; X2: temporary consumed by a kernel that accepts strided inputs
+  AddViewNode(X2, X3);    // X3: temporary consumed by a kernel that requires contiguous inputs
+  AddNormalNode(X3, X4);  // X4: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"}, shape2{"N", "M"};
+  SetShape({{X1, &shape1.value}, {X2, &shape2.value}, {X3, &shape1.value}, {X4, &shape1.value}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kView);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kAllocateOutput);
+
+  // check each ml-value is freed at appropriate step
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {X3});
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
@@ -14,10 +14,13 @@
 #include "core/platform/env.h"
 #include "core/common/logging/logging.h"
 #include "core/common/profiler.h"
+#include "core/framework/activation_statistics.h"
 #include "core/framework/execution_provider.h"
+#include "core/framework/initializer_store.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
+#include "core/graph/graph_transformer.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/compute_capability.h"
 #include "core/graph/model.h"
@@ -551,6 +554,571 @@ TEST(InferenceSessionTests, MultipleSessionsNoTimeout) {
   thread2.join();
 }
 
+TEST(InferenceSessionTests, LoadAndInitializeSessions) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.LoadAndInitializeSessions";
+  so.load_thread_pool_size = 2;
+
+  InferenceSession session_object1{so, &DefaultLoggingManager()};
+  InferenceSession session_object2{so, &DefaultLoggingManager()};
+  InferenceSession session_object3{so, &DefaultLoggingManager()};
+  std::vector<InferenceSession*> sessions{&session_object1, &session_object2, &session_object3};
+
+  // a model is needed for each session
+  auto st = InferenceSession::LoadAndInitialize(sessions, {MODEL_URI}, 4);
+  ASSERT_EQ(st.Code(), common::INVALID_ARGUMENT);
+
+  std::vector<common::Status> statuses;
+  st = InferenceSession::LoadAndInitialize(sessions, {MODEL_URI, MODEL_URI, "testdata/does_not_exist.pb"}, 4,
+                                           &statuses);
+  ASSERT_FALSE(st.IsOK());
+  ASSERT_EQ(statuses.size(), 3u);
+  ASSERT_TRUE(statuses[0].IsOK()) << statuses[0].ErrorMessage();
+  ASSERT_TRUE(statuses[1].IsOK()) << statuses[1].ErrorMessage();
+  ASSERT_FALSE(statuses[2].IsOK());
+
+  // initialize the remaining session with the model it already loaded
+  ASSERT_TRUE(session_object3.Load(MODEL_URI).IsOK());
+  st = InferenceSession::LoadAndInitialize({&session_object3}, {});
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+
+  RunOptions run_options;
+  run_options.run_tag = "batch initialized sessions";
+  for (auto* session : sessions) {
+    RunModel(*session, run_options);
+
+    const SessionLoadTimings& timings = session->GetLoadTimings();
+    EXPECT_GT(timings.model_loading, 0);
+    EXPECT_GT(timings.session_initialization, 0);
+    EXPECT_GE(timings.session_initialization,
+              timings.graph_transformation + timings.plan_creation + timings.initializers_loading +
+                  timings.kernel_creation + timings.subgraphs_initialization);
+  }
+}
+
+static bool HasLogMessage(const CapturingSink& sink, const std::string& text) {
+  const auto& msgs = sink.Messages();
+  return std::find_if(msgs.begin(), msgs.end(),
+                      [&text](const std::string& msg) { return msg.find(text) != std::string::npos; }) != msgs.end();
+}
+
+// copy the model to model_uri, so that its optimized model cache doesn't end up next to the test data
+static void CopyModelForOptimizedModelCache(const std::string& model_uri) {
+  std::ifstream model_file(MODEL_URI, std::ios::binary);
+  std::ofstream model_copy(model_uri, std::ios::binary | std::ios::trunc);
+  model_copy << model_file.rdbuf();
+}
+
+// run a session of the model and tell whether it was loaded from the optimized model cache
+static bool RunWithOptimizedModelCache(const SessionOptions& so, const std::string& model_uri,
+                                       std::unique_ptr<GraphTransformer> transformer = nullptr) {
+  // LoggingManager will own the sink, but as long as the logging_manager is around our pointer stays valid.
+  auto capturing_sink = new CapturingSink();
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(capturing_sink), logging::Severity::kVERBOSE, false,
+      LoggingManager::InstanceType::Temporal);
+
+  InferenceSession session_object{so, logging_manager.get()};
+  if (transformer) {
+    EXPECT_TRUE(session_object.RegisterGraphTransformer(std::move(transformer)).IsOK());
+  }
+  EXPECT_TRUE(session_object.Load(model_uri).IsOK());
+  EXPECT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "optimized model cache";
+  RunModel(session_object, run_options);
+
+  return HasLogMessage(*capturing_sink, "Loaded the model from the optimized model cache.");
+}
+
+TEST(InferenceSessionTests, OptimizedModelCache) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.OptimizedModelCache";
+  so.enable_optimized_model_cache = true;
+
+  const std::string model_uri = "mul_1_optimized_model_cache.pb";
+  const std::string cache_uri = model_uri + ".optimized";
+  CopyModelForOptimizedModelCache(model_uri);
+  std::remove(cache_uri.c_str());
+
+  // the first session creates the cache and the next one uses it
+  EXPECT_FALSE(RunWithOptimizedModelCache(so, model_uri));
+  ASSERT_TRUE(std::ifstream(cache_uri).good());
+  EXPECT_TRUE(RunWithOptimizedModelCache(so, model_uri));
+
+  // rewriting the model file with the same content keeps the cache valid
+  CopyModelForOptimizedModelCache(model_uri);
+  EXPECT_TRUE(RunWithOptimizedModelCache(so, model_uri));
+
+  // a corrupt cache is ignored and replaced
+  {
+    std::ofstream cache_file(cache_uri, std::ios::binary | std::ios::trunc);
+    cache_file << "not a model";
+  }
+  EXPECT_FALSE(RunWithOptimizedModelCache(so, model_uri));
+  EXPECT_TRUE(RunWithOptimizedModelCache(so, model_uri));
+
+  std::remove(cache_uri.c_str());
+  std::remove(model_uri.c_str());
+}
+
+TEST(InferenceSessionTests, SharedInitializers) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.SharedInitializers";
+  so.initializer_store = std::make_shared<InitializerStore>();
+
+  RunOptions run_options;
+  run_options.run_tag = "shared initializers";
+
+  {
+    // the first session adds the initializer W of the model to the store
+    InferenceSession session_object1{so, &DefaultLoggingManager()};
+    ASSERT_TRUE(session_object1.Load(MODEL_URI).IsOK());
+    ASSERT_TRUE(session_object1.Initialize().IsOK());
+    ASSERT_EQ(so.initializer_store->Size(), 1u);
+    RunModel(session_object1, run_options);
+  }
+
+  // the next one uses it, after the session that created it is gone
+  InferenceSession session_object2{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object2.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object2.Initialize().IsOK());
+  EXPECT_EQ(so.initializer_store->Size(), 1u);
+  RunModel(session_object2, run_options);
+
+  // sessions enabling share_initializers get a store for the model
+  SessionOptions so_shared;
+  so_shared.session_logid = "InferenceSessionTests.SharedInitializers";
+  so_shared.share_initializers = true;
+
+  InferenceSession session_object3{so_shared, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object3.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object3.Initialize().IsOK());
+  InferenceSession session_object4{so_shared, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object4.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object4.Initialize().IsOK());
+  RunModel(session_object3, run_options);
+  RunModel(session_object4, run_options);
+}
+
+// Sets the initializer W to zeros, keeping its name and shape.
+class ZeroWeightTransformer : public GraphTransformer {
+ public:
+  ZeroWeightTransformer() : GraphTransformer("ZeroWeightTransformer", "Sets W to zeros") {}
+
+  Status Apply(Graph& graph, bool& modified) const override {
+    modified = false;
+    const TensorProto* weight;
+    if (!graph.GetInitializedTensor("W", weight) ||
+        std::all_of(weight->float_data().begin(), weight->float_data().end(), [](float v) { return v == 0.0f; })) {
+      return Status::OK();
+    }
+    TensorProto zeros(*weight);
+    for (auto& v : *zeros.mutable_float_data()) {
+      v = 0.0f;
+    }
+    graph.RemoveInitializedTensor("W");
+    graph.AddInitializedTensor(zeros);
+    modified = true;
+    return Status::OK();
+  }
+};
+
+TEST(InferenceSessionTests, SharedInitializersWithDifferentTransformers) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.SharedInitializersWithDifferentTransformers";
+  so.share_initializers = true;
+
+  // the transformed W must not be used by the session of the original model
+  InferenceSession transformed_session{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(transformed_session.RegisterGraphTransformer(std::make_unique<ZeroWeightTransformer>()).IsOK());
+  ASSERT_TRUE(transformed_session.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(transformed_session.Initialize().IsOK());
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+}
+
+TEST(InferenceSessionTests, OptimizedModelCacheWithDifferentTransformers) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.OptimizedModelCacheWithDifferentTransformers";
+  so.enable_optimized_model_cache = true;
+
+  const std::string model_uri = "mul_1_optimized_model_cache_transformers.pb";
+  const std::string cache_uri = model_uri + ".optimized";
+  CopyModelForOptimizedModelCache(model_uri);
+  std::remove(cache_uri.c_str());
+
+  // the model cached with W set to zeros must not be used by the sessions without the transformer, which check the
+  // output computed with the original W
+  EXPECT_FALSE(RunWithOptimizedModelCache(so, model_uri, std::make_unique<ZeroWeightTransformer>()));
+  ASSERT_TRUE(std::ifstream(cache_uri).good());
+  EXPECT_FALSE(RunWithOptimizedModelCache(so, model_uri));
+  EXPECT_TRUE(RunWithOptimizedModelCache(so, model_uri));
+
+  std::remove(cache_uri.c_str());
+  std::remove(model_uri.c_str());
+}
+
+// Y = Concat(Neg(X), Relu(X)) on axis 1, with X of shape {1, 2}, so that the inputs of the Concat are planned to be
+// computed in the Concat output.
+static void CreateConcatSubBufferModel(std::unique_ptr<onnxruntime::Model>& p_model) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  p_model = std::make_unique<onnxruntime::Model>("test", true, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  onnxruntime::Graph& graph = p_model->MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto tensor_float_1x2(tensor_float);
+  tensor_float_1x2.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  tensor_float_1x2.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &tensor_float_1x2);
+  auto& neg_arg = graph.GetOrCreateNodeArg("A", &tensor_float);
+  auto& relu_arg = graph.GetOrCreateNodeArg("B", &tensor_float);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &tensor_float);
+
+  graph.AddNode("neg", "Neg", "Neg", {&input_arg}, {&neg_arg});
+  graph.AddNode("relu", "Relu", "Relu", {&input_arg}, {&relu_arg});
+  auto& concat = graph.AddNode("concat", "Concat", "Concat", {&neg_arg, &relu_arg}, {&output_arg});
+  concat.AddAttribute("axis", int64_t{1});
+
+  Status status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+}
+
+TEST(InferenceSessionTests, ConcatSubBuffers) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ConcatSubBuffers";
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  std::unique_ptr<Model> p_model;
+  CreateConcatSubBufferModel(p_model);
+
+  std::stringstream s1;
+  p_model->ToProto().SerializeToOstream(&s1);
+  ASSERT_TRUE(session_object.Load(s1).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  auto run = [&session_object](const std::vector<int64_t>& dims, const std::vector<float>& x,
+                               const std::vector<int64_t>& expected_dims, const std::vector<float>& expected_y) {
+    MLValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims, x, &ml_value);
+    NameMLValMap feeds;
+    feeds.insert(std::make_pair("X", ml_value));
+    std::vector<MLValue> fetches;
+
+    RunOptions run_options;
+    common::Status st = session_object.Run(run_options, feeds, {"Y"}, &fetches);
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+    VerifyOutputs(fetches, expected_dims, expected_y);
+  };
+
+  // the shape of the model, twice to also run with the memory pattern
+  run({1, 2}, {1.0f, -2.0f}, {1, 4}, {-1.0f, 2.0f, 1.0f, 0.0f});
+  run({1, 2}, {3.0f, -4.0f}, {1, 4}, {-3.0f, 4.0f, 3.0f, 0.0f});
+
+  // the input shape is not validated, so the slices don't have their planned sizes and the frame falls back to
+  // buffers of their own, and to a new Concat output
+  run({1, 3}, {1.0f, -2.0f, 3.0f}, {1, 6}, {-1.0f, 2.0f, -3.0f, 1.0f, 0.0f, 3.0f});
+  run({1, 1}, {-5.0f}, {1, 2}, {5.0f, 0.0f});
+}
+
+// Gives the tests access to the plan that the session made for the model.
+class InferenceSessionGetSessionStateWrapper : public InferenceSession {
+ public:
+  explicit InferenceSessionGetSessionStateWrapper(const SessionOptions& session_options,
+                                                  logging::LoggingManager* logging_manager)
+      : InferenceSession(session_options, logging_manager) {}
+
+  using InferenceSession::GetSessionState;
+};
+
+static AllocKind GetPlannedAllocKind(const InferenceSessionGetSessionStateWrapper& session_object,
+                                     const std::string& name) {
+  const SessionState& session_state = session_object.GetSessionState();
+  int index;
+  auto status = session_state.GetMLValueNameIdxMap().GetIdx(name, index);
+  ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+  return session_state.GetExecutionPlan()->allocation_plan[index].alloc_kind;
+}
+
+// Records the first element and whether each value of the main graph is a strided view.
+class ViewObserver : public IActivationObserver {
+ public:
+  void Observe(const Node*, const std::string& name, const MLValue& value) override {
+    const auto& tensor = value.Get<Tensor>();
+    data[name] = tensor.DataRaw();
+    contiguous[name] = tensor.IsContiguous();
+  }
+
+  std::unordered_map<std::string, const void*> data;
+  std::unordered_map<std::string, bool> contiguous;
+};
+
+static void RunViewModel(InferenceSession& session_object, AllocatorPtr allocator, const std::vector<int64_t>& dims,
+                         const std::vector<float>& x, const std::vector<int64_t>& expected_dims,
+                         const std::vector<float>& expected_y) {
+  MLValue ml_value;
+  CreateMLValue<float>(allocator, dims, x, &ml_value);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value));
+  std::vector<MLValue> fetches;
+
+  RunOptions run_options;
+  common::Status st = session_object.Run(run_options, feeds, {"Y"}, &fetches);
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+  VerifyOutputs(fetches, expected_dims, expected_y);
+}
+
+// Y = Relu(Slice(Transpose(X))), with X of shape {2, 3}, so that the Transpose output is planned to be a view of X
+// that the Slice reads in place.
+static void CreateTransposeSliceReluModel(std::unique_ptr<onnxruntime::Model>& p_model) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  p_model = std::make_unique<onnxruntime::Model>("test", true, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  onnxruntime::Graph& graph = p_model->MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto tensor_float_2x3(tensor_float);
+  tensor_float_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  tensor_float_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &tensor_float_2x3);
+  auto& transpose_arg = graph.GetOrCreateNodeArg("T", &tensor_float);
+  auto& slice_arg = graph.GetOrCreateNodeArg("S", &tensor_float);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &tensor_float);
+
+  graph.AddNode("transpose", "Transpose", "Transpose", {&input_arg}, {&transpose_arg});
+  auto& slice = graph.AddNode("slice", "Slice", "Slice", {&transpose_arg}, {&slice_arg});
+  slice.AddAttribute("starts", std::vector<int64_t>{1, 0});
+  slice.AddAttribute("ends", std::vector<int64_t>{3, 1});
+  graph.AddNode("relu", "Relu", "Relu", {&slice_arg}, {&output_arg});
+
+  Status status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+}
+
+TEST(InferenceSessionTests, TransposeSliceReluViews) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TransposeSliceReluViews";
+
+  InferenceSessionGetSessionStateWrapper session_object{so, &DefaultLoggingManager()};
+  std::unique_ptr<Model> p_model;
+  CreateTransposeSliceReluModel(p_model);
+
+  std::stringstream s1;
+  p_model->ToProto().SerializeToOstream(&s1);
+  ASSERT_TRUE(session_object.Load(s1).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  // the Slice accepts a strided input, the Relu doesn't
+  EXPECT_EQ(GetPlannedAllocKind(session_object, "T"), AllocKind::kView);
+  EXPECT_NE(GetPlannedAllocKind(session_object, "S"), AllocKind::kView);
+
+  auto observer = std::make_shared<ViewObserver>();
+  session_object.SetActivationObserver(observer);
+
+  // twice to also run with the memory pattern
+  AllocatorPtr arena = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  for (int i = 0; i < 2; i++) {
+    RunViewModel(session_object, arena, {2, 3}, {1.0f, -2.0f, 3.0f, -4.0f, 5.0f, -6.0f}, {2, 1}, {0.0f, 3.0f});
+    EXPECT_EQ(observer->data["T"], observer->data["X"]);
+    EXPECT_FALSE(observer->contiguous["T"]);
+    EXPECT_TRUE(observer->contiguous["S"]);
+  }
+
+  // X is not in the planned location, so the Transpose output falls back to a buffer of its own
+  AllocatorPtr device_allocator = std::make_shared<CPUAllocator>();
+  for (int i = 0; i < 2; i++) {
+    RunViewModel(session_object, device_allocator, {2, 3}, {1.0f, -2.0f, 3.0f, -4.0f, 5.0f, -6.0f}, {2, 1},
+                 {0.0f, 3.0f});
+    EXPECT_NE(observer->data["T"], observer->data["X"]);
+    EXPECT_TRUE(observer->contiguous["T"]);
+    EXPECT_TRUE(observer->contiguous["S"]);
+  }
+
+  session_object.SetActivationObserver(nullptr);
+}
+
+// Y = Transpose(A) + B with A, B = Split(X) on axis 1 and X of shape {2, 4}, so that A is planned to be a view of X
+// that the Transpose reads in place, and B, which the Add needs to be contiguous, is planned to be a buffer of its own.
+static void CreateSplitAddModel(std::unique_ptr<onnxruntime::Model>& p_model) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  p_model = std::make_unique<onnxruntime::Model>("test", true, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  onnxruntime::Graph& graph = p_model->MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto tensor_float_2x4(tensor_float);
+  tensor_float_2x4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  tensor_float_2x4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &tensor_float_2x4);
+  auto& split_arg_a = graph.GetOrCreateNodeArg("A", &tensor_float);
+  auto& split_arg_b = graph.GetOrCreateNodeArg("B", &tensor_float);
+  auto& transpose_arg = graph.GetOrCreateNodeArg("TA", &tensor_float);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &tensor_float);
+
+  auto& split = graph.AddNode("split", "Split", "Split", {&input_arg}, {&split_arg_a, &split_arg_b});
+  split.AddAttribute("axis", int64_t{1});
+  graph.AddNode("transpose", "Transpose", "Transpose", {&split_arg_a}, {&transpose_arg});
+  graph.AddNode("add", "Add", "Add", {&transpose_arg, &split_arg_b}, {&output_arg});
+
+  Status status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+}
+
+TEST(InferenceSessionTests, SplitAddViews) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.SplitAddViews";
+
+  InferenceSessionGetSessionStateWrapper session_object{so, &DefaultLoggingManager()};
+  std::unique_ptr<Model> p_model;
+  CreateSplitAddModel(p_model);
+
+  std::stringstream s1;
+  p_model->ToProto().SerializeToOstream(&s1);
+  ASSERT_TRUE(session_object.Load(s1).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  EXPECT_EQ(GetPlannedAllocKind(session_object, "A"), AllocKind::kView);
+  EXPECT_NE(GetPlannedAllocKind(session_object, "B"), AllocKind::kView);
+  EXPECT_NE(GetPlannedAllocKind(session_object, "TA"), AllocKind::kView);
+
+  auto observer = std::make_shared<ViewObserver>();
+  session_object.SetActivationObserver(observer);
+
+  AllocatorPtr arena = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  for (int i = 0; i < 2; i++) {
+    RunViewModel(session_object, arena, {2, 4}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f}, {2, 2},
+                 {4.0f, 9.0f, 9.0f, 14.0f});
+    EXPECT_EQ(observer->data["A"], observer->data["X"]);
+    EXPECT_FALSE(observer->contiguous["A"]);
+    EXPECT_NE(observer->data["B"], static_cast<const float*>(observer->data["X"]) + 2);
+    EXPECT_TRUE(observer->contiguous["B"]);
+    EXPECT_TRUE(observer->contiguous["TA"]);
+  }
+
+  // X is not in the planned location, so A falls back to a buffer of its own
+  AllocatorPtr device_allocator = std::make_shared<CPUAllocator>();
+  for (int i = 0; i < 2; i++) {
+    RunViewModel(session_object, device_allocator, {2, 4}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f}, {2, 2},
+                 {4.0f, 9.0f, 9.0f, 14.0f});
+    EXPECT_NE(observer->data["A"], observer->data["X"]);
+    EXPECT_TRUE(observer->contiguous["A"]);
+    EXPECT_TRUE(observer->contiguous["B"]);
+  }
+
+  session_object.SetActivationObserver(nullptr);
+}
+
+// YX = CategoryMapper(X), YS = CategoryMapper(S) and SI = Identity(S), so that X, which only the CategoryMapper reads,
+// can be fed in the compact string layout, and S, which the Identity also reads, has to be expanded.
+static void CreateCompactStringModel(std::unique_ptr<onnxruntime::Model>& p_model) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  domain_to_version[onnxruntime::kMLDomain] = 1;
+  p_model = std::make_unique<onnxruntime::Model>("test", true, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  onnxruntime::Graph& graph = p_model->MainGraph();
+
+  TypeProto tensor_string;
+  tensor_string.mutable_tensor_type()->set_elem_type(TensorProto_DataType_STRING);
+  TypeProto tensor_int64;
+  tensor_int64.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+
+  auto& x_arg = graph.GetOrCreateNodeArg("X", &tensor_string);
+  auto& s_arg = graph.GetOrCreateNodeArg("S", &tensor_string);
+  auto& yx_arg = graph.GetOrCreateNodeArg("YX", &tensor_int64);
+  auto& ys_arg = graph.GetOrCreateNodeArg("YS", &tensor_int64);
+  auto& si_arg = graph.GetOrCreateNodeArg("SI", &tensor_string);
+
+  auto add_category_mapper = [&graph](const std::string& name, NodeArg& input_arg, NodeArg& output_arg) {
+    auto& node = graph.AddNode(name, "CategoryMapper", "CategoryMapper", {&input_arg}, {&output_arg}, nullptr,
+                               onnxruntime::kMLDomain);
+    node.AddAttribute("cats_strings", std::vector<std::string>{"hello", "world"});
+    node.AddAttribute("cats_int64s", std::vector<int64_t>{1, 2});
+    node.AddAttribute("default_int64", int64_t{-1});
+    node.AddAttribute("default_string", std::string("_Unused"));
+  };
+  add_category_mapper("category_mapper_x", x_arg, yx_arg);
+  add_category_mapper("category_mapper_s", s_arg, ys_arg);
+  graph.AddNode("identity", "Identity", "Identity", {&s_arg}, {&si_arg});
+
+  Status status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+}
+
+// Records whether each value of the main graph is in the compact string layout.
+class CompactStringObserver : public IActivationObserver {
+ public:
+  void Observe(const Node*, const std::string& name, const MLValue& value) override {
+    compact[name] = value.Get<Tensor>().IsCompactString();
+  }
+
+  std::unordered_map<std::string, bool> compact;
+};
+
+TEST(InferenceSessionTests, CompactStringFeeds) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.CompactStringFeeds";
+
+  InferenceSessionGetSessionStateWrapper session_object{so, &DefaultLoggingManager()};
+  std::unique_ptr<Model> p_model;
+  CreateCompactStringModel(p_model);
+
+  std::stringstream s1;
+  p_model->ToProto().SerializeToOstream(&s1);
+  ASSERT_TRUE(session_object.Load(s1).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  EXPECT_TRUE(session_object.GetSessionState().AcceptsCompactStringInput("X"));
+  EXPECT_FALSE(session_object.GetSessionState().AcceptsCompactStringInput("S"));
+
+  auto observer = std::make_shared<CompactStringObserver>();
+  session_object.SetActivationObserver(observer);
+
+  const std::string chars("helloworldfoo");
+  const std::vector<size_t> offsets{0, 5, 10, 10};
+  AllocatorPtr arena = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  auto create_feed = [&]() {
+    MLValue ml_value;
+    ml_value.Init(new Tensor(TensorShape(std::vector<int64_t>{4}), chars.data(), chars.size(), offsets.data(), arena->Info()),
+                  DataTypeImpl::GetType<Tensor>(),
+                  DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    return ml_value;
+  };
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", create_feed()));
+  feeds.insert(std::make_pair("S", create_feed()));
+
+  RunOptions run_options;
+  std::vector<MLValue> fetches;
+  common::Status st = session_object.Run(run_options, feeds, {"YX", "YS", "SI"}, &fetches);
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+
+  EXPECT_TRUE(observer->compact["X"]);
+  EXPECT_FALSE(observer->compact["S"]);
+
+  const std::vector<int64_t> expected_y{1, 2, -1, -1};
+  for (size_t i = 0; i < 2; ++i) {
+    auto y = fetches[i].Get<Tensor>().DataAsSpan<int64_t>();
+    EXPECT_EQ(std::vector<int64_t>(y.cbegin(), y.cend()), expected_y);
+  }
+  auto si = fetches[2].Get<Tensor>().DataAsSpan<std::string>();
+  EXPECT_EQ(std::vector<std::string>(si.cbegin(), si.cend()), (std::vector<std::string>{"hello", "world", "", "foo"}));
+
+  session_object.SetActivationObserver(nullptr);
+}
+
 TEST(InferenceSessionTests, PreAllocateOutputVector) {
   SessionOptions so;
 
@@ -566,6 +1134,43 @@ TEST(InferenceSessionTests, PreAllocateOutputVector) {
   RunModel(session_object, run_options, is_preallocate_output_vec);
 }
 
+TEST(InferenceSessionTests, CollectActivationStatistics) {
+  for (bool sequential : {true, false}) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.CollectActivationStatistics";
+    so.enable_sequential_execution = sequential;
+
+    InferenceSession session_object{so, &DefaultLoggingManager()};
+    ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+    ASSERT_TRUE(session_object.Initialize().IsOK());
+
+    auto statistics = std::make_shared<ActivationStatistics>(4);
+    session_object.SetActivationObserver(statistics);
+
+    RunOptions run_options;
+    RunModel(session_object, run_options);
+    RunModel(session_object, run_options);
+
+    // X is {1, ..., 6} and Y = X * X
+    auto entries = statistics->Get();
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries["X"].min, 1.0f);
+    EXPECT_EQ(entries["X"].max, 6.0f);
+    EXPECT_EQ(entries["X"].histogram_range, 6.0f);
+    EXPECT_EQ(entries["X"].histogram, std::vector<int64_t>({2, 2, 4, 4}));
+    EXPECT_EQ(entries["Y"].min, 1.0f);
+    EXPECT_EQ(entries["Y"].max, 36.0f);
+    EXPECT_EQ(entries["Y"].histogram_range, 36.0f);
+    EXPECT_EQ(entries["Y"].histogram, std::vector<int64_t>({4, 4, 2, 2}));
+
+    // runs after the observer is removed are not observed
+    session_object.SetActivationObserver(nullptr);
+    statistics->Clear();
+    RunModel(session_object, run_options);
+    EXPECT_TRUE(statistics->Get().empty());
+  }
+}
+
 TEST(InferenceSessionTests, ConfigureVerbosityLevel) {
   SessionOptions so;
 
@@ -1114,19 +1719,8 @@ TEST(ExecutionProviderTest, FunctionInlineTest) {
   VerifyOutputs(fetches, expected_dims_mul_m, expected_values_mul_m);
 }
 
-TEST(InferenceSessionTests, TestTruncatedSequence) {
-  // model/data generated by <repo>/onnxruntime/test/testdata/CNTK/gen.py GenScan()
-  static const std::string LSTM_MODEL_URI = "testdata/scan_1.pb";
-  // This model is a 4x forward LSTM. Parse it to find out mapping between init_state input/output
-  ONNX_NAMESPACE::ModelProto model_proto;
-  int model_fd;
-  auto status = Env::Default().FileOpenRd(LSTM_MODEL_URI, model_fd);
-  ASSERT_TRUE(status.IsOK());
-  google::protobuf::io::FileInputStream f(model_fd);
-  f.SetCloseOnDelete(true);
-  ASSERT_TRUE(model_proto.ParseFromZeroCopyStream(&f));
-  GraphProto& graph_proto = *model_proto.mutable_graph();
-
+// maps the state outputs of the forward Scan nodes in graph_proto to the inputs with their initial values
+static void GetScanStateMap(const GraphProto& graph_proto, std::unordered_map<std::string, std::string>& init_state_map) {
   auto find_attr = [&](const NodeProto& node, const std::string& attr_name) -> const AttributeProto* {
     for (int i = 0; i < node.attribute_size(); ++i) {
       auto& attr = node.attribute(i);
@@ -1136,9 +1730,8 @@ TEST(InferenceSessionTests, TestTruncatedSequence) {
     return nullptr;
   };
 
-  std::unordered_map<std::string, std::string> init_state_map;
   for (int i_node = 0; i_node < graph_proto.node_size(); ++i_node) {
-    auto& node = *graph_proto.mutable_node(i_node);
+    auto& node = graph_proto.node(i_node);
     if (node.op_type() == "Scan") {
       // only works in forward, and do not allow bidirection
       auto attr_directions = find_attr(node, "scan_input_directions");
@@ -1161,6 +1754,23 @@ TEST(InferenceSessionTests, TestTruncatedSequence) {
       }
     }
   }
+}
+
+TEST(InferenceSessionTests, TestTruncatedSequence) {
+  // model/data generated by <repo>/onnxruntime/test/testdata/CNTK/gen.py GenScan()
+  static const std::string LSTM_MODEL_URI = "testdata/scan_1.pb";
+  // This model is a 4x forward LSTM. Parse it to find out mapping between init_state input/output
+  ONNX_NAMESPACE::ModelProto model_proto;
+  int model_fd;
+  auto status = Env::Default().FileOpenRd(LSTM_MODEL_URI, model_fd);
+  ASSERT_TRUE(status.IsOK());
+  google::protobuf::io::FileInputStream f(model_fd);
+  f.SetCloseOnDelete(true);
+  ASSERT_TRUE(model_proto.ParseFromZeroCopyStream(&f));
+  GraphProto& graph_proto = *model_proto.mutable_graph();
+
+  std::unordered_map<std::string, std::string> init_state_map;
+  GetScanStateMap(graph_proto, init_state_map);
 
   // now run the truncated model
   SessionOptions so;
@@ -1267,5 +1877,88 @@ TEST(InferenceSessionTests, TestTruncatedSequence) {
   }
 }
 
+TEST(InferenceSessionTests, TestStreamingSequence) {
+  // same model and data as TestTruncatedSequence with the LSTM state kept by the session
+  static const std::string LSTM_MODEL_URI = "testdata/scan_1.pb";
+  ONNX_NAMESPACE::ModelProto model_proto;
+  int model_fd;
+  auto status = Env::Default().FileOpenRd(LSTM_MODEL_URI, model_fd);
+  ASSERT_TRUE(status.IsOK());
+  google::protobuf::io::FileInputStream f(model_fd);
+  f.SetCloseOnDelete(true);
+  ASSERT_TRUE(model_proto.ParseFromZeroCopyStream(&f));
+  const GraphProto& graph_proto = model_proto.graph();
+
+  std::unordered_map<std::string, std::string> init_state_map;
+  GetScanStateMap(graph_proto, init_state_map);
+  ASSERT_FALSE(init_state_map.empty());
+
+  std::string final_output_name;
+  for (int i = 0; i < graph_proto.output_size(); ++i) {
+    if (init_state_map.find(graph_proto.output(i).name()) == init_state_map.end()) {
+      final_output_name = graph_proto.output(i).name();
+    }
+  }
+
+  SessionOptions so;
+  so.state_tensors.assign(init_state_map.cbegin(), init_state_map.cend());
+  InferenceSession session_object(so);
+  ASSERT_TRUE(session_object.Load(LSTM_MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  ASSERT_TRUE(session_object.CreateStream("a").IsOK());
+  ASSERT_TRUE(session_object.CreateStream("b").IsOK());
+  ASSERT_FALSE(session_object.CreateStream("a").IsOK());
+
+  RunOptions run_options;
+  std::vector<int64_t> X_dims = {5, 1, 3};
+  std::vector<float> X = {0.5488135f, 0.71518934f, 0.60276335f,
+                          0.5448832f, 0.4236548f, 0.6458941f,
+                          0.4375872f, 0.891773f, 0.96366274f,
+                          0.3834415f, 0.79172504f, 0.5288949f,
+                          0.56804454f, 0.92559665f, 0.07103606f};
+  std::vector<float> Y_data = {-1.1730184e-04f, -3.1204990e-04f,
+                               -2.9978977e-04f, -1.0602647e-03f,
+                               -3.8115133e-04f, -2.0684483e-03f,
+                               -2.5120965e-04f, -2.9920202e-03f,
+                               3.0980256e-05f, -3.5933927e-03f};
+  const int64_t seq_stride = 3;
+  const int64_t seq_output_stride = 2;
+
+  auto run_chunk = [&](const std::string& stream_id, int seq_start, int len) {
+    std::vector<int64_t> dims = X_dims;
+    dims[0] = len;
+    std::vector<float> chunk(X.begin() + seq_start * seq_stride, X.begin() + (seq_start + len) * seq_stride);
+    MLValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims, chunk, &ml_value);
+    NameMLValMap feeds = {{"Input13165", ml_value}};
+    std::vector<MLValue> fetches;
+    auto st = session_object.Run(run_options, stream_id, feeds, {final_output_name}, &fetches);
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+    ASSERT_EQ(1, fetches.size());
+    auto& rtensor = fetches.front().Get<Tensor>();
+    ASSERT_EQ(len * seq_output_stride, rtensor.Shape().Size());
+    for (int64_t i = 0; i < len * seq_output_stride; ++i)
+      EXPECT_NEAR(Y_data[i + seq_start * seq_output_stride], rtensor.template Data<float>()[i], FLT_EPSILON);
+  };
+
+  // interleaved streams don't see each other's state
+  run_chunk("a", 0, 2);
+  run_chunk("b", 0, 1);
+  run_chunk("a", 2, 2);
+  run_chunk("b", 1, 3);
+  run_chunk("a", 4, 1);
+  run_chunk("b", 4, 1);
+
+  // starts over after a reset
+  ASSERT_TRUE(session_object.ResetStream("a").IsOK());
+  run_chunk("a", 0, 5);
+
+  ASSERT_TRUE(session_object.DropStream("b").IsOK());
+  std::vector<MLValue> fetches;
+  ASSERT_FALSE(session_object.Run(run_options, "b", {}, {final_output_name}, &fetches).IsOK());
+  ASSERT_FALSE(session_object.ResetStream("b").IsOK());
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -117,5 +117,42 @@ TEST(TransformerTest, InsertCastAllCPUTest) {
     EXPECT_EQ((*it).OpType(), "Cast");
   }
 }
+// A Cast to float16 in the model rounds its input, so it must not be merged with the Cast back to float that is
+// inserted for the following cpu node.
+TEST(TransformerTest, InsertCastKeepsModelNarrowingCastTest) {
+  auto model = std::make_shared<onnxruntime::Model>("test");
+  onnxruntime::Graph& graph = model->MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto tensor_float_16;
+  tensor_float_16.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT16);
+  onnxruntime::NodeArg i1_def("I1", &tensor_float),
+      o1_def("O1", &tensor_float_16),
+      o2_def("O2", &tensor_float_16);
+
+  auto& node1 = graph.AddNode("node1", "Cast", "model cast", ArgMap{&i1_def}, ArgMap{&o1_def});
+  node1.AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT16));
+  node1.SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+  auto& node2 = graph.AddNode("node2", "Clip", "cpu operator1", ArgMap{&o1_def}, ArgMap{&o2_def});
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  auto cpu_execution_provider = TestCPUExecutionProvider();
+  InsertCastTransformer transformer("Test");
+  transformer.AddKernelRegistry(*cpu_execution_provider->GetKernelRegistry().get());
+
+  bool modified = false;
+  EXPECT_TRUE(transformer.Apply(graph, modified).IsOK());
+  status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_EQ(graph.NumberOfNodes(), 4);
+  EXPECT_TRUE(graph.GetNode(node1.Index()) != nullptr);
+  for (auto it = node2.InputNodesBegin(); it != node2.InputNodesEnd(); ++it) {
+    EXPECT_EQ((*it).OpType(), "Cast");
+    EXPECT_NE((*it).Index(), node1.Index());
+  }
+}
 }  // namespace test
 }  // namespace onnxruntime
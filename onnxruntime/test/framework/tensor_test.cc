@@ -140,6 +140,31 @@ TEST(TensorTest, EmptyTensorTest) {
   EXPECT_EQ(location.type, OrtAllocatorType::OrtArenaAllocator);
 }
 
+TEST(TensorTest, StridedTensorTest) {
+  float data[12] = {};
+  Tensor t(DataTypeImpl::GetType<float>(), TensorShape({3, 4}), data,
+           TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault)->Info());
+  EXPECT_TRUE(t.IsContiguous());
+  EXPECT_THAT(t.Strides(), testing::ElementsAre(4, 1));
+
+  // the transpose of a {4, 3} tensor
+  t.SetStrides({1, 3});
+  EXPECT_FALSE(t.IsContiguous());
+  EXPECT_THAT(t.Strides(), testing::ElementsAre(1, 3));
+
+  // strides that match the dense layout, ignoring axes with a single index, leave the tensor contiguous
+  Tensor t2(DataTypeImpl::GetType<float>(), TensorShape({1, 4}), data,
+            TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault)->Info());
+  t2.SetStrides({12, 1});
+  EXPECT_TRUE(t2.IsContiguous());
+  EXPECT_THAT(t2.Strides(), testing::ElementsAre(4, 1));
+
+  // copies keep the strides
+  Tensor t3 = t;
+  EXPECT_FALSE(t3.IsContiguous());
+  EXPECT_THAT(t3.Strides(), testing::ElementsAre(1, 3));
+}
+
 TEST(TensorTest, TensorCopyAssignOpTest) {
   TensorShape shape({1, 2, 3});
   auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
@@ -198,6 +223,41 @@ TEST(TensorTest, StringTensorTest) {
 #endif
 }
 
+TEST(TensorTest, CompactStringTensorTest) {
+  const std::string chars("helloworld!");
+  const size_t offsets[] = {0, 5, 10, 10};
+  TensorShape shape({2, 2});
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  Tensor t(shape, chars.data(), chars.size(), offsets, alloc->Info());
+
+  EXPECT_EQ(t.DataType(), DataTypeImpl::GetType<std::string>());
+  EXPECT_TRUE(t.IsCompactString());
+  const std::string expected[] = {"hello", "world", "", "!"};
+  for (int64_t i = 0; i < shape.Size(); ++i) {
+    auto element = t.StringElement(i);
+    EXPECT_EQ(std::string(element.data(), element.size()), expected[i]);
+  }
+  EXPECT_EQ(t.CompactStringChars().data(), chars.data());
+  EXPECT_EQ(t.CompactStringOffsets().size(), 4);
+
+  // the elements are not std::string
+  EXPECT_THROW(t.Data<std::string>(), OnnxRuntimeException);
+
+  // a shallow copy shares the layout
+  Tensor t2(t);
+  EXPECT_TRUE(t2.IsCompactString());
+  EXPECT_EQ(t2.StringElement(1).data(), chars.data() + 5);
+
+  // StringElement reads std::string elements too
+  auto buffer = alloc->Alloc(sizeof(std::string) * shape.Size());
+  Tensor t3(DataTypeImpl::GetType<std::string>(), shape, buffer, alloc->Info(), alloc);
+  EXPECT_FALSE(t3.IsCompactString());
+  t3.MutableData<std::string>()[2] = "abc";
+  auto element = t3.StringElement(2);
+  EXPECT_EQ(std::string(element.data(), element.size()), "abc");
+  EXPECT_THROW(t3.CompactStringChars(), OnnxRuntimeException);
+}
+
 TEST(TensorTest, ConvertToString) {
   TensorShape shape({2, 3, 4});
 
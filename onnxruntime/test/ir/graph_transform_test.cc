@@ -11,9 +11,11 @@
 #include "core/graph/conv_mul_fusion.h"
 #include "core/graph/conv_add_fusion.h"
 #include "core/graph/conv_activation_fusion.h"
+#include "core/graph/qdq_fusion.h"
 #include "core/platform/env.h"
 
 #include "test/capturing_sink.h"
+#include "test/framework/test_utils.h"
 #include "test/test_environment.h"
 #include "gtest/gtest.h"
 
@@ -27,6 +29,99 @@ namespace test {
 
 static const std::string MODEL_FOLDER = "testdata/transform/";
 
+namespace {
+NodeArg& AddScalarInitializer(Graph& graph, const std::string& name, TensorProto_DataType elem_type, float value) {
+  TensorProto tensor;
+  tensor.set_name(name);
+  tensor.set_data_type(elem_type);
+  if (elem_type == TensorProto_DataType_FLOAT) {
+    tensor.add_float_data(value);
+  } else {
+    tensor.add_int32_data(static_cast<int32_t>(value));
+  }
+  graph.AddInitializedTensor(tensor);
+
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(elem_type);
+  type.mutable_tensor_type()->mutable_shape();
+  return graph.GetOrCreateNodeArg(name, &type);
+}
+
+// y = QuantizeLinear(MatMul(DequantizeLinear(a), DequantizeLinear(b)))
+void BuildQDQMatMulGraph(Graph& graph) {
+  TypeProto a_type;
+  a_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_UINT8);
+  a_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  a_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  auto& a = graph.GetOrCreateNodeArg("a", &a_type);
+
+  TensorProto b_tensor;
+  b_tensor.set_name("b");
+  b_tensor.set_data_type(TensorProto_DataType_UINT8);
+  b_tensor.add_dims(4);
+  b_tensor.add_dims(3);
+  for (int32_t value : {152, 51, 244, 60, 26, 255, 0, 127, 246, 127, 254, 247}) {
+    b_tensor.add_int32_data(value);
+  }
+  graph.AddInitializedTensor(b_tensor);
+  TypeProto b_type;
+  b_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_UINT8);
+  b_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  b_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  auto& b = graph.GetOrCreateNodeArg("b", &b_type);
+
+  auto& a_scale = AddScalarInitializer(graph, "a_scale", TensorProto_DataType_FLOAT, 0.0066f);
+  auto& a_zero_point = AddScalarInitializer(graph, "a_zero_point", TensorProto_DataType_UINT8, 113);
+  auto& b_scale = AddScalarInitializer(graph, "b_scale", TensorProto_DataType_FLOAT, 0.00705f);
+  auto& b_zero_point = AddScalarInitializer(graph, "b_zero_point", TensorProto_DataType_UINT8, 114);
+  auto& y_scale = AddScalarInitializer(graph, "y_scale", TensorProto_DataType_FLOAT, 0.0107f);
+  auto& y_zero_point = AddScalarInitializer(graph, "y_zero_point", TensorProto_DataType_UINT8, 118);
+
+  auto& a_float = graph.GetOrCreateNodeArg("a_float", nullptr);
+  auto& b_float = graph.GetOrCreateNodeArg("b_float", nullptr);
+  auto& y_float = graph.GetOrCreateNodeArg("y_float", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+
+  graph.AddNode("dequantize_a", "DequantizeLinear", "", {&a, &a_scale, &a_zero_point}, {&a_float}, nullptr, kMSDomain);
+  graph.AddNode("dequantize_b", "DequantizeLinear", "", {&b, &b_scale, &b_zero_point}, {&b_float}, nullptr, kMSDomain);
+  graph.AddNode("matmul", "MatMul", "", {&a_float, &b_float}, {&y_float});
+  graph.AddNode("quantize_y", "QuantizeLinear", "", {&y_float, &y_scale, &y_zero_point}, {&y}, nullptr, kMSDomain);
+}
+
+std::map<std::string, int> CountOpsInGraph(const Graph& graph) {
+  std::map<std::string, int> op_to_count;
+  for (auto& node : graph.Nodes()) {
+    op_to_count[node.OpType()]++;
+  }
+  return op_to_count;
+}
+
+void RunQDQMatMulModel(Model& model) {
+  std::stringstream model_stream;
+  model.ToProto().SerializeToOstream(&model_stream);
+
+  SessionOptions so;
+  so.session_logid = "GraphTransformationTests.RunQDQMatMulModel";
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(model_stream).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  MLValue a_value;
+  CreateMLValue<uint8_t>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2, 4},
+                         {208, 236, 0, 238, 3, 214, 255, 29}, &a_value);
+  NameMLValMap feeds{{"a", a_value}};
+  std::vector<MLValue> fetches;
+  auto status = session_object.Run(feeds, {"y"}, &fetches);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  const std::vector<uint8_t> expected{168, 115, 255, 1, 66, 151};
+  const auto& y_tensor = fetches[0].Get<Tensor>();
+  ASSERT_EQ(y_tensor.Shape(), TensorShape({2, 3}));
+  const uint8_t* y_data = y_tensor.Data<uint8_t>();
+  EXPECT_TRUE(std::equal(expected.cbegin(), expected.cend(), y_data));
+}
+}  // namespace
+
 TEST(GraphTransformationTests, IdentityElimination) {
   string model_uri = MODEL_FOLDER + "abs-id-max.onnx";
 
@@ -194,5 +289,46 @@ TEST(GraphTransformationTests, FuseConvAddMul3D) {
   ASSERT_TRUE(session_object.Initialize().IsOK());
 }
 
+TEST(GraphTransformationTests, FuseQDQMatMul) {
+  Model model("FuseQDQMatMul");
+  auto& graph = model.MainGraph();
+  BuildQDQMatMulGraph(graph);
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  // the unfused graph computes the reference output in float
+  RunQDQMatMulModel(model);
+
+  QDQFusion fusion;
+  bool modified = false;
+  ASSERT_TRUE(fusion.Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["QLinearMatMul"], 1);
+  EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+  EXPECT_EQ(op_to_count["MatMul"], 0);
+  EXPECT_EQ(op_to_count["QuantizeLinear"], 0);
+
+  RunQDQMatMulModel(model);
+}
+
+TEST(GraphTransformationTests, FuseQDQMatMulKeepsSharedDequantize) {
+  Model model("FuseQDQMatMulKeepsSharedDequantize");
+  auto& graph = model.MainGraph();
+  BuildQDQMatMulGraph(graph);
+
+  // a second consumer of the dequantized input prevents the fusion
+  auto& a_float = *graph.GetNodeArg("a_float");
+  auto& a_copy = graph.GetOrCreateNodeArg("a_copy", nullptr);
+  graph.AddNode("identity", "Identity", "", {&a_float}, {&a_copy});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  QDQFusion fusion;
+  bool modified = false;
+  ASSERT_TRUE(fusion.Apply(graph, modified).IsOK());
+  ASSERT_FALSE(modified);
+  EXPECT_EQ(CountOpsInGraph(graph)["QLinearMatMul"], 0);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
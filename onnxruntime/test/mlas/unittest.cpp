@@ -17,6 +17,8 @@ Abstract:
 #include <stdio.h>
 #include <memory.h>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <limits>
 #include <mlas.h>
 
@@ -30,6 +32,7 @@ Abstract:
 #define _countof(_Array) (sizeof(_Array) / sizeof(_Array[0]))
 #endif
 
+template<typename T>
 class MatrixGuardBuffer
 {
 public:
@@ -47,7 +50,7 @@ public:
 #endif
     }
 
-    float* GetBuffer(size_t Elements)
+    T* GetBuffer(size_t Elements)
     {
         return _GuardAddress - Elements;
     }
@@ -58,7 +61,7 @@ private:
         const size_t PageSize = 4096;
         const size_t GuardPadding = 256 * 1024;
 
-        size_t MatrixSize = Elements * sizeof(float);
+        size_t MatrixSize = Elements * sizeof(T);
         size_t AlignedMatrixSize = (MatrixSize + PageSize - 1) & ~(PageSize - 1);
 
         _BaseBufferSize = AlignedMatrixSize + GuardPadding;
@@ -71,17 +74,17 @@ private:
         mprotect(_BaseBuffer, AlignedMatrixSize, PROT_READ | PROT_WRITE);
 #endif
 
-        float* GuardAddress = (float*)((unsigned char*)_BaseBuffer + AlignedMatrixSize);
+        T* GuardAddress = (T*)((unsigned char*)_BaseBuffer + AlignedMatrixSize);
 
         const int MinimumFillValue = -23;
         const int MaximumFillValue = 23;
 
         int FillValue = MinimumFillValue;
-        float* FillAddress = (float*)((unsigned char*)GuardAddress - MatrixSize);
+        T* FillAddress = (T*)((unsigned char*)GuardAddress - MatrixSize);
 
         while (FillAddress < GuardAddress) {
 
-            *FillAddress++ = (float)FillValue;
+            *FillAddress++ = (T)FillValue;
 
             FillValue++;
 
@@ -105,7 +108,7 @@ private:
 private:
     void* _BaseBuffer;
     size_t _BaseBufferSize;
-    float* _GuardAddress;
+    T* _GuardAddress;
 };
 
 void
@@ -257,11 +260,11 @@ TrialSgemm(
     size_t N,
     size_t K,
     float alpha,
-    MatrixGuardBuffer& BufferA,
-    MatrixGuardBuffer& BufferB,
+    MatrixGuardBuffer<float>& BufferA,
+    MatrixGuardBuffer<float>& BufferB,
     float beta,
-    MatrixGuardBuffer& BufferC,
-    MatrixGuardBuffer& BufferCReference
+    MatrixGuardBuffer<float>& BufferC,
+    MatrixGuardBuffer<float>& BufferCReference
     )
 {
     const float* A = BufferA.GetBuffer(K * M);
@@ -282,10 +285,10 @@ ExecuteSgemmTests(
 {
     constexpr size_t MaximumDimension = 320;
 
-    MatrixGuardBuffer BufferA(MaximumDimension * MaximumDimension, true);
-    MatrixGuardBuffer BufferB(MaximumDimension * MaximumDimension, true);
-    MatrixGuardBuffer BufferC(MaximumDimension * MaximumDimension, false);
-    MatrixGuardBuffer BufferCReference(MaximumDimension * MaximumDimension, false);
+    MatrixGuardBuffer<float> BufferA(MaximumDimension * MaximumDimension, true);
+    MatrixGuardBuffer<float> BufferB(MaximumDimension * MaximumDimension, true);
+    MatrixGuardBuffer<float> BufferC(MaximumDimension * MaximumDimension, false);
+    MatrixGuardBuffer<float> BufferCReference(MaximumDimension * MaximumDimension, false);
 
     // Trial balloons.
     for (size_t b = 1; b < 16; b++) {
@@ -367,6 +370,729 @@ ExecuteSgemmTests(
     }
 }
 
+void
+ReferenceQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    bool BIsSigned,
+    int32_t* C,
+    size_t ldc
+    )
+{
+    for (size_t m = 0; m < M; m++) {
+
+        for (size_t n = 0; n < N; n++) {
+
+            const uint8_t* a = A + (m * lda);
+            const uint8_t* b = B + n;
+            int32_t* c = C + (m * ldc) + n;
+            int32_t sum = 0;
+
+            for (size_t k = 0; k < K; k++) {
+                int32_t bvalue = BIsSigned ? int32_t(int8_t(*b)) - int32_t(int8_t(offb)) : int32_t(*b) - int32_t(offb);
+                sum += (int32_t(*a) - int32_t(offa)) * bvalue;
+                b += ldb;
+                a += 1;
+            }
+
+            *c = sum;
+        }
+    }
+}
+
+void
+TrialQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    uint8_t offa,
+    uint8_t offb,
+    bool BIsSigned,
+    MatrixGuardBuffer<uint8_t>& BufferA,
+    MatrixGuardBuffer<uint8_t>& BufferB,
+    MatrixGuardBuffer<uint8_t>& BufferPackedB,
+    MatrixGuardBuffer<int32_t>& BufferC,
+    MatrixGuardBuffer<int32_t>& BufferCReference
+    )
+{
+    const uint8_t* A = BufferA.GetBuffer(K * M);
+    const uint8_t* B = BufferB.GetBuffer(N * K);
+    int32_t* C = BufferC.GetBuffer(N * M);
+    int32_t* CReference = BufferCReference.GetBuffer(N * M);
+
+    std::fill_n(C, M * N, -1);
+    std::fill_n(CReference, M * N, -1);
+
+    ReferenceQgemm(M, N, K, A, K, offa, B, N, offb, BIsSigned, CReference, N);
+
+    MlasQgemm(M, N, K, A, K, offa, B, N, offb, BIsSigned, C, N);
+
+    if (memcmp(C, CReference, M * N * sizeof(int32_t)) != 0) {
+        printf("mismatch M=%zd, N=%zd, K=%zd, offa=%d, offb=%d, BIsSigned=%d!\n", M, N, K, offa, offb, int(BIsSigned));
+    }
+
+    //
+    // Repeat the operation with a prepacked matrix B.
+    //
+
+    size_t PackedBSize = MlasQgemmPackBSize(N, K);
+    void* PackedB = BufferPackedB.GetBuffer(PackedBSize);
+
+    MlasQgemmPackB(N, K, B, N, offb, BIsSigned, PackedB);
+
+    std::fill_n(C, M * N, -1);
+
+    MlasQgemmPacked(M, N, K, A, K, offa, PackedB, C, N);
+
+    if (memcmp(C, CReference, M * N * sizeof(int32_t)) != 0) {
+        printf("mismatch packed M=%zd, N=%zd, K=%zd, offa=%d, offb=%d, BIsSigned=%d!\n", M, N, K, offa, offb, int(BIsSigned));
+    }
+}
+
+void
+ExecuteQgemmTests(
+    void
+    )
+{
+    constexpr size_t MaximumDimension = 320;
+
+    MatrixGuardBuffer<uint8_t> BufferA(MaximumDimension * MaximumDimension, true);
+    MatrixGuardBuffer<uint8_t> BufferB(MaximumDimension * MaximumDimension, true);
+    MatrixGuardBuffer<uint8_t> BufferPackedB((MaximumDimension + 16) * (MaximumDimension + 2) * sizeof(int16_t), false);
+    MatrixGuardBuffer<int32_t> BufferC(MaximumDimension * MaximumDimension, false);
+    MatrixGuardBuffer<int32_t> BufferCReference(MaximumDimension * MaximumDimension, false);
+
+    static const uint8_t offsets[] = { 0, 1, 7, 128, 231, 255 };
+
+    for (size_t b = 1; b < 16; b++) {
+        TrialQgemm(b, b, b, 7, 9, false, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+        TrialQgemm(b, b, b, 7, 9, true, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+    }
+    for (size_t b = 16; b <= 256; b <<= 1) {
+        TrialQgemm(b, b, b, 34, 1, false, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+        TrialQgemm(b, b, b, 34, 1, true, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+    }
+    for (size_t b = 256; b < 320; b += 32) {
+        TrialQgemm(b, b, b, 85, 173, false, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+        TrialQgemm(b, b, b, 85, 173, true, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+    }
+
+    for (size_t a = 0; a < _countof(offsets); a++) {
+        for (size_t b = 0; b < _countof(offsets); b++) {
+            TrialQgemm(16, 16, 16, offsets[a], offsets[b], false, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+            TrialQgemm(16, 16, 16, offsets[a], offsets[b], true, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+            TrialQgemm(1, 33, 257, offsets[a], offsets[b], false, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+            TrialQgemm(1, 33, 257, offsets[a], offsets[b], true, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+        }
+    }
+
+    for (size_t M = 1; M < 48; M++) {
+        for (size_t N = 1; N < 48; N++) {
+            for (size_t K = 1; K < 48; K++) {
+                TrialQgemm(M, N, K, 13, 101, false, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+                TrialQgemm(M, N, K, 13, 101, true, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+            }
+        }
+        printf("M %zd\n", M);
+    }
+
+    for (size_t M = 1; M < 160; M += 17) {
+        for (size_t N = 112; N < 320; N += 24) {
+            for (size_t K = 240; K < 320; K += 13) {
+                TrialQgemm(M, N, K, 1, 254, false, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+                TrialQgemm(M, N, K, 1, 254, true, BufferA, BufferB, BufferPackedB, BufferC, BufferCReference);
+            }
+        }
+        printf("M %zd\n", M);
+    }
+}
+
+void
+EvaluateQgemmPerformance(
+    void
+    )
+{
+    static const size_t shapes[][3] = {
+        { 1, 1024, 1024 },
+        { 16, 1024, 1024 },
+        { 64, 512, 2048 },
+        { 256, 256, 256 },
+        { 512, 512, 512 },
+        { 1024, 1024, 1024 },
+    };
+
+    for (size_t s = 0; s < _countof(shapes); s++) {
+
+        const size_t M = shapes[s][0];
+        const size_t N = shapes[s][1];
+        const size_t K = shapes[s][2];
+
+        MatrixGuardBuffer<uint8_t> BufferA(M * K, true);
+        MatrixGuardBuffer<uint8_t> BufferB(K * N, true);
+        MatrixGuardBuffer<uint8_t> BufferPackedB(MlasQgemmPackBSize(N, K), false);
+        MatrixGuardBuffer<int32_t> BufferC(M * N, false);
+
+        const uint8_t* A = BufferA.GetBuffer(M * K);
+        const uint8_t* B = BufferB.GetBuffer(K * N);
+        void* PackedB = BufferPackedB.GetBuffer(MlasQgemmPackBSize(N, K));
+        int32_t* C = BufferC.GetBuffer(M * N);
+
+        MlasQgemmPackB(N, K, B, N, 128, false, PackedB);
+
+        //
+        // Run enough iterations to perform roughly the same number of
+        // multiplies for each shape.
+        //
+
+        const size_t Iterations = std::max(size_t(4), size_t(4ull * 1024 * 1024 * 1024 / (M * N * K)));
+        const double Operations = 2.0 * double(M) * double(N) * double(K) * double(Iterations);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < Iterations; i++) {
+            MlasQgemm(M, N, K, A, K, 128, B, N, 128, false, C, N);
+        }
+        std::chrono::duration<double> unpacked = std::chrono::high_resolution_clock::now() - start;
+
+        start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < Iterations; i++) {
+            MlasQgemmPacked(M, N, K, A, K, 128, PackedB, C, N);
+        }
+        std::chrono::duration<double> packed = std::chrono::high_resolution_clock::now() - start;
+
+        printf("qgemm %zd,%zd,%zd: %.2f gops, packed %.2f gops\n", M, N, K,
+            Operations / unpacked.count() * 1e-9, Operations / packed.count() * 1e-9);
+    }
+}
+
+template<typename T>
+void
+TrialQuantizeLinear(
+    size_t N,
+    float Scale,
+    T ZeroPoint,
+    MatrixGuardBuffer<float>& BufferInput,
+    MatrixGuardBuffer<T>& BufferOutput,
+    MatrixGuardBuffer<float>& BufferDequantized
+    )
+{
+    float* Input = BufferInput.GetBuffer(N);
+    T* Output = BufferOutput.GetBuffer(N);
+    float* Dequantized = BufferDequantized.GetBuffer(N);
+
+    //
+    // Generate values across the full quantized range including halfway cases
+    // and values that saturate.
+    //
+
+    for (size_t n = 0; n < N; n++) {
+        Input[n] = (float(int(n % 613) - 306) * 0.5f) * Scale;
+    }
+
+    MlasQuantizeLinear(Input, Output, N, Scale, ZeroPoint);
+
+    for (size_t n = 0; n < N; n++) {
+
+        float FloatValue = std::round(Input[n] / Scale) + float(ZeroPoint);
+        FloatValue = std::min(std::max(FloatValue, float(std::numeric_limits<T>::lowest())), float(std::numeric_limits<T>::max()));
+
+        if (Output[n] != T(FloatValue)) {
+            printf("mismatch quantize N=%zd, n=%zd, Scale=%f, ZeroPoint=%d!\n", N, n, Scale, int(ZeroPoint));
+            break;
+        }
+    }
+
+    MlasDequantizeLinear(Output, Dequantized, N, Scale, ZeroPoint);
+
+    for (size_t n = 0; n < N; n++) {
+
+        if (Dequantized[n] != float(int32_t(Output[n]) - int32_t(ZeroPoint)) * Scale) {
+            printf("mismatch dequantize N=%zd, n=%zd, Scale=%f, ZeroPoint=%d!\n", N, n, Scale, int(ZeroPoint));
+            break;
+        }
+    }
+}
+
+void
+TrialRequantizeOutput(
+    size_t M,
+    size_t N,
+    bool PerRowScale,
+    bool HasBias,
+    uint8_t ZeroPoint,
+    MatrixGuardBuffer<int32_t>& BufferInput,
+    MatrixGuardBuffer<uint8_t>& BufferOutput
+    )
+{
+    int32_t* Input = BufferInput.GetBuffer(M * N);
+    uint8_t* Output = BufferOutput.GetBuffer(M * N);
+    int32_t Bias[8];
+    float Scale[8];
+
+    for (size_t i = 0; i < M * N; i++) {
+        Input[i] = int32_t(i * 7919 % 20011) - 10005;
+    }
+
+    for (size_t m = 0; m < M; m++) {
+        Bias[m] = int32_t(m * 37) - 100;
+        Scale[m] = PerRowScale ? 0.0125f * float(m + 1) : 0.0125f;
+    }
+
+    MlasRequantizeOutput(Input, Output, HasBias ? Bias : nullptr, M, N, Scale, PerRowScale, ZeroPoint);
+
+    for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+
+            int32_t Value = Input[m * N + n] + (HasBias ? Bias[m] : 0);
+            float FloatValue = std::round(float(Value) * Scale[m]) + float(ZeroPoint);
+            FloatValue = std::min(std::max(FloatValue, 0.0f), 255.0f);
+
+            if (Output[m * N + n] != uint8_t(FloatValue)) {
+                printf("mismatch requantize M=%zd, N=%zd, m=%zd, n=%zd, PerRowScale=%d!\n", M, N, m, n, int(PerRowScale));
+                return;
+            }
+        }
+    }
+}
+
+void
+ExecuteQuantizeLinearTests(
+    void
+    )
+{
+    constexpr size_t MaximumElements = 4099;
+
+    MatrixGuardBuffer<float> BufferInput(MaximumElements, false);
+    MatrixGuardBuffer<uint8_t> BufferOutputU8(MaximumElements, false);
+    MatrixGuardBuffer<int8_t> BufferOutputS8(MaximumElements, false);
+    MatrixGuardBuffer<float> BufferDequantized(MaximumElements, false);
+    MatrixGuardBuffer<int32_t> BufferAccumulators(MaximumElements, false);
+
+    static const float scales[] = { 1.0f, 0.5f, 0.0078125f, 0.0173f, 3.0f };
+
+    for (size_t s = 0; s < _countof(scales); s++) {
+        for (size_t N = 1; N < 40; N++) {
+            TrialQuantizeLinear<uint8_t>(N, scales[s], 0, BufferInput, BufferOutputU8, BufferDequantized);
+            TrialQuantizeLinear<uint8_t>(N, scales[s], 128, BufferInput, BufferOutputU8, BufferDequantized);
+            TrialQuantizeLinear<uint8_t>(N, scales[s], 255, BufferInput, BufferOutputU8, BufferDequantized);
+            TrialQuantizeLinear<int8_t>(N, scales[s], 0, BufferInput, BufferOutputS8, BufferDequantized);
+            TrialQuantizeLinear<int8_t>(N, scales[s], -128, BufferInput, BufferOutputS8, BufferDequantized);
+            TrialQuantizeLinear<int8_t>(N, scales[s], 17, BufferInput, BufferOutputS8, BufferDequantized);
+        }
+        TrialQuantizeLinear<uint8_t>(MaximumElements, scales[s], 113, BufferInput, BufferOutputU8, BufferDequantized);
+        TrialQuantizeLinear<int8_t>(MaximumElements, scales[s], -5, BufferInput, BufferOutputS8, BufferDequantized);
+    }
+
+    for (size_t M = 1; M <= 8; M++) {
+        for (size_t N = 1; N < 40; N++) {
+            TrialRequantizeOutput(M, N, false, false, 0, BufferAccumulators, BufferOutputU8);
+            TrialRequantizeOutput(M, N, false, true, 128, BufferAccumulators, BufferOutputU8);
+            TrialRequantizeOutput(M, N, true, true, 17, BufferAccumulators, BufferOutputU8);
+        }
+    }
+}
+
+bool
+CloseEnough(
+    float Actual,
+    double Expected,
+    double AbsoluteTolerance,
+    double RelativeTolerance
+    )
+{
+    if (std::isnan(Expected)) {
+        return std::isnan(Actual);
+    }
+
+    if (std::isinf(Expected)) {
+        return Actual == Expected;
+    }
+
+    return std::fabs(double(Actual) - Expected) <= AbsoluteTolerance + RelativeTolerance * std::fabs(Expected);
+}
+
+template<typename ComputeRoutine, typename ReferenceRoutine>
+void
+TrialComputeUnary(
+    const char* Name,
+    ComputeRoutine Compute,
+    ReferenceRoutine Reference,
+    float MinimumValue,
+    float MaximumValue,
+    double AbsoluteTolerance,
+    double RelativeTolerance,
+    size_t N,
+    MatrixGuardBuffer<float>& BufferInput,
+    MatrixGuardBuffer<float>& BufferOutput
+    )
+{
+    float* Input = BufferInput.GetBuffer(N);
+    float* Output = BufferOutput.GetBuffer(N);
+
+    for (size_t n = 0; n < N; n++) {
+        Input[n] = MinimumValue + (MaximumValue - MinimumValue) * float(n) / float(N > 1 ? N - 1 : 1);
+    }
+
+    Compute(Input, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+
+        double Expected = Reference(double(Input[n]));
+
+        if (!CloseEnough(Output[n], Expected, AbsoluteTolerance, RelativeTolerance)) {
+            printf("mismatch %s N=%zd, n=%zd, input=%.9g, output=%.9g, expected=%.9g!\n",
+                Name, N, n, Input[n], Output[n], Expected);
+            return;
+        }
+    }
+}
+
+void
+TrialComputeSpecialValues(
+    void
+    )
+{
+    const float Infinity = std::numeric_limits<float>::infinity();
+    const float NaN = std::numeric_limits<float>::quiet_NaN();
+    const float Denormal = std::numeric_limits<float>::denorm_min() * 1000.0f;
+
+    const float Input[] = { 0.0f, -0.0f, Infinity, -Infinity, NaN, Denormal, -1.0f, 1.0f, 1000.0f, -1000.0f, 88.5f };
+    const size_t N = _countof(Input);
+    float Output[N];
+
+    MlasComputeExp(Input, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+        if (!CloseEnough(Output[n], std::exp(double(Input[n])), 1e-45, 2e-6)) {
+            printf("mismatch exp special n=%zd, input=%.9g, output=%.9g!\n", n, Input[n], Output[n]);
+        }
+    }
+
+    MlasComputeLog(Input, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+        if (!CloseEnough(Output[n], std::log(double(Input[n])), 0.0, 2e-6)) {
+            printf("mismatch log special n=%zd, input=%.9g, output=%.9g!\n", n, Input[n], Output[n]);
+        }
+    }
+
+    MlasComputeErf(Input, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+        if (!CloseEnough(Output[n], std::erf(double(Input[n])), 1e-44, 2e-6)) {
+            printf("mismatch erf special n=%zd, input=%.9g, output=%.9g!\n", n, Input[n], Output[n]);
+        }
+    }
+}
+
+void
+TrialComputeSoftmax(
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    MatrixGuardBuffer<float>& BufferInput,
+    MatrixGuardBuffer<float>& BufferOutput
+    )
+{
+    float* Input = BufferInput.GetBuffer(N * D);
+    float* Output = BufferOutput.GetBuffer(N * D);
+
+    for (size_t i = 0; i < N * D; i++) {
+        Input[i] = float(int(i * 7919 % 2003) - 1001) * 0.03125f;
+    }
+
+    MlasComputeSoftmax(Input, Output, N, D, LogSoftmax);
+
+    for (size_t n = 0; n < N; n++) {
+
+        const float* InputRow = Input + n * D;
+        const float* OutputRow = Output + n * D;
+
+        double Maximum = *std::max_element(InputRow, InputRow + D);
+        double Sum = 0.0;
+
+        for (size_t d = 0; d < D; d++) {
+            Sum += std::exp(double(InputRow[d]) - Maximum);
+        }
+
+        for (size_t d = 0; d < D; d++) {
+
+            double Expected = double(InputRow[d]) - Maximum;
+            bool Close;
+
+            if (LogSoftmax) {
+                Expected -= std::log(Sum);
+                Close = CloseEnough(OutputRow[d], Expected, 1e-5, 1e-6);
+            } else {
+                Expected = std::exp(Expected) / Sum;
+                Close = CloseEnough(OutputRow[d], Expected, 1e-30, 1e-5);
+            }
+
+            if (!Close) {
+                printf("mismatch %s N=%zd, D=%zd, n=%zd, d=%zd, output=%.9g, expected=%.9g!\n",
+                    LogSoftmax ? "logsoftmax" : "softmax", N, D, n, d, OutputRow[d], Expected);
+                return;
+            }
+        }
+    }
+}
+
+void
+ExecuteComputeTests(
+    void
+    )
+{
+    constexpr size_t MaximumElements = 64 * 1031;
+
+    MatrixGuardBuffer<float> BufferInput(MaximumElements, false);
+    MatrixGuardBuffer<float> BufferOutput(MaximumElements, false);
+
+    static const size_t ns[] = { 1, 3, 7, 8, 15, 16, 17, 31, 33, 63, 65, 4099, 20011 };
+
+    auto ReferenceExp = [](double x) { return std::exp(x); };
+    auto ReferenceLog = [](double x) { return std::log(x); };
+    auto ReferenceErf = [](double x) { return std::erf(x); };
+
+    for (size_t i = 0; i < _countof(ns); i++) {
+        TrialComputeUnary("exp", MlasComputeExp, ReferenceExp, -103.0f, 88.5f, 1e-44, 2e-6, ns[i], BufferInput, BufferOutput);
+        TrialComputeUnary("exp", MlasComputeExp, ReferenceExp, -2.0f, 2.0f, 0.0, 2e-6, ns[i], BufferInput, BufferOutput);
+        TrialComputeUnary("log", MlasComputeLog, ReferenceLog, 1e-37f, 1e37f, 0.0, 2e-6, ns[i], BufferInput, BufferOutput);
+        TrialComputeUnary("log", MlasComputeLog, ReferenceLog, 0.25f, 4.0f, 1e-7, 2e-6, ns[i], BufferInput, BufferOutput);
+        TrialComputeUnary("erf", MlasComputeErf, ReferenceErf, -5.0f, 5.0f, 1e-7, 2e-6, ns[i], BufferInput, BufferOutput);
+    }
+
+    TrialComputeSpecialValues();
+
+    static const size_t ds[] = { 1, 2, 3, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000, 1031 };
+
+    for (size_t i = 0; i < _countof(ds); i++) {
+        for (size_t N = 1; N <= 64; N *= 4) {
+            TrialComputeSoftmax(N, ds[i], false, BufferInput, BufferOutput);
+            TrialComputeSoftmax(N, ds[i], true, BufferInput, BufferOutput);
+        }
+    }
+}
+
+float
+ReferenceHalfToFloat(
+    unsigned short Half
+    )
+{
+    int Exponent = (Half >> 10) & 0x1F;
+    int Mantissa = Half & 0x3FF;
+    float Value;
+
+    if (Exponent == 0x1F) {
+        Value = (Mantissa != 0) ? std::numeric_limits<float>::quiet_NaN() : std::numeric_limits<float>::infinity();
+    } else if (Exponent == 0) {
+        Value = std::ldexp(float(Mantissa), -24);
+    } else {
+        Value = std::ldexp(float(Mantissa + 0x400), Exponent - 25);
+    }
+
+    return (Half & 0x8000) ? -Value : Value;
+}
+
+void
+TrialConvertHalf(
+    size_t N,
+    MatrixGuardBuffer<unsigned short>& BufferHalf,
+    MatrixGuardBuffer<float>& BufferFloat,
+    MatrixGuardBuffer<unsigned short>& BufferOutput
+    )
+{
+    //
+    // Convert every half precision value in blocks of N elements and verify
+    // the result against the reference conversion. Converting back must
+    // produce the original value except for NaNs, which only need to remain
+    // NaNs.
+    //
+
+    unsigned short* Half = BufferHalf.GetBuffer(N);
+    float* Float = BufferFloat.GetBuffer(N);
+    unsigned short* Output = BufferOutput.GetBuffer(N);
+
+    for (uint32_t start = 0; start < 0x10000; start += uint32_t(N)) {
+
+        size_t Count = std::min(N, size_t(0x10000 - start));
+
+        for (size_t n = 0; n < Count; n++) {
+            Half[n] = (unsigned short)(start + n);
+        }
+
+        MlasConvertHalfToFloatBuffer(Half, Float, Count);
+        MlasConvertFloatToHalfBuffer(Float, Output, Count);
+
+        for (size_t n = 0; n < Count; n++) {
+
+            float Expected = ReferenceHalfToFloat(Half[n]);
+            bool IsNaN = std::isnan(Expected);
+
+            if (IsNaN ? !std::isnan(Float[n]) : memcmp(&Float[n], &Expected, sizeof(float)) != 0) {
+                printf("mismatch half to float N=%zd, value=%04x!\n", N, unsigned(Half[n]));
+                return;
+            }
+
+            if (IsNaN ? (Output[n] & 0x7FFF) <= 0x7C00 : Output[n] != Half[n]) {
+                printf("mismatch float to half N=%zd, value=%04x!\n", N, unsigned(Half[n]));
+                return;
+            }
+        }
+    }
+}
+
+void
+TrialConvertHalfRounding(
+    MatrixGuardBuffer<float>& BufferFloat,
+    MatrixGuardBuffer<unsigned short>& BufferOutput
+    )
+{
+    //
+    // Verify the rounding of values halfway between adjacent finite half
+    // precision values and of the values just below and above the halfway
+    // point. Halfway cases round to the value with an even mantissa.
+    //
+
+    constexpr size_t Count = 3 * 0x7BFF;
+
+    float* Float = BufferFloat.GetBuffer(Count);
+    unsigned short* Output = BufferOutput.GetBuffer(Count);
+
+    for (unsigned Half = 0; Half < 0x7BFF; Half++) {
+
+        float Low = ReferenceHalfToFloat((unsigned short)Half);
+        float High = ReferenceHalfToFloat((unsigned short)(Half + 1));
+        float Middle = (Low + High) * 0.5f;
+
+        Float[3 * Half + 0] = Middle;
+        Float[3 * Half + 1] = std::nextafter(Middle, Low);
+        Float[3 * Half + 2] = std::nextafter(Middle, High);
+    }
+
+    for (int Negate = 0; Negate < 2; Negate++) {
+
+        MlasConvertFloatToHalfBuffer(Float, Output, Count);
+
+        for (unsigned Half = 0; Half < 0x7BFF; Half++) {
+
+            unsigned Sign = Negate ? 0x8000 : 0;
+            unsigned Even = ((Half & 1) == 0) ? Half : Half + 1;
+
+            if (Output[3 * Half + 0] != (Even | Sign) ||
+                Output[3 * Half + 1] != (Half | Sign) ||
+                Output[3 * Half + 2] != ((Half + 1) | Sign)) {
+                printf("mismatch float to half rounding value=%04x!\n", Half | Sign);
+                return;
+            }
+        }
+
+        for (size_t n = 0; n < Count; n++) {
+            Float[n] = -Float[n];
+        }
+    }
+}
+
+void
+TrialConvertBFloat16(
+    size_t N,
+    MatrixGuardBuffer<float>& BufferInput,
+    MatrixGuardBuffer<unsigned short>& BufferBFloat16,
+    MatrixGuardBuffer<float>& BufferOutput
+    )
+{
+    float* Input = BufferInput.GetBuffer(N);
+    unsigned short* BFloat16 = BufferBFloat16.GetBuffer(N);
+    float* Output = BufferOutput.GetBuffer(N);
+
+    //
+    // Generate bit patterns that cover values exactly representable as
+    // bfloat16, halfway cases with both odd and even mantissas, values just
+    // above and below the halfway cases, infinities and NaNs.
+    //
+
+    static const uint32_t LowBits[] = { 0x0000, 0x8000, 0x7FFF, 0x8001, 0xFFFF, 0x1234 };
+
+    for (size_t n = 0; n < N; n++) {
+
+        uint32_t Bits = (uint32_t(n * 40503) & 0xFFFF) << 16 | LowBits[n % _countof(LowBits)];
+
+        if (n % 97 == 0) {
+            Bits = 0x7F800000 | (Bits & 0x80000000);
+        } else if (n % 89 == 0) {
+            Bits = 0x7F800001 | (Bits & 0x80000000);
+        }
+
+        memcpy(&Input[n], &Bits, sizeof(float));
+    }
+
+    MlasConvertFloatToBFloat16Buffer(Input, BFloat16, N);
+    MlasConvertBFloat16ToFloatBuffer(BFloat16, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+
+        uint32_t Bits;
+        memcpy(&Bits, &Input[n], sizeof(float));
+
+        if (std::isnan(Input[n])) {
+
+            if (!std::isnan(Output[n])) {
+                printf("mismatch bfloat16 NaN N=%zd, n=%zd, value=%08x!\n", N, n, Bits);
+                return;
+            }
+
+            continue;
+        }
+
+        uint32_t Truncated = Bits >> 16;
+        uint32_t Remainder = Bits & 0xFFFF;
+
+        if (Remainder > 0x8000 || (Remainder == 0x8000 && (Truncated & 1) != 0)) {
+            Truncated += 1;
+        }
+
+        uint32_t OutputBits;
+        memcpy(&OutputBits, &Output[n], sizeof(float));
+
+        if (BFloat16[n] != Truncated || OutputBits != (Truncated << 16)) {
+            printf("mismatch bfloat16 N=%zd, n=%zd, value=%08x!\n", N, n, Bits);
+            return;
+        }
+    }
+}
+
+void
+ExecuteHalfConvertTests(
+    void
+    )
+{
+    constexpr size_t MaximumElements = 3 * 0x7BFF;
+
+    MatrixGuardBuffer<unsigned short> BufferHalf(MaximumElements, false);
+    MatrixGuardBuffer<float> BufferFloat(MaximumElements, false);
+    MatrixGuardBuffer<unsigned short> BufferOutput(MaximumElements, false);
+
+    static const size_t ns[] = { 1, 3, 7, 8, 15, 16, 17, 31, 33, 4099 };
+
+    for (size_t i = 0; i < _countof(ns); i++) {
+        TrialConvertHalf(ns[i], BufferHalf, BufferFloat, BufferOutput);
+    }
+
+    TrialConvertHalfRounding(BufferFloat, BufferOutput);
+
+    MatrixGuardBuffer<float> BufferDequantized(MaximumElements, false);
+
+    for (size_t N = 1; N < 40; N++) {
+        TrialConvertBFloat16(N, BufferFloat, BufferHalf, BufferDequantized);
+    }
+    TrialConvertBFloat16(4099, BufferFloat, BufferHalf, BufferDequantized);
+}
+
 void
 ReferenceConv2D(
     size_t BatchCount,
@@ -398,7 +1124,7 @@ ReferenceConv2D(
     size_t K = InputChannels * KernelSize;
     size_t Im2ColBufferElements = OutputSize * K;
 
-    MatrixGuardBuffer BufferIm2Col(Im2ColBufferElements, false);
+    MatrixGuardBuffer<float> BufferIm2Col(Im2ColBufferElements, false);
 
     for (size_t b = 0; b < BatchCount; b++) {
 
@@ -526,11 +1252,11 @@ TrialConv2D(
     size_t BiasBufferElements = GroupCount * FilterCount;
     size_t OutputBufferElements = BatchCount * GroupCount * FilterCount * OutputSize;
 
-    MatrixGuardBuffer BufferInput(InputBufferElements, true);
-    MatrixGuardBuffer BufferFilter(FilterBufferElements, true);
-    MatrixGuardBuffer BufferBias(BiasBufferElements, true);
-    MatrixGuardBuffer BufferOutput(OutputBufferElements, false);
-    MatrixGuardBuffer BufferOutputReference(OutputBufferElements, false);
+    MatrixGuardBuffer<float> BufferInput(InputBufferElements, true);
+    MatrixGuardBuffer<float> BufferFilter(FilterBufferElements, true);
+    MatrixGuardBuffer<float> BufferBias(BiasBufferElements, true);
+    MatrixGuardBuffer<float> BufferOutput(OutputBufferElements, false);
+    MatrixGuardBuffer<float> BufferOutputReference(OutputBufferElements, false);
 
     const float* Input = BufferInput.GetBuffer(InputBufferElements);
     const float* Filter = BufferFilter.GetBuffer(FilterBufferElements);
@@ -538,7 +1264,7 @@ TrialConv2D(
     float* Output = BufferOutput.GetBuffer(OutputBufferElements);
     float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
 
-    MatrixGuardBuffer BufferWorking(WorkingBufferSize, false);
+    MatrixGuardBuffer<float> BufferWorking(WorkingBufferSize, false);
 
     MlasConv(&Parameters,
              Input,
@@ -567,6 +1293,38 @@ TrialConv2D(
             BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
             KernelHeight, KernelWidth);
     }
+
+    //
+    // Verify the algorithms that can be selected in place of the prepared
+    // algorithm produce the same output.
+    //
+
+    static const MLAS_CONV_ALGORITHM Algorithms[] = {
+        MlasConvAlgorithmExpandThenGemm,
+        MlasConvAlgorithmExpandThenGemmSegmented,
+    };
+
+    for (size_t i = 0; i < _countof(Algorithms); i++) {
+
+        if (!MlasConvSetAlgorithm(&Parameters, Algorithms[i], &WorkingBufferSize)) {
+            continue;
+        }
+
+        MatrixGuardBuffer<float> BufferAlgorithmWorking(WorkingBufferSize, false);
+
+        MlasConv(&Parameters,
+                 Input,
+                 Filter,
+                 Bias,
+                 BufferAlgorithmWorking.GetBuffer(WorkingBufferSize),
+                 Output);
+
+        if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+            printf("mismatch algorithm %d: batch=%zd,group=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd)!!!\n",
+                int(Algorithms[i]), BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
+                KernelHeight, KernelWidth);
+        }
+    }
 }
 
 void
@@ -631,6 +1389,384 @@ ExecuteConvTests(
     }
 }
 
+void
+ReferenceConvTranspose2D(
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t FilterCount,
+    size_t KernelHeight,
+    size_t KernelWidth,
+    size_t PaddingLeftHeight,
+    size_t PaddingLeftWidth,
+    size_t DilationHeight,
+    size_t DilationWidth,
+    size_t StrideHeight,
+    size_t StrideWidth,
+    size_t OutputHeight,
+    size_t OutputWidth,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output
+    )
+{
+    size_t InputSize = InputHeight * InputWidth;
+    size_t OutputSize = OutputHeight * OutputWidth;
+    size_t KernelSize = KernelHeight * KernelWidth;
+
+    for (size_t b = 0; b < BatchCount; b++) {
+
+        const float* filter = Filter;
+        const float* bias = Bias;
+
+        for (size_t g = 0; g < GroupCount; g++) {
+
+            //
+            // Scatter each input element scaled by the kernel to the output.
+            //
+
+            for (size_t f = 0; f < FilterCount; f++) {
+
+                float* output = Output + f * OutputSize;
+                float biasValue = *bias++;
+
+                for (size_t o = 0; o < OutputSize; o++) {
+                    output[o] = biasValue;
+                }
+
+                for (size_t c = 0; c < InputChannels; c++) {
+
+                    const float* input = Input + c * InputSize;
+                    const float* kernel = filter + (c * FilterCount + f) * KernelSize;
+
+                    for (size_t ih = 0; ih < InputHeight; ih++) {
+
+                        for (size_t iw = 0; iw < InputWidth; iw++) {
+
+                            for (size_t ky = 0; ky < KernelHeight; ky++) {
+
+                                size_t oh = ih * StrideHeight + ky * DilationHeight - PaddingLeftHeight;
+
+                                for (size_t kx = 0; kx < KernelWidth; kx++) {
+
+                                    size_t ow = iw * StrideWidth + kx * DilationWidth - PaddingLeftWidth;
+
+                                    if (oh < OutputHeight && ow < OutputWidth) {
+                                        output[oh * OutputWidth + ow] +=
+                                            input[ih * InputWidth + iw] * kernel[ky * KernelWidth + kx];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            filter += InputChannels * FilterCount * KernelSize;
+            Input += InputChannels * InputSize;
+            Output += FilterCount * OutputSize;
+        }
+    }
+}
+
+void
+TrialConvTranspose2D(
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t FilterCount,
+    size_t KernelHeight,
+    size_t KernelWidth,
+    size_t PaddingLeftHeight,
+    size_t PaddingLeftWidth,
+    size_t PaddingRightHeight,
+    size_t PaddingRightWidth,
+    size_t DilationHeight,
+    size_t DilationWidth,
+    size_t StrideHeight,
+    size_t StrideWidth,
+    size_t OutputPaddingHeight,
+    size_t OutputPaddingWidth
+    )
+{
+    int64_t OutputHeight64 =
+        (int64_t(InputHeight) - 1) * int64_t(StrideHeight) + int64_t(DilationHeight) * (int64_t(KernelHeight) - 1) + 1 +
+        int64_t(OutputPaddingHeight) - int64_t(PaddingLeftHeight) - int64_t(PaddingRightHeight);
+    int64_t OutputWidth64 =
+        (int64_t(InputWidth) - 1) * int64_t(StrideWidth) + int64_t(DilationWidth) * (int64_t(KernelWidth) - 1) + 1 +
+        int64_t(OutputPaddingWidth) - int64_t(PaddingLeftWidth) - int64_t(PaddingRightWidth);
+
+    if (OutputHeight64 <= 0 || OutputWidth64 <= 0) {
+        return;
+    }
+
+    int64_t InputShape[] = { int64_t(InputHeight), int64_t(InputWidth) };
+    int64_t KernelShape[] = { int64_t(KernelHeight), int64_t(KernelWidth) };
+    int64_t DilationShape[] = { int64_t(DilationHeight), int64_t(DilationWidth) };
+    int64_t Padding[] = { int64_t(PaddingLeftHeight), int64_t(PaddingLeftWidth), int64_t(PaddingRightHeight), int64_t(PaddingRightWidth) };
+    int64_t StrideShape[] = { int64_t(StrideHeight), int64_t(StrideWidth) };
+    int64_t OutputShape[] = { OutputHeight64, OutputWidth64 };
+
+    MLAS_CONV_TRANSPOSE_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvTransposePrepare(&Parameters,
+                             BatchCount,
+                             GroupCount,
+                             InputChannels,
+                             InputShape,
+                             KernelShape,
+                             DilationShape,
+                             Padding,
+                             StrideShape,
+                             OutputShape,
+                             FilterCount,
+                             &WorkingBufferSize);
+
+    size_t OutputHeight = size_t(OutputHeight64);
+    size_t OutputWidth = size_t(OutputWidth64);
+
+    size_t InputSize = InputHeight * InputWidth;
+    size_t KernelSize = KernelHeight * KernelWidth;
+    size_t OutputSize = OutputHeight * OutputWidth;
+
+    size_t InputBufferElements = BatchCount * GroupCount * InputChannels * InputSize;
+    size_t FilterBufferElements = GroupCount * InputChannels * FilterCount * KernelSize;
+    size_t BiasBufferElements = GroupCount * FilterCount;
+    size_t OutputBufferElements = BatchCount * GroupCount * FilterCount * OutputSize;
+
+    MatrixGuardBuffer<float> BufferInput(InputBufferElements, true);
+    MatrixGuardBuffer<float> BufferFilter(FilterBufferElements, true);
+    MatrixGuardBuffer<float> BufferBias(BiasBufferElements, true);
+    MatrixGuardBuffer<float> BufferOutput(OutputBufferElements, false);
+    MatrixGuardBuffer<float> BufferOutputReference(OutputBufferElements, false);
+
+    const float* Input = BufferInput.GetBuffer(InputBufferElements);
+    const float* Filter = BufferFilter.GetBuffer(FilterBufferElements);
+    const float* Bias = BufferBias.GetBuffer(BiasBufferElements);
+    float* Output = BufferOutput.GetBuffer(OutputBufferElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
+
+    MatrixGuardBuffer<float> BufferWorking(WorkingBufferSize, false);
+
+    MlasConvTranspose(&Parameters,
+                      Input,
+                      Filter,
+                      Bias,
+                      BufferWorking.GetBuffer(WorkingBufferSize),
+                      Output);
+
+    ReferenceConvTranspose2D(BatchCount,
+                             GroupCount,
+                             InputChannels,
+                             InputHeight, InputWidth,
+                             FilterCount,
+                             KernelHeight, KernelWidth,
+                             PaddingLeftHeight, PaddingLeftWidth,
+                             DilationHeight, DilationWidth,
+                             StrideHeight, StrideWidth,
+                             OutputHeight, OutputWidth,
+                             Input,
+                             Filter,
+                             Bias,
+                             OutputReference);
+
+    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+        printf("mismatch convtranspose: batch=%zd,group=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd)!!!\n",
+            BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
+            KernelHeight, KernelWidth);
+    }
+
+    //
+    // Verify the algorithms that can be selected in place of the prepared
+    // algorithm produce the same output.
+    //
+
+    static const MLAS_CONV_TRANSPOSE_ALGORITHM Algorithms[] = {
+        MlasConvTransposeAlgorithmGemmThenCol2Im,
+        MlasConvTransposeAlgorithmDirectStride2,
+    };
+
+    for (size_t i = 0; i < _countof(Algorithms); i++) {
+
+        if (Algorithms[i] == Parameters.Algorithm ||
+            !MlasConvTransposeSetAlgorithm(&Parameters, Algorithms[i], &WorkingBufferSize)) {
+            continue;
+        }
+
+        MatrixGuardBuffer<float> BufferAlgorithmWorking(WorkingBufferSize, false);
+
+        MlasConvTranspose(&Parameters,
+                          Input,
+                          Filter,
+                          Bias,
+                          BufferAlgorithmWorking.GetBuffer(WorkingBufferSize),
+                          Output);
+
+        if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+            printf("mismatch convtranspose algorithm %d: batch=%zd,group=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd)!!!\n",
+                int(Algorithms[i]), BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
+                KernelHeight, KernelWidth);
+        }
+    }
+}
+
+void
+ExecuteConvTransposeTests(
+    void
+    )
+{
+    static const unsigned cs[] = { 32, 3, 1 };
+    static const unsigned is[] = { 17, 8, 5, 1 };
+
+    for (unsigned i = 1; i < 128; i <<= 1) {
+        TrialConvTranspose2D(1, 1, 16, i, i, 32, 3, 3, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0);
+        TrialConvTranspose2D(1, 1, 16, i, i, 32, 2, 2, 0, 0, 0, 0, 1, 1, 2, 2, 0, 0);
+        TrialConvTranspose2D(1, 1, 16, i, i, 32, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2, 1, 1);
+        TrialConvTranspose2D(1, 1, 64, i, i, 32, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2, 1, 1);
+        TrialConvTranspose2D(1, 1, 16, i, i, 32, 4, 4, 1, 1, 1, 1, 1, 1, 2, 2, 0, 0);
+    }
+
+    for (unsigned b = 1; b < 8; b++) {
+        TrialConvTranspose2D(b, 1, 8, 7, 9, 4, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2, 1, 1);
+        TrialConvTranspose2D(b, 32, 1, 7, 9, 1, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2, 1, 1);
+        TrialConvTranspose2D(b, 4, 6, 7, 9, 5, 2, 3, 0, 1, 0, 0, 1, 1, 2, 2, 0, 1);
+    }
+
+    for (unsigned ic = 0; ic < _countof(cs); ic++) {
+        for (unsigned ih = 0; ih < _countof(is); ih++) {
+            for (unsigned iw = 0; iw < _countof(is); iw++) {
+                fprintf(stderr, "Handling convtranspose %dx%dx%d\n", cs[ic], is[ih], is[iw]);
+                for (unsigned fc = 0; fc < _countof(cs); fc++) {
+                    for (unsigned kh = 1; kh <= 4; kh++) {
+                        for (unsigned kw = 1; kw <= 4; kw++) {
+                            for (unsigned p0 = 0; p0 < 2; p0++) {
+                                for (unsigned p1 = 0; p1 < 2; p1++) {
+                                    for (unsigned p2 = 0; p2 < 3; p2 += 2) {
+                                        for (unsigned p3 = 0; p3 < 3; p3 += 2) {
+                                            for (unsigned dh = 1; dh <= 2; dh++) {
+                                                for (unsigned sh = 1; sh <= 3; sh++) {
+                                                    for (unsigned sw = 1; sw <= 3; sw++) {
+                                                        TrialConvTranspose2D(1, 1, cs[ic], is[ih], is[iw], cs[fc], kh, kw, p0, p1, p2, p3, dh, 1, sh, sw, sh - 1, 0);
+                                                    }
+                                                }
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+EvaluateConvTransposePerformance(
+    void
+    )
+{
+    //
+    // Shapes of upsampling layers: batch, group, input channels per group,
+    // input size, filter count per group, kernel size, padding, output padding.
+    //
+
+    static const size_t shapes[][8] = {
+        { 1, 1, 256, 32, 128, 2, 0, 0 },
+        { 1, 1, 64, 64, 32, 3, 1, 1 },
+        { 1, 1, 16, 64, 16, 3, 1, 1 },
+        { 1, 1, 4, 128, 4, 2, 0, 0 },
+        { 1, 64, 1, 64, 1, 3, 1, 1 },
+        { 1, 21, 1, 64, 1, 2, 0, 0 },
+    };
+
+    for (size_t s = 0; s < _countof(shapes); s++) {
+
+        const size_t BatchCount = shapes[s][0];
+        const size_t GroupCount = shapes[s][1];
+        const size_t InputChannels = shapes[s][2];
+        const size_t InputLength = shapes[s][3];
+        const size_t FilterCount = shapes[s][4];
+        const size_t KernelLength = shapes[s][5];
+        const size_t PaddingLength = shapes[s][6];
+        const size_t OutputLength = (InputLength - 1) * 2 + KernelLength + shapes[s][7] - 2 * PaddingLength;
+
+        int64_t InputShape[] = { int64_t(InputLength), int64_t(InputLength) };
+        int64_t KernelShape[] = { int64_t(KernelLength), int64_t(KernelLength) };
+        int64_t DilationShape[] = { 1, 1 };
+        int64_t Padding[] = { int64_t(PaddingLength), int64_t(PaddingLength), int64_t(PaddingLength), int64_t(PaddingLength) };
+        int64_t StrideShape[] = { 2, 2 };
+        int64_t OutputShape[] = { int64_t(OutputLength), int64_t(OutputLength) };
+
+        size_t InputBufferElements = BatchCount * GroupCount * InputChannels * InputLength * InputLength;
+        size_t FilterBufferElements = GroupCount * InputChannels * FilterCount * KernelLength * KernelLength;
+        size_t BiasBufferElements = GroupCount * FilterCount;
+        size_t OutputBufferElements = BatchCount * GroupCount * FilterCount * OutputLength * OutputLength;
+
+        MatrixGuardBuffer<float> BufferInput(InputBufferElements, true);
+        MatrixGuardBuffer<float> BufferFilter(FilterBufferElements, true);
+        MatrixGuardBuffer<float> BufferBias(BiasBufferElements, true);
+        MatrixGuardBuffer<float> BufferOutput(OutputBufferElements, false);
+
+        const float* Input = BufferInput.GetBuffer(InputBufferElements);
+        const float* Filter = BufferFilter.GetBuffer(FilterBufferElements);
+        const float* Bias = BufferBias.GetBuffer(BiasBufferElements);
+        float* Output = BufferOutput.GetBuffer(OutputBufferElements);
+
+        //
+        // Run enough iterations to perform roughly the same number of
+        // multiplies for each shape.
+        //
+
+        const size_t Multiplies = InputBufferElements * FilterCount * KernelLength * KernelLength;
+        const size_t Iterations = std::max(size_t(4), size_t(1ull * 1024 * 1024 * 1024 / Multiplies));
+        const double Operations = 2.0 * double(Multiplies) * double(Iterations);
+
+        static const MLAS_CONV_TRANSPOSE_ALGORITHM Algorithms[] = {
+            MlasConvTransposeAlgorithmGemmThenCol2Im,
+            MlasConvTransposeAlgorithmDirectStride2,
+        };
+
+        printf("convtranspose %zd,%zd,%zd,%zd,%zd,%zd:", BatchCount, GroupCount, InputChannels,
+            InputLength, FilterCount, KernelLength);
+
+        for (size_t i = 0; i < _countof(Algorithms); i++) {
+
+            MLAS_CONV_TRANSPOSE_PARAMETERS Parameters;
+            size_t WorkingBufferSize;
+
+            MlasConvTransposePrepare(&Parameters, BatchCount, GroupCount, InputChannels, InputShape,
+                KernelShape, DilationShape, Padding, StrideShape, OutputShape, FilterCount,
+                &WorkingBufferSize);
+
+            const bool Prepared = (Parameters.Algorithm == Algorithms[i]);
+
+            MlasConvTransposeSetAlgorithm(&Parameters, Algorithms[i], &WorkingBufferSize);
+
+            MatrixGuardBuffer<float> BufferWorking(WorkingBufferSize, false);
+            float* WorkingBuffer = BufferWorking.GetBuffer(WorkingBufferSize);
+
+            auto start = std::chrono::high_resolution_clock::now();
+            for (size_t n = 0; n < Iterations; n++) {
+                MlasConvTranspose(&Parameters, Input, Filter, Bias, WorkingBuffer, Output);
+            }
+            std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+            printf(" algorithm %d%s %.2f gflops", int(Algorithms[i]), Prepared ? "*" : "",
+                Operations / elapsed.count() * 1e-9);
+        }
+
+        printf("\n");
+    }
+}
+
 void
 ReferenceMaximumPool2D(
     const int64_t* InputShape,
@@ -963,9 +2099,9 @@ TrialPool2D(
     size_t InputBufferElements = size_t(InputShape[0] * InputShape[1] * InputShape[2] * InputShape[3]);
     size_t OutputBufferElements = size_t(OutputShape[0] * OutputShape[1] * OutputShape[2] * OutputShape[3]);
 
-    MatrixGuardBuffer BufferInput(InputBufferElements, true);
-    MatrixGuardBuffer BufferOutput(OutputBufferElements, false);
-    MatrixGuardBuffer BufferOutputReference(OutputBufferElements, false);
+    MatrixGuardBuffer<float> BufferInput(InputBufferElements, true);
+    MatrixGuardBuffer<float> BufferOutput(OutputBufferElements, false);
+    MatrixGuardBuffer<float> BufferOutputReference(OutputBufferElements, false);
 
     const float* Input = BufferInput.GetBuffer(InputBufferElements);
     float* Output = BufferOutput.GetBuffer(OutputBufferElements);
@@ -1030,9 +2166,9 @@ TrialPool3D(
     size_t InputBufferElements = size_t(InputShape[0] * InputShape[1] * InputShape[2] * InputShape[3] * InputShape[4]);
     size_t OutputBufferElements = size_t(OutputShape[0] * OutputShape[1] * OutputShape[2] * OutputShape[3] * OutputShape[4]);
 
-    MatrixGuardBuffer BufferInput(InputBufferElements, true);
-    MatrixGuardBuffer BufferOutput(OutputBufferElements, false);
-    MatrixGuardBuffer BufferOutputReference(OutputBufferElements, false);
+    MatrixGuardBuffer<float> BufferInput(InputBufferElements, true);
+    MatrixGuardBuffer<float> BufferOutput(OutputBufferElements, false);
+    MatrixGuardBuffer<float> BufferOutputReference(OutputBufferElements, false);
 
     const float* Input = BufferInput.GetBuffer(InputBufferElements);
     float* Output = BufferOutput.GetBuffer(OutputBufferElements);
@@ -1164,9 +2300,9 @@ EvaluateThreadingPerformance(
 
     const size_t MaximumDimension = 4096;
 
-    MatrixGuardBuffer BufferA(MaximumDimension, true);
-    MatrixGuardBuffer BufferB(MaximumDimension, true);
-    MatrixGuardBuffer BufferC(MaximumDimension, false);
+    MatrixGuardBuffer<float> BufferA(MaximumDimension, true);
+    MatrixGuardBuffer<float> BufferB(MaximumDimension, true);
+    MatrixGuardBuffer<float> BufferC(MaximumDimension, false);
 
     for (size_t M = 16; M <= MaximumDimension; M <<= 1) {
         for (size_t N = 16; N <= MaximumDimension; N <<= 1) {
@@ -1235,7 +2371,14 @@ main(
     )
 {
 //    ExecuteSgemmTests();
+    ExecuteQgemmTests();
+    EvaluateQgemmPerformance();
+    ExecuteQuantizeLinearTests();
+    ExecuteHalfConvertTests();
+    ExecuteComputeTests();
     ExecuteConvTests();
+    ExecuteConvTransposeTests();
+    EvaluateConvTransposePerformance();
 //    ExecutePool2DTests();
 //    ExecutePool3DTests();
 //    EvaluateThreadingPerformance();
@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/graph/constants.h>
+#include <core/framework/allocator.h>
+#include <core/framework/ml_value.h>
+#include <core/framework/tensor.h>
+#include <core/session/inference_session.h>
+
+#include <random>
+#include <sstream>
+
+using namespace onnxruntime;
+
+namespace {
+
+void AddFloatInitializer(ONNX_NAMESPACE::GraphProto& graph, const std::string& name,
+                         const std::vector<int64_t>& dims, std::mt19937& rng) {
+  std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+  auto* initializer = graph.add_initializer();
+  initializer->set_name(name);
+  initializer->set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  int64_t size = 1;
+  for (auto dim : dims) {
+    initializer->add_dims(dim);
+    size *= dim;
+  }
+  for (int64_t i = 0; i < size; ++i) {
+    initializer->add_float_data(dist(rng));
+  }
+}
+
+// a single forward LSTM (op_type LSTM) or GRU node, or the quantized contrib version of it
+ONNX_NAMESPACE::ModelProto MakeModel(const std::string& op_type, const std::string& domain, int num_gates,
+                                     int64_t input_size, int64_t hidden_size) {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  auto* opset = model.add_opset_import();
+  opset->set_domain(kOnnxDomain);
+  opset->set_version(7);
+  opset = model.add_opset_import();
+  opset->set_domain(kMSDomain);
+  opset->set_version(1);
+
+  auto* graph = model.mutable_graph();
+  graph->set_name("rnn");
+  auto* node = graph->add_node();
+  node->set_op_type(op_type);
+  node->set_domain(domain);
+  node->add_input("X");
+  node->add_input("W");
+  node->add_input("R");
+  node->add_output("Y");
+
+  auto* attr = node->add_attribute();
+  attr->set_name("hidden_size");
+  attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+  attr->set_i(hidden_size);
+  attr = node->add_attribute();
+  attr->set_name("direction");
+  attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_STRING);
+  attr->set_s("forward");
+  if (num_gates == 3) {
+    attr = node->add_attribute();
+    attr->set_name("linear_before_reset");
+    attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+    attr->set_i(0);
+  }
+
+  std::mt19937 rng(42);
+  AddFloatInitializer(*graph, "W", {1, num_gates * hidden_size, input_size}, rng);
+  AddFloatInitializer(*graph, "R", {1, num_gates * hidden_size, hidden_size}, rng);
+
+  auto* input = graph->add_input();
+  input->set_name("X");
+  input->mutable_type()->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  auto* output = graph->add_output();
+  output->set_name("Y");
+  output->mutable_type()->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  return model;
+}
+
+void RunRnn(benchmark::State& state, const std::string& op_type, const std::string& domain, int num_gates) {
+  const int64_t seq_length = 50;
+  const int64_t batch_size = state.range(0);
+  const int64_t input_size = state.range(1);
+  const int64_t hidden_size = state.range(1);
+
+  SessionOptions so;
+  so.session_logid = op_type;
+  InferenceSession session{so};
+  std::stringstream model_stream;
+  MakeModel(op_type, domain, num_gates, input_size, hidden_size).SerializeToOstream(&model_stream);
+  auto status = session.Load(model_stream);
+  if (status.IsOK()) status = session.Initialize();
+  if (!status.IsOK()) {
+    state.SkipWithError(status.ErrorMessage().c_str());
+    return;
+  }
+
+  AllocatorPtr alloc = std::make_shared<CPUAllocator>();
+  TensorShape shape({seq_length, batch_size, input_size});
+  void* buffer = alloc->Alloc(sizeof(float) * shape.Size());
+  auto p_tensor = std::make_unique<Tensor>(DataTypeImpl::GetType<float>(), shape, buffer, alloc->Info(), alloc);
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  float* data = p_tensor->MutableData<float>();
+  for (int64_t i = 0; i < shape.Size(); ++i) {
+    data[i] = dist(rng);
+  }
+  MLValue input;
+  input.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(), DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+
+  NameMLValMap feeds{{"X", input}};
+  std::vector<std::string> output_names{"Y"};
+
+  for (auto _ : state) {
+    std::vector<MLValue> fetches;
+    status = session.Run(feeds, output_names, &fetches);
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+      return;
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * seq_length * batch_size));
+}
+
+}  // namespace
+
+static void BM_LSTM(benchmark::State& state) {
+  RunRnn(state, "LSTM", kOnnxDomain, 4);
+}
+BENCHMARK(BM_LSTM)->Args({1, 256})->Args({1, 512})->Args({16, 512});
+
+static void BM_DynamicQuantizeLSTM(benchmark::State& state) {
+  RunRnn(state, "DynamicQuantizeLSTM", kMSDomain, 4);
+}
+BENCHMARK(BM_DynamicQuantizeLSTM)->Args({1, 256})->Args({1, 512})->Args({16, 512});
+
+static void BM_GRU(benchmark::State& state) {
+  RunRnn(state, "GRU", kOnnxDomain, 3);
+}
+BENCHMARK(BM_GRU)->Args({1, 256})->Args({1, 512})->Args({16, 512});
+
+static void BM_DynamicQuantizeGRU(benchmark::State& state) {
+  RunRnn(state, "DynamicQuantizeGRU", kMSDomain, 3);
+}
+BENCHMARK(BM_DynamicQuantizeGRU)->Args({1, 256})->Args({1, 512})->Args({16, 512});
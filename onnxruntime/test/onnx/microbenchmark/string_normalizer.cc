@@ -0,0 +1,143 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/graph/constants.h>
+#include <core/framework/allocator.h>
+#include <core/framework/ml_value.h>
+#include <core/framework/tensor.h>
+#include <core/session/inference_session.h>
+
+#include <random>
+#include <sstream>
+
+using namespace onnxruntime;
+
+namespace {
+
+// Words from several scripts so that both the ASCII and the table driven paths are exercised
+const char* const kWords[] = {
+    "The", "QUICK", "brown", "Fox", "jumps", "OVER", "the", "lazy", "dog", "Monday",
+    u8"École", u8"Straße", u8"Ñandú", u8"ÇA", u8"Œuvre",
+    u8"Москва", u8"ПРИВЕТ", u8"мир", u8"Αθήνα", u8"ΚΑΛΗΜΕΡΑ",
+    u8"中文", u8"東京", u8"한국어", u8"Ärger", u8"İstanbul"};
+
+std::vector<std::string> MakeCorpus(size_t count, size_t words_per_string) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<size_t> pick(0, sizeof(kWords) / sizeof(kWords[0]) - 1);
+  std::vector<std::string> corpus(count);
+  for (auto& s : corpus) {
+    for (size_t w = 0; w < words_per_string; ++w) {
+      if (w > 0) s += ' ';
+      s += kWords[pick(rng)];
+    }
+  }
+  return corpus;
+}
+
+ONNX_NAMESPACE::ModelProto MakeModel(const std::string& casechangeaction, bool is_case_sensitive,
+                                     const std::vector<std::string>& stopwords) {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  auto* opset = model.add_opset_import();
+  opset->set_domain(kOnnxDomain);
+  opset->set_version(9);
+  opset = model.add_opset_import();
+  opset->set_domain(kMSDomain);
+  opset->set_version(1);
+
+  auto* graph = model.mutable_graph();
+  graph->set_name("string_normalizer");
+  auto* node = graph->add_node();
+  node->set_op_type("StringNormalizer");
+  node->set_domain(kMSDomain);
+  node->add_input("X");
+  node->add_output("Y");
+
+  auto* attr = node->add_attribute();
+  attr->set_name("casechangeaction");
+  attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_STRING);
+  attr->set_s(casechangeaction);
+  attr = node->add_attribute();
+  attr->set_name("is_case_sensitive");
+  attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+  attr->set_i(is_case_sensitive ? 1 : 0);
+  if (!stopwords.empty()) {
+    attr = node->add_attribute();
+    attr->set_name("stopwords");
+    attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_STRINGS);
+    for (const auto& sw : stopwords) {
+      attr->add_strings(sw);
+    }
+  }
+
+  auto* input = graph->add_input();
+  input->set_name("X");
+  input->mutable_type()->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_STRING);
+  auto* output = graph->add_output();
+  output->set_name("Y");
+  output->mutable_type()->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_STRING);
+  return model;
+}
+
+void RunStringNormalizer(benchmark::State& state, const std::string& casechangeaction, bool is_case_sensitive,
+                         const std::vector<std::string>& stopwords) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  const auto corpus = MakeCorpus(count, 8);
+
+  SessionOptions so;
+  so.session_logid = "StringNormalizer";
+  InferenceSession session{so};
+  std::stringstream model_stream;
+  MakeModel(casechangeaction, is_case_sensitive, stopwords).SerializeToOstream(&model_stream);
+  auto status = session.Load(model_stream);
+  if (status.IsOK()) status = session.Initialize();
+  if (!status.IsOK()) {
+    state.SkipWithError(status.ErrorMessage().c_str());
+    return;
+  }
+
+  AllocatorPtr alloc = std::make_shared<CPUAllocator>();
+  auto element_type = DataTypeImpl::GetType<std::string>();
+  TensorShape shape({static_cast<int64_t>(count)});
+  void* buffer = alloc->Alloc(element_type->Size() * count);
+  auto p_tensor = std::make_unique<Tensor>(element_type, shape, buffer, alloc->Info(), alloc);
+  std::copy(corpus.cbegin(), corpus.cend(), p_tensor->MutableData<std::string>());
+  MLValue input;
+  input.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(), DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+
+  NameMLValMap feeds{{"X", input}};
+  std::vector<std::string> output_names{"Y"};
+  size_t bytes = 0;
+  for (const auto& s : corpus) {
+    bytes += s.size();
+  }
+
+  for (auto _ : state) {
+    std::vector<MLValue> fetches;
+    status = session.Run(feeds, output_names, &fetches);
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+      return;
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+}  // namespace
+
+static void BM_StringNormalizerLower(benchmark::State& state) {
+  RunStringNormalizer(state, "LOWER", true, {});
+}
+BENCHMARK(BM_StringNormalizerLower)->Arg(1000)->Arg(100000);
+
+static void BM_StringNormalizerUpperStopwords(benchmark::State& state) {
+  RunStringNormalizer(state, "UPPER", true, {"The QUICK", u8"Москва мир"});
+}
+BENCHMARK(BM_StringNormalizerUpperStopwords)->Arg(1000)->Arg(100000);
+
+static void BM_StringNormalizerCaseInsensitiveStopwords(benchmark::State& state) {
+  RunStringNormalizer(state, "NONE", false, {"the quick", u8"москва мир"});
+}
+BENCHMARK(BM_StringNormalizerCaseInsensitiveStopwords)->Arg(1000)->Arg(100000);
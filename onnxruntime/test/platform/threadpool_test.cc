@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/platform/threadpool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace concurrency {
+namespace test {
+
+static void RunParallelForAndCheck(ThreadPool* tp, std::ptrdiff_t total, double cost_per_unit) {
+  std::vector<std::atomic<int>> hits(total);
+  for (auto& hit : hits) {
+    hit = 0;
+  }
+
+  ThreadPool::TryParallelFor(tp, total, cost_per_unit, [&hits](std::ptrdiff_t first, std::ptrdiff_t last) {
+    ASSERT_LE(first, last);
+    for (std::ptrdiff_t i = first; i < last; ++i) {
+      hits[i]++;
+    }
+  });
+
+  for (std::ptrdiff_t i = 0; i < total; ++i) {
+    ASSERT_EQ(hits[i], 1) << "index " << i << " of " << total;
+  }
+}
+
+TEST(ThreadPoolTest, ParallelForCoversRangeOnce) {
+  ThreadPool tp("test", 4);
+  for (std::ptrdiff_t total : {1, 2, 3, 7, 64, 1000, 4097}) {
+    RunParallelForAndCheck(&tp, total, 1);
+    RunParallelForAndCheck(&tp, total, 1e6);
+  }
+}
+
+TEST(ThreadPoolTest, TryParallelForWithoutPool) {
+  RunParallelForAndCheck(nullptr, 100, 1e6);
+
+  int calls = 0;
+  ThreadPool::TryParallelFor(nullptr, 0, 1e6, [&calls](std::ptrdiff_t, std::ptrdiff_t) { ++calls; });
+  EXPECT_EQ(calls, 0);
+}
+
+TEST(ThreadPoolTest, ComputeNumBlocks) {
+  // cheap loops stay on the calling thread
+  EXPECT_EQ(ThreadPool::ComputeNumBlocks(4, 1000, 1), 1);
+  // expensive loops are split into several blocks per thread, but never more blocks than iterations
+  EXPECT_GT(ThreadPool::ComputeNumBlocks(4, 1000, 1e6), 5);
+  EXPECT_EQ(ThreadPool::ComputeNumBlocks(4, 3, 1e6), 3);
+  // no worker threads means no splitting
+  EXPECT_EQ(ThreadPool::ComputeNumBlocks(0, 1000, 1e6), 1);
+}
+
+TEST(ThreadPoolTest, NestedParallelFor) {
+  ThreadPool tp("test", 2);
+  std::atomic<int64_t> sum{0};
+  tp.ParallelFor(8, 1e6, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t i = first; i < last; ++i) {
+      tp.ParallelFor(100, 1e6, [&](std::ptrdiff_t inner_first, std::ptrdiff_t inner_last) {
+        sum += inner_last - inner_first;
+      });
+    }
+  });
+  EXPECT_EQ(sum, 800);
+}
+
+TEST(ThreadPoolTest, ParallelForPropagatesException) {
+  ThreadPool tp("test", 2);
+  EXPECT_THROW(tp.ParallelFor(100, 1e6,
+                              [](std::ptrdiff_t first, std::ptrdiff_t) {
+                                if (first == 0) throw std::runtime_error("failed");
+                              }),
+               std::runtime_error);
+}
+
+}  // namespace test
+}  // namespace concurrency
+}  // namespace onnxruntime
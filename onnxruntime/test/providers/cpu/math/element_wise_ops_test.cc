@@ -41,6 +41,14 @@ TEST(MathOpTest, Add) {
   test.Run();
 }
 
+TEST(MathOpTest, Add_Float16_Broadcast) {
+  OpTester test("Add");
+  test.AddInput<MLFloat16>("A", {2, 3}, FloatsToMLFloat16s({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}));
+  test.AddInput<MLFloat16>("B", {3}, FloatsToMLFloat16s({0.5f, -2.0f, 1024.0f}));
+  test.AddOutput<MLFloat16>("C", {2, 3}, FloatsToMLFloat16s({1.5f, 0.0f, 1027.0f, 4.5f, 3.0f, 1030.0f}));
+  test.Run();
+}
+
 TEST(MathOpTest, Add_Broadcast_Axis) {
   OpTester test("Add");
 
@@ -237,6 +245,14 @@ TEST(MathOpTest, Mul) {
   test.Run();
 }
 
+TEST(MathOpTest, Mul_Float16) {
+  OpTester test("Mul");
+  test.AddInput<MLFloat16>("A", {2, 2}, FloatsToMLFloat16s({1.0f, -2.0f, 0.25f, 100.0f}));
+  test.AddInput<MLFloat16>("B", {2, 2}, FloatsToMLFloat16s({3.0f, 4.0f, -8.0f, 0.5f}));
+  test.AddOutput<MLFloat16>("C", {2, 2}, FloatsToMLFloat16s({3.0f, -8.0f, -2.0f, 50.0f}));
+  test.Run();
+}
+
 TEST(MathOpTest, Div_int32) {
   OpTester test("Div");
   test.AddInput<int32_t>("A", {3}, {4, 8, 8});
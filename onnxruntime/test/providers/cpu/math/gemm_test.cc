@@ -26,6 +26,25 @@ TEST(MathOpTest, GemmNoTrans) {
   test.Run();
 }
 
+TEST(MathOpTest, GemmNoTrans_Float16) {
+  OpTester test("Gemm");
+
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)0);
+  test.AddAttribute("alpha", 1.0f);
+  test.AddAttribute("beta", 1.0f);
+
+  test.AddInput<MLFloat16>("A", {2, 4},
+                           FloatsToMLFloat16s({1.0f, 2.0f, 3.0f, 4.0f,
+                                               -1.0f, -2.0f, -3.0f, -4.0f}));
+  test.AddInput<MLFloat16>("B", {4, 3}, FloatsToMLFloat16s(std::vector<float>(12, 1.0f)));
+  test.AddInput<MLFloat16>("C", {3}, FloatsToMLFloat16s({1.0f, 2.0f, 3.0f}));
+  test.AddOutput<MLFloat16>("Y", {2, 3},
+                            FloatsToMLFloat16s({11.0f, 12.0f, 13.0f,
+                                                -9.0f, -8.0f, -7.0f}));
+  test.Run();
+}
+
 TEST(MathOpTest, GemmBroadcast) {
   OpTester test("Gemm");
 
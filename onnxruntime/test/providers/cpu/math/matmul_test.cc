@@ -77,5 +77,15 @@ TEST(MathOpTest, MatMul) {
   }
 }
 
+TEST(MathOpTest, MatMul_Float16) {
+  OpTester test("MatMul");
+  test.AddInput<MLFloat16>("A", {2, 2, 3}, FloatsToMLFloat16s({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}));
+  test.AddInput<MLFloat16>("B", {3, 4}, FloatsToMLFloat16s({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}));
+  test.AddOutput<MLFloat16>("Y", {2, 2, 4},
+                            FloatsToMLFloat16s({20, 23, 26, 29, 56, 68, 80, 92,
+                                                92, 113, 134, 155, 128, 158, 188, 218}));
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
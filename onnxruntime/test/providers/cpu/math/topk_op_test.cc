@@ -65,6 +65,15 @@ TEST(TopKOperator, TopAll) {
   RunTest(4, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions);
 }
 
+TEST(TopKOperator, TopKEmptyBatch) {
+  std::vector<float> input_vals = {};
+  std::vector<int64_t> input_dimensions = {0, 10};
+  std::vector<float> expected_vals = {};
+  std::vector<int64_t> expected_indices = {};
+  std::vector<int64_t> expected_dimensions = {0, 3};
+  RunTest(3, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions);
+}
+
 TEST(TopKOperator, InvalidK) {
   std::vector<float> input_vals = {0.1f, 0.3f, 0.2f, 0.4f, 0.1f, 0.3f, 0.3f, 0.2f};
   std::vector<int64_t> input_dimensions = {2, 4};
@@ -82,5 +91,45 @@ TEST(TopKOperator, InvalidK) {
           "Invalid value for attribute k");
 }
 
+TEST(TopKOperator, TopKOuterAxis) {
+  std::vector<float> input_vals = {0.1f, 0.3f, 0.2f, 0.4f, 0.1f, 0.3f,
+                                   0.3f, 0.2f, 0.2f, 0.4f, 0.5f, 0.1f};
+  std::vector<int64_t> input_dimensions = {2, 3, 2};
+  std::vector<float> expected_vals = {0.3f, 0.3f, 0.2f, 0.4f, 0.5f, 0.3f};
+  std::vector<int64_t> expected_indices = {1, 0, 0, 0, 1, 0};
+  std::vector<int64_t> expected_dimensions = {1, 3, 2};
+  RunTest(1, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, 0);
+}
+
+TEST(TopKOperator, TopKMiddleAxis) {
+  std::vector<float> input_vals = {0.1f, 0.3f, 0.2f, 0.4f, 0.1f, 0.3f,
+                                   0.3f, 0.2f, 0.2f, 0.4f, 0.5f, 0.1f};
+  std::vector<int64_t> input_dimensions = {2, 3, 2};
+  std::vector<float> expected_vals = {0.2f, 0.4f, 0.1f, 0.3f,
+                                      0.5f, 0.4f, 0.3f, 0.2f};
+  std::vector<int64_t> expected_indices = {1, 1, 0, 0,
+                                           2, 1, 0, 0};
+  std::vector<int64_t> expected_dimensions = {2, 2, 2};
+  RunTest(2, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, -2);
+}
+
+TEST(TopKOperator, TopKLargeRowWithTies) {
+  // a single row long enough to be split across threads, where the largest value is repeated
+  const int64_t n = 40000;
+  const int64_t k = 5;
+  std::vector<float> input_vals(n);
+  for (int64_t i = 0; i < n; ++i) {
+    input_vals[i] = static_cast<float>((i * 7919) % 1000);
+  }
+  std::vector<float> expected_vals(k, 999.0f);
+  std::vector<int64_t> expected_indices;
+  for (int64_t i = 0; i < n && static_cast<int64_t>(expected_indices.size()) < k; ++i) {
+    if (input_vals[i] == 999.0f) {
+      expected_indices.push_back(i);
+    }
+  }
+  RunTest(k, input_vals, {1, n}, expected_vals, expected_indices, {1, k});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -164,6 +164,17 @@ TEST(ConvTest, Conv2D_1) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, false, true);  // asymmetric padding is not supported by cudnn
 }
 
+TEST(ConvTest, Conv2D_Float16) {
+  OpTester test("Conv");
+  test.AddAttribute("kernel_shape", vector<int64_t>{2, 2});
+  test.AddAttribute("strides", vector<int64_t>{1, 1});
+  test.AddInput<MLFloat16>("X", {1, 1, 3, 3}, FloatsToMLFloat16s({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  test.AddInput<MLFloat16>("W", {1, 1, 2, 2}, FloatsToMLFloat16s({1, 1, 1, 1}));
+  test.AddInput<MLFloat16>("B", {1}, FloatsToMLFloat16s({1}));
+  test.AddOutput<MLFloat16>("Y", {1, 1, 2, 2}, FloatsToMLFloat16s({13, 17, 25, 29}));
+  test.Run();
+}
+
 TEST(ConvTest, Conv1D_Invalid_Input_Shape) {
   ConvOpAttributes attrs = {
       "",                     // auto_pad
@@ -40,5 +40,36 @@ TEST(RoIPoolTest, MaxRoiPool) {
   test.Run();
 }
 
+TEST(RoIPoolTest, MaxRoiPool_WideBins) {
+  OpTester test("MaxRoiPool");
+
+  const int64_t pooled_height = 2, pooled_width = 2;
+  test.AddAttribute("pooled_shape", std::vector<int64_t>{pooled_height, pooled_width});
+
+  const int H = 4, W = 20;
+  const int input_channels = 2;
+  std::vector<float> input;
+  for (int i = 0; i < input_channels * H * W; i++)
+    input.push_back(static_cast<float>((i * 37) % 101));
+  std::vector<float> rois = {
+      0, 0, 0, 19, 3,
+      0, 2, 1, 12, 2};
+
+  std::vector<int64_t> x_dims = {1, input_channels, H, W};
+
+  test.AddInput<float>("X", x_dims, input);
+  std::vector<int64_t> rois_dims = {2, 5};
+  test.AddInput<float>("rois", rois_dims, rois);
+
+  const std::vector<float> expected_vals = {
+      94, 100, 99, 95,
+      94, 98, 97, 100,
+      90, 100, 86, 96,
+      84, 94, 80, 100};
+  std::vector<int64_t> expected_dims = {2, input_channels, pooled_height, pooled_width};
+  test.AddOutput<float>("Y", expected_dims, expected_vals);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -109,6 +109,36 @@ TEST(PoolTest, MaxPool_8_With_Index) {
   MaxPool_8_WithIndexTest(true, 1 /*storage_order*/);  // col major
 }
 
+static void MaxPool_8_WithIndexTiesTest(int64_t storage_order) {
+  OpTester test("MaxPool", 8);
+
+  test.AddAttribute("auto_pad", "");
+  test.AddAttribute("strides", std::vector<int64_t>{1, 1});
+  test.AddAttribute("pads", vector<int64_t>{0, 0, 0, 0});
+  test.AddAttribute("kernel_shape", vector<int64_t>{2, 2});
+  test.AddAttribute("storage_order", storage_order);
+
+  // every window holds the maximum more than once, the index is the first one in row major order
+  std::vector<float> x_vals = {1, 3, 3,
+                               2, 3, 1,
+                               0, 1, 2};
+  std::vector<int64_t> x_dims = {1, 1, 3, 3};
+  std::vector<int64_t> expected_dims = {1, 1, 2, 2};
+  std::vector<float> expected_vals = {3, 3, 3, 3};
+  std::vector<int64_t> expected_indices_row = {1, 1, 4, 4};
+  std::vector<int64_t> expected_indices_col = {3, 3, 4, 4};
+
+  test.AddInput<float>("X", x_dims, x_vals);
+  test.AddOutput<float>("Y", expected_dims, expected_vals);
+  test.AddOutput<int64_t>("Indices", expected_dims, storage_order == 0 ? expected_indices_row : expected_indices_col);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kMklDnnExecutionProvider});
+}
+
+TEST(PoolTest, MaxPool_8_With_Index_Ties) {
+  MaxPool_8_WithIndexTiesTest(0 /*storage_order*/);
+  MaxPool_8_WithIndexTiesTest(1 /*storage_order*/);
+}
+
 TEST(PoolTest, MaxPool1D) {
   OpTester test("MaxPool");
 
@@ -410,6 +440,26 @@ TEST(PoolTest, AveragePool_IncludePadPixel) {
   test.Run();
 }
 
+TEST(PoolTest, AveragePool1D_Pads) {
+  OpTester test("AveragePool");
+
+  test.AddAttribute("auto_pad", "");
+  test.AddAttribute("strides", std::vector<int64_t>{1});
+  test.AddAttribute("pads", vector<int64_t>{1, 1});
+  test.AddAttribute("kernel_shape", vector<int64_t>{3});
+
+  std::vector<float> x_vals = {1, 2, 3, 4, 5,
+                               2, 4, 6, 8, 10};
+  std::vector<int64_t> x_dims = {1, 2, 5};
+  std::vector<int64_t> expected_dims = {1, 2, 5};
+  std::vector<float> expected_vals = {1.5f, 2, 3, 4, 4.5f,
+                                      3, 4, 6, 8, 9};
+
+  test.AddInput<float>("X", x_dims, x_vals);
+  test.AddOutput<float>("Y", expected_dims, expected_vals);
+  test.Run();
+}
+
 TEST(PoolTest, GlobalAveragePool) {
   OpTester test("GlobalAveragePool");
 
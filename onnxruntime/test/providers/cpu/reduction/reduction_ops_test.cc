@@ -696,6 +696,49 @@ TEST(ReductionOpTest, ReduceSum_axes02) {
   test.Run();
 }
 
+TEST(ReductionOpTest, ReduceSum_middle_axis_wide) {
+  // the kept inner dimension spans several column blocks of the strided reduction
+  const int64_t outer = 2, reduced = 3, inner = 1100;
+  std::vector<float> input_data(outer * reduced * inner);
+  std::vector<float> expected_data(outer * inner, 0.0f);
+  for (int64_t o = 0; o < outer; ++o) {
+    for (int64_t r = 0; r < reduced; ++r) {
+      for (int64_t i = 0; i < inner; ++i) {
+        float value = static_cast<float>((o * 7 + r * 3 + i) % 11);
+        input_data[(o * reduced + r) * inner + i] = value;
+        expected_data[o * inner + i] += value;
+      }
+    }
+  }
+
+  OpTester test("ReduceSum");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {outer, reduced, inner}, input_data);
+  test.AddOutput<float>("reduced", {outer, inner}, expected_data);
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceMax_interleaved_axes) {
+  OpTester test("ReduceMax");
+  test.AddAttribute("axes", std::vector<int64_t>{0, 2});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {2, 2, 2, 2},
+                       {1.0f, 2.0f,
+                        3.0f, 4.0f,
+
+                        5.0f, 6.0f,
+                        7.0f, 8.0f,
+
+                        9.0f, 10.0f,
+                        11.0f, 12.0f,
+
+                        13.0f, 14.0f,
+                        15.0f, 16.0f});
+  test.AddOutput<float>("reduced", {2, 2}, {11.0f, 12.0f, 15.0f, 16.0f});
+  test.Run();
+}
+
 TEST(ReductionOpTest, ReduceSum_int32) {
   OpTester test("ReduceSum");
   test.AddAttribute("axes", std::vector<int64_t>{0, 2});
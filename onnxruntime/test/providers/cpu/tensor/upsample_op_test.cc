@@ -174,6 +174,33 @@ TEST(UpsampleOpTest, UpsampleOpNearest15XTest) {
   test.Run();
 }
 
+TEST(UpsampleOpTest, UpsampleOpNearest3XTest) {
+  OpTester test("Upsample");
+
+  std::vector<float> scales{1.0f, 1.0f, 1.0f, 3.0f};
+  test.AddAttribute("mode", "nearest");
+  test.AddAttribute("scales", scales);
+
+  const int64_t N = 1, C = 2, H = 2, W = 2;
+  std::vector<float> X = {1.0f, 3.0f,
+                          3.0f, 5.0f,
+
+                          3.0f, 5.0f,
+                          7.0f, 9.0f};
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+
+  std::vector<float> Y = {
+      1.0f, 1.0f, 1.0f, 3.0f, 3.0f, 3.0f,
+      3.0f, 3.0f, 3.0f, 5.0f, 5.0f, 5.0f,
+
+      3.0f, 3.0f, 3.0f, 5.0f, 5.0f, 5.0f,
+      7.0f, 7.0f, 7.0f, 9.0f, 9.0f, 9.0f};
+
+  test.AddOutput<float>("Y", {N, C, (int64_t)(H * scales[2]), (int64_t)(W * scales[3])}, Y);
+  test.Run();
+}
+
 TEST(UpsampleOpTest, UpsampleOpNearest2XTest_int32) {
   OpTester test("Upsample");
 
@@ -267,6 +294,35 @@ TEST(UpsampleOpTest, UpsampleOpBilinearTest2) {
   test.Run();
 }
 
+TEST(UpsampleOpTest, UpsampleOpBilinearTest_NonIntegerScale) {
+  OpTester test("Upsample");
+
+  std::vector<float> scales{1.0f, 1.0f, 1.5f, 3.0f};
+  test.AddAttribute("mode", "linear");
+  test.AddAttribute("scales", scales);
+
+  const int64_t N = 1, C = 2, H = 2, W = 2;
+  std::vector<float> X = {1.0f, 3.0f,
+                          4.0f, 8.0f,
+
+                          6.0f, 2.0f,
+                          7.0f, 11.0f};
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+
+  std::vector<float> Y = {
+      1.0f, 1.666667f, 2.333333f, 3.0f, 3.0f, 3.0f,
+      3.0f, 4.111111f, 5.222222f, 6.333333f, 6.333333f, 6.333333f,
+      4.0f, 5.333333f, 6.666667f, 8.0f, 8.0f, 8.0f,
+
+      6.0f, 4.666667f, 3.333333f, 2.0f, 2.0f, 2.0f,
+      6.666667f, 7.111111f, 7.555556f, 8.0f, 8.0f, 8.0f,
+      7.0f, 8.333333f, 9.666667f, 11.0f, 11.0f, 11.0f};
+
+  test.AddOutput<float>("Y", {N, C, (int64_t)(H * scales[2]), (int64_t)(W * scales[3])}, Y);
+  test.Run();
+}
+
 TEST(UpsampleOpTest, UpsampleOpBilinearTest_int32) {
   OpTester test("Upsample");
 
@@ -14,6 +14,7 @@
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/framework/data_types.h"
+#include "core/util/math.h"
 #include "test/test_environment.h"
 #include "test/framework/TestAllocatorManager.h"
 
@@ -108,6 +109,16 @@ struct TTypeProto : ONNX_NAMESPACE::TypeProto {
 template <typename T>
 const TTypeProto<T> s_type_proto;
 
+// Converts float values to float16, e.g. to set the inputs and expected outputs of float16 kernels.
+inline std::vector<MLFloat16> FloatsToMLFloat16s(const std::vector<float>& values) {
+  std::vector<MLFloat16> result;
+  result.reserve(values.size());
+  for (float value : values) {
+    result.push_back(MLFloat16(math::floatToHalf(value)));
+  }
+  return result;
+}
+
 //TypeProto for map<TKey, TVal>
 template <typename TKey, typename TVal>
 struct MTypeProto : ONNX_NAMESPACE::TypeProto {
@@ -5,6 +5,7 @@
 import unittest
 import os
 import sys
+import threading
 import numpy as np
 import onnxruntime as onnxrt
 from onnxruntime.capi._pybind_state import onnxruntime_ostream_redirect
@@ -72,6 +73,76 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[5.0], [11.0], [17.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def testRunModelNonContiguousInput(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        # transposed view, must be copied before it is fed
+        x = np.array([[1.0, 3.0, 5.0], [2.0, 4.0, 6.0]], dtype=np.float32).T
+        self.assertFalse(x.flags['C_CONTIGUOUS'])
+        res = sess.run(["Y"], {"X": x})
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+    def testRunModelOutputsAreIndependent(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        res1 = sess.run(["Y"], {"X": x})[0]
+        res1[:] = 0
+        res2 = sess.run(["Y"], {"X": x})[0]
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res2, rtol=1e-05, atol=1e-08)
+        np.testing.assert_allclose(np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32), x)
+
+    def testRunModelMultipleThreads(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        errors = []
+
+        def run(scale):
+            try:
+                x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32) * scale
+                for i in range(50):
+                    res = sess.run(["Y"], {"X": x})
+                    np.testing.assert_allclose(x * x, res[0], rtol=1e-05, atol=1e-08)
+            except Exception as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=run, args=(i + 1,)) for i in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(errors, [])
+
+    def testRunModelWithIOBinding(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        y = np.zeros((3, 2), dtype=np.float32)
+        binding = sess.io_binding()
+        binding.bind_input("X", x)
+        binding.bind_output("Y", y)
+        sess.run_with_iobinding(binding)
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, y, rtol=1e-05, atol=1e-08)
+        self.assertTrue(binding.get_outputs()[0] is y)
+
+        # the bound input is used in place
+        x *= 2
+        sess.run_with_iobinding(binding)
+        np.testing.assert_allclose(output_expected * 4, y, rtol=1e-05, atol=1e-08)
+
+        binding.clear_binding_outputs()
+        binding.bind_output("Y")
+        sess.run_with_iobinding(binding)
+        res = binding.get_outputs()
+        self.assertEqual(len(res), 1)
+        np.testing.assert_allclose(output_expected * 4, res[0], rtol=1e-05, atol=1e-08)
+
+    def testIOBindingOutputMustBeWriteable(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        binding = sess.io_binding()
+        y = np.zeros((2, 3), dtype=np.float32).T
+        with self.assertRaises(RuntimeError):
+            binding.bind_output("Y", y)
+
     def testRunDevice(self):
         device = onnxrt.get_device()
         self.assertTrue('CPU' in device or 'GPU' in device)
@@ -259,6 +330,24 @@ class TestInferenceSession(unittest.TestCase):
                                       [12., 15., 15., 15.,  8.]]]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0])
 
+    def testConvAutotune(self):
+        so = onnxrt.SessionOptions()
+        self.assertFalse(so.enable_conv_autotune)
+        so.enable_conv_autotune = True
+        sess = onnxrt.InferenceSession(self.get_name("conv_autopad.pb"), so)
+        x = np.array(25 * [1.0], dtype=np.float32).reshape((1,1,5,5))
+
+        output_expected = np.array([[[[24., 33., 33., 33., 20.],
+                                      [27., 36., 36., 36., 21.],
+                                      [27., 36., 36., 36., 21.],
+                                      [27., 36., 36., 36., 21.],
+                                      [12., 15., 15., 15.,  8.]]]], dtype=np.float32)
+
+        # The first run tunes the algorithm and later runs use the cached parameters.
+        for i in range(3):
+            res = sess.run(["Convolution5_Output_0"], {"Input4": x})
+            np.testing.assert_allclose(output_expected, res[0])
+
     def testZipMapStringFloat(self):
         sess = onnxrt.InferenceSession(self.get_name("zipmap_stringfloat.pb"))
         x = np.array([1.0, 0.0, 3.0, 44.0, 23.0, 11.0], dtype=np.float32).reshape((2,3))
@@ -355,6 +444,24 @@ class TestInferenceSession(unittest.TestCase):
                     self.assertTrue(tag in lines[i])
             self.assertTrue(']' in lines[8])
 
+    def testActivationStatistics(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        statistics = onnxrt.ActivationStatistics(num_bins=4)
+        sess.set_activation_observer(statistics)
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        sess.run([], {'X': x})
+        sess.run([], {'X': -x})
+        sess.set_activation_observer(None)
+        sess.run([], {'X': 2 * x})
+
+        result = statistics.get()
+        self.assertEqual(sorted(result.keys()), ['X', 'Y'])
+        self.assertEqual(result['X'], (-6.0, 6.0, [2, 2, 4, 4], 6.0))
+        self.assertEqual(result['Y'], (1.0, 36.0, [4, 4, 2, 2], 36.0))
+
+        statistics.clear()
+        self.assertEqual(statistics.get(), {})
+
     def testDictVectorizer(self):
         sess = onnxrt.InferenceSession(self.get_name("pipeline_vectorize.onnx"))
         input_name = sess.get_inputs()[0].name
@@ -426,6 +533,12 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([3], dtype=np.int64)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+        # Bytes
+        x = np.array([[b'4']])
+        res = sess.run([output_name], {input_name: x})
+        output_expected = np.array([[3]], dtype=np.int64)
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
         x = np.array(['4'], dtype=np.object)
         res = sess.run([output_name], {input_name: x})
         output_expected = np.array([3], dtype=np.int64)
@@ -0,0 +1,86 @@
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+# -*- coding: UTF-8 -*-
+import os
+import shutil
+import tempfile
+import unittest
+
+import numpy as np
+import onnx
+from onnx import helper, numpy_helper, TensorProto
+import onnxruntime as onnxrt
+from onnxruntime.tools.quantize_static import quantize_static
+
+
+class TestQuantizeStatic(unittest.TestCase):
+
+    def setUp(self):
+        self.test_dir = tempfile.mkdtemp()
+        self.rng = np.random.RandomState(0)
+
+    def tearDown(self):
+        shutil.rmtree(self.test_dir)
+
+    def save_model(self, nodes, inputs, outputs, initializers):
+        graph = helper.make_graph(nodes, 'test', inputs, outputs, initializers)
+        model = helper.make_model(graph, opset_imports=[helper.make_opsetid('', 9)])
+        # the IR version of the opset, so that the model loads with the onnx version onnxruntime is built with
+        model.ir_version = 4
+        model_path = os.path.join(self.test_dir, 'model.onnx')
+        onnx.save(model, model_path)
+        return model_path
+
+    def save_calibration_data(self, feeds):
+        data_dir = os.path.join(self.test_dir, 'calibration')
+        for index, feed in enumerate(feeds):
+            data_set = os.path.join(data_dir, 'test_data_set_{}'.format(index))
+            os.makedirs(data_set)
+            with open(os.path.join(data_set, 'input_0.pb'), 'wb') as f:
+                f.write(numpy_helper.from_array(feed, 'X').SerializeToString())
+        return data_dir
+
+    def check_quantized_model(self, model_path, feeds, quantized_op_type, **kwargs):
+        data_dir = self.save_calibration_data(feeds)
+        quantized_path = os.path.join(self.test_dir, 'model.quantized.onnx')
+        self.assertEqual(quantize_static(model_path, quantized_path, data_dir, **kwargs), 1)
+
+        op_types = [node.op_type for node in onnx.load(quantized_path).graph.node]
+        self.assertIn(quantized_op_type, op_types)
+        self.assertNotIn(quantized_op_type[len('QLinear'):], op_types)
+
+        # the values are in [-1, 1] and the results a few units at most, so the quantization steps are a few
+        # hundredths and the quantized model is within a couple of steps of the float one
+        sess = onnxrt.InferenceSession(model_path)
+        quantized_sess = onnxrt.InferenceSession(quantized_path)
+        for feed in feeds:
+            expected = sess.run([], {'X': feed})[0]
+            result = quantized_sess.run([], {'X': feed})[0]
+            self.assertEqual(result.shape, expected.shape)
+            np.testing.assert_allclose(result, expected, rtol=0, atol=0.08)
+
+    def testQuantizeMatMul(self):
+        w = self.rng.uniform(-1.0, 1.0, (4, 3)).astype(np.float32)
+        nodes = [helper.make_node('MatMul', ['X', 'W'], ['Z']), helper.make_node('Relu', ['Z'], ['Y'])]
+        model_path = self.save_model(nodes, [helper.make_tensor_value_info('X', TensorProto.FLOAT, [2, 4])],
+                                     [helper.make_tensor_value_info('Y', TensorProto.FLOAT, [2, 3])],
+                                     [numpy_helper.from_array(w, 'W')])
+
+        feeds = [self.rng.uniform(-1.0, 1.0, (2, 4)).astype(np.float32) for _ in range(8)]
+        self.check_quantized_model(model_path, feeds, 'QLinearMatMul')
+
+    def testQuantizeConvPerChannel(self):
+        w = self.rng.uniform(-1.0, 1.0, (2, 1, 3, 3)).astype(np.float32)
+        b = self.rng.uniform(-1.0, 1.0, (2,)).astype(np.float32)
+        nodes = [helper.make_node('Conv', ['X', 'W', 'B'], ['Y'], kernel_shape=[3, 3])]
+        model_path = self.save_model(nodes, [helper.make_tensor_value_info('X', TensorProto.FLOAT, [1, 1, 4, 4])],
+                                     [helper.make_tensor_value_info('Y', TensorProto.FLOAT, [1, 2, 2, 2])],
+                                     [numpy_helper.from_array(w, 'W'), numpy_helper.from_array(b, 'B')])
+
+        feeds = [self.rng.uniform(-1.0, 1.0, (1, 1, 4, 4)).astype(np.float32) for _ in range(8)]
+        self.check_quantized_model(model_path, feeds, 'QLinearConv', per_channel=True)
+
+
+if __name__ == '__main__':
+    unittest.main()
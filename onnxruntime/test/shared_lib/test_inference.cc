@@ -179,6 +179,71 @@ TEST_F(CApiTest, create_tensor) {
   }
 }
 
+TEST_F(CApiTest, fill_string_tensor_from_buffer) {
+  const std::string data("helloworld!");
+  const size_t offsets[] = {0, 5, 10, 10};
+  size_t expected_len = 4;
+  std::unique_ptr<MockedOrtAllocator> default_allocator(std::make_unique<MockedOrtAllocator>());
+  {
+    std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> tensor(
+        OrtCreateTensorAsOrtValue(default_allocator.get(), {expected_len}, ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING), OrtReleaseValue);
+    ORT_THROW_ON_ERROR(OrtFillStringTensorFromBuffer(tensor.get(), data.data(), data.size(), offsets, expected_len));
+
+    const std::string expected[] = {"hello", "world", "", "!"};
+    for (size_t i = 0; i != expected_len; ++i) {
+      const char* s;
+      size_t len;
+      ORT_THROW_ON_ERROR(OrtGetStringTensorElement(tensor.get(), i, &s, &len));
+      ASSERT_EQ(std::string(s, len), expected[i]);
+    }
+
+    const size_t bad_offsets[] = {0, 5, 4, 10};
+    OrtStatus* status = OrtFillStringTensorFromBuffer(tensor.get(), data.data(), data.size(), bad_offsets, expected_len);
+    ASSERT_NE(status, nullptr);
+    OrtReleaseStatus(status);
+  }
+}
+
+TEST_F(CApiTest, create_string_tensor_with_data) {
+  const std::string data("helloworld!");
+  const size_t offsets[] = {0, 5, 10, 10};
+  size_t expected_len = 4;
+  OrtAllocatorInfo* info;
+  ORT_THROW_ON_ERROR(OrtCreateAllocatorInfo("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault, &info));
+  const size_t dims[] = {2, 2};
+  OrtValue* value;
+  ORT_THROW_ON_ERROR(OrtCreateStringTensorWithDataAsOrtValue(info, data.data(), data.size(), offsets, expected_len,
+                                                             dims, 2, &value));
+  std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> tensor(value, OrtReleaseValue);
+
+  // the elements are read in place
+  const std::string expected[] = {"hello", "world", "", "!"};
+  for (size_t i = 0; i != expected_len; ++i) {
+    const char* s;
+    size_t len;
+    ORT_THROW_ON_ERROR(OrtGetStringTensorElement(tensor.get(), i, &s, &len));
+    ASSERT_EQ(s, data.data() + offsets[i]);
+    ASSERT_EQ(std::string(s, len), expected[i]);
+  }
+
+  size_t data_len;
+  ORT_THROW_ON_ERROR(OrtGetStringTensorDataLength(tensor.get(), &data_len));
+  ASSERT_EQ(data_len, data.size());
+  std::string result(data_len, '\0');
+  std::vector<size_t> result_offsets(expected_len);
+  ORT_THROW_ON_ERROR(OrtGetStringTensorContent(tensor.get(), (void*)result.data(), data_len, result_offsets.data(),
+                                               result_offsets.size()));
+  ASSERT_EQ(result, data);
+  ASSERT_EQ(result_offsets, std::vector<size_t>(offsets, offsets + expected_len));
+
+  const size_t bad_offsets[] = {0, 5, 4, 10};
+  OrtStatus* status = OrtCreateStringTensorWithDataAsOrtValue(info, data.data(), data.size(), bad_offsets,
+                                                              expected_len, dims, 2, &value);
+  ASSERT_NE(status, nullptr);
+  OrtReleaseStatus(status);
+  OrtReleaseAllocatorInfo(info);
+}
+
 TEST_F(CApiTest, create_tensor_with_data) {
   float values[] = {3.0f, 1.0f, 2.f, 0.f};
   constexpr size_t values_length = sizeof(values) / sizeof(values[0]);
@@ -199,6 +264,65 @@ TEST_F(CApiTest, create_tensor_with_data) {
   OrtReleaseObject(type_info);
 }
 
+TEST_F(CApiTest, run_with_io_binding) {
+  SessionOptionsWrapper sf(env);
+  std::unique_ptr<OrtSession, decltype(&OrtReleaseSession)> inference_session(sf.OrtCreateSession(MODEL_URI), OrtReleaseSession);
+  std::unique_ptr<OrtIoBinding, decltype(&OrtReleaseIoBinding)> binding(nullptr, OrtReleaseIoBinding);
+  {
+    OrtIoBinding* p;
+    ORT_THROW_ON_ERROR(OrtCreateIoBinding(inference_session.get(), &p));
+    binding.reset(p);
+  }
+
+  float x[] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  float y[6] = {};
+  const std::vector<size_t> dims = {3, 2};
+  OrtAllocatorInfo* info;
+  ORT_THROW_ON_ERROR(OrtCreateAllocatorInfo("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault, &info));
+  std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> value_x(
+      OrtCreateTensorWithDataAsOrtValue(info, x, sizeof(x), dims, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT), OrtReleaseValue);
+  std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> value_y(
+      OrtCreateTensorWithDataAsOrtValue(info, y, sizeof(y), dims, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT), OrtReleaseValue);
+  OrtReleaseAllocatorInfo(info);
+
+  ORT_THROW_ON_ERROR(OrtIoBindingBindInput(binding.get(), "X", value_x.get()));
+  ORT_THROW_ON_ERROR(OrtIoBindingBindOutput(binding.get(), "Y", value_y.get()));
+
+  // the output is written to the bound buffer on every run
+  for (int run = 1; run <= 3; ++run) {
+    for (size_t i = 0; i != 6; ++i) {
+      x[i] = static_cast<float>(run * (i + 1));
+    }
+    ORT_THROW_ON_ERROR(OrtRunWithIoBinding(inference_session.get(), nullptr, binding.get()));
+    for (size_t i = 0; i != 6; ++i) {
+      ASSERT_EQ(x[i] * x[i], y[i]);
+    }
+  }
+
+  size_t output_count;
+  ORT_THROW_ON_ERROR(OrtIoBindingGetOutputCount(binding.get(), &output_count));
+  ASSERT_EQ(1u, output_count);
+  OrtValue* output;
+  ORT_THROW_ON_ERROR(OrtIoBindingGetOutputValue(binding.get(), 0, &output));
+  void* output_data;
+  ORT_THROW_ON_ERROR(OrtGetTensorMutableData(output, &output_data));
+  ASSERT_EQ(output_data, y);
+  OrtReleaseValue(output);
+
+  // an output bound without a value is allocated by the run
+  OrtIoBindingClearOutputs(binding.get());
+  ORT_THROW_ON_ERROR(OrtIoBindingBindOutput(binding.get(), "Y", nullptr));
+  ORT_THROW_ON_ERROR(OrtRunWithIoBinding(inference_session.get(), nullptr, binding.get()));
+  ORT_THROW_ON_ERROR(OrtIoBindingGetOutputValue(binding.get(), 0, &output));
+  float* f;
+  ORT_THROW_ON_ERROR(OrtGetTensorMutableData(output, (void**)&f));
+  ASSERT_NE(f, y);
+  for (size_t i = 0; i != 6; ++i) {
+    ASSERT_EQ(x[i] * x[i], f[i]);
+  }
+  OrtReleaseValue(output);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
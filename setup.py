@@ -75,6 +75,7 @@ setup(
     entry_points= {
         'console_scripts': [
             'onnxruntime_test = onnxruntime.tools.onnxruntime_test:main',
+            'onnxruntime_quantize_static = onnxruntime.tools.quantize_static:main',
         ]
     },
     classifiers=[